@@ -1,6 +1,10 @@
 import { EventEmitter } from 'events';
 import type { BaseWindow as TLWT } from 'electron/main';
-const { BaseWindow } = process._linkedBinding('electron_browser_base_window') as { BaseWindow: typeof TLWT };
+const { BaseWindow, beginBatchUpdate, endBatchUpdate } = process._linkedBinding('electron_browser_base_window') as {
+  BaseWindow: typeof TLWT;
+  beginBatchUpdate(windows: TLWT[]): void;
+  endBatchUpdate(): void;
+};
 
 Object.setPrototypeOf(BaseWindow.prototype, EventEmitter.prototype);
 
@@ -106,4 +110,13 @@ BaseWindow.getFocusedWindow = () => {
   return BaseWindow.getAllWindows().find((win) => win.isFocused()) ?? null;
 };
 
+BaseWindow.batchUpdate = (windows: TLWT[], fn: () => void) => {
+  beginBatchUpdate(windows);
+  try {
+    fn();
+  } finally {
+    endBatchUpdate();
+  }
+};
+
 module.exports = BaseWindow;
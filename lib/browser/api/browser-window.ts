@@ -92,6 +92,8 @@ BrowserWindow.getFocusedWindow = () => {
   return null;
 };
 
+BrowserWindow.batchUpdate = BaseWindow.batchUpdate;
+
 BrowserWindow.fromWebContents = (webContents: WebContents) => {
   return webContents.getOwnerBrowserWindow();
 };
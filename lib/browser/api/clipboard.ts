@@ -1,3 +1,20 @@
-const clipboard = process._linkedBinding('electron_common_clipboard');
+import { EventEmitter } from 'events';
+
+const { _setChangeListener, ...binding } = process._linkedBinding('electron_common_clipboard') as any;
+
+const clipboard: Electron.Clipboard = Object.assign(new EventEmitter(), binding);
+
+// The platform clipboard is only watched while there are listeners for the
+// change event.
+clipboard.on('newListener', (event) => {
+  if (event === 'change' && clipboard.listenerCount('change') === 0) {
+    _setChangeListener(() => clipboard.emit('change'));
+  }
+});
+clipboard.on('removeListener', (event) => {
+  if (event === 'change' && clipboard.listenerCount('change') === 0) {
+    _setChangeListener(null);
+  }
+});
 
 export default clipboard;
@@ -1,3 +1,5 @@
+import { EventEmitter } from 'events';
+
 const { createDesktopCapturer } = process._linkedBinding('electron_browser_desktop_capturer');
 
 const deepEqual = (a: ElectronInternal.GetSourcesOptions, b: ElectronInternal.GetSourcesOptions) => JSON.stringify(a) === JSON.stringify(b);
@@ -69,3 +71,74 @@ export async function getSources (args: Electron.SourcesOptions) {
 
   return getSources;
 }
+
+class DesktopCapturerSourceList extends EventEmitter implements Electron.DesktopCapturerSourceList {
+  #capturer: ElectronInternal.DesktopCapturer | null;
+  #sources = new Map<string, Electron.DesktopCapturerSource>();
+  #order: string[] = [];
+
+  constructor (options: ElectronInternal.GetSourcesOptions, updateInterval: number) {
+    super();
+    this.#capturer = createDesktopCapturer();
+    this.#capturer._onupdated = (added, removed, changed, order) => {
+      for (const id of removed) {
+        this.#sources.delete(id);
+        this.emit('source-removed', id);
+      }
+      for (const source of added) {
+        this.#sources.set(source.id, source);
+      }
+      for (const change of changed) {
+        const source = this.#sources.get(change.id)!;
+        if (change.name !== undefined) source.name = change.name;
+        if (change.thumbnail !== undefined) source.thumbnail = change.thumbnail;
+      }
+      this.#order = order;
+      for (const source of added) {
+        this.emit('source-added', source);
+      }
+      for (const change of changed) {
+        const source = this.#sources.get(change.id)!;
+        if (change.name !== undefined) this.emit('source-name-changed', source);
+        if (change.thumbnail !== undefined) this.emit('source-thumbnail-changed', source);
+      }
+      this.emit('updated');
+    };
+    this.#capturer._onerror = (error: string) => {
+      this.#capturer = null;
+      this.emit('failed', error);
+    };
+    this.#capturer.startUpdating(options.captureWindow, options.captureScreen, options.thumbnailSize, options.fetchWindowIcons, updateInterval);
+  }
+
+  getSources () {
+    return this.#order.map(id => this.#sources.get(id)!);
+  }
+
+  destroy () {
+    if (this.#capturer) {
+      this.#capturer.stop();
+      delete this.#capturer._onupdated;
+      delete this.#capturer._onerror;
+      this.#capturer = null;
+    }
+  }
+}
+
+export function createSourceList (args: Electron.SourcesOptions & { updateInterval?: number }) {
+  if (!isValid(args)) throw new Error('Invalid options');
+
+  const { thumbnailSize = { width: 150, height: 150 } } = args;
+  const { fetchWindowIcons = false } = args;
+  const { updateInterval = 1000 } = args;
+  if (typeof updateInterval !== 'number' || !(updateInterval > 0)) {
+    throw new Error('updateInterval must be a positive number');
+  }
+
+  return new DesktopCapturerSourceList({
+    captureWindow: args.types.includes('window'),
+    captureScreen: args.types.includes('screen'),
+    thumbnailSize,
+    fetchWindowIcons
+  }, updateInterval);
+}
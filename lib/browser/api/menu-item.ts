@@ -37,6 +37,21 @@ const MenuItem = function (this: any, options: any) {
   this.overrideProperty('acceleratorWorksWhenHidden', true);
   this.overrideProperty('registerAccelerator', roles.shouldRegisterAccelerator(this.role));
 
+  // Push the changes to the native menu, which then doesn't have to ask for
+  // the state of every item when it is shown.
+  for (const name of ['enabled', 'visible', 'checked', 'acceleratorWorksWhenHidden', 'registerAccelerator']) {
+    let value = this[name];
+    Object.defineProperty(this, name, {
+      configurable: true,
+      enumerable: true,
+      get: () => value,
+      set: (newValue) => {
+        value = newValue;
+        this._updateNativeState();
+      }
+    });
+  }
+
   if (!MenuItem.types.includes(this.type)) {
     throw new Error(`Unknown menu item type: ${this.type}`);
   }
@@ -81,6 +96,23 @@ MenuItem.prototype.getCheckStatus = function () {
   return roles.getCheckStatus(this.role);
 };
 
+MenuItem.prototype._getNativeState = function () {
+  return {
+    checked: this.getCheckStatus(),
+    dynamicChecked: roles.shouldOverrideCheckStatus(this.role),
+    enabled: this.enabled,
+    visible: this.visible,
+    worksWhenHidden: !!this.acceleratorWorksWhenHidden,
+    registerAccelerator: this.registerAccelerator,
+    accelerator: this.accelerator,
+    defaultAccelerator: this.accelerator == null ? this.getDefaultRoleAccelerator() : undefined
+  };
+};
+
+MenuItem.prototype._updateNativeState = function () {
+  if (this.menu) this.menu._setCommandState(this.commandId, this._getNativeState());
+};
+
 MenuItem.prototype.overrideProperty = function (name: string, defaultValue: any = null) {
   if (this[name] == null) {
     this[name] = defaultValue;
@@ -61,7 +61,10 @@ Menu.prototype._menuWillShow = function () {
   // Ensure radio groups have at least one menu item selected
   for (const id of Object.keys(this.groupsMap)) {
     const found = this.groupsMap[id].find(item => item.checked) || null;
-    if (!found) checked.set(this.groupsMap[id][0], true);
+    if (!found) {
+      checked.set(this.groupsMap[id][0], true);
+      this.groupsMap[id][0]._updateNativeState();
+    }
   }
 };
 
@@ -145,6 +148,7 @@ Menu.prototype.insert = function (pos, item) {
 
   // Make menu accessible to items.
   item.overrideReadOnlyProperty('menu', this);
+  item._updateNativeState();
 
   // Remember the items.
   this.items.splice(pos, 0, item);
@@ -281,9 +285,13 @@ function insertItemByType (this: MenuType, item: MenuItem, pos: number) {
         get: () => checked.get(item),
         set: () => {
           for (const other of this.groupsMap[item.groupId]) {
-            if (other !== item) checked.set(other, false);
+            if (other !== item) {
+              checked.set(other, false);
+              other._updateNativeState();
+            }
           }
           checked.set(item, true);
+          item._updateNativeState();
         }
       });
       this.insertRadioItem(pos, item.commandId, item.label, item.groupId);
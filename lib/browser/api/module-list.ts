@@ -23,6 +23,7 @@ export const browserModuleList: ElectronInternal.ModuleEntry[] = [
   { name: 'net', loader: () => require('./net') },
   { name: 'netLog', loader: () => require('./net-log') },
   { name: 'Notification', loader: () => require('./notification') },
+  { name: 'OffscreenAtlas', loader: () => require('./offscreen-atlas') },
   { name: 'powerMonitor', loader: () => require('./power-monitor') },
   { name: 'powerSaveBlocker', loader: () => require('./power-save-blocker') },
   { name: 'pushNotifications', loader: () => require('./push-notifications') },
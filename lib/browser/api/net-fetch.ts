@@ -1,5 +1,6 @@
 import { ClientRequestConstructorOptions, ClientRequest, IncomingMessage, Session as SessionT } from 'electron/main';
 import { Readable, Writable, isReadable } from 'stream';
+import { fileURLToPath } from 'url';
 import { allowAnyProtocol } from '@electron/internal/common/api/net-client-request';
 
 function createDeferredPromise<T, E extends Error = Error> (): { promise: Promise<T>; resolve: (x: T) => void; reject: (e: E) => void; } {
@@ -110,6 +111,12 @@ export function fetchWithSession (input: RequestInfo, init: (RequestInit & {bypa
       statusText: resp.statusMessage
     });
     (rResp as any).__original_resp = resp;
+    // Lets protocol.handle hand the file to the native file loader instead of
+    // streaming it through JS, unless file: requests are handled in JS too.
+    if (req.method === 'GET' && resp.statusCode === 200 && req.url.startsWith('file:') &&
+        (init?.bypassCustomProtocolHandlers || !session?.protocol.isProtocolIntercepted('file'))) {
+      (rResp as any).__file_path = fileURLToPath(req.url);
+    }
     p.resolve(rResp);
   });
 
@@ -0,0 +1,3 @@
+const { OffscreenAtlas } = process._linkedBinding('electron_browser_offscreen_atlas');
+
+export default OffscreenAtlas;
@@ -5,7 +5,8 @@ const {
   getSystemIdleState,
   getSystemIdleTime,
   getCurrentThermalState,
-  isOnBatteryPower
+  isOnBatteryPower,
+  setPolicy
 } = process._linkedBinding('electron_browser_power_monitor');
 
 class PowerMonitor extends EventEmitter implements Electron.PowerMonitor {
@@ -53,6 +54,10 @@ class PowerMonitor extends EventEmitter implements Electron.PowerMonitor {
     return isOnBatteryPower();
   }
 
+  setPolicy (rules: Electron.PowerPolicyRule[]) {
+    setPolicy(rules);
+  }
+
   get onBatteryPower () {
     return this.isOnBatteryPower();
   }
@@ -107,7 +107,7 @@ function validateResponse (res: Response) {
   return true;
 }
 
-Protocol.prototype.handle = function (this: Electron.Protocol, scheme: string, handler: (req: Request) => Response | Promise<Response>) {
+Protocol.prototype.handle = function (this: Electron.Protocol, scheme: string, handler: (req: Request) => Response | Promise<Response>, options?: { cache?: boolean }) {
   const register = isBuiltInScheme(scheme) ? this.interceptProtocol : this.registerProtocol;
   const success = register.call(this, scheme, async (preq: ProtocolRequest, cb: any) => {
     try {
@@ -128,6 +128,14 @@ Protocol.prototype.handle = function (this: Electron.Protocol, scheme: string, h
         return cb({ error: ERR_UNEXPECTED });
       } else if (res.type === 'error') {
         cb({ error: ERR_FAILED });
+      } else if ((res as any).__file_path && !res.bodyUsed && !res.body?.locked) {
+        // The response is a file fetched with net.fetch, which the native file
+        // loader can serve directly, with support for range requests.
+        res.body?.cancel().catch(() => {});
+        const headers = Object.fromEntries(res.headers);
+        delete headers['content-length'];
+        delete headers['content-type'];
+        cb({ path: (res as any).__file_path, headers });
       } else {
         cb({
           data: res.body ? Readable.fromWeb(res.body as ReadableStream<ArrayBufferView>) : null,
@@ -143,6 +151,7 @@ Protocol.prototype.handle = function (this: Electron.Protocol, scheme: string, h
     }
   });
   if (!success) throw new Error(`Failed to register protocol: ${scheme}`);
+  if (options?.cache && !isBuiltInScheme(scheme)) this._enableResponseCache(scheme);
 };
 
 Protocol.prototype.unhandle = function (this: Electron.Protocol, scheme: string) {
@@ -4,9 +4,41 @@ const { createScreen } = process._linkedBinding('electron_browser_screen');
 
 let _screen: Electron.Screen;
 
+const deepFreeze = <T>(value: T): T => {
+  if (value && typeof value === 'object') {
+    for (const child of Object.values(value)) deepFreeze(child);
+    Object.freeze(value);
+  }
+  return value;
+};
+
+// The snapshot is frozen, so the same one can be handed out until the
+// displays change.
+let displaySnapshot: Electron.DisplaySnapshot | undefined;
+function getDisplaySnapshot (this: Electron.Screen) {
+  const version = this.getDisplaysVersion();
+  if (displaySnapshot?.version !== version) {
+    displaySnapshot = deepFreeze({ version, displays: this.getAllDisplays() });
+  }
+  return displaySnapshot;
+}
+
 const createScreenIfNeeded = () => {
   if (_screen === undefined) {
     _screen = createScreen();
+    _screen.getDisplaySnapshot = getDisplaySnapshot;
+
+    // The cursor is only tracked while there are listeners for it.
+    _screen.on('newListener', (event) => {
+      if (event === 'cursor-moved' && _screen.listenerCount('cursor-moved') === 0) {
+        (_screen as any)._setCursorTracking(true);
+      }
+    });
+    _screen.on('removeListener', (event) => {
+      if (event === 'cursor-moved' && _screen.listenerCount('cursor-moved') === 0) {
+        (_screen as any)._setCursorTracking(false);
+      }
+    });
   }
 };
 
@@ -1,11 +1,178 @@
 import { fetchWithSession } from '@electron/internal/browser/api/net-fetch';
-import { net } from 'electron/main';
+import { net, webContents } from 'electron/main';
 const { fromPartition, fromPath, Session } = process._linkedBinding('electron_browser_session');
 
 Session.prototype.fetch = function (input: RequestInfo, init?: RequestInit) {
   return fetchWithSession(input, init, this, net.request);
 };
 
+// Loads a page like a navigation to it would, so that the response is in the
+// HTTP cache of the session when the navigation happens.
+function prefetchURL (session: Electron.Session, url: string, options: Electron.PrefetchOptions): Promise<Electron.PrefetchResult> {
+  return new Promise((resolve) => {
+    const request = net.request({
+      url,
+      session,
+      useSessionCookies: true,
+      priority: options.priority ?? 'idle',
+      headers: {
+        'Sec-Fetch-Mode': 'navigate',
+        'Sec-Fetch-Dest': 'document'
+      }
+    });
+    request.on('response', (response) => {
+      response.on('data', () => {});
+      response.on('end', () => resolve({ url, statusCode: response.statusCode }));
+      response.on('error', (error: Error) => resolve({ url, error: error.message }));
+    });
+    request.on('error', (error) => resolve({ url, error: error.message }));
+    request.end();
+  });
+}
+
+Session.prototype.prefetch = function (urls: string[], options: Electron.PrefetchOptions = {}) {
+  if (!Array.isArray(urls)) {
+    throw new TypeError('urls must be an array');
+  }
+  return Promise.all(urls.map(url => prefetchURL(this, url, options)));
+};
+
+const kClearDataTypes = ['backgroundFetch', 'cache', 'cookies', 'downloads', 'fileSystems', 'indexedDB', 'localStorage', 'serviceWorkers', 'webSQL'];
+
+// The data types are cleared one at a time, the BrowsingDataRemover runs its
+// tasks one after the other anyway and this way the progress can be reported
+// and the types that are left can be skipped once aborted.
+async function clearDataInSteps (session: Electron.Session, clearData: Electron.Session['clearData'], options: Electron.ClearDataOptions) {
+  const { onProgress, signal, ...clearOptions } = options;
+  const dataTypes = clearOptions.dataTypes ?? kClearDataTypes;
+  const failedDataTypes: string[] = [];
+  for (const [index, dataType] of dataTypes.entries()) {
+    signal?.throwIfAborted();
+    try {
+      await clearData.call(session, { ...clearOptions, dataTypes: [dataType] });
+    } catch (error: any) {
+      if (!error.failedDataTypes) throw error;
+      failedDataTypes.push(...error.failedDataTypes);
+    }
+    onProgress?.({ dataType, completed: index + 1, total: dataTypes.length });
+  }
+  if (failedDataTypes.length > 0) {
+    throw Object.assign(new Error('Failed to clear data'), { failedDataTypes });
+  }
+}
+
+const { clearData } = Session.prototype;
+Session.prototype.clearData = function (options?: Electron.ClearDataOptions) {
+  if (options?.onProgress !== undefined && typeof options.onProgress !== 'function') {
+    throw new TypeError('onProgress must be a function');
+  }
+  if (!options?.onProgress && !options?.signal) {
+    return clearData.call(this, options);
+  }
+  return clearDataInSteps(this, clearData, options);
+};
+
+const kDownloadPriorities: Record<string, number> = { low: 0, normal: 1, high: 2 };
+
+// Throttles the downloads of a session with DownloadItem.pause() and resume(),
+// since the network service has no bandwidth limit for a single download.
+class DownloadScheduler {
+  private readonly downloads = new Set<Electron.DownloadItem>();
+  // The downloads paused by the scheduler, a download paused by the app is
+  // left alone.
+  private readonly paused = new Set<Electron.DownloadItem>();
+  private timer?: NodeJS.Timeout;
+
+  constructor (private readonly session: Electron.Session, private readonly options: Electron.DownloadSchedulerOptions) {
+    session.on('will-download', this.onWillDownload);
+  }
+
+  stop () {
+    this.session.removeListener('will-download', this.onWillDownload);
+    clearInterval(this.timer);
+    this.timer = undefined;
+    for (const item of this.paused) {
+      if (item.canResume()) item.resume();
+    }
+    this.downloads.clear();
+    this.paused.clear();
+  }
+
+  private onWillDownload = (event: Electron.Event, item: Electron.DownloadItem) => {
+    this.downloads.add(item);
+    item.once('done', () => {
+      this.downloads.delete(item);
+      this.paused.delete(item);
+      if (this.downloads.size === 0) {
+        clearInterval(this.timer);
+        this.timer = undefined;
+      }
+    });
+    if (!this.timer) {
+      this.timer = setInterval(this.schedule, this.options.interval ?? 1000);
+    }
+  };
+
+  private isBusy () {
+    if (!this.options.pauseWhileLoading) return false;
+    return webContents.getAllWebContents().some(contents => contents.session === this.session && contents.isLoading());
+  }
+
+  private schedule = () => {
+    for (const item of this.paused) {
+      // The app resumed the download itself.
+      if (!item.isPaused()) this.paused.delete(item);
+    }
+
+    // Highest priority first, then the oldest first.
+    const items = [...this.downloads]
+      .filter(item => item.getState() === 'progressing' && (!item.isPaused() || this.paused.has(item)))
+      .sort((a, b) => (kDownloadPriorities[b.priority] - kDownloadPriorities[a.priority]) || (a.getStartTime() - b.getStartTime()));
+
+    // Low priority downloads make way for the pages that are loading.
+    const busy = this.isBusy();
+    for (const item of items) {
+      const wanted = !(busy && item.priority === 'low');
+      if (!wanted && !item.isPaused()) {
+        item.pause();
+        this.paused.add(item);
+      }
+    }
+
+    const { maxBytesPerSecond } = this.options;
+    const running = items.filter(item => !item.isPaused());
+    const bytesPerSecond = running.reduce((total, item) => total + item.getCurrentBytesPerSecond(), 0);
+    if (maxBytesPerSecond && bytesPerSecond > maxBytesPerSecond && running.length > 1) {
+      // Pause one download per interval, so that the speed of the others can
+      // catch up before pausing more.
+      const item = running[running.length - 1];
+      item.pause();
+      this.paused.add(item);
+    } else if (!maxBytesPerSecond || bytesPerSecond < maxBytesPerSecond * 0.8) {
+      const item = items.find(item => this.paused.has(item) && !(busy && item.priority === 'low'));
+      if (item && item.canResume()) {
+        item.resume();
+        this.paused.delete(item);
+      }
+    }
+  };
+}
+
+const downloadSchedulers = new WeakMap<Electron.Session, DownloadScheduler>();
+Session.prototype.setDownloadScheduler = function (options: Electron.DownloadSchedulerOptions | null) {
+  if (options !== null && typeof options !== 'object') {
+    throw new TypeError('options must be null or an object');
+  }
+  if (options?.maxBytesPerSecond !== undefined && !(options.maxBytesPerSecond > 0)) {
+    throw new TypeError('maxBytesPerSecond must be a positive number');
+  }
+  downloadSchedulers.get(this)?.stop();
+  downloadSchedulers.delete(this);
+  if (options) {
+    downloadSchedulers.set(this, new DownloadScheduler(this, options));
+  }
+};
+
 export default {
   fromPartition,
   fromPath,
@@ -40,9 +40,12 @@ const LiveProperty = <T extends TouchBarItem<any>>(def: (config: T extends Touch
       return this[hiddenProperties][propertyKey];
     },
     set: function (value) {
+      // Objects can be mutated in place and then set again, so only the
+      // primitives are compared.
+      if (value === this[hiddenProperties][propertyKey] && (value === null || typeof value !== 'object')) return;
       if (onMutate) onMutate((this as any), value);
       this[hiddenProperties][propertyKey] = value;
-      this.emit('change', this);
+      this.emit('change', this, propertyKey);
     },
     enumerable: true
   });
@@ -358,8 +361,8 @@ class TouchBar extends EventEmitter implements Electron.TouchBar {
     }
   }
 
-  private changeListener = (item: TouchBarItem<any>) => {
-    this.emit('change', item.id, item.type);
+  private changeListener = (item: TouchBarItem<any>, property: string) => {
+    this.emit('change', item.id, item.type, property, (item as any)[property]);
   };
 
   private [escapeItemSymbol]: TouchBarItem<unknown> | null = null;
@@ -391,8 +394,16 @@ class TouchBar extends EventEmitter implements Electron.TouchBar {
 
     window._touchBar = this;
 
-    const changeListener = (itemID: string) => {
-      window._refreshTouchBarItem(itemID);
+    const changeListener = (itemID: string, type: string, property: string, value: any) => {
+      // The values that change the most often, like the ones showing progress,
+      // are set without the whole item being read again.
+      if (type === 'label' && property === 'label' && typeof value === 'string') {
+        window._setTouchBarItemLabel(itemID, value);
+      } else if (type === 'slider' && property === 'value' && Number.isInteger(value)) {
+        window._setTouchBarItemValue(itemID, value);
+      } else {
+        window._refreshTouchBarItem(itemID);
+      }
     };
     this.on('change', changeListener);
 
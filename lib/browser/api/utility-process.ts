@@ -1,8 +1,11 @@
 import { EventEmitter } from 'events';
 import { Duplex, PassThrough } from 'stream';
 import { Socket } from 'net';
+import { availableParallelism } from 'os';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
-const { _fork } = process._linkedBinding('electron_browser_utility_process');
+import { SharedBuffer } from '@electron/internal/browser/shared-buffer';
+import { session } from 'electron/main';
+const { _fork, _setPrewarmedProcessCount } = process._linkedBinding('electron_browser_utility_process');
 
 class ForkUtilityProcess extends EventEmitter implements Electron.UtilityProcess {
   #handle: ElectronInternal.UtilityProcessWrapper | null;
@@ -129,7 +132,7 @@ class ForkUtilityProcess extends EventEmitter implements Electron.UtilityProcess
     return this.#stderr;
   }
 
-  postMessage (message: any, transfer?: MessagePortMain[]) {
+  postMessage (message: any, transfer?: (MessagePortMain | ArrayBuffer)[]) {
     if (Array.isArray(transfer)) {
       transfer = transfer.map((o: any) => o instanceof MessagePortMain ? o._internalPort : o);
       return this.#handle?.postMessage(message, transfer);
@@ -137,14 +140,236 @@ class ForkUtilityProcess extends EventEmitter implements Electron.UtilityProcess
     return this.#handle?.postMessage(message);
   }
 
+  createSharedBuffer (name: string, capacity: number) {
+    if (this.#handle === null) {
+      throw new Error('The process is not running');
+    }
+    return new SharedBuffer(this.#handle.createSharedBuffer(name, capacity));
+  }
+
+  handleProtocol (scheme: string, options: { session?: Electron.Session } = {}) : void {
+    if (this.#handle === null) {
+      throw new Error('The process is not running');
+    }
+    if (['http', 'https', 'file'].includes(scheme)) {
+      throw new Error(`Built-in schemes can't be handled by a utility process: ${scheme}`);
+    }
+    this.#handle.handleProtocol(scheme, options.session ?? session.defaultSession);
+  }
+
   kill () : boolean {
     if (this.#handle === null) {
       return false;
     }
     return this.#handle.kill();
   }
+
+  setPriority (priority: 'background' | 'utility' | 'user-interactive') : boolean {
+    if (this.#handle === null) {
+      return false;
+    }
+    return this.#handle.setPriority(priority);
+  }
+
+  setCPUAffinity (cpus: number[]) : boolean {
+    if (this.#handle === null) {
+      return false;
+    }
+    return this.#handle.setCPUAffinity(cpus);
+  }
+
+  async startCpuProfiling (options?: Electron.CpuProfilingOptions) {
+    if (this.#handle === null) {
+      throw new Error('The process is not running');
+    }
+    return this.#handle.startCpuProfiling(options);
+  }
+
+  async stopCpuProfiling (filePath: string) {
+    if (this.#handle === null) {
+      throw new Error('The process is not running');
+    }
+    return this.#handle.stopCpuProfiling(filePath);
+  }
+}
+
+interface PoolTask {
+  message: any;
+  transfer?: MessagePortMain[];
+  resolve: (result: any) => void;
+  reject: (error: Error) => void;
+}
+
+interface PoolMember {
+  child: ForkUtilityProcess;
+  spawned: boolean;
+  alive: boolean;
+  // Tasks that were assigned to this process but not posted to it yet.
+  queue: PoolTask[];
+  // The task that was posted to this process and awaits its reply.
+  current: PoolTask | null;
+  completed: number;
+  respawns: number;
+}
+
+class UtilityProcessPool extends EventEmitter implements Electron.UtilityProcessPool {
+  #modulePath: string;
+  #args: string[];
+  #options: Electron.ForkOptions;
+  #members: PoolMember[] = [];
+  #closed = false;
+
+  constructor (modulePath: string, options?: Electron.CreatePoolOptions) {
+    super();
+
+    const { size = availableParallelism(), args = [], ...forkOptions } = options ?? {};
+    if (!Number.isInteger(size) || size < 1) {
+      throw new TypeError('size must be a positive integer.');
+    }
+    if (!Array.isArray(args)) {
+      throw new TypeError('args must be an array of strings.');
+    }
+
+    this.#modulePath = modulePath;
+    this.#args = args;
+    this.#options = forkOptions;
+    for (let index = 0; index < size; index++) {
+      this.#members.push(this.#spawn(index, 0));
+    }
+  }
+
+  get size () {
+    return this.#members.length;
+  }
+
+  run (message: any, transfer?: MessagePortMain[]) {
+    return new Promise<any>((resolve, reject) => {
+      this.#dispatch({ message, transfer, resolve, reject });
+    });
+  }
+
+  getMetrics (): Electron.UtilityProcessPoolMetric[] {
+    return this.#members.map((member, index) => ({
+      index,
+      pid: member.child.pid,
+      queued: member.queue.length,
+      running: member.current !== null,
+      completed: member.completed,
+      respawns: member.respawns
+    }));
+  }
+
+  close () {
+    if (this.#closed) return;
+    this.#closed = true;
+    const error = new Error('The pool was closed');
+    for (const member of this.#members) {
+      for (const task of member.queue.splice(0)) task.reject(error);
+      member.current?.reject(error);
+      member.current = null;
+      member.child.kill();
+    }
+  }
+
+  #spawn (index: number, respawns: number): PoolMember {
+    const child = new ForkUtilityProcess(this.#modulePath, this.#args, this.#options);
+    const member: PoolMember = {
+      child,
+      spawned: false,
+      alive: true,
+      queue: [],
+      current: null,
+      completed: 0,
+      respawns
+    };
+    child.once('spawn', () => { member.spawned = true; });
+    child.on('message', (message) => this.#onReply(member, message));
+    child.once('exit', (code: number) => this.#onExit(index, member, code));
+    return member;
+  }
+
+  // Assigns |task| to the process with the fewest tasks, the first one when
+  // several are tied.
+  #dispatch (task: PoolTask) {
+    if (this.#closed) {
+      task.reject(new Error('The pool was closed'));
+      return;
+    }
+    let target: PoolMember | null = null;
+    let targetLoad = Infinity;
+    for (const member of this.#members) {
+      if (!member.alive) continue;
+      const load = member.queue.length + (member.current ? 1 : 0);
+      if (load < targetLoad) {
+        target = member;
+        targetLoad = load;
+      }
+    }
+    if (!target) {
+      task.reject(new Error('No process of the pool is running'));
+      return;
+    }
+    target.queue.push(task);
+    this.#runNext(target);
+  }
+
+  // Posts the next task of |member|, or one that is waiting the longest on
+  // another process when |member| has none left.
+  #runNext (member: PoolMember) {
+    if (this.#closed || !member.alive || member.current) return;
+    let task = member.queue.shift();
+    if (!task) {
+      let victim: PoolMember | null = null;
+      for (const other of this.#members) {
+        if (other.queue.length > (victim?.queue.length ?? 0)) victim = other;
+      }
+      task = victim?.queue.shift();
+    }
+    if (!task) return;
+    member.current = task;
+    member.child.postMessage(task.message, task.transfer);
+  }
+
+  #onReply (member: PoolMember, message: any) {
+    const task = member.current;
+    if (!task) return;
+    member.current = null;
+    member.completed++;
+    task.resolve(message);
+    this.#runNext(member);
+  }
+
+  #onExit (index: number, member: PoolMember, code: number) {
+    member.alive = false;
+    if (this.#closed) return;
+
+    const { current } = member;
+    member.current = null;
+    current?.reject(new Error(`The utility process exited with code ${code} while running the task`));
+    this.emit('process-exit', index, code);
+
+    // A process that failed to spawn would fail again, the pool goes on with
+    // the others instead.
+    if (member.spawned) {
+      const replacement = this.#spawn(index, member.respawns + 1);
+      replacement.completed = member.completed;
+      this.#members[index] = replacement;
+    }
+    for (const task of member.queue.splice(0)) this.#dispatch(task);
+  }
 }
 
 export function fork (modulePath: string, args?: string[], options?: Electron.ForkOptions) {
   return new ForkUtilityProcess(modulePath, args, options);
 }
+
+export function createPool (modulePath: string, options?: Electron.CreatePoolOptions) {
+  return new UtilityProcessPool(modulePath, options);
+}
+
+export function prewarm (count: number) {
+  if (!Number.isInteger(count) || count < 0) {
+    throw new TypeError('count must be a non-negative integer.');
+  }
+  _setPrewarmedProcessCount(count);
+}
@@ -3,11 +3,13 @@ import type { BrowserWindowConstructorOptions, LoadURLOptions, MessageBoxOptions
 
 import * as url from 'url';
 import * as path from 'path';
+import { Readable } from 'stream';
 import { openGuestWindow, makeWebPreferences, parseContentTypeFormat } from '@electron/internal/browser/guest-window-manager';
 import { parseFeatures } from '@electron/internal/browser/parse-features-string';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+import { executeRegisteredScript } from '@electron/internal/browser/script-registry';
 import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 import { IpcMainImpl } from '@electron/internal/browser/ipc-main-impl';
 import * as deprecate from '@electron/internal/common/deprecate';
@@ -187,6 +189,70 @@ WebContents.prototype.executeJavaScriptInIsolatedWorld = async function (worldId
   return ipcMainUtils.invokeInWebContents(this, IPC_MESSAGES.RENDERER_WEB_FRAME_METHOD, 'executeJavaScriptInIsolatedWorld', worldId, code, !!hasUserGesture);
 };
 
+// Runs the code in each frame with WebFrameMain::executeJavaScript, which
+// calls the frame directly instead of going through the IPC of the main frame,
+// and resolves once all frames have answered.
+async function executeJavaScriptInFrames (frames: Electron.WebFrameMain[], code: string, userGesture: boolean): Promise<Electron.FrameExecutionResult[]> {
+  return Promise.all(frames.map(async (frame) => {
+    try {
+      return { frame, result: await frame.executeJavaScript(code, userGesture) };
+    } catch (error: any) {
+      return { frame, error: error instanceof Error ? error.message : String(error) };
+    }
+  }));
+}
+
+WebContents.prototype.executeJavaScriptInAllFrames = async function (code, userGesture) {
+  await waitTillCanExecuteJavaScript(this);
+  return executeJavaScriptInFrames(this.mainFrame.framesInSubtree, String(code), !!userGesture);
+};
+
+WebContents.prototype.executeRegisteredScript = async function (name, options) {
+  await waitTillCanExecuteJavaScript(this);
+  return executeRegisteredScript((command, ...args) => ipcMainUtils.invokeInWebContents(this, command, ...args), name, options);
+};
+
+// Fetches the subresources of the page ahead of content::SavePackage, which
+// saves them one after the other, so that it finds them in the HTTP cache.
+// The ones that are cached already are not fetched again.
+async function fetchSubresources (contents: Electron.WebContents, concurrency: number, onProgress?: (progress: Electron.SavePageProgress) => void) {
+  const urls = contents._getSubresourceURLs();
+  let next = 0;
+  let completed = 0;
+  const fetchNext = async () => {
+    while (next < urls.length) {
+      const url = urls[next++];
+      try {
+        const response = await contents.session.fetch(url, { cache: 'force-cache' });
+        await response.arrayBuffer();
+      } catch {
+        // The save reports the resources that it could not get itself.
+      }
+      completed++;
+      onProgress?.({ stage: 'fetching', completed, total: urls.length });
+    }
+  };
+  await Promise.all(Array.from({ length: Math.min(concurrency, urls.length) }, fetchNext));
+}
+
+WebContents.prototype.savePage = async function (fullPath, saveType, options = {}) {
+  const { concurrency, onProgress } = options;
+  if (concurrency !== undefined && !(Number.isInteger(concurrency) && concurrency > 0)) {
+    throw new TypeError('concurrency must be a positive integer');
+  }
+  if (onProgress !== undefined && typeof onProgress !== 'function') {
+    throw new TypeError('onProgress must be a function');
+  }
+  // Only a complete page saves its subresources from the network, an MHTML
+  // archive is serialized by the renderer from what it has loaded.
+  if (concurrency !== undefined && saveType === 'HTMLComplete' && path.isAbsolute(fullPath)) {
+    await fetchSubresources(this, concurrency, onProgress);
+  }
+  return this._savePage(fullPath, saveType, onProgress && ((completed: number, total: number) => {
+    onProgress({ stage: 'saving', completed, total });
+  }));
+};
+
 function checkType<T> (value: T, type: 'number' | 'boolean' | 'string' | 'object', name: string): T {
   // eslint-disable-next-line valid-typeof
   if (typeof value !== type) {
@@ -216,9 +282,7 @@ function parsePageSize (pageSize: string | ElectronInternal.PageSize) {
 }
 
 // Translate the options of printToPDF.
-
-let pendingPromise: Promise<any> | undefined;
-WebContents.prototype.printToPDF = async function (options) {
+function getPrintToPDFSettings (options: Electron.PrintToPDFOptions) {
   const margins = checkType(options.margins ?? {}, 'object', 'margins');
   const pageSize = parsePageSize(options.pageSize ?? 'letter');
 
@@ -230,7 +294,7 @@ WebContents.prototype.printToPDF = async function (options) {
     throw new Error('margins must be less than or equal to pageSize');
   }
 
-  const printSettings = {
+  return {
     requestID: getNextId(),
     landscape: checkType(options.landscape ?? false, 'boolean', 'landscape'),
     displayHeaderFooter: checkType(options.displayHeaderFooter ?? false, 'boolean', 'displayHeaderFooter'),
@@ -248,17 +312,42 @@ WebContents.prototype.printToPDF = async function (options) {
     generateDocumentOutline: checkType(options.generateDocumentOutline ?? false, 'boolean', 'generateDocumentOutline'),
     ...pageSize
   };
+}
 
-  if (this._printToPDF) {
-    if (pendingPromise) {
-      pendingPromise = pendingPromise.then(() => this._printToPDF(printSettings));
-    } else {
-      pendingPromise = this._printToPDF(printSettings);
-    }
-    return pendingPromise;
-  } else {
+// Print jobs of a WebContents run one after the other, the jobs of different
+// WebContents can run at the same time.
+const pendingPrintToPDF = new WeakMap<Electron.WebContents, Promise<any>>();
+function queuePrintToPDF (contents: Electron.WebContents, printSettings: any) {
+  if (!contents._printToPDF) {
     throw new Error('Printing feature is disabled');
   }
+  const pending = pendingPrintToPDF.get(contents) ?? Promise.resolve();
+  const promise = pending.catch(() => {}).then(() => contents._printToPDF(printSettings));
+  pendingPrintToPDF.set(contents, promise);
+  return promise;
+}
+
+WebContents.prototype.printToPDF = async function (options) {
+  return queuePrintToPDF(this, getPrintToPDFSettings(options));
+};
+
+WebContents.prototype.printToPDFFile = async function (filePath, options = {}) {
+  checkType(filePath, 'string', 'path');
+  return queuePrintToPDF(this, { ...getPrintToPDFSettings(options), path: path.resolve(filePath) });
+};
+
+// The PDF is read from the native side in chunks when the stream is consumed,
+// instead of being copied to a single Buffer.
+const kPDFStreamChunkSize = 1024 * 1024;
+WebContents.prototype.printToPDFStream = async function (options = {}) {
+  const reader = await queuePrintToPDF(this, { ...getPrintToPDFSettings(options), stream: true });
+  return new Readable({
+    read () {
+      const chunk = Buffer.allocUnsafe(Math.min(kPDFStreamChunkSize, reader.size));
+      const length = reader.read(chunk);
+      this.push(length > 0 ? chunk.subarray(0, length) : null);
+    }
+  });
 };
 
 // TODO(codebytere): deduplicate argument sanitization by moving rest of
@@ -437,12 +526,28 @@ WebContents.prototype.setWindowOpenHandler = function (handler: (details: Electr
   this._windowOpenHandler = handler;
 };
 
-WebContents.prototype._callWindowOpenHandler = function (event: Electron.Event, details: Electron.HandlerDetails): {browserWindowConstructorOptions: BrowserWindowConstructorOptions | null, outlivesOpener: boolean, createWindow?: Electron.CreateWindowFunction} {
+WebContents.prototype.setWindowOpenRules = function (rules: Electron.WindowOpenRule[]) {
+  this._setWindowOpenRules(rules);
+  this._windowOpenRules = rules.map(rule => ({ ...rule }));
+};
+
+WebContents.prototype._callWindowOpenHandler = function (event: Electron.Event, details: Electron.HandlerDetails, allowRule: number): {browserWindowConstructorOptions: BrowserWindowConstructorOptions | null, outlivesOpener: boolean, createWindow?: Electron.CreateWindowFunction} {
   const defaultResponse = {
     browserWindowConstructorOptions: null,
     outlivesOpener: false,
     createWindow: undefined
   };
+  // The 'allow' rules that match the URL take the place of the handler, the
+  // other rules are applied before the window gets here.
+  const rule = allowRule >= 0 ? this._windowOpenRules?.[allowRule] : undefined;
+  if (rule) {
+    return {
+      browserWindowConstructorOptions: typeof rule.overrideBrowserWindowOptions === 'object' ? rule.overrideBrowserWindowOptions : null,
+      outlivesOpener: typeof rule.outlivesOpener === 'boolean' ? rule.outlivesOpener : false,
+      createWindow: undefined
+    };
+  }
+
   if (!this._windowOpenHandler) {
     return defaultResponse;
   }
@@ -547,7 +652,18 @@ WebContents.prototype._init = function () {
   // Dispatch IPC messages to the ipc module.
   this.on('-ipc-message' as any, function (this: Electron.WebContents, event: Electron.IpcMainEvent, internal: boolean, channel: string, args: any[]) {
     addSenderToEvent(event, this);
-    if (internal) {
+    if (internal && channel === IPC_MESSAGES.BROWSER_IPC_BATCH) {
+      // Messages queued with ipcRenderer.sendBatched() arrive as a single
+      // mojo message and are dispatched in order with a shared event.
+      addReplyToEvent(event);
+      const maybeWebFrame = getWebFrameForEvent(event);
+      for (const [batchedChannel, batchedArgs] of args[0] as [string, any[]][]) {
+        this.emit('ipc-message', event, batchedChannel, ...batchedArgs);
+        maybeWebFrame && maybeWebFrame.ipc.emit(batchedChannel, event, ...batchedArgs);
+        ipc.emit(batchedChannel, event, ...batchedArgs);
+        ipcMain.emit(batchedChannel, event, ...batchedArgs);
+      }
+    } else if (internal) {
       ipcMainInternal.emit(channel, event, ...args);
     } else {
       addReplyToEvent(event);
@@ -635,7 +751,7 @@ WebContents.prototype._init = function () {
   if (this.getType() !== 'remote') {
     // Make new windows requested by links behave like "window.open".
     this.on('-new-window' as any, (event: Electron.Event, url: string, frameName: string, disposition: Electron.HandlerDetails['disposition'],
-      rawFeatures: string, referrer: Electron.Referrer, postData: PostData) => {
+      rawFeatures: string, referrer: Electron.Referrer, postData: PostData, allowRule: number) => {
       const postBody = postData ? {
         data: postData,
         ...parseContentTypeFormat(postData)
@@ -651,7 +767,7 @@ WebContents.prototype._init = function () {
 
       let result: ReturnType<typeof this._callWindowOpenHandler>;
       try {
-        result = this._callWindowOpenHandler(event, details);
+        result = this._callWindowOpenHandler(event, details, allowRule);
       } catch (err) {
         event.preventDefault();
         throw err;
@@ -676,7 +792,7 @@ WebContents.prototype._init = function () {
     let windowOpenOutlivesOpenerOption: boolean = false;
     let createWindow: Electron.CreateWindowFunction | undefined;
 
-    this.on('-will-add-new-contents' as any, (event: Electron.Event, url: string, frameName: string, rawFeatures: string, disposition: Electron.HandlerDetails['disposition'], referrer: Electron.Referrer, postData: PostData) => {
+    this.on('-will-add-new-contents' as any, (event: Electron.Event, url: string, frameName: string, rawFeatures: string, disposition: Electron.HandlerDetails['disposition'], referrer: Electron.Referrer, postData: PostData, allowRule: number) => {
       const postBody = postData ? {
         data: postData,
         ...parseContentTypeFormat(postData)
@@ -692,7 +808,7 @@ WebContents.prototype._init = function () {
 
       let result: ReturnType<typeof this._callWindowOpenHandler>;
       try {
-        result = this._callWindowOpenHandler(event, details);
+        result = this._callWindowOpenHandler(event, details, allowRule);
       } catch (err) {
         event.preventDefault();
         throw err;
@@ -872,6 +988,61 @@ export function create (options = {}): Electron.WebContents {
   return new (WebContents as any)(options);
 }
 
+export async function printToPDFFiles (jobs: Electron.PrintToPDFJob[], options: Electron.PrintToPDFFilesOptions = {}) {
+  if (!Array.isArray(jobs)) {
+    throw new TypeError('jobs must be an array');
+  }
+  const concurrency = options.concurrency ?? 4;
+  if (!Number.isInteger(concurrency) || concurrency < 1) {
+    throw new TypeError('concurrency must be a positive integer');
+  }
+
+  // Each worker prints the next job that no one took yet in its own
+  // offscreen WebContents, so that pages load and print in parallel.
+  const results: Electron.PrintToPDFJobResult[] = new Array(jobs.length);
+  let nextJob = 0;
+  const runWorker = async () => {
+    const contents = create({ ...options.webPreferences, offscreen: true });
+    try {
+      while (nextJob < jobs.length) {
+        const index = nextJob++;
+        const { url, path: filePath, options: printOptions } = jobs[index];
+        try {
+          const loadStart = performance.now();
+          await contents.loadURL(url);
+          const loadTime = performance.now() - loadStart;
+          const result = await contents.printToPDFFile(filePath, printOptions);
+          results[index] = { path: filePath, loadTime, ...result };
+        } catch (error: any) {
+          results[index] = { path: filePath, error: error.message };
+        }
+      }
+    } finally {
+      contents.destroy();
+    }
+  };
+
+  const workers = [];
+  for (let i = 0; i < Math.min(concurrency, jobs.length); i++) {
+    workers.push(runWorker());
+  }
+  await Promise.all(workers);
+  return results;
+}
+
+export async function executeJavaScriptInAllFrames (contents: Electron.WebContents[], code: string, userGesture?: boolean) {
+  if (!Array.isArray(contents)) {
+    throw new TypeError('contents must be an array');
+  }
+  const frames = await Promise.all(contents.map(async (contents) => {
+    await waitTillCanExecuteJavaScript(contents);
+    return contents.mainFrame.framesInSubtree;
+  }));
+  return executeJavaScriptInFrames(frames.flat(), String(code), !!userGesture);
+}
+
+export { registerScript, unregisterScript } from '@electron/internal/browser/script-registry';
+
 export function fromId (id: string) {
   return binding.fromId(id);
 }
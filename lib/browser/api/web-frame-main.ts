@@ -1,5 +1,7 @@
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
 import { IpcMainImpl } from '@electron/internal/browser/ipc-main-impl';
+import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
+import { executeRegisteredScript } from '@electron/internal/browser/script-registry';
 
 const { WebFrameMain, fromId } = process._linkedBinding('electron_browser_web_frame_main');
 
@@ -42,6 +44,10 @@ WebFrameMain.prototype.postMessage = function (...args) {
   this._postMessage(...args);
 };
 
+WebFrameMain.prototype.executeRegisteredScript = function (name, options) {
+  return executeRegisteredScript((command, ...args) => ipcMainUtils.invokeInWebFrameMain(this, command, ...args), name, options);
+};
+
 export default {
   fromId
 };
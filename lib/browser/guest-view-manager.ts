@@ -20,6 +20,9 @@ const supportedWebViewEvents = Object.keys(webViewEvents);
 
 const guestInstances = new Map<number, GuestInstance>();
 const embedderElementsMap = new Map<string, number>();
+// The guest instance ids of each embedder, so that handling an event of an
+// embedder doesn't go through the guests of all embedders.
+const embedderGuests = new Map<Electron.WebContents, Set<number>>();
 
 function makeWebPreferences (embedder: Electron.WebContents, params: Record<string, any>) {
   // parse the 'webpreferences' attribute string, if set
@@ -108,6 +111,12 @@ const createGuest = function (embedder: Electron.WebContents, embedderFrameId: n
     guest,
     embedder
   });
+  let guestIds = embedderGuests.get(embedder);
+  if (!guestIds) {
+    guestIds = new Set();
+    embedderGuests.set(embedder, guestIds);
+  }
+  guestIds.add(guestInstanceId);
 
   // Clear the guest from map when it is destroyed.
   guest.once('destroyed', () => {
@@ -214,6 +223,9 @@ const detachGuest = function (embedder: Electron.WebContents, guestInstanceId: n
 
   webViewManager.removeGuest(embedder, guestInstanceId);
   guestInstances.delete(guestInstanceId);
+  const guestIds = embedderGuests.get(embedder);
+  guestIds?.delete(guestInstanceId);
+  if (guestIds?.size === 0) embedderGuests.delete(embedder);
 
   const key = `${embedder.id}-${guestInstance.elementInstanceId}`;
   embedderElementsMap.delete(key);
@@ -230,11 +242,10 @@ const watchEmbedder = function (embedder: Electron.WebContents) {
 
   // Forward embedder window visibility change events to guest
   const onVisibilityChange = function (visibilityState: DocumentVisibilityState) {
-    for (const guestInstance of guestInstances.values()) {
+    for (const guestInstanceId of embedderGuests.get(embedder) ?? []) {
+      const guestInstance = guestInstances.get(guestInstanceId)!;
       guestInstance.visibilityState = visibilityState;
-      if (guestInstance.embedder === embedder) {
-        guestInstance.guest._sendInternal(IPC_MESSAGES.GUEST_INSTANCE_VISIBILITY_CHANGE, visibilityState);
-      }
+      guestInstance.guest._sendInternal(IPC_MESSAGES.GUEST_INSTANCE_VISIBILITY_CHANGE, visibilityState);
     }
   };
   embedder.on('-window-visibility-change' as any, onVisibilityChange);
@@ -243,10 +254,8 @@ const watchEmbedder = function (embedder: Electron.WebContents) {
     // Usually the guestInstances is cleared when guest is destroyed, but it
     // may happen that the embedder gets manually destroyed earlier than guest,
     // and the embedder will be invalid in the usual code path.
-    for (const [guestInstanceId, guestInstance] of guestInstances) {
-      if (guestInstance.embedder === embedder) {
-        detachGuest(embedder, guestInstanceId);
-      }
+    for (const guestInstanceId of [...embedderGuests.get(embedder) ?? []]) {
+      detachGuest(embedder, guestInstanceId);
     }
     // Clear the listeners.
     embedder.removeListener('-window-visibility-change' as any, onVisibilityChange);
@@ -29,10 +29,15 @@ process.on('uncaughtException', function (error) {
   // responsible for setting up the require hook for the "electron" module
   // so we import it inside the handler down here
   import('electron')
-    .then(({ dialog }) => {
+    .then(({ app, dialog }) => {
       const stack = error.stack ? error.stack : `${error.name}: ${error.message}`;
       const message = 'Uncaught Exception:\n' + stack;
-      dialog.showErrorBox('A JavaScript error occurred in the main process', message);
+      // Headless servers have no display to show the dialog on.
+      if (app.commandLine.hasSwitch('headless-server')) {
+        console.error(`A JavaScript error occurred in the main process\n${message}`);
+      } else {
+        dialog.showErrorBox('A JavaScript error occurred in the main process', message);
+      }
     });
 });
 
@@ -151,6 +156,9 @@ require('@electron/internal/browser/api/web-contents');
 // Load web-frame-main module to ensure it is populated on app ready
 require('@electron/internal/browser/api/web-frame-main');
 
+// Let the worker threads of the main process use some of its modules.
+require('@electron/internal/browser/worker-bridge').startWorkerBridge();
+
 // Required because `new BrowserWindow` calls some WebContentsView stuff, so
 // the inheritance needs to be set up before that happens.
 require('@electron/internal/browser/api/web-contents-view');
@@ -191,8 +199,10 @@ const { setDefaultApplicationMenu } = require('@electron/internal/browser/defaul
 // Create default menu.
 //
 // The |will-finish-launching| event is emitted before |ready| event, so default
-// menu is set before any user window is created.
-app.once('will-finish-launching', setDefaultApplicationMenu);
+// menu is set before any user window is created. Headless servers have no menus.
+if (!app.commandLine.hasSwitch('headless-server')) {
+  app.once('will-finish-launching', setDefaultApplicationMenu);
+}
 
 const { appCodeLoaded } = process;
 delete process.appCodeLoaded;
@@ -31,4 +31,39 @@ export class IpcMainImpl extends EventEmitter implements Electron.IpcMain {
   removeHandler (method: string) {
     this._invokeHandlers.delete(method);
   }
+
+  setSharedValue (key: string, value: any) {
+    process._linkedBinding('electron_browser_shared_values').setSharedValue(key, value);
+  }
+
+  deleteSharedValue (key: string) {
+    process._linkedBinding('electron_browser_shared_values').deleteSharedValue(key);
+  }
+
+  setSharedBuffer (name: string, data: ArrayBuffer | SharedArrayBuffer | ArrayBufferView, options?: { origins?: string[] }) {
+    const view = data instanceof ArrayBuffer || data instanceof SharedArrayBuffer ? new Uint8Array(data) : data;
+    process._linkedBinding('electron_browser_shared_values').setSharedBuffer(name, view, options?.origins ?? []);
+  }
+
+  deleteSharedBuffer (name: string) {
+    process._linkedBinding('electron_browser_shared_values').deleteSharedBuffer(name);
+  }
+
+  setChannelPriority (channel: string, priority: 'normal' | 'low') {
+    if (typeof channel !== 'string') {
+      throw new TypeError('channel must be a string');
+    }
+    if (priority !== 'normal' && priority !== 'low') {
+      throw new TypeError("priority must be 'normal' or 'low'");
+    }
+    process._linkedBinding('electron_browser_web_contents')._setIpcChannelPriority(channel, priority === 'low');
+  }
+
+  getStats (): Electron.IpcMainChannelStats[] {
+    return process._linkedBinding('electron_browser_web_contents')._getIpcStats();
+  }
+
+  resetStats () {
+    process._linkedBinding('electron_browser_web_contents')._resetIpcStats();
+  }
 }
@@ -36,3 +36,26 @@ export function invokeInWebContents<T> (sender: Electron.WebContents, command: s
     sender._sendInternal(command, requestId, ...args);
   });
 }
+
+export function invokeInWebFrameMain<T> (frame: Electron.WebFrameMain, command: string, ...args: any[]) {
+  return new Promise<T>((resolve, reject) => {
+    const requestId = ++nextId;
+    const channel = `${command}_RESPONSE_${requestId}`;
+    ipcMainInternal.on(channel, function handler (event, error: Error, result: any) {
+      if (event.processId !== frame.processId || event.frameId !== frame.routingId) {
+        console.error(`Reply to ${command} sent by unexpected frame (${event.processId}, ${event.frameId})`);
+        return;
+      }
+
+      ipcMainInternal.removeListener(channel, handler);
+
+      if (error) {
+        reject(error);
+      } else {
+        resolve(result);
+      }
+    });
+
+    frame._sendInternal(command, requestId, ...args);
+  });
+}
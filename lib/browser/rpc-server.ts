@@ -1,4 +1,5 @@
 import { clipboard } from 'electron/common';
+import * as crypto from 'crypto';
 import * as fs from 'fs';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
@@ -27,7 +28,7 @@ const allowedClipboardMethods = (() => {
     case 'darwin':
       return new Set(['readFindText', 'writeFindText']);
     case 'linux':
-      return new Set(Object.keys(clipboard));
+      return new Set(Object.keys(clipboard).filter(key => typeof (clipboard as any)[key] === 'function'));
     default:
       return new Set();
   }
@@ -41,22 +42,72 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_CLIPBOARD_SYNC, function (event, me
   return (clipboard as any)[method](...args);
 });
 
-const getPreloadScript = async function (preloadPath: string) {
-  let preloadSrc = null;
-  let preloadError = null;
+const allowedAsyncClipboardMethods = new Set(process.platform === 'linux' ? ['readImageAsync'] : []);
+
+ipcMainInternal.handle(IPC_MESSAGES.BROWSER_CLIPBOARD_ASYNC, function (event, method: string, ...args: any[]) {
+  if (!allowedAsyncClipboardMethods.has(method)) {
+    throw new Error(`Invalid method: ${method}`);
+  }
+
+  return (clipboard as any)[method](...args);
+});
+
+// Sets |key| as the most recent entry of |map| and drops the oldest entries
+// past |max|, a Map iterates in insertion order.
+const setMostRecent = function <K, V> (map: Map<K, V>, key: K, value: V, max: number) {
+  map.delete(key);
+  map.set(key, value);
+  for (const oldKey of map.keys()) {
+    if (map.size <= max) break;
+    map.delete(oldKey);
+  }
+};
+
+// The sources of the sandboxed preload scripts, which are only read again
+// when their file changed, so that the windows sharing a preload script don't
+// each read and hash it.
+const kMaxPreloadSources = 32;
+const preloadSources = new Map<string, { mtimeMs: number, size: number, preloadSrc: string, preloadHash: string }>();
+
+const readPreloadScript = async function (preloadPath: string) {
+  const { mtimeMs, size } = await fs.promises.stat(preloadPath);
+  const cached = preloadSources.get(preloadPath);
+  if (cached && cached.mtimeMs === mtimeMs && cached.size === size) {
+    return cached;
+  }
+  const preloadSrc = await fs.promises.readFile(preloadPath, 'utf8');
+  const preloadHash = crypto.createHash('sha256').update(preloadSrc).digest('hex');
+  const source = { mtimeMs, size, preloadSrc, preloadHash };
+  setMostRecent(preloadSources, preloadPath, source, kMaxPreloadSources);
+  return source;
+};
+
+// The code caches of the sandboxed preload scripts of each session, produced
+// by the first renderer that runs a script and used by the next ones. They are
+// keyed by origin, like the code cache of Blink, so that a renderer can't hand
+// its cache to the renderers of other sites.
+const kMaxPreloadCodeCaches = 32;
+const preloadCodeCaches = new WeakMap<Electron.Session, Map<string, Uint8Array>>();
+
+const getPreloadCodeCacheKey = (event: ElectronInternal.IpcMainInternalEvent, preloadHash: string) => {
+  return `${event.senderFrame?.origin}\n${preloadHash}`;
+};
+
+const getPreloadScript = async function (event: ElectronInternal.IpcMainInternalEvent, preloadPath: string) {
   try {
-    preloadSrc = await fs.promises.readFile(preloadPath, 'utf8');
+    const { preloadSrc, preloadHash } = await readPreloadScript(preloadPath);
+    const codeCache = preloadCodeCaches.get(event.sender.session)?.get(getPreloadCodeCacheKey(event, preloadHash));
+    return { preloadPath, preloadSrc, preloadError: null, preloadHash, codeCache };
   } catch (error) {
-    preloadError = error;
+    return { preloadPath, preloadSrc: null, preloadError: error };
   }
-  return { preloadPath, preloadSrc, preloadError };
 };
 
 ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_SANDBOX_LOAD, async function (event) {
   const preloadPaths = event.sender._getPreloadPaths();
 
   return {
-    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(path))),
+    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(event, path))),
     process: {
       arch: process.arch,
       platform: process.platform,
@@ -72,6 +123,17 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_NONSANDBOX_LOAD, function (event) {
   return { preloadPaths: event.sender._getPreloadPaths() };
 });
 
+ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_CODE_CACHE, function (event, preloadHash: string, codeCache: Uint8Array) {
+  if (typeof preloadHash !== 'string' || !(codeCache instanceof Uint8Array)) return;
+  const { session } = event.sender;
+  let caches = preloadCodeCaches.get(session);
+  if (!caches) {
+    caches = new Map();
+    preloadCodeCaches.set(session, caches);
+  }
+  setMostRecent(caches, getPreloadCodeCacheKey(event, preloadHash), codeCache, kMaxPreloadCodeCaches);
+});
+
 ipcMainInternal.on(IPC_MESSAGES.BROWSER_PRELOAD_ERROR, function (event, preloadPath: string, error: Error) {
   event.sender.emit('preload-error', event, preloadPath, error);
 });
@@ -0,0 +1,37 @@
+import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
+
+type Invoke = (command: string, ...args: any[]) => Promise<any>;
+
+const scripts = new Map<string, { code: string, version: number }>();
+let nextVersion = 0;
+
+export function registerScript (name: string, code: string) {
+  if (typeof name !== 'string' || !name) {
+    throw new TypeError('name must be a non-empty string');
+  }
+  if (typeof code !== 'string') {
+    throw new TypeError('code must be a string');
+  }
+  scripts.set(name, { code, version: ++nextVersion });
+}
+
+export function unregisterScript (name: string) {
+  return scripts.delete(name);
+}
+
+// The source is only sent to the frames that don't have this version of the
+// script yet. Each run compiles the same source at the same URL, which V8
+// finds in the compilation cache of the renderer process.
+export async function executeRegisteredScript (invoke: Invoke, name: string, options: Electron.ExecuteRegisteredScriptOptions = {}) {
+  const script = scripts.get(name);
+  if (!script) {
+    throw new Error(`No script is registered as '${name}'`);
+  }
+  const { worldId = 0, userGesture = false } = options;
+  const run = (code: string | null) => invoke(IPC_MESSAGES.RENDERER_EXECUTE_REGISTERED_SCRIPT, name, script.version, code, worldId, !!userGesture);
+  let reply = await run(null);
+  if (!reply.cached) {
+    reply = await run(script.code);
+  }
+  return reply.result;
+}
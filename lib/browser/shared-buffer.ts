@@ -0,0 +1,26 @@
+import { EventEmitter } from 'events';
+
+export class SharedBuffer extends EventEmitter implements Electron.SharedBuffer {
+  #handle: ElectronInternal.SharedBuffer;
+  constructor (handle: ElectronInternal.SharedBuffer) {
+    super();
+    this.#handle = handle;
+    this.#handle.emit = (channel: string | symbol) => this.emit(channel);
+  }
+
+  get capacity () {
+    return this.#handle.capacity;
+  }
+
+  write (data: ArrayBufferView) {
+    return this.#handle.write(data);
+  }
+
+  read () {
+    return this.#handle.read();
+  }
+
+  close () {
+    this.#handle.close();
+  }
+}
@@ -0,0 +1,143 @@
+import { ipcMain, net, protocol, safeStorage } from 'electron/main';
+import type { IpcMainInvokeEvent } from 'electron/main';
+import {
+  WORKER_BRIDGE_CONTROL_CHANNEL,
+  WORKER_BRIDGE_ENVIRONMENT_DATA,
+  workerBridgeChannel,
+  serializeRequest,
+  deserializeRequest,
+  serializeResponse,
+  deserializeResponse,
+  postReply,
+  toBuffer
+} from '@electron/internal/common/worker-bridge';
+import type { WorkerBridgeControlMessage, WorkerBridgeMessage, SerializedRequest } from '@electron/internal/common/worker-bridge';
+
+import { BroadcastChannel, setEnvironmentData } from 'worker_threads';
+import type { Worker } from 'worker_threads';
+
+class WorkerConnection {
+  readonly toMain: BroadcastChannel;
+  readonly toWorker: BroadcastChannel;
+  readonly ipcChannels = new Set<string>();
+  readonly schemes = new Set<string>();
+  private readonly pendingInvokes = new Map<number, { resolve: (result: any) => void, reject: (error: any) => void }>();
+  private nextId = 0;
+
+  constructor (threadId: number) {
+    this.toMain = new BroadcastChannel(workerBridgeChannel(threadId, 'main'));
+    this.toMain.unref();
+    this.toMain.onmessage = (event) => this.onMessage((event as MessageEvent).data);
+    this.toWorker = new BroadcastChannel(workerBridgeChannel(threadId, 'worker'));
+    this.toWorker.unref();
+  }
+
+  invoke (kind: 'ipc' | 'protocol', name: string, args: any[]): Promise<any> {
+    const id = this.nextId++;
+    return new Promise((resolve, reject) => {
+      this.pendingInvokes.set(id, { resolve, reject });
+      this.toWorker.postMessage({ type: 'invoke', id, kind, name, args } as WorkerBridgeMessage);
+    });
+  }
+
+  close () {
+    for (const channel of this.ipcChannels) ipcMain.removeHandler(channel);
+    for (const scheme of this.schemes) protocol.unhandle(scheme);
+    for (const { reject } of this.pendingInvokes.values()) reject(new Error('The worker thread exited'));
+    this.pendingInvokes.clear();
+    this.toMain.close();
+    this.toWorker.close();
+  }
+
+  private async onMessage (message: WorkerBridgeMessage) {
+    if (message.type === 'reply') {
+      const pending = this.pendingInvokes.get(message.id);
+      if (!pending) return;
+      this.pendingInvokes.delete(message.id);
+      if ('error' in message) pending.reject(message.error);
+      else pending.resolve(message.result);
+    } else if (message.type === 'call') {
+      const method = methods[message.method];
+      try {
+        if (!method) throw new Error(`Unknown method '${message.method}'`);
+        const result = await method(this, ...message.args);
+        postReply(this.toWorker, { type: 'reply', id: message.id }, { result });
+      } catch (error) {
+        postReply(this.toWorker, { type: 'reply', id: message.id }, { error });
+      }
+    }
+  }
+}
+
+// What the handlers in workers get instead of the IpcMainInvokeEvent, which
+// can't be sent to other threads.
+const serializeInvokeEvent = (event: IpcMainInvokeEvent) => ({
+  processId: event.processId,
+  frameId: event.frameId,
+  senderId: event.sender.id
+});
+
+const methods: Record<string, (connection: WorkerConnection, ...args: any[]) => any> = {
+  'ipcMain.handle' (connection, channel: string) {
+    ipcMain.handle(channel, (event, ...args) =>
+      connection.invoke('ipc', channel, [serializeInvokeEvent(event), ...args]));
+    connection.ipcChannels.add(channel);
+  },
+  'ipcMain.removeHandler' (connection, channel: string) {
+    if (connection.ipcChannels.delete(channel)) ipcMain.removeHandler(channel);
+  },
+  'protocol.handle' (connection, scheme: string) {
+    protocol.handle(scheme, async (request) =>
+      deserializeResponse(await connection.invoke('protocol', scheme, [await serializeRequest(request)])));
+    connection.schemes.add(scheme);
+  },
+  'protocol.unhandle' (connection, scheme: string) {
+    if (connection.schemes.delete(scheme)) protocol.unhandle(scheme);
+  },
+  'protocol.isProtocolHandled' (connection, scheme: string) {
+    return protocol.isProtocolHandled(scheme);
+  },
+  async 'net.fetch' (connection, request: SerializedRequest, options: { bypassCustomProtocolHandlers?: boolean }) {
+    return serializeResponse(await net.fetch(deserializeRequest(request), options));
+  },
+  'safeStorage.isEncryptionAvailable' () {
+    return safeStorage.isEncryptionAvailable();
+  },
+  'safeStorage.encryptString' (connection, plainText: string) {
+    return safeStorage.encryptString(plainText);
+  },
+  'safeStorage.decryptString' (connection, encrypted: Uint8Array) {
+    return safeStorage.decryptString(toBuffer(encrypted));
+  }
+};
+
+const connections = new Map<number, WorkerConnection>();
+
+function disconnect (threadId: number) {
+  connections.get(threadId)?.close();
+  connections.delete(threadId);
+}
+
+export function startWorkerBridge () {
+  setEnvironmentData(WORKER_BRIDGE_ENVIRONMENT_DATA, true);
+
+  const control = new BroadcastChannel(WORKER_BRIDGE_CONTROL_CHANNEL);
+  control.unref();
+  control.onmessage = (event) => {
+    const message = (event as MessageEvent).data as WorkerBridgeControlMessage;
+    if (message.type === 'connect') {
+      disconnect(message.threadId);
+      const connection = new WorkerConnection(message.threadId);
+      connections.set(message.threadId, connection);
+      connection.toWorker.postMessage({ type: 'connected' } as WorkerBridgeMessage);
+    } else if (message.type === 'exit') {
+      disconnect(message.threadId);
+    }
+  };
+
+  // The workers of workers are reported by their parents.
+  process.on('worker', (worker: Worker) => {
+    const { threadId } = worker;
+    worker.once('exit', () => disconnect(threadId));
+  });
+}
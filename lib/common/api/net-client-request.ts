@@ -1,3 +1,4 @@
+import * as path from 'path';
 import * as url from 'url';
 import { Readable, Writable } from 'stream';
 import type {
@@ -12,6 +13,8 @@ const {
 } = process._linkedBinding('electron_common_net');
 
 const kHttpProtocols = new Set(['http:', 'https:']);
+const kBodyHighWaterMark = 1024 * 1024;
+const kRequestPriorities = new Set(['throttled', 'idle', 'lowest', 'low', 'medium', 'highest']);
 
 // set of headers that Node.js discards duplicates for
 // see https://nodejs.org/api/http.html#http_message_headers
@@ -89,6 +92,10 @@ class IncomingMessage extends Readable {
     return this._responseHead.httpVersion.minor;
   }
 
+  get connectionInfo () {
+    return this._responseHead.connectionInfo;
+  }
+
   get rawTrailers () {
     throw new Error('HTTP trailers are not supported');
   }
@@ -272,6 +279,14 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     throw new Error('redirect mode should be one of follow, error or manual');
   }
 
+  if (options.priority != null && !kRequestPriorities.has(options.priority)) {
+    throw new Error(`priority should be one of ${[...kRequestPriorities].join(', ')}`);
+  }
+
+  if (options.downloadToFile != null && (typeof options.downloadToFile !== 'string' || !path.isAbsolute(options.downloadToFile))) {
+    throw new TypeError('downloadToFile must be an absolute path');
+  }
+
   if (options.headers != null && typeof options.headers !== 'object') {
     throw new TypeError('headers must be an object');
   }
@@ -287,6 +302,9 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     origin: options.origin,
     referrerPolicy: options.referrerPolicy,
     cache: options.cache,
+    priority: options.priority,
+    priorityIncremental: options.priorityIncremental,
+    downloadToFile: options.downloadToFile,
     allowNonHttpProtocols: Object.hasOwn(options, kAllowNonHttpProtocols)
   };
   const headers: Record<string, string | string[]> = options.headers || {};
@@ -325,7 +343,9 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
   _response?: IncomingMessage;
 
   constructor (options: ClientRequestConstructorOptions | string, callback?: (message: IncomingMessage) => void) {
-    super({ autoDestroy: true });
+    // The chunks that are written while the body is busy are buffered and
+    // passed on in a single write, so allow more than the default 16KiB.
+    super({ autoDestroy: true, highWaterMark: kBodyHighWaterMark });
 
     if (callback) {
       this.once('response', callback);
@@ -394,6 +414,29 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     delete this._urlLoaderOptions.headers[key];
   }
 
+  uploadFile (filePath: string, options: Electron.UploadFileOptions = {}) {
+    if (this._started || this._firstWrite) {
+      throw new Error('uploadFile can only be called before the request is started');
+    }
+    if (this._chunkedEncoding) {
+      throw new Error('uploadFile can not be used with chunkedEncoding');
+    }
+    if (typeof filePath !== 'string' || !path.isAbsolute(filePath)) {
+      throw new TypeError('filePath must be an absolute path');
+    }
+    for (const key of ['offset', 'length'] as const) {
+      if (options[key] != null && !(Number.isSafeInteger(options[key]) && options[key]! >= 0)) {
+        throw new TypeError(`${key} must be a non-negative integer`);
+      }
+    }
+    this._urlLoaderOptions.uploadFile = { path: filePath, offset: options.offset, length: options.length };
+    this.end();
+  }
+
+  _writev (chunks: Array<{ chunk: Buffer, encoding: BufferEncoding }>, callback: () => void) {
+    this._write(Buffer.concat(chunks.map(({ chunk }) => chunk)), 'buffer', callback);
+  }
+
   _write (chunk: Buffer, encoding: BufferEncoding, callback: () => void) {
     this._firstWrite = true;
     if (!this._body) {
@@ -496,7 +539,7 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
 
     this._urlLoader.on('download-progress', (event, current) => {
       if (this._response) {
-        this._response.emit('download-progress', current); // Undocumented, for now
+        this._response.emit('download-progress', current);
       }
     });
   }
@@ -0,0 +1,100 @@
+// Shared by the two ends of the bridge that lets the worker threads of the main
+// process use some of its modules, see lib/browser/worker-bridge.ts and
+// lib/node/worker-bridge.ts.
+//
+// The native bindings of the main process can only be used on its main thread,
+// so the calls are sent there over BroadcastChannels: workers announce
+// themselves on the control channel, and then talk to the main thread over two
+// channels of their own.
+
+// Set with setEnvironmentData() on the main thread, and so inherited by all the
+// worker threads started from it or from its workers.
+export const WORKER_BRIDGE_ENVIRONMENT_DATA = 'electron:main-process-worker';
+
+export const WORKER_BRIDGE_CONTROL_CHANNEL = 'electron:worker-bridge';
+
+export const workerBridgeChannel = (threadId: number, to: 'main' | 'worker') =>
+  `electron:worker-bridge:${threadId}:${to}`;
+
+export type WorkerBridgeControlMessage =
+  | { type: 'connect', threadId: number }
+  | { type: 'exit', threadId: number };
+
+export type WorkerBridgeReply = { result: any } | { error: any };
+
+export type WorkerBridgeMessage =
+  | { type: 'connected' }
+  // Worker -> main.
+  | { type: 'call', id: number, method: string, args: any[] }
+  // Main -> worker.
+  | { type: 'invoke', id: number, kind: 'ipc' | 'protocol', name: string, args: any[] }
+  | ({ type: 'reply', id: number } & WorkerBridgeReply);
+
+export interface SerializedRequest {
+  url: string;
+  method: string;
+  headers: [string, string][];
+  body: ArrayBuffer | null;
+  redirect: RequestRedirect;
+  credentials: RequestCredentials;
+  cache: RequestCache;
+}
+
+export interface SerializedResponse {
+  url: string;
+  status: number;
+  statusText: string;
+  headers: [string, string][];
+  body: ArrayBuffer | null;
+}
+
+// The statuses whose responses must be constructed without a body.
+const kNullBodyStatuses = new Set([101, 103, 204, 205, 304]);
+
+export async function serializeRequest (request: Request): Promise<SerializedRequest> {
+  return {
+    url: request.url,
+    method: request.method,
+    headers: [...request.headers],
+    body: request.body ? await request.arrayBuffer() : null,
+    redirect: request.redirect,
+    credentials: request.credentials,
+    cache: request.cache
+  };
+}
+
+export function deserializeRequest (request: SerializedRequest): Request {
+  const { url, ...init } = request;
+  return new Request(url, init);
+}
+
+export async function serializeResponse (response: Response): Promise<SerializedResponse> {
+  return {
+    url: response.url,
+    status: response.status,
+    statusText: response.statusText,
+    headers: [...response.headers],
+    body: response.body ? await response.arrayBuffer() : null
+  };
+}
+
+export function deserializeResponse (response: SerializedResponse): Response {
+  const { url, status, statusText, headers, body } = response;
+  const result = new Response(kNullBodyStatuses.has(status) ? null : body, { status, statusText, headers });
+  if (url) Object.defineProperty(result, 'url', { value: url });
+  return result;
+}
+
+// Errors are structured-cloneable, but what a handler throws might not be.
+export function postReply (channel: { postMessage (message: any): void }, message: { type: 'reply', id: number }, reply: WorkerBridgeReply) {
+  try {
+    channel.postMessage({ ...message, ...reply });
+  } catch {
+    const error = new Error('error' in reply ? String(reply.error) : 'The result could not be cloned');
+    channel.postMessage({ ...message, error });
+  }
+}
+
+export function toBuffer (data: Uint8Array): Buffer {
+  return Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+}
@@ -278,6 +278,99 @@ const makePromiseFunction = function (orig: Function, pathArgumentIndex: number)
 };
 
 // Override fs APIs.
+const cjsParameters = ['exports', 'require', 'module', '__filename', '__dirname'];
+
+// A cheap, non-cryptographic hash used to derive cache file names without
+// having to load the crypto module during startup.
+const fnv1a = (value: string) => {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < value.length; i++) {
+    hash ^= value.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193) >>> 0;
+  }
+  return hash.toString(16).padStart(8, '0');
+};
+
+const installCodeCache = (fs: Record<string, any>, cacheDirectory: string) => {
+  const vm = require('vm') as typeof import('vm');
+  const versionKey = `${process.versions.electron}:${process.versions.v8}:${process.arch}`;
+  const wrap = (Module as any).wrap as (script: string) => string;
+  const defaultWrapper = wrap('');
+  let cacheDirectoryCreated = false;
+
+  // Each cache file holds a uint32 key length, the key and the V8 cache data.
+  const readCache = (cachePath: string, key: string) => {
+    try {
+      const data: Buffer = fs.readFileSync(cachePath);
+      const keyLength = data.readUInt32LE(0);
+      if (data.toString('utf8', 4, 4 + keyLength) !== key) return undefined;
+      return data.subarray(4 + keyLength);
+    } catch {
+      return undefined;
+    }
+  };
+
+  const writeCache = (cachePath: string, key: string, cachedData: Buffer) => {
+    const keyBuffer = Buffer.from(key);
+    const lengthBuffer = Buffer.alloc(4);
+    lengthBuffer.writeUInt32LE(keyBuffer.length);
+    if (!cacheDirectoryCreated) {
+      fs.mkdirSync(cacheDirectory, { recursive: true });
+      cacheDirectoryCreated = true;
+    }
+    fs.writeFile(cachePath, Buffer.concat([lengthBuffer, keyBuffer, cachedData]), () => {});
+  };
+
+  const { _compile } = Module.prototype as any;
+  (Module.prototype as any)._compile = function (this: NodeJS.Module, content: string, filename: string) {
+    const pathInfo = splitPath(filename);
+    // Dynamic import() needs Node's own compile path to get a module loader,
+    // and a patched Module.wrap means someone else controls compilation.
+    if (!pathInfo.isAsar || /\bimport\s*\(/.test(content) || (Module as any).wrap('') !== defaultWrapper) {
+      return _compile.apply(this, arguments);
+    }
+
+    const { asarPath, filePath } = pathInfo;
+    const archive = getOrCreateArchive(asarPath);
+    const info = archive && archive.getFileInfo(filePath);
+    if (!archive || !info) return _compile.apply(this, arguments);
+
+    const key = `${versionKey}:${archive.getCacheKey()}:${filePath}:${info.integrity ? info.integrity.hash : ''}`;
+    const cachePath = path.join(cacheDirectory, `${fnv1a(asarPath + '\0' + filePath)}.bin`);
+    const cachedData = readCache(cachePath, key);
+
+    let compiledWrapper: Function & { cachedData?: Buffer, cachedDataRejected?: boolean };
+    try {
+      compiledWrapper = vm.compileFunction(content, cjsParameters, {
+        filename,
+        cachedData,
+        produceCachedData: !cachedData
+      });
+    } catch {
+      // Let Node's loader produce its usual syntax error.
+      return _compile.apply(this, arguments);
+    }
+
+    if (!cachedData && compiledWrapper.cachedData) {
+      writeCache(cachePath, key, compiledWrapper.cachedData);
+    } else if (compiledWrapper.cachedDataRejected) {
+      fs.rmSync(cachePath, { force: true });
+    }
+
+    const mod = this as any;
+    const require = function (id: string) { return mod.require(id); } as NodeJS.Require;
+    require.resolve = function (request: string, options?: { paths?: string[] }) {
+      return Module._resolveFilename(request, mod, false, options as any);
+    } as NodeJS.RequireResolve;
+    require.main = process.mainModule;
+    require.extensions = Module._extensions as any;
+    require.cache = Module._cache;
+
+    const exports = mod.exports;
+    return Reflect.apply(compiledWrapper, exports, [exports, require, mod, filename, path.dirname(filename)]);
+  };
+};
+
 export const wrapFsWithAsar = (fs: Record<string, any>) => {
   const logFDs = new Map<string, number>();
   const logASARAccess = (asarPath: string, filePath: string, offset: number) => {
@@ -615,6 +708,33 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
         return fs.readFile(realPath, options, callback);
       }
 
+      const mapped = info.compressed ? archive.readCompressedFile(filePath) : archive.readFileMapped(filePath);
+      if (mapped) {
+        logASARAccess(asarPath, filePath, info.offset);
+        nextTick(callback, [null, encoding ? mapped.toString(encoding) : mapped]);
+        return;
+      } else if (info.compressed) {
+        const error = createError(AsarError.INVALID_ARCHIVE, { asarPath });
+        nextTick(callback, [error]);
+        return;
+      }
+
+      // Read on the thread pool, along with the other files requested at the
+      // same time, instead of taking a slot of the libuv threadpool.
+      const pending = archive.readFileAsync(filePath);
+      if (pending) {
+        logASARAccess(asarPath, filePath, info.offset);
+        pending.then((contents) => {
+          if (!contents) {
+            const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
+            nextTick(callback, [error]);
+          } else {
+            nextTick(callback, [null, encoding ? contents.toString(encoding) : contents]);
+          }
+        });
+        return;
+      }
+
       const buffer = Buffer.alloc(info.size);
       const fd = archive.getFdAndValidateIntegrityLater();
       if (!(fd >= 0)) {
@@ -679,6 +799,14 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     }
 
     const { encoding } = options;
+    const mapped = info.compressed ? archive.readCompressedFile(filePath) : archive.readFileMapped(filePath);
+    if (mapped) {
+      logASARAccess(asarPath, filePath, info.offset);
+      return (encoding) ? mapped.toString(encoding) : mapped;
+    } else if (info.compressed) {
+      throw createError(AsarError.INVALID_ARCHIVE, { asarPath });
+    }
+
     const buffer = Buffer.alloc(info.size);
     const fd = archive.getFdAndValidateIntegrityLater();
     if (!(fd >= 0)) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
@@ -692,6 +820,30 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
   type ReaddirOptions = { encoding: BufferEncoding | null; withFileTypes?: false, recursive?: false } | undefined | null;
   type ReaddirCallback = (err: NodeJS.ErrnoException | null, files: string[]) => void;
 
+  // The types of the entries of an archive directory come out of a single
+  // native walk of the header instead of a stat() per entry.
+  const readAsarDirents = (archive: NodeJS.AsarArchive, filePath: string) => {
+    const entries = archive.readdirWithTypes(filePath, false);
+    if (!entries) return null;
+    const [names, types] = entries;
+    return names.map((name, i) => new fs.Dirent(name, types[i]));
+  };
+
+  // Lists the whole tree under an archive directory at once, in the format of
+  // the recursive fs.readdir(): dirents whose path is their parent directory,
+  // or paths relative to |basePath|.
+  const readAsarDirRecursive = (archive: NodeJS.AsarArchive, filePath: string, dirPath: string, withFileTypes: boolean, basePath: string) => {
+    const entries = archive.readdirWithTypes(filePath, true);
+    if (!entries) return null;
+    const [names, types] = entries;
+    return names.map((name, i) => {
+      const entryPath = path.join(dirPath, name);
+      return withFileTypes
+        ? getDirent(path.dirname(entryPath), path.basename(entryPath), types[i])
+        : path.relative(basePath, entryPath);
+    });
+  };
+
   const { readdir } = fs;
   fs.readdir = function (pathArgument: string, options: ReaddirOptions, callback: ReaddirCallback) {
     callback = typeof options === 'function' ? options : callback;
@@ -720,6 +872,17 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return;
     }
 
+    if (options?.withFileTypes) {
+      const dirents = readAsarDirents(archive, filePath);
+      if (!dirents) {
+        const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
+        nextTick(callback!, [error]);
+        return;
+      }
+      nextTick(callback!, [null, dirents]);
+      return;
+    }
+
     const files = archive.readdir(filePath);
     if (!files) {
       const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
@@ -727,22 +890,6 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return;
     }
 
-    if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          const error = createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-          nextTick(callback!, [error]);
-          return;
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
-      }
-      nextTick(callback!, [null, dirents]);
-      return;
-    }
-
     nextTick(callback!, [null, files]);
   };
 
@@ -768,24 +915,19 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return Promise.reject(createError(AsarError.INVALID_ARCHIVE, { asarPath }));
     }
 
-    const files = archive.readdir(filePath);
-    if (!files) {
-      return Promise.reject(createError(AsarError.NOT_FOUND, { asarPath, filePath }));
-    }
-
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          throw createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const dirents = readAsarDirents(archive, filePath);
+      if (!dirents) {
+        return Promise.reject(createError(AsarError.NOT_FOUND, { asarPath, filePath }));
       }
       return Promise.resolve(dirents);
     }
 
+    const files = archive.readdir(filePath);
+    if (!files) {
+      return Promise.reject(createError(AsarError.NOT_FOUND, { asarPath, filePath }));
+    }
+
     return Promise.resolve(files);
   };
 
@@ -811,24 +953,19 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       throw createError(AsarError.INVALID_ARCHIVE, { asarPath });
     }
 
-    const files = archive.readdir(filePath);
-    if (!files) {
-      throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
-    }
-
     if (options?.withFileTypes) {
-      const dirents = [];
-      for (const file of files) {
-        const childPath = path.join(filePath, file);
-        const stats = archive.stat(childPath);
-        if (!stats) {
-          throw createError(AsarError.NOT_FOUND, { asarPath, filePath: childPath });
-        }
-        dirents.push(new fs.Dirent(file, stats.type));
+      const dirents = readAsarDirents(archive, filePath);
+      if (!dirents) {
+        throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
       }
       return dirents;
     }
 
+    const files = archive.readdir(filePath);
+    if (!files) {
+      throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
+    }
+
     return files;
   };
 
@@ -851,6 +988,15 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
       return [str, str.length > 0];
     }
 
+    const mapped = info.compressed ? archive.readCompressedFile(filePath) : archive.readFileMapped(filePath);
+    if (mapped) {
+      logASARAccess(asarPath, filePath, info.offset);
+      const str = mapped.toString('utf8');
+      return [str, str.length > 0];
+    } else if (info.compressed) {
+      return [];
+    }
+
     const buffer = Buffer.alloc(info.size);
     const fd = archive.getFdAndValidateIntegrityLater();
     if (!(fd >= 0)) return [];
@@ -886,32 +1032,19 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     let queue: [string, string[]][] = [];
     const withFileTypes = Boolean(options?.withFileTypes);
 
-    let initialItem = [];
     if (pathInfo.isAsar) {
       const archive = getOrCreateArchive(pathInfo.asarPath);
       if (!archive) return result;
-      const files = archive.readdir(pathInfo.filePath);
-      if (!files) return result;
-
-      // If we're in an asar dir, we need to ensure the result is in the same format as the
-      // native call to readdir withFileTypes i.e. an array of arrays.
-      initialItem = files;
-      if (withFileTypes) {
-        initialItem = [
-          [...initialItem], initialItem.map((p: string) => {
-            return internalBinding('fs').internalModuleStat(path.join(originalPath, p));
-          })
-        ];
-      }
-    } else {
-      initialItem = await binding.readdir(
-        path.toNamespacedPath(originalPath),
-        options!.encoding,
-        withFileTypes,
-        kUsePromises
-      );
+      return readAsarDirRecursive(archive, pathInfo.filePath, originalPath, withFileTypes, originalPath) ?? result;
     }
 
+    const initialItem = await binding.readdir(
+      path.toNamespacedPath(originalPath),
+      options!.encoding,
+      withFileTypes,
+      kUsePromises
+    );
+
     queue = [[originalPath, initialItem]];
 
     if (withFileTypes) {
@@ -923,26 +1056,21 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
           if (dirent.isDirectory()) {
             const direntPath = path.join(pathArg, dirent.name);
             const info = splitPath(direntPath);
-            let readdirResult;
             if (info.isAsar) {
               const archive = getOrCreateArchive(info.asarPath);
               if (!archive) continue;
-              const files = archive.readdir(info.filePath);
-              if (!files) continue;
-
-              readdirResult = [
-                [...files], files.map((p: string) => {
-                  return internalBinding('fs').internalModuleStat(path.join(direntPath, p));
-                })
-              ];
-            } else {
-              readdirResult = await binding.readdir(
-                direntPath,
-                options!.encoding,
-                true,
-                kUsePromises
-              );
+              const entries = readAsarDirRecursive(archive, info.filePath, direntPath, true, originalPath);
+              if (entries) {
+                for (const entry of entries) result.push(entry);
+              }
+              continue;
             }
+            const readdirResult = await binding.readdir(
+              direntPath,
+              options!.encoding,
+              true,
+              kUsePromises
+            );
             queue.push([direntPath, readdirResult]);
           }
         }
@@ -958,21 +1086,20 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
 
           if (stat === 1) {
             const subPathInfo = splitPath(direntPath);
-            let item = [];
             if (subPathInfo.isAsar) {
               const archive = getOrCreateArchive(subPathInfo.asarPath);
               if (!archive) return;
-              const files = archive.readdir(subPathInfo.filePath);
-              if (!files) return result;
-              item = files;
-            } else {
-              item = await binding.readdir(
-                path.toNamespacedPath(direntPath),
-                options!.encoding,
-                false,
-                kUsePromises
-              );
+              const entries = readAsarDirRecursive(archive, subPathInfo.filePath, direntPath, false, originalPath);
+              if (!entries) return result;
+              for (const entry of entries) result.push(entry);
+              continue;
             }
+            const item = await binding.readdir(
+              path.toNamespacedPath(direntPath),
+              options!.encoding,
+              false,
+              kUsePromises
+            );
             queue.push([direntPath, item]);
           }
         }
@@ -990,33 +1117,25 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     const pathsQueue = [basePath];
 
     function read (pathArg: string) {
-      let readdirResult;
-
       const pathInfo = splitPath(pathArg);
       if (pathInfo.isAsar) {
         const { asarPath, filePath } = pathInfo;
         const archive = getOrCreateArchive(asarPath);
         if (!archive) return;
 
-        readdirResult = archive.readdir(filePath);
-        if (!readdirResult) return;
-        // If we're in an asar dir, we need to ensure the result is in the same format as the
-        // native call to readdir withFileTypes i.e. an array of arrays.
-        if (withFileTypes) {
-          readdirResult = [
-            [...readdirResult], readdirResult.map((p: string) => {
-              return internalBinding('fs').internalModuleStat(path.join(pathArg, p));
-            })
-          ];
-        }
-      } else {
-        readdirResult = binding.readdir(
-          path.toNamespacedPath(pathArg),
-          encoding,
-          withFileTypes
-        );
+        // The whole tree under an archive directory is read at once.
+        const entries = readAsarDirRecursive(archive, filePath, pathArg, withFileTypes, basePath);
+        if (!entries) return;
+        for (const entry of entries) readdirResults.push(entry);
+        return;
       }
 
+      const readdirResult = binding.readdir(
+        path.toNamespacedPath(pathArg),
+        encoding,
+        withFileTypes
+      );
+
       if (readdirResult === undefined) return;
 
       if (withFileTypes) {
@@ -1127,6 +1246,32 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
     overrideAPISync(childProcess, 'execFileSync');
   };
 
+  // Archives can ship a pre-generated module resolution index (see
+  // script/asar-resolve-index.js). Requires made from inside such an archive
+  // are answered from the index instead of probing the archive with stat,
+  // realpath and readdir calls for every candidate path.
+  const { _resolveFilename: originalResolveFilename } = Module;
+  Module._resolveFilename = function (request: string, parent?: NodeJS.Module | null, isMain?: boolean, options?: { paths: string[] }) {
+    if (!options && parent && typeof parent.filename === 'string') {
+      const pathInfo = splitPath(parent.filename);
+      if (pathInfo.isAsar) {
+        const archive = getOrCreateArchive(pathInfo.asarPath);
+        const resolved = archive && archive.resolveModule(path.dirname(pathInfo.filePath), request);
+        if (resolved) return path.join(pathInfo.asarPath, resolved);
+      }
+    }
+    return originalResolveFilename.apply(this, arguments as any);
+  };
+
+  // With the asarCodeCache fuse enabled, CommonJS modules loaded from an
+  // archive are compiled with V8 code cache data kept in the user data
+  // directory. Cache entries are keyed by the archive's contents and the
+  // file's integrity hash, so rebuilding the archive invalidates them.
+  const codeCacheDirectory = asar.getCodeCacheDirectory();
+  if (codeCacheDirectory) {
+    installCodeCache(fs, codeCacheDirectory);
+  }
+
   const asarReady = new WeakSet();
 
   // Lazily override the child_process APIs only when child_process is
@@ -1,5 +1,8 @@
+import { WORKER_BRIDGE_ENVIRONMENT_DATA } from '@electron/internal/common/worker-bridge';
+import { installWorkerBridge } from '@electron/internal/node/worker-bridge';
+
 // Initialize ASAR support in fs module.
-import { wrapFsWithAsar } from './asar-fs-wrapper';
+import { wrapFsWithAsar } from './asar-fs-wrapper'; // eslint-disable-line import/first
 wrapFsWithAsar(require('fs'));
 
 // Hook child_process.fork.
@@ -47,3 +50,10 @@ Module._nodeModulePaths = function (from) {
     return paths;
   }
 };
+
+// Worker threads of the main process reach some of its modules through
+// require('electron').
+import worker = require('worker_threads'); // eslint-disable-line import/first
+if (!worker.isMainThread && worker.getEnvironmentData(WORKER_BRIDGE_ENVIRONMENT_DATA)) {
+  installWorkerBridge();
+}
@@ -0,0 +1,190 @@
+import {
+  WORKER_BRIDGE_CONTROL_CHANNEL,
+  workerBridgeChannel,
+  serializeRequest,
+  deserializeRequest,
+  serializeResponse,
+  deserializeResponse,
+  postReply,
+  toBuffer
+} from '@electron/internal/common/worker-bridge';
+import type { WorkerBridgeControlMessage, WorkerBridgeMessage } from '@electron/internal/common/worker-bridge';
+
+import { BroadcastChannel, threadId } from 'worker_threads';
+import type { Worker } from 'worker_threads';
+
+type Handler = (...args: any[]) => any;
+
+const pendingCalls = new Map<number, { resolve: (result: any) => void, reject: (error: any) => void }>();
+const ipcHandlers = new Map<string, Handler>();
+const protocolHandlers = new Map<string, Handler>();
+let nextId = 0;
+
+let toMain: BroadcastChannel | undefined;
+let toWorker: BroadcastChannel | undefined;
+let connected: Promise<void> | undefined;
+
+function postControlMessage (message: WorkerBridgeControlMessage) {
+  const control = new BroadcastChannel(WORKER_BRIDGE_CONTROL_CHANNEL);
+  control.postMessage(message);
+  control.close();
+}
+
+// Like a server, the bridge keeps the worker alive while it waits for the main
+// thread or has handlers that the main thread can call.
+function updateRef () {
+  if (pendingCalls.size > 0 || ipcHandlers.size > 0 || protocolHandlers.size > 0) {
+    toWorker!.ref();
+  } else {
+    toWorker!.unref();
+  }
+}
+
+// The channels are only opened once the worker uses the bridge.
+function connect () {
+  if (!connected) {
+    toMain = new BroadcastChannel(workerBridgeChannel(threadId, 'main'));
+    toMain.unref();
+    toWorker = new BroadcastChannel(workerBridgeChannel(threadId, 'worker'));
+    connected = new Promise(resolve => {
+      toWorker!.onmessage = (event) => {
+        const message = (event as MessageEvent).data as WorkerBridgeMessage;
+        if (message.type === 'connected') resolve();
+        else onMessage(message);
+      };
+    });
+    updateRef();
+    postControlMessage({ type: 'connect', threadId });
+  }
+  return connected;
+}
+
+async function call (method: string, ...args: any[]): Promise<any> {
+  const id = nextId++;
+  const result = new Promise((resolve, reject) => {
+    pendingCalls.set(id, { resolve, reject });
+  });
+  await connect();
+  updateRef();
+  toMain!.postMessage({ type: 'call', id, method, args } as WorkerBridgeMessage);
+  return result;
+}
+
+async function invoke (kind: 'ipc' | 'protocol', name: string, args: any[]) {
+  if (kind === 'ipc') {
+    const handler = ipcHandlers.get(name);
+    if (!handler) throw new Error(`No handler registered for '${name}'`);
+    return handler(...args);
+  } else {
+    const handler = protocolHandlers.get(name);
+    if (!handler) throw new Error(`No handler registered for '${name}'`);
+    return serializeResponse(await handler(deserializeRequest(args[0])));
+  }
+}
+
+async function onMessage (message: WorkerBridgeMessage) {
+  if (message.type === 'reply') {
+    const pending = pendingCalls.get(message.id);
+    if (!pending) return;
+    pendingCalls.delete(message.id);
+    updateRef();
+    if ('error' in message) pending.reject(message.error);
+    else pending.resolve(message.result);
+  } else if (message.type === 'invoke') {
+    try {
+      const result = await invoke(message.kind, message.name, message.args);
+      postReply(toMain!, { type: 'reply', id: message.id }, { result });
+    } catch (error) {
+      postReply(toMain!, { type: 'reply', id: message.id }, { error });
+    }
+  }
+}
+
+// Registers |handler| locally before telling the main thread, so that no
+// invocation finds it missing.
+function addHandler (handlers: Map<string, Handler>, method: string, name: string, handler: Handler) {
+  if (typeof handler !== 'function') throw new TypeError('Expected handler to be a function');
+  if (handlers.has(name)) throw new Error(`Attempted to register a second handler for '${name}'`);
+  handlers.set(name, handler);
+  return call(method, name).catch((error) => {
+    handlers.delete(name);
+    updateRef();
+    throw error;
+  });
+}
+
+async function removeHandler (handlers: Map<string, Handler>, method: string, name: string) {
+  if (!handlers.has(name)) return;
+  await call(method, name);
+  handlers.delete(name);
+  updateRef();
+}
+
+const electronModule = {
+  ipcMain: {
+    handle: (channel: string, handler: Handler): Promise<void> =>
+      addHandler(ipcHandlers, 'ipcMain.handle', channel, handler),
+    removeHandler: (channel: string): Promise<void> =>
+      removeHandler(ipcHandlers, 'ipcMain.removeHandler', channel)
+  },
+  protocol: {
+    handle: (scheme: string, handler: (request: Request) => Response | Promise<Response>): Promise<void> =>
+      addHandler(protocolHandlers, 'protocol.handle', scheme, handler),
+    unhandle: (scheme: string): Promise<void> =>
+      removeHandler(protocolHandlers, 'protocol.unhandle', scheme),
+    isProtocolHandled: (scheme: string): Promise<boolean> =>
+      call('protocol.isProtocolHandled', scheme)
+  },
+  net: {
+    async fetch (input: RequestInfo | URL, init?: RequestInit & { bypassCustomProtocolHandlers?: boolean }): Promise<Response> {
+      const request = new Request(input, init);
+      request.signal.throwIfAborted();
+      // The request still completes on the main thread when it's aborted.
+      const aborted = new Promise<never>((resolve, reject) => {
+        request.signal.addEventListener('abort', () => reject(request.signal.reason), { once: true });
+      });
+      const response = call('net.fetch', await serializeRequest(request), {
+        bypassCustomProtocolHandlers: init?.bypassCustomProtocolHandlers
+      });
+      return deserializeResponse(await Promise.race([response, aborted]));
+    }
+  },
+  safeStorage: {
+    isEncryptionAvailable: (): Promise<boolean> =>
+      call('safeStorage.isEncryptionAvailable'),
+    encryptString: async (plainText: string): Promise<Buffer> =>
+      toBuffer(await call('safeStorage.encryptString', plainText)),
+    decryptString: (encrypted: Buffer): Promise<string> =>
+      call('safeStorage.decryptString', encrypted)
+  }
+};
+
+// Makes require('electron') in the worker thread return the bridged modules.
+export function installWorkerBridge () {
+  const Module = require('module') as NodeJS.ModuleInternal;
+  const bridgeModule = new Module('electron', null);
+  bridgeModule.id = 'electron';
+  bridgeModule.loaded = true;
+  bridgeModule.filename = 'electron';
+  bridgeModule.exports = electronModule;
+  Module._cache.electron = bridgeModule;
+
+  const originalResolveFilename = Module._resolveFilename;
+  Module._resolveFilename = function (request, parent, isMain, options) {
+    if (request === 'electron' || request === 'electron/main') {
+      return 'electron';
+    } else {
+      return originalResolveFilename(request, parent, isMain, options);
+    }
+  };
+
+  // Workers that exit or that are terminated can't unregister their handlers
+  // themselves.
+  process.on('worker', (worker: Worker) => {
+    const { threadId } = worker;
+    worker.once('exit', () => postControlMessage({ type: 'exit', threadId }));
+  });
+  process.once('exit', () => {
+    if (connected) postControlMessage({ type: 'exit', threadId });
+  });
+}
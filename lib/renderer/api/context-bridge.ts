@@ -12,6 +12,10 @@ const contextBridge: Electron.ContextBridge = {
   exposeInIsolatedWorld: (worldId: number, key: string, api: any) => {
     checkContextIsolationEnabled();
     return binding.exposeAPIInWorld(worldId, key, api);
+  },
+  shareBuffer: (buffer: ArrayBuffer | ArrayBufferView) => {
+    checkContextIsolationEnabled();
+    return binding.shareBuffer(buffer);
   }
 };
 
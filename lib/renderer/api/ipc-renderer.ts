@@ -1,22 +1,51 @@
 import { EventEmitter } from 'events';
+import { IPC_MESSAGES } from '@electron/internal/common/ipc-messages';
 
 const { ipc } = process._linkedBinding('electron_renderer_ipc');
 
 const internal = false;
 class IpcRenderer extends EventEmitter implements Electron.IpcRenderer {
+  private _batch: [string, any[]][] = [];
+
   send (channel: string, ...args: any[]) {
+    this._flushBatch();
     return ipc.send(internal, channel, args);
   }
 
+  sendBatched (channel: string, ...args: any[]) {
+    if (this._batch.length === 0) {
+      queueMicrotask(() => this._flushBatch());
+    }
+    this._batch.push([channel, args]);
+  }
+
   sendSync (channel: string, ...args: any[]) {
+    this._flushBatch();
     return ipc.sendSync(internal, channel, args);
   }
 
+  getSharedValue (key: string) {
+    return ipc.getSharedValue(key);
+  }
+
+  getSharedBuffer (name: string) {
+    return ipc.getSharedBuffer(name);
+  }
+
+  getStats () {
+    return ipc.getStats();
+  }
+
+  resetStats () {
+    ipc.resetStats();
+  }
+
   sendToHost (channel: string, ...args: any[]) {
     return ipc.sendToHost(channel, args);
   }
 
   async invoke (channel: string, ...args: any[]) {
+    this._flushBatch();
     const { error, result } = await ipc.invoke(internal, channel, args);
     if (error) {
       throw new Error(`Error invoking remote method '${channel}': ${error}`);
@@ -25,8 +54,18 @@ class IpcRenderer extends EventEmitter implements Electron.IpcRenderer {
   }
 
   postMessage (channel: string, message: any, transferables: any) {
+    this._flushBatch();
     return ipc.postMessage(channel, message, transferables);
   }
+
+  // Sends everything queued by sendBatched() as one message, so that it is
+  // delivered before anything sent after it.
+  private _flushBatch () {
+    if (this._batch.length === 0) return;
+    const batch = this._batch;
+    this._batch = [];
+    ipc.send(true, IPC_MESSAGES.BROWSER_IPC_BATCH, [batch]);
+  }
 }
 
 export default new IpcRenderer();
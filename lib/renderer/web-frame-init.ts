@@ -18,4 +18,22 @@ export const webFrameInit = () => {
     // will be caught by "keyof WebFrameMethod" though.
     return (webFrame[method] as any)(...args);
   });
+
+  // The scripts registered in the main process that this frame ran, see
+  // lib/browser/script-registry.ts.
+  const registeredScripts = new Map<string, { code: string, version: number }>();
+  ipcRendererUtils.handle(IPC_MESSAGES.RENDERER_EXECUTE_REGISTERED_SCRIPT, async (
+    event, name: string, version: number, code: string | null, worldId: number, userGesture: boolean
+  ) => {
+    if (code !== null) {
+      registeredScripts.set(name, { code, version });
+    }
+    const script = registeredScripts.get(name);
+    if (!script || script.version !== version) {
+      return { cached: false };
+    }
+    const url = `electron-script://${encodeURIComponent(name)}`;
+    const result = await webFrame.executeJavaScriptInIsolatedWorld(worldId, [{ code: script.code, url }], userGesture);
+    return { cached: true, result };
+  });
 };
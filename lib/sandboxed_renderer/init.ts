@@ -8,7 +8,7 @@ import type * as ipcRendererInternalModule from '@electron/internal/renderer/ipc
 declare const binding: {
   get: (name: string) => any;
   process: NodeJS.Process;
-  createPreloadScript: (src: string) => Function
+  createPreloadScript: (src: string, codeCache?: Uint8Array) => { preloadFn: Function, codeCache?: Uint8Array }
 };
 
 const { EventEmitter } = events;
@@ -39,6 +39,8 @@ const {
     preloadPath: string;
     preloadSrc: string | null;
     preloadError: null | Error;
+    preloadHash?: string;
+    codeCache?: Uint8Array;
   }[];
   process: NodeJS.Process;
 }>(IPC_MESSAGES.BROWSER_SANDBOX_LOAD);
@@ -120,22 +122,29 @@ require('@electron/internal/renderer/common-init');
 // - `process`: The `preloadProcess` object
 // - `Buffer`: Shim of `Buffer` implementation
 // - `global`: The window object, which is aliased to `global` by webpack.
-function runPreloadScript (preloadSrc: string) {
+function runPreloadScript (preloadSrc: string, codeCache?: Uint8Array) {
   const preloadWrapperSrc = `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports, module) {
   ${preloadSrc}
   })`;
 
   // eval in window scope
-  const preloadFn = binding.createPreloadScript(preloadWrapperSrc);
+  const { preloadFn, codeCache: newCodeCache } = binding.createPreloadScript(preloadWrapperSrc, codeCache);
   const exports = {};
 
   preloadFn(preloadRequire, preloadProcess, Buffer, global, setImmediate, clearImmediate, exports, { exports });
+
+  return newCodeCache;
 }
 
-for (const { preloadPath, preloadSrc, preloadError } of preloadScripts) {
+for (const { preloadPath, preloadSrc, preloadError, preloadHash, codeCache } of preloadScripts) {
   try {
     if (preloadSrc) {
-      runPreloadScript(preloadSrc);
+      const newCodeCache = runPreloadScript(preloadSrc, codeCache);
+      // Hand the code cache to the browser process, for the next renderers of
+      // the session that run the same preload script.
+      if (newCodeCache && preloadHash) {
+        ipcRendererInternal.send(IPC_MESSAGES.BROWSER_PRELOAD_CODE_CACHE, preloadHash, newCodeCache);
+      }
     } else if (preloadError) {
       throw preloadError;
     }
@@ -23,14 +23,17 @@ Object.defineProperty(process, 'parentPort', {
 });
 
 // Based on third_party/electron_node/lib/internal/worker/io.js
+const isMessageEvent = (name: string) => name === 'message' || name === 'messages';
+const messageListenerCount = () => parentPort.listenerCount('message') + parentPort.listenerCount('messages');
+
 parentPort.on('newListener', (name: string) => {
-  if (name === 'message' && parentPort.listenerCount('message') === 0) {
+  if (isMessageEvent(name) && messageListenerCount() === 0) {
     parentPort.start();
   }
 });
 
 parentPort.on('removeListener', (name: string) => {
-  if (name === 'message' && parentPort.listenerCount('message') === 0) {
+  if (isMessageEvent(name) && messageListenerCount() === 0) {
     parentPort.pause();
   }
 });
@@ -1,19 +1,42 @@
 import { EventEmitter } from 'events';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+import { SharedBuffer } from '@electron/internal/browser/shared-buffer';
 const { createParentPort } = process._linkedBinding('electron_utility_parent_port');
 
+const ERR_UNEXPECTED = -9;
+
+function concatRawData (uploadData: Electron.ProtocolRequest['uploadData']) {
+  if (!uploadData) return null;
+  return Buffer.concat(uploadData.filter(chunk => (chunk as any).type === 'rawData').map(chunk => chunk.bytes));
+}
+
 export class ParentPort extends EventEmitter implements Electron.ParentPort {
-  #port: ParentPort;
+  #port: ElectronInternal.ParentPort;
   constructor () {
     super();
     this.#port = createParentPort();
-    this.#port.emit = (channel: string | symbol, event: { ports: any[] }) => {
+    const wrapMessageEvent = (event: any) => ({ ...event, ports: event.ports.map((p: any) => new MessagePortMain(p)) });
+    this.#port.emit = (channel: string | symbol, event: any) => {
       if (channel === 'message') {
-        event = { ...event, ports: event.ports.map(p => new MessagePortMain(p)) };
+        event = wrapMessageEvent(event);
+      } else if (channel === 'messages') {
+        event = event.map(wrapMessageEvent);
+      } else if (channel === 'shared-buffer') {
+        event = { ...event, buffer: new SharedBuffer(event.buffer) };
       }
       this.emit(channel, event);
       return false;
     };
+    this.on('newListener', (name: string) => {
+      if (name === 'messages' && this.listenerCount('messages') === 0) {
+        this.#port.setBatching(true);
+      }
+    });
+    this.on('removeListener', (name: string) => {
+      if (name === 'messages' && this.listenerCount('messages') === 0) {
+        this.#port.setBatching(false);
+      }
+    });
   }
 
   start () : void {
@@ -24,7 +47,31 @@ export class ParentPort extends EventEmitter implements Electron.ParentPort {
     this.#port.pause();
   }
 
-  postMessage (message: any) : void {
+  handleProtocol (scheme: string, handler: (request: Request) => Response | Promise<Response>) : void {
+    this.#port.handleProtocol(scheme, async (preq, callback) => {
+      try {
+        const headers = new Headers(preq.headers);
+        if (headers.get('origin') === 'null') {
+          headers.delete('origin');
+        }
+        const body = preq.method === 'GET' || preq.method === 'HEAD' ? null : concatRawData(preq.uploadData);
+        const res = await handler(new Request(preq.url, { method: preq.method, headers, body }));
+        callback({
+          statusCode: res.status,
+          headers: Object.fromEntries(res.headers),
+          data: Buffer.from(await res.arrayBuffer())
+        });
+      } catch (e) {
+        console.error(e);
+        callback({ error: ERR_UNEXPECTED });
+      }
+    });
+  }
+
+  postMessage (message: any, transfer?: ArrayBuffer[]) : void {
+    if (Array.isArray(transfer)) {
+      return this.#port.postMessage(message, transfer);
+    }
     this.#port.postMessage(message);
   }
 }
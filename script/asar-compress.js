@@ -0,0 +1,75 @@
+// Rewrites the packed files of an ASAR archive as blocks that are compressed
+// independently with brotli, which shell/common/asar/archive.h decompresses
+// on demand.
+//
+// Usage: node script/asar-compress.js <input.asar> <output.asar> [--block-size=<bytes>]
+
+const assert = require('node:assert');
+const crypto = require('node:crypto');
+const fs = require('node:fs');
+const zlib = require('node:zlib');
+
+const { createArchive, readRawHeader } = require('./asar-index');
+
+const DEFAULT_BLOCK_SIZE = 64 * 1024;
+// Must match kMaxCompressionBlockSize in shell/common/asar/archive.cc.
+const MAX_BLOCK_SIZE = 1024 * 1024;
+
+const hash = (data) => crypto.createHash('sha256').update(data).digest('hex');
+
+function compressArchive (input, output, { blockSize = DEFAULT_BLOCK_SIZE } = {}) {
+  assert(blockSize > 0 && blockSize <= MAX_BLOCK_SIZE, `block size must be between 1 and ${MAX_BLOCK_SIZE}`);
+  const archive = fs.readFileSync(input);
+  const { headerString, dataOffset } = readRawHeader(archive);
+  const header = JSON.parse(headerString.toString());
+
+  const chunks = [];
+  let offset = 0;
+
+  const compressNode = (node) => {
+    if (node.files !== undefined) {
+      Object.values(node.files).forEach(compressNode);
+      return;
+    }
+    if (node.link !== undefined || node.unpacked) return;
+    assert(!node.compression, 'the archive is already compressed');
+
+    const start = dataOffset + Number(node.offset);
+    const contents = archive.subarray(start, start + node.size);
+    node.offset = String(offset);
+    if (contents.length === 0) return;
+
+    const blocks = [];
+    const hashes = [];
+    for (let i = 0; i < contents.length; i += blockSize) {
+      const block = contents.subarray(i, i + blockSize);
+      const compressed = zlib.brotliCompressSync(block, {
+        params: { [zlib.constants.BROTLI_PARAM_SIZE_HINT]: block.length }
+      });
+      chunks.push(compressed);
+      blocks.push(compressed.length);
+      hashes.push(hash(block));
+      offset += compressed.length;
+    }
+    node.compression = { algorithm: 'brotli', blockSize, blocks };
+
+    // The blocks are validated once they are decompressed, so the integrity
+    // blocks have to be the same as the compressed ones.
+    if (node.integrity) {
+      node.integrity = { ...node.integrity, blockSize, blocks: hashes };
+    }
+  };
+
+  compressNode(header);
+  fs.writeFileSync(output, createArchive(Buffer.from(JSON.stringify(header)), Buffer.concat(chunks)));
+}
+
+if (require.main === module) {
+  const args = process.argv.slice(2);
+  const blockSizeArg = args.find((arg) => arg.startsWith('--block-size='));
+  const [input, output] = args.filter((arg) => !arg.startsWith('--'));
+  assert(input && output, 'Usage: node script/asar-compress.js <input.asar> <output.asar> [--block-size=<bytes>]');
+  compressArchive(input, output, blockSizeArg ? { blockSize: Number(blockSizeArg.split('=')[1]) } : {});
+}
+
+module.exports = { compressArchive };
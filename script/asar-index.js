@@ -0,0 +1,147 @@
+// Rewrites the JSON header of an ASAR archive into the pre-indexed binary
+// format understood by shell/common/asar/archive_index.h.
+//
+// Usage: node script/asar-index.js <input.asar> <output.asar>
+
+const assert = require('node:assert');
+const fs = require('node:fs');
+
+const MAGIC = 'ASARIDX1';
+const ENTRY_SIZE = 48;
+const HASH_SIZE = 64;
+
+const TYPE_FILE = 0;
+const TYPE_DIRECTORY = 1;
+const TYPE_LINK = 2;
+
+const FLAG_UNPACKED = 1 << 0;
+const FLAG_EXECUTABLE = 1 << 1;
+const FLAG_HAS_INTEGRITY = 1 << 2;
+
+const align4 = (n) => (n + 3) & ~3;
+
+// Reads the header string and the offset at which file data starts.
+function readRawHeader (archive) {
+  const sizePickle = archive.subarray(0, 8);
+  const headerPickleSize = sizePickle.readUInt32LE(4);
+  const headerPickle = archive.subarray(8, 8 + headerPickleSize);
+  const headerStringSize = headerPickle.readUInt32LE(4);
+  const headerString = headerPickle.subarray(8, 8 + headerStringSize);
+  return { headerString, dataOffset: 8 + headerPickleSize };
+}
+
+function createIndex (header) {
+  const entries = [];
+  const children = [];
+  const strings = [];
+  let stringsSize = 0;
+
+  const addString = (value) => {
+    const buffer = Buffer.from(value);
+    const offset = stringsSize;
+    strings.push(buffer);
+    stringsSize += buffer.length;
+    return { offset, size: buffer.length };
+  };
+
+  const addEntry = (name, node) => {
+    const index = entries.length;
+    const entry = { name: addString(name) };
+    entries.push(entry);
+
+    if (node.link !== undefined) {
+      entry.type = TYPE_LINK;
+      entry.target = addString(node.link);
+    } else if (node.files !== undefined) {
+      entry.type = TYPE_DIRECTORY;
+      // Children are sorted by their UTF-8 bytes so lookups can bisect.
+      const names = Object.keys(node.files).sort((a, b) => Buffer.compare(Buffer.from(a), Buffer.from(b)));
+      const childIndices = names.map((childName) => addEntry(childName, node.files[childName]));
+      entry.first = children.length;
+      entry.count = childIndices.length;
+      children.push(...childIndices);
+    } else {
+      assert(!node.compression, 'compressed files can not be indexed');
+      entry.type = TYPE_FILE;
+      entry.size = node.size;
+      entry.offset = BigInt(node.offset || 0);
+      entry.flags = (node.unpacked ? FLAG_UNPACKED : 0) | (node.executable ? FLAG_EXECUTABLE : 0);
+      if (node.integrity) {
+        assert.strictEqual(node.integrity.algorithm, 'SHA256', 'only SHA256 integrity is supported');
+        entry.flags |= FLAG_HAS_INTEGRITY;
+        entry.integrity = addString([node.integrity.hash, ...node.integrity.blocks].join(''));
+        assert.strictEqual(entry.integrity.size, HASH_SIZE * (node.integrity.blocks.length + 1));
+        entry.blockSize = node.integrity.blockSize;
+        entry.blockCount = node.integrity.blocks.length;
+      }
+    }
+
+    return index;
+  };
+
+  addEntry('', header);
+
+  const preambleSize = MAGIC.length + 12;
+  const index = Buffer.alloc(preambleSize + entries.length * ENTRY_SIZE + children.length * 4 + stringsSize);
+  index.write(MAGIC, 0, 'latin1');
+  index.writeUInt32LE(entries.length, MAGIC.length);
+  index.writeUInt32LE(children.length, MAGIC.length + 4);
+  index.writeUInt32LE(stringsSize, MAGIC.length + 8);
+
+  entries.forEach((entry, i) => {
+    const base = preambleSize + i * ENTRY_SIZE;
+    index.writeUInt32LE(entry.name.offset, base);
+    index.writeUInt32LE(entry.name.size, base + 4);
+    index.writeUInt8(entry.type, base + 8);
+    index.writeUInt8(entry.flags || 0, base + 9);
+    index.writeUInt32LE(entry.size || 0, base + 12);
+    index.writeBigUInt64LE(entry.offset || 0n, base + 16);
+    if (entry.type === TYPE_DIRECTORY) {
+      index.writeUInt32LE(entry.first, base + 24);
+      index.writeUInt32LE(entry.count, base + 28);
+    } else if (entry.type === TYPE_LINK) {
+      index.writeUInt32LE(entry.target.offset, base + 24);
+      index.writeUInt32LE(entry.target.size, base + 28);
+    }
+    if (entry.integrity) {
+      index.writeUInt32LE(entry.integrity.offset, base + 32);
+      index.writeUInt32LE(entry.blockSize, base + 36);
+      index.writeUInt32LE(entry.blockCount, base + 40);
+    }
+  });
+
+  const childrenOffset = preambleSize + entries.length * ENTRY_SIZE;
+  children.forEach((child, i) => index.writeUInt32LE(child, childrenOffset + i * 4));
+  Buffer.concat(strings).copy(index, childrenOffset + children.length * 4);
+
+  return index;
+}
+
+// Serializes |index| the same way @electron/asar pickles the JSON header.
+function createArchive (index, data) {
+  const headerPickle = Buffer.alloc(8 + align4(index.length));
+  headerPickle.writeUInt32LE(headerPickle.length - 4, 0);
+  headerPickle.writeUInt32LE(index.length, 4);
+  index.copy(headerPickle, 8);
+
+  const sizePickle = Buffer.alloc(8);
+  sizePickle.writeUInt32LE(4, 0);
+  sizePickle.writeUInt32LE(headerPickle.length, 4);
+
+  return Buffer.concat([sizePickle, headerPickle, data]);
+}
+
+function indexArchive (input, output) {
+  const archive = fs.readFileSync(input);
+  const { headerString, dataOffset } = readRawHeader(archive);
+  const index = createIndex(JSON.parse(headerString.toString()));
+  fs.writeFileSync(output, createArchive(index, archive.subarray(dataOffset)));
+}
+
+if (require.main === module) {
+  const [input, output] = process.argv.slice(2);
+  assert(input && output, 'Usage: node script/asar-index.js <input.asar> <output.asar>');
+  indexArchive(input, output);
+}
+
+module.exports = { createArchive, createIndex, indexArchive, readRawHeader };
@@ -0,0 +1,72 @@
+// Generates the module resolution index that Electron consults when modules
+// inside an ASAR archive are required (see Archive::ResolveModule). Run it on
+// the app directory before packing it:
+//
+//   node script/asar-resolve-index.js <app-dir>
+//
+// Every statically analyzable `require('...')` in the app's JavaScript files
+// is resolved the way Node.js would resolve it, and the results are written to
+// <app-dir>/.electron-resolve.json as
+//   { "<parent dir>": { "<request>": "<resolved path>" } }
+// with all paths relative to <app-dir> and using forward slashes.
+
+const assert = require('node:assert');
+const fs = require('node:fs');
+const Module = require('node:module');
+const path = require('node:path');
+
+const INDEX_FILE_NAME = '.electron-resolve.json';
+const requireRe = /\brequire\s*\(\s*(['"])([^'"\n]+)\1\s*\)/g;
+const electronModuleNames = new Set(['electron', 'electron/main', 'electron/renderer', 'electron/common']);
+
+const toIndexPath = (p) => p.split(path.sep).join('/');
+
+function * walk (dir) {
+  for (const entry of fs.readdirSync(dir, { withFileTypes: true })) {
+    const fullPath = path.join(dir, entry.name);
+    if (entry.isDirectory()) {
+      yield * walk(fullPath);
+    } else if (entry.isFile() && /\.c?js$/.test(entry.name)) {
+      yield fullPath;
+    }
+  }
+}
+
+function createResolveIndex (appDir) {
+  const index = {};
+  for (const file of walk(appDir)) {
+    const parent = new Module(file, null);
+    parent.filename = file;
+    parent.paths = Module._nodeModulePaths(path.dirname(file));
+
+    const parentDir = toIndexPath(path.relative(appDir, path.dirname(file)));
+    const source = fs.readFileSync(file, 'utf8');
+    for (const [, , request] of source.matchAll(requireRe)) {
+      if (Module.isBuiltin(request) || electronModuleNames.has(request)) continue;
+
+      let resolved;
+      try {
+        resolved = Module._resolveFilename(request, parent, false);
+      } catch {
+        // Leave unresolvable requests to Node.js at runtime.
+        continue;
+      }
+
+      const relative = path.relative(appDir, resolved);
+      if (relative.startsWith('..') || path.isAbsolute(relative)) continue;
+
+      index[parentDir] = index[parentDir] || {};
+      index[parentDir][request] = toIndexPath(relative);
+    }
+  }
+  return index;
+}
+
+if (require.main === module) {
+  const appDir = process.argv[2];
+  assert(appDir, 'Usage: node script/asar-resolve-index.js <app-dir>');
+  const index = createResolveIndex(path.resolve(appDir));
+  fs.writeFileSync(path.join(appDir, INDEX_FILE_NAME), JSON.stringify(index));
+}
+
+module.exports = { createResolveIndex };
@@ -0,0 +1,10 @@
+/* global chrome */
+
+// Acknowledges every message, and every batch of messages sent over a port.
+chrome.runtime.onMessage.addListener((message, sender, sendResponse) => {
+  sendResponse(null);
+});
+
+chrome.runtime.onConnect.addListener((port) => {
+  port.onMessage.addListener(() => port.postMessage(null));
+});
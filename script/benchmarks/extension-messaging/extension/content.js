@@ -0,0 +1,94 @@
+/* global chrome */
+
+// Runs the benchmarks in the content script when the page asks for them, and
+// posts the results back to the page.
+
+const kSizes = [16, 1024, 64 * 1024];
+const kBatchSize = 100;
+
+function createBytes (size) {
+  const bytes = new Uint8Array(size);
+  for (let i = 0; i < size; i++) bytes[i] = i & 0xff;
+  return bytes;
+}
+
+// Extension messages are serialized to JSON, so binary data has to be encoded
+// into something JSON can hold.
+const payloadTypes = {
+  string: (size) => 'x'.repeat(size),
+  'binary (base64)': (size) => {
+    let binary = '';
+    for (const byte of createBytes(size)) binary += String.fromCharCode(byte);
+    return btoa(binary);
+  },
+  'binary (array)': (size) => Array.from(createBytes(size))
+};
+
+function connect () {
+  const port = chrome.runtime.connect({ name: 'benchmark' });
+  const waiting = [];
+  port.onMessage.addListener(() => waiting.shift()());
+  return (message) => new Promise((resolve) => {
+    waiting.push(resolve);
+    port.postMessage(message);
+  });
+}
+
+function createTransports () {
+  const sendOverPort = connect();
+  return {
+    sendMessage: { send: (payload) => chrome.runtime.sendMessage(payload), batchSize: 1 },
+    port: { send: sendOverPort, batchSize: 1 },
+    // Relaying many small messages as one array saves the per-message cost of
+    // the extension message service.
+    portBatched: {
+      send: (payload) => sendOverPort(new Array(kBatchSize).fill(payload)),
+      batchSize: kBatchSize
+    }
+  };
+}
+
+async function measure ({ send, batchSize }, payload, iterations) {
+  const sends = Math.max(1, Math.round(iterations / batchSize));
+
+  // Warm up.
+  for (let i = 0; i < Math.min(sends, 10); i++) await send(payload);
+
+  const latencies = [];
+  for (let i = 0; i < Math.min(sends, 100); i++) {
+    const start = performance.now();
+    await send(payload);
+    latencies.push(performance.now() - start);
+  }
+  latencies.sort((a, b) => a - b);
+
+  const start = performance.now();
+  await Promise.all(Array.from({ length: sends }, () => send(payload)));
+  const elapsed = (performance.now() - start) / 1000;
+
+  return {
+    p50: latencies[Math.floor(latencies.length / 2)],
+    p99: latencies[Math.floor(latencies.length * 0.99)],
+    messagesPerSecond: (sends * batchSize) / elapsed
+  };
+}
+
+async function runBenchmarks ({ iterations, filter }) {
+  const results = [];
+  for (const [transport, methods] of Object.entries(createTransports())) {
+    if (filter && !transport.includes(filter)) continue;
+    for (const [type, createPayload] of Object.entries(payloadTypes)) {
+      for (const size of kSizes) {
+        const measurement = await measure(methods, createPayload(size), iterations);
+        results.push({ transport, type, size, ...measurement });
+      }
+    }
+  }
+  return results;
+}
+
+window.addEventListener('message', async (event) => {
+  if (event.source !== window || event.data?.type !== 'run-benchmarks') return;
+  const results = await runBenchmarks(event.data.options);
+  window.postMessage({ type: 'benchmark-results', results }, '*');
+});
@@ -0,0 +1,96 @@
+// Measures latency (p50/p99 of sequential round trips) and throughput
+// (messages per second with all round trips in flight) of extension messaging
+// between a content script and the service worker of its extension:
+//
+//   sendMessage:  chrome.runtime.sendMessage, answered with sendResponse
+//   port:         a port from chrome.runtime.connect, acknowledged per message
+//   portBatched:  the same port, with the messages relayed in arrays of 100
+//
+// for strings and for binary data, which has to be encoded to JSON either as
+// base64 or as an array of numbers.
+//
+// Usage: npm run benchmark:extension-messaging -- [--iterations=N] [--filter=transport] [--json]
+
+const { app, BrowserWindow, session } = require('electron');
+const http = require('node:http');
+const path = require('node:path');
+
+const kPage = `<!doctype html>
+<script>
+  function runBenchmarks (options) {
+    return new Promise((resolve) => {
+      window.addEventListener('message', (event) => {
+        if (event.data?.type === 'benchmark-results') resolve(event.data.results);
+      });
+      window.postMessage({ type: 'run-benchmarks', options }, '*');
+    });
+  }
+</script>`;
+
+function parseOptions (argv) {
+  const options = { iterations: 1000, filter: undefined, json: false };
+  for (const arg of argv) {
+    const [name, value] = arg.replace(/^--/, '').split('=');
+    if (name === 'iterations') options.iterations = Number(value);
+    else if (name === 'filter') options.filter = value;
+    else if (name === 'json') options.json = true;
+  }
+  return options;
+}
+
+function listen (server) {
+  return new Promise((resolve) => {
+    server.listen(0, '127.0.0.1', () => resolve(`http://127.0.0.1:${server.address().port}/`));
+  });
+}
+
+async function runBenchmarks (options) {
+  const ses = session.fromPartition('extension-messaging-benchmark');
+  await ses.loadExtension(path.join(__dirname, 'extension'));
+
+  const server = http.createServer((req, res) => {
+    res.setHeader('Content-Type', 'text/html');
+    res.end(kPage);
+  });
+  const url = await listen(server);
+
+  const win = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+  await win.loadURL(url);
+  const results = await win.webContents.executeJavaScript(`runBenchmarks(${JSON.stringify({
+    iterations: options.iterations,
+    filter: options.filter
+  })})`);
+  win.destroy();
+  server.close();
+  return results;
+}
+
+function formatSize (size) {
+  if (size >= 1024 * 1024) return `${size / (1024 * 1024)}MB`;
+  if (size >= 1024) return `${size / 1024}KB`;
+  return `${size}B`;
+}
+
+function printResults (results) {
+  console.table(results.map(({ transport, type, size, p50, p99, messagesPerSecond }) => ({
+    transport,
+    payload: `${type} ${formatSize(size)}`,
+    'p50 (ms)': p50.toFixed(3),
+    'p99 (ms)': p99.toFixed(3),
+    'msg/s': Math.round(messagesPerSecond)
+  })));
+}
+
+app.whenReady().then(async () => {
+  const options = parseOptions(process.argv.slice(2));
+  const results = await runBenchmarks(options);
+  if (options.json) {
+    console.log(JSON.stringify({ electron: process.versions.electron, results }, null, 2));
+  } else {
+    printResults(results);
+  }
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
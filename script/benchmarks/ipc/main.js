@@ -0,0 +1,111 @@
+// Measures latency (p50/p99 of sequential round trips) and throughput
+// (messages per second with all round trips in flight) of Electron's IPC
+// transports across payload types and sizes:
+//
+//   renderer -> main:  send, sendBatched, invoke, sendSync, postMessage,
+//                      and a MessagePort transferred to the main process
+//   main -> utility:   utilityProcess postMessage / parentPort
+//   main -> main:      MessagePortMain to MessagePortMain
+//
+// Usage: npm run benchmark:ipc -- [--iterations=N] [--filter=transport] [--json]
+
+const { app, BrowserWindow, ipcMain, MessageChannelMain, utilityProcess } = require('electron');
+const path = require('node:path');
+const { createAckQueue, runAll } = require('./measure');
+
+function parseOptions (argv) {
+  const options = { iterations: 1000, filter: undefined, json: false };
+  for (const arg of argv) {
+    const [name, value] = arg.replace(/^--/, '').split('=');
+    if (name === 'iterations') options.iterations = Number(value);
+    else if (name === 'filter') options.filter = value;
+    else if (name === 'json') options.json = true;
+  }
+  return options;
+}
+
+function handleRendererMessages () {
+  ipcMain.on('send', (event) => event.reply('send-ack'));
+  ipcMain.on('send-batched', (event) => event.reply('send-batched-ack'));
+  ipcMain.handle('invoke', () => null);
+  ipcMain.on('send-sync', (event) => { event.returnValue = null; });
+  ipcMain.on('post-message', (event) => event.reply('post-message-ack'));
+  ipcMain.on('message-port', (event) => {
+    const [port] = event.ports;
+    port.on('message', () => port.postMessage(null));
+    port.start();
+  });
+}
+
+async function runRendererBenchmarks (options) {
+  const win = new BrowserWindow({
+    show: false,
+    webPreferences: { nodeIntegration: true, contextIsolation: false }
+  });
+  await win.loadFile(path.join(__dirname, 'index.html'));
+  const results = await win.webContents.executeJavaScript(`runBenchmarks(${JSON.stringify(options)})`);
+  win.destroy();
+  return results;
+}
+
+async function runMainBenchmarks (options) {
+  const child = utilityProcess.fork(path.join(__dirname, 'utility.js'));
+  const childAcks = createAckQueue();
+  child.on('message', childAcks.ack);
+
+  const { port1, port2 } = new MessageChannelMain();
+  port2.on('message', () => port2.postMessage(null));
+  const portAcks = createAckQueue();
+  port1.on('message', portAcks.ack);
+  port1.start();
+  port2.start();
+
+  const results = await runAll({
+    utilityProcess: (payload) => () => {
+      child.postMessage(payload);
+      return childAcks.wait();
+    },
+    messagePortMain: (payload) => () => {
+      port1.postMessage(payload);
+      return portAcks.wait();
+    }
+  }, options);
+
+  child.kill();
+  port1.close();
+  return results;
+}
+
+function formatSize (size) {
+  if (size >= 1024 * 1024) return `${size / (1024 * 1024)}MB`;
+  if (size >= 1024) return `${size / 1024}KB`;
+  return `${size}B`;
+}
+
+function printResults (results) {
+  console.table(results.map(({ transport, type, size, p50, p99, messagesPerSecond }) => ({
+    transport,
+    payload: `${type} ${formatSize(size)}`,
+    'p50 (ms)': p50.toFixed(3),
+    'p99 (ms)': p99.toFixed(3),
+    'msg/s': Math.round(messagesPerSecond)
+  })));
+}
+
+app.whenReady().then(async () => {
+  const options = parseOptions(process.argv.slice(2));
+  handleRendererMessages();
+  const results = [
+    ...await runRendererBenchmarks(options),
+    ...await runMainBenchmarks(options)
+  ];
+  if (options.json) {
+    console.log(JSON.stringify({ electron: process.versions.electron, results }, null, 2));
+  } else {
+    printResults(results);
+  }
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
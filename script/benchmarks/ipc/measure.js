@@ -0,0 +1,82 @@
+// Helpers shared by the main process, renderer and utility process parts of
+// the IPC benchmark.
+
+const PAYLOAD_SIZES = [16, 1024, 64 * 1024, 1024 * 1024];
+const PAYLOAD_TYPES = ['string', 'object', 'buffer'];
+
+// Creates a payload whose serialized size is roughly |size| bytes.
+function createPayload (type, size) {
+  switch (type) {
+    case 'string':
+      return 'x'.repeat(size);
+    case 'object':
+      // Many small records exercise the serializer rather than memcpy.
+      return Array.from({ length: Math.max(1, Math.floor(size / 32)) }, (_, i) => ({ id: i, name: `item${i}` }));
+    case 'buffer':
+      return new Uint8Array(size);
+    default:
+      throw new Error(`Unknown payload type '${type}'`);
+  }
+}
+
+// Large payloads get fewer iterations so that a full run stays reasonable.
+function getIterations (iterations, size) {
+  return size >= 64 * 1024 ? Math.max(10, Math.floor(iterations / 10)) : iterations;
+}
+
+function percentile (sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+// Measures the latency of sequential calls to |roundTrip|, then the
+// throughput when |iterations| calls are in flight at once.
+async function measure (roundTrip, iterations) {
+  for (let i = 0; i < Math.min(iterations, 10); i++) {
+    await roundTrip();
+  }
+
+  const samples = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = performance.now();
+    await roundTrip();
+    samples.push(performance.now() - start);
+  }
+  samples.sort((a, b) => a - b);
+
+  const start = performance.now();
+  await Promise.all(Array.from({ length: iterations }, () => roundTrip()));
+  const elapsed = performance.now() - start;
+
+  return {
+    p50: percentile(samples, 0.5),
+    p99: percentile(samples, 0.99),
+    messagesPerSecond: iterations / (elapsed / 1000)
+  };
+}
+
+// Turns acknowledgements that arrive in order into resolved promises.
+function createAckQueue () {
+  const pending = [];
+  return {
+    wait: () => new Promise(resolve => pending.push(resolve)),
+    ack: () => pending.shift()()
+  };
+}
+
+// Runs |transports| ({ name: payload => roundTrip }) for every payload.
+async function runAll (transports, { iterations, filter }) {
+  const results = [];
+  for (const [transport, createRoundTrip] of Object.entries(transports)) {
+    if (filter && !transport.includes(filter)) continue;
+    for (const type of PAYLOAD_TYPES) {
+      for (const size of PAYLOAD_SIZES) {
+        const roundTrip = createRoundTrip(createPayload(type, size));
+        const result = await measure(roundTrip, getIterations(iterations, size));
+        results.push({ transport, type, size, ...result });
+      }
+    }
+  }
+  return results;
+}
+
+module.exports = { createAckQueue, runAll };
@@ -0,0 +1,47 @@
+// Benchmarks for the transports that start in a renderer. Every message is
+// acknowledged by the main process with an empty reply, so payloads only
+// travel from the renderer to the main process.
+
+const { ipcRenderer } = require('electron');
+const { createAckQueue, runAll } = require('./measure');
+
+function createTransports () {
+  const sendAcks = createAckQueue();
+  ipcRenderer.on('send-ack', sendAcks.ack);
+
+  const batchedAcks = createAckQueue();
+  ipcRenderer.on('send-batched-ack', batchedAcks.ack);
+
+  const postMessageAcks = createAckQueue();
+  ipcRenderer.on('post-message-ack', postMessageAcks.ack);
+
+  const { port1, port2 } = new MessageChannel();
+  ipcRenderer.postMessage('message-port', null, [port2]);
+  const portAcks = createAckQueue();
+  port1.onmessage = portAcks.ack;
+
+  return {
+    send: (payload) => () => {
+      ipcRenderer.send('send', payload);
+      return sendAcks.wait();
+    },
+    sendBatched: (payload) => () => {
+      ipcRenderer.sendBatched('send-batched', payload);
+      return batchedAcks.wait();
+    },
+    invoke: (payload) => () => ipcRenderer.invoke('invoke', payload),
+    sendSync: (payload) => async () => {
+      ipcRenderer.sendSync('send-sync', payload);
+    },
+    postMessage: (payload) => () => {
+      ipcRenderer.postMessage('post-message', payload);
+      return postMessageAcks.wait();
+    },
+    messagePort: (payload) => () => {
+      port1.postMessage(payload);
+      return portAcks.wait();
+    }
+  };
+}
+
+window.runBenchmarks = (options) => runAll(createTransports(), options);
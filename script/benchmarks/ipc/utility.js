@@ -0,0 +1,5 @@
+// Acknowledges every message from the main process with an empty reply.
+
+process.parentPort.on('message', () => {
+  process.parentPort.postMessage(null);
+});
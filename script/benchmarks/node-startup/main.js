@@ -0,0 +1,102 @@
+// Measures how long it takes to run a Node.js script in a process started with
+// ELECTRON_RUN_AS_NODE, the way child_process.fork(process.execPath) starts
+// helpers, across scenarios:
+//
+//   default: the regular run-as-node startup
+//   minimal: with ELECTRON_RUN_AS_NODE_MINIMAL, which skips the crash reporter
+//     and the feature list
+//   node:    the `node` executable found in PATH, when there is one, for
+//     reference
+//
+// For every scenario the median of the runs is reported, in milliseconds from
+// the launch of the process until it exited after running an empty script.
+//
+// Usage: npm run benchmark:node-startup -- [--runs=N] [--json]
+
+const { app } = require('electron');
+const cp = require('node:child_process');
+
+function parseOptions (argv) {
+  const options = { runs: 20, json: false };
+  for (const arg of argv) {
+    const [name, value] = arg.replace(/^--/, '').split('=');
+    if (name === 'runs') options.runs = Number(value);
+    else if (name === 'json') options.json = true;
+  }
+  return options;
+}
+
+function findNode () {
+  const result = cp.spawnSync(process.platform === 'win32' ? 'where' : 'which', ['node'], { encoding: 'utf8' });
+  return result.status === 0 ? result.stdout.split(/\r?\n/)[0] : undefined;
+}
+
+function createScenarios () {
+  const { ELECTRON_RUN_AS_NODE_MINIMAL, ...env } = process.env;
+  const scenarios = [
+    { name: 'default', execPath: process.execPath, env: { ...env, ELECTRON_RUN_AS_NODE: '1' } },
+    { name: 'minimal', execPath: process.execPath, env: { ...env, ELECTRON_RUN_AS_NODE: '1', ELECTRON_RUN_AS_NODE_MINIMAL: '1' } }
+  ];
+  const node = findNode();
+  if (node) scenarios.push({ name: 'node', execPath: node, env });
+  return scenarios;
+}
+
+function launch (scenario) {
+  return new Promise((resolve, reject) => {
+    const launchTime = process.hrtime.bigint();
+    const child = cp.spawn(scenario.execPath, ['-e', ''], { env: scenario.env, stdio: 'ignore' });
+    child.on('error', reject);
+    child.on('close', (code) => {
+      if (code !== 0) {
+        reject(new Error(`Scenario '${scenario.name}' exited with code ${code}`));
+        return;
+      }
+      resolve(Number(process.hrtime.bigint() - launchTime) / 1e6);
+    });
+  });
+}
+
+function median (values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+async function runScenario (scenario, options) {
+  // The first launch warms the disk cache and is not counted.
+  await launch(scenario);
+  const runs = [];
+  for (let i = 0; i < options.runs; i++) {
+    runs.push(await launch(scenario));
+  }
+  return { name: scenario.name, startup: median(runs), min: Math.min(...runs), max: Math.max(...runs) };
+}
+
+app.whenReady().then(async () => {
+  const options = parseOptions(process.argv.slice(2));
+  const results = [];
+  for (const scenario of createScenarios()) {
+    results.push(await runScenario(scenario, options));
+  }
+
+  if (options.json) {
+    console.log(JSON.stringify({
+      electron: process.versions.electron,
+      platform: process.platform,
+      arch: process.arch,
+      runs: options.runs,
+      results
+    }, null, 2));
+  } else {
+    console.table(results.map((result) => ({
+      scenario: result.name,
+      'startup (ms)': result.startup.toFixed(1),
+      'min (ms)': result.min.toFixed(1),
+      'max (ms)': result.max.toFixed(1)
+    })));
+  }
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
@@ -0,0 +1,75 @@
+// The app launched for every run of the startup benchmark. It opens the
+// windows of its scenario, waits for them to paint and to settle, and prints
+// its measurements on stdout for the main.js that launched it.
+
+const { app, BrowserWindow, ipcMain } = require('electron');
+const path = require('node:path');
+
+const scenario = JSON.parse(process.env.ELECTRON_BENCHMARK_SCENARIO);
+
+// Long enough for the renderers to finish their startup work.
+const SETTLE_PERIOD = 2000;
+const IDLE_PERIOD = 5000;
+
+function createWindow () {
+  const win = new BrowserWindow({
+    show: false,
+    webPreferences: {
+      sandbox: scenario.sandbox,
+      preload: scenario.preload ? path.join(__dirname, 'preload.js') : undefined
+    }
+  });
+  const painted = new Promise(resolve => win.once('ready-to-show', () => resolve(Date.now())));
+  win.loadFile(path.join(__dirname, 'index.html'));
+  return painted;
+}
+
+function getPhaseTime (metrics, name) {
+  const phase = metrics.phases.find(phase => phase.name === name);
+  return phase ? phase.startTime : undefined;
+}
+
+function sumMetrics (metrics, type, get) {
+  return metrics
+    .filter(metric => type === undefined || metric.type === type)
+    .reduce((total, metric) => total + get(metric), 0);
+}
+
+const wait = (ms) => new Promise(resolve => setTimeout(resolve, ms));
+
+ipcMain.handle('ping', () => null);
+
+app.whenReady().then(async () => {
+  const readyTime = Date.now();
+  const paintTimes = await Promise.all(Array.from({ length: scenario.windows }, createWindow));
+  const startupMetrics = app.getStartupMetrics();
+
+  await wait(SETTLE_PERIOD);
+  const metrics = app.getAppMetrics();
+
+  // The CPU usage is measured between two calls of getAppMetrics().
+  await wait(IDLE_PERIOD);
+  const idleMetrics = app.getAppMetrics();
+
+  const result = {
+    readyTime,
+    firstPaintTime: Math.min(...paintTimes),
+    lastPaintTime: Math.max(...paintTimes),
+    phases: {
+      ready: getPhaseTime(startupMetrics, 'ready'),
+      firstNavigationCommit: getPhaseTime(startupMetrics, 'firstNavigationCommit'),
+      firstNonEmptyLayout: getPhaseTime(startupMetrics, 'firstNonEmptyLayout')
+    },
+    // In kilobytes.
+    browserMemory: sumMetrics(metrics, 'Browser', metric => metric.memory.workingSetSize),
+    rendererMemory: sumMetrics(metrics, 'Tab', metric => metric.memory.workingSetSize),
+    totalMemory: sumMetrics(metrics, undefined, metric => metric.memory.workingSetSize),
+    idleCPU: sumMetrics(idleMetrics, undefined, metric => metric.cpu.percentCPUUsage),
+    idleWakeupsPerSecond: sumMetrics(idleMetrics, undefined, metric => metric.cpu.idleWakeupsPerSecond)
+  };
+  process.stdout.write(`BENCHMARK_RESULT ${JSON.stringify(result)}\n`);
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
@@ -0,0 +1,8 @@
+// A preload script of the size most apps have, it only exposes a couple of
+// functions to the page.
+
+const { contextBridge, ipcRenderer } = require('electron');
+
+contextBridge.exposeInMainWorld('benchmark', {
+  ping: () => ipcRenderer.invoke('ping')
+});
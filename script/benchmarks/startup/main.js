@@ -0,0 +1,157 @@
+// Measures the startup time, memory and idle CPU usage of an app across
+// scenarios, each run launches a new Electron process with the app in ./app:
+//
+//   windows:   how many windows the app opens at startup (1 and 4)
+//   sandbox:   sandboxed and non-sandboxed renderers
+//   preload:   with and without a preload script
+//   packaging: the app from a directory and from an ASAR archive
+//
+// For every scenario the median of the runs is reported:
+//
+//   ready, firstPaint, lastPaint: milliseconds from the launch of the process
+//     until app 'ready' and the first and last windows emitted 'ready-to-show'
+//   firstNavigationCommit, firstNonEmptyLayout: from app.getStartupMetrics()
+//   browserMemory, rendererMemoryPerWindow, totalMemory: working set in KB
+//     once the windows settled
+//   idleCPU, idleWakeupsPerSecond: summed over the processes of the app while
+//     it is idle, the wakeups are only reported on macOS
+//
+// Usage: npm run benchmark:startup -- [--runs=N] [--windows=1,4]
+//        [--filter=name] [--json]
+
+const { app } = require('electron');
+const asar = require('@electron/asar');
+const cp = require('node:child_process');
+const fs = require('node:fs');
+const os = require('node:os');
+const path = require('node:path');
+
+function parseOptions (argv) {
+  const options = { runs: 5, windows: [1, 4], filter: undefined, json: false };
+  for (const arg of argv) {
+    const [name, value] = arg.replace(/^--/, '').split('=');
+    if (name === 'runs') options.runs = Number(value);
+    else if (name === 'windows') options.windows = value.split(',').map(Number);
+    else if (name === 'filter') options.filter = value;
+    else if (name === 'json') options.json = true;
+  }
+  return options;
+}
+
+function createScenarios (options) {
+  const scenarios = [];
+  for (const windows of options.windows) {
+    for (const sandbox of [true, false]) {
+      for (const preload of [false, true]) {
+        for (const packaging of ['directory', 'asar']) {
+          const name = [
+            `${windows}-window${windows > 1 ? 's' : ''}`,
+            sandbox ? 'sandboxed' : 'unsandboxed',
+            preload ? 'preload' : 'no-preload',
+            packaging
+          ].join(' ');
+          if (options.filter && !name.includes(options.filter)) continue;
+          scenarios.push({ name, windows, sandbox, preload, packaging });
+        }
+      }
+    }
+  }
+  return scenarios;
+}
+
+// Launches the app once, the process is started the way `electron <app>`
+// starts it, through the default app.
+function launch (appPath, scenario) {
+  return new Promise((resolve, reject) => {
+    const env = { ...process.env, ELECTRON_BENCHMARK_SCENARIO: JSON.stringify(scenario) };
+    delete env.ELECTRON_RUN_AS_NODE;
+    const launchTime = Date.now();
+    const child = cp.spawn(process.execPath, [appPath], { env, stdio: ['ignore', 'pipe', 'inherit'] });
+    let stdout = '';
+    child.stdout.on('data', (data) => { stdout += data; });
+    child.on('error', reject);
+    child.on('close', (code) => {
+      const line = stdout.split('\n').find(line => line.startsWith('BENCHMARK_RESULT '));
+      if (code !== 0 || !line) {
+        reject(new Error(`Scenario '${scenario.name}' exited with code ${code}`));
+        return;
+      }
+      const result = JSON.parse(line.slice('BENCHMARK_RESULT '.length));
+      resolve({
+        ready: result.readyTime - launchTime,
+        firstPaint: result.firstPaintTime - launchTime,
+        lastPaint: result.lastPaintTime - launchTime,
+        firstNavigationCommit: result.phases.firstNavigationCommit,
+        firstNonEmptyLayout: result.phases.firstNonEmptyLayout,
+        browserMemory: result.browserMemory,
+        rendererMemoryPerWindow: result.rendererMemory / scenario.windows,
+        totalMemory: result.totalMemory,
+        idleCPU: result.idleCPU,
+        idleWakeupsPerSecond: result.idleWakeupsPerSecond
+      });
+    });
+  });
+}
+
+function median (values) {
+  const sorted = values.filter(value => value !== undefined).sort((a, b) => a - b);
+  return sorted.length > 0 ? sorted[Math.floor(sorted.length / 2)] : undefined;
+}
+
+async function runScenario (appPaths, scenario, options) {
+  const runs = [];
+  for (let i = 0; i < options.runs; i++) {
+    runs.push(await launch(appPaths[scenario.packaging], scenario));
+  }
+  const result = { ...scenario };
+  for (const metric of Object.keys(runs[0])) {
+    result[metric] = median(runs.map(run => run[metric]));
+  }
+  return result;
+}
+
+function printResults (results) {
+  const format = (value, digits = 0) => value === undefined ? '-' : value.toFixed(digits);
+  console.table(results.map((result) => ({
+    scenario: result.name,
+    'ready (ms)': format(result.ready),
+    'first paint (ms)': format(result.firstPaint),
+    'last paint (ms)': format(result.lastPaint),
+    'renderer/window (MB)': format(result.rendererMemoryPerWindow / 1024, 1),
+    'total (MB)': format(result.totalMemory / 1024, 1),
+    'idle CPU (%)': format(result.idleCPU, 2),
+    'wakeups/s': format(result.idleWakeupsPerSecond, 1)
+  })));
+}
+
+app.whenReady().then(async () => {
+  const options = parseOptions(process.argv.slice(2));
+  const tempDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-startup-benchmark-'));
+  const appPaths = {
+    directory: path.join(__dirname, 'app'),
+    asar: path.join(tempDir, 'app.asar')
+  };
+  await asar.createPackage(appPaths.directory, appPaths.asar);
+
+  const results = [];
+  for (const scenario of createScenarios(options)) {
+    results.push(await runScenario(appPaths, scenario, options));
+  }
+  fs.rmSync(tempDir, { recursive: true, force: true });
+
+  if (options.json) {
+    console.log(JSON.stringify({
+      electron: process.versions.electron,
+      platform: process.platform,
+      arch: process.arch,
+      runs: options.runs,
+      results
+    }, null, 2));
+  } else {
+    printResults(results);
+  }
+  app.quit();
+}).catch((error) => {
+  console.error(error);
+  app.exit(1);
+});
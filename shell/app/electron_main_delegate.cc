@@ -9,6 +9,7 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/apple/bundle_locations.h"
 #include "base/base_switches.h"
@@ -16,9 +17,12 @@
 #include "base/debug/stack_trace.h"
 #include "base/environment.h"
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/path_service.h"
 #include "base/strings/string_split.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/chrome_switches.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
@@ -42,6 +46,7 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
 #include "shell/common/process_util.h"
+#include "shell/common/startup_metrics.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/renderer/electron_renderer_client.h"
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
@@ -207,13 +212,7 @@ void RegisterPathProvider() {
                                       PATH_END);
 }
 
-}  // namespace
-
-std::string LoadResourceBundle(const std::string& locale) {
-  const bool initialized = ui::ResourceBundle::HasSharedInstance();
-  DCHECK(!initialized);
-
-  // Load other resource files.
+base::FilePath GetResourcesPakDir() {
   base::FilePath pak_dir;
 #if BUILDFLAG(IS_MAC)
   pak_dir =
@@ -221,15 +220,52 @@ std::string LoadResourceBundle(const std::string& locale) {
 #else
   base::PathService::Get(base::DIR_MODULE, &pak_dir);
 #endif
+  return pak_dir;
+}
+
+void PrefetchResourceBundleFiles(const std::string& locale) {
+  TRACE_EVENT0("electron.startup", "PrefetchResourceBundle");
+  const base::FilePath pak_dir = GetResourcesPakDir();
+  std::vector<base::FilePath> files = {
+      pak_dir.Append(FILE_PATH_LITERAL("resources.pak")),
+      pak_dir.Append(FILE_PATH_LITERAL("chrome_100_percent.pak")),
+      pak_dir.Append(FILE_PATH_LITERAL("chrome_200_percent.pak")),
+  };
+  if (!locale.empty())
+    files.push_back(ui::ResourceBundle::GetLocaleFilePath(locale));
+
+  // Missing files, e.g. the 200% pack in some builds, are simply skipped.
+  for (const auto& file : files) {
+    if (!file.empty())
+      base::PreReadFile(file, /*is_executable=*/false);
+  }
+}
+
+}  // namespace
+
+std::string LoadResourceBundle(const std::string& locale) {
+  startup_metrics::ScopedPhase phase("LoadResourceBundle");
+  const bool initialized = ui::ResourceBundle::HasSharedInstance();
+  DCHECK(!initialized);
 
   std::string loaded_locale = ui::ResourceBundle::InitSharedInstanceWithLocale(
       locale, nullptr, ui::ResourceBundle::LOAD_COMMON_RESOURCES);
   ui::ResourceBundle& bundle = ui::ResourceBundle::GetSharedInstance();
-  bundle.AddDataPackFromPath(pak_dir.Append(FILE_PATH_LITERAL("resources.pak")),
-                             ui::kScaleFactorNone);
+  // Load other resource files.
+  bundle.AddDataPackFromPath(
+      GetResourcesPakDir().Append(FILE_PATH_LITERAL("resources.pak")),
+      ui::kScaleFactorNone);
   return loaded_locale;
 }
 
+void PrefetchResourceBundle(const std::string& locale) {
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&PrefetchResourceBundleFiles, locale));
+}
+
 ElectronMainDelegate::ElectronMainDelegate() = default;
 
 ElectronMainDelegate::~ElectronMainDelegate() = default;
@@ -240,6 +276,8 @@ const size_t ElectronMainDelegate::kNonWildcardDomainNonPortSchemesSize =
     std::size(kNonWildcardDomainNonPortSchemes);
 
 std::optional<int> ElectronMainDelegate::BasicStartupComplete() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronMainDelegate::BasicStartupComplete");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
 #if BUILDFLAG(IS_WIN)
@@ -316,6 +354,7 @@ std::optional<int> ElectronMainDelegate::BasicStartupComplete() {
 }
 
 void ElectronMainDelegate::PreSandboxStartup() {
+  startup_metrics::ScopedPhase phase("ElectronMainDelegate::PreSandboxStartup");
   auto* command_line = base::CommandLine::ForCurrentProcess();
   std::string process_type = GetProcessType();
 
@@ -400,6 +439,8 @@ void ElectronMainDelegate::SandboxInitialized(const std::string& process_type) {
 }
 
 std::optional<int> ElectronMainDelegate::PreBrowserMain() {
+  startup_metrics::ScopedPhase phase("ElectronMainDelegate::PreBrowserMain");
+  startup_metrics::TakeRelaunchTime();
   // This is initialized early because the service manager reads some feature
   // flags and we need to make sure the feature list is initialized before the
   // service manager reads the features.
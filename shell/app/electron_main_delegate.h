@@ -19,6 +19,10 @@ namespace electron {
 
 std::string LoadResourceBundle(const std::string& locale);
 
+// Reads the files LoadResourceBundle() maps into the page cache on the thread
+// pool, so that loading them later does not block on disk.
+void PrefetchResourceBundle(const std::string& locale);
+
 class ElectronMainDelegate : public content::ContentMainDelegate {
  public:
   static const char* const kNonWildcardDomainNonPortSchemes[];
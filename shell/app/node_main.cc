@@ -28,6 +28,7 @@
 #include "shell/app/uv_task_runner.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/api/electron_bindings.h"
+#include "shell/common/electron_constants.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
@@ -148,8 +149,13 @@ int NodeMain(int argc, char* argv[]) {
   }
 #endif  // BUILDFLAG(IS_MAC)
 
+  // Helpers that only run plain Node.js code can skip the crash reporter and
+  // the feature list, which cost startup time in every process.
+  const bool minimal = os_env->HasVar(electron::kRunAsNodeMinimal);
+
 #if BUILDFLAG(IS_WIN)
-  v8_crashpad_support::SetUp();
+  if (!minimal)
+    v8_crashpad_support::SetUp();
 #endif
 
 #if BUILDFLAG(IS_LINUX)
@@ -175,9 +181,11 @@ int NodeMain(int argc, char* argv[]) {
     base::SingleThreadTaskRunner::CurrentDefaultHandle handle(uv_task_runner);
 
     // Initialize feature list.
-    auto feature_list = std::make_unique<base::FeatureList>();
-    feature_list->InitFromCommandLine("", "");
-    base::FeatureList::SetInstance(std::move(feature_list));
+    if (!minimal) {
+      auto feature_list = std::make_unique<base::FeatureList>();
+      feature_list->InitFromCommandLine("", "");
+      base::FeatureList::SetInstance(std::move(feature_list));
+    }
 
     // Explicitly register electron's builtin bindings.
     NodeBindings::RegisterBuiltinBindings();
@@ -205,7 +213,7 @@ int NodeMain(int argc, char* argv[]) {
 #if BUILDFLAG(IS_LINUX)
     // On Linux, initialize crashpad after Nodejs init phase so that
     // crash and termination signal handlers can be set by the crashpad client.
-    if (!pid_string.empty()) {
+    if (!pid_string.empty() && !minimal) {
       auto* command_line = base::CommandLine::ForCurrentProcess();
       command_line->AppendSwitchASCII(
           crash_reporter::switches::kCrashpadHandlerPid, pid_string);
@@ -218,11 +226,13 @@ int NodeMain(int argc, char* argv[]) {
       command_line->RemoveSwitch(crash_reporter::switches::kCrashpadHandlerPid);
     }
 #elif BUILDFLAG(IS_WIN) || (BUILDFLAG(IS_MAC) && !IS_MAS_BUILD())
-    ElectronCrashReporterClient::Create();
-    crash_reporter::InitializeCrashpad(false, "node");
-    crash_keys::SetCrashKeysFromCommandLine(
-        *base::CommandLine::ForCurrentProcess());
-    crash_keys::SetPlatformCrashKey();
+    if (!minimal) {
+      ElectronCrashReporterClient::Create();
+      crash_reporter::InitializeCrashpad(false, "node");
+      crash_keys::SetCrashKeysFromCommandLine(
+          *base::CommandLine::ForCurrentProcess());
+      crash_keys::SetPlatformCrashKey();
+    }
 #endif
 
     gin::V8Initializer::LoadV8Snapshot(
@@ -5,29 +5,46 @@
 #include <utility>
 
 #include "base/location.h"
-#include "base/stl_util.h"
 #include "base/time/time.h"
 #include "shell/app/uv_task_runner.h"
 
 namespace electron {
 
-UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+UvTaskRunner::DelayedTask::DelayedTask(uint64_t run_time,
+                                       uint64_t sequence_num,
+                                       base::OnceClosure task)
+    : run_time(run_time), sequence_num(sequence_num), task(std::move(task)) {}
+
+UvTaskRunner::DelayedTask::DelayedTask(DelayedTask&&) = default;
+
+UvTaskRunner::DelayedTask& UvTaskRunner::DelayedTask::operator=(
+    DelayedTask&&) = default;
+
+UvTaskRunner::DelayedTask::~DelayedTask() = default;
+
+UvTaskRunner::UvTaskRunner(uv_loop_t* loop)
+    : loop_(loop), timer_(new uv_timer_t) {
+  timer_->data = this;
+  uv_timer_init(loop_, timer_);
+}
 
 UvTaskRunner::~UvTaskRunner() {
-  for (auto& iter : tasks_) {
-    uv_unref(reinterpret_cast<uv_handle_t*>(iter.first));
-    delete iter.first;
-  }
+  uv_timer_stop(timer_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(timer_.get()));
+  uv_close(reinterpret_cast<uv_handle_t*>(timer_.get()), UvTaskRunner::OnClose);
 }
 
 bool UvTaskRunner::PostDelayedTask(const base::Location& from_here,
                                    base::OnceClosure task,
                                    base::TimeDelta delay) {
-  auto* timer = new uv_timer_t;
-  timer->data = this;
-  uv_timer_init(loop_, timer);
-  uv_timer_start(timer, UvTaskRunner::OnTimeout, delay.InMilliseconds(), 0);
-  tasks_[timer] = std::move(task);
+  const int64_t delay_ms = delay.InMilliseconds();
+  if (delay_ms <= 0) {
+    immediate_tasks_.push_back(std::move(task));
+  } else {
+    delayed_tasks_.emplace(uv_now(loop_) + delay_ms, next_sequence_num_++,
+                           std::move(task));
+  }
+  ScheduleTimer();
   return true;
 }
 
@@ -41,17 +58,50 @@ bool UvTaskRunner::PostNonNestableDelayedTask(const base::Location& from_here,
   return PostDelayedTask(from_here, std::move(task), delay);
 }
 
+void UvTaskRunner::ScheduleTimer() {
+  const uint64_t now = uv_now(loop_);
+  uint64_t run_time;
+  if (!immediate_tasks_.empty()) {
+    run_time = now;
+  } else if (!delayed_tasks_.empty()) {
+    run_time = delayed_tasks_.top().run_time;
+  } else {
+    uv_timer_stop(timer_);
+    timer_run_time_.reset();
+    return;
+  }
+
+  if (timer_run_time_ && *timer_run_time_ <= run_time)
+    return;
+
+  uv_timer_start(timer_, UvTaskRunner::OnTimeout,
+                 run_time > now ? run_time - now : 0, 0);
+  timer_run_time_ = run_time;
+}
+
 // static
 void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
-  auto& tasks = static_cast<UvTaskRunner*>(timer->data)->tasks_;
-  const auto iter = tasks.find(timer);
-  if (iter == std::end(tasks))
-    return;
+  auto* self = static_cast<UvTaskRunner*>(timer->data);
+  self->timer_run_time_.reset();
+
+  // Only run the tasks that are already queued, anything posted by them
+  // waits for the next loop iteration so that a task reposting itself can
+  // not starve the loop.
+  for (size_t count = self->immediate_tasks_.size(); count > 0; --count) {
+    base::OnceClosure task = std::move(self->immediate_tasks_.front());
+    self->immediate_tasks_.pop_front();
+    std::move(task).Run();
+  }
+
+  const uint64_t now = uv_now(self->loop_);
+  while (!self->delayed_tasks_.empty() &&
+         self->delayed_tasks_.top().run_time <= now) {
+    base::OnceClosure task = std::move(self->delayed_tasks_.top().task);
+    self->delayed_tasks_.pop();
+    std::move(task).Run();
+  }
 
-  std::move(iter->second).Run();
-  tasks.erase(iter);
-  uv_timer_stop(timer);
-  uv_close(reinterpret_cast<uv_handle_t*>(timer), UvTaskRunner::OnClose);
+  self->ScheduleTimer();
 }
 
 // static
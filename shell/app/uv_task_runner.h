@@ -5,8 +5,11 @@
 #ifndef ELECTRON_SHELL_APP_UV_TASK_RUNNER_H_
 #define ELECTRON_SHELL_APP_UV_TASK_RUNNER_H_
 
-#include <map>
+#include <cstdint>
+#include <optional>
+#include <queue>
 
+#include "base/containers/circular_deque.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/task/single_thread_task_runner.h"
@@ -20,6 +23,9 @@ class TimeDelta;
 namespace electron {
 
 // TaskRunner implementation that posts tasks into libuv's default loop.
+//
+// All tasks are run from a single uv timer, which is armed for the earliest
+// pending task, so posting a task does not create a uv handle of its own.
 class UvTaskRunner : public base::SingleThreadTaskRunner {
  public:
   explicit UvTaskRunner(uv_loop_t* loop);
@@ -38,13 +44,48 @@ class UvTaskRunner : public base::SingleThreadTaskRunner {
                                   base::TimeDelta delay) override;
 
  private:
+  struct DelayedTask {
+    DelayedTask(uint64_t run_time,
+                uint64_t sequence_num,
+                base::OnceClosure task);
+    DelayedTask(DelayedTask&&);
+    DelayedTask& operator=(DelayedTask&&);
+    ~DelayedTask();
+
+    // Orders the queue so that the earliest task is on top, and tasks that
+    // are due at the same time run in the order they were posted.
+    bool operator<(const DelayedTask& other) const {
+      if (run_time != other.run_time)
+        return run_time > other.run_time;
+      return sequence_num > other.sequence_num;
+    }
+
+    // In uv loop time, milliseconds.
+    uint64_t run_time;
+    uint64_t sequence_num;
+    // Mutable so it can be moved out of the top of the queue.
+    mutable base::OnceClosure task;
+  };
+
   ~UvTaskRunner() override;
+
+  // Arms |timer_| for the earliest pending task, or stops it if there is
+  // none.
+  void ScheduleTimer();
+
   static void OnTimeout(uv_timer_t* timer);
   static void OnClose(uv_handle_t* handle);
 
   raw_ptr<uv_loop_t> loop_;
+  raw_ptr<uv_timer_t> timer_;
+
+  // The loop time |timer_| is armed for, if it is.
+  std::optional<uint64_t> timer_run_time_;
 
-  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+  // Tasks posted without a delay, in posting order.
+  base::circular_deque<base::OnceClosure> immediate_tasks_;
+  std::priority_queue<DelayedTask> delayed_tasks_;
+  uint64_t next_sequence_num_ = 0;
 };
 
 }  // namespace electron
@@ -60,10 +60,12 @@
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/login_handler.h"
+#include "shell/browser/microtasks_runner.h"
 #include "shell/browser/relauncher.h"
 #include "shell/common/application_info.h"
 #include "shell/common/electron_command_line.h"
 #include "shell/common/electron_paths.h"
+#include "shell/common/event_loop_monitor.h"
 #include "shell/common/gin_converters/base_converter.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
@@ -78,6 +80,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
+#include "shell/common/startup_metrics.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
 #include "ui/gfx/image/image.h"
@@ -545,6 +548,7 @@ App::~App() {
   Browser::Get()->RemoveObserver(this);
   content::GpuDataManager::GetInstance()->RemoveObserver(this);
   content::BrowserChildProcessObserver::Remove(this);
+  MediaCaptureDevicesDispatcher::GetInstance()->RemoveObserver(this);
 }
 
 void App::OnBeforeQuit(bool* prevent_default) {
@@ -602,6 +606,9 @@ void App::OnFinishLaunching(base::Value::Dict launch_info) {
 
 void App::OnPreMainMessageLoopRun() {
   content::BrowserChildProcessObserver::Add(this);
+  MediaCaptureDevicesDispatcher::GetInstance()->AddObserver(this);
+  // So that app.getGPUInfo('basic') can be answered from the cache.
+  GPUInfoManager::GetInstance()->CollectBasicInfoInBackground();
   if (process_singleton_ && watch_singleton_socket_on_ready_) {
     process_singleton_->StartWatching();
     watch_singleton_socket_on_ready_ = false;
@@ -771,6 +778,10 @@ void App::OnGpuInfoUpdate() {
   Emit("gpu-info-update");
 }
 
+void App::OnMediaCaptureDevicesChanged() {
+  Emit("media-capture-devices-changed");
+}
+
 void App::BrowserChildProcessLaunchedAndConnected(
     const content::ChildProcessData& data) {
   ChildProcessLaunched(data.process_type, data.id, data.GetProcess().Handle(),
@@ -840,10 +851,14 @@ void App::ChildProcessLaunched(int process_type,
 #endif
   app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
       process_type, handle, std::move(metrics), service_name, name);
+  if (process_metrics_sampler_)
+    process_metrics_sampler_->AddProcess(pid, *app_metrics_[pid]);
 }
 
 void App::ChildProcessDisconnected(int pid) {
   app_metrics_.erase(pid);
+  if (process_metrics_sampler_)
+    process_metrics_sampler_->RemoveProcess(pid);
 }
 
 base::FilePath App::GetAppPath() const {
@@ -1014,8 +1029,14 @@ bool App::RequestSingleInstanceLock(gin::Arguments* args) {
 
   auto cb = base::BindRepeating(&App::OnSecondInstance, base::Unretained(this));
 
+  // The data may be read by another version of Electron.
   blink::CloneableMessage additional_data_message;
-  args->GetNext(&additional_data_message);
+  v8::Local<v8::Value> additional_data;
+  if (args->GetNext(&additional_data)) {
+    electron::SerializeV8Value(args->isolate(), additional_data,
+                               &additional_data_message,
+                               electron::SerializationFormat::kV8Only);
+  }
 #if BUILDFLAG(IS_WIN)
   bool app_is_sandboxed =
       IsSandboxEnabled(base::CommandLine::ForCurrentProcess());
@@ -1339,10 +1360,184 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+void App::StartProcessMetricsSampling(gin_helper::ErrorThrower thrower,
+                                      gin::Arguments* args) {
+  int interval = 1000;
+  int history_size = 60;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("interval", &interval);
+    options.Get("historySize", &history_size);
+  }
+  if (interval <= 0) {
+    thrower.ThrowError("interval must be a positive number");
+    return;
+  }
+  if (history_size <= 0) {
+    thrower.ThrowError("historySize must be a positive number");
+    return;
+  }
+
+  process_metrics_sampler_ = std::make_unique<ProcessMetricsSampler>(
+      base::Milliseconds(interval), history_size);
+  for (const auto& [pid, process_metric] : app_metrics_)
+    process_metrics_sampler_->AddProcess(pid, *process_metric);
+}
+
+void App::StopProcessMetricsSampling() {
+  process_metrics_sampler_.reset();
+}
+
+v8::Local<v8::Value> App::GetProcessMetricsHistory(v8::Isolate* isolate) {
+  if (!process_metrics_sampler_)
+    return v8::Null(isolate);
+  return process_metrics_sampler_->GetHistory(isolate);
+}
+
+bool App::StartCpuProfiling(gin_helper::ErrorThrower thrower,
+                            gin::Arguments* args) {
+  int sampling_interval = 1000;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval <= 0) {
+    thrower.ThrowError("samplingInterval must be a positive number");
+    return false;
+  }
+
+  if (!cpu_profiler_)
+    cpu_profiler_ = std::make_unique<CpuProfiler>(args->isolate());
+  return cpu_profiler_->Start(base::Microseconds(sampling_interval));
+}
+
+v8::Local<v8::Promise> App::StopCpuProfiling(v8::Isolate* isolate,
+                                             const base::FilePath& file_path) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!cpu_profiler_ || !cpu_profiler_->is_profiling()) {
+    promise.RejectWithErrorMessage("CPU profiling is not running");
+    return handle;
+  }
+
+  base::File file;
+  {
+    ScopedAllowBlockingForElectron allow_blocking;
+    file = base::File(file_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  }
+  if (!file.IsValid()) {
+    promise.RejectWithErrorMessage("Failed to open the profile file");
+    return handle;
+  }
+
+  cpu_profiler_->Stop(
+      std::move(file),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, bool success) {
+            if (success)
+              promise.Resolve();
+            else
+              promise.RejectWithErrorMessage("Failed to write the CPU profile");
+          },
+          std::move(promise)));
+  return handle;
+}
+
+base::Value::Dict App::GetEventLoopStats() {
+  auto* monitor = EventLoopMonitor::GetCurrent();
+  return monitor ? monitor->GetStats() : base::Value::Dict();
+}
+
+void App::ResetEventLoopStats() {
+  if (auto* monitor = EventLoopMonitor::GetCurrent())
+    monitor->Reset();
+}
+
+void App::SetSkipIdleMicrotaskCheckpoints(bool skip) {
+  if (auto* runner = MicrotasksRunner::GetCurrent())
+    runner->SetSkipIdleCheckpoints(skip);
+}
+
+base::Value::List App::GetBlockingCallStats() {
+  base::Value::List result;
+  for (const auto& site : ScopedAllowBlockingForElectron::GetStats()) {
+    base::Value::Dict dict;
+    dict.Set("location", site.location);
+    dict.Set("count", static_cast<double>(site.count));
+    dict.Set("totalDuration", site.total.InMillisecondsF());
+    dict.Set("maxDuration", site.max.InMillisecondsF());
+    result.Append(std::move(dict));
+  }
+  return result;
+}
+
+void App::ResetBlockingCallStats() {
+  ScopedAllowBlockingForElectron::ResetStats();
+}
+
+void App::StartHangMonitor(gin_helper::ErrorThrower thrower,
+                           gin::Arguments* args) {
+  int threshold = 5000;
+  bool dump_without_crashing = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("threshold", &threshold);
+    options.Get("dumpWithoutCrashing", &dump_without_crashing);
+  }
+  if (threshold <= 0) {
+    thrower.ThrowError("threshold must be a positive number");
+    return;
+  }
+
+  hang_monitor_ = std::make_unique<HangMonitor>(
+      args->isolate(), base::Milliseconds(threshold), dump_without_crashing,
+      base::BindRepeating(&App::OnHang, base::Unretained(this)));
+}
+
+void App::StopHangMonitor() {
+  hang_monitor_.reset();
+}
+
+void App::OnHang(const HangMonitor::Hang& hang) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto details = gin_helper::Dictionary::CreateEmpty(isolate);
+  details.Set("duration", hang.duration.InMillisecondsF());
+  details.Set("stack", hang.stack);
+  Emit("main-process-hang", details);
+}
+
+base::Value::Dict App::GetStartupMetrics() {
+  return startup_metrics::GetMetrics();
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   return gin::ConvertToV8(isolate, content::GetFeatureStatus());
 }
 
+v8::Local<v8::Value> App::GetMediaCaptureDevices(v8::Isolate* isolate) {
+  auto* dispatcher = MediaCaptureDevicesDispatcher::GetInstance();
+  auto to_v8 = [isolate](const blink::MediaStreamDevices& devices) {
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> result =
+        v8::Array::New(isolate, static_cast<int>(devices.size()));
+    for (size_t i = 0; i < devices.size(); ++i) {
+      auto device = gin_helper::Dictionary::CreateEmpty(isolate);
+      device.Set("id", devices[i].id);
+      device.Set("name", devices[i].name);
+      if (devices[i].group_id)
+        device.Set("groupId", *devices[i].group_id);
+      result->Set(context, static_cast<uint32_t>(i), device.GetHandle())
+          .Check();
+    }
+    return result;
+  };
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("audio", to_v8(dispatcher->GetCachedAudioCaptureDevices()));
+  dict.Set("video", to_v8(dispatcher->GetCachedVideoCaptureDevices()));
+  return dict.GetHandle();
+}
+
 v8::Local<v8::Promise> App::GetGPUInfo(v8::Isolate* isolate,
                                        const std::string& info_type) {
   auto* const gpu_data_manager = content::GpuDataManagerImpl::GetInstance();
@@ -1779,8 +1974,24 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("startProcessMetricsSampling",
+                 &App::StartProcessMetricsSampling)
+      .SetMethod("stopProcessMetricsSampling", &App::StopProcessMetricsSampling)
+      .SetMethod("getProcessMetricsHistory", &App::GetProcessMetricsHistory)
+      .SetMethod("startCpuProfiling", &App::StartCpuProfiling)
+      .SetMethod("stopCpuProfiling", &App::StopCpuProfiling)
+      .SetMethod("getEventLoopStats", &App::GetEventLoopStats)
+      .SetMethod("resetEventLoopStats", &App::ResetEventLoopStats)
+      .SetMethod("setSkipIdleMicrotaskCheckpoints",
+                 &App::SetSkipIdleMicrotaskCheckpoints)
+      .SetMethod("getBlockingCallStats", &App::GetBlockingCallStats)
+      .SetMethod("resetBlockingCallStats", &App::ResetBlockingCallStats)
+      .SetMethod("startHangMonitor", &App::StartHangMonitor)
+      .SetMethod("stopHangMonitor", &App::StopHangMonitor)
+      .SetMethod("getStartupMetrics", &App::GetStartupMetrics)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
+      .SetMethod("getMediaCaptureDevices", &App::GetMediaCaptureDevices)
 #if IS_MAS_BUILD()
       .SetMethod("startAccessingSecurityScopedResource",
                  &App::StartAccessingSecurityScopedResource)
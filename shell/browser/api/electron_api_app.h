@@ -23,10 +23,14 @@
 #include "net/base/completion_repeating_callback.h"
 #include "net/ssl/client_cert_identity.h"
 #include "shell/browser/api/process_metric.h"
+#include "shell/browser/api/hang_monitor.h"
+#include "shell/browser/api/process_metrics_sampler.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/media/media_capture_devices_dispatcher.h"
+#include "shell/common/cpu_profiler.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
@@ -52,7 +56,8 @@ class App : public ElectronBrowserClient::Delegate,
             public gin_helper::EventEmitterMixin<App>,
             public BrowserObserver,
             public content::GpuDataManagerObserver,
-            public content::BrowserChildProcessObserver {
+            public content::BrowserChildProcessObserver,
+            public MediaCaptureDevicesDispatcher::Observer {
  public:
   using FileIconCallback =
       base::RepeatingCallback<void(v8::Local<v8::Value>, const gfx::Image&)>;
@@ -155,6 +160,9 @@ class App : public ElectronBrowserClient::Delegate,
   // content::GpuDataManagerObserver:
   void OnGpuInfoUpdate() override;
 
+  // MediaCaptureDevicesDispatcher::Observer:
+  void OnMediaCaptureDevicesChanged() override;
+
   // content::BrowserChildProcessObserver:
   void BrowserChildProcessLaunchedAndConnected(
       const content::ChildProcessData& data) override;
@@ -216,9 +224,27 @@ class App : public ElectronBrowserClient::Delegate,
                                      gin::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  void StartProcessMetricsSampling(gin_helper::ErrorThrower thrower,
+                                   gin::Arguments* args);
+  void StopProcessMetricsSampling();
+  v8::Local<v8::Value> GetProcessMetricsHistory(v8::Isolate* isolate);
+  bool StartCpuProfiling(gin_helper::ErrorThrower thrower,
+                         gin::Arguments* args);
+  v8::Local<v8::Promise> StopCpuProfiling(v8::Isolate* isolate,
+                                          const base::FilePath& file_path);
+  base::Value::Dict GetEventLoopStats();
+  void ResetEventLoopStats();
+  void SetSkipIdleMicrotaskCheckpoints(bool skip);
+  base::Value::List GetBlockingCallStats();
+  void ResetBlockingCallStats();
+  void StartHangMonitor(gin_helper::ErrorThrower thrower, gin::Arguments* args);
+  void StopHangMonitor();
+  void OnHang(const HangMonitor::Hang& hang);
+  base::Value::Dict GetStartupMetrics();
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
+  v8::Local<v8::Value> GetMediaCaptureDevices(v8::Isolate* isolate);
   void EnableSandbox(gin_helper::ErrorThrower thrower);
   void SetUserAgentFallback(const std::string& user_agent);
   std::string GetUserAgentFallback();
@@ -265,6 +291,13 @@ class App : public ElectronBrowserClient::Delegate,
   // pid -> electron::ProcessMetric
   base::flat_map<int, std::unique_ptr<electron::ProcessMetric>> app_metrics_;
 
+  // Samples the processes of |app_metrics_| in the background.
+  std::unique_ptr<ProcessMetricsSampler> process_metrics_sampler_;
+
+  std::unique_ptr<CpuProfiler> cpu_profiler_;
+
+  std::unique_ptr<HangMonitor> hang_monitor_;
+
   bool disable_hw_acceleration_ = false;
   bool disable_domain_blocking_for_3DAPIs_ = false;
   bool watch_singleton_socket_on_ready_ = false;
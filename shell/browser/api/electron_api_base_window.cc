@@ -85,9 +85,11 @@ BaseWindow::BaseWindow(v8::Isolate* isolate,
 
   // Offscreen windows are always created frameless.
   gin_helper::Dictionary web_preferences;
-  bool offscreen;
+  gin_helper::Dictionary offscreen_options;
+  bool offscreen = false;
   if (options.Get(options::kWebPreferences, &web_preferences) &&
-      web_preferences.Get(options::kOffscreen, &offscreen) && offscreen) {
+      (web_preferences.Get(options::kOffscreen, &offscreen_options) ||
+       (web_preferences.Get(options::kOffscreen, &offscreen) && offscreen))) {
     const_cast<gin_helper::Dictionary&>(options).Set(options::kFrame, false);
   }
 
@@ -849,6 +851,15 @@ void BaseWindow::RefreshTouchBarItem(const std::string& item_id) {
   window_->RefreshTouchBarItem(item_id);
 }
 
+void BaseWindow::SetTouchBarItemLabel(const std::string& item_id,
+                                      const std::string& label) {
+  window_->SetTouchBarItemLabel(item_id, label);
+}
+
+void BaseWindow::SetTouchBarItemValue(const std::string& item_id, int value) {
+  window_->SetTouchBarItemValue(item_id, value);
+}
+
 void BaseWindow::SetEscapeTouchBarItem(gin_helper::PersistentDictionary item) {
   window_->SetEscapeTouchBarItem(std::move(item));
 }
@@ -1076,21 +1087,21 @@ void BaseWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("close", &BaseWindow::Close)
       .SetMethod("focus", &BaseWindow::Focus)
       .SetMethod("blur", &BaseWindow::Blur)
-      .SetMethod("isFocused", &BaseWindow::IsFocused)
+      .SetFastMethod<&BaseWindow::IsFocused>("isFocused")
       .SetMethod("show", &BaseWindow::Show)
       .SetMethod("showInactive", &BaseWindow::ShowInactive)
       .SetMethod("hide", &BaseWindow::Hide)
-      .SetMethod("isVisible", &BaseWindow::IsVisible)
+      .SetFastMethod<&BaseWindow::IsVisible>("isVisible")
       .SetMethod("isEnabled", &BaseWindow::IsEnabled)
       .SetMethod("setEnabled", &BaseWindow::SetEnabled)
       .SetMethod("maximize", &BaseWindow::Maximize)
       .SetMethod("unmaximize", &BaseWindow::Unmaximize)
-      .SetMethod("isMaximized", &BaseWindow::IsMaximized)
+      .SetFastMethod<&BaseWindow::IsMaximized>("isMaximized")
       .SetMethod("minimize", &BaseWindow::Minimize)
       .SetMethod("restore", &BaseWindow::Restore)
-      .SetMethod("isMinimized", &BaseWindow::IsMinimized)
+      .SetFastMethod<&BaseWindow::IsMinimized>("isMinimized")
       .SetMethod("setFullScreen", &BaseWindow::SetFullScreen)
-      .SetMethod("isFullScreen", &BaseWindow::IsFullscreen)
+      .SetFastMethod<&BaseWindow::IsFullscreen>("isFullScreen")
       .SetMethod("setBounds", &BaseWindow::SetBounds)
       .SetMethod("getBounds", &BaseWindow::GetBounds)
       .SetMethod("isNormal", &BaseWindow::IsNormal)
@@ -1179,6 +1190,8 @@ void BaseWindow::BuildPrototype(v8::Isolate* isolate,
 
       .SetMethod("_setTouchBarItems", &BaseWindow::SetTouchBar)
       .SetMethod("_refreshTouchBarItem", &BaseWindow::RefreshTouchBarItem)
+      .SetMethod("_setTouchBarItemLabel", &BaseWindow::SetTouchBarItemLabel)
+      .SetMethod("_setTouchBarItemValue", &BaseWindow::SetTouchBarItemValue)
       .SetMethod("_setEscapeTouchBarItem", &BaseWindow::SetEscapeTouchBarItem)
 #if BUILDFLAG(IS_MAC)
       .SetMethod("selectPreviousTab", &BaseWindow::SelectPreviousTab)
@@ -1228,7 +1241,7 @@ void BaseWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setThumbnailToolTip", &BaseWindow::SetThumbnailToolTip)
       .SetMethod("setAppDetails", &BaseWindow::SetAppDetails)
 #endif
-      .SetProperty("id", &BaseWindow::GetID);
+      .SetFastProperty<&BaseWindow::GetID>("id");
 }
 
 }  // namespace electron::api
@@ -1237,6 +1250,25 @@ namespace {
 
 using electron::api::BaseWindow;
 
+void BeginBatchUpdate(gin_helper::ErrorThrower thrower,
+                      const std::vector<v8::Local<v8::Value>>& values) {
+  std::vector<electron::NativeWindow*> windows;
+  for (v8::Local<v8::Value> value : values) {
+    gin::Handle<BaseWindow> window;
+    if (!gin::ConvertFromV8(thrower.isolate(), value, &window)) {
+      thrower.ThrowTypeError("Must pass an array of BaseWindow instances");
+      return;
+    }
+    if (!window->IsDestroyed())
+      windows.push_back(window->window());
+  }
+  electron::NativeWindow::BeginBatchUpdate(windows);
+}
+
+void EndBatchUpdate() {
+  electron::NativeWindow::EndBatchUpdate();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -1253,6 +1285,8 @@ void Initialize(v8::Local<v8::Object> exports,
 
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("BaseWindow", constructor);
+  dict.SetMethod("beginBatchUpdate", &BeginBatchUpdate);
+  dict.SetMethod("endBatchUpdate", &EndBatchUpdate);
 }
 
 }  // namespace
@@ -198,6 +198,9 @@ class BaseWindow : public gin_helper::TrackableObject<BaseWindow>,
 
   void SetTouchBar(std::vector<gin_helper::PersistentDictionary> items);
   void RefreshTouchBarItem(const std::string& item_id);
+  void SetTouchBarItemLabel(const std::string& item_id,
+                            const std::string& label);
+  void SetTouchBarItemValue(const std::string& item_id, int value);
   void SetEscapeTouchBarItem(gin_helper::PersistentDictionary item);
   void SelectPreviousTab();
   void SelectNextTab();
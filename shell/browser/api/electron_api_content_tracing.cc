@@ -2,22 +2,35 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
 #include <utility>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/memory/weak_ptr.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/bind_post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
 #include "base/trace_event/trace_config.h"
 #include "content/public/browser/tracing_controller.h"
+#include "services/tracing/public/cpp/perfetto/perfetto_config.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "third_party/perfetto/include/perfetto/tracing/tracing.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <io.h>
+#endif
 
 using content::TracingController;
 
@@ -169,6 +182,231 @@ v8::Local<v8::Promise> GetTraceBufferUsage(v8::Isolate* isolate) {
   return handle;
 }
 
+struct StreamingOptions {
+  base::FilePath file_path;
+  base::TimeDelta file_write_period = base::Seconds(5);
+  uint32_t buffer_size_kb = 4 * 1024;
+  uint64_t max_file_size = 0;
+  int max_files = 1;
+};
+
+// Opens |path| for a new trace, after moving the previous files to |path|.1,
+// |path|.2, ... so that |max_files| files are kept in total.
+base::File OpenTraceFile(const base::FilePath& path, int max_files) {
+  for (int i = max_files - 1; i > 0; --i) {
+    const base::FilePath from =
+        i == 1 ? path : path.AddExtensionASCII(base::NumberToString(i - 1));
+    base::Move(from, path.AddExtensionASCII(base::NumberToString(i)));
+  }
+  return base::File(path, base::File::FLAG_CREATE_ALWAYS |
+                              base::File::FLAG_WRITE);
+}
+
+// Records a perfetto session whose trace buffer is periodically written into a
+// file by the tracing service, instead of being kept in memory until the end
+// of the recording like contentTracing.startRecording() does. Once a file
+// reaches |max_file_size| the session is restarted with a new file.
+class TraceStreamer {
+ public:
+  static TraceStreamer* GetInstance() {
+    static base::NoDestructor<TraceStreamer> instance;
+    return instance.get();
+  }
+
+  TraceStreamer() = default;
+
+  // disable copy
+  TraceStreamer(const TraceStreamer&) = delete;
+  TraceStreamer& operator=(const TraceStreamer&) = delete;
+
+  void Start(const base::trace_event::TraceConfig& trace_config,
+             const StreamingOptions& options,
+             gin_helper::Promise<void> promise) {
+    if (active_) {
+      promise.RejectWithErrorMessage(
+          "Failed to start streaming - a trace is already being streamed");
+      return;
+    }
+    active_ = true;
+    stopping_ = false;
+    options_ = options;
+    start_promise_.emplace(std::move(promise));
+
+    config_ = tracing::GetDefaultPerfettoConfig(trace_config);
+    config_.set_write_into_file(true);
+    config_.set_file_write_period_ms(
+        options.file_write_period.InMilliseconds());
+    if (options.max_file_size)
+      config_.set_max_file_size_bytes(options.max_file_size);
+    // The buffer only has to hold what is traced between two writes, the
+    // oldest events are overwritten when it is too small.
+    for (auto& buffer : *config_.mutable_buffers()) {
+      buffer.set_size_kb(options.buffer_size_kb);
+      buffer.set_fill_policy(
+          perfetto::TraceConfig::BufferConfig::RING_BUFFER);
+    }
+    OpenFile();
+  }
+
+  void Stop(gin_helper::Promise<void> promise) {
+    if (!active_ || stopping_) {
+      promise.RejectWithErrorMessage(
+          "Failed to stop streaming - no trace is being streamed");
+      return;
+    }
+    stopping_ = true;
+    stop_promise_.emplace(std::move(promise));
+    // Otherwise the file is still being opened, see OnFileOpened().
+    if (session_)
+      session_->Stop();
+  }
+
+ private:
+  void OpenFile() {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(&OpenTraceFile, options_.file_path, options_.max_files),
+        base::BindOnce(&TraceStreamer::OnFileOpened,
+                       weak_factory_.GetWeakPtr()));
+  }
+
+  void OnFileOpened(base::File file) {
+    if (!file.IsValid()) {
+      Finish("Failed to open the trace file");
+      return;
+    }
+    if (stopping_) {
+      Finish(std::nullopt);
+      return;
+    }
+
+#if BUILDFLAG(IS_WIN)
+    const int fd =
+        _open_osfhandle(reinterpret_cast<intptr_t>(file.TakePlatformFile()), 0);
+#else
+    const int fd = file.TakePlatformFile();
+#endif
+
+    // The callbacks run on the tracing service's sequence.
+    auto on_start = base::BindPostTaskToCurrentDefault(base::BindRepeating(
+        &TraceStreamer::OnSessionStarted, weak_factory_.GetWeakPtr()));
+    auto on_stop = base::BindPostTaskToCurrentDefault(base::BindRepeating(
+        &TraceStreamer::OnSessionStopped, weak_factory_.GetWeakPtr()));
+    session_ = perfetto::Tracing::NewTrace();
+    session_->Setup(config_, fd);
+    session_->SetOnStartCallback([on_start] { on_start.Run(); });
+    session_->SetOnStopCallback([on_stop] { on_stop.Run(); });
+    session_->Start();
+  }
+
+  void OnSessionStarted() {
+    if (start_promise_) {
+      start_promise_->Resolve();
+      start_promise_.reset();
+    }
+  }
+
+  void OnSessionStopped() {
+    session_.reset();
+    // The session stops by itself when the file reached its maximum size.
+    if (!stopping_ && options_.max_files > 1) {
+      OpenFile();
+      return;
+    }
+    Finish(std::nullopt);
+  }
+
+  void Finish(std::optional<std::string> error) {
+    active_ = false;
+    if (start_promise_) {
+      if (error)
+        start_promise_->RejectWithErrorMessage(*error);
+      else
+        start_promise_->Resolve();
+      start_promise_.reset();
+    }
+    if (stop_promise_) {
+      if (error)
+        stop_promise_->RejectWithErrorMessage(*error);
+      else
+        stop_promise_->Resolve();
+      stop_promise_.reset();
+    }
+  }
+
+  bool active_ = false;
+  bool stopping_ = false;
+  StreamingOptions options_;
+  perfetto::TraceConfig config_;
+  std::unique_ptr<perfetto::TracingSession> session_;
+  std::optional<gin_helper::Promise<void>> start_promise_;
+  std::optional<gin_helper::Promise<void>> stop_promise_;
+
+  base::WeakPtrFactory<TraceStreamer> weak_factory_{this};
+};
+
+v8::Local<v8::Promise> StartStreaming(gin_helper::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  StreamingOptions options;
+  if (!args->GetNext(&options.file_path) || options.file_path.empty()) {
+    promise.RejectWithErrorMessage("filePath must be a non-empty string");
+    return handle;
+  }
+
+  base::trace_event::TraceConfig trace_config;
+  if (!args->GetNext(&trace_config)) {
+    promise.RejectWithErrorMessage("Invalid trace config");
+    return handle;
+  }
+
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    int file_write_period = 0;
+    if (dict.Get("fileWritePeriod", &file_write_period)) {
+      if (file_write_period <= 0) {
+        promise.RejectWithErrorMessage(
+            "fileWritePeriod must be a positive number");
+        return handle;
+      }
+      options.file_write_period = base::Milliseconds(file_write_period);
+    }
+    int buffer_size = 0;
+    if (dict.Get("bufferSize", &buffer_size)) {
+      if (buffer_size <= 0) {
+        promise.RejectWithErrorMessage("bufferSize must be a positive number");
+        return handle;
+      }
+      options.buffer_size_kb = buffer_size;
+    }
+    double max_file_size = 0;
+    if (dict.Get("maxFileSize", &max_file_size)) {
+      if (max_file_size <= 0) {
+        promise.RejectWithErrorMessage(
+            "maxFileSize must be a positive number");
+        return handle;
+      }
+      options.max_file_size = static_cast<uint64_t>(max_file_size);
+    }
+    if (dict.Get("maxFiles", &options.max_files) && options.max_files <= 0) {
+      promise.RejectWithErrorMessage("maxFiles must be a positive number");
+      return handle;
+    }
+  }
+
+  TraceStreamer::GetInstance()->Start(trace_config, options,
+                                      std::move(promise));
+  return handle;
+}
+
+v8::Local<v8::Promise> StopStreaming(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  TraceStreamer::GetInstance()->Stop(std::move(promise));
+  return handle;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -178,6 +416,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("startRecording", &StartTracing);
   dict.SetMethod("stopRecording", &StopRecording);
   dict.SetMethod("getTraceBufferUsage", &GetTraceBufferUsage);
+  dict.SetMethod("startStreaming", &StartStreaming);
+  dict.SetMethod("stopStreaming", &StopStreaming);
 }
 
 }  // namespace
@@ -4,28 +4,45 @@
 
 #include "shell/browser/api/electron_api_cookies.h"
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
-
+#include <vector>
+
+#include "base/containers/contains.h"
+#include "base/containers/span.h"
+#include "base/no_destructor.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
 #include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
+#include "gin/arguments.h"
 #include "gin/dictionary.h"
 #include "gin/object_template_builder.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_inclusion_status.h"
 #include "net/cookies/cookie_store.h"
 #include "net/cookies/cookie_util.h"
+#include "services/network/public/mojom/cookie_manager.mojom.h"
 #include "shell/browser/cookie_change_notifier.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/dictionary_template.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 
 namespace gin {
@@ -51,21 +68,40 @@ struct Converter<net::CookieSameSite> {
 
 template <>
 struct Converter<net::CanonicalCookie> {
+  // The properties of a cookie object, in order.
+  static constexpr std::string_view kFields[] = {
+      "name",     "value",          "domain",  "hostOnly", "path",
+      "secure",   "httpOnly",       "session", "expirationDate",
+      "sameSite"};
+
+  // Fills |values| with the properties of |val|, in the order of kFields.
+  // expirationDate is left empty for session cookies.
+  static void ToValues(v8::Isolate* isolate,
+                       const net::CanonicalCookie& val,
+                       base::span<v8::MaybeLocal<v8::Value>> values) {
+    CHECK_EQ(values.size(), std::size(kFields));
+    values[0] = ConvertToV8(isolate, val.Name());
+    values[1] = ConvertToV8(isolate, val.Value());
+    values[2] = ConvertToV8(isolate, val.Domain());
+    values[3] =
+        ConvertToV8(isolate, net::cookie_util::DomainIsHostOnly(val.Domain()));
+    values[4] = ConvertToV8(isolate, val.Path());
+    values[5] = ConvertToV8(isolate, val.SecureAttribute());
+    values[6] = ConvertToV8(isolate, val.IsHttpOnly());
+    values[7] = ConvertToV8(isolate, !val.IsPersistent());
+    values[8] = val.IsPersistent()
+                    ? ConvertToV8(isolate,
+                                  val.ExpiryDate().InSecondsFSinceUnixEpoch())
+                    : v8::MaybeLocal<v8::Value>();
+    values[9] = ConvertToV8(isolate, val.SameSite());
+  }
+
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
                                    const net::CanonicalCookie& val) {
-    gin::Dictionary dict(isolate, v8::Object::New(isolate));
-    dict.Set("name", val.Name());
-    dict.Set("value", val.Value());
-    dict.Set("domain", val.Domain());
-    dict.Set("hostOnly", net::cookie_util::DomainIsHostOnly(val.Domain()));
-    dict.Set("path", val.Path());
-    dict.Set("secure", val.SecureAttribute());
-    dict.Set("httpOnly", val.IsHttpOnly());
-    dict.Set("session", !val.IsPersistent());
-    if (val.IsPersistent())
-      dict.Set("expirationDate", val.ExpiryDate().InSecondsFSinceUnixEpoch());
-    dict.Set("sameSite", val.SameSite());
-    return ConvertToV8(isolate, dict).As<v8::Object>();
+    static base::NoDestructor<gin_helper::DictionaryTemplate> templ(kFields);
+    v8::MaybeLocal<v8::Value> values[std::size(kFields)];
+    ToValues(isolate, val, values);
+    return templ->NewInstance(isolate, values);
   }
 };
 
@@ -97,6 +133,9 @@ namespace electron::api {
 
 namespace {
 
+// The number of cookies in a page of cookies.getPage() by default.
+constexpr int kDefaultCookiePageLimit = 1000;
+
 // Returns whether |domain| matches |filter|.
 bool MatchesDomain(std::string filter, const std::string& domain) {
   // Add a leading '.' character to the filter domain if it doesn't exist.
@@ -118,48 +157,197 @@ bool MatchesDomain(std::string filter, const std::string& domain) {
   return false;
 }
 
+// The properties of a filter that cookies are matched against, parsed once
+// instead of being looked up for every cookie.
+struct CookieFilter {
+  explicit CookieFilter(const base::Value::Dict& filter) {
+    if (const std::string* str = filter.FindString("name"))
+      name = *str;
+    if (const std::string* str = filter.FindString("path"))
+      path = *str;
+    if (const std::string* str = filter.FindString("domain"))
+      domain = *str;
+    secure = filter.FindBool("secure");
+    session = filter.FindBool("session");
+    http_only = filter.FindBool("httpOnly");
+  }
+
+  std::optional<std::string> name;
+  std::optional<std::string> path;
+  std::optional<std::string> domain;
+  std::optional<bool> secure;
+  std::optional<bool> session;
+  std::optional<bool> http_only;
+};
+
 // Returns whether |cookie| matches |filter|.
-bool MatchesCookie(const base::Value::Dict& filter,
+bool MatchesCookie(const CookieFilter& filter,
                    const net::CanonicalCookie& cookie) {
-  const std::string* str;
-  if ((str = filter.FindString("name")) && *str != cookie.Name())
+  if (filter.name && *filter.name != cookie.Name())
     return false;
-  if ((str = filter.FindString("path")) && *str != cookie.Path())
+  if (filter.path && *filter.path != cookie.Path())
     return false;
-  if ((str = filter.FindString("domain")) &&
-      !MatchesDomain(*str, cookie.Domain()))
+  if (filter.domain && !MatchesDomain(*filter.domain, cookie.Domain()))
     return false;
-  std::optional<bool> secure_filter = filter.FindBool("secure");
-  if (secure_filter && *secure_filter != cookie.SecureAttribute())
+  if (filter.secure && *filter.secure != cookie.SecureAttribute())
     return false;
-  std::optional<bool> session_filter = filter.FindBool("session");
-  if (session_filter && *session_filter == cookie.IsPersistent())
+  if (filter.session && *filter.session == cookie.IsPersistent())
     return false;
-  std::optional<bool> httpOnly_filter = filter.FindBool("httpOnly");
-  if (httpOnly_filter && *httpOnly_filter != cookie.IsHttpOnly())
+  if (filter.http_only && *filter.http_only != cookie.IsHttpOnly())
     return false;
   return true;
 }
 
-// Remove cookies from |list| not matching |filter|, and pass it to |callback|.
-void FilterCookies(base::Value::Dict filter,
-                   gin_helper::Promise<net::CookieList> promise,
-                   const net::CookieList& cookies) {
-  net::CookieList result;
-  for (const auto& cookie : cookies) {
-    if (MatchesCookie(filter, cookie))
-      result.push_back(cookie);
+// The position of a cookie in the pages of cookies.getPage(). Cookies are
+// ordered by domain, path and name, then by creation date which the cookie
+// store keeps unique.
+struct CookiePosition {
+  std::string domain;
+  std::string path;
+  std::string name;
+  base::Time creation_date;
+};
+
+auto PositionKey(const net::CanonicalCookie& cookie) {
+  return std::tie(cookie.Domain(), cookie.Path(), cookie.Name(),
+                  cookie.CreationDate());
+}
+
+auto PositionKey(const CookiePosition& position) {
+  return std::tie(position.domain, position.path, position.name,
+                  position.creation_date);
+}
+
+// Cursors are opaque to the app, cookies can't have newlines in these parts.
+std::string PositionToCursor(const net::CanonicalCookie& cookie) {
+  return base::JoinString(
+      {cookie.Domain(), cookie.Path(), cookie.Name(),
+       base::NumberToString(
+           cookie.CreationDate().ToDeltaSinceWindowsEpoch().InMicroseconds())},
+      "\n");
+}
+
+std::optional<CookiePosition> PositionFromCursor(std::string_view cursor) {
+  std::vector<std::string> parts = base::SplitString(
+      cursor, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  int64_t creation_date;
+  if (parts.size() != 4 || !base::StringToInt64(parts[3], &creation_date))
+    return std::nullopt;
+  return CookiePosition{
+      std::move(parts[0]), std::move(parts[1]), std::move(parts[2]),
+      base::Time::FromDeltaSinceWindowsEpoch(
+          base::Microseconds(creation_date))};
+}
+
+// Runs on the thread pool, so that matching many cookies doesn't block the
+// UI thread.
+net::CookieList FilterCookies(const CookieFilter& filter,
+                              net::CookieList cookies) {
+  TRACE_EVENT1("electron", "FilterCookies", "count", cookies.size());
+  std::erase_if(cookies, [&filter](const net::CanonicalCookie& cookie) {
+    return !MatchesCookie(filter, cookie);
+  });
+  return cookies;
+}
+
+struct CookiePage {
+  net::CookieList cookies;
+  // The cursor of the next page, if any.
+  std::optional<std::string> cursor;
+};
+
+// Like FilterCookies(), but returns at most |limit| cookies that come after
+// |after|.
+CookiePage GetCookiePage(const CookieFilter& filter,
+                         const std::optional<CookiePosition>& after,
+                         size_t limit,
+                         net::CookieList cookies) {
+  TRACE_EVENT1("electron", "GetCookiePage", "count", cookies.size());
+  std::erase_if(cookies, [&](const net::CanonicalCookie& cookie) {
+    return !MatchesCookie(filter, cookie) ||
+           (after && PositionKey(cookie) <= PositionKey(*after));
+  });
+
+  CookiePage page;
+  const auto less = [](const net::CanonicalCookie& a,
+                       const net::CanonicalCookie& b) {
+    return PositionKey(a) < PositionKey(b);
+  };
+  if (cookies.size() > limit) {
+    std::partial_sort(cookies.begin(), cookies.begin() + limit, cookies.end(),
+                      less);
+    cookies.resize(limit);
+    page.cursor = PositionToCursor(cookies.back());
+  } else {
+    std::sort(cookies.begin(), cookies.end(), less);
   }
-  promise.Resolve(result);
+  page.cookies = std::move(cookies);
+  return page;
 }
 
-void FilterCookieWithStatuses(
-    base::Value::Dict filter,
-    gin_helper::Promise<net::CookieList> promise,
-    const net::CookieAccessResultList& list,
-    const net::CookieAccessResultList& excluded_list) {
-  FilterCookies(std::move(filter), std::move(promise),
+// Calls |callback| with the cookies that the cookie manager returned, either
+// all of them or those for |url|.
+void GetCookieList(network::mojom::CookieManager* manager,
+                   const std::string& url,
+                   base::OnceCallback<void(net::CookieList)> callback) {
+  if (url.empty()) {
+    manager->GetAllCookies(base::BindOnce(
+        [](base::OnceCallback<void(net::CookieList)> callback,
+           const net::CookieList& cookies) {
+          std::move(callback).Run(cookies);
+        },
+        std::move(callback)));
+    return;
+  }
+
+  net::CookieOptions options;
+  options.set_include_httponly();
+  options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+  options.set_do_not_update_access_time();
+
+  manager->GetCookieList(
+      GURL(url), options, net::CookiePartitionKeyCollection::Todo(),
+      base::BindOnce(
+          [](base::OnceCallback<void(net::CookieList)> callback,
+             const net::CookieAccessResultList& list,
+             const net::CookieAccessResultList& excluded_list) {
+            std::move(callback).Run(
                 net::cookie_util::StripAccessResults(list));
+          },
+          std::move(callback)));
+}
+
+// Converts |page| to what cookies.getPage() resolves with.
+v8::Local<v8::Value> CookiePageToV8(v8::Isolate* isolate,
+                                    const CookiePage& page,
+                                    bool columns) {
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  if (columns) {
+    using CookieConverter = gin::Converter<net::CanonicalCookie>;
+    constexpr size_t kFieldCount = std::size(CookieConverter::kFields);
+    v8::LocalVector<v8::Value> values(isolate);
+    values.reserve(page.cookies.size() * kFieldCount);
+    v8::MaybeLocal<v8::Value> row[kFieldCount];
+    for (const auto& cookie : page.cookies) {
+      CookieConverter::ToValues(isolate, cookie, row);
+      for (const auto& value : row) {
+        values.push_back(value.IsEmpty()
+                             ? v8::Undefined(isolate).As<v8::Value>()
+                             : value.ToLocalChecked());
+      }
+    }
+    dict.Set("fields", std::vector<std::string>(
+                           std::begin(CookieConverter::kFields),
+                           std::end(CookieConverter::kFields)));
+    dict.Set("values", v8::Local<v8::Value>(v8::Array::New(
+                           isolate, values.data(), values.size())));
+  } else {
+    dict.Set("cookies", page.cookies);
+  }
+  if (page.cursor)
+    dict.Set("cursor", *page.cursor);
+  return dict.GetHandle();
 }
 
 // Parse dictionary property to CanonicalCookie time correctly.
@@ -228,6 +416,12 @@ Cookies::Cookies(v8::Isolate* isolate, ElectronBrowserContext* browser_context)
 
 Cookies::~Cookies() = default;
 
+Cookies::ChangeBatching::ChangeBatching() = default;
+Cookies::ChangeBatching::ChangeBatching(ChangeBatching&&) = default;
+Cookies::ChangeBatching& Cookies::ChangeBatching::operator=(ChangeBatching&&) =
+    default;
+Cookies::ChangeBatching::~ChangeBatching() = default;
+
 v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
                                     const gin_helper::Dictionary& filter) {
   gin_helper::Promise<net::CookieList> promise(isolate);
@@ -241,22 +435,86 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
 
   std::string url;
   filter.Get("url", &url);
-  if (url.empty()) {
-    manager->GetAllCookies(
-        base::BindOnce(&FilterCookies, std::move(dict), std::move(promise)));
-  } else {
-    net::CookieOptions options;
-    options.set_include_httponly();
-    options.set_same_site_cookie_context(
-        net::CookieOptions::SameSiteCookieContext::MakeInclusive());
-    options.set_do_not_update_access_time();
-
-    manager->GetCookieList(GURL(url), options,
-                           net::CookiePartitionKeyCollection::Todo(),
-                           base::BindOnce(&FilterCookieWithStatuses,
-                                          std::move(dict), std::move(promise)));
+  GetCookieList(
+      manager, url,
+      base::BindOnce(
+          [](CookieFilter filter, gin_helper::Promise<net::CookieList> promise,
+             net::CookieList cookies) {
+            base::ThreadPool::PostTaskAndReplyWithResult(
+                FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+                base::BindOnce(&FilterCookies, std::move(filter),
+                               std::move(cookies)),
+                base::BindOnce(
+                    &gin_helper::Promise<net::CookieList>::ResolvePromise,
+                    std::move(promise)));
+          },
+          CookieFilter(dict), std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::GetPage(v8::Isolate* isolate,
+                                        const gin_helper::Dictionary& filter,
+                                        gin::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  int limit = kDefaultCookiePageLimit;
+  std::optional<CookiePosition> after;
+  std::string format = "objects";
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    if (options.Has("limit") &&
+        (!options.Get("limit", &limit) || limit <= 0)) {
+      promise.RejectWithErrorMessage("limit must be a positive integer");
+      return handle;
+    }
+    std::string cursor;
+    if (options.Get("cursor", &cursor) &&
+        !(after = PositionFromCursor(cursor))) {
+      promise.RejectWithErrorMessage("Invalid cursor");
+      return handle;
+    }
+    options.Get("format", &format);
+    if (format != "objects" && format != "columns") {
+      promise.RejectWithErrorMessage(
+          "format must be either 'objects' or 'columns'");
+      return handle;
+    }
   }
 
+  base::Value::Dict dict;
+  gin::ConvertFromV8(isolate, filter.GetHandle(), &dict);
+
+  std::string url;
+  filter.Get("url", &url);
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  GetCookieList(
+      manager, url,
+      base::BindOnce(
+          [](CookieFilter filter, std::optional<CookiePosition> after,
+             size_t limit, bool columns,
+             gin_helper::Promise<v8::Local<v8::Value>> promise,
+             net::CookieList cookies) {
+            base::ThreadPool::PostTaskAndReplyWithResult(
+                FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+                base::BindOnce(&GetCookiePage, std::move(filter),
+                               std::move(after), limit, std::move(cookies)),
+                base::BindOnce(
+                    [](bool columns,
+                       gin_helper::Promise<v8::Local<v8::Value>> promise,
+                       CookiePage page) {
+                      v8::Isolate* isolate = promise.isolate();
+                      v8::HandleScope handle_scope(isolate);
+                      promise.Resolve(CookiePageToV8(isolate, page, columns));
+                    },
+                    columns, std::move(promise)));
+          },
+          CookieFilter(dict), std::move(after), static_cast<size_t>(limit),
+          format == "columns", std::move(promise)));
+
   return handle;
 }
 
@@ -349,9 +607,10 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
       base::BindOnce(
           [](gin_helper::Promise<void> promise, net::CookieAccessResult r) {
             if (r.status.IsInclude()) {
-              promise.Resolve();
+              gin_helper::Promise<void>::ResolvePromise(std::move(promise));
             } else {
-              promise.RejectWithErrorMessage(InclusionStatusToString(r.status));
+              gin_helper::Promise<void>::RejectPromise(
+                  std::move(promise), InclusionStatusToString(r.status));
             }
           },
           std::move(promise)));
@@ -372,7 +631,83 @@ v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   return handle;
 }
 
+void Cookies::SetChangeBatching(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    // Turning batching off delivers what was pending right away.
+    change_batching_.reset();
+    pending_changes_timer_.Stop();
+    EmitPendingChanges();
+    return;
+  }
+
+  int interval = 0;
+  if (!options.Get("interval", &interval) || interval <= 0) {
+    args->ThrowTypeError("interval must be a positive integer");
+    return;
+  }
+  ChangeBatching batching;
+  batching.interval = base::Milliseconds(interval);
+  if ((options.Has("domains") &&
+       !options.Get("domains", &batching.domains)) ||
+      (options.Has("names") && !options.Get("names", &batching.names))) {
+    args->ThrowTypeError("domains and names must be arrays of strings");
+    return;
+  }
+  change_batching_ = std::move(batching);
+}
+
+bool Cookies::MatchesChangeBatching(const net::CanonicalCookie& cookie) const {
+  if (!change_batching_->names.empty() &&
+      !base::Contains(change_batching_->names, cookie.Name()))
+    return false;
+  if (!change_batching_->domains.empty() &&
+      base::ranges::none_of(change_batching_->domains,
+                            [&cookie](const std::string& domain) {
+                              return MatchesDomain(domain, cookie.Domain());
+                            }))
+    return false;
+  return true;
+}
+
+void Cookies::EmitPendingChanges() {
+  if (pending_changes_.empty())
+    return;
+  std::vector<net::CookieChangeInfo> changes = std::move(pending_changes_);
+  pending_changes_.clear();
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  static base::NoDestructor<gin_helper::DictionaryTemplate> templ(
+      {"cookie", "cause", "removed"});
+  v8::LocalVector<v8::Value> values(isolate);
+  values.reserve(changes.size());
+  for (const auto& change : changes) {
+    v8::MaybeLocal<v8::Value> properties[] = {
+        gin::ConvertToV8(isolate, change.cookie),
+        gin::ConvertToV8(isolate, change.cause),
+        gin::ConvertToV8(isolate,
+                         change.cause != net::CookieChangeCause::INSERTED)};
+    values.push_back(templ->NewInstance(isolate, properties));
+  }
+  Emit("changes", v8::Local<v8::Value>(
+                      v8::Array::New(isolate, values.data(), values.size())));
+}
+
 void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
+  if (change_batching_) {
+    // Changes that aren't interesting never reach JavaScript.
+    if (!MatchesChangeBatching(change.cookie))
+      return;
+    pending_changes_.push_back(change);
+    if (!pending_changes_timer_.IsRunning()) {
+      pending_changes_timer_.Start(FROM_HERE, change_batching_->interval,
+                                   base::BindOnce(&Cookies::EmitPendingChanges,
+                                                  base::Unretained(this)));
+    }
+    return;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   Emit("changed", gin::ConvertToV8(isolate, change.cookie),
@@ -392,9 +727,11 @@ gin::ObjectTemplateBuilder Cookies::GetObjectTemplateBuilder(
   return gin_helper::EventEmitterMixin<Cookies>::GetObjectTemplateBuilder(
              isolate)
       .SetMethod("get", &Cookies::Get)
+      .SetMethod("getPage", &Cookies::GetPage)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
-      .SetMethod("flushStore", &Cookies::FlushStore);
+      .SetMethod("flushStore", &Cookies::FlushStore)
+      .SetMethod("setChangeBatching", &Cookies::SetChangeBatching);
 }
 
 const char* Cookies::GetTypeName() {
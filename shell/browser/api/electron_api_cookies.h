@@ -5,10 +5,14 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_COOKIES_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_COOKIES_H_
 
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "base/callback_list.h"
 #include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "gin/handle.h"
 #include "net/cookies/canonical_cookie.h"
@@ -17,6 +21,10 @@
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/gin_helper/trackable_object.h"
 
+namespace gin {
+class Arguments;
+}
+
 namespace gin_helper {
 class Dictionary;
 }
@@ -49,18 +57,41 @@ class Cookies : public gin::Wrappable<Cookies>,
 
   v8::Local<v8::Promise> Get(v8::Isolate*,
                              const gin_helper::Dictionary& filter);
+  v8::Local<v8::Promise> GetPage(v8::Isolate*,
+                                 const gin_helper::Dictionary& filter,
+                                 gin::Arguments* args);
   v8::Local<v8::Promise> Set(v8::Isolate*, base::Value::Dict details);
   v8::Local<v8::Promise> Remove(v8::Isolate*,
                                 const GURL& url,
                                 const std::string& name);
   v8::Local<v8::Promise> FlushStore(v8::Isolate*);
+  void SetChangeBatching(gin::Arguments* args);
 
   // CookieChangeNotifier subscription:
   void OnCookieChanged(const net::CookieChangeInfo& change);
 
  private:
+  // See cookies.setChangeBatching().
+  struct ChangeBatching {
+    ChangeBatching();
+    ChangeBatching(ChangeBatching&&);
+    ChangeBatching& operator=(ChangeBatching&&);
+    ~ChangeBatching();
+
+    base::TimeDelta interval;
+    std::vector<std::string> domains;
+    std::vector<std::string> names;
+  };
+
+  bool MatchesChangeBatching(const net::CanonicalCookie& cookie) const;
+  void EmitPendingChanges();
+
   base::CallbackListSubscription cookie_change_subscription_;
 
+  std::optional<ChangeBatching> change_batching_;
+  std::vector<net::CookieChangeInfo> pending_changes_;
+  base::OneShotTimer pending_changes_timer_;
+
   // Weak reference; ElectronBrowserContext is guaranteed to outlive us.
   raw_ptr<ElectronBrowserContext> browser_context_;
 };
@@ -4,23 +4,99 @@
 
 #include "shell/browser/api/electron_api_debugger.h"
 
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
-
-#include "base/json/json_reader.h"
-#include "base/json/json_writer.h"
+#include <vector>
+
+#include "base/json/string_escape.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/pattern.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "content/public/browser/devtools_agent_host.h"
 #include "content/public/browser/web_contents.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
 #include "shell/browser/javascript_environment.h"
-#include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
+#include "v8/include/v8-json.h"
+
+namespace gin {
+
+template <>
+struct Converter<electron::api::DebuggerEventFilter> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::api::DebuggerEventFilter* out) {
+    gin_helper::Dictionary dict;
+    if (!ConvertFromV8(isolate, val, &dict) ||
+        !dict.Get("method", &out->method))
+      return false;
+    v8::Local<v8::Value> params;
+    return !dict.Get("params", &params) || params->IsUndefined() ||
+           ConvertFromV8(isolate, params, &out->params);
+  }
+};
+
+}  // namespace gin
 
 using content::DevToolsAgentHost;
 
 namespace electron::api {
 
+namespace {
+
+// The DevTools agents serialize events as {"method":"Domain.event",...}, so
+// the method of an event can be read without parsing the whole message.
+constexpr std::string_view kEventPrefix = "{\"method\":\"";
+
+std::optional<std::string_view> GetEventMethod(std::string_view message) {
+  if (!base::StartsWith(message, kEventPrefix))
+    return std::nullopt;
+  message.remove_prefix(kEventPrefix.size());
+  size_t end = message.find_first_of("\"\\");
+  if (end == std::string_view::npos || message[end] != '"')
+    return std::nullopt;
+  return message.substr(0, end);
+}
+
+// Returns the object at |key| of |dict|, or an empty object.
+v8::Local<v8::Value> GetObject(const gin_helper::Dictionary& dict,
+                               std::string_view key) {
+  v8::Local<v8::Value> value;
+  if (!dict.Get(key, &value) || !value->IsObject())
+    return v8::Object::New(dict.isolate());
+  return value;
+}
+
+// Whether the string at the dot separated |path| of |params| matches
+// |pattern|.
+bool MatchesParam(v8::Isolate* isolate,
+                  v8::Local<v8::Value> params,
+                  std::string_view path,
+                  std::string_view pattern) {
+  v8::Local<v8::Value> value = params;
+  for (std::string_view key : base::SplitStringPiece(
+           path, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL)) {
+    if (!value->IsObject())
+      return false;
+    gin_helper::Dictionary dict(isolate, value.As<v8::Object>());
+    if (!dict.Get(key, &value))
+      return false;
+  }
+  std::string str;
+  return gin::ConvertFromV8(isolate, value, &str) &&
+         base::MatchPattern(str, pattern);
+}
+
+}  // namespace
+
 gin::WrapperInfo Debugger::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 Debugger::Debugger(v8::Isolate* isolate, content::WebContents* web_contents)
@@ -39,40 +115,71 @@ void Debugger::DispatchProtocolMessage(DevToolsAgentHost* agent_host,
                                        base::span<const uint8_t> message) {
   DCHECK(agent_host == agent_host_);
 
+  std::string_view message_str(reinterpret_cast<const char*>(message.data()),
+                               message.size());
+  // Events that are filtered out by their method, and raw events that have
+  // no params to match, don't need to be parsed.
+  if (std::optional<std::string_view> method = GetEventMethod(message_str)) {
+    if (!IsEventMethodEnabled(*method))
+      return;
+    if (raw_messages_ && !HasParamsFilter(*method)) {
+      Emit("raw-message", message_str);
+      return;
+    }
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-
-  base::StringPiece message_str(reinterpret_cast<const char*>(message.data()),
-                                message.size());
-  std::optional<base::Value> parsed_message = base::JSONReader::Read(
-      message_str, base::JSON_REPLACE_INVALID_CHARACTERS);
-  if (!parsed_message || !parsed_message->is_dict())
+  v8::Local<v8::Object> wrapper;
+  if (!GetWrapper(isolate).ToLocal(&wrapper))
     return;
-  base::Value::Dict& dict = parsed_message->GetDict();
-  std::optional<int> id = dict.FindInt("id");
-  if (!id) {
-    std::string* method = dict.FindString("method");
-    if (!method)
+  v8::Local<v8::Context> context = wrapper->GetCreationContextChecked();
+  v8::Context::Scope context_scope(context);
+
+  // V8's parser builds the objects handed to JS directly, instead of going
+  // through base::Value.
+  v8::TryCatch try_catch(isolate);
+  v8::Local<v8::String> json;
+  v8::Local<v8::Value> parsed;
+  if (!v8::String::NewFromUtf8(isolate, message_str.data(),
+                               v8::NewStringType::kNormal,
+                               base::checked_cast<int>(message_str.size()))
+           .ToLocal(&json) ||
+      !v8::JSON::Parse(context, json).ToLocal(&parsed) ||
+      !parsed->IsObject())
+    return;
+  gin_helper::Dictionary dict(isolate, parsed.As<v8::Object>());
+
+  int id = 0;
+  if (!dict.Get("id", &id)) {
+    std::string method;
+    if (!dict.Get("method", &method) || !IsEventMethodEnabled(method))
       return;
-    std::string* session_id = dict.FindString("sessionId");
-    base::Value::Dict* params = dict.FindDict("params");
-    Emit("message", *method, params ? std::move(*params) : base::Value::Dict(),
-         session_id ? *session_id : "");
+    v8::Local<v8::Value> params = GetObject(dict, "params");
+    if (!MatchesEventFilters(isolate, method, params))
+      return;
+    if (raw_messages_) {
+      Emit("raw-message", message_str);
+      return;
+    }
+    std::string session_id;
+    dict.Get("sessionId", &session_id);
+    Emit("message", method, params, session_id);
   } else {
-    auto it = pending_requests_.find(*id);
+    auto it = pending_requests_.find(id);
     if (it == pending_requests_.end())
       return;
 
-    gin_helper::Promise<base::Value::Dict> promise = std::move(it->second);
+    gin_helper::Promise<v8::Local<v8::Value>> promise = std::move(it->second);
     pending_requests_.erase(it);
 
-    base::Value::Dict* error = dict.FindDict("error");
-    if (error) {
-      std::string* error_message = error->FindString("message");
-      promise.RejectWithErrorMessage(error_message ? *error_message : "");
+    gin_helper::Dictionary error;
+    if (dict.Get("error", &error)) {
+      std::string error_message;
+      error.Get("message", &error_message);
+      promise.RejectWithErrorMessage(error_message);
     } else {
-      base::Value::Dict* result = dict.FindDict("result");
-      promise.Resolve(result ? std::move(*result) : base::Value::Dict());
+      promise.Resolve(GetObject(dict, "result"));
     }
   }
 }
@@ -121,9 +228,69 @@ void Debugger::Detach() {
   AgentHostClosed(agent_host_.get());
 }
 
+void Debugger::SetEventDomains(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  std::vector<std::string> domains;
+  if (args->GetNext(&value) && value->IsNull()) {
+    event_domains_.reset();
+  } else if (!value.IsEmpty() &&
+             gin::ConvertFromV8(args->isolate(), value, &domains)) {
+    event_domains_.emplace(std::move(domains));
+  } else {
+    args->ThrowTypeError("domains must be null or an array of strings");
+  }
+}
+
+void Debugger::SetRawMessages(bool raw_messages) {
+  raw_messages_ = raw_messages;
+}
+
+void Debugger::SetEventFilters(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  std::vector<DebuggerEventFilter> filters;
+  if (args->GetNext(&value) && value->IsNull()) {
+    event_filters_.reset();
+  } else if (!value.IsEmpty() &&
+             gin::ConvertFromV8(args->isolate(), value, &filters)) {
+    event_filters_.emplace(std::move(filters));
+  } else {
+    args->ThrowTypeError("filters must be null or an array of event filters");
+  }
+}
+
+bool Debugger::IsEventMethodEnabled(std::string_view method) const {
+  if (event_domains_ &&
+      !event_domains_->contains(method.substr(0, method.find('.'))))
+    return false;
+  return !event_filters_ ||
+         base::ranges::any_of(*event_filters_, [method](const auto& filter) {
+           return filter.method == method;
+         });
+}
+
+bool Debugger::HasParamsFilter(std::string_view method) const {
+  return event_filters_ &&
+         base::ranges::any_of(*event_filters_, [method](const auto& filter) {
+           return filter.method == method && !filter.params.empty();
+         });
+}
+
+bool Debugger::MatchesEventFilters(v8::Isolate* isolate,
+                                   std::string_view method,
+                                   v8::Local<v8::Value> params) const {
+  if (!event_filters_)
+    return true;
+  return base::ranges::any_of(*event_filters_, [&](const auto& filter) {
+    return filter.method == method &&
+           base::ranges::all_of(filter.params, [&](const auto& param) {
+             return MatchesParam(isolate, params, param.first, param.second);
+           });
+  });
+}
+
 v8::Local<v8::Promise> Debugger::SendCommand(gin::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
-  gin_helper::Promise<base::Value::Dict> promise(isolate);
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
   if (!agent_host_) {
@@ -137,8 +304,16 @@ v8::Local<v8::Promise> Debugger::SendCommand(gin::Arguments* args) {
     return handle;
   }
 
-  base::Value::Dict command_params;
-  args->GetNext(&command_params);
+  // The parameters are serialized by V8, instead of being converted to
+  // base::Value first.
+  std::string command_params;
+  v8::Local<v8::Value> params;
+  v8::Local<v8::String> params_json;
+  if (args->GetNext(&params) && params->IsObject() &&
+      v8::JSON::Stringify(isolate->GetCurrentContext(), params)
+          .ToLocal(&params_json)) {
+    command_params = gin::V8ToString(isolate, params_json);
+  }
 
   std::string session_id;
   if (args->GetNext(&session_id) && session_id.empty()) {
@@ -146,22 +321,23 @@ v8::Local<v8::Promise> Debugger::SendCommand(gin::Arguments* args) {
     return handle;
   }
 
-  base::Value::Dict request;
   int request_id = ++previous_request_id_;
   pending_requests_.emplace(request_id, std::move(promise));
-  request.Set("id", request_id);
-  request.Set("method", method);
-  if (!command_params.empty()) {
-    request.Set("params", std::move(command_params));
+  std::string request =
+      base::StringPrintf("{\"id\":%d,\"method\":", request_id);
+  base::EscapeJSONString(method, true, &request);
+  if (!command_params.empty() && command_params != "{}") {
+    request += ",\"params\":";
+    request += command_params;
   }
-
   if (!session_id.empty()) {
-    request.Set("sessionId", session_id);
+    request += ",\"sessionId\":";
+    base::EscapeJSONString(session_id, true, &request);
   }
+  request += '}';
 
-  const auto json_args = base::WriteJson(request).value_or("");
   agent_host_->DispatchProtocolMessage(
-      this, base::as_bytes(base::make_span(json_args)));
+      this, base::as_bytes(base::make_span(request)));
 
   return handle;
 }
@@ -185,7 +361,10 @@ gin::ObjectTemplateBuilder Debugger::GetObjectTemplateBuilder(
       .SetMethod("attach", &Debugger::Attach)
       .SetMethod("isAttached", &Debugger::IsAttached)
       .SetMethod("detach", &Debugger::Detach)
-      .SetMethod("sendCommand", &Debugger::SendCommand);
+      .SetMethod("sendCommand", &Debugger::SendCommand)
+      .SetMethod("setEventDomains", &Debugger::SetEventDomains)
+      .SetMethod("setEventFilters", &Debugger::SetEventFilters)
+      .SetMethod("setRawMessages", &Debugger::SetRawMessages);
 }
 
 const char* Debugger::GetTypeName() {
@@ -5,11 +5,16 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DEBUGGER_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DEBUGGER_H_
 
+#include <functional>
 #include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
-#include "base/values.h"
 #include "content/public/browser/devtools_agent_host_client.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "gin/arguments.h"
@@ -25,6 +30,13 @@ class WebContents;
 
 namespace electron::api {
 
+// An event of |method| whose string params at the dot separated paths of
+// |params| match their patterns.
+struct DebuggerEventFilter {
+  std::string method;
+  std::map<std::string, std::string> params;
+};
+
 class Debugger : public gin::Wrappable<Debugger>,
                  public gin_helper::EventEmitterMixin<Debugger>,
                  public content::DevToolsAgentHostClient,
@@ -58,12 +70,22 @@ class Debugger : public gin::Wrappable<Debugger>,
 
  private:
   using PendingRequestMap =
-      std::map<int, gin_helper::Promise<base::Value::Dict>>;
+      std::map<int, gin_helper::Promise<v8::Local<v8::Value>>>;
 
   void Attach(gin::Arguments* args);
   bool IsAttached();
   void Detach();
   v8::Local<v8::Promise> SendCommand(gin::Arguments* args);
+  void SetEventDomains(gin::Arguments* args);
+  void SetEventFilters(gin::Arguments* args);
+  void SetRawMessages(bool raw_messages);
+  // Whether the events of |method| can be emitted, before looking at their
+  // params.
+  bool IsEventMethodEnabled(std::string_view method) const;
+  bool HasParamsFilter(std::string_view method) const;
+  bool MatchesEventFilters(v8::Isolate* isolate,
+                           std::string_view method,
+                           v8::Local<v8::Value> params) const;
   void ClearPendingRequests();
 
   raw_ptr<content::WebContents> web_contents_;  // Weak Reference.
@@ -71,6 +93,14 @@ class Debugger : public gin::Wrappable<Debugger>,
 
   PendingRequestMap pending_requests_;
   int previous_request_id_ = 0;
+
+  // The domains of the events that are emitted, all of them when unset.
+  std::optional<base::flat_set<std::string, std::less<>>> event_domains_;
+  // Set by debugger.setEventFilters(), an event is only emitted when it
+  // matches one of them.
+  std::optional<std::vector<DebuggerEventFilter>> event_filters_;
+  // Whether events are emitted as unparsed JSON.
+  bool raw_messages_ = false;
 };
 
 }  // namespace electron::api
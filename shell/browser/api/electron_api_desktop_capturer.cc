@@ -4,11 +4,13 @@
 
 #include "shell/browser/api/electron_api_desktop_capturer.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/hash/hash.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
@@ -139,6 +141,18 @@ base::flat_map<int32_t, uint32_t> MonitorAtomIdToDisplayId() {
 
 namespace {
 
+// Identifies a thumbnail, so that unchanged thumbnails are not sent again.
+uint32_t HashThumbnail(const gfx::ImageSkia& thumbnail) {
+  if (thumbnail.isNull())
+    return 0;
+  const SkBitmap* bitmap = thumbnail.bitmap();
+  if (!bitmap->getPixels())
+    return 0;
+  return base::FastHash(
+      base::make_span(static_cast<const uint8_t*>(bitmap->getPixels()),
+                      bitmap->computeByteSize()));
+}
+
 std::unique_ptr<ThumbnailCapturer> MakeWindowCapturer() {
 #if BUILDFLAG(IS_MAC)
   if (ShouldUseThumbnailCapturerMac(DesktopMediaList::Type::kWindow)) {
@@ -269,6 +283,7 @@ void DesktopCapturer::StartHandling(bool capture_window,
                                            std::move(desktop_capturer))
                                      : nullptr;
     if (capturer && capturer->GetDelegatedSourceListController()) {
+      source_list_delegated_ = true;
       capture_screen_ = false;
       capture_window_ = capture_window;
       window_capturer_ = std::make_unique<NativeDesktopMediaList>(
@@ -314,6 +329,7 @@ void DesktopCapturer::StartHandling(bool capture_window,
             window_capturer_.get());
 
         if (window_capturer_->IsSourceListDelegated()) {
+          source_list_delegated_ = true;
           OnceCallback failure_callback = base::BindOnce(
               &DesktopCapturer::HandleFailure, weak_ptr_factory_.GetWeakPtr());
           window_listener_ = std::make_unique<DesktopListListener>(
@@ -344,6 +360,7 @@ void DesktopCapturer::StartHandling(bool capture_window,
             screen_capturer_.get());
 
         if (screen_capturer_->IsSourceListDelegated()) {
+          source_list_delegated_ = true;
           OnceCallback failure_callback = base::BindOnce(
               &DesktopCapturer::HandleFailure, weak_ptr_factory_.GetWeakPtr());
           screen_listener_ = std::make_unique<DesktopListListener>(
@@ -433,16 +450,115 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   if (!capture_window_ && !capture_screen_) {
     v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
     v8::HandleScope scope(isolate);
-    gin_helper::CallMethod(this, "_onfinished", captured_sources_);
+    if (updating_)
+      ReportChanges();
+    else
+      gin_helper::CallMethod(this, "_onfinished", captured_sources_);
 
     screen_capturer_.reset();
     window_capturer_.reset();
 
-    Unpin();
+    if (!updating_) {
+      Unpin();
+    } else if (!source_list_delegated_) {
+      // Scheduled after the refresh finished, so that slow captures don't
+      // pile up.
+      refresh_timer_.Start(
+          FROM_HERE, update_interval_,
+          base::BindOnce(&DesktopCapturer::Refresh, base::Unretained(this)));
+    }
   }
 }
 
+void DesktopCapturer::StartUpdating(bool capture_window,
+                                    bool capture_screen,
+                                    const gfx::Size& thumbnail_size,
+                                    bool fetch_window_icons,
+                                    int interval_ms) {
+  updating_ = true;
+  update_capture_window_ = capture_window;
+  update_capture_screen_ = capture_screen;
+  update_thumbnail_size_ = thumbnail_size;
+  update_interval_ = base::Milliseconds(interval_ms);
+  fetch_window_icons_ = fetch_window_icons;
+  Refresh();
+}
+
+void DesktopCapturer::Stop() {
+  if (!updating_)
+    return;
+  updating_ = false;
+  refresh_timer_.Stop();
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  screen_capturer_.reset();
+  window_capturer_.reset();
+  screen_listener_.reset();
+  window_listener_.reset();
+  Unpin();
+}
+
+void DesktopCapturer::Refresh() {
+  StartHandling(update_capture_window_, update_capture_screen_,
+                update_thumbnail_size_, fetch_window_icons_);
+}
+
+void DesktopCapturer::ReportChanges() {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  base::flat_map<std::string, const CachedSource*> cached;
+  for (const auto& source : cached_sources_)
+    cached[source.id] = &source;
+
+  std::vector<CachedSource> sources;
+  std::vector<std::string> order;
+  std::vector<DesktopCapturer::Source> added;
+  std::vector<v8::Local<v8::Value>> changed;
+  for (const auto& source : captured_sources_) {
+    const DesktopMediaList::Source& media_source = source.media_list_source;
+    CachedSource current{media_source.id.ToString(), media_source.name,
+                         HashThumbnail(media_source.thumbnail)};
+    order.push_back(current.id);
+
+    auto iter = cached.find(current.id);
+    if (iter == cached.end()) {
+      added.push_back(source);
+    } else {
+      const bool name_changed = iter->second->name != current.name;
+      const bool thumbnail_changed =
+          iter->second->thumbnail_hash != current.thumbnail_hash;
+      if (name_changed || thumbnail_changed) {
+        auto change = gin_helper::Dictionary::CreateEmpty(isolate);
+        change.Set("id", current.id);
+        if (name_changed)
+          change.Set("name", current.name);
+        if (thumbnail_changed) {
+          change.Set("thumbnail",
+                     NativeImage::Create(isolate,
+                                         gfx::Image(media_source.thumbnail)));
+        }
+        changed.push_back(change.GetHandle());
+      }
+      cached.erase(iter);
+    }
+    sources.push_back(std::move(current));
+  }
+
+  std::vector<std::string> removed;
+  for (const auto& [id, source] : cached)
+    removed.push_back(id);
+
+  const bool reordered = !std::equal(
+      cached_sources_.begin(), cached_sources_.end(), sources.begin(),
+      sources.end(),
+      [](const auto& a, const auto& b) { return a.id == b.id; });
+  cached_sources_ = std::move(sources);
+  if (reordered || !changed.empty())
+    gin_helper::CallMethod(this, "_onupdated", added, removed, changed, order);
+}
+
 void DesktopCapturer::HandleFailure() {
+  updating_ = false;
+  refresh_timer_.Stop();
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   gin_helper::CallMethod(this, "_onerror", "Failed to get sources.");
@@ -466,7 +582,9 @@ gin::Handle<DesktopCapturer> DesktopCapturer::Create(v8::Isolate* isolate) {
 gin::ObjectTemplateBuilder DesktopCapturer::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<DesktopCapturer>::GetObjectTemplateBuilder(isolate)
-      .SetMethod("startHandling", &DesktopCapturer::StartHandling);
+      .SetMethod("startHandling", &DesktopCapturer::StartHandling)
+      .SetMethod("startUpdating", &DesktopCapturer::StartUpdating)
+      .SetMethod("stop", &DesktopCapturer::Stop);
 }
 
 const char* DesktopCapturer::GetTypeName() {
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "chrome/browser/media/webrtc/desktop_media_list_observer.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
@@ -37,6 +38,15 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
                      const gfx::Size& thumbnail_size,
                      bool fetch_window_icons);
 
+  // Refreshes the sources every |interval_ms| until Stop() is called and
+  // reports how they changed since the previous refresh.
+  void StartUpdating(bool capture_window,
+                     bool capture_screen,
+                     const gfx::Size& thumbnail_size,
+                     bool fetch_window_icons,
+                     int interval_ms);
+  void Stop();
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -88,8 +98,17 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
     bool have_thumbnail_ = false;
   };
 
+  // What is known about a source from the previous refresh.
+  struct CachedSource {
+    std::string id;
+    std::u16string name;
+    uint32_t thumbnail_hash = 0;
+  };
+
   void UpdateSourcesList(DesktopMediaList* list);
   void HandleFailure();
+  void Refresh();
+  void ReportChanges();
 
   std::unique_ptr<DesktopListListener> window_listener_;
   std::unique_ptr<DesktopListListener> screen_listener_;
@@ -99,6 +118,18 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
+  // Whether the sources are picked by the user through the system, e.g. with
+  // PipeWire, in which case they are not refreshed.
+  bool source_list_delegated_ = false;
+
+  // Set by StartUpdating().
+  bool updating_ = false;
+  bool update_capture_window_ = false;
+  bool update_capture_screen_ = false;
+  gfx::Size update_thumbnail_size_;
+  base::TimeDelta update_interval_;
+  base::OneShotTimer refresh_timer_;
+  std::vector<CachedSource> cached_sources_;
 #if BUILDFLAG(IS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // BUILDFLAG(IS_WIN)
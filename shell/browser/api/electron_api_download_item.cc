@@ -45,6 +45,45 @@ struct Converter<download::DownloadItem::DownloadState> {
   }
 };
 
+template <>
+struct Converter<electron::api::DownloadItem::Priority> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      electron::api::DownloadItem::Priority priority) {
+    using Priority = electron::api::DownloadItem::Priority;
+    std::string download_priority;
+    switch (priority) {
+      case Priority::kLow:
+        download_priority = "low";
+        break;
+      case Priority::kNormal:
+        download_priority = "normal";
+        break;
+      case Priority::kHigh:
+        download_priority = "high";
+        break;
+    }
+    return ConvertToV8(isolate, download_priority);
+  }
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::api::DownloadItem::Priority* out) {
+    using Priority = electron::api::DownloadItem::Priority;
+    std::string priority;
+    if (!ConvertFromV8(isolate, val, &priority))
+      return false;
+    if (priority == "low")
+      *out = Priority::kLow;
+    else if (priority == "normal")
+      *out = Priority::kNormal;
+    else if (priority == "high")
+      *out = Priority::kHigh;
+    else
+      return false;
+    return true;
+  }
+};
+
 }  // namespace gin
 
 namespace electron::api {
@@ -84,6 +123,7 @@ DownloadItem::DownloadItem(v8::Isolate* isolate, download::DownloadItem* item)
   download_item_->SetUserData(
       kElectronApiDownloadItemKey,
       std::make_unique<UserDataLink>(weak_factory_.GetWeakPtr()));
+  power_policy_observation_.Observe(PowerPolicy::GetInstance());
 }
 
 DownloadItem::~DownloadItem() {
@@ -119,9 +159,31 @@ void DownloadItem::OnDownloadDestroyed(download::DownloadItem* /*item*/) {
   Unpin();
 }
 
+void DownloadItem::OnPowerPolicyChanged() {
+  ApplyPowerPolicy();
+}
+
+void DownloadItem::ApplyPowerPolicy() {
+  if (!download_item_ || download_item_->IsDone())
+    return;
+  const bool pause =
+      priority_ == Priority::kLow &&
+      PowerPolicy::GetInstance()->actions().pause_low_priority_downloads;
+  if (pause && !download_item_->IsPaused() &&
+      download_item_->GetState() == download::DownloadItem::IN_PROGRESS) {
+    paused_by_power_policy_ = true;
+    download_item_->Pause();
+  } else if (!pause && paused_by_power_policy_) {
+    paused_by_power_policy_ = false;
+    if (download_item_->CanResume())
+      download_item_->Resume(false /* user_gesture */);
+  }
+}
+
 void DownloadItem::Pause() {
   if (!CheckAlive())
     return;
+  paused_by_power_policy_ = false;
   download_item_->Pause();
 }
 
@@ -134,6 +196,8 @@ bool DownloadItem::IsPaused() const {
 void DownloadItem::Resume() {
   if (!CheckAlive())
     return;
+  // The app takes the download over from the power policy.
+  paused_by_power_policy_ = false;
   download_item_->Resume(true /* user_gesture */);
 }
 
@@ -161,6 +225,36 @@ int64_t DownloadItem::GetTotalBytes() const {
   return download_item_->GetTotalBytes();
 }
 
+int64_t DownloadItem::GetCurrentBytesPerSecond() const {
+  if (!CheckAlive())
+    return 0;
+  return download_item_->CurrentSpeed();
+}
+
+int DownloadItem::GetPercentComplete() const {
+  if (!CheckAlive())
+    return -1;
+  return download_item_->PercentComplete();
+}
+
+v8::Local<v8::Value> DownloadItem::GetReceivedSlices() const {
+  v8::Local<v8::Array> result = v8::Array::New(isolate_);
+  if (!CheckAlive())
+    return result;
+  // Parallel downloads receive one slice per connection, a download that
+  // isn't split has at most one slice.
+  v8::Local<v8::Context> context = isolate_->GetCurrentContext();
+  uint32_t index = 0;
+  for (const auto& slice : download_item_->GetReceivedSlices()) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate_);
+    dict.Set("offset", slice.offset);
+    dict.Set("receivedBytes", slice.received_bytes);
+    dict.Set("finished", slice.finished);
+    result->Set(context, index++, dict.GetHandle()).Check();
+  }
+  return result;
+}
+
 std::string DownloadItem::GetMimeType() const {
   if (!CheckAlive())
     return "";
@@ -248,6 +342,18 @@ double DownloadItem::GetStartTime() const {
   return download_item_->GetStartTime().InSecondsFSinceUnixEpoch();
 }
 
+double DownloadItem::GetEndTime() const {
+  if (!CheckAlive())
+    return 0;
+  const base::Time end_time = download_item_->GetEndTime();
+  return end_time.is_null() ? 0 : end_time.InSecondsFSinceUnixEpoch();
+}
+
+void DownloadItem::SetPriority(Priority priority) {
+  priority_ = priority;
+  ApplyPowerPolicy();
+}
+
 // static
 gin::ObjectTemplateBuilder DownloadItem::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
@@ -260,6 +366,10 @@ gin::ObjectTemplateBuilder DownloadItem::GetObjectTemplateBuilder(
       .SetMethod("cancel", &DownloadItem::Cancel)
       .SetMethod("getReceivedBytes", &DownloadItem::GetReceivedBytes)
       .SetMethod("getTotalBytes", &DownloadItem::GetTotalBytes)
+      .SetMethod("getCurrentBytesPerSecond",
+                 &DownloadItem::GetCurrentBytesPerSecond)
+      .SetMethod("getPercentComplete", &DownloadItem::GetPercentComplete)
+      .SetMethod("getReceivedSlices", &DownloadItem::GetReceivedSlices)
       .SetMethod("getMimeType", &DownloadItem::GetMimeType)
       .SetMethod("hasUserGesture", &DownloadItem::HasUserGesture)
       .SetMethod("getFilename", &DownloadItem::GetFilename)
@@ -276,7 +386,10 @@ gin::ObjectTemplateBuilder DownloadItem::GetObjectTemplateBuilder(
       .SetMethod("getSaveDialogOptions", &DownloadItem::GetSaveDialogOptions)
       .SetMethod("getLastModifiedTime", &DownloadItem::GetLastModifiedTime)
       .SetMethod("getETag", &DownloadItem::GetETag)
-      .SetMethod("getStartTime", &DownloadItem::GetStartTime);
+      .SetMethod("getStartTime", &DownloadItem::GetStartTime)
+      .SetMethod("getEndTime", &DownloadItem::GetEndTime)
+      .SetProperty("priority", &DownloadItem::GetPriority,
+                   &DownloadItem::SetPriority);
 }
 
 const char* DownloadItem::GetTypeName() {
@@ -10,10 +10,12 @@
 #include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
 #include "components/download/public/common/download_item.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/power_policy.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/common/gin_helper/pinnable.h"
 
@@ -24,7 +26,8 @@ namespace electron::api {
 class DownloadItem : public gin::Wrappable<DownloadItem>,
                      public gin_helper::Pinnable<DownloadItem>,
                      public gin_helper::EventEmitterMixin<DownloadItem>,
-                     public download::DownloadItem::Observer {
+                     public download::DownloadItem::Observer,
+                     public PowerPolicy::Observer {
  public:
   static gin::Handle<DownloadItem> FromOrCreate(v8::Isolate* isolate,
                                                 download::DownloadItem* item);
@@ -37,6 +40,9 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
       v8::Isolate* isolate) override;
   const char* GetTypeName() override;
 
+  // Priority of the download for the download scheduler of its session.
+  enum class Priority { kLow, kNormal, kHigh };
+
   // JS API, but also C++ calls it sometimes
   void SetSavePath(const base::FilePath& path);
   base::FilePath GetSavePath() const;
@@ -56,6 +62,13 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
   void OnDownloadUpdated(download::DownloadItem* item) override;
   void OnDownloadDestroyed(download::DownloadItem* item) override;
 
+  // PowerPolicy::Observer
+  void OnPowerPolicyChanged() override;
+
+  // Pauses a low priority download while the power policy asks for it, and
+  // resumes it once the policy no longer does.
+  void ApplyPowerPolicy();
+
   // JS API
   void Pause();
   bool IsPaused() const;
@@ -64,6 +77,9 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
   void Cancel();
   int64_t GetReceivedBytes() const;
   int64_t GetTotalBytes() const;
+  int64_t GetCurrentBytesPerSecond() const;
+  int GetPercentComplete() const;
+  v8::Local<v8::Value> GetReceivedSlices() const;
   std::string GetMimeType() const;
   bool HasUserGesture() const;
   std::string GetFilename() const;
@@ -76,13 +92,23 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
   std::string GetLastModifiedTime() const;
   std::string GetETag() const;
   double GetStartTime() const;
+  double GetEndTime() const;
+  Priority GetPriority() const { return priority_; }
+  void SetPriority(Priority priority);
 
   base::FilePath save_path_;
   file_dialog::DialogSettings dialog_options_;
+  Priority priority_ = Priority::kNormal;
+  // Whether the download was paused by the power policy rather than by the
+  // app, only such a download is resumed by the policy.
+  bool paused_by_power_policy_ = false;
   raw_ptr<download::DownloadItem> download_item_;
 
   raw_ptr<v8::Isolate> isolate_;
 
+  base::ScopedObservation<PowerPolicy, PowerPolicy::Observer>
+      power_policy_observation_{this};
+
   base::WeakPtrFactory<DownloadItem> weak_factory_{this};
 };
 
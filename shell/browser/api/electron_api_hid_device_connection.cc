@@ -0,0 +1,210 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_hid_device_connection.h"
+
+#include <optional>
+
+#include "base/functional/bind.h"
+#include "base/trace_event/trace_event.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
+
+#include "shell/common/node_includes.h"
+
+namespace electron::api {
+
+namespace {
+
+bool GetBytes(v8::Local<v8::Value> data, std::vector<uint8_t>* bytes) {
+  if (!node::Buffer::HasInstance(data))
+    return false;
+  const auto* begin =
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(data));
+  bytes->assign(begin, begin + node::Buffer::Length(data));
+  return true;
+}
+
+void OnReportSent(gin_helper::Promise<void> promise, bool success) {
+  if (success)
+    promise.Resolve();
+  else
+    promise.RejectWithErrorMessage("Failed to send the report");
+}
+
+v8::Local<v8::Value> ToBuffer(v8::Isolate* isolate,
+                              const std::vector<uint8_t>& bytes) {
+  return node::Buffer::Copy(isolate,
+                            reinterpret_cast<const char*>(bytes.data()),
+                            bytes.size())
+      .ToLocalChecked();
+}
+
+}  // namespace
+
+gin::WrapperInfo HidDeviceConnection::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+HidDeviceConnection::HidDeviceConnection(
+    mojo::PendingRemote<device::mojom::HidConnection> connection,
+    mojo::PendingReceiver<device::mojom::HidConnectionClient> client,
+    const BatchOptions& options)
+    : options_(options),
+      connection_(std::move(connection)),
+      client_receiver_(this, std::move(client)) {
+  connection_.set_disconnect_handler(base::BindOnce(
+      &HidDeviceConnection::OnClosed, weak_factory_.GetWeakPtr()));
+}
+
+HidDeviceConnection::~HidDeviceConnection() = default;
+
+void HidDeviceConnection::OnInputReport(uint8_t report_id,
+                                        const std::vector<uint8_t>& buffer) {
+  pending_reports_.emplace_back(report_id, buffer);
+  if (pending_reports_.size() >= options_.max_size)
+    EmitReports();
+  else if (!batch_timer_.IsRunning())
+    batch_timer_.Start(FROM_HERE, options_.interval,
+                       base::BindOnce(&HidDeviceConnection::EmitReports,
+                                      weak_factory_.GetWeakPtr()));
+}
+
+void HidDeviceConnection::EmitReports() {
+  batch_timer_.Stop();
+  if (pending_reports_.empty())
+    return;
+  TRACE_EVENT1("electron", "HidDeviceConnection::EmitReports", "reports",
+               pending_reports_.size());
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Array> reports =
+      v8::Array::New(isolate, static_cast<int>(pending_reports_.size()));
+  for (size_t i = 0; i < pending_reports_.size(); ++i) {
+    auto report = gin_helper::Dictionary::CreateEmpty(isolate);
+    report.Set("reportId", pending_reports_[i].first);
+    report.Set("data", ToBuffer(isolate, pending_reports_[i].second));
+    reports->Set(context, static_cast<uint32_t>(i), report.GetHandle())
+        .Check();
+  }
+  pending_reports_.clear();
+  EmitWithoutEvent("input-reports", reports.As<v8::Value>());
+}
+
+v8::Local<v8::Promise> HidDeviceConnection::SendReport(
+    v8::Isolate* isolate,
+    uint8_t report_id,
+    v8::Local<v8::Value> data) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  std::vector<uint8_t> bytes;
+  if (!GetBytes(data, &bytes)) {
+    promise.RejectWithErrorMessage("data must be a Buffer");
+  } else if (!connection_) {
+    promise.RejectWithErrorMessage("The device is closed");
+  } else {
+    connection_->Write(report_id, bytes,
+                       base::BindOnce(&OnReportSent, std::move(promise)));
+  }
+  return handle;
+}
+
+v8::Local<v8::Promise> HidDeviceConnection::SendFeatureReport(
+    v8::Isolate* isolate,
+    uint8_t report_id,
+    v8::Local<v8::Value> data) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  std::vector<uint8_t> bytes;
+  if (!GetBytes(data, &bytes)) {
+    promise.RejectWithErrorMessage("data must be a Buffer");
+  } else if (!connection_) {
+    promise.RejectWithErrorMessage("The device is closed");
+  } else {
+    connection_->SendFeatureReport(
+        report_id, bytes, base::BindOnce(&OnReportSent, std::move(promise)));
+  }
+  return handle;
+}
+
+v8::Local<v8::Promise> HidDeviceConnection::ReceiveFeatureReport(
+    v8::Isolate* isolate,
+    uint8_t report_id) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!connection_) {
+    promise.RejectWithErrorMessage("The device is closed");
+    return handle;
+  }
+  connection_->GetFeatureReport(
+      report_id,
+      base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise, bool success,
+             const std::optional<std::vector<uint8_t>>& buffer) {
+            if (!success || !buffer) {
+              promise.RejectWithErrorMessage(
+                  "Failed to receive the feature report");
+              return;
+            }
+            v8::HandleScope handle_scope(promise.isolate());
+            promise.Resolve(ToBuffer(promise.isolate(), *buffer));
+          },
+          std::move(promise)));
+  return handle;
+}
+
+void HidDeviceConnection::Close() {
+  OnClosed();
+}
+
+bool HidDeviceConnection::IsOpen() const {
+  return connection_.is_bound();
+}
+
+void HidDeviceConnection::OnClosed() {
+  if (!connection_)
+    return;
+  connection_.reset();
+  client_receiver_.reset();
+  // The reports that were received before the device closed are still
+  // delivered.
+  EmitReports();
+  EmitWithoutEvent("close");
+  Unpin();
+}
+
+// static
+gin::Handle<HidDeviceConnection> HidDeviceConnection::Create(
+    v8::Isolate* isolate,
+    mojo::PendingRemote<device::mojom::HidConnection> connection,
+    mojo::PendingReceiver<device::mojom::HidConnectionClient> client,
+    const BatchOptions& options) {
+  auto handle = gin::CreateHandle(
+      isolate, new HidDeviceConnection(std::move(connection),
+                                       std::move(client), options));
+  // Kept alive while the device is open, so that the reports keep coming
+  // without a reference from JS.
+  handle->Pin(isolate);
+  return handle;
+}
+
+gin::ObjectTemplateBuilder HidDeviceConnection::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin_helper::EventEmitterMixin<
+             HidDeviceConnection>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("sendReport", &HidDeviceConnection::SendReport)
+      .SetMethod("sendFeatureReport", &HidDeviceConnection::SendFeatureReport)
+      .SetMethod("receiveFeatureReport",
+                 &HidDeviceConnection::ReceiveFeatureReport)
+      .SetMethod("close", &HidDeviceConnection::Close)
+      .SetProperty("isOpen", &HidDeviceConnection::IsOpen);
+}
+
+const char* HidDeviceConnection::GetTypeName() {
+  return "HIDDeviceConnection";
+}
+
+}  // namespace electron::api
@@ -0,0 +1,100 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_HID_DEVICE_CONNECTION_H_
+#define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_HID_DEVICE_CONNECTION_H_
+
+#include <utility>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "services/device/public/mojom/hid.mojom.h"
+#include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/pinnable.h"
+
+namespace gin {
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron::api {
+
+// A HID device opened from the main process with session.openHidDevice(),
+// which delivers the input reports in batches instead of one event each.
+class HidDeviceConnection
+    : public gin::Wrappable<HidDeviceConnection>,
+      public gin_helper::Pinnable<HidDeviceConnection>,
+      public gin_helper::EventEmitterMixin<HidDeviceConnection>,
+      public device::mojom::HidConnectionClient {
+ public:
+  struct BatchOptions {
+    // The 'input-reports' event is emitted this long after the first report
+    // of the batch...
+    base::TimeDelta interval;
+    // ...or once this many reports were received.
+    uint32_t max_size = 1000;
+  };
+
+  static gin::Handle<HidDeviceConnection> Create(
+      v8::Isolate* isolate,
+      mojo::PendingRemote<device::mojom::HidConnection> connection,
+      mojo::PendingReceiver<device::mojom::HidConnectionClient> client,
+      const BatchOptions& options);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  HidDeviceConnection(const HidDeviceConnection&) = delete;
+  HidDeviceConnection& operator=(const HidDeviceConnection&) = delete;
+
+ private:
+  HidDeviceConnection(
+      mojo::PendingRemote<device::mojom::HidConnection> connection,
+      mojo::PendingReceiver<device::mojom::HidConnectionClient> client,
+      const BatchOptions& options);
+  ~HidDeviceConnection() override;
+
+  // device::mojom::HidConnectionClient:
+  void OnInputReport(uint8_t report_id,
+                     const std::vector<uint8_t>& buffer) override;
+
+  // JS API.
+  v8::Local<v8::Promise> SendReport(v8::Isolate* isolate,
+                                    uint8_t report_id,
+                                    v8::Local<v8::Value> data);
+  v8::Local<v8::Promise> SendFeatureReport(v8::Isolate* isolate,
+                                           uint8_t report_id,
+                                           v8::Local<v8::Value> data);
+  v8::Local<v8::Promise> ReceiveFeatureReport(v8::Isolate* isolate,
+                                              uint8_t report_id);
+  void Close();
+  bool IsOpen() const;
+
+  void EmitReports();
+  void OnClosed();
+
+  const BatchOptions options_;
+  mojo::Remote<device::mojom::HidConnection> connection_;
+  mojo::Receiver<device::mojom::HidConnectionClient> client_receiver_;
+
+  std::vector<std::pair<uint8_t, std::vector<uint8_t>>> pending_reports_;
+  base::OneShotTimer batch_timer_;
+
+  base::WeakPtrFactory<HidDeviceConnection> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_HID_DEVICE_CONNECTION_H_
@@ -83,19 +83,55 @@ bool InvokeBoolMethod(const Menu* menu,
   return gin::ConvertFromV8(isolate, val, &ret) ? ret : default_value;
 }
 
+Menu::CommandState::CommandState() = default;
+Menu::CommandState::CommandState(CommandState&&) = default;
+Menu::CommandState& Menu::CommandState::operator=(CommandState&&) = default;
+Menu::CommandState::~CommandState() = default;
+
+const Menu::CommandState* Menu::GetCommandState(int command_id) const {
+  auto it = command_states_.find(command_id);
+  return it == command_states_.end() ? nullptr : &it->second;
+}
+
+void Menu::SetCommandState(int command_id,
+                           const gin_helper::Dictionary& dict) {
+  CommandState state;
+  dict.Get("checked", &state.checked);
+  dict.Get("dynamicChecked", &state.dynamic_checked);
+  dict.Get("enabled", &state.enabled);
+  dict.Get("visible", &state.visible);
+  dict.Get("worksWhenHidden", &state.works_when_hidden);
+  dict.Get("registerAccelerator", &state.register_accelerator);
+  ui::Accelerator accelerator;
+  if (dict.Get("accelerator", &accelerator))
+    state.accelerator = accelerator;
+  if (dict.Get("defaultAccelerator", &accelerator))
+    state.default_accelerator = accelerator;
+  command_states_.insert_or_assign(command_id, std::move(state));
+}
+
 bool Menu::IsCommandIdChecked(int command_id) const {
+  const CommandState* state = GetCommandState(command_id);
+  if (state && !state->dynamic_checked)
+    return state->checked;
   return InvokeBoolMethod(this, "_isCommandIdChecked", command_id);
 }
 
 bool Menu::IsCommandIdEnabled(int command_id) const {
+  if (const CommandState* state = GetCommandState(command_id))
+    return state->enabled;
   return InvokeBoolMethod(this, "_isCommandIdEnabled", command_id);
 }
 
 bool Menu::IsCommandIdVisible(int command_id) const {
+  if (const CommandState* state = GetCommandState(command_id))
+    return state->visible;
   return InvokeBoolMethod(this, "_isCommandIdVisible", command_id);
 }
 
 bool Menu::ShouldCommandIdWorkWhenHidden(int command_id) const {
+  if (const CommandState* state = GetCommandState(command_id))
+    return state->works_when_hidden;
   return InvokeBoolMethod(this, "_shouldCommandIdWorkWhenHidden", command_id);
 }
 
@@ -103,6 +139,18 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
     int command_id,
     bool use_default_accelerator,
     ui::Accelerator* accelerator) const {
+  if (const CommandState* state = GetCommandState(command_id)) {
+    if (state->accelerator) {
+      *accelerator = *state->accelerator;
+      return true;
+    }
+    if (use_default_accelerator && state->default_accelerator) {
+      *accelerator = *state->default_accelerator;
+      return true;
+    }
+    return false;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   v8::Local<v8::Value> val = gin_helper::CallMethod(
@@ -112,6 +160,8 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
 }
 
 bool Menu::ShouldRegisterAcceleratorForCommandId(int command_id) const {
+  if (const CommandState* state = GetCommandState(command_id))
+    return state->register_accelerator;
   return InvokeBoolMethod(this, "_shouldRegisterAcceleratorForCommandId",
                           command_id);
 }
@@ -137,6 +187,8 @@ void Menu::ExecuteCommand(int command_id, int flags) {
 }
 
 void Menu::OnMenuWillShow(ui::SimpleMenuModel* source) {
+  if (!has_radio_items_)
+    return;
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   gin_helper::CallMethod(isolate, const_cast<Menu*>(this), "_menuWillShow");
@@ -179,6 +231,7 @@ void Menu::InsertRadioItemAt(int index,
                              int command_id,
                              const std::u16string& label,
                              int group_id) {
+  has_radio_items_ = true;
   model_->InsertRadioItemAt(index, command_id, label, group_id);
 }
 
@@ -207,6 +260,8 @@ void Menu::SetRole(int index, const std::u16string& role) {
 }
 
 void Menu::Clear() {
+  command_states_.clear();
+  has_radio_items_ = false;
   model_->Clear();
 }
 
@@ -279,6 +334,7 @@ void Menu::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("setSublabel", &Menu::SetSublabel)
       .SetMethod("setToolTip", &Menu::SetToolTip)
       .SetMethod("setRole", &Menu::SetRole)
+      .SetMethod("_setCommandState", &Menu::SetCommandState)
       .SetMethod("clear", &Menu::Clear)
       .SetMethod("getIndexOfCommandId", &Menu::GetIndexOfCommandId)
       .SetMethod("getItemCount", &Menu::GetItemCount)
@@ -6,8 +6,10 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_MENU_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "base/containers/flat_map.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "gin/arguments.h"
@@ -16,6 +18,7 @@
 #include "shell/browser/ui/electron_menu_model.h"
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/pinnable.h"
+#include "ui/base/accelerators/accelerator.h"
 
 namespace electron::api {
 
@@ -93,6 +96,28 @@ class Menu : public gin::Wrappable<Menu>,
   void OnMenuWillShow() override;
 
  private:
+  // The state of an item, pushed by JS whenever it changes so that showing
+  // the menu doesn't call into JS for every item.
+  struct CommandState {
+    CommandState();
+    CommandState(CommandState&&);
+    CommandState& operator=(CommandState&&);
+    ~CommandState();
+
+    bool checked = false;
+    // Set for the roles whose checked state is read when the menu is shown.
+    bool dynamic_checked = false;
+    bool enabled = false;
+    bool visible = false;
+    bool works_when_hidden = false;
+    bool register_accelerator = false;
+    std::optional<ui::Accelerator> accelerator;
+    std::optional<ui::Accelerator> default_accelerator;
+  };
+
+  const CommandState* GetCommandState(int command_id) const;
+  void SetCommandState(int command_id, const gin_helper::Dictionary& state);
+
   void InsertItemAt(int index, int command_id, const std::u16string& label);
   void InsertSeparatorAt(int index);
   void InsertCheckItemAt(int index,
@@ -121,6 +146,11 @@ class Menu : public gin::Wrappable<Menu>,
   bool IsEnabledAt(int index) const;
   bool IsVisibleAt(int index) const;
   bool WorksWhenHiddenAt(int index) const;
+
+  base::flat_map<int, CommandState> command_states_;
+
+  // Radio groups are fixed up by JS before the menu is shown.
+  bool has_radio_items_ = false;
 };
 
 }  // namespace electron::api
@@ -6,10 +6,16 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/task/thread_pool.h"
 #include "chrome/browser/browser_process.h"
 #include "components/net_log/chrome_net_log.h"
@@ -67,6 +73,64 @@ base::File OpenFileForWriting(base::FilePath path) {
                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
 }
 
+// The recent events are those of the current segment and of the previous
+// one, so a dump holds between one and two minutes of events.
+constexpr base::TimeDelta kSegmentDuration = base::Minutes(1);
+
+constexpr uint64_t kDefaultRecordingMaxSize = 10 * 1024 * 1024;
+
+base::Value::Dict GetNetLogConstants() {
+  auto command_line_string =
+      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
+  auto channel_string = std::string("Electron " ELECTRON_VERSION);
+  return net_log::GetPlatformConstantsForNetLog(command_line_string,
+                                                channel_string);
+}
+
+base::FilePath CreateRecordingDir() {
+  base::FilePath dir;
+  if (!base::CreateNewTempDirectory(FILE_PATH_LITERAL("electron-net-log"),
+                                    &dir))
+    return base::FilePath();
+  return dir;
+}
+
+// Writes the events of the |segments| to |dump_path| as a single net log,
+// returning an error message on failure.
+std::string WriteMergedNetLog(std::vector<base::FilePath> segments,
+                              base::FilePath dump_path) {
+  std::optional<base::Value::Dict> merged;
+  for (const auto& segment : segments) {
+    std::string contents;
+    if (!base::ReadFileToString(segment, &contents))
+      continue;
+    // A segment that was stopped before it started is empty.
+    std::optional<base::Value::Dict> log = base::JSONReader::ReadDict(contents);
+    if (!log)
+      continue;
+    if (!merged) {
+      merged = std::move(log);
+      continue;
+    }
+    base::Value::List* merged_events = merged->EnsureList("events");
+    if (base::Value::List* events = log->FindList("events")) {
+      for (auto& event : *events)
+        merged_events->Append(std::move(event));
+    }
+    if (base::Value* polled_data = log->Find("polledData"))
+      merged->Set("polledData", std::move(*polled_data));
+  }
+  if (!merged)
+    return "No network events have been recorded";
+
+  std::string json;
+  if (!base::JSONWriter::Write(*merged, &json))
+    return "Failed to serialize the net log";
+  if (!base::WriteFile(dump_path, json))
+    return "Failed to write the net log";
+  return std::string();
+}
+
 void ResolvePromiseWithNetError(gin_helper::Promise<void> promise,
                                 int32_t error) {
   if (error == net::OK) {
@@ -87,7 +151,12 @@ NetLog::NetLog(v8::Isolate* isolate, ElectronBrowserContext* browser_context)
   file_task_runner_ = CreateFileTaskRunner();
 }
 
-NetLog::~NetLog() = default;
+NetLog::~NetLog() {
+  if (!recording_dir_.empty()) {
+    file_task_runner_->PostTask(
+        FROM_HERE, base::GetDeletePathRecursivelyCallback(recording_dir_));
+  }
+}
 
 v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
                                             gin::Arguments* args) {
@@ -128,11 +197,7 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
       std::make_optional<gin_helper::Promise<void>>(args->isolate());
   v8::Local<v8::Promise> handle = pending_start_promise_->GetHandle();
 
-  auto command_line_string =
-      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
-  auto channel_string = std::string("Electron " ELECTRON_VERSION);
-  base::Value::Dict custom_constants = net_log::GetPlatformConstantsForNetLog(
-      command_line_string, channel_string);
+  base::Value::Dict custom_constants = GetNetLogConstants();
 
   auto* network_context =
       browser_context_->GetDefaultStoragePartition()->GetNetworkContext();
@@ -215,12 +280,278 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> NetLog::StartRecording(gin::Arguments* args) {
+  net::NetLogCaptureMode capture_mode = net::NetLogCaptureMode::kDefault;
+  uint64_t max_size = kDefaultRecordingMaxSize;
+
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    v8::Local<v8::Value> capture_mode_v8;
+    if (dict.Get("captureMode", &capture_mode_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), capture_mode_v8,
+                              &capture_mode)) {
+        args->ThrowTypeError("Invalid value for captureMode");
+        return v8::Local<v8::Promise>();
+      }
+    }
+    v8::Local<v8::Value> max_size_v8;
+    if (dict.Get("maxSize", &max_size_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), max_size_v8, &max_size) ||
+          max_size == 0) {
+        args->ThrowTypeError("Invalid value for maxSize");
+        return v8::Local<v8::Promise>();
+      }
+    }
+  }
+
+  if (recording_) {
+    args->ThrowTypeError("There is already a net log recording running");
+    return v8::Local<v8::Promise>();
+  }
+
+  recording_ = true;
+  recording_capture_mode_ = capture_mode;
+  recording_max_size_ = max_size;
+  next_segment_ = 0;
+
+  pending_recording_promise_ =
+      std::make_optional<gin_helper::Promise<void>>(args->isolate());
+  v8::Local<v8::Promise> handle = pending_recording_promise_->GetHandle();
+
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&CreateRecordingDir),
+      base::BindOnce(&NetLog::OnRecordingDirCreated,
+                     weak_ptr_factory_.GetWeakPtr()));
+
+  return handle;
+}
+
+void NetLog::OnRecordingDirCreated(base::FilePath dir) {
+  if (!recording_) {
+    // The recording was stopped in the meantime.
+    if (!dir.empty()) {
+      file_task_runner_->PostTask(
+          FROM_HERE, base::GetDeletePathRecursivelyCallback(dir));
+    }
+    return;
+  }
+  if (dir.empty()) {
+    std::move(*pending_recording_promise_)
+        .RejectWithErrorMessage("Failed to create the net log directory");
+    pending_recording_promise_.reset();
+    ResetRecording(base::DoNothing());
+    return;
+  }
+
+  recording_dir_ = std::move(dir);
+  StartSegment();
+  rotate_timer_.Start(FROM_HERE, kSegmentDuration,
+                      base::BindRepeating(
+                          [](NetLog* self) { self->RotateSegment({}); },
+                          // The timer is owned by |this|.
+                          base::Unretained(this)));
+}
+
+void NetLog::StartSegment() {
+  segment_path_ = recording_dir_.AppendASCII(
+      "segment-" + base::NumberToString(next_segment_++) + ".json");
+
+  auto* network_context =
+      browser_context_->GetDefaultStoragePartition()->GetNetworkContext();
+  network_context->CreateNetLogExporter(
+      segment_exporter_.BindNewPipeAndPassReceiver());
+
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(OpenFileForWriting, segment_path_),
+      base::BindOnce(&NetLog::StartSegmentAfterCreateFile,
+                     weak_ptr_factory_.GetWeakPtr(), segment_path_));
+}
+
+void NetLog::StartSegmentAfterCreateFile(base::FilePath path,
+                                         base::File output_file) {
+  // The segment may have been stopped before its file was created.
+  if (!recording_ || path != segment_path_ || !segment_exporter_)
+    return;
+
+  if (!output_file.IsValid()) {
+    if (pending_recording_promise_) {
+      std::move(*pending_recording_promise_)
+          .RejectWithErrorMessage(
+              base::File::ErrorToString(output_file.error_details()));
+      pending_recording_promise_.reset();
+    }
+    ResetRecording(base::DoNothing());
+    return;
+  }
+
+  // Each segment gets half of the size, since two of them are kept.
+  segment_exporter_->Start(
+      std::move(output_file), GetNetLogConstants(), recording_capture_mode_,
+      recording_max_size_ / 2,
+      base::BindOnce(&NetLog::OnSegmentStarted,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void NetLog::OnSegmentStarted(int32_t error) {
+  if (!pending_recording_promise_)
+    return;
+  ResolvePromiseWithNetError(std::move(*pending_recording_promise_), error);
+  pending_recording_promise_.reset();
+  if (error != net::OK)
+    ResetRecording(base::DoNothing());
+}
+
+void NetLog::RotateSegment(DumpCallback dump) {
+  if (!segment_exporter_) {
+    if (dump)
+      std::move(dump).Run({});
+    return;
+  }
+
+  // The exporter is moved into the callback so that it lives until the
+  // segment is complete, the next segment starts right away.
+  mojo::Remote<network::mojom::NetLogExporter> exporter =
+      std::move(segment_exporter_);
+  network::mojom::NetLogExporter* exporter_ptr = exporter.get();
+  exporter_ptr->Stop(
+      base::Value::Dict(),
+      base::BindOnce(
+          [](mojo::Remote<network::mojom::NetLogExporter>,
+             base::WeakPtr<NetLog> self, base::FilePath path,
+             DumpCallback dump, int32_t error) {
+            if (self)
+              self->OnSegmentStopped(std::move(path), std::move(dump));
+          },
+          std::move(exporter), weak_ptr_factory_.GetWeakPtr(), segment_path_,
+          std::move(dump)));
+
+  if (recording_)
+    StartSegment();
+}
+
+void NetLog::OnSegmentStopped(base::FilePath path, DumpCallback dump) {
+  std::vector<base::FilePath> segments;
+  if (!previous_segment_path_.empty())
+    segments.push_back(previous_segment_path_);
+  segments.push_back(path);
+  if (dump)
+    std::move(dump).Run(std::move(segments));
+
+  if (!recording_)
+    return;
+
+  // The file task runner is sequenced, so the segment is deleted after a
+  // dump posted above has read it.
+  if (!previous_segment_path_.empty()) {
+    file_task_runner_->PostTask(
+        FROM_HERE, base::GetDeleteFileCallback(previous_segment_path_));
+  }
+  previous_segment_path_ = std::move(path);
+}
+
+void NetLog::ResetRecording(base::OnceClosure done) {
+  recording_ = false;
+  rotate_timer_.Stop();
+  segment_path_.clear();
+  previous_segment_path_.clear();
+
+  base::OnceClosure delete_dir = std::move(done);
+  if (!recording_dir_.empty()) {
+    delete_dir = base::BindOnce(
+        [](scoped_refptr<base::TaskRunner> task_runner, base::FilePath dir,
+           base::OnceClosure done) {
+          task_runner->PostTaskAndReply(
+              FROM_HERE, base::GetDeletePathRecursivelyCallback(dir),
+              std::move(done));
+        },
+        file_task_runner_, std::move(recording_dir_), std::move(delete_dir));
+    recording_dir_.clear();
+  }
+
+  if (segment_exporter_) {
+    RotateSegment(base::BindOnce(
+        [](base::OnceClosure delete_dir, std::vector<base::FilePath>) {
+          std::move(delete_dir).Run();
+        },
+        std::move(delete_dir)));
+  } else {
+    std::move(delete_dir).Run();
+  }
+}
+
+v8::Local<v8::Promise> NetLog::DumpRecording(base::FilePath dump_path,
+                                             gin::Arguments* args) {
+  if (dump_path.empty()) {
+    args->ThrowTypeError("The first parameter must be a valid string");
+    return v8::Local<v8::Promise>();
+  }
+
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!recording_ || recording_dir_.empty()) {
+    promise.RejectWithErrorMessage("No net log recording in progress");
+    return handle;
+  }
+
+  // Completes the current segment, so that it holds valid JSON up to now.
+  RotateSegment(base::BindOnce(
+      [](scoped_refptr<base::TaskRunner> task_runner, base::FilePath dump_path,
+         gin_helper::Promise<void> promise,
+         std::vector<base::FilePath> segments) {
+        task_runner->PostTaskAndReplyWithResult(
+            FROM_HERE,
+            base::BindOnce(&WriteMergedNetLog, std::move(segments),
+                           std::move(dump_path)),
+            base::BindOnce(
+                [](gin_helper::Promise<void> promise, std::string error) {
+                  if (error.empty())
+                    promise.Resolve();
+                  else
+                    promise.RejectWithErrorMessage(error);
+                },
+                std::move(promise)));
+      },
+      file_task_runner_, std::move(dump_path), std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> NetLog::StopRecording(gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!recording_) {
+    promise.RejectWithErrorMessage("No net log recording in progress");
+    return handle;
+  }
+
+  if (pending_recording_promise_) {
+    std::move(*pending_recording_promise_)
+        .RejectWithErrorMessage("The net log recording was stopped");
+    pending_recording_promise_.reset();
+  }
+  ResetRecording(base::BindOnce(
+      [](gin_helper::Promise<void> promise) { promise.Resolve(); },
+      std::move(promise)));
+
+  return handle;
+}
+
+bool NetLog::IsCurrentlyRecording() const {
+  return recording_;
+}
+
 gin::ObjectTemplateBuilder NetLog::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<NetLog>::GetObjectTemplateBuilder(isolate)
       .SetProperty("currentlyLogging", &NetLog::IsCurrentlyLogging)
       .SetMethod("startLogging", &NetLog::StartLogging)
-      .SetMethod("stopLogging", &NetLog::StopLogging);
+      .SetMethod("stopLogging", &NetLog::StopLogging)
+      .SetProperty("currentlyRecording", &NetLog::IsCurrentlyRecording)
+      .SetMethod("startRecording", &NetLog::StartRecording)
+      .SetMethod("dumpRecording", &NetLog::DumpRecording)
+      .SetMethod("stopRecording", &NetLog::StopRecording);
 }
 
 const char* NetLog::GetTypeName() {
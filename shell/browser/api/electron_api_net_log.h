@@ -6,11 +6,13 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_NET_LOG_H_
 
 #include <optional>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
@@ -40,6 +42,14 @@ class NetLog : public gin::Wrappable<NetLog> {
   v8::Local<v8::Promise> StopLogging(gin::Arguments* args);
   bool IsCurrentlyLogging() const;
 
+  // Keeps a bounded log of the recent network events, which is only written
+  // out when it is dumped.
+  v8::Local<v8::Promise> StartRecording(gin::Arguments* args);
+  v8::Local<v8::Promise> DumpRecording(base::FilePath dump_path,
+                                       gin::Arguments* args);
+  v8::Local<v8::Promise> StopRecording(gin::Arguments* args);
+  bool IsCurrentlyRecording() const;
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -64,6 +74,20 @@ class NetLog : public gin::Wrappable<NetLog> {
   void NetLogStarted(int32_t error);
 
  private:
+  using DumpCallback = base::OnceCallback<void(std::vector<base::FilePath>)>;
+
+  void OnRecordingDirCreated(base::FilePath dir);
+  void StartSegment();
+  void StartSegmentAfterCreateFile(base::FilePath path,
+                                   base::File output_file);
+  void OnSegmentStarted(int32_t error);
+  // Stops the current segment and starts the next one, |dump| is given the
+  // segments that hold the recent events once the current one is complete.
+  void RotateSegment(DumpCallback dump);
+  void OnSegmentStopped(base::FilePath path, DumpCallback dump);
+  // Stops the recording, |done| runs once its files are deleted.
+  void ResetRecording(base::OnceClosure done);
+
   raw_ptr<ElectronBrowserContext> browser_context_;
 
   mojo::Remote<network::mojom::NetLogExporter> net_log_exporter_;
@@ -72,6 +96,23 @@ class NetLog : public gin::Wrappable<NetLog> {
 
   scoped_refptr<base::TaskRunner> file_task_runner_;
 
+  // The recording is written to a couple of files in |recording_dir_|, each
+  // holding the events of a segment. The segments are rotated periodically
+  // and only the previous one is kept, which bounds the size of the log and
+  // the cost of writing it without a network service API to keep the events
+  // in memory.
+  bool recording_ = false;
+  net::NetLogCaptureMode recording_capture_mode_ =
+      net::NetLogCaptureMode::kDefault;
+  uint64_t recording_max_size_ = 0;
+  base::FilePath recording_dir_;
+  uint64_t next_segment_ = 0;
+  mojo::Remote<network::mojom::NetLogExporter> segment_exporter_;
+  base::FilePath segment_path_;
+  base::FilePath previous_segment_path_;
+  base::RepeatingTimer rotate_timer_;
+  std::optional<gin_helper::Promise<void>> pending_recording_promise_;
+
   base::WeakPtrFactory<NetLog> weak_ptr_factory_{this};
 };
 
@@ -167,6 +167,11 @@ void Notification::NotificationClosed() {
 
 void Notification::Close() {
   if (notification_) {
+    // A notification that is still queued is discarded without being shown.
+    if (presenter_->CancelPendingNotification(notification_.get())) {
+      notification_.reset();
+      return;
+    }
     if (notification_->is_dismissed()) {
       notification_->Remove();
     } else {
@@ -199,7 +204,7 @@ void Notification::Show() {
       options.close_button_text = close_button_text_;
       options.urgency = urgency_;
       options.toast_xml = toast_xml_;
-      notification_->Show(options);
+      presenter_->ShowNotification(notification_.get(), options);
     }
   }
 }
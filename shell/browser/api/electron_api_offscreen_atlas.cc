@@ -0,0 +1,246 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_offscreen_atlas.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "gin/handle.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_converters/image_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/node_includes.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "ui/gfx/image/image.h"
+#include "ui/gfx/skia_util.h"
+
+namespace electron::api {
+
+namespace {
+
+constexpr int kMaxAtlasSize = 16384;
+
+// The bounds of the frame rates of offscreen views.
+constexpr int kMinFrameRate = 1;
+constexpr int kMaxFrameRate = 240;
+
+}  // namespace
+
+gin::WrapperInfo OffscreenAtlas::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+OffscreenAtlas::OffscreenAtlas(const SkBitmap& bitmap, int frame_rate)
+    : bitmap_(bitmap),
+      frame_rate_(frame_rate),
+      vsync_timebase_(base::TimeTicks::Now()) {}
+
+OffscreenAtlas::~OffscreenAtlas() = default;
+
+// static
+gin::Handle<OffscreenAtlas> OffscreenAtlas::New(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  int width = 0;
+  int height = 0;
+  if (!args->GetNext(&options) || !options.Get("width", &width) ||
+      !options.Get("height", &height) || width <= 0 || height <= 0 ||
+      width > kMaxAtlasSize || height > kMaxAtlasSize) {
+    args->ThrowTypeError(
+        "Expected options to have a width and a height between 1 and 16384");
+    return gin::Handle<OffscreenAtlas>();
+  }
+
+  int frame_rate = 60;
+  options.Get("frameRate", &frame_rate);
+  frame_rate = std::clamp(frame_rate, kMinFrameRate, kMaxFrameRate);
+
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocN32Pixels(width, height)) {
+    args->ThrowError("Failed to allocate the atlas");
+    return gin::Handle<OffscreenAtlas>();
+  }
+  bitmap.eraseColor(SK_ColorTRANSPARENT);
+
+  return gin::CreateHandle(args->isolate(),
+                           new OffscreenAtlas(bitmap, frame_rate));
+}
+
+void OffscreenAtlas::AddWebContents(gin::Arguments* args) {
+  gin::Handle<WebContents> web_contents;
+  if (!args->GetNext(&web_contents) || web_contents.IsEmpty()) {
+    args->ThrowTypeError("Expected a WebContents");
+    return;
+  }
+  gin_helper::Dictionary position;
+  int x = 0;
+  int y = 0;
+  if (!args->GetNext(&position) || !position.Get("x", &x) ||
+      !position.Get("y", &y)) {
+    args->ThrowTypeError("Expected a position with x and y");
+    return;
+  }
+  if (!web_contents->IsOffScreen()) {
+    args->ThrowTypeError("Expected an offscreen WebContents");
+    return;
+  }
+  if (!web_contents->SetOffscreenAtlas(weak_factory_.GetWeakPtr(),
+                                       vsync_timebase_)) {
+    args->ThrowError(
+        "WebContents using offscreen shared textures can't be added to an "
+        "atlas");
+    return;
+  }
+
+  const int32_t id = web_contents->ID();
+  if (auto it = regions_.find(id); it != regions_.end()) {
+    // Moving a WebContents clears where it was.
+    Clear(it->second.bounds);
+  } else if (!paint_timer_.IsRunning()) {
+    paint_timer_.Start(FROM_HERE, base::Seconds(1) / frame_rate_,
+                       base::BindRepeating(&OffscreenAtlas::Paint,
+                                           base::Unretained(this)));
+    // Painting goes on while there are WebContents in the atlas.
+    Pin(args->isolate());
+  }
+  regions_[id] = Region{gfx::Rect(x, y, 0, 0), gfx::Rect()};
+
+  web_contents->SetFrameRate(frame_rate_);
+  web_contents->Invalidate();
+}
+
+void OffscreenAtlas::RemoveWebContents(gin::Handle<WebContents> web_contents) {
+  if (web_contents.IsEmpty() || !regions_.contains(web_contents->ID()))
+    return;
+  web_contents->SetOffscreenAtlas(nullptr, base::TimeTicks());
+  RemoveRegion(web_contents->ID());
+}
+
+void OffscreenAtlas::OnWebContentsRemoved(int32_t web_contents_id) {
+  RemoveRegion(web_contents_id);
+}
+
+void OffscreenAtlas::RemoveRegion(int32_t web_contents_id) {
+  auto it = regions_.find(web_contents_id);
+  if (it == regions_.end())
+    return;
+  Clear(it->second.bounds);
+  regions_.erase(it);
+}
+
+void OffscreenAtlas::OnPaint(int32_t web_contents_id,
+                             const gfx::Rect& dirty_rect,
+                             const SkBitmap& bitmap) {
+  auto it = regions_.find(web_contents_id);
+  if (it == regions_.end() || bitmap.drawsNothing())
+    return;
+  Region& region = it->second;
+
+  gfx::Rect damage = dirty_rect;
+  if (region.bounds.size() != gfx::Size(bitmap.width(), bitmap.height())) {
+    Clear(region.bounds);
+    region.bounds.set_size(gfx::Size(bitmap.width(), bitmap.height()));
+    damage = gfx::Rect(region.bounds.size());
+  }
+  damage.Offset(region.bounds.OffsetFromOrigin());
+  damage.Intersect(region.bounds);
+  damage.Intersect(gfx::Rect(bitmap_.width(), bitmap_.height()));
+  if (damage.IsEmpty() || !EnsureUniqueBitmap())
+    return;
+
+  SkPixmap destination;
+  if (!bitmap_.pixmap().extractSubset(&destination,
+                                      gfx::RectToSkIRect(damage)))
+    return;
+  bitmap.readPixels(destination, damage.x() - region.bounds.x(),
+                    damage.y() - region.bounds.y());
+  region.damage.Union(damage);
+  damage_.Union(damage);
+}
+
+void OffscreenAtlas::Clear(const gfx::Rect& rect) {
+  gfx::Rect cleared =
+      gfx::IntersectRects(rect, gfx::Rect(bitmap_.width(), bitmap_.height()));
+  if (cleared.IsEmpty() || !EnsureUniqueBitmap())
+    return;
+  bitmap_.erase(SK_ColorTRANSPARENT, gfx::RectToSkIRect(cleared));
+  damage_.Union(cleared);
+}
+
+bool OffscreenAtlas::EnsureUniqueBitmap() {
+  // The images of the previous paint events share the pixels of the atlas
+  // until they are released, so they are only copied when they are not.
+  if (bitmap_.pixelRef()->unique())
+    return true;
+  SkBitmap copy;
+  if (!copy.tryAllocPixels(bitmap_.info()) ||
+      !bitmap_.readPixels(copy.pixmap()))
+    return false;
+  bitmap_ = std::move(copy);
+  return true;
+}
+
+void OffscreenAtlas::Paint() {
+  if (damage_.IsEmpty()) {
+    // Stops once the pixels of the last WebContents were cleared.
+    if (regions_.empty()) {
+      paint_timer_.Stop();
+      Unpin();
+    }
+    return;
+  }
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<v8::Local<v8::Value>> regions;
+  for (auto& [id, region] : regions_) {
+    if (region.damage.IsEmpty())
+      continue;
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("webContentsId", id);
+    dict.Set("bounds", region.bounds);
+    dict.Set("dirtyRect", region.damage);
+    regions.push_back(dict.GetHandle());
+    region.damage = gfx::Rect();
+  }
+  gfx::Rect damage = damage_;
+  damage_ = gfx::Rect();
+
+  Emit("paint", gfx::Image::CreateFrom1xBitmap(bitmap_), damage, regions);
+}
+
+// static
+void OffscreenAtlas::FillObjectTemplate(v8::Isolate* isolate,
+                                        v8::Local<v8::ObjectTemplate> templ) {
+  gin::ObjectTemplateBuilder(isolate, GetClassName(), templ)
+      .SetMethod("addWebContents", &OffscreenAtlas::AddWebContents)
+      .SetMethod("removeWebContents", &OffscreenAtlas::RemoveWebContents)
+      .SetProperty("frameRate", &OffscreenAtlas::GetFrameRate)
+      .Build();
+}
+
+const char* OffscreenAtlas::GetTypeName() {
+  return GetClassName();
+}
+
+}  // namespace electron::api
+
+namespace {
+
+using electron::api::OffscreenAtlas;
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  v8::Isolate* isolate = context->GetIsolate();
+  gin_helper::Dictionary dict(isolate, exports);
+  dict.Set("OffscreenAtlas", OffscreenAtlas::GetConstructor(context));
+}
+
+}  // namespace
+
+NODE_LINKED_BINDING_CONTEXT_AWARE(electron_browser_offscreen_atlas, Initialize)
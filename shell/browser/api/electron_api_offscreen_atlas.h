@@ -0,0 +1,100 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_OFFSCREEN_ATLAS_H_
+#define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_OFFSCREEN_ATLAS_H_
+
+#include <map>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "gin/wrappable.h"
+#include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/constructible.h"
+#include "shell/common/gin_helper/pinnable.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace gin {
+class Arguments;
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron::api {
+
+class WebContents;
+
+// Composites the frames of many offscreen WebContents into regions of one
+// bitmap, which is painted once per frame for all of them, with the rects
+// that changed in each region, instead of once per WebContents.
+class OffscreenAtlas : public gin::Wrappable<OffscreenAtlas>,
+                       public gin_helper::EventEmitterMixin<OffscreenAtlas>,
+                       public gin_helper::Constructible<OffscreenAtlas>,
+                       public gin_helper::Pinnable<OffscreenAtlas> {
+ public:
+  // gin_helper::Constructible
+  static gin::Handle<OffscreenAtlas> New(gin::Arguments* args);
+  static void FillObjectTemplate(v8::Isolate*, v8::Local<v8::ObjectTemplate>);
+  static const char* GetClassName() { return "OffscreenAtlas"; }
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  const char* GetTypeName() override;
+
+  // disable copy
+  OffscreenAtlas(const OffscreenAtlas&) = delete;
+  OffscreenAtlas& operator=(const OffscreenAtlas&) = delete;
+
+  // Called by the WebContents that were added, in place of their own paint
+  // events.
+  void OnPaint(int32_t web_contents_id,
+               const gfx::Rect& dirty_rect,
+               const SkBitmap& bitmap);
+  // Called when a WebContents is destroyed or added to another atlas.
+  void OnWebContentsRemoved(int32_t web_contents_id);
+
+ private:
+  struct Region {
+    // The frame of the WebContents is drawn at |bounds.origin()|, and
+    // |bounds| has the size of its last frame.
+    gfx::Rect bounds;
+    // What was drawn in |bounds| since the last paint, in atlas coordinates.
+    gfx::Rect damage;
+  };
+
+  OffscreenAtlas(const SkBitmap& bitmap, int frame_rate);
+  ~OffscreenAtlas() override;
+
+  void AddWebContents(gin::Arguments* args);
+  void RemoveWebContents(gin::Handle<WebContents> web_contents);
+  int GetFrameRate() const { return frame_rate_; }
+
+  void RemoveRegion(int32_t web_contents_id);
+  // Clears the pixels in |rect|, which are painted with the next frame.
+  void Clear(const gfx::Rect& rect);
+  // Copies the pixels if they are shared with images painted before.
+  bool EnsureUniqueBitmap();
+  // Called once per frame for all the regions.
+  void Paint();
+
+  SkBitmap bitmap_;
+  const int frame_rate_;
+  // The compositors of the WebContents begin their frames in phase with it,
+  // so that their frames reach the atlas together.
+  base::TimeTicks vsync_timebase_;
+
+  std::map<int32_t, Region> regions_;
+  // What changed since the last paint, including the cleared pixels.
+  gfx::Rect damage_;
+  base::RepeatingTimer paint_timer_;
+
+  base::WeakPtrFactory<OffscreenAtlas> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_OFFSCREEN_ATLAS_H_
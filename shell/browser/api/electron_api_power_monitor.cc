@@ -4,6 +4,10 @@
 
 #include "shell/browser/api/electron_api_power_monitor.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/power_monitor/power_monitor.h"
 #include "base/power_monitor/power_monitor_device_source.h"
 #include "base/power_monitor/power_observer.h"
@@ -11,8 +15,10 @@
 #include "gin/handle.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/browser/power_policy.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 
@@ -56,6 +62,52 @@ struct Converter<base::PowerThermalObserver::DeviceThermalState> {
   }
 };
 
+template <>
+struct Converter<electron::PowerPolicy::Rule> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::PowerPolicy::Rule* out) {
+    using Condition = electron::PowerPolicy::Condition;
+    gin_helper::Dictionary dict;
+    if (!ConvertFromV8(isolate, val, &dict))
+      return false;
+    std::string when;
+    if (!dict.Get("when", &when))
+      return false;
+    if (when == "on-battery")
+      out->condition = Condition::kOnBattery;
+    else if (when == "thermal-fair")
+      out->condition = Condition::kThermalFair;
+    else if (when == "thermal-serious")
+      out->condition = Condition::kThermalSerious;
+    else if (when == "thermal-critical")
+      out->condition = Condition::kThermalCritical;
+    else
+      return false;
+
+    // The actions are optional, but one that is given must be valid.
+    electron::PowerPolicy::Actions& actions = out->actions;
+    if (dict.Has("maxOffscreenFrameRate") &&
+        (!dict.GetOptional("maxOffscreenFrameRate",
+                           &actions.max_offscreen_frame_rate) ||
+         *actions.max_offscreen_frame_rate < 1))
+      return false;
+    if (dict.Has("backgroundThrottlingPolicy") &&
+        !dict.GetOptional("backgroundThrottlingPolicy",
+                          &actions.background_throttling_policy))
+      return false;
+    if (dict.Has("pauseLowPriorityDownloads") &&
+        !dict.Get("pauseLowPriorityDownloads",
+                  &actions.pause_low_priority_downloads))
+      return false;
+    if (dict.Has("pauseRendererProcessPools") &&
+        !dict.Get("pauseRendererProcessPools",
+                  &actions.pause_renderer_process_pools))
+      return false;
+    return true;
+  }
+};
+
 }  // namespace gin
 
 namespace electron::api {
@@ -182,6 +234,16 @@ base::PowerThermalObserver::DeviceThermalState GetCurrentThermalState() {
   return base::PowerMonitor::GetCurrentThermalState();
 }
 
+void SetPolicy(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+  std::vector<electron::PowerPolicy::Rule> rules;
+  if (!gin::ConvertFromV8(isolate, value, &rules)) {
+    gin_helper::ErrorThrower(isolate).ThrowTypeError(
+        "rules must be an array of valid power policy rules");
+    return;
+  }
+  electron::PowerPolicy::GetInstance()->SetRules(std::move(rules));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -196,6 +258,7 @@ void Initialize(v8::Local<v8::Object> exports,
                  base::BindRepeating(&GetCurrentThermalState));
   dict.SetMethod("getSystemIdleTime", base::BindRepeating(&GetSystemIdleTime));
   dict.SetMethod("isOnBatteryPower", base::BindRepeating(&IsOnBatteryPower));
+  dict.SetMethod("setPolicy", base::BindRepeating(&SetPolicy));
 }
 
 }  // namespace
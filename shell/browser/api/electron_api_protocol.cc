@@ -235,6 +235,10 @@ bool Protocol::IsProtocolRegistered(const std::string& scheme) {
   return protocol_registry_->IsProtocolRegistered(scheme);
 }
 
+bool Protocol::EnableResponseCache(const std::string& scheme) {
+  return protocol_registry_->EnableResponseCache(scheme);
+}
+
 ProtocolError Protocol::InterceptProtocol(ProtocolType type,
                                           const std::string& scheme,
                                           const ProtocolHandler& handler) {
@@ -325,6 +329,7 @@ v8::Local<v8::ObjectTemplate> Protocol::FillObjectTemplate(
                  &Protocol::RegisterProtocolFor<ProtocolType::kFree>)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
       .SetMethod("isProtocolRegistered", &Protocol::IsProtocolRegistered)
+      .SetMethod("_enableResponseCache", &Protocol::EnableResponseCache)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
       .SetMethod("interceptStringProtocol",
                  &Protocol::InterceptProtocolFor<ProtocolType::kString>)
@@ -35,6 +35,19 @@ gin::WrapperInfo Screen::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 namespace {
 
+// The cursor is not checked more often than a display refreshes.
+constexpr base::TimeDelta kCursorTrackingInterval = base::Milliseconds(16);
+
+// Wayland will crash unless a window is created prior to calling
+// GetCursorScreenPoint.
+bool CanGetCursorScreenPoint() {
+#if defined(USE_OZONE)
+  return ui::OzonePlatform::IsInitialized();
+#else
+  return true;
+#endif
+}
+
 // Convert the changed_metrics bitmask to string array.
 std::vector<std::string> MetricsToArray(uint32_t metrics) {
   std::vector<std::string> array;
@@ -74,20 +87,39 @@ Screen::~Screen() {
 }
 
 gfx::Point Screen::GetCursorScreenPoint(v8::Isolate* isolate) {
-#if defined(USE_OZONE)
-  // Wayland will crash unless a window is created prior to calling
-  // GetCursorScreenPoint.
-  if (!ui::OzonePlatform::IsInitialized()) {
+  if (!CanGetCursorScreenPoint()) {
     gin_helper::ErrorThrower thrower(isolate);
     thrower.ThrowError(
         "screen.getCursorScreenPoint() cannot be called before a window has "
         "been created.");
     return gfx::Point();
   }
-#endif
   return screen_->GetCursorScreenPoint();
 }
 
+void Screen::SetCursorTracking(bool enabled) {
+  if (!enabled) {
+    cursor_timer_.Stop();
+    return;
+  }
+  if (cursor_timer_.IsRunning())
+    return;
+  if (CanGetCursorScreenPoint())
+    last_cursor_screen_point_ = screen_->GetCursorScreenPoint();
+  cursor_timer_.Start(FROM_HERE, kCursorTrackingInterval, this,
+                      &Screen::CheckCursorScreenPoint);
+}
+
+void Screen::CheckCursorScreenPoint() {
+  if (!CanGetCursorScreenPoint())
+    return;
+  gfx::Point point = screen_->GetCursorScreenPoint();
+  if (point == last_cursor_screen_point_)
+    return;
+  last_cursor_screen_point_ = point;
+  Emit("cursor-moved", point);
+}
+
 #if BUILDFLAG(IS_WIN)
 
 static gfx::Rect ScreenToDIPRect(electron::NativeWindow* window,
@@ -105,12 +137,14 @@ static gfx::Rect DIPToScreenRect(electron::NativeWindow* window,
 #endif
 
 void Screen::OnDisplayAdded(const display::Display& new_display) {
+  ++displays_version_;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmit, base::Unretained(this),
                                 "display-added", new_display));
 }
 
 void Screen::OnDisplayRemoved(const display::Display& old_display) {
+  ++displays_version_;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmit, base::Unretained(this),
                                 "display-removed", old_display));
@@ -118,6 +152,7 @@ void Screen::OnDisplayRemoved(const display::Display& old_display) {
 
 void Screen::OnDisplayMetricsChanged(const display::Display& display,
                                      uint32_t changed_metrics) {
+  ++displays_version_;
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostNonNestableTask(
       FROM_HERE, base::BindOnce(&DelayEmitWithMetrics, base::Unretained(this),
                                 "display-metrics-changed", display,
@@ -151,6 +186,8 @@ gin::ObjectTemplateBuilder Screen::GetObjectTemplateBuilder(
       .SetMethod("getPrimaryDisplay", &Screen::GetPrimaryDisplay)
       .SetMethod("getAllDisplays", &Screen::GetAllDisplays)
       .SetMethod("getDisplayNearestPoint", &Screen::GetDisplayNearestPoint)
+      .SetMethod("getDisplaysVersion", &Screen::GetDisplaysVersion)
+      .SetMethod("_setCursorTracking", &Screen::SetCursorTracking)
 #if BUILDFLAG(IS_WIN)
       .SetMethod("screenToDipPoint", &display::win::ScreenWin::ScreenToDIPPoint)
       .SetMethod("dipToScreenPoint", &display::win::ScreenWin::DIPToScreenPoint)
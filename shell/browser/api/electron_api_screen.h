@@ -8,14 +8,15 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/timer/timer.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "ui/display/display_observer.h"
 #include "ui/display/screen.h"
+#include "ui/gfx/geometry/point.h"
 
 namespace gfx {
-class Point;
 class Rect;
 class Screen;
 }  // namespace gfx
@@ -54,6 +55,11 @@ class Screen : public gin::Wrappable<Screen>,
   display::Display GetDisplayMatching(const gfx::Rect& match_rect) const {
     return screen_->GetDisplayMatching(match_rect);
   }
+  // Changes whenever a display is added, removed or changes.
+  uint32_t GetDisplaysVersion() const { return displays_version_; }
+
+  // Emits "cursor-moved" while there are listeners for it.
+  void SetCursorTracking(bool enabled);
 
   // display::DisplayObserver:
   void OnDisplayAdded(const display::Display& new_display) override;
@@ -62,7 +68,13 @@ class Screen : public gin::Wrappable<Screen>,
                                uint32_t changed_metrics) override;
 
  private:
+  void CheckCursorScreenPoint();
+
   raw_ptr<display::Screen> screen_;
+  uint32_t displays_version_ = 0;
+
+  base::RepeatingTimer cursor_timer_;
+  gfx::Point last_cursor_screen_point_;
 };
 
 }  // namespace electron::api
@@ -0,0 +1,376 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_serial_connection.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/trace_event/trace_event.h"
+#include "gin/converter.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+#include "shell/browser/javascript_environment.h"
+
+#include "shell/common/node_includes.h"
+
+namespace electron::api {
+
+namespace {
+
+const char* ReceiveErrorToString(device::mojom::SerialReceiveError error) {
+  switch (error) {
+    case device::mojom::SerialReceiveError::NONE:
+      return "none";
+    case device::mojom::SerialReceiveError::DISCONNECTED:
+      return "disconnected";
+    case device::mojom::SerialReceiveError::DEVICE_LOST:
+      return "device-lost";
+    case device::mojom::SerialReceiveError::BREAK:
+      return "break";
+    case device::mojom::SerialReceiveError::FRAME_ERROR:
+      return "frame-error";
+    case device::mojom::SerialReceiveError::OVERRUN:
+      return "overrun";
+    case device::mojom::SerialReceiveError::BUFFER_OVERFLOW:
+      return "buffer-overflow";
+    case device::mojom::SerialReceiveError::PARITY_ERROR:
+      return "parity-error";
+    case device::mojom::SerialReceiveError::SYSTEM_ERROR:
+      return "system-error";
+  }
+  return "unknown";
+}
+
+// Whether the port can't be read from again after |error|, the others only
+// affect the bytes that were being received.
+bool IsFatalReceiveError(device::mojom::SerialReceiveError error) {
+  return error == device::mojom::SerialReceiveError::DISCONNECTED ||
+         error == device::mojom::SerialReceiveError::DEVICE_LOST ||
+         error == device::mojom::SerialReceiveError::SYSTEM_ERROR;
+}
+
+const char* SendErrorToString(device::mojom::SerialSendError error) {
+  switch (error) {
+    case device::mojom::SerialSendError::NONE:
+      return "none";
+    case device::mojom::SerialSendError::DISCONNECTED:
+      return "disconnected";
+    case device::mojom::SerialSendError::SYSTEM_ERROR:
+      return "system-error";
+  }
+  return "unknown";
+}
+
+bool CreatePipe(uint32_t capacity,
+                mojo::ScopedDataPipeProducerHandle& producer,
+                mojo::ScopedDataPipeConsumerHandle& consumer) {
+  const MojoCreateDataPipeOptions options{
+      sizeof(MojoCreateDataPipeOptions), MOJO_CREATE_DATA_PIPE_FLAG_NONE, 1,
+      capacity};
+  return mojo::CreateDataPipe(&options, producer, consumer) == MOJO_RESULT_OK;
+}
+
+}  // namespace
+
+gin::WrapperInfo SerialConnection::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+SerialConnection::PendingWrite::PendingWrite(std::vector<uint8_t> data,
+                                             gin_helper::Promise<void> promise)
+    : data(std::move(data)), promise(std::move(promise)) {}
+SerialConnection::PendingWrite::PendingWrite(PendingWrite&&) = default;
+SerialConnection::PendingWrite& SerialConnection::PendingWrite::operator=(
+    PendingWrite&&) = default;
+SerialConnection::PendingWrite::~PendingWrite() = default;
+
+SerialConnection::SerialConnection(
+    mojo::PendingRemote<device::mojom::SerialPort> port,
+    mojo::PendingReceiver<device::mojom::SerialPortClient> client,
+    const ReadOptions& options)
+    : options_(options),
+      port_(std::move(port)),
+      client_receiver_(this, std::move(client)),
+      read_watcher_(FROM_HERE,
+                    mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                    base::SequencedTaskRunner::GetCurrentDefault()),
+      write_watcher_(FROM_HERE,
+                     mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                     base::SequencedTaskRunner::GetCurrentDefault()) {
+  port_.set_disconnect_handler(base::BindOnce(
+      &SerialConnection::OnConnectionError, weak_factory_.GetWeakPtr()));
+  StartReading();
+  StartWriting();
+}
+
+SerialConnection::~SerialConnection() = default;
+
+void SerialConnection::OnReadError(device::mojom::SerialReceiveError error) {
+  if (IsFatalReceiveError(error))
+    read_failed_ = true;
+  EmitWithoutEvent("read-error", ReceiveErrorToString(error));
+}
+
+void SerialConnection::OnSendError(device::mojom::SerialSendError error) {
+  RejectWrites("Failed to write to the serial port");
+  EmitWithoutEvent("write-error", SendErrorToString(error));
+}
+
+v8::Local<v8::Promise> SerialConnection::Write(v8::Isolate* isolate,
+                                               v8::Local<v8::Value> data) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<uint8_t> bytes;
+  if (node::Buffer::HasInstance(data)) {
+    const auto* begin =
+        reinterpret_cast<const uint8_t*>(node::Buffer::Data(data));
+    bytes.assign(begin, begin + node::Buffer::Length(data));
+  } else if (std::string string; gin::ConvertFromV8(isolate, data, &string)) {
+    bytes.assign(string.begin(), string.end());
+  } else {
+    promise.RejectWithErrorMessage("data must be a Buffer or a string");
+    return handle;
+  }
+
+  if (!port_) {
+    promise.RejectWithErrorMessage("The serial port is closed");
+    return handle;
+  }
+  if (bytes.empty()) {
+    promise.Resolve();
+    return handle;
+  }
+
+  pending_writes_.emplace_back(std::move(bytes), std::move(promise));
+  if (pending_writes_.size() == 1 && write_pipe_)
+    write_watcher_.ArmOrNotify();
+  return handle;
+}
+
+v8::Local<v8::Promise> SerialConnection::Drain(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!port_) {
+    promise.RejectWithErrorMessage("The serial port is closed");
+    return handle;
+  }
+  port_->Drain(base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                              std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> SerialConnection::Flush(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!port_) {
+    promise.RejectWithErrorMessage("The serial port is closed");
+    return handle;
+  }
+  read_buffer_.clear();
+  read_timer_.Stop();
+  port_->Flush(device::mojom::SerialPortFlushMode::kReceiveAndTransmit,
+               base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
+                              std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> SerialConnection::Close(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!port_) {
+    promise.Resolve();
+    return handle;
+  }
+  port_->Close(
+      /*flush=*/true,
+      base::BindOnce(
+          [](base::WeakPtr<SerialConnection> self,
+             gin_helper::Promise<void> promise) {
+            if (self)
+              self->OnClosed();
+            promise.Resolve();
+          },
+          weak_factory_.GetWeakPtr(), std::move(promise)));
+  return handle;
+}
+
+bool SerialConnection::IsOpen() const {
+  return port_.is_bound();
+}
+
+void SerialConnection::StartReading() {
+  mojo::ScopedDataPipeProducerHandle producer;
+  if (!CreatePipe(options_.buffer_size, producer, read_pipe_)) {
+    read_failed_ = true;
+    return;
+  }
+  port_->StartReading(std::move(producer));
+  read_watcher_.Watch(read_pipe_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+                      MOJO_WATCH_CONDITION_SATISFIED,
+                      base::BindRepeating(&SerialConnection::OnReadable,
+                                          weak_factory_.GetWeakPtr()));
+  read_watcher_.ArmOrNotify();
+}
+
+void SerialConnection::OnReadable(MojoResult result) {
+  TRACE_EVENT0("electron", "SerialConnection::OnReadable");
+  // Everything that is available is taken at once, the reads are only
+  // batched on this side of the pipe.
+  while (result == MOJO_RESULT_OK) {
+    const void* buffer = nullptr;
+    uint32_t available = 0;
+    result = read_pipe_->BeginReadData(&buffer, &available,
+                                       MOJO_READ_DATA_FLAG_NONE);
+    if (result != MOJO_RESULT_OK)
+      break;
+    const auto* bytes = static_cast<const uint8_t*>(buffer);
+    read_buffer_.insert(read_buffer_.end(), bytes, bytes + available);
+    read_pipe_->EndReadData(available);
+  }
+
+  if (result == MOJO_RESULT_SHOULD_WAIT) {
+    if (read_buffer_.size() >= options_.batch_size) {
+      EmitData();
+    } else if (!read_buffer_.empty() && !read_timer_.IsRunning()) {
+      read_timer_.Start(FROM_HERE, options_.timeout,
+                        base::BindOnce(&SerialConnection::EmitData,
+                                       weak_factory_.GetWeakPtr()));
+    }
+    read_watcher_.ArmOrNotify();
+    return;
+  }
+
+  // The port closes the pipe after a read error, a new one is needed to keep
+  // reading.
+  read_watcher_.Cancel();
+  read_pipe_.reset();
+  EmitData();
+  if (port_ && !read_failed_)
+    StartReading();
+}
+
+void SerialConnection::EmitData() {
+  read_timer_.Stop();
+  if (read_buffer_.empty())
+    return;
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<uint8_t> data;
+  data.swap(read_buffer_);
+  EmitWithoutEvent(
+      "data",
+      node::Buffer::Copy(isolate, reinterpret_cast<const char*>(data.data()),
+                         data.size())
+          .ToLocalChecked());
+}
+
+void SerialConnection::StartWriting() {
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (!CreatePipe(options_.buffer_size, write_pipe_, consumer))
+    return;
+  port_->StartWriting(std::move(consumer));
+  write_watcher_.Watch(write_pipe_.get(), MOJO_HANDLE_SIGNAL_WRITABLE,
+                       MOJO_WATCH_CONDITION_SATISFIED,
+                       base::BindRepeating(&SerialConnection::OnWritable,
+                                           weak_factory_.GetWeakPtr()));
+  if (!pending_writes_.empty())
+    write_watcher_.ArmOrNotify();
+}
+
+void SerialConnection::OnWritable(MojoResult result) {
+  while (result == MOJO_RESULT_OK && !pending_writes_.empty()) {
+    PendingWrite& write = pending_writes_.front();
+    uint32_t size = static_cast<uint32_t>(
+        std::min<size_t>(write.data.size() - write.offset,
+                         std::numeric_limits<uint32_t>::max()));
+    result = write_pipe_->WriteData(write.data.data() + write.offset, &size,
+                                    MOJO_WRITE_DATA_FLAG_NONE);
+    if (result != MOJO_RESULT_OK)
+      break;
+    write.offset += size;
+    if (write.offset == write.data.size()) {
+      gin_helper::Promise<void> promise = std::move(write.promise);
+      pending_writes_.pop_front();
+      promise.Resolve();
+    }
+  }
+
+  if (result == MOJO_RESULT_OK || result == MOJO_RESULT_SHOULD_WAIT) {
+    if (!pending_writes_.empty())
+      write_watcher_.ArmOrNotify();
+    return;
+  }
+
+  // The port closes the pipe after a send error, the writes that are left
+  // were rejected by OnSendError() and the next ones go to a new pipe.
+  write_watcher_.Cancel();
+  write_pipe_.reset();
+  if (port_)
+    StartWriting();
+}
+
+void SerialConnection::RejectWrites(const char* message) {
+  while (!pending_writes_.empty()) {
+    gin_helper::Promise<void> promise =
+        std::move(pending_writes_.front().promise);
+    pending_writes_.pop_front();
+    promise.RejectWithErrorMessage(message);
+  }
+}
+
+void SerialConnection::OnConnectionError() {
+  OnClosed();
+}
+
+void SerialConnection::OnClosed() {
+  if (!port_)
+    return;
+  port_.reset();
+  client_receiver_.reset();
+  read_watcher_.Cancel();
+  write_watcher_.Cancel();
+  // The bytes that were read before the port closed are still delivered.
+  EmitData();
+  read_pipe_.reset();
+  write_pipe_.reset();
+  RejectWrites("The serial port is closed");
+  EmitWithoutEvent("close");
+  Unpin();
+}
+
+// static
+gin::Handle<SerialConnection> SerialConnection::Create(
+    v8::Isolate* isolate,
+    mojo::PendingRemote<device::mojom::SerialPort> port,
+    mojo::PendingReceiver<device::mojom::SerialPortClient> client,
+    const ReadOptions& options) {
+  auto handle = gin::CreateHandle(
+      isolate, new SerialConnection(std::move(port), std::move(client),
+                                    options));
+  // Kept alive while the port is open, so that the 'data' events keep
+  // coming without a reference from JS.
+  handle->Pin(isolate);
+  return handle;
+}
+
+gin::ObjectTemplateBuilder SerialConnection::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin_helper::EventEmitterMixin<
+             SerialConnection>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("write", &SerialConnection::Write)
+      .SetMethod("drain", &SerialConnection::Drain)
+      .SetMethod("flush", &SerialConnection::Flush)
+      .SetMethod("close", &SerialConnection::Close)
+      .SetProperty("isOpen", &SerialConnection::IsOpen);
+}
+
+const char* SerialConnection::GetTypeName() {
+  return "SerialConnection";
+}
+
+}  // namespace electron::api
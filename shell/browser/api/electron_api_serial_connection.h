@@ -0,0 +1,128 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERIAL_CONNECTION_H_
+#define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERIAL_CONNECTION_H_
+
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "services/device/public/mojom/serial.mojom.h"
+#include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/pinnable.h"
+#include "shell/common/gin_helper/promise.h"
+
+namespace gin {
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron::api {
+
+// A serial port opened from the main process with session.openSerialPort(),
+// which reads and writes through the device service directly instead of
+// through a renderer.
+class SerialConnection
+    : public gin::Wrappable<SerialConnection>,
+      public gin_helper::Pinnable<SerialConnection>,
+      public gin_helper::EventEmitterMixin<SerialConnection>,
+      public device::mojom::SerialPortClient {
+ public:
+  struct ReadOptions {
+    // The capacity of the data pipes the port is read from and written to.
+    uint32_t buffer_size = 0;
+    // The 'data' event is emitted once this many bytes were read...
+    uint32_t batch_size = 1;
+    // ...or once this long passed since the first byte of the batch.
+    base::TimeDelta timeout;
+  };
+
+  static gin::Handle<SerialConnection> Create(
+      v8::Isolate* isolate,
+      mojo::PendingRemote<device::mojom::SerialPort> port,
+      mojo::PendingReceiver<device::mojom::SerialPortClient> client,
+      const ReadOptions& options);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  SerialConnection(const SerialConnection&) = delete;
+  SerialConnection& operator=(const SerialConnection&) = delete;
+
+ private:
+  struct PendingWrite {
+    PendingWrite(std::vector<uint8_t> data, gin_helper::Promise<void> promise);
+    PendingWrite(PendingWrite&&);
+    PendingWrite& operator=(PendingWrite&&);
+    ~PendingWrite();
+
+    std::vector<uint8_t> data;
+    size_t offset = 0;
+    gin_helper::Promise<void> promise;
+  };
+
+  SerialConnection(
+      mojo::PendingRemote<device::mojom::SerialPort> port,
+      mojo::PendingReceiver<device::mojom::SerialPortClient> client,
+      const ReadOptions& options);
+  ~SerialConnection() override;
+
+  // device::mojom::SerialPortClient:
+  void OnReadError(device::mojom::SerialReceiveError error) override;
+  void OnSendError(device::mojom::SerialSendError error) override;
+
+  // JS API.
+  v8::Local<v8::Promise> Write(v8::Isolate* isolate,
+                               v8::Local<v8::Value> data);
+  v8::Local<v8::Promise> Drain(v8::Isolate* isolate);
+  v8::Local<v8::Promise> Flush(v8::Isolate* isolate);
+  v8::Local<v8::Promise> Close(v8::Isolate* isolate);
+  bool IsOpen() const;
+
+  void StartReading();
+  void OnReadable(MojoResult result);
+  void EmitData();
+
+  void StartWriting();
+  void OnWritable(MojoResult result);
+  void RejectWrites(const char* message);
+
+  void OnConnectionError();
+  void OnClosed();
+
+  const ReadOptions options_;
+  mojo::Remote<device::mojom::SerialPort> port_;
+  mojo::Receiver<device::mojom::SerialPortClient> client_receiver_;
+
+  mojo::ScopedDataPipeConsumerHandle read_pipe_;
+  mojo::SimpleWatcher read_watcher_;
+  std::vector<uint8_t> read_buffer_;
+  base::OneShotTimer read_timer_;
+  // Whether the last read error stops the port from reading at all.
+  bool read_failed_ = false;
+
+  mojo::ScopedDataPipeProducerHandle write_pipe_;
+  mojo::SimpleWatcher write_watcher_;
+  base::circular_deque<PendingWrite> pending_writes_;
+
+  base::WeakPtrFactory<SerialConnection> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERIAL_CONNECTION_H_
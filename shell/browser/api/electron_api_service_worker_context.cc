@@ -4,14 +4,21 @@
 
 #include "shell/browser/api/electron_api_service_worker_context.h"
 
+#include <memory>
+#include <string>
 #include <string_view>
 #include <utility>
 
+#include "base/containers/fixed_flat_map.h"
+#include "base/functional/bind.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/string_number_conversions.h"
 #include "chrome/browser/browser_process.h"
 #include "content/public/browser/console_message.h"
 #include "content/public/browser/storage_partition.h"
+#include "gin/arguments.h"
 #include "gin/data_object_builder.h"
+#include "gin/dictionary.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "shell/browser/electron_browser_context.h"
@@ -20,7 +27,11 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "third_party/blink/public/common/service_worker/service_worker_status_code.h"
+#include "third_party/blink/public/common/storage_key/storage_key.h"
+#include "url/origin.h"
 
 namespace electron::api {
 
@@ -68,8 +79,36 @@ v8::Local<v8::Value> ServiceWorkerRunningInfoToDict(
       .Build();
 }
 
+using StartWorkerPromise = gin_helper::Promise<v8::Local<v8::Value>>;
+
+void OnWorkerStarted(std::shared_ptr<StartWorkerPromise> promise,
+                     const GURL& scope,
+                     int64_t version_id,
+                     int process_id,
+                     int thread_id) {
+  v8::HandleScope handle_scope(promise->isolate());
+  promise->Resolve(gin::DataObjectBuilder(promise->isolate())
+                       .Set("versionId", version_id)
+                       .Set("scope", scope.spec())
+                       .Set("renderProcessId", process_id)
+                       .Build());
+}
+
+void OnWorkerFailedToStart(std::shared_ptr<StartWorkerPromise> promise,
+                           blink::ServiceWorkerStatusCode status) {
+  promise->RejectWithErrorMessage(
+      std::string("Failed to start the service worker: ") +
+      blink::ServiceWorkerStatusToString(status));
+}
+
 }  // namespace
 
+ServiceWorkerContext::EventFilter::EventFilter() = default;
+ServiceWorkerContext::EventFilter::EventFilter(EventFilter&&) = default;
+ServiceWorkerContext::EventFilter& ServiceWorkerContext::EventFilter::operator=(
+    EventFilter&&) = default;
+ServiceWorkerContext::EventFilter::~EventFilter() = default;
+
 gin::WrapperInfo ServiceWorkerContext::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 ServiceWorkerContext::ServiceWorkerContext(
@@ -88,6 +127,11 @@ void ServiceWorkerContext::OnReportConsoleMessage(
     int64_t version_id,
     const GURL& scope,
     const content::ConsoleMessage& message) {
+  if (event_filter_ &&
+      (static_cast<int32_t>(message.message_level) <
+           event_filter_->minimum_level ||
+       !MatchesScope(scope)))
+    return;
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   Emit("console-message",
@@ -102,6 +146,8 @@ void ServiceWorkerContext::OnReportConsoleMessage(
 }
 
 void ServiceWorkerContext::OnRegistrationCompleted(const GURL& scope) {
+  if (event_filter_ && !MatchesScope(scope))
+    return;
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   Emit("registration-completed",
@@ -141,6 +187,79 @@ v8::Local<v8::Value> ServiceWorkerContext::GetWorkerInfoFromID(
                                         std::move(iter->second));
 }
 
+void ServiceWorkerContext::SetEventFilter(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) || value->IsNullOrUndefined()) {
+    event_filter_.reset();
+    return;
+  }
+
+  gin::Dictionary dict(args->isolate());
+  if (!gin::ConvertFromV8(args->isolate(), value, &dict)) {
+    args->ThrowTypeError("Must pass an object or null");
+    return;
+  }
+
+  EventFilter filter;
+  std::vector<std::string> patterns;
+  dict.Get("scopes", &patterns);
+  for (const std::string& pattern_string : patterns) {
+    URLPattern pattern(URLPattern::SCHEME_ALL);
+    const URLPattern::ParseResult result = pattern.Parse(pattern_string);
+    if (result != URLPattern::ParseResult::kSuccess) {
+      args->ThrowTypeError("Invalid url pattern " + pattern_string + ": " +
+                           URLPattern::GetParseResultString(result));
+      return;
+    }
+    filter.scopes.push_back(std::move(pattern));
+  }
+
+  static constexpr auto kLevels =
+      base::MakeFixedFlatMap<std::string_view, int32_t>({
+          {"verbose", 0},
+          {"info", 1},
+          {"warning", 2},
+          {"error", 3},
+      });
+  std::string level;
+  if (dict.Get("minimumLevel", &level)) {
+    const auto* iter = kLevels.find(level);
+    if (iter == kLevels.end()) {
+      args->ThrowTypeError("Invalid level " + level);
+      return;
+    }
+    filter.minimum_level = iter->second;
+  }
+
+  event_filter_ = std::move(filter);
+}
+
+bool ServiceWorkerContext::MatchesScope(const GURL& scope) const {
+  return event_filter_->scopes.empty() ||
+         base::ranges::any_of(event_filter_->scopes,
+                              [&scope](const URLPattern& pattern) {
+                                return pattern.MatchesURL(scope);
+                              });
+}
+
+v8::Local<v8::Promise> ServiceWorkerContext::StartWorkerForScope(
+    v8::Isolate* isolate,
+    const GURL& scope) {
+  // Both callbacks settle the same promise, only one of them runs.
+  auto promise = std::make_shared<StartWorkerPromise>(isolate);
+  v8::Local<v8::Promise> handle = promise->GetHandle();
+  if (!scope.is_valid()) {
+    promise->RejectWithErrorMessage("Invalid scope " +
+                                    scope.possibly_invalid_spec());
+    return handle;
+  }
+  service_worker_context_->StartWorkerForScope(
+      scope, blink::StorageKey::CreateFirstParty(url::Origin::Create(scope)),
+      base::BindOnce(&OnWorkerStarted, promise, scope),
+      base::BindOnce(&OnWorkerFailedToStart, promise));
+  return handle;
+}
+
 // static
 gin::Handle<ServiceWorkerContext> ServiceWorkerContext::Create(
     v8::Isolate* isolate,
@@ -157,7 +276,10 @@ gin::ObjectTemplateBuilder ServiceWorkerContext::GetObjectTemplateBuilder(
       .SetMethod("getAllRunning",
                  &ServiceWorkerContext::GetAllRunningWorkerInfo)
       .SetMethod("getFromVersionID",
-                 &ServiceWorkerContext::GetWorkerInfoFromID);
+                 &ServiceWorkerContext::GetWorkerInfoFromID)
+      .SetMethod("setEventFilter", &ServiceWorkerContext::SetEventFilter)
+      .SetMethod("startWorkerForScope",
+                 &ServiceWorkerContext::StartWorkerForScope);
 }
 
 const char* ServiceWorkerContext::GetTypeName() {
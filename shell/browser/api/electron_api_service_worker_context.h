@@ -5,13 +5,23 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 
+#include <optional>
+#include <vector>
+
 #include "base/memory/raw_ptr.h"
 #include "content/public/browser/service_worker_context.h"
 #include "content/public/browser/service_worker_context_observer.h"
+#include "extensions/common/url_pattern.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
 
+class GURL;
+
+namespace gin {
+class Arguments;
+}  // namespace gin
+
 namespace electron {
 
 class ElectronBrowserContext;
@@ -30,6 +40,9 @@ class ServiceWorkerContext
   v8::Local<v8::Value> GetAllRunningWorkerInfo(v8::Isolate* isolate);
   v8::Local<v8::Value> GetWorkerInfoFromID(gin_helper::ErrorThrower thrower,
                                            int64_t version_id);
+  void SetEventFilter(gin::Arguments* args);
+  v8::Local<v8::Promise> StartWorkerForScope(v8::Isolate* isolate,
+                                             const GURL& scope);
 
   // content::ServiceWorkerContextObserver
   void OnReportConsoleMessage(int64_t version_id,
@@ -54,7 +67,24 @@ class ServiceWorkerContext
   ~ServiceWorkerContext() override;
 
  private:
+  // Set with setEventFilter(), so that the events of the service workers
+  // nobody listens to don't reach JS.
+  struct EventFilter {
+    EventFilter();
+    EventFilter(EventFilter&&);
+    EventFilter& operator=(EventFilter&&);
+    ~EventFilter();
+
+    // Empty matches all the scopes.
+    std::vector<URLPattern> scopes;
+    // Console messages below this level are dropped.
+    int32_t minimum_level = 0;
+  };
+
+  bool MatchesScope(const GURL& scope) const;
+
   raw_ptr<content::ServiceWorkerContext> service_worker_context_;
+  std::optional<EventFilter> event_filter_;
 
   base::WeakPtrFactory<ServiceWorkerContext> weak_ptr_factory_{this};
 };
@@ -6,20 +6,24 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/barrier_callback.h"
 #include "base/command_line.h"
 #include "base/containers/fixed_flat_map.h"
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/memory/raw_ptr.h"
+#include "base/ranges/algorithm.h"
 #include "base/scoped_observation.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/unguessable_token.h"
 #include "base/uuid.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/common/chrome_switches.h"
@@ -40,6 +44,7 @@
 #include "content/public/browser/download_manager_delegate.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/storage_partition.h"
+#include "content/public/browser/web_contents.h"
 #include "gin/arguments.h"
 #include "gin/converter.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -58,26 +63,39 @@
 #include "shell/browser/api/electron_api_cookies.h"
 #include "shell/browser/api/electron_api_data_pipe_holder.h"
 #include "shell/browser/api/electron_api_download_item.h"
+#include "shell/browser/api/electron_api_hid_device_connection.h"
 #include "shell/browser/api/electron_api_net_log.h"
 #include "shell/browser/api/electron_api_protocol.h"
+#include "shell/browser/api/electron_api_serial_connection.h"
 #include "shell/browser/api/electron_api_service_worker_context.h"
+#include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
 #include "shell/browser/api/electron_api_web_request.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_permission_manager.h"
+#include "shell/browser/hid/hid_chooser_context.h"
+#include "shell/browser/hid/hid_chooser_context_factory.h"
+#include "shell/browser/hid/hid_chooser_controller.h"
+#include "shell/browser/hidden_page_throttler.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
+#include "shell/browser/net/network_stats.h"
 #include "shell/browser/net/resolve_host_function.h"
+#include "shell/browser/renderer_process_pool.h"
+#include "shell/browser/serial/serial_chooser_context.h"
+#include "shell/browser/serial/serial_chooser_context_factory.h"
 #include "shell/browser/session_preferences.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
+#include "shell/common/gin_converters/hid_device_info_converter.h"
 #include "shell/common/gin_converters/media_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
+#include "shell/common/gin_converters/serial_port_info_converter.h"
 #include "shell/common/gin_converters/usb_protected_classes_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -462,6 +480,42 @@ struct Converter<network::mojom::SSLConfigPtr> {
   }
 };
 
+template <>
+struct Converter<electron::NetworkStats::Histogram> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::NetworkStats::Histogram& histogram) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("count", histogram.count);
+    dict.Set("totalTime", histogram.total.InMillisecondsF());
+    dict.Set("buckets", std::vector<uint64_t>(histogram.buckets.begin(),
+                                              histogram.buckets.end()));
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::NetworkStats::HostStats> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::NetworkStats::HostStats& stats) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("requests", stats.requests);
+    dict.Set("failedRequests", stats.failed_requests);
+    dict.Set("cachedRequests", stats.cached_requests);
+    dict.Set("bytesReceived", stats.bytes_received);
+    dict.Set("dns", stats.dns);
+    dict.Set("connect", stats.connect);
+    dict.Set("ssl", stats.ssl);
+    dict.Set("ttfb", stats.ttfb);
+    auto protocols = gin_helper::Dictionary::CreateEmpty(isolate);
+    for (const auto& [protocol, count] : stats.protocols)
+      protocols.Set(protocol, count);
+    dict.Set("protocols", protocols);
+    return dict.GetHandle();
+  }
+};
+
 }  // namespace gin
 
 namespace electron::api {
@@ -470,6 +524,36 @@ namespace {
 
 const char kPersistPrefix[] = "persist:";
 
+struct ResolveHostResult {
+  size_t index;
+  std::string host;
+  int64_t net_error;
+  std::optional<net::AddressList> addresses;
+};
+
+void OnResolveHostsComplete(
+    gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise,
+    std::vector<ResolveHostResult> results) {
+  // The results arrive in the order the lookups complete.
+  std::sort(results.begin(), results.end(),
+            [](const auto& a, const auto& b) { return a.index < b.index; });
+
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<gin_helper::Dictionary> hosts;
+  hosts.reserve(results.size());
+  for (const auto& result : results) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("host", result.host);
+    if (result.net_error < 0 || !result.addresses)
+      dict.Set("error", net::ErrorToString(result.net_error));
+    else
+      dict.Set("endpoints", result.addresses->endpoints());
+    hosts.push_back(std::move(dict));
+  }
+  promise.Resolve(hosts);
+}
+
 void DownloadIdCallback(content::DownloadManager* download_manager,
                         const base::FilePath& path,
                         const std::vector<GURL>& url_chain,
@@ -531,6 +615,21 @@ class DictionaryObserver final : public SpellcheckCustomDictionary::Observer {
 };
 #endif  // BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 
+#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
+// Reads the options of loadExtension() and loadExtensions().
+int GetExtensionLoadFlags(gin::Arguments* args) {
+  int load_flags = extensions::Extension::FOLLOW_SYMLINKS_ANYWHERE;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    bool allowFileAccess = false;
+    options.Get("allowFileAccess", &allowFileAccess);
+    if (allowFileAccess)
+      load_flags |= extensions::Extension::ALLOW_FILE_ACCESS;
+  }
+  return load_flags;
+}
+#endif
+
 struct UserDataLink : base::SupportsUserData::Data {
   explicit UserDataLink(Session* ses) : session(ses) {}
 
@@ -634,6 +733,27 @@ v8::Local<v8::Promise> Session::ResolveProxy(gin::Arguments* args) {
   return handle;
 }
 
+void Session::SetProxyResolutionOptions(gin_helper::ErrorThrower thrower,
+                                        const gin_helper::Dictionary& options) {
+  int max_concurrent_lookups = 0;
+  if (options.Get("maxConcurrentLookups", &max_concurrent_lookups) &&
+      max_concurrent_lookups < 1) {
+    thrower.ThrowTypeError("maxConcurrentLookups must be a positive integer");
+    return;
+  }
+  double cache_ttl = 0;
+  if (options.Get("cacheTTL", &cache_ttl) && !(cache_ttl >= 0)) {
+    thrower.ThrowTypeError("cacheTTL must be a non-negative number");
+    return;
+  }
+
+  auto* resolve_proxy_helper = browser_context_->GetResolveProxyHelper();
+  if (max_concurrent_lookups > 0)
+    resolve_proxy_helper->SetMaxConcurrentLookups(max_concurrent_lookups);
+  if (options.Has("cacheTTL"))
+    resolve_proxy_helper->SetCacheTTL(base::Milliseconds(cache_ttl));
+}
+
 v8::Local<v8::Promise> Session::ResolveHost(
     std::string host,
     std::optional<network::mojom::ResolveHostParametersPtr> params) {
@@ -647,16 +767,23 @@ v8::Local<v8::Promise> Session::ResolveHost(
           [](gin_helper::Promise<gin_helper::Dictionary> promise,
              int64_t net_error, const std::optional<net::AddressList>& addrs) {
             if (net_error < 0) {
-              promise.RejectWithErrorMessage(net::ErrorToString(net_error));
-            } else {
-              DCHECK(addrs.has_value() && !addrs->empty());
-
-              v8::HandleScope handle_scope(promise.isolate());
-              auto dict =
-                  gin_helper::Dictionary::CreateEmpty(promise.isolate());
-              dict.Set("endpoints", addrs->endpoints());
-              promise.Resolve(dict);
+              gin_helper::Promise<gin_helper::Dictionary>::RejectPromise(
+                  std::move(promise), net::ErrorToString(net_error));
+              return;
             }
+
+            DCHECK(addrs.has_value() && !addrs->empty());
+            // Bulk lookups complete together, so they are resolved at once.
+            gin_helper::PromiseBase::SettleInBatch(base::BindOnce(
+                [](gin_helper::Promise<gin_helper::Dictionary> promise,
+                   const net::AddressList& addrs) {
+                  v8::HandleScope handle_scope(promise.isolate());
+                  auto dict =
+                      gin_helper::Dictionary::CreateEmpty(promise.isolate());
+                  dict.Set("endpoints", addrs.endpoints());
+                  promise.Resolve(dict);
+                },
+                std::move(promise), *addrs));
           },
           std::move(promise)));
 
@@ -665,6 +792,66 @@ v8::Local<v8::Promise> Session::ResolveHost(
   return handle;
 }
 
+v8::Local<v8::Promise> Session::ResolveHosts(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<std::string> hosts;
+  if (!args->GetNext(&hosts)) {
+    promise.RejectWithErrorMessage("hosts must be an array of strings");
+    return handle;
+  }
+
+  network::mojom::ResolveHostParametersPtr params;
+  bool stale_while_revalidate = false;
+  v8::Local<v8::Value> options;
+  if (args->GetNext(&options) && !options->IsUndefined()) {
+    gin_helper::Dictionary dict;
+    if (!gin::ConvertFromV8(isolate, options, &params) ||
+        !gin::ConvertFromV8(isolate, options, &dict)) {
+      promise.RejectWithErrorMessage("options must be an object");
+      return handle;
+    }
+    dict.Get("staleWhileRevalidate", &stale_while_revalidate);
+  }
+  if (!params)
+    params = network::mojom::ResolveHostParameters::New();
+  if (stale_while_revalidate)
+    params->cache_usage =
+        network::mojom::ResolveHostParameters::CacheUsage::STALE_ALLOWED;
+
+  auto barrier = base::BarrierCallback<ResolveHostResult>(
+      hosts.size(),
+      base::BindOnce(&OnResolveHostsComplete, std::move(promise)));
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    auto fn = base::MakeRefCounted<ResolveHostFunction>(
+        browser_context_, hosts[i], params.Clone(),
+        base::BindOnce(
+            [](base::RepeatingCallback<void(ResolveHostResult)> barrier,
+               size_t index, std::string host, int64_t net_error,
+               const std::optional<net::AddressList>& addrs) {
+              barrier.Run({index, std::move(host), net_error, addrs});
+            },
+            barrier, i, hosts[i]));
+    fn->Run();
+
+    // The host cache can't tell whether a result was stale, so each host is
+    // resolved again in the background to refresh its cache entry.
+    if (stale_while_revalidate) {
+      auto refresh_params = params.Clone();
+      refresh_params->cache_usage =
+          network::mojom::ResolveHostParameters::CacheUsage::DISALLOWED;
+      auto refresh = base::MakeRefCounted<ResolveHostFunction>(
+          browser_context_, hosts[i], std::move(refresh_params),
+          base::DoNothing());
+      refresh->Run();
+    }
+  }
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Session::GetCacheSize() {
   gin_helper::Promise<int64_t> promise(isolate_);
   auto handle = promise.GetHandle();
@@ -692,6 +879,7 @@ v8::Local<v8::Promise> Session::ClearCache() {
   gin_helper::Promise<void> promise(isolate_);
   auto handle = promise.GetHandle();
 
+  browser_context_->GetResolveProxyHelper()->ClearCache();
   browser_context_->GetDefaultStoragePartition()
       ->GetNetworkContext()
       ->ClearHttpCache(base::Time(), base::Time::Max(), nullptr,
@@ -701,6 +889,17 @@ v8::Local<v8::Promise> Session::ClearCache() {
   return handle;
 }
 
+v8::Local<v8::Value> Session::GetNetworkStats(v8::Isolate* isolate) {
+  auto hosts = gin_helper::Dictionary::CreateEmpty(isolate);
+  for (const auto& [host, stats] : browser_context_->network_stats()->hosts())
+    hosts.Set(host, stats);
+  return hosts.GetHandle();
+}
+
+void Session::ClearNetworkStats() {
+  browser_context_->network_stats()->Clear();
+}
+
 v8::Local<v8::Promise> Session::ClearStorageData(gin::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
   gin_helper::Promise<void> promise(isolate);
@@ -770,6 +969,7 @@ v8::Local<v8::Promise> Session::SetProxy(gin::Arguments* args) {
       base::Value{
           createProxyConfig(proxy_mode, pac_url, proxy_rules, bypass_list)},
       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  browser_context_->GetResolveProxyHelper()->ClearCache();
 
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
       FROM_HERE, base::BindOnce(gin_helper::Promise<void>::ResolvePromise,
@@ -827,11 +1027,20 @@ void Session::SetCertVerifyProc(v8::Local<v8::Value> val,
     return;
   }
 
+  double cache_ttl = 0;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options) && options.Get("cacheTTL", &cache_ttl) &&
+      !(cache_ttl >= 0)) {
+    args->ThrowTypeError("cacheTTL must be a non-negative number");
+    return;
+  }
+
   mojo::PendingRemote<network::mojom::CertVerifierClient>
       cert_verifier_client_remote;
   if (proc) {
     mojo::MakeSelfOwnedReceiver(
-        std::make_unique<CertVerifierClient>(proc),
+        std::make_unique<CertVerifierClient>(proc,
+                                             base::Milliseconds(cache_ttl)),
         cert_verifier_client_remote.InitWithNewPipeAndPassReceiver());
   }
   browser_context_->GetDefaultStoragePartition()
@@ -872,9 +1081,19 @@ void Session::SetPermissionCheckHandler(v8::Local<v8::Value> val,
     args->ThrowTypeError("Must pass null or function");
     return;
   }
+  bool cache = false;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("cache", &cache);
+  auto* permission_manager = static_cast<ElectronPermissionManager*>(
+      browser_context()->GetPermissionControllerDelegate());
+  permission_manager->SetPermissionCheckHandler(handler, cache);
+}
+
+void Session::ClearPermissionCheckCache() {
   auto* permission_manager = static_cast<ElectronPermissionManager*>(
       browser_context()->GetPermissionControllerDelegate());
-  permission_manager->SetPermissionCheckHandler(handler);
+  permission_manager->ClearPermissionCheckCache();
 }
 
 void Session::SetDisplayMediaRequestHandler(v8::Isolate* isolate,
@@ -1073,6 +1292,23 @@ std::vector<base::FilePath> Session::GetPreloads() const {
   return prefs->preloads();
 }
 
+void Session::SetBackgroundThrottlingPolicy(gin::Arguments* args) {
+  std::optional<BackgroundThrottlingPolicy> policy;
+  if (!GetBackgroundThrottlingPolicyArgument(args, &policy))
+    return;
+  auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
+  DCHECK(prefs);
+  prefs->set_background_throttling_policy(policy);
+
+  for (content::WebContents* web_contents :
+       content::WebContents::GetAllWebContents()) {
+    if (web_contents->GetBrowserContext() != browser_context())
+      continue;
+    if (auto* api_web_contents = WebContents::From(web_contents))
+      api_web_contents->UpdateHiddenPageThrottler();
+  }
+}
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
 v8::Local<v8::Promise> Session::LoadExtension(
     const base::FilePath& extension_path,
@@ -1092,15 +1328,7 @@ v8::Local<v8::Promise> Session::LoadExtension(
     return handle;
   }
 
-  int load_flags = extensions::Extension::FOLLOW_SYMLINKS_ANYWHERE;
-  gin_helper::Dictionary options;
-  if (args->GetNext(&options)) {
-    bool allowFileAccess = false;
-    options.Get("allowFileAccess", &allowFileAccess);
-    if (allowFileAccess)
-      load_flags |= extensions::Extension::ALLOW_FILE_ACCESS;
-  }
-
+  const int load_flags = GetExtensionLoadFlags(args);
   auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
       extensions::ExtensionSystem::Get(browser_context()));
   extension_system->LoadExtension(
@@ -1125,6 +1353,58 @@ v8::Local<v8::Promise> Session::LoadExtension(
   return handle;
 }
 
+v8::Local<v8::Promise> Session::LoadExtensions(
+    const std::vector<base::FilePath>& extension_paths,
+    gin::Arguments* args) {
+  gin_helper::Promise<std::vector<const extensions::Extension*>> promise(
+      isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  for (const auto& extension_path : extension_paths) {
+    if (!extension_path.IsAbsolute()) {
+      promise.RejectWithErrorMessage(
+          "The paths to the extensions in 'loadExtensions' must be absolute");
+      return handle;
+    }
+  }
+
+  if (browser_context()->IsOffTheRecord()) {
+    promise.RejectWithErrorMessage(
+        "Extensions cannot be loaded in a temporary session");
+    return handle;
+  }
+
+  const int load_flags = GetExtensionLoadFlags(args);
+  auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
+      extensions::ExtensionSystem::Get(browser_context()));
+  extension_system->LoadExtensions(
+      extension_paths, load_flags,
+      base::BindOnce(
+          [](gin_helper::Promise<std::vector<const extensions::Extension*>>
+                 promise,
+             std::vector<std::pair<const extensions::Extension*, std::string>>
+                 results) {
+            // The extensions that loaded stay loaded when another one fails.
+            std::vector<const extensions::Extension*> extensions;
+            for (const auto& [extension, error_msg] : results) {
+              if (!extension) {
+                promise.RejectWithErrorMessage(error_msg);
+                return;
+              }
+              if (!error_msg.empty()) {
+                node::Environment* env =
+                    node::Environment::GetCurrent(promise.isolate());
+                EmitWarning(env, error_msg, "ExtensionLoadWarning");
+              }
+              extensions.push_back(extension);
+            }
+            promise.Resolve(extensions);
+          },
+          std::move(promise)));
+
+  return handle;
+}
+
 void Session::RemoveExtension(const std::string& extension_id) {
   auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
       extensions::ExtensionSystem::Get(browser_context()));
@@ -1260,6 +1540,21 @@ v8::Local<v8::Promise> Session::CloseAllConnections() {
   return handle;
 }
 
+void Session::SetRendererProcessPool(const gin_helper::Dictionary& options,
+                                     gin::Arguments* args) {
+  int size = 0;
+  if (!options.Get("size", &size) || size < 0) {
+    args->ThrowTypeError(
+        "Must pass a non-negative size to session.setRendererProcessPool.");
+    return;
+  }
+
+  auto web_preferences = gin_helper::Dictionary::CreateEmpty(isolate_);
+  options.Get("webPreferences", &web_preferences);
+  browser_context_->GetRendererProcessPool()->Configure(
+      size, RendererProcessPreferences::FromDictionary(web_preferences));
+}
+
 v8::Local<v8::Value> Session::GetPath(v8::Isolate* isolate) {
   if (browser_context_->IsOffTheRecord()) {
     return v8::Null(isolate);
@@ -1389,6 +1684,233 @@ v8::Local<v8::Value> Session::ClearData(gin_helper::ErrorThrower thrower,
   return promise_handle;
 }
 
+v8::Local<v8::Promise> Session::GetSerialPorts() {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  SerialChooserContextFactory::GetForBrowserContext(browser_context_)
+      ->GetPortManager()
+      ->GetDevices(base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+             std::vector<device::mojom::SerialPortInfoPtr> ports) {
+            v8::HandleScope handle_scope(promise.isolate());
+            promise.Resolve(gin::ConvertToV8(promise.isolate(), ports));
+          },
+          std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> Session::OpenSerialPort(gin::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string port_id;
+  std::optional<base::UnguessableToken> token;
+  if (args->GetNext(&port_id))
+    token = base::UnguessableToken::DeserializeFromString(port_id);
+  if (!token) {
+    promise.RejectWithErrorMessage("Invalid portId");
+    return handle;
+  }
+
+  gin_helper::Dictionary options;
+  args->GetNext(&options);
+  auto connection_options = device::mojom::SerialConnectionOptions::New();
+  if (!options.Get("baudRate", &connection_options->bitrate) ||
+      connection_options->bitrate == 0) {
+    promise.RejectWithErrorMessage("baudRate must be a positive number");
+    return handle;
+  }
+
+  int data_bits = 8;
+  options.Get("dataBits", &data_bits);
+  if (data_bits == 7) {
+    connection_options->data_bits = device::mojom::SerialDataBits::SEVEN;
+  } else if (data_bits == 8) {
+    connection_options->data_bits = device::mojom::SerialDataBits::EIGHT;
+  } else {
+    promise.RejectWithErrorMessage("dataBits must be 7 or 8");
+    return handle;
+  }
+
+  std::string parity = "none";
+  options.Get("parity", &parity);
+  if (parity == "none") {
+    connection_options->parity_bit = device::mojom::SerialParityBit::NO_PARITY;
+  } else if (parity == "even") {
+    connection_options->parity_bit = device::mojom::SerialParityBit::EVEN;
+  } else if (parity == "odd") {
+    connection_options->parity_bit = device::mojom::SerialParityBit::ODD;
+  } else {
+    promise.RejectWithErrorMessage("parity must be 'none', 'even' or 'odd'");
+    return handle;
+  }
+
+  int stop_bits = 1;
+  options.Get("stopBits", &stop_bits);
+  if (stop_bits == 1) {
+    connection_options->stop_bits = device::mojom::SerialStopBits::ONE;
+  } else if (stop_bits == 2) {
+    connection_options->stop_bits = device::mojom::SerialStopBits::TWO;
+  } else {
+    promise.RejectWithErrorMessage("stopBits must be 1 or 2");
+    return handle;
+  }
+
+  std::string flow_control = "none";
+  options.Get("flowControl", &flow_control);
+  if (flow_control != "none" && flow_control != "hardware") {
+    promise.RejectWithErrorMessage(
+        "flowControl must be 'none' or 'hardware'");
+    return handle;
+  }
+  connection_options->has_cts_flow_control = true;
+  connection_options->cts_flow_control = flow_control == "hardware";
+
+  // The defaults match the ones of the Web Serial API, a single read is
+  // delivered as soon as it is available.
+  SerialConnection::ReadOptions read_options;
+  read_options.buffer_size = 255;
+  options.Get("bufferSize", &read_options.buffer_size);
+  double read_timeout = 0;
+  options.Get("readBatchSize", &read_options.batch_size);
+  options.Get("readTimeout", &read_timeout);
+  if (read_options.buffer_size == 0 ||
+      read_options.buffer_size > 16 * 1024 * 1024) {
+    promise.RejectWithErrorMessage(
+        "bufferSize must be between 1 and 16777216");
+    return handle;
+  }
+  if (read_options.batch_size == 0 || read_timeout < 0) {
+    promise.RejectWithErrorMessage(
+        "readBatchSize must be positive and readTimeout must not be negative");
+    return handle;
+  }
+  read_options.timeout = base::Milliseconds(read_timeout);
+
+  mojo::PendingRemote<device::mojom::SerialPortClient> client;
+  auto client_receiver = client.InitWithNewPipeAndPassReceiver();
+  SerialChooserContextFactory::GetForBrowserContext(browser_context_)
+      ->GetPortManager()
+      ->OpenPort(
+          *token, /*use_alternate_path=*/false, std::move(connection_options),
+          std::move(client), /*watcher=*/mojo::NullRemote(),
+          base::BindOnce(
+              [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+                 mojo::PendingReceiver<device::mojom::SerialPortClient>
+                     client_receiver,
+                 SerialConnection::ReadOptions read_options,
+                 mojo::PendingRemote<device::mojom::SerialPort> port) {
+                if (!port) {
+                  promise.RejectWithErrorMessage(
+                      "Failed to open the serial port");
+                  return;
+                }
+                v8::Isolate* isolate = promise.isolate();
+                v8::HandleScope handle_scope(isolate);
+                promise.Resolve(SerialConnection::Create(
+                                    isolate, std::move(port),
+                                    std::move(client_receiver), read_options)
+                                    .ToV8());
+              },
+              std::move(promise), std::move(client_receiver), read_options));
+  return handle;
+}
+
+v8::Local<v8::Promise> Session::GetHidDevices() {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  HidChooserContextFactory::GetForBrowserContext(browser_context_)
+      ->GetDevices(base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+             std::vector<device::mojom::HidDeviceInfoPtr> devices) {
+            // The collections of a device are listed once, like in the
+            // select-hid-device event.
+            std::set<std::string> device_ids;
+            std::erase_if(devices, [&device_ids](const auto& device) {
+              return !device_ids
+                          .insert(HidChooserController::
+                                      PhysicalDeviceIdFromDeviceInfo(*device))
+                          .second;
+            });
+            v8::HandleScope handle_scope(promise.isolate());
+            promise.Resolve(gin::ConvertToV8(promise.isolate(), devices));
+          },
+          std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> Session::OpenHidDevice(gin::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string device_id;
+  if (!args->GetNext(&device_id)) {
+    promise.RejectWithErrorMessage("deviceId must be a string");
+    return handle;
+  }
+
+  HidDeviceConnection::BatchOptions batch_options;
+  double batch_interval = 0;
+  if (gin_helper::Dictionary options; args->GetNext(&options)) {
+    options.Get("batchInterval", &batch_interval);
+    options.Get("maxBatchSize", &batch_options.max_size);
+  }
+  if (batch_interval < 0 || batch_options.max_size == 0) {
+    promise.RejectWithErrorMessage(
+        "batchInterval must not be negative and maxBatchSize must be "
+        "positive");
+    return handle;
+  }
+  batch_options.interval = base::Milliseconds(batch_interval);
+
+  HidChooserContext* context =
+      HidChooserContextFactory::GetForBrowserContext(browser_context_);
+  context->GetDevices(base::BindOnce(
+      [](base::WeakPtr<HidChooserContext> context,
+         gin_helper::Promise<v8::Local<v8::Value>> promise,
+         std::string device_id, HidDeviceConnection::BatchOptions options,
+         std::vector<device::mojom::HidDeviceInfoPtr> devices) {
+        auto iter = base::ranges::find_if(devices, [&](const auto& device) {
+          return HidChooserController::PhysicalDeviceIdFromDeviceInfo(
+                     *device) == device_id;
+        });
+        if (!context || iter == devices.end()) {
+          promise.RejectWithErrorMessage("Invalid deviceId");
+          return;
+        }
+        mojo::PendingRemote<device::mojom::HidConnectionClient> client;
+        auto client_receiver = client.InitWithNewPipeAndPassReceiver();
+        // The main process is trusted with the protected and FIDO reports.
+        context->GetHidManager()->Connect(
+            (*iter)->guid, std::move(client), /*watcher=*/mojo::NullRemote(),
+            /*allow_protected_reports=*/true, /*allow_fido_reports=*/true,
+            base::BindOnce(
+                [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+                   mojo::PendingReceiver<device::mojom::HidConnectionClient>
+                       client_receiver,
+                   HidDeviceConnection::BatchOptions options,
+                   mojo::PendingRemote<device::mojom::HidConnection>
+                       connection) {
+                  if (!connection) {
+                    promise.RejectWithErrorMessage(
+                        "Failed to open the HID device");
+                    return;
+                  }
+                  v8::Isolate* isolate = promise.isolate();
+                  v8::HandleScope handle_scope(isolate);
+                  promise.Resolve(
+                      HidDeviceConnection::Create(isolate,
+                                                  std::move(connection),
+                                                  std::move(client_receiver),
+                                                  options)
+                          .ToV8());
+                },
+                std::move(promise), std::move(client_receiver), options));
+      },
+      context->AsWeakPtr(), std::move(promise), device_id, batch_options));
+  return handle;
+}
+
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 base::Value Session::GetSpellCheckerLanguages() {
   return browser_context_->prefs()
@@ -1592,9 +2114,14 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
                                  v8::Local<v8::ObjectTemplate> templ) {
   gin::ObjectTemplateBuilder(isolate, GetClassName(), templ)
       .SetMethod("resolveHost", &Session::ResolveHost)
+      .SetMethod("resolveHosts", &Session::ResolveHosts)
       .SetMethod("resolveProxy", &Session::ResolveProxy)
+      .SetMethod("setProxyResolutionOptions",
+                 &Session::SetProxyResolutionOptions)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
       .SetMethod("clearCache", &Session::ClearCache)
+      .SetMethod("getNetworkStats", &Session::GetNetworkStats)
+      .SetMethod("clearNetworkStats", &Session::ClearNetworkStats)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
       .SetMethod("setProxy", &Session::SetProxy)
@@ -1607,6 +2134,8 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
                  &Session::SetPermissionRequestHandler)
       .SetMethod("setPermissionCheckHandler",
                  &Session::SetPermissionCheckHandler)
+      .SetMethod("clearPermissionCheckCache",
+                 &Session::ClearPermissionCheckCache)
       .SetMethod("setDisplayMediaRequestHandler",
                  &Session::SetDisplayMediaRequestHandler)
       .SetMethod("setDevicePermissionHandler",
@@ -1629,8 +2158,11 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
                  &Session::CreateInterruptedDownload)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
+      .SetMethod("setBackgroundThrottlingPolicy",
+                 &Session::SetBackgroundThrottlingPolicy)
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
       .SetMethod("loadExtension", &Session::LoadExtension)
+      .SetMethod("loadExtensions", &Session::LoadExtensions)
       .SetMethod("removeExtension", &Session::RemoveExtension)
       .SetMethod("getExtension", &Session::GetExtension)
       .SetMethod("getAllExtensions", &Session::GetAllExtensions)
@@ -1655,10 +2187,15 @@ void Session::FillObjectTemplate(v8::Isolate* isolate,
 #endif
       .SetMethod("preconnect", &Session::Preconnect)
       .SetMethod("closeAllConnections", &Session::CloseAllConnections)
+      .SetMethod("setRendererProcessPool", &Session::SetRendererProcessPool)
       .SetMethod("getStoragePath", &Session::GetPath)
       .SetMethod("setCodeCachePath", &Session::SetCodeCachePath)
       .SetMethod("clearCodeCaches", &Session::ClearCodeCaches)
       .SetMethod("clearData", &Session::ClearData)
+      .SetMethod("getSerialPorts", &Session::GetSerialPorts)
+      .SetMethod("openSerialPort", &Session::OpenSerialPort)
+      .SetMethod("getHidDevices", &Session::GetHidDevices)
+      .SetMethod("openHidDevice", &Session::OpenHidDevice)
       .SetProperty("cookies", &Session::Cookies)
       .SetProperty("netLog", &Session::NetLog)
       .SetProperty("protocol", &Session::Protocol)
@@ -1678,6 +2215,30 @@ namespace {
 
 using electron::api::Session;
 
+// Checks the cache option of fromPartition() and fromPath(), which is either
+// a boolean or an object.
+bool CheckCacheOptions(const base::Value::Dict& options, gin::Arguments* args) {
+  const base::Value* cache = options.Find("cache");
+  if (!cache || cache->is_bool())
+    return true;
+  if (!cache->is_dict()) {
+    args->ThrowTypeError("cache must be a boolean or an object");
+    return false;
+  }
+  const base::Value* max_size = cache->GetDict().Find("maxSize");
+  if (max_size && (!max_size->is_int() || max_size->GetInt() < 0)) {
+    args->ThrowTypeError("cache.maxSize must be a non-negative integer");
+    return false;
+  }
+  const std::string* backend = cache->GetDict().FindString("backend");
+  if (cache->GetDict().contains("backend") &&
+      (!backend || (*backend != "disk" && *backend != "memory"))) {
+    args->ThrowTypeError("cache.backend must be 'disk' or 'memory'");
+    return false;
+  }
+  return true;
+}
+
 v8::Local<v8::Value> FromPartition(const std::string& partition,
                                    gin::Arguments* args) {
   if (!electron::Browser::Get()->is_ready()) {
@@ -1686,6 +2247,8 @@ v8::Local<v8::Value> FromPartition(const std::string& partition,
   }
   base::Value::Dict options;
   args->GetNext(&options);
+  if (!CheckCacheOptions(options, args))
+    return v8::Null(args->isolate());
   return Session::FromPartition(args->isolate(), partition, std::move(options))
       .ToV8();
 }
@@ -1698,6 +2261,8 @@ v8::Local<v8::Value> FromPath(const base::FilePath& path,
   }
   base::Value::Dict options;
   args->GetNext(&options);
+  if (!CheckCacheOptions(options, args))
+    return v8::Null(args->isolate());
   std::optional<gin::Handle<Session>> session_handle =
       Session::FromPath(args->isolate(), path, std::move(options));
 
@@ -104,8 +104,13 @@ class Session : public gin::Wrappable<Session>,
       std::string host,
       std::optional<network::mojom::ResolveHostParametersPtr> params);
   v8::Local<v8::Promise> ResolveProxy(gin::Arguments* args);
+  v8::Local<v8::Promise> ResolveHosts(gin::Arguments* args);
+  void SetProxyResolutionOptions(gin_helper::ErrorThrower thrower,
+                                 const gin_helper::Dictionary& options);
   v8::Local<v8::Promise> GetCacheSize();
   v8::Local<v8::Promise> ClearCache();
+  v8::Local<v8::Value> GetNetworkStats(v8::Isolate* isolate);
+  void ClearNetworkStats();
   v8::Local<v8::Promise> ClearStorageData(gin::Arguments* args);
   void FlushStorageData();
   v8::Local<v8::Promise> SetProxy(gin::Arguments* args);
@@ -118,6 +123,7 @@ class Session : public gin::Wrappable<Session>,
                                    gin::Arguments* args);
   void SetPermissionCheckHandler(v8::Local<v8::Value> val,
                                  gin::Arguments* args);
+  void ClearPermissionCheckCache();
   void SetDevicePermissionHandler(v8::Local<v8::Value> val,
                                   gin::Arguments* args);
   void SetUSBProtectedClassesHandler(v8::Local<v8::Value> val,
@@ -137,6 +143,7 @@ class Session : public gin::Wrappable<Session>,
   void CreateInterruptedDownload(const gin_helper::Dictionary& options);
   void SetPreloads(const std::vector<base::FilePath>& preloads);
   std::vector<base::FilePath> GetPreloads() const;
+  void SetBackgroundThrottlingPolicy(gin::Arguments* args);
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
   v8::Local<v8::Value> Protocol(v8::Isolate* isolate);
   v8::Local<v8::Value> ServiceWorkerContext(v8::Isolate* isolate);
@@ -144,11 +151,17 @@ class Session : public gin::Wrappable<Session>,
   v8::Local<v8::Value> NetLog(v8::Isolate* isolate);
   void Preconnect(const gin_helper::Dictionary& options, gin::Arguments* args);
   v8::Local<v8::Promise> CloseAllConnections();
+  void SetRendererProcessPool(const gin_helper::Dictionary& options,
+                              gin::Arguments* args);
   v8::Local<v8::Value> GetPath(v8::Isolate* isolate);
   void SetCodeCachePath(gin::Arguments* args);
   v8::Local<v8::Promise> ClearCodeCaches(const gin_helper::Dictionary& options);
   v8::Local<v8::Value> ClearData(gin_helper::ErrorThrower thrower,
                                  gin::Arguments* args);
+  v8::Local<v8::Promise> GetSerialPorts();
+  v8::Local<v8::Promise> OpenSerialPort(gin::Arguments* args);
+  v8::Local<v8::Promise> GetHidDevices();
+  v8::Local<v8::Promise> OpenHidDevice(gin::Arguments* args);
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   base::Value GetSpellCheckerLanguages();
   void SetSpellCheckerLanguages(gin_helper::ErrorThrower thrower,
@@ -163,6 +176,9 @@ class Session : public gin::Wrappable<Session>,
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   v8::Local<v8::Promise> LoadExtension(const base::FilePath& extension_path,
                                        gin::Arguments* args);
+  v8::Local<v8::Promise> LoadExtensions(
+      const std::vector<base::FilePath>& extension_paths,
+      gin::Arguments* args);
   void RemoveExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetAllExtensions();
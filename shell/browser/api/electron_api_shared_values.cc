@@ -0,0 +1,86 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "shell/browser/shared_buffer_broker.h"
+#include "shell/browser/shared_value_store.h"
+#include "shell/common/gin_converters/gurl_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/node_includes.h"
+#include "shell/common/v8_value_serializer.h"
+#include "third_party/blink/public/common/messaging/cloneable_message.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace {
+
+void SetSharedValue(v8::Isolate* isolate,
+                    const std::string& key,
+                    v8::Local<v8::Value> value) {
+  blink::CloneableMessage message;
+  if (!electron::SerializeV8Value(isolate, value, &message)) {
+    // SerializeV8Value sets an exception.
+    return;
+  }
+  electron::SharedValueStore::GetInstance()->Set(
+      key, std::vector<uint8_t>(message.encoded_message.begin(),
+                                message.encoded_message.end()));
+}
+
+void DeleteSharedValue(const std::string& key) {
+  electron::SharedValueStore::GetInstance()->Delete(key);
+}
+
+void SetSharedBuffer(gin_helper::ErrorThrower thrower,
+                     const std::string& name,
+                     v8::Local<v8::Value> data,
+                     const std::vector<GURL>& origins) {
+  if (!node::Buffer::HasInstance(data)) {
+    thrower.ThrowTypeError("data must be an ArrayBuffer or an ArrayBufferView");
+    return;
+  }
+  if (node::Buffer::Length(data) == 0) {
+    thrower.ThrowTypeError("data must not be empty");
+    return;
+  }
+  std::vector<url::Origin> allowed_origins;
+  for (const GURL& url : origins) {
+    url::Origin origin = url::Origin::Create(url);
+    if (origin.opaque()) {
+      thrower.ThrowTypeError("Invalid origin: " + url.possibly_invalid_spec());
+      return;
+    }
+    allowed_origins.push_back(std::move(origin));
+  }
+  const auto bytes = base::span(
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(data)),
+      node::Buffer::Length(data));
+  if (!electron::SharedBufferBroker::GetInstance()->Set(
+          name, bytes, std::move(allowed_origins)))
+    thrower.ThrowError("Failed to allocate shared memory for the buffer");
+}
+
+void DeleteSharedBuffer(const std::string& name) {
+  electron::SharedBufferBroker::GetInstance()->Delete(name);
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("setSharedValue", &SetSharedValue);
+  dict.SetMethod("deleteSharedValue", &DeleteSharedValue);
+  dict.SetMethod("setSharedBuffer", &SetSharedBuffer);
+  dict.SetMethod("deleteSharedBuffer", &DeleteSharedBuffer);
+}
+
+}  // namespace
+
+NODE_LINKED_BINDING_CONTEXT_AWARE(electron_browser_shared_values, Initialize)
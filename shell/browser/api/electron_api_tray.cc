@@ -70,6 +70,11 @@ gin::Handle<Tray> Tray::New(gin_helper::ErrorThrower thrower,
     return gin::Handle<Tray>();
   }
 
+  if (Browser::IsHeadless()) {
+    thrower.ThrowError("Cannot create Tray in headless server mode");
+    return gin::Handle<Tray>();
+  }
+
 #if BUILDFLAG(IS_WIN)
   if (!guid.has_value() && args->Length() > 1) {
     thrower.ThrowError("Invalid GUID format");
@@ -203,6 +208,7 @@ void Tray::SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
   if (!NativeImage::TryConvertNativeImage(isolate, image, &native_image))
     return;
 
+  image_index_.reset();
 #if BUILDFLAG(IS_WIN)
   tray_icon_->SetImage(native_image->GetHICON(GetSystemMetrics(SM_CXSMICON)));
 #else
@@ -226,6 +232,51 @@ void Tray::SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
 #endif
 }
 
+void Tray::SetImageSet(gin_helper::ErrorThrower thrower,
+                       const std::vector<v8::Local<v8::Value>>& images) {
+  if (!CheckAlive())
+    return;
+
+  v8::Isolate* isolate = thrower.isolate();
+  TrayIcon::ImageSet image_set;
+  std::vector<v8::Global<v8::Object>> wrappers;
+  for (const auto& image : images) {
+    NativeImage* native_image = nullptr;
+    if (!NativeImage::TryConvertNativeImage(isolate, image, &native_image))
+      return;
+
+    v8::Local<v8::Object> wrapper;
+    if (native_image->GetWrapper(isolate).ToLocal(&wrapper))
+      wrappers.emplace_back(isolate, wrapper);
+#if BUILDFLAG(IS_WIN)
+    image_set.push_back(native_image->GetHICON(GetSystemMetrics(SM_CXSMICON)));
+#else
+    image_set.push_back(native_image->image());
+#endif
+  }
+
+  image_set_ = std::move(wrappers);
+  image_index_.reset();
+  tray_icon_->SetImageSet(std::move(image_set));
+}
+
+void Tray::SetImageIndex(gin_helper::ErrorThrower thrower, uint32_t index) {
+  if (!CheckAlive())
+    return;
+
+  if (index >= image_set_.size()) {
+    thrower.ThrowRangeError("index is out of the range of the image set");
+    return;
+  }
+
+  // Switching to the current image is a no-op, which is common when the
+  // icon is animated on a timer.
+  if (image_index_ == index)
+    return;
+  image_index_ = index;
+  tray_icon_->SetImageFromSet(index);
+}
+
 void Tray::SetToolTip(const std::string& tool_tip) {
   if (!CheckAlive())
     return;
@@ -410,6 +461,8 @@ void Tray::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("isDestroyed", &Tray::IsDestroyed)
       .SetMethod("setImage", &Tray::SetImage)
       .SetMethod("setPressedImage", &Tray::SetPressedImage)
+      .SetMethod("setImageSet", &Tray::SetImageSet)
+      .SetMethod("setImageIndex", &Tray::SetImageIndex)
       .SetMethod("setToolTip", &Tray::SetToolTip)
       .SetMethod("setTitle", &Tray::SetTitle)
       .SetMethod("getTitle", &Tray::GetTitle)
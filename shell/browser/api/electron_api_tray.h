@@ -91,6 +91,9 @@ class Tray : public gin::Wrappable<Tray>,
   bool IsDestroyed();
   void SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
   void SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
+  void SetImageSet(gin_helper::ErrorThrower thrower,
+                   const std::vector<v8::Local<v8::Value>>& images);
+  void SetImageIndex(gin_helper::ErrorThrower thrower, uint32_t index);
   void SetToolTip(const std::string& tool_tip);
   void SetTitle(const std::string& title,
                 const std::optional<gin_helper::Dictionary>& options,
@@ -111,6 +114,10 @@ class Tray : public gin::Wrappable<Tray>,
   bool CheckAlive();
 
   v8::Global<v8::Value> menu_;
+  // The images of the image set are kept alive, on Windows their icons are
+  // owned by the NativeImage.
+  std::vector<v8::Global<v8::Object>> image_set_;
+  std::optional<uint32_t> image_index_;
   std::unique_ptr<TrayIcon> tray_icon_;
 };
 
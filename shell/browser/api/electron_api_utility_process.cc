@@ -5,31 +5,51 @@
 #include "shell/browser/api/electron_api_utility_process.h"
 
 #include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
+#include "base/containers/fixed_flat_map.h"
+#include "base/files/file.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/no_destructor.h"
 #include "base/process/kill.h"
 #include "base/process/launch.h"
 #include "base/process/process.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
 #include "chrome/browser/browser_process.h"
+#include "content/public/browser/browser_child_process_host.h"
 #include "content/public/browser/child_process_host.h"
 #include "content/public/browser/service_process_host.h"
 #include "content/public/common/result_codes.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/net/system_network_context_manager.h"
+#include "shell/browser/protocol_registry.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
+#include "shell/services/node/shared_buffer.h"
 #include "third_party/blink/public/common/messaging/message_port_descriptor.h"
 #include "third_party/blink/public/common/messaging/transferable_message_mojom_traits.h"
 
@@ -37,12 +57,37 @@
 #include "base/posix/eintr_wrapper.h"
 #endif
 
+#if BUILDFLAG(IS_LINUX)
+#include <sched.h>
+#endif
+
 #if BUILDFLAG(IS_WIN)
 #include <fcntl.h>
 #include <io.h>
 #include "base/win/windows_types.h"
 #endif
 
+namespace gin {
+
+template <>
+struct Converter<base::Process::Priority> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     base::Process::Priority* out) {
+    return FromV8WithLookup(isolate, val, Lookup, out);
+  }
+
+ private:
+  static constexpr auto Lookup =
+      base::MakeFixedFlatMap<std::string_view, base::Process::Priority>({
+          {"background", base::Process::Priority::kBestEffort},
+          {"user-interactive", base::Process::Priority::kUserBlocking},
+          {"utility", base::Process::Priority::kUserVisible},
+      });
+};
+
+}  // namespace gin
+
 namespace electron {
 
 base::IDMap<api::UtilityProcessWrapper*, base::ProcessId>&
@@ -53,6 +98,118 @@ GetAllUtilityProcessWrappers() {
   return *s_all_utility_process_wrappers;
 }
 
+namespace {
+
+constexpr char16_t kDefaultDisplayName[] = u"Node Utility Process";
+
+// A utility process launched ahead of fork(), with its isolate and Node.js
+// initialized, waiting for the script to run.
+class PrewarmedProcess {
+ public:
+  PrewarmedProcess() {
+    content::ServiceProcessHost::Launch(
+        remote_.BindNewPipeAndPassReceiver(),
+        content::ServiceProcessHost::Options()
+            .WithDisplayName(kDefaultDisplayName)
+            .WithProcessCallback(
+                base::BindOnce(&PrewarmedProcess::OnServiceProcessLaunched,
+                               weak_factory_.GetWeakPtr()))
+            .Pass());
+    remote_.set_disconnect_handler(base::BindOnce(
+        &PrewarmedProcess::OnServiceProcessDisconnected,
+        base::Unretained(this)));
+    remote_->Prewarm();
+  }
+
+  // disable copy
+  PrewarmedProcess(const PrewarmedProcess&) = delete;
+  PrewarmedProcess& operator=(const PrewarmedProcess&) = delete;
+
+  bool is_ready() const { return process_.IsValid() && remote_.is_connected(); }
+  base::Process TakeProcess() { return std::move(process_); }
+  mojo::Remote<node::mojom::NodeService> TakeRemote() {
+    return std::move(remote_);
+  }
+
+ private:
+  void OnServiceProcessLaunched(const base::Process& process) {
+    process_ = process.Duplicate();
+  }
+
+  void OnServiceProcessDisconnected();
+
+  base::Process process_;
+  mojo::Remote<node::mojom::NodeService> remote_;
+  base::WeakPtrFactory<PrewarmedProcess> weak_factory_{this};
+};
+
+struct PrewarmedProcesses {
+  size_t count = 0;
+  std::vector<std::unique_ptr<PrewarmedProcess>> processes;
+};
+
+PrewarmedProcesses& GetPrewarmedProcesses() {
+  static base::NoDestructor<PrewarmedProcesses> prewarmed;
+  return *prewarmed;
+}
+
+void PrewarmedProcess::OnServiceProcessDisconnected() {
+  // Processes that go away are not relaunched until the next fork(), so
+  // one that fails to start doesn't relaunch in a loop. Deletes this.
+  auto& processes = GetPrewarmedProcesses().processes;
+  std::erase_if(processes, [this](const auto& process) {
+    return process.get() == this;
+  });
+}
+
+void FillPrewarmedProcesses() {
+  auto& prewarmed = GetPrewarmedProcesses();
+  if (prewarmed.processes.size() > prewarmed.count)
+    prewarmed.processes.resize(prewarmed.count);
+  while (prewarmed.processes.size() < prewarmed.count)
+    prewarmed.processes.push_back(std::make_unique<PrewarmedProcess>());
+}
+
+void SetPrewarmedProcessCount(uint32_t count) {
+  GetPrewarmedProcesses().count = count;
+  FillPrewarmedProcesses();
+}
+
+// Returns a prewarmed process when the launch options of fork() are those
+// the processes were launched with.
+std::unique_ptr<PrewarmedProcess> TakePrewarmedProcess(
+    const std::vector<std::string>& exec_args,
+    const std::u16string& display_name,
+    const std::map<api::UtilityProcessWrapper::IOHandle,
+                   api::UtilityProcessWrapper::IOType>& stdio,
+    const base::EnvironmentMap& env_map,
+    const base::FilePath& current_working_directory,
+    bool use_plugin_helper) {
+  using IOHandle = api::UtilityProcessWrapper::IOHandle;
+  using IOType = api::UtilityProcessWrapper::IOType;
+  if (!exec_args.empty() || !display_name.empty() || !env_map.empty() ||
+      !current_working_directory.empty() || use_plugin_helper)
+    return nullptr;
+  // stdin is never passed to the child.
+  for (const auto& [io_handle, io_type] : stdio) {
+    if (io_handle != IOHandle::STDIN && io_type != IOType::IO_INHERIT)
+      return nullptr;
+  }
+
+  auto& processes = GetPrewarmedProcesses().processes;
+  auto it = base::ranges::find_if(
+      processes, [](const auto& process) { return process->is_ready(); });
+  if (it == processes.end())
+    return nullptr;
+  std::unique_ptr<PrewarmedProcess> process = std::move(*it);
+  processes.erase(it);
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(&FillPrewarmedProcesses));
+  return process;
+}
+
+}  // namespace
+
 namespace api {
 
 gin::WrapperInfo UtilityProcessWrapper::kWrapperInfo = {
@@ -64,6 +221,70 @@ UtilityProcessWrapper::UtilityProcessWrapper(
     std::map<IOHandle, IOType> stdio,
     base::EnvironmentMap env_map,
     base::FilePath current_working_directory,
+    bool use_plugin_helper,
+    std::optional<base::Process::Priority> priority,
+    std::vector<uint32_t> cpu_affinity)
+    : priority_(priority), cpu_affinity_(std::move(cpu_affinity)) {
+  if (auto prewarmed = TakePrewarmedProcess(params->exec_args, display_name,
+                                            stdio, env_map,
+                                            current_working_directory,
+                                            use_plugin_helper)) {
+    node_service_remote_ = prewarmed->TakeRemote();
+    // 'spawn' is emitted after fork() returned, like for other processes.
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&UtilityProcessWrapper::OnServiceProcessSpawned,
+                       weak_factory_.GetWeakPtr(), prewarmed->TakeProcess()));
+  } else if (!LaunchServiceProcess(params->exec_args, display_name,
+                                   std::move(stdio), env_map,
+                                   current_working_directory,
+                                   use_plugin_helper)) {
+    return;
+  }
+  node_service_remote_.set_disconnect_with_reason_handler(
+      base::BindOnce(&UtilityProcessWrapper::OnServiceProcessDisconnected,
+                     weak_factory_.GetWeakPtr()));
+
+  // We use a separate message pipe to support postMessage API
+  // instead of the existing receiver interface so that we can
+  // support queuing of messages without having to block other
+  // interfaces.
+  blink::MessagePortDescriptorPair pipe;
+  host_port_ = pipe.TakePort0();
+  params->port = pipe.TakePort1();
+  connector_ = std::make_unique<mojo::Connector>(
+      host_port_.TakeHandleToEntangleWithEmbedder(),
+      mojo::Connector::SINGLE_THREADED_SEND,
+      base::SingleThreadTaskRunner::GetCurrentDefault());
+  connector_->set_incoming_receiver(this);
+  connector_->set_connection_error_handler(base::BindOnce(
+      &UtilityProcessWrapper::CloseConnectorPort, weak_factory_.GetWeakPtr()));
+
+  mojo::PendingRemote<network::mojom::URLLoaderFactory> url_loader_factory;
+  network::mojom::URLLoaderFactoryParamsPtr loader_params =
+      network::mojom::URLLoaderFactoryParams::New();
+  loader_params->process_id = pid_;
+  loader_params->is_orb_enabled = false;
+  loader_params->is_trusted = true;
+  network::mojom::NetworkContext* network_context =
+      g_browser_process->system_network_context_manager()->GetContext();
+  network_context->CreateURLLoaderFactory(
+      url_loader_factory.InitWithNewPipeAndPassReceiver(),
+      std::move(loader_params));
+  params->url_loader_factory = std::move(url_loader_factory);
+  mojo::PendingRemote<network::mojom::HostResolver> host_resolver;
+  network_context->CreateHostResolver(
+      {}, host_resolver.InitWithNewPipeAndPassReceiver());
+  params->host_resolver = std::move(host_resolver);
+  node_service_remote_->Initialize(std::move(params));
+}
+
+bool UtilityProcessWrapper::LaunchServiceProcess(
+    const std::vector<std::string>& exec_args,
+    const std::u16string& display_name,
+    std::map<IOHandle, IOType> stdio,
+    const base::EnvironmentMap& env_map,
+    const base::FilePath& current_working_directory,
     bool use_plugin_helper) {
 #if BUILDFLAG(IS_WIN)
   base::win::ScopedHandle stdout_write(nullptr);
@@ -88,7 +309,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       // https://source.chromium.org/chromium/chromium/src/+/main:base/process/launch_win.cc;l=303-332
       if (!::CreatePipe(&read, &write, nullptr, 0)) {
         PLOG(ERROR) << "pipe creation failed";
-        return;
+        return false;
       }
       if (io_handle == IOHandle::STDOUT) {
         stdout_write.Set(write);
@@ -105,7 +326,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       int pipe_fd[2];
       if (HANDLE_EINTR(pipe(pipe_fd)) < 0) {
         PLOG(ERROR) << "pipe creation failed";
-        return;
+        return false;
       }
       if (io_handle == IOHandle::STDOUT) {
         fds_to_remap.emplace_back(pipe_fd[1], STDOUT_FILENO);
@@ -123,7 +344,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
                       OPEN_EXISTING, 0, nullptr);
       if (handle == INVALID_HANDLE_VALUE) {
         PLOG(ERROR) << "Failed to create null handle";
-        return;
+        return false;
       }
       if (io_handle == IOHandle::STDOUT) {
         stdout_write.Set(handle);
@@ -134,7 +355,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       int devnull = open("/dev/null", O_WRONLY);
       if (devnull < 0) {
         PLOG(ERROR) << "failed to open /dev/null";
-        return;
+        return false;
       }
       if (io_handle == IOHandle::STDOUT) {
         fds_to_remap.emplace_back(devnull, STDOUT_FILENO);
@@ -152,9 +373,9 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       std::move(receiver),
       content::ServiceProcessHost::Options()
           .WithDisplayName(display_name.empty()
-                               ? std::u16string(u"Node Utility Process")
+                               ? std::u16string(kDefaultDisplayName)
                                : display_name)
-          .WithExtraCommandLineSwitches(params->exec_args)
+          .WithExtraCommandLineSwitches(exec_args)
           .WithCurrentDirectory(current_working_directory)
           // Inherit parent process environment when there is no custom
           // environment provided by the user.
@@ -175,42 +396,7 @@ UtilityProcessWrapper::UtilityProcessWrapper(
               base::BindOnce(&UtilityProcessWrapper::OnServiceProcessLaunched,
                              weak_factory_.GetWeakPtr()))
           .Pass());
-  node_service_remote_.set_disconnect_with_reason_handler(
-      base::BindOnce(&UtilityProcessWrapper::OnServiceProcessDisconnected,
-                     weak_factory_.GetWeakPtr()));
-
-  // We use a separate message pipe to support postMessage API
-  // instead of the existing receiver interface so that we can
-  // support queuing of messages without having to block other
-  // interfaces.
-  blink::MessagePortDescriptorPair pipe;
-  host_port_ = pipe.TakePort0();
-  params->port = pipe.TakePort1();
-  connector_ = std::make_unique<mojo::Connector>(
-      host_port_.TakeHandleToEntangleWithEmbedder(),
-      mojo::Connector::SINGLE_THREADED_SEND,
-      base::SingleThreadTaskRunner::GetCurrentDefault());
-  connector_->set_incoming_receiver(this);
-  connector_->set_connection_error_handler(base::BindOnce(
-      &UtilityProcessWrapper::CloseConnectorPort, weak_factory_.GetWeakPtr()));
-
-  mojo::PendingRemote<network::mojom::URLLoaderFactory> url_loader_factory;
-  network::mojom::URLLoaderFactoryParamsPtr loader_params =
-      network::mojom::URLLoaderFactoryParams::New();
-  loader_params->process_id = pid_;
-  loader_params->is_orb_enabled = false;
-  loader_params->is_trusted = true;
-  network::mojom::NetworkContext* network_context =
-      g_browser_process->system_network_context_manager()->GetContext();
-  network_context->CreateURLLoaderFactory(
-      url_loader_factory.InitWithNewPipeAndPassReceiver(),
-      std::move(loader_params));
-  params->url_loader_factory = std::move(url_loader_factory);
-  mojo::PendingRemote<network::mojom::HostResolver> host_resolver;
-  network_context->CreateHostResolver(
-      {}, host_resolver.InitWithNewPipeAndPassReceiver());
-  params->host_resolver = std::move(host_resolver);
-  node_service_remote_->Initialize(std::move(params));
+  return true;
 }
 
 UtilityProcessWrapper::~UtilityProcessWrapper() = default;
@@ -218,8 +404,20 @@ UtilityProcessWrapper::~UtilityProcessWrapper() = default;
 void UtilityProcessWrapper::OnServiceProcessLaunched(
     const base::Process& process) {
   DCHECK(node_service_remote_.is_connected());
-  pid_ = process.Pid();
+  OnServiceProcessSpawned(process.Duplicate());
+}
+
+void UtilityProcessWrapper::OnServiceProcessSpawned(base::Process process) {
+  // A prewarmed process can go away before the task that reports it runs.
+  if (!node_service_remote_.is_connected())
+    return;
+  process_ = std::move(process);
+  pid_ = process_.Pid();
   GetAllUtilityProcessWrappers().AddWithID(this, pid_);
+  if (priority_)
+    SetPriority(*priority_);
+  if (!cpu_affinity_.empty())
+    SetCPUAffinity(cpu_affinity_);
   if (stdout_read_fd_ != -1) {
     EmitWithoutEvent("stdout", stdout_read_fd_);
   }
@@ -264,24 +462,23 @@ void UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
   if (!node_service_remote_.is_connected())
     return;
 
-  blink::TransferableMessage transferable_message;
-  v8::Local<v8::Value> message_value;
-  if (args->GetNext(&message_value)) {
-    if (!electron::SerializeV8Value(args->isolate(), message_value,
-                                    &transferable_message)) {
-      // SerializeV8Value sets an exception.
-      return;
-    }
-  }
+  v8::Local<v8::Value> message_value = v8::Undefined(args->isolate());
+  args->GetNext(&message_value);
 
   v8::Local<v8::Value> transferables;
   std::vector<gin::Handle<MessagePort>> wrapped_ports;
-  if (args->GetNext(&transferables)) {
-    if (!gin::ConvertFromV8(args->isolate(), transferables, &wrapped_ports)) {
-      gin_helper::ErrorThrower(args->isolate())
-          .ThrowTypeError("Invalid value for transfer");
-      return;
-    }
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (args->GetNext(&transferables) &&
+      !MessagePort::GetTransferables(args->isolate(), transferables,
+                                     &wrapped_ports, &array_buffers)) {
+    return;
+  }
+
+  blink::TransferableMessage transferable_message;
+  if (!electron::SerializeV8Value(args->isolate(), message_value,
+                                  array_buffers, &transferable_message)) {
+    // SerializeV8Value sets an exception.
+    return;
   }
 
   bool threw_exception = false;
@@ -295,6 +492,195 @@ void UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
   connector_->Accept(&mojo_message);
 }
 
+bool UtilityProcessWrapper::SetPriority(base::Process::Priority priority) {
+  if (!process_.IsValid())
+    return false;
+#if BUILDFLAG(IS_MAC)
+  return process_.SetPriority(
+      content::BrowserChildProcessHost::GetPortProvider(), priority);
+#else
+  return process_.SetPriority(priority);
+#endif
+}
+
+bool UtilityProcessWrapper::SetCPUAffinity(const std::vector<uint32_t>& cpus) {
+  if (!process_.IsValid() || cpus.empty())
+    return false;
+#if BUILDFLAG(IS_WIN)
+  DWORD_PTR mask = 0;
+  for (uint32_t cpu : cpus) {
+    if (cpu >= sizeof(mask) * 8)
+      return false;
+    mask |= DWORD_PTR{1} << cpu;
+  }
+  return ::SetProcessAffinityMask(process_.Handle(), mask);
+#elif BUILDFLAG(IS_LINUX)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (uint32_t cpu : cpus) {
+    if (cpu >= CPU_SETSIZE)
+      return false;
+    CPU_SET(cpu, &set);
+  }
+  // The affinity is per thread on Linux, each thread of the process is given
+  // the mask and those it starts later inherit it.
+  base::FileEnumerator tasks(base::FilePath("/proc")
+                                 .Append(base::NumberToString(pid_))
+                                 .Append("task"),
+                             false, base::FileEnumerator::DIRECTORIES);
+  bool result = false;
+  for (base::FilePath task = tasks.Next(); !task.empty(); task = tasks.Next()) {
+    pid_t tid;
+    if (base::StringToInt(task.BaseName().value(), &tid) &&
+        sched_setaffinity(tid, sizeof(set), &set) == 0) {
+      result = true;
+    }
+  }
+  return result;
+#else
+  return false;
+#endif
+}
+
+v8::Local<v8::Promise> UtilityProcessWrapper::StartCpuProfiling(
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node_service_remote_.is_connected()) {
+    promise.RejectWithErrorMessage("The process is not running");
+    return handle;
+  }
+
+  int sampling_interval = 1000;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval <= 0) {
+    promise.RejectWithErrorMessage(
+        "samplingInterval must be a positive number");
+    return handle;
+  }
+
+  node_service_remote_->StartCpuProfiling(
+      base::Microseconds(sampling_interval),
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](gin_helper::Promise<void> promise, bool success) {
+                if (success)
+                  promise.Resolve();
+                else
+                  promise.RejectWithErrorMessage(
+                      "Failed to start CPU profiling");
+              },
+              std::move(promise)),
+          false));
+  return handle;
+}
+
+v8::Local<v8::Promise> UtilityProcessWrapper::StopCpuProfiling(
+    v8::Isolate* isolate,
+    const base::FilePath& file_path) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node_service_remote_.is_connected()) {
+    promise.RejectWithErrorMessage("The process is not running");
+    return handle;
+  }
+
+  base::File file;
+  {
+    ScopedAllowBlockingForElectron allow_blocking;
+    file = base::File(file_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  }
+  if (!file.IsValid()) {
+    promise.RejectWithErrorMessage("Failed to open the profile file");
+    return handle;
+  }
+
+  node_service_remote_->StopCpuProfiling(
+      std::move(file),
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          base::BindOnce(
+              [](gin_helper::Promise<void> promise, bool success) {
+                if (success)
+                  promise.Resolve();
+                else
+                  promise.RejectWithErrorMessage(
+                      "Failed to write the CPU profile");
+              },
+              std::move(promise)),
+          false));
+  return handle;
+}
+
+v8::Local<v8::Value> UtilityProcessWrapper::CreateSharedBuffer(
+    gin::Arguments* args) {
+  std::string name;
+  int64_t capacity = 0;
+  if (!args->GetNext(&name) || !args->GetNext(&capacity) || capacity <= 0) {
+    args->ThrowTypeError("Expected a name and a positive capacity");
+    return v8::Undefined(args->isolate());
+  }
+  if (!node_service_remote_.is_connected()) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError("The process is not running");
+    return v8::Undefined(args->isolate());
+  }
+
+  base::UnsafeSharedMemoryRegion region =
+      SharedBuffer::CreateRegion(static_cast<size_t>(capacity));
+  base::UnsafeSharedMemoryRegion utility_region = region.Duplicate();
+  if (!utility_region.IsValid()) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError("Failed to allocate the shared buffer");
+    return v8::Undefined(args->isolate());
+  }
+
+  // Each end calls the other through a pipe of its own.
+  mojo::PendingRemote<node::mojom::SharedBufferPeer> parent_remote;
+  auto parent_receiver = parent_remote.InitWithNewPipeAndPassReceiver();
+  mojo::PendingRemote<node::mojom::SharedBufferPeer> utility_remote;
+  auto utility_receiver = utility_remote.InitWithNewPipeAndPassReceiver();
+  gin::Handle<SharedBuffer> buffer = SharedBuffer::Create(
+      args->isolate(), std::move(region), /*is_parent=*/true,
+      std::move(utility_remote), std::move(parent_receiver));
+  if (buffer.IsEmpty()) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError("Failed to allocate the shared buffer");
+    return v8::Undefined(args->isolate());
+  }
+  node_service_remote_->ShareBuffer(name, std::move(utility_region),
+                                    std::move(parent_remote),
+                                    std::move(utility_receiver));
+  return buffer.ToV8();
+}
+
+void UtilityProcessWrapper::HandleProtocol(gin::Arguments* args) {
+  std::string scheme;
+  Session* session = nullptr;
+  if (!args->GetNext(&scheme) || !args->GetNext(&session) || !session) {
+    args->ThrowTypeError("Expected a scheme and a session");
+    return;
+  }
+  if (!node_service_remote_.is_connected()) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError("The process is not running");
+    return;
+  }
+
+  mojo::PendingRemote<network::mojom::URLLoaderFactory> factory;
+  auto receiver = factory.InitWithNewPipeAndPassReceiver();
+  auto* protocol_registry =
+      ProtocolRegistry::FromBrowserContext(session->browser_context());
+  if (!protocol_registry->RegisterProtocolFactory(scheme, std::move(factory))) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError("Failed to register protocol: " + scheme);
+    return;
+  }
+  node_service_remote_->HandleProtocol(scheme, std::move(receiver));
+}
+
 bool UtilityProcessWrapper::Kill() const {
   if (pid_ == base::kNullProcessId)
     return false;
@@ -354,6 +740,8 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
   std::map<IOHandle, IOType> stdio;
   base::FilePath current_working_directory;
   base::EnvironmentMap env_map;
+  std::optional<base::Process::Priority> priority;
+  std::vector<uint32_t> cpu_affinity;
   node::mojom::NodeServiceParamsPtr params =
       node::mojom::NodeServiceParams::New();
   dict.Get("modulePath", &params->script);
@@ -377,6 +765,20 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
     opts.Get("serviceName", &display_name);
     opts.Get("cwd", &current_working_directory);
 
+    base::Process::Priority process_priority;
+    if (opts.Has("priority")) {
+      if (!opts.Get("priority", &process_priority)) {
+        args->ThrowTypeError("Invalid value for priority");
+        return gin::Handle<UtilityProcessWrapper>();
+      }
+      priority = process_priority;
+    }
+
+    if (opts.Has("cpuAffinity") && !opts.Get("cpuAffinity", &cpu_affinity)) {
+      args->ThrowTypeError("Invalid value for cpuAffinity");
+      return gin::Handle<UtilityProcessWrapper>();
+    }
+
     std::vector<std::string> stdio_arr{"ignore", "inherit", "inherit"};
     opts.Get("stdio", &stdio_arr);
     for (size_t i = 0; i < 3; i++) {
@@ -399,7 +801,8 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
       args->isolate(),
       new UtilityProcessWrapper(std::move(params), display_name,
                                 std::move(stdio), env_map,
-                                current_working_directory, use_plugin_helper));
+                                current_working_directory, use_plugin_helper,
+                                priority, std::move(cpu_affinity)));
   handle->Pin(args->isolate());
   return handle;
 }
@@ -411,6 +814,13 @@ gin::ObjectTemplateBuilder UtilityProcessWrapper::GetObjectTemplateBuilder(
              UtilityProcessWrapper>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &UtilityProcessWrapper::PostMessage)
       .SetMethod("kill", &UtilityProcessWrapper::Kill)
+      .SetMethod("startCpuProfiling", &UtilityProcessWrapper::StartCpuProfiling)
+      .SetMethod("stopCpuProfiling", &UtilityProcessWrapper::StopCpuProfiling)
+      .SetMethod("createSharedBuffer",
+                 &UtilityProcessWrapper::CreateSharedBuffer)
+      .SetMethod("handleProtocol", &UtilityProcessWrapper::HandleProtocol)
+      .SetMethod("setPriority", &UtilityProcessWrapper::SetPriority)
+      .SetMethod("setCPUAffinity", &UtilityProcessWrapper::SetCPUAffinity)
       .SetProperty("pid", &UtilityProcessWrapper::GetOSProcessId);
 }
 
@@ -431,6 +841,8 @@ void Initialize(v8::Local<v8::Object> exports,
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary dict(isolate, exports);
   dict.SetMethod("_fork", &electron::api::UtilityProcessWrapper::Create);
+  dict.SetMethod("_setPrewarmedProcessCount",
+                 &electron::SetPrewarmedProcessCount);
 }
 
 }  // namespace
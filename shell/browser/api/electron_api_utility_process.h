@@ -7,11 +7,14 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "base/containers/id_map.h"
 #include "base/environment.h"
 #include "base/memory/weak_ptr.h"
+#include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
@@ -28,10 +31,6 @@ template <typename T>
 class Handle;
 }  // namespace gin
 
-namespace base {
-class Process;
-}  // namespace base
-
 namespace electron::api {
 
 class UtilityProcessWrapper
@@ -61,20 +60,40 @@ class UtilityProcessWrapper
                         std::map<IOHandle, IOType> stdio,
                         base::EnvironmentMap env_map,
                         base::FilePath current_working_directory,
-                        bool use_plugin_helper);
+                        bool use_plugin_helper,
+                        std::optional<base::Process::Priority> priority,
+                        std::vector<uint32_t> cpu_affinity);
   void OnServiceProcessDisconnected(uint32_t error_code,
                                     const std::string& description);
+  bool LaunchServiceProcess(const std::vector<std::string>& exec_args,
+                            const std::u16string& display_name,
+                            std::map<IOHandle, IOType> stdio,
+                            const base::EnvironmentMap& env_map,
+                            const base::FilePath& current_working_directory,
+                            bool use_plugin_helper);
   void OnServiceProcessLaunched(const base::Process& process);
+  void OnServiceProcessSpawned(base::Process process);
   void CloseConnectorPort();
 
   void PostMessage(gin::Arguments* args);
   bool Kill() const;
+  v8::Local<v8::Promise> StartCpuProfiling(gin::Arguments* args);
+  v8::Local<v8::Promise> StopCpuProfiling(v8::Isolate* isolate,
+                                          const base::FilePath& file_path);
   v8::Local<v8::Value> GetOSProcessId(v8::Isolate* isolate) const;
+  v8::Local<v8::Value> CreateSharedBuffer(gin::Arguments* args);
+  void HandleProtocol(gin::Arguments* args);
+  bool SetPriority(base::Process::Priority priority);
+  bool SetCPUAffinity(const std::vector<uint32_t>& cpus);
 
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
   base::ProcessId pid_ = base::kNullProcessId;
+  base::Process process_;
+  // Applied once the process is launched.
+  const std::optional<base::Process::Priority> priority_;
+  const std::vector<uint32_t> cpu_affinity_;
 #if BUILDFLAG(IS_WIN)
   // Non-owning handles, these will be closed when the
   // corresponding FD are closed via _close.
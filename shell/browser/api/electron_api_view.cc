@@ -304,6 +304,31 @@ void View::SetVisible(bool visible) {
   view_->SetVisible(visible);
 }
 
+void View::LayoutChildren(gin_helper::ErrorThrower thrower,
+                          const std::vector<views::ChildLayout>& layouts) {
+  if (!view_)
+    return;
+  for (const auto& layout : layouts) {
+    if (layout.child_view && layout.child_view->parent() != view_) {
+      thrower.ThrowError("Each view must be a child of this view");
+      return;
+    }
+  }
+
+  // The changes are applied together, with a single transaction of the
+  // layers on macOS, and hidden children stop being painted.
+#if BUILDFLAG(IS_MAC)
+  ScopedCAActionDisabler disable_animations;
+#endif
+  for (const auto& layout : layouts) {
+    if (!layout.child_view)
+      continue;
+    layout.child_view->SetVisible(layout.visible);
+    if (layout.visible)
+      layout.child_view->SetBoundsRect(layout.bounds);
+  }
+}
+
 void View::OnViewBoundsChanged(views::View* observed_view) {
   Emit("bounds-changed");
 }
@@ -354,7 +379,8 @@ void View::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("getBounds", &View::GetBounds)
       .SetMethod("setBackgroundColor", &View::SetBackgroundColor)
       .SetMethod("setLayout", &View::SetLayout)
-      .SetMethod("setVisible", &View::SetVisible);
+      .SetMethod("setVisible", &View::SetVisible)
+      .SetMethod("layoutChildren", &View::LayoutChildren);
 }
 
 }  // namespace electron::api
@@ -10,7 +10,9 @@
 #include "base/memory/raw_ptr.h"
 #include "gin/handle.h"
 #include "shell/common/color_util.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter.h"
+#include "ui/views/layout/proposed_layout.h"
 #include "ui/views/view.h"
 #include "ui/views/view_observer.h"
 #include "v8/include/v8-value.h"
@@ -37,6 +39,8 @@ class View : public gin_helper::EventEmitter<View>, public views::ViewObserver {
   std::vector<v8::Local<v8::Value>> GetChildren();
   void SetBackgroundColor(std::optional<WrappedSkColor> color);
   void SetVisible(bool visible);
+  void LayoutChildren(gin_helper::ErrorThrower thrower,
+                      const std::vector<views::ChildLayout>& layouts);
 
   // views::ViewObserver
   void OnViewBoundsChanged(views::View* observed_view) override;
@@ -4,6 +4,8 @@
 
 #include "shell/browser/api/electron_api_web_contents.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -13,12 +15,18 @@
 #include <utility>
 #include <vector>
 
+#include "base/barrier_callback.h"
 #include "base/containers/contains.h"
 #include "base/containers/fixed_flat_map.h"
 #include "base/containers/id_map.h"
 #include "base/files/file_util.h"
+#include "base/functional/callback_helpers.h"
 #include "base/json/json_reader.h"
 #include "base/no_destructor.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/current_thread.h"
 #include "base/task/thread_pool.h"
@@ -46,6 +54,8 @@
 #include "content/public/browser/download_request_utils.h"
 #include "content/public/browser/favicon_status.h"
 #include "content/public/browser/file_select_listener.h"
+#include "content/public/browser/gpu_data_manager.h"
+#include "content/public/browser/mhtml_generation_result.h"
 #include "content/public/browser/navigation_details.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/navigation_handle.h"
@@ -59,6 +69,7 @@
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/input/native_web_keyboard_event.h"
+#include "content/public/common/mhtml_generation_params.h"
 #include "content/public/common/referrer_type_converters.h"
 #include "content/public/common/result_codes.h"
 #include "content/public/common/webplugininfo.h"
@@ -66,37 +77,51 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "gin/arguments.h"
 #include "gin/data_object_builder.h"
+#include "gin/dictionary.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "gpu/ipc/common/memory_stats.h"
 #include "media/base/mime_util.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_connection_info.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "printing/buildflags/buildflags.h"
 #include "printing/print_job_constants.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/browser/api/electron_api_browser_window.h"
 #include "shell/browser/api/electron_api_debugger.h"
+#include "shell/browser/api/electron_api_offscreen_atlas.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
+#include "shell/browser/electron_api_ipc_handler_impl.h"
 #include "shell/browser/electron_autofill_driver_factory.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_navigation_throttle.h"
 #include "shell/browser/file_select_helper.h"
+#include "shell/browser/hidden_page_throttler.h"
+#include "shell/browser/input_event_queue.h"
 #include "shell/browser/native_window.h"
+#include "shell/browser/net/network_stats.h"
 #include "shell/browser/osr/osr_render_widget_host_view.h"
 #include "shell/browser/osr/osr_web_contents_view.h"
+#include "shell/browser/power_policy.h"
+#include "shell/browser/renderer_process_pool.h"
 #include "shell/browser/session_preferences.h"
 #include "shell/browser/ui/drag_util.h"
+#include "shell/browser/ui/draggable_region_index.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/ui/inspectable_web_contents_view.h"
@@ -108,6 +133,7 @@
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/color_util.h"
+#include "shell/common/crash_keys.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/base_converter.h"
 #include "shell/common/gin_converters/blink_converter.h"
@@ -126,16 +152,21 @@
 #include "shell/common/language_util.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/platform_util.h"
 #include "shell/common/process_util.h"
+#include "shell/common/startup_metrics.h"
 #include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
 #include "storage/browser/file_system/isolated_context.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
+#include "third_party/blink/public/common/input/web_mouse_event.h"
+#include "third_party/blink/public/common/input/web_mouse_wheel_event.h"
 #include "third_party/blink/public/common/messaging/transferable_message_mojom_traits.h"
 #include "third_party/blink/public/common/page/page_zoom.h"
 #include "third_party/blink/public/mojom/frame/find_in_page.mojom.h"
 #include "third_party/blink/public/mojom/frame/fullscreen.mojom.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
 #include "third_party/blink/public/mojom/messaging/transferable_message.mojom.h"
 #include "third_party/blink/public/mojom/renderer_preferences.mojom.h"
 #include "ui/base/cursor/cursor.h"
@@ -366,6 +397,22 @@ struct Converter<content::NavigationEntry*> {
   }
 };
 
+template <>
+struct Converter<media::VideoEncoderOutput> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const media::VideoEncoderOutput& output) {
+    gin_helper::Dictionary dict(isolate, v8::Object::New(isolate));
+    dict.Set("data",
+             node::Buffer::Copy(isolate,
+                                reinterpret_cast<const char*>(output.data.get()),
+                                output.size)
+                 .ToLocalChecked());
+    dict.Set("keyFrame", output.key_frame);
+    dict.Set("timestamp", output.timestamp.InMicrosecondsF());
+    return dict.GetHandle();
+  }
+};
+
 }  // namespace gin
 
 namespace electron::api {
@@ -511,6 +558,169 @@ void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
   capture_handle.RunAndReset();
 }
 
+// Writes the captured pixels into the caller's buffer and resolves with an
+// image that uses its memory, to save allocating and copying a new image.
+void OnCapturePageToBufferDone(
+    gin_helper::Promise<gin::Handle<NativeImage>> promise,
+    v8::Global<v8::Value> buffer,
+    base::ScopedClosureRunner capture_handle,
+    const SkBitmap& bitmap) {
+  auto ui_task_runner = content::GetUIThreadTaskRunner({});
+  if (!ui_task_runner->RunsTasksInCurrentSequence()) {
+    ui_task_runner->PostTask(
+        FROM_HERE,
+        base::BindOnce(&OnCapturePageToBufferDone, std::move(promise),
+                       std::move(buffer), std::move(capture_handle), bitmap));
+    return;
+  }
+  capture_handle.RunAndReset();
+
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  if (bitmap.drawsNothing()) {
+    promise.Resolve(NativeImage::CreateEmpty(isolate));
+    return;
+  }
+
+  v8::Local<v8::Value> buffer_value = buffer.Get(isolate);
+  const SkImageInfo info =
+      SkImageInfo::MakeN32Premul(bitmap.width(), bitmap.height());
+  if (node::Buffer::Length(buffer_value) < info.computeMinByteSize()) {
+    promise.RejectWithErrorMessage(
+        base::StringPrintf("buffer must hold at least %zu bytes",
+                           info.computeMinByteSize()));
+    return;
+  }
+  if (!bitmap.readPixels(info, node::Buffer::Data(buffer_value),
+                         info.minRowBytes(), 0, 0)) {
+    promise.RejectWithErrorMessage("Failed to read the captured pixels");
+    return;
+  }
+
+  gin::Handle<NativeImage> image = NativeImage::CreateFromSharedBuffer(
+      isolate, buffer_value.As<v8::ArrayBufferView>(), info, 1.0);
+  if (image.IsEmpty())
+    image = NativeImage::Create(isolate,
+                                gfx::Image::CreateFrom1xBitmap(bitmap));
+  promise.Resolve(image);
+}
+
+// The allocator dumps of a renderer process reported by getMemoryBreakdown().
+constexpr char kV8Dump[] = "v8";
+constexpr char kBlinkGCDump[] = "blink_gc";
+constexpr char kLayoutDump[] = "partition_alloc/partitions/layout";
+constexpr char kImageDecodeCacheDump[] = "cc/image_memory";
+
+struct MemoryBreakdown {
+  // The V8 heap of the frames of the WebContents, in bytes.
+  uint64_t main_world = 0;
+  uint64_t isolated_worlds = 0;
+  uint64_t node = 0;
+
+  // The renderer process of the main frame, shared with other WebContents.
+  base::ProcessId pid = base::kNullProcessId;
+  int web_contents_count = 0;
+  std::optional<uint64_t> v8;
+  std::optional<uint64_t> blink_gc;
+  std::optional<uint64_t> layout;
+  std::optional<uint64_t> image_decode_cache;
+  uint64_t gpu = 0;
+};
+
+int CountWebContentsInProcess(content::RenderProcessHost* process) {
+  int count = 0;
+  for (content::WebContents* web_contents :
+       content::WebContents::GetAllWebContents()) {
+    bool in_process = false;
+    web_contents->ForEachRenderFrameHost(
+        [process, &in_process](content::RenderFrameHost* frame) {
+          in_process |= frame->GetProcess() == process;
+        });
+    count += in_process;
+  }
+  return count;
+}
+
+void OnVideoMemoryStatsForBreakdown(
+    gin_helper::Promise<gin_helper::Dictionary> promise,
+    MemoryBreakdown breakdown,
+    const gpu::VideoMemoryUsageStats& stats) {
+  auto it = stats.process_map.find(breakdown.pid);
+  if (it != stats.process_map.end())
+    breakdown.gpu = it->second.video_memory;
+
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+
+  // Sizes are in kilobytes, like getProcessMemoryInfo().
+  auto to_kb = [](std::optional<uint64_t> size) {
+    return static_cast<double>(size.value_or(0) >> 10);
+  };
+  auto javascript = gin_helper::Dictionary::CreateEmpty(isolate);
+  javascript.Set("mainWorld", to_kb(breakdown.main_world));
+  javascript.Set("isolatedWorlds", to_kb(breakdown.isolated_worlds));
+  javascript.Set("node", to_kb(breakdown.node));
+
+  auto process = gin_helper::Dictionary::CreateEmpty(isolate);
+  process.Set("pid", breakdown.pid);
+  process.Set("webContentsCount", breakdown.web_contents_count);
+  process.Set("v8", to_kb(breakdown.v8));
+  process.Set("blinkGC", to_kb(breakdown.blink_gc));
+  process.Set("layout", to_kb(breakdown.layout));
+  process.Set("imageDecodeCache", to_kb(breakdown.image_decode_cache));
+  process.Set("gpu", to_kb(breakdown.gpu));
+
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("javaScript", javascript);
+  dict.Set("process", process);
+  promise.Resolve(dict);
+}
+
+void OnRendererMemoryDumped(
+    gin_helper::Promise<gin_helper::Dictionary> promise,
+    MemoryBreakdown breakdown,
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> global_dump) {
+  if (!success) {
+    promise.RejectWithErrorMessage("Failed to create memory dump");
+    return;
+  }
+
+  for (const auto& dump : global_dump->process_dumps()) {
+    if (dump.pid() != breakdown.pid)
+      continue;
+    breakdown.v8 = dump.GetMetric(kV8Dump, "effective_size");
+    breakdown.blink_gc = dump.GetMetric(kBlinkGCDump, "effective_size");
+    breakdown.layout = dump.GetMetric(kLayoutDump, "effective_size");
+    breakdown.image_decode_cache =
+        dump.GetMetric(kImageDecodeCacheDump, "effective_size");
+  }
+
+  // The GPU process reports the video memory of its clients.
+  content::GpuDataManager::GetInstance()->RequestVideoMemoryUsageStatsUpdate(
+      base::BindOnce(&OnVideoMemoryStatsForBreakdown, std::move(promise),
+                     breakdown));
+}
+
+void OnFramesMeasured(gin_helper::Promise<gin_helper::Dictionary> promise,
+                      MemoryBreakdown breakdown,
+                      std::vector<mojom::FrameMemoryUsagePtr> usages) {
+  for (const auto& usage : usages) {
+    breakdown.main_world += usage->main_world;
+    breakdown.isolated_worlds += usage->isolated_worlds;
+    breakdown.node += usage->node;
+  }
+
+  memory_instrumentation::MemoryInstrumentation::GetInstance()
+      ->RequestGlobalDumpForPid(
+          breakdown.pid,
+          {kV8Dump, kBlinkGCDump, kLayoutDump, kImageDecodeCacheDump},
+          base::BindOnce(&OnRendererMemoryDumped, std::move(promise),
+                         breakdown));
+}
+
 std::optional<base::TimeDelta> GetCursorBlinkInterval() {
 #if BUILDFLAG(IS_MAC)
   std::optional<base::TimeDelta> system_value(
@@ -618,6 +828,91 @@ scoped_refptr<base::TaskRunner> CreatePrinterHandlerTaskRunner() {
   return base::ThreadPool::CreateSingleThreadTaskRunner(kTraits);
 #endif
 }
+
+// Writes the PDF of printToPDFFile() and returns how long it took, or nothing
+// if it failed.
+std::optional<base::TimeDelta> WritePDFFile(
+    const base::FilePath& path,
+    scoped_refptr<base::RefCountedMemory> data) {
+  const base::TimeTicks start = base::TimeTicks::Now();
+  if (!base::WriteFile(path, base::make_span(data->front(), data->size())))
+    return std::nullopt;
+  return base::TimeTicks::Now() - start;
+}
+
+void OnPDFFileWritten(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                      size_t size,
+                      base::TimeDelta print_time,
+                      std::optional<base::TimeDelta> write_time) {
+  if (!write_time) {
+    promise.RejectWithErrorMessage("Failed to write PDF");
+    return;
+  }
+
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(
+      v8::Local<v8::Context>::New(isolate, promise.GetContext()));
+
+  auto result = gin_helper::Dictionary::CreateEmpty(isolate);
+  result.Set("size", static_cast<double>(size));
+  result.Set("printTime", print_time.InMillisecondsF());
+  result.Set("writeTime", write_time->InMillisecondsF());
+  promise.Resolve(result.GetHandle());
+}
+
+// Hands the PDF of printToPDFStream() to JS in chunks, so that only the chunks
+// that have not been consumed yet live on the V8 heap.
+class PDFDataReader : public gin::Wrappable<PDFDataReader> {
+ public:
+  static gin::Handle<PDFDataReader> Create(
+      v8::Isolate* isolate,
+      scoped_refptr<base::RefCountedMemory> data) {
+    return gin::CreateHandle(isolate, new PDFDataReader(std::move(data)));
+  }
+
+  // gin::Wrappable
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override {
+    return gin::Wrappable<PDFDataReader>::GetObjectTemplateBuilder(isolate)
+        .SetMethod("read", &PDFDataReader::Read)
+        .SetProperty("size", &PDFDataReader::size);
+  }
+
+  const char* GetTypeName() override { return "PDFDataReader"; }
+
+  static gin::WrapperInfo kWrapperInfo;
+
+ private:
+  explicit PDFDataReader(scoped_refptr<base::RefCountedMemory> data)
+      : data_(std::move(data)), size_(data_->size()) {}
+  ~PDFDataReader() override = default;
+
+  // Copies the next bytes of the PDF to |buf| and returns how many were
+  // copied, 0 once the whole PDF was read.
+  uint32_t Read(v8::Local<v8::ArrayBufferView> buf) {
+    if (!data_)
+      return 0;
+    const size_t length =
+        std::min(buf->ByteLength(), data_->size() - bytes_read_);
+    memcpy(static_cast<char*>(buf->Buffer()->Data()) + buf->ByteOffset(),
+           data_->front() + bytes_read_, length);
+    bytes_read_ += length;
+    // Release the PDF as soon as it is consumed instead of waiting for GC.
+    if (bytes_read_ == data_->size())
+      data_.reset();
+    return base::checked_cast<uint32_t>(length);
+  }
+
+  double size() const { return static_cast<double>(size_); }
+
+  scoped_refptr<base::RefCountedMemory> data_;
+  const size_t size_;
+  size_t bytes_read_ = 0;
+};
+
+gin::WrapperInfo PDFDataReader::kWrapperInfo = {gin::kEmbedderNativeGin};
 #endif
 
 struct UserDataLink : public base::SupportsUserData::Data {
@@ -630,6 +925,9 @@ const void* kElectronApiWebContentsKey = &kElectronApiWebContentsKey;
 
 const char kRootName[] = "<root>";
 
+// Bounds the subresources savePage() fetches ahead of saving the page.
+constexpr size_t kMaxSubresourceURLs = 1000;
+
 struct FileSystem {
   FileSystem() = default;
   FileSystem(const std::string& type,
@@ -748,6 +1046,75 @@ content::RenderFrameHost* GetRenderFrameHost(
 
   return frame_host;
 }
+
+const char* OffscreenPixelFormatToString(media::VideoPixelFormat format) {
+  switch (format) {
+    case media::PIXEL_FORMAT_ARGB:
+      return "bgra";
+    case media::PIXEL_FORMAT_ABGR:
+      return "rgba";
+    case media::PIXEL_FORMAT_NV12:
+      return "nv12";
+    default:
+      return "unknown";
+  }
+}
+
+// Describes a frame captured into a GPU texture to JS. The texture stays
+// reserved for the frame until release() is called or the returned object is
+// garbage collected.
+v8::Local<v8::Value> CreateOffscreenSharedTexture(
+    v8::Isolate* isolate,
+    const OffscreenSharedTextureValue& texture) {
+  auto info = gin_helper::Dictionary::CreateEmpty(isolate);
+  info.Set("widgetType", texture.is_popup ? "popup" : "frame");
+  info.Set("pixelFormat", OffscreenPixelFormatToString(texture.pixel_format));
+  info.Set("codedSize", texture.coded_size);
+  info.Set("visibleRect", texture.visible_rect);
+  info.Set("contentRect", texture.content_rect);
+  info.Set("timestamp", texture.timestamp.InMicroseconds());
+  if (texture.capture_update_rect)
+    info.Set("captureUpdateRect", *texture.capture_update_rect);
+
+  const gfx::GpuMemoryBufferHandle* handle = texture.holder->handle();
+#if BUILDFLAG(IS_WIN)
+  HANDLE shared_texture_handle = handle->dxgi_handle.Get();
+  info.Set("sharedTextureHandle",
+           node::Buffer::Copy(isolate,
+                              reinterpret_cast<char*>(&shared_texture_handle),
+                              sizeof(shared_texture_handle))
+               .ToLocalChecked());
+#elif BUILDFLAG(IS_MAC)
+  IOSurfaceRef shared_texture_handle = handle->io_surface.get();
+  info.Set("sharedTextureHandle",
+           node::Buffer::Copy(isolate,
+                              reinterpret_cast<char*>(&shared_texture_handle),
+                              sizeof(shared_texture_handle))
+               .ToLocalChecked());
+#elif BUILDFLAG(IS_LINUX)
+  std::vector<gin_helper::Dictionary> planes;
+  for (const auto& plane : handle->native_pixmap_handle.planes) {
+    auto plane_info = gin_helper::Dictionary::CreateEmpty(isolate);
+    plane_info.Set("stride", plane.stride);
+    plane_info.Set("offset", plane.offset);
+    plane_info.Set("size", plane.size);
+    plane_info.Set("fd", plane.fd.get());
+    planes.push_back(plane_info);
+  }
+  info.Set("planes", planes);
+  // Modifiers use all 64 bits, which a JS number cannot represent.
+  info.Set("modifier",
+           base::NumberToString(handle->native_pixmap_handle.modifier));
+#endif
+
+  auto object = gin_helper::Dictionary::CreateEmpty(isolate);
+  object.Set("textureInfo", info);
+  object.SetMethod("release",
+                   base::BindRepeating(&OffscreenSharedTextureHolder::Release,
+                                       texture.holder));
+  return object.GetHandle();
+}
+
 }  // namespace
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -802,6 +1169,7 @@ WebContents::WebContents(v8::Isolate* isolate,
   web_contents->SetUserData(kElectronApiWebContentsKey,
                             std::make_unique<UserDataLink>(GetWeakPtr()));
   InitZoomController(web_contents, gin::Dictionary::CreateEmpty(isolate));
+  power_policy_observation_.Observe(PowerPolicy::GetInstance());
 }
 
 WebContents::WebContents(v8::Isolate* isolate,
@@ -840,8 +1208,26 @@ WebContents::WebContents(v8::Isolate* isolate,
   // Get transparent for guest view
   options.Get("transparent", &guest_transparent_);
 
+  // |offscreen| is either a boolean or an object of offscreen options
   bool b = false;
-  if (options.Get(options::kOffscreen, &b) && b)
+  bool offscreen_use_shared_texture = false;
+  bool offscreen_adaptive_frame_rate = false;
+  int offscreen_max_latency = 250;
+  gin_helper::Dictionary offscreen_options;
+  if (options.Get(options::kOffscreen, &offscreen_options)) {
+    type_ = Type::kOffScreen;
+    offscreen_options.Get(options::kUseSharedTexture,
+                          &offscreen_use_shared_texture);
+    offscreen_options.Get(options::kDirtyRectOnly, &offscreen_dirty_rect_only_);
+    offscreen_options.Get(options::kAdaptiveFrameRate,
+                          &offscreen_adaptive_frame_rate);
+    offscreen_options.Get(options::kMaxLatency, &offscreen_max_latency);
+  } else if (options.Get(options::kOffscreen, &b) && b) {
+    type_ = Type::kOffScreen;
+  }
+
+  // Headless servers have no display to draw the windows' pages on.
+  if (type_ == Type::kBrowserWindow && Browser::IsHeadless())
     type_ = Type::kOffScreen;
 
   // Init embedder earlier
@@ -878,7 +1264,7 @@ WebContents::WebContents(v8::Isolate* isolate,
 
     if (embedder_ && embedder_->IsOffScreen()) {
       auto* view = new OffScreenWebContentsView(
-          false,
+          false, false,
           base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
       params.view = view;
       params.delegate_view = view;
@@ -898,8 +1284,11 @@ WebContents::WebContents(v8::Isolate* isolate,
 
     content::WebContents::CreateParams params(session->browser_context());
     auto* view = new OffScreenWebContentsView(
-        transparent,
+        transparent, offscreen_use_shared_texture,
         base::BindRepeating(&WebContents::OnPaint, base::Unretained(this)));
+    view->SetAdaptiveFrameRate(
+        offscreen_adaptive_frame_rate,
+        base::Milliseconds(std::max(offscreen_max_latency, 0)));
     params.view = view;
     params.delegate_view = view;
 
@@ -908,6 +1297,20 @@ WebContents::WebContents(v8::Isolate* isolate,
   } else {
     content::WebContents::CreateParams params(session->browser_context());
     params.initially_hidden = !initially_shown;
+    const auto process_prefs =
+        RendererProcessPreferences::FromDictionary(options);
+    // Share the renderer processes of the process group, or else use one
+    // launched ahead of time when there is one.
+    std::string process_group;
+    if (options.Get("processGroup", &process_group) && !process_group.empty()) {
+      params.site_instance =
+          ElectronBrowserClient::Get()->GetSiteInstanceForProcessGroup(
+              session->browser_context(), process_group, process_prefs);
+    }
+    if (!params.site_instance) {
+      if (auto* pool = session->browser_context()->renderer_process_pool())
+        params.site_instance = pool->Take(process_prefs);
+    }
     web_contents = content::WebContents::Create(params);
   }
 
@@ -985,6 +1388,9 @@ void WebContents::InitWithSessionAndOptions(
 
   WebContentsPermissionHelper::CreateForWebContents(web_contents());
   InitZoomController(web_contents(), options);
+  power_policy_observation_.Observe(PowerPolicy::GetInstance());
+  if (IsOffScreen())
+    ApplyOffscreenFrameRate();
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   extensions::ElectronExtensionWebContentsObserver::CreateForWebContents(
       web_contents());
@@ -1061,6 +1467,8 @@ WebContents::~WebContents() {
   if (owner_window_) {
     owner_window_->RemoveBackgroundThrottlingSource(this);
   }
+  if (offscreen_atlas_)
+    offscreen_atlas_->OnWebContentsRemoved(ID());
   if (web_contents()) {
     content::RenderViewHost* host = web_contents()->GetRenderViewHost();
     if (host)
@@ -1149,8 +1557,40 @@ void WebContents::OnCreateWindow(
     WindowOpenDisposition disposition,
     const std::string& features,
     const scoped_refptr<network::ResourceRequestBody>& body) {
+  int allow_rule;
+  if (ApplyWindowOpenRules(target_url, &allow_rule))
+    return;
   Emit("-new-window", target_url, frame_name, disposition, features, referrer,
-       body);
+       body, allow_rule);
+}
+
+WebContents::WindowOpenRule::WindowOpenRule() = default;
+WebContents::WindowOpenRule::WindowOpenRule(const WindowOpenRule&) = default;
+WebContents::WindowOpenRule& WebContents::WindowOpenRule::operator=(
+    const WindowOpenRule&) = default;
+WebContents::WindowOpenRule::~WindowOpenRule() = default;
+
+bool WebContents::ApplyWindowOpenRules(const GURL& url, int* allow_rule) {
+  *allow_rule = -1;
+  for (size_t i = 0; i < window_open_rules_.size(); ++i) {
+    const WindowOpenRule& rule = window_open_rules_[i];
+    if (!rule.urls.empty() &&
+        !base::ranges::any_of(rule.urls, [&url](const URLPattern& pattern) {
+          return pattern.MatchesURL(url);
+        }))
+      continue;
+    switch (rule.action) {
+      case WindowOpenRule::Action::kDeny:
+        return true;
+      case WindowOpenRule::Action::kOpenExternal:
+        platform_util::OpenExternal(url, {}, base::DoNothing());
+        return true;
+      case WindowOpenRule::Action::kAllow:
+        *allow_rule = static_cast<int>(i);
+        return false;
+    }
+  }
+  return false;
 }
 
 void WebContents::WebContentsCreatedWithFullParams(
@@ -1187,15 +1627,72 @@ bool WebContents::IsWebContentsCreationOverridden(
     content::mojom::WindowContainerType window_container_type,
     const GURL& opener_url,
     const content::mojom::CreateNewWindowParams& params) {
-  bool default_prevented = Emit(
-      "-will-add-new-contents", params.target_url, params.frame_name,
-      params.raw_features, params.disposition, *params.referrer, params.body);
+  // The windows that the rules decide never wait for the main process's JS.
+  int allow_rule;
+  if (ApplyWindowOpenRules(params.target_url, &allow_rule))
+    return true;
+  bool default_prevented =
+      Emit("-will-add-new-contents", params.target_url, params.frame_name,
+           params.raw_features, params.disposition, *params.referrer,
+           params.body, allow_rule);
   // If the app prevented the default, redirect to CreateCustomWebContents,
   // which always returns nullptr, which will result in the window open being
   // prevented (window.open() will return null in the renderer).
   return default_prevented;
 }
 
+void WebContents::SetWindowOpenRules(gin::Arguments* args) {
+  std::vector<v8::Local<v8::Value>> rule_values;
+  if (!args->GetNext(&rule_values)) {
+    args->ThrowTypeError("Must pass an array of rules");
+    return;
+  }
+
+  std::vector<WindowOpenRule> rules;
+  for (v8::Local<v8::Value> rule_value : rule_values) {
+    gin::Dictionary dict(args->isolate());
+    if (!gin::ConvertFromV8(args->isolate(), rule_value, &dict)) {
+      args->ThrowTypeError("Rules must be objects");
+      return;
+    }
+
+    WindowOpenRule rule;
+
+    std::vector<std::string> patterns;
+    if (!dict.Get("urls", &patterns)) {
+      args->ThrowTypeError("Rules must have property 'urls'.");
+      return;
+    }
+    for (const std::string& pattern_string : patterns) {
+      URLPattern pattern(URLPattern::SCHEME_ALL);
+      const URLPattern::ParseResult result = pattern.Parse(pattern_string);
+      if (result != URLPattern::ParseResult::kSuccess) {
+        args->ThrowTypeError("Invalid url pattern " + pattern_string + ": " +
+                             URLPattern::GetParseResultString(result));
+        return;
+      }
+      rule.urls.push_back(std::move(pattern));
+    }
+
+    std::string action;
+    dict.Get("action", &action);
+    if (action == "allow") {
+      rule.action = WindowOpenRule::Action::kAllow;
+    } else if (action == "deny") {
+      rule.action = WindowOpenRule::Action::kDeny;
+    } else if (action == "openExternal") {
+      rule.action = WindowOpenRule::Action::kOpenExternal;
+    } else {
+      args->ThrowTypeError("Invalid action " + action);
+      return;
+    }
+
+    rules.push_back(std::move(rule));
+  }
+
+  window_open_rules_ = std::move(rules);
+}
+
 void WebContents::SetNextChildWebPreferences(
     const gin_helper::Dictionary preferences) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
@@ -1257,8 +1754,11 @@ content::WebContents* WebContents::OpenURLFromTab(
     const content::OpenURLParams& params) {
   auto weak_this = GetWeakPtr();
   if (params.disposition != WindowOpenDisposition::CURRENT_TAB) {
-    Emit("-new-window", params.url, "", params.disposition, "", params.referrer,
-         params.post_data);
+    int allow_rule;
+    if (!ApplyWindowOpenRules(params.url, &allow_rule)) {
+      Emit("-new-window", params.url, "", params.disposition, "",
+           params.referrer, params.post_data, allow_rule);
+    }
     return nullptr;
   }
 
@@ -1703,6 +2203,13 @@ void WebContents::RenderFrameCreated(
     content::RenderFrameHost* render_frame_host) {
   HandleNewRenderFrame(render_frame_host);
 
+  // Pages that are created hidden get the policy of their session.
+  if (!render_frame_host->GetParent()) {
+    // A page that is navigated after it was discarded has a renderer again.
+    discarded_ = false;
+    UpdateHiddenPageThrottler();
+  }
+
   // RenderFrameCreated is called for speculative frames which may not be
   // used in certain cross-origin navigations. Invoking
   // RenderFrameHost::GetLifecycleState currently crashes when called for
@@ -1790,6 +2297,12 @@ void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
 
 void WebContents::PrimaryMainFrameRenderProcessGone(
     base::TerminationStatus status) {
+  // The frozen state goes away with the renderer.
+  frozen_ = false;
+  auto_freeze_timer_.Stop();
+  // The renderer of a discarded page is expected to go away.
+  if (discarded_)
+    return;
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
   auto details = gin_helper::Dictionary::CreateEmpty(isolate);
@@ -1843,6 +2356,15 @@ void WebContents::OnWebContentsLostFocus(
   Emit("blur");
 }
 
+void WebContents::OnVisibilityChanged(content::Visibility visibility) {
+  if (visibility != content::Visibility::HIDDEN)
+    Resume();
+  UpdateHiddenPageThrottler();
+  UpdateAutoFreezeTimer();
+  if (visibility != content::Visibility::HIDDEN)
+    RestoreIfDiscarded();
+}
+
 void WebContents::DOMContentLoaded(
     content::RenderFrameHost* render_frame_host) {
   auto* web_frame = WebFrameMain::FromRenderFrameHost(render_frame_host);
@@ -1893,6 +2415,22 @@ void WebContents::DidStartLoading() {
   Emit("did-start-loading");
 }
 
+void WebContents::ResourceLoadComplete(
+    content::RenderFrameHost* render_frame_host,
+    const content::GlobalRequestID& request_id,
+    const blink::mojom::ResourceLoadInfo& resource_load_info) {
+  auto* browser_context = static_cast<ElectronBrowserContext*>(
+      web_contents()->GetBrowserContext());
+  browser_context->network_stats()->RecordRequest(
+      resource_load_info.final_url, resource_load_info.net_error,
+      resource_load_info.was_cached, resource_load_info.raw_body_bytes,
+      resource_load_info.load_timing_info);
+  if (resource_load_info.net_error == net::OK &&
+      resource_load_info.final_url.SchemeIsHTTPOrHTTPS() &&
+      subresource_urls_.size() < kMaxSubresourceURLs)
+    subresource_urls_.insert(resource_load_info.final_url);
+}
+
 void WebContents::DidStopLoading() {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
   if (web_preferences && web_preferences->ShouldUsePreferredSizeMode())
@@ -1945,6 +2483,7 @@ void WebContents::Message(bool internal,
                           blink::CloneableMessage arguments,
                           content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::Message", "channel", channel);
+  crash_keys::AddBreadcrumb("ipc", channel);
   // webContents.emit('-ipc-message', new Event(), internal, channel,
   // arguments);
   EmitWithSender("-ipc-message", render_frame_host,
@@ -1959,6 +2498,7 @@ void WebContents::Invoke(
     electron::mojom::ElectronApiIPC::InvokeCallback callback,
     content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::Invoke", "channel", channel);
+  crash_keys::AddBreadcrumb("ipc", channel);
   // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
   EmitWithSender("-ipc-invoke", render_frame_host, std::move(callback),
                  internal, channel, std::move(arguments));
@@ -1967,6 +2507,7 @@ void WebContents::Invoke(
 void WebContents::OnFirstNonEmptyLayout(
     content::RenderFrameHost* render_frame_host) {
   if (render_frame_host == web_contents()->GetPrimaryMainFrame()) {
+    startup_metrics::RecordMilestone("firstNonEmptyLayout");
     Emit("ready-to-show");
   }
 }
@@ -2075,6 +2616,7 @@ void WebContents::MessageSync(
     electron::mojom::ElectronApiIPC::MessageSyncCallback callback,
     content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::MessageSync", "channel", channel);
+  crash_keys::AddBreadcrumb("ipc", channel);
   // webContents.emit('-ipc-message-sync', new Event(sender, message), internal,
   // channel, arguments);
   EmitWithSender("-ipc-message-sync", render_frame_host, std::move(callback),
@@ -2096,7 +2638,10 @@ void WebContents::UpdateDraggableRegions(
   if (owner_window() && owner_window()->has_frame())
     return;
 
-  draggable_region_ = DraggableRegionsToSkRegion(regions);
+  std::unique_ptr<SkRegion> region = DraggableRegionsToSkRegion(regions);
+  if (draggable_region_ && draggable_region_->region() == *region)
+    return;
+  draggable_region_ = std::make_unique<DraggableRegionIndex>(*region);
 }
 
 void WebContents::DidStartNavigation(
@@ -2138,6 +2683,25 @@ void WebContents::DidFinishNavigation(
 
   if (!navigation_handle->HasCommitted())
     return;
+  // The loads of the renderers don't tell which protocol they used, the
+  // navigations do.
+  if (!navigation_handle->IsSameDocument()) {
+    auto* browser_context = static_cast<ElectronBrowserContext*>(
+        web_contents()->GetBrowserContext());
+    browser_context->network_stats()->RecordProtocol(
+        navigation_handle->GetURL(),
+        net::HttpConnectionInfoToString(
+            navigation_handle->GetConnectionInfo()));
+  }
+  if (navigation_handle->IsInPrimaryMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    subresource_urls_.clear();
+    startup_metrics::RecordMilestone("firstNavigationCommit");
+    // Only the origin, the rest of the URL can hold personal data.
+    crash_keys::AddBreadcrumb(
+        "navigation",
+        url::Origin::Create(navigation_handle->GetURL()).Serialize());
+  }
   bool is_main_frame = navigation_handle->IsInMainFrame();
   content::RenderFrameHost* frame_host =
       navigation_handle->GetRenderFrameHost();
@@ -2320,6 +2884,8 @@ content::WebContents* WebContents::GetDevToolsWebContents() const {
 }
 
 void WebContents::WebContentsDestroyed() {
+  input_event_queue_.reset();
+
   // Clear the pointer stored in wrapper.
   if (GetAllWebContents().Lookup(id_))
     GetAllWebContents().Remove(id_);
@@ -2334,6 +2900,7 @@ void WebContents::WebContentsDestroyed() {
   if (guest_delegate_)
     guest_delegate_->WillDestroy();
 
+  hidden_page_throttler_.reset();
   Observe(nullptr);
   Emit("destroyed");
 }
@@ -2344,12 +2911,117 @@ void WebContents::NavigationEntryCommitted(
        details.is_same_document, details.did_replace_entry);
 }
 
+void WebContents::SetBackgroundThrottlingPolicy(gin::Arguments* args) {
+  if (!GetBackgroundThrottlingPolicyArgument(args,
+                                             &background_throttling_policy_))
+    return;
+  UpdateHiddenPageThrottler();
+}
+
+void WebContents::UpdateHiddenPageThrottler() {
+  std::optional<BackgroundThrottlingPolicy> policy =
+      background_throttling_policy_;
+  if (!policy) {
+    if (auto* prefs = SessionPreferences::FromBrowserContext(
+            web_contents()->GetBrowserContext()))
+      policy = prefs->background_throttling_policy();
+  }
+  // The power policy overrides the policies of the page and of its session
+  // while it applies, but not a page whose throttling is disabled.
+  if (const auto& power_policy =
+          PowerPolicy::GetInstance()->actions().background_throttling_policy)
+    policy = power_policy;
+  // A frozen page is not woken up by the throttler.
+  if (!policy || !background_throttling_ || frozen_ ||
+      web_contents()->GetVisibility() != content::Visibility::HIDDEN) {
+    if (hidden_page_throttler_)
+      hidden_page_throttler_->Stop();
+    return;
+  }
+  if (!hidden_page_throttler_)
+    hidden_page_throttler_ =
+        std::make_unique<HiddenPageThrottler>(web_contents());
+  if (hidden_page_throttler_->is_running() &&
+      hidden_page_throttler_->policy() == *policy)
+    return;
+  hidden_page_throttler_->Stop();
+  hidden_page_throttler_->Start(*policy);
+}
+
+bool WebContents::Freeze() {
+  // Blink does not freeze visible pages.
+  if (frozen_ ||
+      web_contents()->GetVisibility() != content::Visibility::HIDDEN ||
+      !web_contents()->GetPrimaryMainFrame()->IsRenderFrameLive())
+    return false;
+  frozen_ = true;
+  auto_freeze_timer_.Stop();
+  UpdateHiddenPageThrottler();
+  web_contents()->SetPageFrozen(true);
+  if (owner_window_)
+    owner_window_->UpdateBackgroundThrottlingState();
+  Emit("frozen");
+  return true;
+}
+
+void WebContents::Resume() {
+  if (!frozen_)
+    return;
+  frozen_ = false;
+  web_contents()->SetPageFrozen(false);
+  if (owner_window_)
+    owner_window_->UpdateBackgroundThrottlingState();
+  UpdateHiddenPageThrottler();
+  UpdateAutoFreezeTimer();
+  Emit("resumed");
+}
+
+void WebContents::SetAutoFreezeDelay(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  int delay = 0;
+  if (args->GetNext(&value) && value->IsNull()) {
+    auto_freeze_delay_ = std::nullopt;
+  } else if (!value.IsEmpty() &&
+             gin::ConvertFromV8(args->isolate(), value, &delay) &&
+             delay >= 0) {
+    auto_freeze_delay_ = base::Milliseconds(delay);
+  } else {
+    args->ThrowTypeError("delay must be null or a non-negative integer");
+    return;
+  }
+  auto_freeze_timer_.Stop();
+  UpdateAutoFreezeTimer();
+}
+
+void WebContents::UpdateAutoFreezeTimer() {
+  if (!auto_freeze_delay_ || !background_throttling_ || frozen_ ||
+      web_contents()->GetVisibility() != content::Visibility::HIDDEN) {
+    auto_freeze_timer_.Stop();
+    return;
+  }
+  if (!auto_freeze_timer_.IsRunning()) {
+    auto_freeze_timer_.Start(FROM_HERE, *auto_freeze_delay_, this,
+                             &WebContents::OnAutoFreezeTimer);
+  }
+}
+
+void WebContents::OnAutoFreezeTimer() {
+  // Hidden pages that play audio are still in use.
+  if (web_contents()->IsCurrentlyAudible()) {
+    UpdateAutoFreezeTimer();
+    return;
+  }
+  Freeze();
+}
+
 bool WebContents::GetBackgroundThrottling() const {
   return background_throttling_;
 }
 
 void WebContents::SetBackgroundThrottling(bool allowed) {
   background_throttling_ = allowed;
+  UpdateHiddenPageThrottler();
+  UpdateAutoFreezeTimer();
 
   if (owner_window_) {
     owner_window_->UpdateBackgroundThrottlingState();
@@ -2708,6 +3380,61 @@ void WebContents::ForcefullyCrashRenderer() {
   }
 }
 
+bool WebContents::Discard() {
+  if (discarded_ || is_guest() ||
+      web_contents()->GetVisibility() == content::Visibility::VISIBLE)
+    return false;
+
+  content::RenderProcessHost* rph =
+      web_contents()->GetPrimaryMainFrame()->GetProcess();
+  if (!rph->IsInitializedAndNotDead())
+    return false;
+
+  if (Emit("will-discard"))
+    return false;
+
+  // The navigation entries keep the state of the page, including its scroll
+  // position, so only the renderer has to go. Processes that host other
+  // pages or unload handlers are not shut down.
+  discarded_ = true;
+  web_contents()->SetWasDiscarded(true);
+  if (!rph->FastShutdownIfPossible(1, false)) {
+    discarded_ = false;
+    web_contents()->SetWasDiscarded(false);
+    return false;
+  }
+  Emit("discarded");
+  return true;
+}
+
+void WebContents::RestoreIfDiscarded() {
+  if (!discarded_)
+    return;
+  discarded_ = false;
+  Emit("restored");
+  content::NavigationController& controller = web_contents()->GetController();
+  controller.SetNeedsReload();
+  controller.LoadIfNecessary();
+}
+
+void WebContents::SetAutoDiscardable(bool auto_discardable) {
+  if (!auto_discardable) {
+    memory_pressure_listener_.reset();
+  } else if (!memory_pressure_listener_) {
+    memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+        FROM_HERE, base::BindRepeating(&WebContents::OnMemoryPressure,
+                                       base::Unretained(this)));
+  }
+}
+
+void WebContents::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+          base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL &&
+      web_contents()->GetVisibility() == content::Visibility::HIDDEN)
+    Discard();
+}
+
 void WebContents::SetUserAgent(const std::string& user_agent) {
   blink::UserAgentOverride ua_override;
   ua_override.ua_string_override = user_agent;
@@ -2723,7 +3450,8 @@ std::string WebContents::GetUserAgent() {
 
 v8::Local<v8::Promise> WebContents::SavePage(
     const base::FilePath& full_file_path,
-    const content::SavePageType& save_type) {
+    const content::SavePageType& save_type,
+    gin::Arguments* args) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -2733,12 +3461,60 @@ v8::Local<v8::Promise> WebContents::SavePage(
     return handle;
   }
 
-  auto* handler = new SavePageHandler(web_contents(), std::move(promise));
+  SavePageHandler::ProgressCallback progress_callback;
+  args->GetNext(&progress_callback);
+  auto* handler = new SavePageHandler(web_contents(), std::move(promise),
+                                      std::move(progress_callback));
   handler->Handle(full_file_path, save_type);
 
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::GenerateMHTML(
+    const base::FilePath& file_path,
+    gin::Arguments* args) {
+  gin_helper::Promise<gin_helper::Dictionary> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!file_path.IsAbsolute()) {
+    promise.RejectWithErrorMessage("Path must be absolute");
+    return handle;
+  }
+
+  content::MHTMLGenerationParams params(file_path);
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("binaryEncoding", &params.use_binary_encoding);
+    options.Get("removePopupOverlay", &params.remove_popup_overlay);
+    options.Get("computeContentsHash", &params.compute_contents_hash);
+  }
+
+  TRACE_EVENT0("electron", "WebContents::GenerateMHTML");
+  web_contents()->GenerateMHTMLWithResult(
+      params, base::BindOnce(
+                  [](gin_helper::Promise<gin_helper::Dictionary> promise,
+                     const content::MHTMLGenerationResult& result) {
+                    if (result.file_size < 0) {
+                      promise.RejectWithErrorMessage(
+                          "Failed to generate the MHTML file");
+                      return;
+                    }
+                    v8::HandleScope handle_scope(promise.isolate());
+                    auto dict =
+                        gin_helper::Dictionary::CreateEmpty(promise.isolate());
+                    dict.Set("size", result.file_size);
+                    if (result.file_digest)
+                      dict.Set("sha256", base::HexEncode(*result.file_digest));
+                    promise.Resolve(dict);
+                  },
+                  std::move(promise)));
+  return handle;
+}
+
+std::vector<GURL> WebContents::GetSubresourceURLs() const {
+  return {subresource_urls_.begin(), subresource_urls_.end()};
+}
+
 void WebContents::OpenDevTools(gin::Arguments* args) {
   if (type_ == Type::kRemote)
     return;
@@ -3206,16 +3982,27 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
       absl::get<printing::mojom::PrintPagesParamsPtr>(print_pages_params));
   params->params->document_cookie = unique_id.value_or(0);
 
-  manager->PrintToPdf(web_contents()->GetPrimaryMainFrame(), page_ranges,
-                      std::move(params),
-                      base::BindOnce(&WebContents::OnPDFCreated, GetWeakPtr(),
-                                     std::move(promise)));
+  // printToPDFFile() writes the PDF without handing it to JS, and
+  // printToPDFStream() hands it over in chunks.
+  base::FilePath path;
+  if (const std::string* path_str = settings.GetDict().FindString("path"))
+    path = base::FilePath::FromUTF8Unsafe(*path_str);
+  const bool stream = settings.GetDict().FindBool("stream").value_or(false);
+
+  manager->PrintToPdf(
+      web_contents()->GetPrimaryMainFrame(), page_ranges, std::move(params),
+      base::BindOnce(&WebContents::OnPDFCreated, GetWeakPtr(),
+                     std::move(promise), path, stream,
+                     base::TimeTicks::Now()));
 
   return handle;
 }
 
 void WebContents::OnPDFCreated(
     gin_helper::Promise<v8::Local<v8::Value>> promise,
+    const base::FilePath& path,
+    bool stream,
+    base::TimeTicks start,
     print_to_pdf::PdfPrintResult print_result,
     scoped_refptr<base::RefCountedMemory> data) {
   if (print_result != print_to_pdf::PdfPrintResult::kPrintSuccess) {
@@ -3225,12 +4012,29 @@ void WebContents::OnPDFCreated(
     return;
   }
 
+  if (!path.empty()) {
+    const size_t size = data->size();
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+        base::BindOnce(&WritePDFFile, path, std::move(data)),
+        base::BindOnce(&OnPDFFileWritten, std::move(promise), size,
+                       base::TimeTicks::Now() - start));
+    return;
+  }
+
   v8::Isolate* isolate = promise.isolate();
   gin_helper::Locker locker(isolate);
   v8::HandleScope handle_scope(isolate);
   v8::Context::Scope context_scope(
       v8::Local<v8::Context>::New(isolate, promise.GetContext()));
 
+  if (stream) {
+    promise.Resolve(PDFDataReader::Create(isolate, std::move(data)).ToV8());
+    return;
+  }
+
   v8::Local<v8::Value> buffer =
       node::Buffer::Copy(isolate, reinterpret_cast<const char*>(data->front()),
                          data->size())
@@ -3410,11 +4214,7 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
   if (blink::WebInputEvent::IsMouseEventType(type)) {
     blink::WebMouseEvent mouse_event;
     if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
-      if (IsOffScreen()) {
-        GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
-      } else {
-        rwh->ForwardMouseEvent(mouse_event);
-      }
+      SendMouseEvent(rwh, mouse_event);
       return;
     }
   } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
@@ -3425,32 +4225,15 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
       // For backwards compatibility, convert `kKeyDown` to `kRawKeyDown`.
       if (keyboard_event.GetType() == blink::WebKeyboardEvent::Type::kKeyDown)
         keyboard_event.SetType(blink::WebKeyboardEvent::Type::kRawKeyDown);
+      if (auto* osr_rwhv = GetOffScreenRenderWidgetHostView())
+        osr_rwhv->NotifyActivity();
       rwh->ForwardKeyboardEvent(keyboard_event);
       return;
     }
   } else if (type == blink::WebInputEvent::Type::kMouseWheel) {
     blink::WebMouseWheelEvent mouse_wheel_event;
     if (gin::ConvertFromV8(isolate, input_event, &mouse_wheel_event)) {
-      if (IsOffScreen()) {
-        GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(
-            mouse_wheel_event);
-      } else {
-        // Chromium expects phase info in wheel events (and applies a
-        // DCHECK to verify it). See: https://crbug.com/756524.
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
-        mouse_wheel_event.dispatch_type =
-            blink::WebInputEvent::DispatchType::kBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-
-        // Send a synthetic wheel event with phaseEnded to finish scrolling.
-        mouse_wheel_event.has_synthetic_phase = true;
-        mouse_wheel_event.delta_x = 0;
-        mouse_wheel_event.delta_y = 0;
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
-        mouse_wheel_event.dispatch_type =
-            blink::WebInputEvent::DispatchType::kEventNonBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-      }
+      SendMouseWheelEvent(rwh, std::move(mouse_wheel_event));
       return;
     }
   }
@@ -3459,6 +4242,112 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
       v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
 }
 
+size_t WebContents::SendInputEvents(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) || !value->IsFloat64Array()) {
+    args->ThrowTypeError("events must be a Float64Array");
+    return 0;
+  }
+  v8::Local<v8::Float64Array> array = value.As<v8::Float64Array>();
+  std::vector<double> data(array->Length());
+  array->CopyContents(data.data(), data.size() * sizeof(double));
+
+  std::vector<std::unique_ptr<blink::WebMouseEvent>> events;
+  if (!gin::DecodeInputEventStream(data, ui::EventTimeForNow(), &events)) {
+    args->ThrowTypeError("Invalid input event stream");
+    return 0;
+  }
+
+  const size_t count = events.size();
+  return SendMouseEvents(std::move(events)) ? count : 0;
+}
+
+bool WebContents::SendMouseEvents(
+    std::vector<std::unique_ptr<blink::WebMouseEvent>> events) {
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderWidgetHostView();
+  if (!view)
+    return false;
+
+  // The events are all forwarded in this task, they are queued by the input
+  // router and reach the renderer without a round trip to JS for each.
+  content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
+  for (const auto& event : events) {
+    if (event->GetType() == blink::WebInputEvent::Type::kMouseWheel) {
+      SendMouseWheelEvent(
+          rwh, static_cast<const blink::WebMouseWheelEvent&>(*event));
+    } else {
+      SendMouseEvent(rwh, *event);
+    }
+  }
+  return true;
+}
+
+void WebContents::SetInputQueue(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) || value->IsNullOrUndefined()) {
+    input_event_queue_.reset();
+    return;
+  }
+  if (!value->IsSharedArrayBuffer()) {
+    args->ThrowTypeError("Expected a SharedArrayBuffer or null");
+    return;
+  }
+
+  int poll_interval = 4;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("pollInterval", &poll_interval);
+  poll_interval = std::clamp(poll_interval, 1, 100);
+
+  auto queue = InputEventQueue::Create(
+      value.As<v8::SharedArrayBuffer>()->GetBackingStore(),
+      base::Milliseconds(poll_interval),
+      base::BindRepeating(base::IgnoreResult(&WebContents::SendMouseEvents),
+                          base::Unretained(this)));
+  if (!queue) {
+    args->ThrowTypeError(
+        "Expected the buffer to hold a 16 byte header followed by events of "
+        "72 bytes");
+    return;
+  }
+  input_event_queue_ = std::move(queue);
+}
+
+void WebContents::SendMouseEvent(content::RenderWidgetHost* rwh,
+                                 const blink::WebMouseEvent& mouse_event) {
+  if (IsOffScreen()) {
+    GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
+  } else {
+    rwh->ForwardMouseEvent(mouse_event);
+  }
+}
+
+void WebContents::SendMouseWheelEvent(
+    content::RenderWidgetHost* rwh,
+    blink::WebMouseWheelEvent mouse_wheel_event) {
+  if (IsOffScreen()) {
+    GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(mouse_wheel_event);
+    return;
+  }
+
+  // Chromium expects phase info in wheel events (and applies a
+  // DCHECK to verify it). See: https://crbug.com/756524.
+  mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
+  mouse_wheel_event.dispatch_type =
+      blink::WebInputEvent::DispatchType::kBlocking;
+  rwh->ForwardWheelEvent(mouse_wheel_event);
+
+  // Send a synthetic wheel event with phaseEnded to finish scrolling.
+  mouse_wheel_event.has_synthetic_phase = true;
+  mouse_wheel_event.delta_x = 0;
+  mouse_wheel_event.delta_y = 0;
+  mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
+  mouse_wheel_event.dispatch_type =
+      blink::WebInputEvent::DispatchType::kEventNonBlocking;
+  rwh->ForwardWheelEvent(mouse_wheel_event);
+}
+
 void WebContents::BeginFrameSubscription(gin::Arguments* args) {
   bool only_dirty = false;
   FrameSubscriber::FrameCaptureCallback callback;
@@ -3478,6 +4367,35 @@ void WebContents::BeginFrameSubscription(gin::Arguments* args) {
       std::make_unique<FrameSubscriber>(web_contents(), callback, only_dirty);
 }
 
+void WebContents::BeginEncodedFrameSubscription(
+    gin_helper::ErrorThrower thrower,
+    const gin_helper::Dictionary& options,
+    const FrameSubscriber::EncodedFrameCallback& callback) {
+  std::string codec;
+  if (!options.Get("codec", &codec)) {
+    thrower.ThrowTypeError("'codec' is required");
+    return;
+  }
+
+  FrameSubscriber::EncodingOptions encoding_options;
+  if (auto profile = FrameSubscriber::GetEncodingProfile(codec)) {
+    encoding_options.profile = *profile;
+  } else {
+    thrower.ThrowError("Unsupported codec: " + codec);
+    return;
+  }
+
+  uint32_t bitrate = 0;
+  if (options.Get("bitrate", &bitrate))
+    encoding_options.bitrate = bitrate;
+  int key_frame_interval = 0;
+  if (options.Get("keyFrameInterval", &key_frame_interval))
+    encoding_options.key_frame_interval = key_frame_interval;
+
+  frame_subscriber_ = std::make_unique<FrameSubscriber>(
+      web_contents(), encoding_options, callback);
+}
+
 void WebContents::EndFrameSubscription() {
   frame_subscriber_.reset();
 }
@@ -3522,11 +4440,26 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
 
   bool stay_hidden = false;
   bool stay_awake = false;
+  std::optional<float> scale_factor;
+  v8::Local<v8::Value> buffer;
   if (args && args->Length() == 2) {
     gin_helper::Dictionary options;
     if (args->GetNext(&options)) {
       options.Get("stayHidden", &stay_hidden);
       options.Get("stayAwake", &stay_awake);
+      float value;
+      if (options.Get("scaleFactor", &value)) {
+        if (!(value > 0)) {
+          promise.RejectWithErrorMessage("scaleFactor must be positive");
+          return handle;
+        }
+        scale_factor = value;
+      }
+      if (options.Get("buffer", &buffer) && !buffer->IsUndefined() &&
+          !node::Buffer::HasInstance(buffer)) {
+        promise.RejectWithErrorMessage("buffer must be a node Buffer");
+        return handle;
+      }
     }
   }
 
@@ -3552,13 +4485,28 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
   // By default, the requested bitmap size is the view size in screen
   // coordinates.  However, if there's more pixel detail available on the
   // current system, increase the requested bitmap size to capture it all.
+  // An explicit scale factor is applied by the GPU when copying the surface.
   gfx::Size bitmap_size = view_size;
-  const gfx::NativeView native_view = view->GetNativeView();
-  const float scale = display::Screen::GetScreen()
-                          ->GetDisplayNearestView(native_view)
-                          .device_scale_factor();
-  if (scale > 1.0f)
-    bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  if (scale_factor) {
+    bitmap_size = gfx::ScaleToCeiledSize(view_size, *scale_factor);
+  } else {
+    const gfx::NativeView native_view = view->GetNativeView();
+    const float scale = display::Screen::GetScreen()
+                            ->GetDisplayNearestView(native_view)
+                            .device_scale_factor();
+    if (scale > 1.0f)
+      bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  }
+
+  if (!buffer.IsEmpty() && node::Buffer::HasInstance(buffer)) {
+    view->CopyFromSurface(
+        gfx::Rect(rect.origin(), view_size), bitmap_size,
+        base::BindOnce(&OnCapturePageToBufferDone,
+                       promise.As<gin::Handle<NativeImage>>(),
+                       v8::Global<v8::Value>(args->isolate(), buffer),
+                       std::move(capture_handle)));
+    return handle;
+  }
 
   view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
                         base::BindOnce(&OnCapturePageDone, std::move(promise),
@@ -3594,8 +4542,39 @@ bool WebContents::IsOffScreen() const {
   return type_ == Type::kOffScreen;
 }
 
-void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
-  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+void WebContents::OnPaint(
+    const gfx::Rect& dirty_rect,
+    const SkBitmap& bitmap,
+    const std::optional<OffscreenSharedTextureValue>& texture) {
+  if (!texture && offscreen_atlas_) {
+    offscreen_atlas_->OnPaint(ID(), dirty_rect, bitmap);
+    return;
+  }
+
+  if (!texture && offscreen_dirty_rect_only_) {
+    // Copy out only the pixels that changed, so that the cost of a paint is
+    // proportional to the size of the change rather than of the frame.
+    SkBitmap dirty_bitmap;
+    if (!dirty_rect.IsEmpty() &&
+        dirty_bitmap.tryAllocPixels(
+            bitmap.info().makeWH(dirty_rect.width(), dirty_rect.height())) &&
+        !bitmap.readPixels(dirty_bitmap.pixmap(), dirty_rect.x(),
+                           dirty_rect.y())) {
+      dirty_bitmap.reset();
+    }
+    Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(dirty_bitmap));
+    return;
+  }
+
+  if (!texture) {
+    Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+    return;
+  }
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("paint", dirty_rect, gfx::Image(),
+       CreateOffscreenSharedTexture(isolate, *texture));
 }
 
 void WebContents::StartPainting() {
@@ -3616,9 +4595,42 @@ bool WebContents::IsPainting() const {
 }
 
 void WebContents::SetFrameRate(int frame_rate) {
+  uncapped_frame_rate_ = frame_rate;
+  ApplyOffscreenFrameRate();
+}
+
+void WebContents::ApplyOffscreenFrameRate() {
   auto* osr_wcv = GetOffScreenWebContentsView();
-  if (osr_wcv)
-    osr_wcv->SetFrameRate(frame_rate);
+  if (!osr_wcv)
+    return;
+  const std::optional<int>& cap =
+      PowerPolicy::GetInstance()->actions().max_offscreen_frame_rate;
+  if (!cap && !uncapped_frame_rate_)
+    return;
+  if (!uncapped_frame_rate_)
+    uncapped_frame_rate_ = osr_wcv->GetFrameRate();
+  osr_wcv->SetFrameRate(cap ? std::min(*uncapped_frame_rate_, *cap)
+                            : *uncapped_frame_rate_);
+}
+
+void WebContents::OnPowerPolicyChanged() {
+  if (!web_contents())
+    return;
+  UpdateHiddenPageThrottler();
+  if (IsOffScreen())
+    ApplyOffscreenFrameRate();
+}
+
+bool WebContents::SetOffscreenAtlas(base::WeakPtr<OffscreenAtlas> atlas,
+                                    base::TimeTicks vsync_timebase) {
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (!osr_wcv || osr_wcv->offscreen_use_shared_texture())
+    return false;
+  if (offscreen_atlas_ && offscreen_atlas_.get() != atlas.get())
+    offscreen_atlas_->OnWebContentsRemoved(ID());
+  offscreen_atlas_ = std::move(atlas);
+  osr_wcv->SetVSyncTimebase(vsync_timebase);
+  return true;
 }
 
 int WebContents::GetFrameRate() const {
@@ -3874,6 +4886,53 @@ v8::Local<v8::Promise> WebContents::GetProcessMemoryInfo(v8::Isolate* isolate) {
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::GetMemoryBreakdown(v8::Isolate* isolate) {
+  gin_helper::Promise<gin_helper::Dictionary> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage(
+        "Failed to measure memory with nonexistent render frame");
+    return handle;
+  }
+
+  std::vector<content::RenderFrameHost*> frames;
+  web_contents()->ForEachRenderFrameHost(
+      [&frames](content::RenderFrameHost* frame) {
+        if (frame->IsRenderFrameLive())
+          frames.push_back(frame);
+      });
+
+  MemoryBreakdown breakdown;
+  breakdown.pid = frame_host->GetProcess()->GetProcess().Pid();
+  breakdown.web_contents_count =
+      CountWebContentsInProcess(frame_host->GetProcess());
+  auto barrier = base::BarrierCallback<mojom::FrameMemoryUsagePtr>(
+      frames.size(),
+      base::BindOnce(&OnFramesMeasured, std::move(promise), breakdown));
+  for (content::RenderFrameHost* frame : frames) {
+    // Kept alive until the frame replied, frames that go away before that
+    // count as using no memory.
+    auto electron_renderer =
+        std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+    frame->GetRemoteInterfaces()->GetInterface(
+        electron_renderer->BindNewPipeAndPassReceiver());
+    auto* raw_ptr = electron_renderer.get();
+    (*raw_ptr)->MeasureMemory(mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+        base::BindOnce(
+            [](std::unique_ptr<mojo::Remote<mojom::ElectronRenderer>>,
+               base::RepeatingCallback<void(mojom::FrameMemoryUsagePtr)>
+                   barrier,
+               mojom::FrameMemoryUsagePtr usage) {
+              barrier.Run(std::move(usage));
+            },
+            std::move(electron_renderer), barrier),
+        mojom::FrameMemoryUsage::New()));
+  }
+  return handle;
+}
+
 v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
     v8::Isolate* isolate,
     const base::FilePath& file_path) {
@@ -3932,6 +4991,50 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::CollectJavaScriptCallStack(
+    v8::Isolate* isolate) {
+  gin_helper::Promise<gin_helper::Dictionary> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->GetProcess()->IsReady()) {
+    promise.RejectWithErrorMessage(
+        "Failed to collect call stack with nonexistent renderer process");
+    return handle;
+  }
+
+  // The interface is bound on the IO thread of the renderer process, unlike
+  // the interfaces of the frame, so it answers while the page is
+  // unresponsive.
+  auto diagnostics =
+      std::make_unique<mojo::Remote<mojom::ElectronRendererDiagnostics>>();
+  frame_host->GetProcess()->BindReceiver(
+      diagnostics->BindNewPipeAndPassReceiver());
+  auto* raw_ptr = diagnostics.get();
+  auto callback = base::BindOnce(
+      [](std::unique_ptr<mojo::Remote<mojom::ElectronRendererDiagnostics>>,
+         gin_helper::Promise<gin_helper::Dictionary> promise, bool collected,
+         const std::string& stack, const std::string& posted_from) {
+        if (!collected) {
+          promise.RejectWithErrorMessage(
+              "Failed to collect call stack, the renderer process is gone");
+          return;
+        }
+        v8::HandleScope handle_scope(promise.isolate());
+        auto dict = gin_helper::Dictionary::CreateEmpty(promise.isolate());
+        dict.Set("stack", stack);
+        dict.Set("postedFrom", posted_from);
+        promise.Resolve(dict);
+      },
+      std::move(diagnostics), std::move(promise));
+  (*raw_ptr)->CollectJavaScriptCallStack(
+      base::BindOnce(mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                         std::move(callback), false, std::string(),
+                         std::string()),
+                     true));
+  return handle;
+}
+
 void WebContents::UpdatePreferredSize(content::WebContents* web_contents,
                                       const gfx::Size& pref_size) {
   Emit("preferred-size-changed", pref_size);
@@ -4333,14 +5436,8 @@ void WebContents::UpdateHtmlApiFullscreen(bool fullscreen) {
 // static
 void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                                      v8::Local<v8::ObjectTemplate> templ) {
-  gin::InvokerOptions options;
-  options.holder_is_first_argument = true;
-  options.holder_type = GetClassName();
-  templ->Set(
-      gin::StringToSymbol(isolate, "isDestroyed"),
-      gin::CreateFunctionTemplate(
-          isolate, base::BindRepeating(&gin_helper::Destroyable::IsDestroyed),
-          options));
+  templ->Set(gin::StringToSymbol(isolate, "isDestroyed"),
+             gin_helper::Destroyable::GetIsDestroyedTemplate(isolate));
   // We use gin_helper::ObjectTemplateBuilder instead of
   // gin::ObjectTemplateBuilder here to handle the fact that WebContents is
   // destroyable.
@@ -4351,6 +5448,12 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
                  &WebContents::GetBackgroundThrottling)
       .SetMethod("setBackgroundThrottling",
                  &WebContents::SetBackgroundThrottling)
+      .SetMethod("setBackgroundThrottlingPolicy",
+                 &WebContents::SetBackgroundThrottlingPolicy)
+      .SetMethod("freeze", &WebContents::Freeze)
+      .SetMethod("resume", &WebContents::Resume)
+      .SetMethod("isFrozen", &WebContents::IsFrozen)
+      .SetMethod("setAutoFreezeDelay", &WebContents::SetAutoFreezeDelay)
       .SetMethod("getProcessId", &WebContents::GetProcessID)
       .SetMethod("getOSProcessId", &WebContents::GetOSProcessID)
       .SetMethod("equal", &WebContents::Equal)
@@ -4380,9 +5483,15 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("isCrashed", &WebContents::IsCrashed)
       .SetMethod("forcefullyCrashRenderer",
                  &WebContents::ForcefullyCrashRenderer)
+      .SetMethod("discard", &WebContents::Discard)
+      .SetMethod("isDiscarded", &WebContents::IsDiscarded)
+      .SetMethod("setAutoDiscardable", &WebContents::SetAutoDiscardable)
+      .SetMethod("isAutoDiscardable", &WebContents::IsAutoDiscardable)
       .SetMethod("setUserAgent", &WebContents::SetUserAgent)
       .SetMethod("getUserAgent", &WebContents::GetUserAgent)
-      .SetMethod("savePage", &WebContents::SavePage)
+      .SetMethod("_savePage", &WebContents::SavePage)
+      .SetMethod("generateMHTML", &WebContents::GenerateMHTML)
+      .SetMethod("_getSubresourceURLs", &WebContents::GetSubresourceURLs)
       .SetMethod("openDevTools", &WebContents::OpenDevTools)
       .SetMethod("closeDevTools", &WebContents::CloseDevTools)
       .SetMethod("isDevToolsOpened", &WebContents::IsDevToolsOpened)
@@ -4418,7 +5527,11 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("focus", &WebContents::Focus)
       .SetMethod("isFocused", &WebContents::IsFocused)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
+      .SetMethod("setInputQueue", &WebContents::SetInputQueue)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
+      .SetMethod("beginEncodedFrameSubscription",
+                 &WebContents::BeginEncodedFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
@@ -4431,9 +5544,9 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
-      .SetMethod("getZoomLevel", &WebContents::GetZoomLevel)
+      .SetFastMethod<&WebContents::GetZoomLevel>("getZoomLevel")
       .SetMethod("setZoomFactor", &WebContents::SetZoomFactor)
-      .SetMethod("getZoomFactor", &WebContents::GetZoomFactor)
+      .SetFastMethod<&WebContents::GetZoomFactor>("getZoomFactor")
       .SetMethod("getType", &WebContents::type)
       .SetMethod("_getPreloadPaths", &WebContents::GetPreloadPaths)
       .SetMethod("getLastWebPreferences", &WebContents::GetLastWebPreferences)
@@ -4449,6 +5562,7 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
 #endif
       .SetMethod("_setNextChildWebPreferences",
                  &WebContents::SetNextChildWebPreferences)
+      .SetMethod("_setWindowOpenRules", &WebContents::SetWindowOpenRules)
       .SetMethod("addWorkSpace", &WebContents::AddWorkSpace)
       .SetMethod("removeWorkSpace", &WebContents::RemoveWorkSpace)
       .SetMethod("showDefinitionForSelection",
@@ -4470,7 +5584,10 @@ void WebContents::FillObjectTemplate(v8::Isolate* isolate,
       .SetMethod("setImageAnimationPolicy",
                  &WebContents::SetImageAnimationPolicy)
       .SetMethod("_getProcessMemoryInfo", &WebContents::GetProcessMemoryInfo)
-      .SetProperty("id", &WebContents::ID)
+      .SetMethod("getMemoryBreakdown", &WebContents::GetMemoryBreakdown)
+      .SetMethod("collectJavaScriptCallStack",
+                 &WebContents::CollectJavaScriptCallStack)
+      .SetFastProperty<&WebContents::ID>("id")
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
       .SetProperty("devToolsWebContents", &WebContents::DevToolsWebContents)
@@ -4633,6 +5750,26 @@ std::vector<gin::Handle<WebContents>> GetAllWebContentsAsV8(
   return list;
 }
 
+void SetIpcChannelPriority(const std::string& channel, bool low) {
+  using Priority = electron::ElectronApiIPCHandlerImpl::ChannelPriority;
+  electron::ElectronApiIPCHandlerImpl::SetChannelPriority(
+      channel, low ? Priority::kLow : Priority::kNormal);
+}
+
+std::vector<gin_helper::Dictionary> GetIpcStats(v8::Isolate* isolate) {
+  std::vector<gin_helper::Dictionary> list;
+  for (const auto& [channel, stats] :
+       electron::ElectronApiIPCHandlerImpl::GetChannelStats()) {
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("channel", channel);
+    dict.Set("messages", static_cast<double>(stats.messages));
+    dict.Set("bytes", static_cast<double>(stats.bytes));
+    dict.Set("handlerTime", stats.handler_time.InMillisecondsF());
+    list.push_back(dict);
+  }
+  return list;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -4644,6 +5781,10 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("fromFrame", &WebContentsFromFrame);
   dict.SetMethod("fromDevToolsTargetId", &WebContentsFromDevToolsTargetID);
   dict.SetMethod("getAllWebContents", &GetAllWebContentsAsV8);
+  dict.SetMethod("_setIpcChannelPriority", &SetIpcChannelPriority);
+  dict.SetMethod("_getIpcStats", &GetIpcStats);
+  dict.SetMethod("_resetIpcStats",
+                 &electron::ElectronApiIPCHandlerImpl::ResetChannelStats);
 }
 
 }  // namespace
@@ -8,17 +8,22 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/raw_ptr_exclusion.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/scoped_observation.h"
 #include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/devtools/devtools_eye_dropper.h"
 #include "chrome/browser/devtools/devtools_file_system_indexer.h"
 #include "chrome/browser/ui/exclusive_access/exclusive_access_context.h"  // nogncheck
@@ -33,6 +38,7 @@
 #include "content/public/browser/web_contents_observer.h"
 #include "electron/buildflags/buildflags.h"
 #include "electron/shell/common/api/api.mojom.h"
+#include "extensions/common/url_pattern.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
@@ -42,6 +48,9 @@
 #include "shell/browser/background_throttling_source.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/extended_web_contents_observer.h"
+#include "shell/browser/hidden_page_throttler.h"
+#include "shell/browser/osr/osr_paint_event.h"
+#include "shell/browser/power_policy.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/ui/inspectable_web_contents_delegate.h"
 #include "shell/browser/ui/inspectable_web_contents_view_delegate.h"
@@ -52,6 +61,7 @@
 #include "ui/base/cursor/cursor.h"
 #include "ui/base/models/image_model.h"
 #include "ui/gfx/image/image.h"
+#include "url/gurl.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
 #include "components/printing/browser/print_to_pdf/pdf_print_result.h"
@@ -67,6 +77,8 @@ class ScriptExecutor;
 #endif
 
 namespace blink {
+class WebMouseEvent;
+class WebMouseWheelEvent;
 struct DeviceEmulationParams;
 // enum class PermissionType;
 }  // namespace blink
@@ -83,11 +95,11 @@ namespace gin {
 class Arguments;
 }
 
-class SkRegion;
-
 namespace electron {
 
+class DraggableRegionIndex;
 class ElectronBrowserContext;
+class InputEventQueue;
 class InspectableWebContents;
 class WebContentsZoomController;
 class WebViewGuestDelegate;
@@ -100,6 +112,7 @@ class OffScreenWebContentsView;
 namespace api {
 
 class BaseWindow;
+class OffscreenAtlas;
 
 // Wrapper around the content::WebContents.
 class WebContents : public ExclusiveAccessContext,
@@ -114,7 +127,8 @@ class WebContents : public ExclusiveAccessContext,
                     public content::JavaScriptDialogManager,
                     public InspectableWebContentsDelegate,
                     public InspectableWebContentsViewDelegate,
-                    public BackgroundThrottlingSource {
+                    public BackgroundThrottlingSource,
+                    public PowerPolicy::Observer {
  public:
   enum class Type {
     kBackgroundPage,  // An extension background page.
@@ -171,6 +185,16 @@ class WebContents : public ExclusiveAccessContext,
 
   bool GetBackgroundThrottling() const override;
   void SetBackgroundThrottling(bool allowed);
+  void SetBackgroundThrottlingPolicy(gin::Arguments* args);
+  // Puts a hidden page in the frozen lifecycle state, where none of its
+  // timers or tasks run, until it is resumed or shown.
+  bool Freeze();
+  void Resume();
+  bool IsFrozen() const override { return frozen_; }
+  void SetAutoFreezeDelay(gin::Arguments* args);
+  // Starts or stops the HiddenPageThrottler for the visibility of the page and
+  // the policy of the page or of its session.
+  void UpdateHiddenPageThrottler();
   int GetProcessID() const;
   base::ProcessId GetOSProcessID() const;
   [[nodiscard]] Type type() const { return type_; }
@@ -204,11 +228,25 @@ class WebContents : public ExclusiveAccessContext,
   std::string GetMediaSourceID(content::WebContents* request_web_contents);
   bool IsCrashed() const;
   void ForcefullyCrashRenderer();
+  // Shuts down the renderer process of a hidden page, the page is loaded
+  // again from its navigation state when it is shown.
+  bool Discard();
+  bool IsDiscarded() const { return discarded_; }
+  void SetAutoDiscardable(bool auto_discardable);
+  bool IsAutoDiscardable() const { return !!memory_pressure_listener_; }
   void SetUserAgent(const std::string& user_agent);
   std::string GetUserAgent();
   void InsertCSS(const std::string& css);
   v8::Local<v8::Promise> SavePage(const base::FilePath& full_file_path,
-                                  const content::SavePageType& save_type);
+                                  const content::SavePageType& save_type,
+                                  gin::Arguments* args);
+  // Has the renderers serialize the page to a single MHTML file, which they
+  // write to directly instead of sending the data to the browser process.
+  v8::Local<v8::Promise> GenerateMHTML(const base::FilePath& file_path,
+                                       gin::Arguments* args);
+  // The URLs of the subresources loaded by the current document and its
+  // frames, which savePage() fetches ahead in parallel.
+  std::vector<GURL> GetSubresourceURLs() const;
   void OpenDevTools(gin::Arguments* args);
   void CloseDevTools();
   bool IsDevToolsOpened();
@@ -243,12 +281,19 @@ class WebContents : public ExclusiveAccessContext,
   // Print current page as PDF.
   v8::Local<v8::Promise> PrintToPDF(const base::Value& settings);
   void OnPDFCreated(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                    const base::FilePath& path,
+                    bool stream,
+                    base::TimeTicks start,
                     print_to_pdf::PdfPrintResult print_result,
                     scoped_refptr<base::RefCountedMemory> data);
 #endif
 
   void SetNextChildWebPreferences(const gin_helper::Dictionary);
 
+  // Set by webContents.setWindowOpenRules(), which keeps the options of the
+  // 'allow' rules in JS.
+  void SetWindowOpenRules(gin::Arguments* args);
+
   // DevTools workspace api.
   void AddWorkSpace(gin::Arguments* args, const base::FilePath& path);
   void RemoveWorkSpace(gin::Arguments* args, const base::FilePath& path);
@@ -280,9 +325,17 @@ class WebContents : public ExclusiveAccessContext,
 
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
+  // Sends a batch of mouse and wheel events encoded in a Float64Array,
+  // returns how many were delivered after coalescing.
+  size_t SendInputEvents(gin::Arguments* args);
+  void SetInputQueue(gin::Arguments* args);
 
   // Subscribe to the frame updates.
   void BeginFrameSubscription(gin::Arguments* args);
+  void BeginEncodedFrameSubscription(
+      gin_helper::ErrorThrower thrower,
+      const gin_helper::Dictionary& options,
+      const FrameSubscriber::EncodedFrameCallback& callback);
   void EndFrameSubscription();
 
   // Dragging native items.
@@ -300,13 +353,19 @@ class WebContents : public ExclusiveAccessContext,
 
   // Methods for offscreen rendering
   bool IsOffScreen() const;
-  void OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap);
+  void OnPaint(const gfx::Rect& dirty_rect,
+               const SkBitmap& bitmap,
+               const std::optional<OffscreenSharedTextureValue>& texture);
   void StartPainting();
   void StopPainting();
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
   void Invalidate();
+  // Sends the frames to |atlas| instead of emitting paint events, or stops
+  // when it is null. Returns false if the frames are shared textures.
+  bool SetOffscreenAtlas(base::WeakPtr<OffscreenAtlas> atlas,
+                         base::TimeTicks vsync_timebase);
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
 
   // Methods for zoom handling.
@@ -329,6 +388,11 @@ class WebContents : public ExclusiveAccessContext,
                       const std::string& features,
                       const scoped_refptr<network::ResourceRequestBody>& body);
 
+  // Applies the first window open rule that matches |url|. Returns true when
+  // the rule decided the new window natively, otherwise sets |allow_rule| to
+  // the index of the matching 'allow' rule, or -1 when no rule matched.
+  bool ApplyWindowOpenRules(const GURL& url, int* allow_rule);
+
   // Returns the preload script path of current WebContents.
   std::vector<base::FilePath> GetPreloadPaths() const;
 
@@ -344,6 +408,8 @@ class WebContents : public ExclusiveAccessContext,
   v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
                                           const base::FilePath& file_path);
   v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
+  v8::Local<v8::Promise> GetMemoryBreakdown(v8::Isolate* isolate);
+  v8::Local<v8::Promise> CollectJavaScriptCallStack(v8::Isolate* isolate);
 
   bool HandleContextMenu(content::RenderFrameHost& render_frame_host,
                          const content::ContextMenuParams& params) override;
@@ -479,7 +545,7 @@ class WebContents : public ExclusiveAccessContext,
 
   void SetBackgroundColor(std::optional<SkColor> color);
 
-  SkRegion* draggable_region() {
+  const DraggableRegionIndex* draggable_region() const {
     return force_non_draggable_ ? nullptr : draggable_region_.get();
   }
 
@@ -505,6 +571,21 @@ class WebContents : public ExclusiveAccessContext,
   // Delete this if garbage collection has not started.
   void DeleteThisIfAlive();
 
+  // Loads the page again if it was discarded.
+  void RestoreIfDiscarded();
+  // Starts or stops the timer of webContents.setAutoFreezeDelay() for the
+  // visibility of the page.
+  void UpdateAutoFreezeTimer();
+  void OnAutoFreezeTimer();
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+  // Sets the frame rate of the offscreen page to the one set with
+  // setFrameRate(), capped by the power policy.
+  void ApplyOffscreenFrameRate();
+
+  // PowerPolicy::Observer:
+  void OnPowerPolicyChanged() override;
+
   // Creates a InspectableWebContents object and takes ownership of
   // |web_contents|.
   void InitWithWebContents(std::unique_ptr<content::WebContents> web_contents,
@@ -640,6 +721,10 @@ class WebContents : public ExclusiveAccessContext,
                    int error_code) override;
   void DidStartLoading() override;
   void DidStopLoading() override;
+  void ResourceLoadComplete(
+      content::RenderFrameHost* render_frame_host,
+      const content::GlobalRequestID& request_id,
+      const blink::mojom::ResourceLoadInfo& resource_load_info) override;
   void DidStartNavigation(
       content::NavigationHandle* navigation_handle) override;
   void DidRedirectNavigation(
@@ -670,6 +755,7 @@ class WebContents : public ExclusiveAccessContext,
       content::RenderWidgetHost* render_widget_host) override;
   void OnWebContentsLostFocus(
       content::RenderWidgetHost* render_widget_host) override;
+  void OnVisibilityChanged(content::Visibility visibility) override;
 
   // InspectableWebContentsDelegate:
   void DevToolsReloadPage() override;
@@ -687,6 +773,14 @@ class WebContents : public ExclusiveAccessContext,
   OffScreenWebContentsView* GetOffScreenWebContentsView() const;
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView() const;
 
+  // Returns false if there is no view to send |events| to.
+  bool SendMouseEvents(
+      std::vector<std::unique_ptr<blink::WebMouseEvent>> events);
+  void SendMouseEvent(content::RenderWidgetHost* rwh,
+                      const blink::WebMouseEvent& mouse_event);
+  void SendMouseWheelEvent(content::RenderWidgetHost* rwh,
+                           blink::WebMouseWheelEvent mouse_wheel_event);
+
   // Called when received a synchronous message from renderer to
   // get the zoom level.
   void OnGetZoomLevel(content::RenderFrameHost* frame_host,
@@ -816,6 +910,33 @@ class WebContents : public ExclusiveAccessContext,
   // Whether background throttling is disabled.
   bool background_throttling_ = true;
 
+  // Set by webContents.setBackgroundThrottlingPolicy(), overrides the policy
+  // of the session.
+  std::optional<BackgroundThrottlingPolicy> background_throttling_policy_;
+  std::unique_ptr<HiddenPageThrottler> hidden_page_throttler_;
+
+  // The frame rate the offscreen page runs at when the power policy does not
+  // cap it, known once the policy capped it or setFrameRate() was called.
+  std::optional<int> uncapped_frame_rate_;
+  base::ScopedObservation<PowerPolicy, PowerPolicy::Observer>
+      power_policy_observation_{this};
+
+  // See GetSubresourceURLs(), cleared when the primary main frame navigates
+  // to another document.
+  std::set<GURL> subresource_urls_;
+
+  // Whether the page was frozen by webContents.freeze() or after it was
+  // hidden for |auto_freeze_delay_|.
+  bool frozen_ = false;
+  std::optional<base::TimeDelta> auto_freeze_delay_;
+  base::OneShotTimer auto_freeze_timer_;
+
+  // Whether the renderer process was shut down by webContents.discard().
+  bool discarded_ = false;
+  // Set by webContents.setAutoDiscardable(), discards the page when it is
+  // hidden under critical memory pressure.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   // Whether to enable devtools.
   bool enable_devtools_ = true;
 
@@ -824,11 +945,33 @@ class WebContents : public ExclusiveAccessContext,
 
   v8::Global<v8::Value> pending_child_web_preferences_;
 
+  struct WindowOpenRule {
+    enum class Action { kAllow, kDeny, kOpenExternal };
+
+    WindowOpenRule();
+    WindowOpenRule(const WindowOpenRule&);
+    WindowOpenRule& operator=(const WindowOpenRule&);
+    ~WindowOpenRule();
+
+    std::vector<URLPattern> urls;
+    Action action = Action::kAllow;
+  };
+  std::vector<WindowOpenRule> window_open_rules_;
+
   // The window that this WebContents belongs to.
   base::WeakPtr<NativeWindow> owner_window_;
 
   bool offscreen_ = false;
 
+  // Whether offscreen paint events only carry the pixels of the dirty rect.
+  bool offscreen_dirty_rect_only_ = false;
+
+  // Where the offscreen frames are painted instead, if anywhere.
+  base::WeakPtr<OffscreenAtlas> offscreen_atlas_;
+
+  // Set by setInputQueue(), forwards the events written to it.
+  std::unique_ptr<InputEventQueue> input_event_queue_;
+
   // Whether window is fullscreened by HTML5 api.
   bool html_fullscreen_ = false;
 
@@ -875,7 +1018,7 @@ class WebContents : public ExclusiveAccessContext,
   // Stores the frame thats currently in fullscreen, nullptr if there is none.
   raw_ptr<content::RenderFrameHost> fullscreen_frame_ = nullptr;
 
-  std::unique_ptr<SkRegion> draggable_region_;
+  std::unique_ptr<DraggableRegionIndex> draggable_region_;
 
   bool force_non_draggable_ = false;
 
@@ -9,6 +9,7 @@
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/native_window.h"
+#include "shell/browser/ui/draggable_region_index.h"
 #include "shell/browser/ui/inspectable_web_contents_view.h"
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/common/gin_converters/gfx_converter.h"
@@ -18,7 +19,6 @@
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
-#include "third_party/skia/include/core/SkRegion.h"
 #include "ui/base/hit_test.h"
 #include "ui/views/layout/flex_layout_types.h"
 #include "ui/views/view_class_properties.h"
@@ -69,8 +69,8 @@ int WebContentsView::NonClientHitTest(const gfx::Point& point) {
   if (api_web_contents_) {
     gfx::Point local_point(point);
     views::View::ConvertPointFromWidget(view(), &local_point);
-    SkRegion* region = api_web_contents_->draggable_region();
-    if (region && region->contains(local_point.x(), local_point.y()))
+    const DraggableRegionIndex* region = api_web_contents_->draggable_region();
+    if (region && region->Contains(local_point.x(), local_point.y()))
       return HTCAPTION;
   }
 
@@ -90,10 +90,14 @@ void WebContentsView::OnViewAddedToWidget(views::View* observed_view) {
   if (!native_window)
     return;
   native_window->AddDraggableRegionProvider(this);
+  if (native_window->defer_content_resize())
+    window_observation_.Observe(native_window);
 }
 
 void WebContentsView::OnViewRemovedFromWidget(views::View* observed_view) {
   DCHECK_EQ(observed_view, view());
+  window_observation_.Reset();
+  SetFastResize(false);
   views::Widget* widget = view()->GetWidget();
   auto* native_window = static_cast<NativeWindow*>(
       widget->GetNativeWindowProperty(kElectronNativeWindowKey));
@@ -102,6 +106,34 @@ void WebContentsView::OnViewRemovedFromWidget(views::View* observed_view) {
   native_window->RemoveDraggableRegionProvider(this);
 }
 
+void WebContentsView::OnWindowWillResize(const gfx::Rect& new_bounds,
+                                         const gfx::ResizeEdge& edge,
+                                         bool* prevent_default) {
+  SetFastResize(true);
+  // Resizing the web contents while the user holds the border still keeps
+  // the page from looking stretched or clipped for long.
+  fast_resize_timer_.Start(
+      FROM_HERE, base::Milliseconds(100),
+      base::BindOnce(&WebContentsView::SetFastResize, base::Unretained(this),
+                     false));
+}
+
+void WebContentsView::OnWindowResized() {
+  fast_resize_timer_.Stop();
+  SetFastResize(false);
+}
+
+void WebContentsView::OnWindowClosed() {
+  fast_resize_timer_.Stop();
+  window_observation_.Reset();
+}
+
+void WebContentsView::SetFastResize(bool fast_resize) {
+  if (api_web_contents_)
+    api_web_contents_->inspectable_web_contents()->GetView()->SetFastResize(
+        fast_resize);
+}
+
 // static
 gin::Handle<WebContentsView> WebContentsView::Create(
     v8::Isolate* isolate,
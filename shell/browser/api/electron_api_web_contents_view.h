@@ -8,9 +8,13 @@
 #include <optional>
 
 #include "base/memory/raw_ptr.h"
+#include "base/scoped_observation.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "shell/browser/api/electron_api_view.h"
 #include "shell/browser/draggable_region_provider.h"
+#include "shell/browser/native_window.h"
+#include "shell/browser/native_window_observer.h"
 
 namespace gin_helper {
 class Dictionary;
@@ -22,6 +26,7 @@ class WebContents;
 
 class WebContentsView : public View,
                         public content::WebContentsObserver,
+                        public NativeWindowObserver,
                         public DraggableRegionProvider {
  public:
   // Create a new instance of WebContentsView.
@@ -54,12 +59,26 @@ class WebContentsView : public View,
   void OnViewAddedToWidget(views::View* view) override;
   void OnViewRemovedFromWidget(views::View* view) override;
 
+  // NativeWindowObserver:
+  void OnWindowWillResize(const gfx::Rect& new_bounds,
+                          const gfx::ResizeEdge& edge,
+                          bool* prevent_default) override;
+  void OnWindowResized() override;
+  void OnWindowClosed() override;
+
  private:
   static gin_helper::WrappableBase* New(gin_helper::Arguments* args);
 
+  void SetFastResize(bool fast_resize);
+
   // Keep a reference to v8 wrapper.
   v8::Global<v8::Value> web_contents_;
   raw_ptr<api::WebContents> api_web_contents_;
+
+  // Ends the fast resize when the user stops moving the window border.
+  base::OneShotTimer fast_resize_timer_;
+  base::ScopedObservation<NativeWindow, NativeWindowObserver>
+      window_observation_{this};
 };
 
 }  // namespace electron::api
@@ -240,9 +240,11 @@ void WebFrameMain::PostMessage(v8::Isolate* isolate,
                                const std::string& channel,
                                v8::Local<v8::Value> message_value,
                                std::optional<v8::Local<v8::Value>> transfer) {
+  // TransferableMessages are only read in the V8 format.
   blink::TransferableMessage transferable_message;
   if (!electron::SerializeV8Value(isolate, message_value,
-                                  &transferable_message)) {
+                                  &transferable_message,
+                                  electron::SerializationFormat::kV8Only)) {
     // SerializeV8Value sets an exception.
     return;
   }
@@ -4,16 +4,22 @@
 
 #include "shell/browser/api/electron_api_web_request.h"
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "base/containers/contains.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/containers/flat_map.h"
 #include "base/memory/raw_ptr.h"
 #include "base/stl_util.h"
+#include "base/strings/string_util.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/types/optional_util.h"
 #include "base/values.h"
 #include "extensions/browser/api/web_request/web_request_resource_type.h"
 #include "gin/converter.h"
@@ -32,6 +38,7 @@
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
 
 static constexpr auto ResourceTypes =
     base::MakeFixedFlatMap<std::string_view,
@@ -92,7 +99,7 @@ extensions::WebRequestResourceType ParseResourceType(std::string_view value) {
 // to pass the original keys.
 v8::Local<v8::Value> HttpResponseHeadersToV8(
     net::HttpResponseHeaders* headers) {
-  base::Value::Dict response_headers;
+  base::flat_map<std::string, std::vector<std::string>> response_headers;
   if (headers) {
     size_t iter = 0;
     std::string key;
@@ -114,15 +121,54 @@ v8::Local<v8::Value> HttpResponseHeadersToV8(
         std::string filename = "\"" + header.filename() + "\"";
         value = decodedFilename + "; filename=" + filename;
       }
-      response_headers.EnsureList(key)->Append(value);
+      response_headers[key].push_back(std::move(value));
     }
   }
-  return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
+
+  // Built directly rather than through a base::Value, which matters for
+  // requests that have many headers.
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Object> dict = v8::Object::New(isolate);
+  for (const auto& [name, values] : response_headers) {
+    dict->CreateDataProperty(context, gin::StringToV8(isolate, name),
+                             gin::ConvertToV8(isolate, values))
+        .Check();
+  }
+  return dict;
 }
 
+// The |details| object passed to the listeners, which only gets the fields
+// they asked for so that the others are not converted.
+class Details : public gin_helper::Dictionary {
+ public:
+  Details(v8::Isolate* isolate,
+          const base::flat_set<std::string>* fields = nullptr)
+      : gin_helper::Dictionary(isolate, v8::Object::New(isolate)),
+        fields_(fields) {}
+
+  bool Wants(std::string_view key) const {
+    return !fields_ || base::Contains(*fields_, key);
+  }
+
+  template <typename V>
+  void Set(std::string_view key, const V& val) {
+    if (Wants(key))
+      gin_helper::Dictionary::Set(key, val);
+  }
+
+  template <typename V>
+  void SetGetter(std::string_view key, const V& val) {
+    if (Wants(key))
+      gin_helper::Dictionary::SetGetter(key, val);
+  }
+
+ private:
+  raw_ptr<const base::flat_set<std::string>> fields_;
+};
+
 // Overloaded by multiple types to fill the |details| object.
-void ToDictionary(gin_helper::Dictionary* details,
-                  extensions::WebRequestInfo* info) {
+void ToDictionary(Details* details, extensions::WebRequestInfo* info) {
   details->Set("id", info->id);
   details->Set("url", info->url);
   details->Set("method", info->method);
@@ -135,8 +181,10 @@ void ToDictionary(gin_helper::Dictionary* details,
     details->Set("fromCache", info->response_from_cache);
     details->Set("statusLine", info->response_headers->GetStatusLine());
     details->Set("statusCode", info->response_headers->response_code());
-    details->Set("responseHeaders",
-                 HttpResponseHeadersToV8(info->response_headers.get()));
+    if (details->Wants("responseHeaders")) {
+      details->Set("responseHeaders",
+                   HttpResponseHeadersToV8(info->response_headers.get()));
+    }
   }
 
   auto* render_frame_host = content::RenderFrameHost::FromID(
@@ -153,34 +201,32 @@ void ToDictionary(gin_helper::Dictionary* details,
   }
 }
 
-void ToDictionary(gin_helper::Dictionary* details,
-                  const network::ResourceRequest& request) {
+void ToDictionary(Details* details, const network::ResourceRequest& request) {
   details->Set("referrer", request.referrer);
   if (request.request_body)
     details->Set("uploadData", *request.request_body);
 }
 
-void ToDictionary(gin_helper::Dictionary* details,
-                  const net::HttpRequestHeaders& headers) {
+void ToDictionary(Details* details, const net::HttpRequestHeaders& headers) {
   details->Set("requestHeaders", headers);
 }
 
-void ToDictionary(gin_helper::Dictionary* details, const GURL& location) {
+void ToDictionary(Details* details, const GURL& location) {
   details->Set("redirectURL", location);
 }
 
-void ToDictionary(gin_helper::Dictionary* details, int net_error) {
+void ToDictionary(Details* details, int net_error) {
   details->Set("error", net::ErrorToString(net_error));
 }
 
 // Helper function to fill |details| with arbitrary |args|.
 template <typename Arg>
-void FillDetails(gin_helper::Dictionary* details, Arg arg) {
+void FillDetails(Details* details, Arg arg) {
   ToDictionary(details, arg);
 }
 
 template <typename Arg, typename... Args>
-void FillDetails(gin_helper::Dictionary* details, Arg arg, Args... args) {
+void FillDetails(Details* details, Arg arg, Args... args) {
   ToDictionary(details, arg);
   FillDetails(details, args...);
 }
@@ -218,6 +264,44 @@ void ReadFromResponse(v8::Isolate* isolate,
   }
 }
 
+// Runs the transform function returned by an |onResponseBody| listener.
+class JSResponseBodyTransform : public ResponseBodyTransform {
+ public:
+  using PushCallback = base::OnceCallback<void(v8::Local<v8::Value>)>;
+  using TransformFunction =
+      base::RepeatingCallback<void(v8::Local<v8::Value>, PushCallback)>;
+
+  explicit JSResponseBodyTransform(TransformFunction function)
+      : function_(std::move(function)) {}
+
+  // ResponseBodyTransform:
+  void Transform(std::optional<std::string> chunk,
+                 OutputCallback callback) override {
+    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Value> value = v8::Null(isolate);
+    if (chunk) {
+      value = node::Buffer::Copy(isolate, chunk->data(), chunk->size())
+                  .ToLocalChecked();
+    }
+    function_.Run(value, base::BindOnce(&JSResponseBodyTransform::OnPush,
+                                        std::move(callback)));
+  }
+
+ private:
+  static void OnPush(OutputCallback callback, v8::Local<v8::Value> output) {
+    std::string data;
+    if (node::Buffer::HasInstance(output)) {
+      data.assign(node::Buffer::Data(output), node::Buffer::Length(output));
+    } else if (output->IsString()) {
+      gin::ConvertFromV8(JavascriptEnvironment::GetIsolate(), output, &data);
+    }
+    std::move(callback).Run(std::move(data));
+  }
+
+  TransformFunction function_;
+};
+
 }  // namespace
 
 gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -225,13 +309,48 @@ gin::WrapperInfo WebRequest::kWrapperInfo = {gin::kEmbedderNativeGin};
 WebRequest::RequestFilter::RequestFilter(
     std::set<URLPattern> url_patterns,
     std::set<extensions::WebRequestResourceType> types)
-    : url_patterns_(std::move(url_patterns)), types_(std::move(types)) {}
-WebRequest::RequestFilter::RequestFilter(const RequestFilter&) = default;
+    : url_patterns_(std::move(url_patterns)), types_(std::move(types)) {
+  RebuildIndex();
+}
+WebRequest::RequestFilter::RequestFilter(const RequestFilter& other)
+    : url_patterns_(other.url_patterns_), types_(other.types_) {
+  RebuildIndex();
+}
+WebRequest::RequestFilter& WebRequest::RequestFilter::operator=(
+    const RequestFilter& other) {
+  if (this != &other) {
+    url_patterns_ = other.url_patterns_;
+    types_ = other.types_;
+    RebuildIndex();
+  }
+  return *this;
+}
 WebRequest::RequestFilter::RequestFilter() = default;
 WebRequest::RequestFilter::~RequestFilter() = default;
 
 void WebRequest::RequestFilter::AddUrlPattern(URLPattern pattern) {
-  url_patterns_.emplace(std::move(pattern));
+  auto [iter, inserted] = url_patterns_.emplace(std::move(pattern));
+  if (inserted)
+    IndexUrlPattern(*iter);
+}
+
+void WebRequest::RequestFilter::IndexUrlPattern(const URLPattern& pattern) {
+  // The index holds pointers into |url_patterns_|, whose nodes never move.
+  // IPv6 literals are left to URLPattern, which knows how to compare them.
+  if (pattern.match_all_urls() || pattern.match_all_hosts() ||
+      pattern.host().empty() || pattern.host().front() == '[') {
+    url_patterns_for_any_host_.push_back(&pattern);
+  } else {
+    url_patterns_by_host_[base::ToLowerASCII(pattern.host())].push_back(
+        &pattern);
+  }
+}
+
+void WebRequest::RequestFilter::RebuildIndex() {
+  url_patterns_by_host_.clear();
+  url_patterns_for_any_host_.clear();
+  for (const auto& pattern : url_patterns_)
+    IndexUrlPattern(pattern);
 }
 
 void WebRequest::RequestFilter::AddType(
@@ -243,10 +362,30 @@ bool WebRequest::RequestFilter::MatchesURL(const GURL& url) const {
   if (url_patterns_.empty())
     return true;
 
-  for (const auto& pattern : url_patterns_) {
-    if (pattern.MatchesURL(url))
+  for (const URLPattern* pattern : url_patterns_for_any_host_) {
+    if (pattern->MatchesURL(url))
       return true;
   }
+
+  if (url_patterns_by_host_.empty())
+    return false;
+
+  // Look up the host and then each domain above it, since patterns like
+  // "*://*.example.com/*" also match the subdomains of their host.
+  std::string_view host = url.host_piece();
+  while (!host.empty()) {
+    auto iter = url_patterns_by_host_.find(host);
+    if (iter != url_patterns_by_host_.end()) {
+      for (const URLPattern* pattern : iter->second) {
+        if (pattern->MatchesURL(url))
+          return true;
+      }
+    }
+    size_t dot = host.find('.');
+    if (dot == std::string_view::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
   return false;
 }
 
@@ -257,7 +396,13 @@ bool WebRequest::RequestFilter::MatchesType(
 
 bool WebRequest::RequestFilter::MatchesRequest(
     extensions::WebRequestInfo* info) const {
-  return MatchesURL(info->url) && MatchesType(info->web_request_type);
+  return MatchesRequest(info->url, info->web_request_type);
+}
+
+bool WebRequest::RequestFilter::MatchesRequest(
+    const GURL& url,
+    extensions::WebRequestResourceType type) const {
+  return MatchesType(type) && MatchesURL(url);
 }
 
 WebRequest::SimpleListenerInfo::SimpleListenerInfo(RequestFilter filter_,
@@ -273,6 +418,14 @@ WebRequest::ResponseListenerInfo::ResponseListenerInfo(
 WebRequest::ResponseListenerInfo::ResponseListenerInfo() = default;
 WebRequest::ResponseListenerInfo::~ResponseListenerInfo() = default;
 
+WebRequest::Batch::Batch() = default;
+WebRequest::Batch::~Batch() = default;
+
+WebRequest::Rule::Rule() = default;
+WebRequest::Rule::Rule(const Rule&) = default;
+WebRequest::Rule& WebRequest::Rule::operator=(const Rule&) = default;
+WebRequest::Rule::~Rule() = default;
+
 WebRequest::WebRequest(v8::Isolate* isolate,
                        content::BrowserContext* browser_context)
     : browser_context_(browser_context) {
@@ -305,7 +458,11 @@ gin::ObjectTemplateBuilder WebRequest::GetObjectTemplateBuilder(
       .SetMethod("onErrorOccurred",
                  &WebRequest::SetSimpleListener<SimpleEvent::kOnErrorOccurred>)
       .SetMethod("onCompleted",
-                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>);
+                 &WebRequest::SetSimpleListener<SimpleEvent::kOnCompleted>)
+      .SetMethod(
+          "onResponseBody",
+          &WebRequest::SetResponseListener<ResponseEvent::kOnResponseBody>)
+      .SetMethod("setRules", &WebRequest::SetRules);
 }
 
 const char* WebRequest::GetTypeName() {
@@ -313,13 +470,59 @@ const char* WebRequest::GetTypeName() {
 }
 
 bool WebRequest::HasListener() const {
-  return !(simple_listeners_.empty() && response_listeners_.empty());
+  return !(simple_listeners_.empty() && response_listeners_.empty() &&
+           rules_.empty());
+}
+
+bool WebRequest::HasListenerForURL(const GURL& url) const {
+  for (const auto& [event, info] : simple_listeners_) {
+    if (info.filter.MatchesURL(url))
+      return true;
+  }
+  for (const auto& [event, info] : response_listeners_) {
+    if (info.filter.MatchesURL(url))
+      return true;
+  }
+  for (const auto& rule : rules_) {
+    if (rule.filter.MatchesURL(url))
+      return true;
+  }
+  return false;
+}
+
+bool WebRequest::HasListenerForWebSocket(const GURL& url) const {
+  constexpr auto kType = extensions::WebRequestResourceType::WEB_SOCKET;
+  for (const auto& [event, info] : simple_listeners_) {
+    if (info.filter.MatchesRequest(url, kType))
+      return true;
+  }
+  for (const auto& [event, info] : response_listeners_) {
+    if (info.filter.MatchesRequest(url, kType))
+      return true;
+  }
+  for (const auto& rule : rules_) {
+    if (rule.filter.MatchesRequest(url, kType))
+      return true;
+  }
+  return false;
 }
 
 int WebRequest::OnBeforeRequest(extensions::WebRequestInfo* info,
                                 const network::ResourceRequest& request,
                                 net::CompletionOnceCallback callback,
                                 GURL* new_url) {
+  for (const auto& rule : rules_) {
+    if (!rule.filter.MatchesRequest(info))
+      continue;
+    if (rule.action == Rule::Action::kBlock)
+      return net::ERR_BLOCKED_BY_CLIENT;
+    if (rule.action == Rule::Action::kRedirect &&
+        rule.redirect_url != info->url) {
+      *new_url = rule.redirect_url;
+      return net::OK;
+    }
+  }
+
   return HandleResponseEvent(ResponseEvent::kOnBeforeRequest, info,
                              std::move(callback), new_url, request);
 }
@@ -328,6 +531,18 @@ int WebRequest::OnBeforeSendHeaders(extensions::WebRequestInfo* info,
                                     const network::ResourceRequest& request,
                                     BeforeSendHeadersCallback callback,
                                     net::HttpRequestHeaders* headers) {
+  for (const auto& rule : rules_) {
+    if (rule.action != Rule::Action::kModifyHeaders ||
+        rule.request_headers.empty() || !rule.filter.MatchesRequest(info))
+      continue;
+    for (const auto& [name, value] : rule.request_headers) {
+      if (value)
+        headers->SetHeader(name, *value);
+      else
+        headers->RemoveHeader(name);
+    }
+  }
+
   return HandleResponseEvent(
       ResponseEvent::kOnBeforeSendHeaders, info,
       base::BindOnce(std::move(callback), std::set<std::string>(),
@@ -342,6 +557,24 @@ int WebRequest::OnHeadersReceived(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url) {
+  for (const auto& rule : rules_) {
+    if (rule.action != Rule::Action::kModifyHeaders ||
+        rule.response_headers.empty() || !original_response_headers ||
+        !rule.filter.MatchesRequest(info))
+      continue;
+    if (!*override_response_headers) {
+      *override_response_headers =
+          base::MakeRefCounted<net::HttpResponseHeaders>(
+              original_response_headers->raw_headers());
+    }
+    for (const auto& [name, value] : rule.response_headers) {
+      if (value)
+        (*override_response_headers)->SetHeader(name, *value);
+      else
+        (*override_response_headers)->RemoveHeader(name);
+    }
+  }
+
   const std::string& status_line =
       original_response_headers ? original_response_headers->GetStatusLine()
                                 : std::string();
@@ -368,10 +601,34 @@ void WebRequest::OnResponseStarted(extensions::WebRequestInfo* info,
   HandleSimpleEvent(SimpleEvent::kOnResponseStarted, info, request);
 }
 
+int WebRequest::OnResponseBody(extensions::WebRequestInfo* info,
+                               const network::ResourceRequest& request,
+                               ResponseBodyCallback callback) {
+  const auto iter = response_listeners_.find(ResponseEvent::kOnResponseBody);
+  if (iter == std::end(response_listeners_) ||
+      !iter->second.filter.MatchesRequest(info))
+    return net::OK;
+
+  body_callbacks_[info->id] = std::move(callback);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Details details(isolate);
+  FillDetails(&details, info, request);
+
+  ResponseCallback response =
+      base::BindOnce(&WebRequest::OnResponseBodyListenerResult,
+                     base::Unretained(this), info->id);
+  iter->second.listener.Run(details.GetHandle(), std::move(response));
+  return net::ERR_IO_PENDING;
+}
+
 void WebRequest::OnErrorOccurred(extensions::WebRequestInfo* info,
                                  const network::ResourceRequest& request,
                                  int net_error) {
   callbacks_.erase(info->id);
+  body_callbacks_.erase(info->id);
+  body_callbacks_.erase(info->id);
 
   HandleSimpleEvent(SimpleEvent::kOnErrorOccurred, info, request, net_error);
 }
@@ -380,12 +637,14 @@ void WebRequest::OnCompleted(extensions::WebRequestInfo* info,
                              const network::ResourceRequest& request,
                              int net_error) {
   callbacks_.erase(info->id);
+  body_callbacks_.erase(info->id);
 
   HandleSimpleEvent(SimpleEvent::kOnCompleted, info, request, net_error);
 }
 
 void WebRequest::OnRequestWillBeDestroyed(extensions::WebRequestInfo* info) {
   callbacks_.erase(info->id);
+  body_callbacks_.erase(info->id);
 }
 
 template <WebRequest::SimpleEvent event>
@@ -406,7 +665,11 @@ void WebRequest::SetListener(Event event,
 
   // { urls, types }.
   std::set<std::string> filter_patterns, filter_types;
-  gin::Dictionary dict(args->isolate());
+  // { batchInterval, fields }, which only the listeners that can't change the
+  // request accept.
+  std::optional<double> batch_interval;
+  std::optional<std::set<std::string>> fields;
+  gin_helper::Dictionary dict;
   if (args->GetNext(&arg) && !arg->IsFunction()) {
     // Note that gin treats Function as Dictionary when doing conversions, so we
     // have to explicitly check if the argument is Function before trying to
@@ -417,33 +680,30 @@ void WebRequest::SetListener(Event event,
         return;
       }
       dict.Get("types", &filter_types);
+      dict.GetOptional("batchInterval", &batch_interval);
+      dict.GetOptional("fields", &fields);
       args->GetNext(&arg);
     }
   }
 
-  RequestFilter filter;
-
-  for (const std::string& filter_pattern : filter_patterns) {
-    URLPattern pattern(URLPattern::SCHEME_ALL);
-    const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
-    if (result == URLPattern::ParseResult::kSuccess) {
-      filter.AddUrlPattern(std::move(pattern));
-    } else {
-      const char* error_type = URLPattern::GetParseResultString(result);
-      args->ThrowTypeError("Invalid url pattern " + filter_pattern + ": " +
-                           error_type);
-      return;
-    }
+  if (batch_interval &&
+      (!std::isfinite(*batch_interval) || *batch_interval <= 0)) {
+    args->ThrowTypeError(
+        "Parameter 'batchInterval' must be a positive number.");
+    return;
+  }
+  constexpr bool kIsSimpleListener = std::is_same_v<Listener, SimpleListener>;
+  if (!kIsSimpleListener && (batch_interval || fields)) {
+    args->ThrowTypeError(
+        "'batchInterval' and 'fields' are only supported by the listeners "
+        "that can't change the request.");
+    return;
   }
 
-  for (const std::string& filter_type : filter_types) {
-    auto type = ParseResourceType(filter_type);
-    if (type != extensions::WebRequestResourceType::OTHER) {
-      filter.AddType(type);
-    } else {
-      args->ThrowTypeError("Invalid type " + filter_type);
-      return;
-    }
+  RequestFilter filter;
+  if (auto error = ParseRequestFilter(filter_patterns, filter_types, &filter)) {
+    args->ThrowTypeError(*error);
+    return;
   }
 
   // Function or null.
@@ -454,10 +714,118 @@ void WebRequest::SetListener(Event event,
     return;
   }
 
-  if (listener.is_null())
+  if constexpr (kIsSimpleListener) {
+    // What the previous listener asked for is still delivered to it.
+    FlushBatch(event);
+  }
+
+  if (listener.is_null()) {
     listeners->erase(event);
-  else
-    (*listeners)[event] = {std::move(filter), std::move(listener)};
+    return;
+  }
+
+  (*listeners)[event] = {std::move(filter), std::move(listener)};
+  if constexpr (kIsSimpleListener) {
+    auto& info = (*listeners)[event];
+    if (batch_interval)
+      info.batch_interval = base::Milliseconds(*batch_interval);
+    if (fields)
+      info.fields.emplace(fields->begin(), fields->end());
+  }
+}
+
+void WebRequest::SetRules(gin::Arguments* args) {
+  std::vector<v8::Local<v8::Value>> rule_values;
+  if (!args->GetNext(&rule_values)) {
+    args->ThrowTypeError("Must pass an array of rules");
+    return;
+  }
+
+  std::vector<Rule> rules;
+  for (v8::Local<v8::Value> rule_value : rule_values) {
+    gin::Dictionary dict(args->isolate());
+    if (!gin::ConvertFromV8(args->isolate(), rule_value, &dict)) {
+      args->ThrowTypeError("Rules must be objects");
+      return;
+    }
+
+    Rule rule;
+
+    std::set<std::string> patterns, types;
+    if (!dict.Get("urls", &patterns)) {
+      args->ThrowTypeError("Rules must have property 'urls'.");
+      return;
+    }
+    dict.Get("types", &types);
+    if (auto error = ParseRequestFilter(patterns, types, &rule.filter)) {
+      args->ThrowTypeError(*error);
+      return;
+    }
+
+    std::string action;
+    dict.Get("action", &action);
+    if (action == "block") {
+      rule.action = Rule::Action::kBlock;
+    } else if (action == "redirect") {
+      rule.action = Rule::Action::kRedirect;
+      if (!dict.Get("redirectURL", &rule.redirect_url) ||
+          !rule.redirect_url.is_valid()) {
+        args->ThrowTypeError("Redirect rules must have a valid 'redirectURL'.");
+        return;
+      }
+    } else if (action == "modifyHeaders") {
+      rule.action = Rule::Action::kModifyHeaders;
+      for (auto [key, headers] :
+           {std::make_pair("requestHeaders", &rule.request_headers),
+            std::make_pair("responseHeaders", &rule.response_headers)}) {
+        base::Value::Dict changes;
+        if (!dict.Get(key, &changes))
+          continue;
+        for (const auto [name, value] : changes) {
+          if (value.is_string()) {
+            headers->emplace_back(name, value.GetString());
+          } else if (value.is_none()) {
+            headers->emplace_back(name, std::nullopt);
+          } else {
+            args->ThrowTypeError("Invalid value for header " + name);
+            return;
+          }
+        }
+      }
+    } else {
+      args->ThrowTypeError("Invalid action " + action);
+      return;
+    }
+
+    rules.push_back(std::move(rule));
+  }
+
+  rules_ = std::move(rules);
+}
+
+// static
+std::optional<std::string> WebRequest::ParseRequestFilter(
+    const std::set<std::string>& patterns,
+    const std::set<std::string>& types,
+    RequestFilter* filter) {
+  for (const std::string& filter_pattern : patterns) {
+    URLPattern pattern(URLPattern::SCHEME_ALL);
+    const URLPattern::ParseResult result = pattern.Parse(filter_pattern);
+    if (result != URLPattern::ParseResult::kSuccess) {
+      const char* error_type = URLPattern::GetParseResultString(result);
+      return "Invalid url pattern " + filter_pattern + ": " + error_type;
+    }
+    filter->AddUrlPattern(std::move(pattern));
+  }
+
+  for (const std::string& filter_type : types) {
+    auto type = ParseResourceType(filter_type);
+    if (type == extensions::WebRequestResourceType::OTHER)
+      return "Invalid type " + filter_type;
+    filter->AddType(type);
+  }
+
+  return std::nullopt;
 }
 
 template <typename... Args>
@@ -474,9 +842,42 @@ void WebRequest::HandleSimpleEvent(SimpleEvent event,
 
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
+  Details details(isolate, base::OptionalToPtr(info.fields));
   FillDetails(&details, request_info, args...);
-  info.listener.Run(gin::ConvertToV8(isolate, details));
+  if (info.batch_interval.is_zero()) {
+    info.listener.Run(details.GetHandle());
+    return;
+  }
+
+  Batch& batch = batches_[event];
+  batch.details.emplace_back(isolate, details.GetHandle());
+  if (!batch.timer.IsRunning()) {
+    batch.timer.Start(FROM_HERE, info.batch_interval,
+                      base::BindOnce(&WebRequest::FlushBatch,
+                                     base::Unretained(this), event));
+  }
+}
+
+void WebRequest::FlushBatch(SimpleEvent event) {
+  const auto batch = batches_.find(event);
+  if (batch == std::end(batches_))
+    return;
+  std::vector<v8::Global<v8::Value>> details =
+      std::move(batch->second.details);
+  batches_.erase(batch);
+
+  const auto iter = simple_listeners_.find(event);
+  if (iter == std::end(simple_listeners_) || details.empty())
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  std::vector<v8::Local<v8::Value>> values;
+  values.reserve(details.size());
+  for (const auto& value : details)
+    values.push_back(value.Get(isolate));
+  iter->second.listener.Run(
+      v8::Array::New(isolate, values.data(), values.size()));
 }
 
 template <typename Out, typename... Args>
@@ -497,13 +898,13 @@ int WebRequest::HandleResponseEvent(ResponseEvent event,
 
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  gin_helper::Dictionary details(isolate, v8::Object::New(isolate));
+  Details details(isolate);
   FillDetails(&details, request_info, args...);
 
   ResponseCallback response =
       base::BindOnce(&WebRequest::OnListenerResult<Out>, base::Unretained(this),
                      request_info->id, out);
-  info.listener.Run(gin::ConvertToV8(isolate, details), std::move(response));
+  info.listener.Run(details.GetHandle(), std::move(response));
   return net::ERR_IO_PENDING;
 }
 
@@ -535,6 +936,24 @@ void WebRequest::OnListenerResult(uint64_t id,
   callbacks_.erase(iter);
 }
 
+void WebRequest::OnResponseBodyListenerResult(uint64_t id,
+                                              v8::Local<v8::Value> response) {
+  const auto iter = body_callbacks_.find(id);
+  if (iter == std::end(body_callbacks_))
+    return;
+
+  std::unique_ptr<ResponseBodyTransform> transform;
+  JSResponseBodyTransform::TransformFunction function;
+  if (gin::ConvertFromV8(JavascriptEnvironment::GetIsolate(), response,
+                         &function))
+    transform = std::make_unique<JSResponseBodyTransform>(std::move(function));
+
+  // Like the other listener results, this is expected to be asynchronous.
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindOnce(std::move(iter->second), std::move(transform)));
+  body_callbacks_.erase(iter);
+}
+
 // static
 gin::Handle<WebRequest> WebRequest::FromOrCreate(
     v8::Isolate* isolate,
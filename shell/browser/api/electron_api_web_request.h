@@ -6,9 +6,16 @@
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_WEB_REQUEST_H_
 
 #include <map>
+#include <optional>
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "extensions/common/url_pattern.h"
 #include "gin/arguments.h"
@@ -49,6 +56,12 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
 
   // WebRequestAPI:
   bool HasListener() const override;
+  bool HasListenerForURL(const GURL& url) const override;
+
+  // Whether any listener or rule could apply to a WebSocket handshake for
+  // |url|, the handshakes for which this is false are not proxied.
+  bool HasListenerForWebSocket(const GURL& url) const;
+
   int OnBeforeRequest(extensions::WebRequestInfo* info,
                       const network::ResourceRequest& request,
                       net::CompletionOnceCallback callback,
@@ -72,6 +85,9 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
                         const GURL& new_location) override;
   void OnResponseStarted(extensions::WebRequestInfo* info,
                          const network::ResourceRequest& request) override;
+  int OnResponseBody(extensions::WebRequestInfo* info,
+                     const network::ResourceRequest& request,
+                     ResponseBodyCallback callback) override;
   void OnErrorOccurred(extensions::WebRequestInfo* info,
                        const network::ResourceRequest& request,
                        int net_error) override;
@@ -95,6 +111,7 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
     kOnBeforeRequest,
     kOnBeforeSendHeaders,
     kOnHeadersReceived,
+    kOnResponseBody,
   };
 
   using SimpleListener = base::RepeatingCallback<void(v8::Local<v8::Value>)>;
@@ -109,10 +126,14 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
   template <typename Listener, typename Listeners, typename Event>
   void SetListener(Event event, Listeners* listeners, gin::Arguments* args);
 
+  void SetRules(gin::Arguments* args);
+
   template <typename... Args>
   void HandleSimpleEvent(SimpleEvent event,
                          extensions::WebRequestInfo* info,
                          Args... args);
+  // Delivers the details of |event| that are waiting to be delivered at once.
+  void FlushBatch(SimpleEvent event);
   template <typename Out, typename... Args>
   int HandleResponseEvent(ResponseEvent event,
                           extensions::WebRequestInfo* info,
@@ -122,12 +143,15 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
 
   template <typename T>
   void OnListenerResult(uint64_t id, T out, v8::Local<v8::Value> response);
+  void OnResponseBodyListenerResult(uint64_t id,
+                                    v8::Local<v8::Value> response);
 
   class RequestFilter {
    public:
     RequestFilter(std::set<URLPattern>,
                   std::set<extensions::WebRequestResourceType>);
     RequestFilter(const RequestFilter&);
+    RequestFilter& operator=(const RequestFilter&);
     RequestFilter();
     ~RequestFilter();
 
@@ -135,18 +159,35 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
     void AddType(extensions::WebRequestResourceType type);
 
     bool MatchesRequest(extensions::WebRequestInfo* info) const;
+    bool MatchesRequest(const GURL& url,
+                        extensions::WebRequestResourceType type) const;
+    bool MatchesURL(const GURL& url) const;
 
    private:
-    bool MatchesURL(const GURL& url) const;
     bool MatchesType(extensions::WebRequestResourceType type) const;
 
+    void IndexUrlPattern(const URLPattern& pattern);
+    void RebuildIndex();
+
     std::set<URLPattern> url_patterns_;
     std::set<extensions::WebRequestResourceType> types_;
+
+    // |url_patterns_| keyed by host, so that a URL is only matched against
+    // the patterns for its host and the domains above it. Patterns that are
+    // not tied to a host are always matched.
+    std::map<std::string, std::vector<const URLPattern*>, std::less<>>
+        url_patterns_by_host_;
+    std::vector<const URLPattern*> url_patterns_for_any_host_;
   };
 
   struct SimpleListenerInfo {
     RequestFilter filter;
     SimpleListener listener;
+    // The listener is called with arrays of details at most this often when
+    // it is not zero.
+    base::TimeDelta batch_interval;
+    // The only fields of the details that are filled when set.
+    std::optional<base::flat_set<std::string>> fields;
 
     SimpleListenerInfo(RequestFilter, SimpleListener);
     SimpleListenerInfo();
@@ -162,9 +203,54 @@ class WebRequest : public gin::Wrappable<WebRequest>, public WebRequestAPI {
     ~ResponseListenerInfo();
   };
 
+  // A declarative rule, applied in C++ before any listener runs so that
+  // requests it covers never wait for JS.
+  struct Rule {
+    enum class Action {
+      kBlock,
+      kRedirect,
+      kModifyHeaders,
+    };
+
+    // A header to set, or to remove when there is no value.
+    using HeaderChange = std::pair<std::string, std::optional<std::string>>;
+
+    Rule();
+    Rule(const Rule&);
+    Rule& operator=(const Rule&);
+    ~Rule();
+
+    RequestFilter filter;
+    Action action = Action::kBlock;
+    GURL redirect_url;
+    std::vector<HeaderChange> request_headers;
+    std::vector<HeaderChange> response_headers;
+  };
+
+  // Fills |filter| from the "urls" and "types" of a filter object, returning
+  // an error message when one of them is invalid.
+  static std::optional<std::string> ParseRequestFilter(
+      const std::set<std::string>& patterns,
+      const std::set<std::string>& types,
+      RequestFilter* filter);
+
+  std::vector<Rule> rules_;
+
   std::map<SimpleEvent, SimpleListenerInfo> simple_listeners_;
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
+
+  // The details that the batched listeners have not been called with yet.
+  struct Batch {
+    Batch();
+    ~Batch();
+
+    base::OneShotTimer timer;
+    std::vector<v8::Global<v8::Value>> details;
+  };
+  std::map<SimpleEvent, Batch> batches_;
+
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  std::map<uint64_t, ResponseBodyCallback> body_callbacks_;
 
   // Weak-ref, it manages us.
   raw_ptr<content::BrowserContext> browser_context_;
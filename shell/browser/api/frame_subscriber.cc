@@ -4,34 +4,119 @@
 
 #include "shell/browser/api/frame_subscriber.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "base/functional/callback_helpers.h"
+#include "base/logging.h"
+#include "base/task/bind_post_task.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
+#include "media/base/bitrate.h"
+#include "media/base/video_frame.h"
 #include "media/capture/mojom/video_capture_buffer.mojom.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
+#include "media/media_buildflags.h"
+#include "media/video/offloading_video_encoder.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/viz/privileged/mojom/compositing/frame_sink_video_capture.mojom-shared.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/skbitmap_operations.h"
 
+#if BUILDFLAG(ENABLE_LIBVPX)
+#include "media/video/vpx_video_encoder.h"
+#endif
+
+#if BUILDFLAG(ENABLE_LIBAOM)
+#include "media/video/av1_video_encoder.h"
+#endif
+
+#if BUILDFLAG(ENABLE_OPENH264)
+#include "media/video/openh264_video_encoder.h"
+#endif
+
 namespace electron::api {
 
+namespace {
+
+std::unique_ptr<media::VideoEncoder> CreateVideoEncoder(
+    media::VideoCodecProfile profile) {
+  std::unique_ptr<media::VideoEncoder> encoder;
+  switch (media::VideoCodecProfileToVideoCodec(profile)) {
+#if BUILDFLAG(ENABLE_LIBVPX)
+    case media::VideoCodec::kVP8:
+    case media::VideoCodec::kVP9:
+      encoder = std::make_unique<media::VpxVideoEncoder>();
+      break;
+#endif
+#if BUILDFLAG(ENABLE_LIBAOM)
+    case media::VideoCodec::kAV1:
+      encoder = std::make_unique<media::Av1VideoEncoder>();
+      break;
+#endif
+#if BUILDFLAG(ENABLE_OPENH264)
+    case media::VideoCodec::kH264:
+      encoder = std::make_unique<media::OpenH264VideoEncoder>();
+      break;
+#endif
+    default:
+      return nullptr;
+  }
+  // The software encoders do their work on the calling thread, keep them off
+  // the UI thread.
+  return std::make_unique<media::OffloadingVideoEncoder>(std::move(encoder));
+}
+
+}  // namespace
+
 constexpr static int kMaxFrameRate = 30;
 
+constexpr static size_t kMaxPooledFrameBuffers = 4;
+
 FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
                                  const FrameCaptureCallback& callback,
                                  bool only_dirty)
     : content::WebContentsObserver(web_contents),
       callback_(callback),
-      only_dirty_(only_dirty) {
+      only_dirty_(only_dirty),
+      frame_buffer_pool_(
+          base::MakeRefCounted<FrameBufferPool>(kMaxPooledFrameBuffers)) {
+  AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
+}
+
+FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+                                 const EncodingOptions& encoding_options,
+                                 const EncodedFrameCallback& callback)
+    : content::WebContentsObserver(web_contents),
+      encoding_options_(encoding_options),
+      encoded_callback_(callback) {
   AttachToHost(web_contents->GetPrimaryMainFrame()->GetRenderWidgetHost());
 }
 
 FrameSubscriber::~FrameSubscriber() = default;
 
+// static
+std::optional<media::VideoCodecProfile> FrameSubscriber::GetEncodingProfile(
+    std::string_view codec) {
+#if BUILDFLAG(ENABLE_LIBVPX)
+  if (codec == "vp8")
+    return media::VP8PROFILE_ANY;
+  if (codec == "vp9")
+    return media::VP9PROFILE_PROFILE0;
+#endif
+#if BUILDFLAG(ENABLE_LIBAOM)
+  if (codec == "av1")
+    return media::AV1PROFILE_PROFILE_MAIN;
+#endif
+#if BUILDFLAG(ENABLE_OPENH264)
+  if (codec == "h264")
+    return media::H264PROFILE_BASELINE;
+#endif
+  return std::nullopt;
+}
+
 void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
   host_ = host;
 
@@ -42,11 +127,18 @@ void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
 
   // Create and configure the video capturer.
   gfx::Size size = GetRenderViewSize();
+  if (encoding_options_) {
+    if (encoded_size_.IsEmpty())
+      InitializeEncoder(size);
+    size = encoded_size_;
+  }
   video_capturer_ = host_->GetView()->CreateVideoCapturer();
   video_capturer_->SetResolutionConstraints(size, size, true);
   video_capturer_->SetAutoThrottlingEnabled(false);
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB);
+  // The encoders take I420 as is, which also halves the size of each frame.
+  video_capturer_->SetFormat(encoding_options_ ? media::PIXEL_FORMAT_I420
+                                               : media::PIXEL_FORMAT_ARGB);
   video_capturer_->SetMinCapturePeriod(base::Seconds(1) / kMaxFrameRate);
   video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
 }
@@ -84,6 +176,11 @@ void FrameSubscriber::OnFrameCaptured(
     const gfx::Rect& content_rect,
     mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
         callbacks) {
+  if (encoding_options_) {
+    EncodeFrame(std::move(data), std::move(info), std::move(callbacks));
+    return;
+  }
+
   auto& data_region = data->get_read_only_shmem_region();
 
   gfx::Size size = GetRenderViewSize();
@@ -162,8 +259,8 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   // allocate and write pixels otherwise crash may happen when the original
   // frame is modified.
   SkBitmap copy;
-  copy.allocPixels(SkImageInfo::Make(bitmap.width(), bitmap.height(),
-                                     kN32_SkColorType, kPremul_SkAlphaType));
+  CHECK(frame_buffer_pool_->AllocPixels(
+      SkImageInfo::MakeN32Premul(bitmap.width(), bitmap.height()), &copy));
   SkPixmap pixmap;
   bool success = bitmap.peekPixels(&pixmap) && copy.writePixels(pixmap, 0, 0);
   CHECK(success);
@@ -171,6 +268,99 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   callback_.Run(gfx::Image::CreateFrom1xBitmap(copy), damage);
 }
 
+void FrameSubscriber::InitializeEncoder(const gfx::Size& size) {
+  // I420 needs even dimensions.
+  encoded_size_ = gfx::Size(std::max(2, size.width() & ~1),
+                            std::max(2, size.height() & ~1));
+
+  encoder_ = CreateVideoEncoder(encoding_options_->profile);
+  if (!encoder_)
+    return;
+
+  media::VideoEncoder::Options options;
+  options.frame_size = encoded_size_;
+  options.framerate = kMaxFrameRate;
+  if (encoding_options_->bitrate)
+    options.bitrate =
+        media::Bitrate::ConstantBitrate(*encoding_options_->bitrate);
+  if (encoding_options_->key_frame_interval)
+    options.keyframe_interval = *encoding_options_->key_frame_interval;
+  options.latency_mode = media::VideoEncoder::LatencyMode::Realtime;
+  options.content_hint = media::VideoEncoder::ContentHint::Screen;
+  // Annex B can be written out or piped into other tools as is.
+  options.avc.produce_annexb = true;
+
+  encoder_->Initialize(
+      encoding_options_->profile, options, base::DoNothing(),
+      base::BindRepeating(&FrameSubscriber::OnEncodedFrame,
+                          weak_ptr_factory_.GetWeakPtr()),
+      base::BindOnce(&FrameSubscriber::OnEncoderStatus,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void FrameSubscriber::EncodeFrame(
+    ::media::mojom::VideoBufferHandlePtr data,
+    ::media::mojom::VideoFrameInfoPtr info,
+    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+        callbacks) {
+  mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+      callbacks_remote(std::move(callbacks));
+  if (!encoder_ || !data->is_read_only_shmem_region()) {
+    callbacks_remote->Done();
+    return;
+  }
+
+  base::ReadOnlySharedMemoryMapping mapping =
+      data->get_read_only_shmem_region().Map();
+  if (!mapping.IsValid() ||
+      mapping.size() < media::VideoFrame::AllocationSize(info->pixel_format,
+                                                         info->coded_size)) {
+    DLOG(ERROR) << "Shared memory mapping failed.";
+    callbacks_remote->Done();
+    return;
+  }
+
+  // The frame is encoded straight from the shared memory of the capturer.
+  scoped_refptr<media::VideoFrame> frame = media::VideoFrame::WrapExternalData(
+      info->pixel_format, info->coded_size, info->visible_rect,
+      info->visible_rect.size(), static_cast<const uint8_t*>(mapping.memory()),
+      mapping.size(), info->timestamp);
+  if (!frame) {
+    callbacks_remote->Done();
+    return;
+  }
+  frame->set_color_space(info->color_space);
+
+  // Keep the shared memory mapped, and prevent FrameSinkVideoCapturer from
+  // recycling it, until the encoder has let go of the frame. That happens on
+  // the encoder's thread, so hop back here to release them.
+  frame->AddDestructionObserver(base::BindPostTaskToCurrentDefault(
+      base::BindOnce(
+          [](base::ReadOnlySharedMemoryMapping mapping,
+             mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+                 releaser) {},
+          std::move(mapping), std::move(callbacks_remote))));
+
+  encoder_->Encode(std::move(frame),
+                   media::VideoEncoder::EncodeOptions(/*key_frame=*/false),
+                   base::BindOnce(&FrameSubscriber::OnEncoderStatus,
+                                  weak_ptr_factory_.GetWeakPtr()));
+}
+
+void FrameSubscriber::OnEncodedFrame(
+    media::VideoEncoderOutput output,
+    std::optional<media::VideoEncoder::CodecDescription> description) {
+  encoded_callback_.Run(output);
+}
+
+void FrameSubscriber::OnEncoderStatus(media::EncoderStatus status) {
+  if (status.is_ok())
+    return;
+
+  LOG(ERROR) << "Failed to encode captured frames: " << status.message();
+  encoder_.reset();
+}
+
 gfx::Size FrameSubscriber::GetRenderViewSize() const {
   content::RenderWidgetHostView* view = host_->GetView();
   gfx::Size size = view->GetViewBounds().size();
@@ -6,16 +6,22 @@
 #define ELECTRON_SHELL_BROWSER_API_FRAME_SUBSCRIBER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
+#include "media/base/video_codecs.h"
+#include "media/base/video_encoder.h"
 #include "media/capture/mojom/video_capture_buffer.mojom-forward.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "shell/browser/frame_buffer_pool.h"
 #include "v8/include/v8.h"
 
 namespace gfx {
@@ -32,16 +38,33 @@ class FrameSubscriber : public content::WebContentsObserver,
  public:
   using FrameCaptureCallback =
       base::RepeatingCallback<void(const gfx::Image&, const gfx::Rect&)>;
+  using EncodedFrameCallback =
+      base::RepeatingCallback<void(const media::VideoEncoderOutput&)>;
+
+  struct EncodingOptions {
+    media::VideoCodecProfile profile = media::VIDEO_CODEC_PROFILE_UNKNOWN;
+    std::optional<uint32_t> bitrate;
+    std::optional<int> key_frame_interval;
+  };
 
   FrameSubscriber(content::WebContents* web_contents,
                   const FrameCaptureCallback& callback,
                   bool only_dirty);
+  // Encodes the captured frames instead of handing them out as images.
+  FrameSubscriber(content::WebContents* web_contents,
+                  const EncodingOptions& encoding_options,
+                  const EncodedFrameCallback& callback);
   ~FrameSubscriber() override;
 
   // disable copy
   FrameSubscriber(const FrameSubscriber&) = delete;
   FrameSubscriber& operator=(const FrameSubscriber&) = delete;
 
+  // Returns the profile used to encode |codec|, or nullopt if this build has
+  // no encoder for it.
+  static std::optional<media::VideoCodecProfile> GetEncodingProfile(
+      std::string_view codec);
+
  private:
   void AttachToHost(content::RenderWidgetHost* host);
   void DetachFromHost();
@@ -64,11 +87,32 @@ class FrameSubscriber : public content::WebContentsObserver,
 
   void Done(const gfx::Rect& damage, const SkBitmap& frame);
 
+  void InitializeEncoder(const gfx::Size& size);
+  void EncodeFrame(
+      ::media::mojom::VideoBufferHandlePtr data,
+      ::media::mojom::VideoFrameInfoPtr info,
+      mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks);
+  void OnEncodedFrame(
+      media::VideoEncoderOutput output,
+      std::optional<media::VideoEncoder::CodecDescription> description);
+  void OnEncoderStatus(media::EncoderStatus status);
+
   // Get the pixel size of render view.
   gfx::Size GetRenderViewSize() const;
 
   FrameCaptureCallback callback_;
-  bool only_dirty_;
+  bool only_dirty_ = false;
+
+  // Set when encoding. The size of the encoded frames is fixed when the
+  // encoder is created, later frames are scaled to fit.
+  std::optional<EncodingOptions> encoding_options_;
+  EncodedFrameCallback encoded_callback_;
+  std::unique_ptr<media::VideoEncoder> encoder_;
+  gfx::Size encoded_size_;
+
+  // Pixel memory of the frames handed to |callback_|.
+  scoped_refptr<FrameBufferPool> frame_buffer_pool_;
 
   raw_ptr<content::RenderWidgetHost> host_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -8,6 +8,7 @@
 
 #include "base/memory/singleton.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "content/public/browser/browser_thread.h"
 #include "gpu/config/gpu_info_collector.h"
 #include "shell/browser/api/gpu_info_enumerator.h"
@@ -40,6 +41,10 @@ bool GPUInfoManager::NeedsCompleteGpuInfoCollection() const {
 
 // Should be posted to the task runner
 void GPUInfoManager::ProcessCompleteInfo() {
+  // Nothing asked for the complete info yet, so there is nothing to refresh.
+  if (!complete_info_ && complete_info_promise_set_.empty())
+    return;
+
   base::Value::Dict result = EnumerateGPUInfo(gpu_data_manager_->GetGPUInfo());
   // We have received the complete information, resolve all promises that
   // were waiting for this info.
@@ -47,9 +52,14 @@ void GPUInfoManager::ProcessCompleteInfo() {
     promise.Resolve(base::Value(result.Clone()));
   }
   complete_info_promise_set_.clear();
+  complete_info_ = std::move(result);
 }
 
 void GPUInfoManager::OnGpuInfoUpdate() {
+  // The devices may have changed, the basic info is collected again when it
+  // is next requested.
+  basic_info_.reset();
+
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
       FROM_HERE, base::BindOnce(&GPUInfoManager::ProcessCompleteInfo,
                                 base::Unretained(this)));
@@ -65,21 +75,54 @@ void GPUInfoManager::CompleteInfoFetcher(
 
 void GPUInfoManager::FetchCompleteInfo(
     gin_helper::Promise<base::Value> promise) {
+  if (complete_info_) {
+    promise.Resolve(base::Value(complete_info_->Clone()));
+    return;
+  }
   base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
       FROM_HERE, base::BindOnce(&GPUInfoManager::CompleteInfoFetcher,
                                 base::Unretained(this), std::move(promise)));
 }
 
-// This fetches the info synchronously, so no need to post to the task queue.
-// There cannot be multiple promises as they are resolved synchronously.
 void GPUInfoManager::FetchBasicInfo(gin_helper::Promise<base::Value> promise) {
+  if (basic_info_) {
+    promise.Resolve(base::Value(basic_info_->Clone()));
+    return;
+  }
+  basic_info_promise_set_.emplace_back(std::move(promise));
+  CollectBasicInfoInBackground();
+}
+
+void GPUInfoManager::CollectBasicInfoInBackground() {
+  if (basic_info_ || collecting_basic_info_)
+    return;
+  collecting_basic_info_ = true;
+  // Enumerating the devices can take a while on Windows.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&GPUInfoManager::CollectBasicInfo),
+      base::BindOnce(&GPUInfoManager::OnBasicInfoCollected,
+                     base::Unretained(this)));
+}
+
+// static
+base::Value::Dict GPUInfoManager::CollectBasicInfo() {
   gpu::GPUInfo gpu_info;
   CollectBasicGraphicsInfo(&gpu_info);
-  promise.Resolve(base::Value(EnumerateGPUInfo(gpu_info)));
+  return EnumerateGPUInfo(gpu_info);
+}
+
+void GPUInfoManager::OnBasicInfoCollected(base::Value::Dict info) {
+  collecting_basic_info_ = false;
+  for (auto& promise : basic_info_promise_set_) {
+    promise.Resolve(base::Value(info.Clone()));
+  }
+  basic_info_promise_set_.clear();
+  basic_info_ = std::move(info);
 }
 
-base::Value::Dict GPUInfoManager::EnumerateGPUInfo(
-    gpu::GPUInfo gpu_info) const {
+// static
+base::Value::Dict GPUInfoManager::EnumerateGPUInfo(gpu::GPUInfo gpu_info) {
   GPUInfoEnumerator enumerator;
   gpu_info.EnumerateFields(&enumerator);
   return enumerator.GetDictionary();
@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_GPUINFO_MANAGER_H_
 #define ELECTRON_SHELL_BROWSER_API_GPUINFO_MANAGER_H_
 
+#include <optional>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
@@ -32,8 +33,15 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   void FetchBasicInfo(gin_helper::Promise<base::Value> promise);
   void OnGpuInfoUpdate() override;
 
+  // Collects the basic info on the thread pool, so that it is cached by the
+  // time it is requested.
+  void CollectBasicInfoInBackground();
+
  private:
-  base::Value::Dict EnumerateGPUInfo(gpu::GPUInfo gpu_info) const;
+  static base::Value::Dict EnumerateGPUInfo(gpu::GPUInfo gpu_info);
+  static base::Value::Dict CollectBasicInfo();
+
+  void OnBasicInfoCollected(base::Value::Dict info);
 
   // These should be posted to the task queue
   void CompleteInfoFetcher(gin_helper::Promise<base::Value> promise);
@@ -42,6 +50,14 @@ class GPUInfoManager : public content::GpuDataManagerObserver {
   // This set maintains all the promises that should be fulfilled
   // once we have the complete information data
   std::vector<gin_helper::Promise<base::Value>> complete_info_promise_set_;
+  std::vector<gin_helper::Promise<base::Value>> basic_info_promise_set_;
+
+  // The last info received, they are refreshed on every GPU info update once
+  // they have been collected.
+  std::optional<base::Value::Dict> complete_info_;
+  std::optional<base::Value::Dict> basic_info_;
+  bool collecting_basic_info_ = false;
+
   raw_ptr<content::GpuDataManagerImpl> gpu_data_manager_;
 };
 
@@ -0,0 +1,139 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/hang_monitor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "base/debug/dump_without_crashing.h"
+#include "base/functional/bind.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "shell/common/crash_keys.h"
+#include "shell/common/javascript_stack.h"
+#include "v8/include/v8-isolate.h"
+
+namespace electron {
+
+// Shared between the watched thread and the watchdog sequence.
+class HangMonitor::State : public base::RefCountedThreadSafe<State> {
+ public:
+  State(v8::Isolate* isolate,
+        base::TimeDelta threshold,
+        bool dump_without_crashing)
+      : isolate_(isolate),
+        threshold_(threshold),
+        dump_without_crashing_(dump_without_crashing) {
+    Heartbeat(base::TimeTicks::Now());
+  }
+
+  // disable copy
+  State(const State&) = delete;
+  State& operator=(const State&) = delete;
+
+  base::TimeDelta check_interval() const {
+    return std::max(threshold_ / 4, base::Milliseconds(10));
+  }
+
+  // Called on the watched thread, returns the previous heartbeat.
+  base::TimeTicks Heartbeat(base::TimeTicks now) {
+    return base::TimeTicks() +
+           base::Microseconds(last_heartbeat_.exchange(
+               (now - base::TimeTicks()).InMicroseconds()));
+  }
+
+  // Called on the watched thread, returns whether a hang was detected since
+  // the last call.
+  bool TakeHang() { return hanging_.exchange(false); }
+
+  // Called on the watched thread, the watchdog stops at its next check.
+  void Stop() { stopped_.store(true); }
+
+  // Called on the watchdog sequence.
+  void Check() {
+    if (stopped_.load())
+      return;
+    const base::TimeTicks last_heartbeat =
+        base::TimeTicks() + base::Microseconds(last_heartbeat_.load());
+    if (!hanging_.load() &&
+        base::TimeTicks::Now() - last_heartbeat > threshold_) {
+      hanging_.store(true);
+      crash_keys::AddBreadcrumb("hang", "main thread");
+      // The stack is captured if the thread is running JavaScript, an
+      // interrupt only runs the next time the thread checks for them.
+      AddRef();
+      isolate_->RequestInterrupt(&State::OnInterrupt, this);
+      if (dump_without_crashing_)
+        base::debug::DumpWithoutCrashing();
+    }
+    base::SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&State::Check, scoped_refptr<State>(this)),
+        check_interval());
+  }
+
+  // Only accessed on the watched thread.
+  std::string stack;
+
+ private:
+  friend class base::RefCountedThreadSafe<State>;
+  ~State() = default;
+
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    auto* state = static_cast<State*>(data);
+    // The hang may be over already when the thread was blocked outside of
+    // JavaScript.
+    if (state->hanging_.load())
+      state->stack = CaptureJavaScriptStack(isolate);
+    state->Release();
+  }
+
+  const raw_ptr<v8::Isolate> isolate_;
+  const base::TimeDelta threshold_;
+  const bool dump_without_crashing_;
+  std::atomic<int64_t> last_heartbeat_{0};
+  std::atomic<bool> hanging_{false};
+  std::atomic<bool> stopped_{false};
+};
+
+HangMonitor::HangMonitor(v8::Isolate* isolate,
+                         base::TimeDelta threshold,
+                         bool dump_without_crashing,
+                         HangCallback callback)
+    : state_(base::MakeRefCounted<State>(isolate,
+                                         threshold,
+                                         dump_without_crashing)),
+      callback_(std::move(callback)) {
+  // The checks keep running on the thread pool while the watched thread is
+  // blocked.
+  base::ThreadPool::CreateSequencedTaskRunner(
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN})
+      ->PostDelayedTask(FROM_HERE, base::BindOnce(&State::Check, state_),
+                        state_->check_interval());
+  heartbeat_.Start(FROM_HERE, state_->check_interval(),
+                   base::BindRepeating(&HangMonitor::OnHeartbeat,
+                                       base::Unretained(this)));
+}
+
+HangMonitor::~HangMonitor() {
+  state_->Stop();
+}
+
+void HangMonitor::OnHeartbeat() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeTicks last_heartbeat = state_->Heartbeat(now);
+  if (!state_->TakeHang())
+    return;
+  Hang hang;
+  hang.duration = now - last_heartbeat;
+  hang.stack = std::move(state_->stack);
+  state_->stack.clear();
+  callback_.Run(hang);
+}
+
+}  // namespace electron
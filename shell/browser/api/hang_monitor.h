@@ -0,0 +1,59 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_HANG_MONITOR_H_
+#define ELECTRON_SHELL_BROWSER_API_HANG_MONITOR_H_
+
+#include <string>
+
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace v8 {
+class Isolate;
+}  // namespace v8
+
+namespace electron {
+
+// Watches the thread that creates it from the thread pool, and reports the
+// times it didn't run a task for longer than a threshold. See
+// app.startHangMonitor().
+class HangMonitor {
+ public:
+  struct Hang {
+    base::TimeDelta duration;
+    // The JavaScript stack of the thread during the hang, empty when it was
+    // not running JavaScript.
+    std::string stack;
+  };
+  using HangCallback = base::RepeatingCallback<void(const Hang&)>;
+
+  // |callback| runs on the watched thread once a hang is over. When
+  // |dump_without_crashing| is set, a crash report is also generated while
+  // the thread hangs, with the native stacks of all the threads.
+  HangMonitor(v8::Isolate* isolate,
+              base::TimeDelta threshold,
+              bool dump_without_crashing,
+              HangCallback callback);
+  ~HangMonitor();
+
+  // disable copy
+  HangMonitor(const HangMonitor&) = delete;
+  HangMonitor& operator=(const HangMonitor&) = delete;
+
+ private:
+  class State;
+
+  void OnHeartbeat();
+
+  scoped_refptr<State> state_;
+  base::RepeatingTimer heartbeat_;
+  HangCallback callback_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_HANG_MONITOR_H_
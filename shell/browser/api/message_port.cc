@@ -76,31 +76,13 @@ void MessagePort::PostMessage(gin::Arguments* args) {
     return;
   }
 
-  electron::SerializeV8Value(args->isolate(), message_value,
-                             &transferable_message);
-
   v8::Local<v8::Value> transferables;
   std::vector<gin::Handle<MessagePort>> wrapped_ports;
-  if (args->GetNext(&transferables)) {
-    std::vector<v8::Local<v8::Value>> wrapped_port_values;
-    if (!gin::ConvertFromV8(args->isolate(), transferables,
-                            &wrapped_port_values)) {
-      thrower.ThrowTypeError("transferables must be an array of MessagePorts");
-      return;
-    }
-
-    for (unsigned i = 0; i < wrapped_port_values.size(); ++i) {
-      if (!IsValidWrappable(wrapped_port_values[i])) {
-        thrower.ThrowTypeError("Port at index " + base::NumberToString(i) +
-                               " is not a valid port");
-        return;
-      }
-    }
-
-    if (!gin::ConvertFromV8(args->isolate(), transferables, &wrapped_ports)) {
-      thrower.ThrowTypeError("Passed an invalid MessagePort");
-      return;
-    }
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (args->GetNext(&transferables) &&
+      !GetTransferables(args->isolate(), transferables, &wrapped_ports,
+                        &array_buffers)) {
+    return;
   }
 
   // Make sure we aren't connected to any of the passed-in ports.
@@ -112,6 +94,12 @@ void MessagePort::PostMessage(gin::Arguments* args) {
     }
   }
 
+  if (!electron::SerializeV8Value(args->isolate(), message_value,
+                                  array_buffers, &transferable_message)) {
+    // SerializeV8Value sets an exception.
+    return;
+  }
+
   bool threw_exception = false;
   transferable_message.ports = MessagePort::DisentanglePorts(
       args->isolate(), wrapped_ports, &threw_exception);
@@ -208,6 +196,47 @@ std::vector<gin::Handle<MessagePort>> MessagePort::EntanglePorts(
   return wrapped_ports;
 }
 
+// static
+bool MessagePort::GetTransferables(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> transferables,
+    std::vector<gin::Handle<MessagePort>>* ports,
+    std::vector<v8::Local<v8::ArrayBuffer>>* array_buffers) {
+  gin_helper::ErrorThrower thrower(isolate);
+  std::vector<v8::Local<v8::Value>> transferable_values;
+  if (!gin::ConvertFromV8(isolate, transferables, &transferable_values)) {
+    thrower.ThrowTypeError(
+        "transferables must be an array of MessagePorts and ArrayBuffers");
+    return false;
+  }
+
+  for (unsigned i = 0; i < transferable_values.size(); ++i) {
+    const v8::Local<v8::Value>& value = transferable_values[i];
+    if (value->IsArrayBuffer()) {
+      auto array_buffer = value.As<v8::ArrayBuffer>();
+      if (base::Contains(*array_buffers, array_buffer)) {
+        thrower.ThrowTypeError("ArrayBuffer at index " +
+                               base::NumberToString(i) +
+                               " is duplicated in transfer");
+        return false;
+      }
+      array_buffers->push_back(array_buffer);
+    } else if (!IsValidWrappable(value)) {
+      thrower.ThrowTypeError("Port at index " + base::NumberToString(i) +
+                             " is not a valid port");
+      return false;
+    } else {
+      gin::Handle<MessagePort> port;
+      if (!gin::ConvertFromV8(isolate, value, &port)) {
+        thrower.ThrowTypeError("Passed an invalid MessagePort");
+        return false;
+      }
+      ports->push_back(port);
+    }
+  }
+  return true;
+}
+
 // static
 std::vector<blink::MessagePortChannel> MessagePort::DisentanglePorts(
     v8::Isolate* isolate,
@@ -47,6 +47,14 @@ class MessagePort : public gin::Wrappable<MessagePort>,
       v8::Isolate* isolate,
       std::vector<blink::MessagePortChannel> channels);
 
+  // Sorts the transfer list of a postMessage() call into its MessagePorts and
+  // its ArrayBuffers. Throws and returns false if the list is not valid.
+  static bool GetTransferables(
+      v8::Isolate* isolate,
+      v8::Local<v8::Value> transferables,
+      std::vector<gin::Handle<MessagePort>>* ports,
+      std::vector<v8::Local<v8::ArrayBuffer>>* array_buffers);
+
   static std::vector<blink::MessagePortChannel> DisentanglePorts(
       v8::Isolate* isolate,
       const std::vector<gin::Handle<MessagePort>>& ports,
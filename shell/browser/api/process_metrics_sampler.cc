@@ -0,0 +1,277 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/process_metrics_sampler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/process/process.h"
+#include "base/process/process_metrics.h"
+#include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/gpu_data_manager.h"
+#include "gpu/ipc/common/memory_stats.h"
+#include "shell/browser/api/process_metric.h"
+#include "shell/common/gin_helper/dictionary.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+
+#include <psapi.h>
+#elif BUILDFLAG(IS_MAC)
+#include <libproc.h>
+
+#include "content/public/browser/browser_child_process_host.h"
+#else
+#include <string_view>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/memory/page_size.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+// The columns of a row, in the order of kFields.
+enum Field {
+  kTime,
+  kPid,
+  kPercentCPUUsage,
+  kWorkingSetSize,
+  kPrivateBytes,
+  kSharedBytes,
+  kGPUMemory,
+  kReadBytes,
+  kWriteBytes,
+  kFieldCount,
+};
+
+constexpr const char* kFields[] = {
+    "time",        "pid",       "percentCPUUsage", "workingSetSize",
+    "privateBytes", "sharedBytes", "gpuMemory",       "readBytes",
+    "writeBytes"};
+static_assert(std::size(kFields) == kFieldCount);
+
+// Fills the memory, in kilobytes like app.getAppMetrics(), and the IO
+// counters of |row|. Those the platform doesn't report are left as NaN.
+void ReadCounters(const base::Process& process, double* row) {
+#if BUILDFLAG(IS_WIN)
+  PROCESS_MEMORY_COUNTERS_EX info = {};
+  if (::GetProcessMemoryInfo(process.Handle(),
+                             reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&info),
+                             sizeof(info))) {
+    row[kWorkingSetSize] = static_cast<double>(info.WorkingSetSize >> 10);
+    row[kPrivateBytes] = static_cast<double>(info.PrivateUsage >> 10);
+  }
+
+  IO_COUNTERS io = {};
+  if (::GetProcessIoCounters(process.Handle(), &io)) {
+    row[kReadBytes] = static_cast<double>(io.ReadTransferCount);
+    row[kWriteBytes] = static_cast<double>(io.WriteTransferCount);
+  }
+#elif BUILDFLAG(IS_MAC)
+  rusage_info_v2 info = {};
+  if (proc_pid_rusage(process.Pid(), RUSAGE_INFO_V2,
+                      reinterpret_cast<rusage_info_t*>(&info)) == 0) {
+    row[kWorkingSetSize] = static_cast<double>(info.ri_resident_size >> 10);
+    row[kPrivateBytes] = static_cast<double>(info.ri_phys_footprint >> 10);
+    row[kReadBytes] = static_cast<double>(info.ri_diskio_bytesread);
+    row[kWriteBytes] = static_cast<double>(info.ri_diskio_byteswritten);
+  }
+#else
+  const base::FilePath dir =
+      base::FilePath("/proc").Append(base::NumberToString(process.Pid()));
+
+  // The sizes are in pages: total, resident, shared, ...
+  std::string statm;
+  if (base::ReadFileToString(dir.Append("statm"), &statm)) {
+    std::vector<std::string_view> pages = base::SplitStringPiece(
+        statm, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    uint64_t resident = 0;
+    uint64_t shared = 0;
+    if (pages.size() >= 3 && base::StringToUint64(pages[1], &resident) &&
+        base::StringToUint64(pages[2], &shared) && shared <= resident) {
+      const uint64_t page_size = base::GetPageSize();
+      row[kWorkingSetSize] = static_cast<double>((resident * page_size) >> 10);
+      row[kPrivateBytes] =
+          static_cast<double>(((resident - shared) * page_size) >> 10);
+      row[kSharedBytes] = static_cast<double>((shared * page_size) >> 10);
+    }
+  }
+
+  std::string io;
+  if (base::ReadFileToString(dir.Append("io"), &io)) {
+    base::StringPairs pairs;
+    base::SplitStringIntoKeyValuePairs(io, ':', '\n', &pairs);
+    for (const auto& [key, value] : pairs) {
+      uint64_t bytes = 0;
+      const std::string_view trimmed =
+          base::TrimWhitespaceASCII(value, base::TRIM_ALL);
+      if (!base::StringToUint64(trimmed, &bytes))
+        continue;
+      if (key == "read_bytes")
+        row[kReadBytes] = static_cast<double>(bytes);
+      else if (key == "write_bytes")
+        row[kWriteBytes] = static_cast<double>(bytes);
+    }
+  }
+#endif
+}
+
+}  // namespace
+
+// Owns the process handles and metrics used for sampling, lives on a
+// sequence of the thread pool.
+class ProcessMetricsSampler::Core {
+ public:
+  Core() = default;
+  ~Core() = default;
+
+  // disable copy
+  Core(const Core&) = delete;
+  Core& operator=(const Core&) = delete;
+
+  void AddProcess(int id, base::Process process) {
+    std::unique_ptr<base::ProcessMetrics> metrics;
+    if (process.is_current()) {
+      metrics = base::ProcessMetrics::CreateCurrentProcessMetrics();
+    } else {
+#if BUILDFLAG(IS_MAC)
+      metrics = base::ProcessMetrics::CreateProcessMetrics(
+          process.Handle(),
+          content::BrowserChildProcessHost::GetPortProvider());
+#else
+      metrics = base::ProcessMetrics::CreateProcessMetrics(process.Handle());
+#endif
+    }
+    // The CPU usage is measured since the previous call, which is made here
+    // so that the first sample doesn't report 0.
+    std::ignore = metrics->GetPlatformIndependentCPUUsage();
+    processes_.insert_or_assign(id,
+                                Entry{std::move(process), std::move(metrics)});
+  }
+
+  void RemoveProcess(int id) { processes_.erase(id); }
+
+  std::vector<double> Sample(
+      base::flat_map<base::ProcessId, uint64_t> gpu_memory) {
+    TRACE_EVENT0("electron", "ProcessMetricsSampler::Sample");
+    const double time = base::Time::Now().InMillisecondsFSinceUnixEpoch();
+    const int processor_count = base::SysInfo::NumberOfProcessors();
+
+    std::vector<double> rows(processes_.size() * kFieldCount,
+                             std::numeric_limits<double>::quiet_NaN());
+    double* row = rows.data();
+    for (auto& [id, entry] : processes_) {
+      const base::ProcessId pid = entry.process.Pid();
+      row[kTime] = time;
+      row[kPid] = pid;
+      if (std::optional<double> usage =
+              entry.metrics->GetPlatformIndependentCPUUsage())
+        row[kPercentCPUUsage] = *usage / processor_count;
+      ReadCounters(entry.process, row);
+      auto it = gpu_memory.find(pid);
+      row[kGPUMemory] =
+          it == gpu_memory.end() ? 0 : static_cast<double>(it->second >> 10);
+      row += kFieldCount;
+    }
+    return rows;
+  }
+
+ private:
+  struct Entry {
+    base::Process process;
+    std::unique_ptr<base::ProcessMetrics> metrics;
+  };
+
+  // The id used by App -> process.
+  base::flat_map<int, Entry> processes_;
+};
+
+ProcessMetricsSampler::ProcessMetricsSampler(base::TimeDelta interval,
+                                             size_t history_size)
+    : core_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      history_size_(history_size) {
+  timer_.Start(FROM_HERE, interval,
+               base::BindRepeating(&ProcessMetricsSampler::Sample,
+                                   base::Unretained(this)));
+}
+
+ProcessMetricsSampler::~ProcessMetricsSampler() = default;
+
+void ProcessMetricsSampler::AddProcess(int id, const ProcessMetric& metric) {
+  core_.AsyncCall(&Core::AddProcess).WithArgs(id, metric.process.Duplicate());
+}
+
+void ProcessMetricsSampler::RemoveProcess(int id) {
+  core_.AsyncCall(&Core::RemoveProcess).WithArgs(id);
+}
+
+v8::Local<v8::Value> ProcessMetricsSampler::GetHistory(
+    v8::Isolate* isolate) const {
+  size_t length = 0;
+  for (const auto& rows : history_)
+    length += rows.size();
+
+  v8::Local<v8::ArrayBuffer> buffer =
+      v8::ArrayBuffer::New(isolate, length * sizeof(double));
+  auto* data = static_cast<double*>(buffer->Data());
+  for (const auto& rows : history_)
+    data = std::copy(rows.begin(), rows.end(), data);
+
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("fields", std::vector<std::string>(std::begin(kFields),
+                                              std::end(kFields)));
+  dict.Set("data", v8::Local<v8::Value>(
+                       v8::Float64Array::New(buffer, 0, length)));
+  return dict.GetHandle();
+}
+
+void ProcessMetricsSampler::Sample() {
+  // Skipped while the previous sample is still being taken, so that a busy
+  // thread pool doesn't queue them up.
+  if (sample_pending_)
+    return;
+  sample_pending_ = true;
+  core_.AsyncCall(&Core::Sample)
+      .WithArgs(gpu_memory_)
+      .Then(base::BindOnce(&ProcessMetricsSampler::OnSampled,
+                           weak_factory_.GetWeakPtr()));
+  content::GpuDataManager::GetInstance()->RequestVideoMemoryUsageStatsUpdate(
+      base::BindOnce(&ProcessMetricsSampler::OnVideoMemoryStats,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ProcessMetricsSampler::OnSampled(std::vector<double> rows) {
+  sample_pending_ = false;
+  history_.push_back(std::move(rows));
+  while (history_.size() > history_size_)
+    history_.pop_front();
+}
+
+void ProcessMetricsSampler::OnVideoMemoryStats(
+    const gpu::VideoMemoryUsageStats& stats) {
+  gpu_memory_.clear();
+  for (const auto& [pid, process_stats] : stats.process_map)
+    gpu_memory_[pid] = process_stats.video_memory;
+}
+
+}  // namespace electron
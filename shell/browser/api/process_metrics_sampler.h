@@ -0,0 +1,71 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+#define ELECTRON_SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "v8/include/v8.h"
+
+namespace gpu {
+struct VideoMemoryUsageStats;
+}
+
+namespace electron {
+
+struct ProcessMetric;
+
+// Samples the CPU usage, memory, GPU memory and IO counters of the app's
+// processes on the thread pool, so that polling them doesn't make syscalls on
+// the main thread. See app.startProcessMetricsSampling().
+class ProcessMetricsSampler {
+ public:
+  ProcessMetricsSampler(base::TimeDelta interval, size_t history_size);
+  ~ProcessMetricsSampler();
+
+  // disable copy
+  ProcessMetricsSampler(const ProcessMetricsSampler&) = delete;
+  ProcessMetricsSampler& operator=(const ProcessMetricsSampler&) = delete;
+
+  // |id| is the key of the process in App's metrics.
+  void AddProcess(int id, const ProcessMetric& metric);
+  void RemoveProcess(int id);
+
+  // Returns the samples as {fields, data}, where |data| is a Float64Array
+  // holding a row of |fields| per process and sample, oldest first.
+  v8::Local<v8::Value> GetHistory(v8::Isolate* isolate) const;
+
+ private:
+  class Core;
+
+  void Sample();
+  void OnSampled(std::vector<double> rows);
+  void OnVideoMemoryStats(const gpu::VideoMemoryUsageStats& stats);
+
+  base::SequenceBound<Core> core_;
+  base::RepeatingTimer timer_;
+  const size_t history_size_;
+  bool sample_pending_ = false;
+
+  // The GPU process reports video memory per client process, the latest
+  // report is used by the next sample.
+  base::flat_map<base::ProcessId, uint64_t> gpu_memory_;
+
+  base::circular_deque<std::vector<double>> history_;
+
+  base::WeakPtrFactory<ProcessMetricsSampler> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
@@ -14,8 +14,11 @@
 namespace electron::api {
 
 SavePageHandler::SavePageHandler(content::WebContents* web_contents,
-                                 gin_helper::Promise<void> promise)
-    : web_contents_(web_contents), promise_(std::move(promise)) {}
+                                 gin_helper::Promise<void> promise,
+                                 ProgressCallback progress_callback)
+    : web_contents_(web_contents),
+      promise_(std::move(promise)),
+      progress_callback_(std::move(progress_callback)) {}
 
 SavePageHandler::~SavePageHandler() = default;
 
@@ -55,6 +58,8 @@ void SavePageHandler::OnDownloadUpdated(download::DownloadItem* item) {
     else
       promise_.RejectWithErrorMessage("Failed to save the page.");
     Destroy(item);
+  } else if (progress_callback_) {
+    progress_callback_.Run(item->GetReceivedBytes(), item->GetTotalBytes());
   }
 }
 
@@ -11,6 +11,9 @@ class BackgroundThrottlingSource {
  public:
   virtual ~BackgroundThrottlingSource() = default;
   virtual bool GetBackgroundThrottling() const = 0;
+  // A frozen source doesn't need its window to keep drawing, whatever its
+  // background throttling is.
+  virtual bool IsFrozen() const { return false; }
 };
 
 }  // namespace electron
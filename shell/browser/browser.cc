@@ -8,6 +8,7 @@
 #include <string>
 #include <utility>
 
+#include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/no_destructor.h"
 #include "base/path_service.h"
@@ -23,6 +24,8 @@
 #include "shell/common/application_info.h"
 #include "shell/common/electron_paths.h"
 #include "shell/common/gin_helper/arguments.h"
+#include "shell/common/options_switches.h"
+#include "shell/common/startup_metrics.h"
 #include "shell/common/thread_restrictions.h"
 
 namespace electron {
@@ -66,6 +69,12 @@ Browser* Browser::Get() {
   return ElectronBrowserMainParts::Get()->browser();
 }
 
+// static
+bool Browser::IsHeadless() {
+  return base::CommandLine::ForCurrentProcess()->HasSwitch(
+      switches::kHeadlessServer);
+}
+
 #if BUILDFLAG(IS_WIN) || BUILDFLAG(IS_LINUX)
 void Browser::Focus(gin::Arguments* args) {
   // Focus on the first visible window.
@@ -193,6 +202,7 @@ void Browser::DidFinishLaunching(base::Value::Dict launch_info) {
   }
 
   is_ready_ = true;
+  startup_metrics::RecordMilestone("ready");
   if (ready_promise_) {
     ready_promise_->Resolve();
   }
@@ -96,6 +96,11 @@ class Browser : public WindowListObserver {
 
   static Browser* Get();
 
+  // Whether the app was started with --headless-server, in which it renders
+  // pages offscreen and doesn't use the desktop: there are no tray icons,
+  // menus or notifications.
+  static bool IsHeadless();
+
   // Try to close all windows and quit the application.
   void Quit();
 
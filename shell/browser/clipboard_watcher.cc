@@ -0,0 +1,81 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/clipboard_watcher.h"
+
+#include <utility>
+
+#include "ui/base/clipboard/clipboard.h"
+#include "ui/base/clipboard/clipboard_monitor.h"
+
+#if BUILDFLAG(IS_WIN)
+#include "base/functional/bind.h"
+#include "ui/gfx/win/singleton_hwnd.h"
+#include "ui/gfx/win/singleton_hwnd_observer.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+#if BUILDFLAG(IS_MAC)
+// The pasteboard has no change notifications, reading its change count is
+// cheap though.
+constexpr base::TimeDelta kPollInterval = base::Milliseconds(250);
+#endif
+
+}  // namespace
+
+ClipboardWatcher::ClipboardWatcher(base::RepeatingClosure callback)
+    : callback_(std::move(callback)) {
+#if BUILDFLAG(IS_WIN)
+  singleton_hwnd_observer_ =
+      std::make_unique<gfx::SingletonHwndObserver>(base::BindRepeating(
+          &ClipboardWatcher::OnWndProc, base::Unretained(this)));
+  ::AddClipboardFormatListener(gfx::SingletonHwnd::GetInstance()->hwnd());
+#elif BUILDFLAG(IS_MAC)
+  sequence_number_ = ui::Clipboard::GetForCurrentThread()->GetSequenceNumber(
+      ui::ClipboardBuffer::kCopyPaste);
+  timer_.Start(FROM_HERE, kPollInterval, this,
+               &ClipboardWatcher::CheckSequenceNumber);
+#else
+  // The Ozone clipboard notifies the monitor of the selection changes of
+  // other applications too.
+  ui::ClipboardMonitor::GetInstance()->AddObserver(this);
+#endif
+}
+
+ClipboardWatcher::~ClipboardWatcher() {
+#if BUILDFLAG(IS_WIN)
+  ::RemoveClipboardFormatListener(gfx::SingletonHwnd::GetInstance()->hwnd());
+#elif !BUILDFLAG(IS_MAC)
+  ui::ClipboardMonitor::GetInstance()->RemoveObserver(this);
+#endif
+}
+
+void ClipboardWatcher::OnClipboardDataChanged() {
+  callback_.Run();
+}
+
+#if BUILDFLAG(IS_WIN)
+void ClipboardWatcher::OnWndProc(HWND hwnd,
+                                 UINT message,
+                                 WPARAM wparam,
+                                 LPARAM lparam) {
+  if (message == WM_CLIPBOARDUPDATE)
+    OnClipboardDataChanged();
+}
+#elif BUILDFLAG(IS_MAC)
+void ClipboardWatcher::CheckSequenceNumber() {
+  const ui::ClipboardSequenceNumberToken& sequence_number =
+      ui::Clipboard::GetForCurrentThread()->GetSequenceNumber(
+          ui::ClipboardBuffer::kCopyPaste);
+  if (sequence_number == sequence_number_)
+    return;
+  sequence_number_ = sequence_number;
+  OnClipboardDataChanged();
+}
+#endif
+
+}  // namespace electron
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_CLIPBOARD_WATCHER_H_
+#define ELECTRON_SHELL_BROWSER_CLIPBOARD_WATCHER_H_
+
+#include <memory>
+
+#include "base/functional/callback.h"
+#include "build/build_config.h"
+#include "ui/base/clipboard/clipboard_observer.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#endif
+
+#if BUILDFLAG(IS_MAC)
+#include "base/timer/timer.h"
+#include "ui/base/clipboard/clipboard_sequence_number_token.h"
+#endif
+
+#if BUILDFLAG(IS_WIN)
+namespace gfx {
+class SingletonHwndObserver;
+}
+#endif
+
+namespace electron {
+
+// Runs a callback whenever the content of the clipboard changes, including
+// when another application writes to it.
+//
+// Windows and Linux notify about changes, macOS doesn't so the change count
+// of the pasteboard is checked periodically there, which doesn't read any
+// data.
+class ClipboardWatcher : public ui::ClipboardObserver {
+ public:
+  explicit ClipboardWatcher(base::RepeatingClosure callback);
+  ~ClipboardWatcher() override;
+
+  // disable copy
+  ClipboardWatcher(const ClipboardWatcher&) = delete;
+  ClipboardWatcher& operator=(const ClipboardWatcher&) = delete;
+
+  // ui::ClipboardObserver:
+  void OnClipboardDataChanged() override;
+
+ private:
+#if BUILDFLAG(IS_WIN)
+  void OnWndProc(HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam);
+
+  std::unique_ptr<gfx::SingletonHwndObserver> singleton_hwnd_observer_;
+#elif BUILDFLAG(IS_MAC)
+  void CheckSequenceNumber();
+
+  base::RepeatingTimer timer_;
+  ui::ClipboardSequenceNumberToken sequence_number_;
+#endif
+
+  base::RepeatingClosure callback_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_CLIPBOARD_WATCHER_H_
@@ -0,0 +1,106 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/directory_enumerator.h"
+
+#include <iterator>
+#include <utility>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "net/base/net_errors.h"
+
+namespace electron {
+
+DirectoryEnumerator::DirectoryEnumerator(const base::FilePath& root)
+    : root_(root) {}
+
+DirectoryEnumerator::~DirectoryEnumerator() = default;
+
+void DirectoryEnumerator::Start(DoneCallback callback) {
+  origin_task_runner_ = base::SequencedTaskRunner::GetCurrentDefault();
+  callback_ = std::move(callback);
+  base::AutoLock lock(lock_);
+  PostListDirectory(root_);
+}
+
+void DirectoryEnumerator::Cancel() {
+  cancelled_.store(true);
+}
+
+void DirectoryEnumerator::PostListDirectory(const base::FilePath& dir) {
+  pending_++;
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&DirectoryEnumerator::ListDirectory, this, dir));
+}
+
+void DirectoryEnumerator::ListDirectory(const base::FilePath& dir) {
+  if (cancelled_.load()) {
+    OnDirectoryListed();
+    return;
+  }
+
+  TRACE_EVENT0("electron", "DirectoryEnumerator::ListDirectory");
+  // The links are resolved so that a directory is listed once however it is
+  // reached.
+  const base::FilePath real_dir = base::MakeAbsoluteFilePath(dir);
+  bool list = false;
+  if (!real_dir.empty() && base::DirectoryExists(real_dir)) {
+    base::AutoLock lock(lock_);
+    list = visited_.insert(real_dir).second;
+  } else if (dir == root_) {
+    base::AutoLock lock(lock_);
+    error_ = net::ERR_FILE_NOT_FOUND;
+  }
+
+  // The entries are listed without the lock, and added at once.
+  std::vector<base::FilePath> files;
+  std::vector<base::FilePath> subdirs;
+  if (list) {
+    base::FileEnumerator enumerator(
+        dir, /*recursive=*/false,
+        base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      if (enumerator.GetInfo().IsDirectory())
+        subdirs.push_back(std::move(path));
+      else
+        files.push_back(std::move(path));
+    }
+  }
+
+  {
+    base::AutoLock lock(lock_);
+    files_.insert(files_.end(), std::make_move_iterator(files.begin()),
+                  std::make_move_iterator(files.end()));
+    if (!cancelled_.load()) {
+      for (const auto& subdir : subdirs)
+        PostListDirectory(subdir);
+    }
+  }
+  OnDirectoryListed();
+}
+
+void DirectoryEnumerator::OnDirectoryListed() {
+  std::vector<base::FilePath> files;
+  int error;
+  {
+    base::AutoLock lock(lock_);
+    if (--pending_ > 0)
+      return;
+    files.swap(files_);
+    error = error_;
+  }
+  origin_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(std::move(callback_), std::move(files), error));
+}
+
+}  // namespace electron
@@ -0,0 +1,75 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_DIRECTORY_ENUMERATOR_H_
+#define ELECTRON_SHELL_BROWSER_DIRECTORY_ENUMERATOR_H_
+
+#include <atomic>
+#include <set>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/synchronization/lock.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/thread_annotations.h"
+
+namespace electron {
+
+// Lists the files under a directory recursively, like net::DirectoryLister
+// with NO_SORT_RECURSIVE, but with the subdirectories listed in parallel on
+// the thread pool, so that folders with a lot of subdirectories don't take
+// one thread pool task per file system call in a row.
+//
+// Symbolic links to directories are followed once, the directories that were
+// already listed are skipped.
+class DirectoryEnumerator
+    : public base::RefCountedThreadSafe<DirectoryEnumerator> {
+ public:
+  // |error| is a net error code, non-zero when |root| couldn't be listed.
+  using DoneCallback =
+      base::OnceCallback<void(std::vector<base::FilePath> files, int error)>;
+
+  explicit DirectoryEnumerator(const base::FilePath& root);
+
+  // disable copy
+  DirectoryEnumerator(const DirectoryEnumerator&) = delete;
+  DirectoryEnumerator& operator=(const DirectoryEnumerator&) = delete;
+
+  // |callback| runs on the calling sequence once all the directories were
+  // listed, or were skipped after Cancel().
+  void Start(DoneCallback callback);
+
+  // The directories that are not listed yet are skipped, the callback still
+  // runs with the files found so far.
+  void Cancel();
+
+ private:
+  friend class base::RefCountedThreadSafe<DirectoryEnumerator>;
+  ~DirectoryEnumerator();
+
+  // Called with |lock_| held for each directory that is found.
+  void PostListDirectory(const base::FilePath& dir)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Runs on the thread pool.
+  void ListDirectory(const base::FilePath& dir);
+  void OnDirectoryListed();
+
+  const base::FilePath root_;
+  scoped_refptr<base::SequencedTaskRunner> origin_task_runner_;
+  DoneCallback callback_;
+  std::atomic<bool> cancelled_{false};
+
+  base::Lock lock_;
+  size_t pending_ GUARDED_BY(lock_) = 0;
+  int error_ GUARDED_BY(lock_) = 0;
+  std::vector<base::FilePath> files_ GUARDED_BY(lock_);
+  std::set<base::FilePath> visited_ GUARDED_BY(lock_);
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_DIRECTORY_ENUMERATOR_H_
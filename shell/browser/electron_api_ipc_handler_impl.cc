@@ -6,11 +6,81 @@
 
 #include <utility>
 
+#include "base/containers/flat_map.h"
+#include "base/memory/raw_ptr.h"
+#include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/browser/shared_buffer_broker.h"
+#include "shell/browser/shared_value_store.h"
 
 namespace electron {
+
+namespace {
+
+base::flat_map<std::string, ElectronApiIPCHandlerImpl::ChannelPriority>&
+GetChannelPriorities() {
+  static base::NoDestructor<
+      base::flat_map<std::string, ElectronApiIPCHandlerImpl::ChannelPriority>>
+      priorities;
+  return *priorities;
+}
+
+bool IsLowPriorityChannel(bool internal, const std::string& channel) {
+  if (internal)
+    return false;
+  const auto& priorities = GetChannelPriorities();
+  auto it = priorities.find(channel);
+  return it != priorities.end() &&
+         it->second == ElectronApiIPCHandlerImpl::ChannelPriority::kLow;
+}
+
+base::flat_map<std::string, ElectronApiIPCHandlerImpl::ChannelStats>&
+GetMutableChannelStats() {
+  static base::NoDestructor<
+      base::flat_map<std::string, ElectronApiIPCHandlerImpl::ChannelStats>>
+      stats;
+  return *stats;
+}
+
+// Counts a message on |channel| along with the time until it goes out of
+// scope.
+class ScopedChannelStats {
+ public:
+  ScopedChannelStats(bool internal,
+                     const std::string& channel,
+                     const blink::CloneableMessage& arguments)
+      : channel_(internal ? nullptr : &channel),
+        bytes_(arguments.encoded_message.size()),
+        start_(base::TimeTicks::Now()) {}
+
+  ~ScopedChannelStats() {
+    if (!channel_)
+      return;
+    // Looked up again, the map may have changed while the message was
+    // emitted.
+    auto& stats = GetMutableChannelStats()[*channel_];
+    stats.messages++;
+    stats.bytes += bytes_;
+    stats.handler_time += base::TimeTicks::Now() - start_;
+  }
+
+  // disable copy
+  ScopedChannelStats(const ScopedChannelStats&) = delete;
+  ScopedChannelStats& operator=(const ScopedChannelStats&) = delete;
+
+ private:
+  const raw_ptr<const std::string> channel_;
+  const size_t bytes_;
+  const base::TimeTicks start_;
+};
+
+}  // namespace
+
 ElectronApiIPCHandlerImpl::ElectronApiIPCHandlerImpl(
     content::RenderFrameHost* frame_host,
     mojo::PendingAssociatedReceiver<mojom::ElectronApiIPC> receiver)
@@ -38,16 +108,54 @@ void ElectronApiIPCHandlerImpl::OnConnectionError() {
 void ElectronApiIPCHandlerImpl::Message(bool internal,
                                         const std::string& channel,
                                         blink::CloneableMessage arguments) {
+  if (IsLowPriorityChannel(internal, channel)) {
+    // The arguments are deserialized when the message is emitted, so a large
+    // message doesn't hold up the ones that arrive after it either.
+    content::GetUIThreadTaskRunner({base::TaskPriority::USER_VISIBLE})
+        ->PostTask(FROM_HERE,
+                   base::BindOnce(&ElectronApiIPCHandlerImpl::EmitMessage,
+                                  GetWeakPtr(), internal, channel,
+                                  std::move(arguments)));
+    return;
+  }
+  EmitMessage(internal, channel, std::move(arguments));
+}
+
+void ElectronApiIPCHandlerImpl::EmitMessage(bool internal,
+                                            const std::string& channel,
+                                            blink::CloneableMessage arguments) {
+  TRACE_EVENT1("electron", "ElectronApiIPCHandlerImpl::Message", "channel",
+               channel);
+  ScopedChannelStats stats(internal, channel, arguments);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->Message(internal, channel, std::move(arguments),
                               GetRenderFrameHost());
   }
 }
+
 void ElectronApiIPCHandlerImpl::Invoke(bool internal,
                                        const std::string& channel,
                                        blink::CloneableMessage arguments,
                                        InvokeCallback callback) {
+  if (IsLowPriorityChannel(internal, channel)) {
+    content::GetUIThreadTaskRunner({base::TaskPriority::USER_VISIBLE})
+        ->PostTask(FROM_HERE,
+                   base::BindOnce(&ElectronApiIPCHandlerImpl::EmitInvoke,
+                                  GetWeakPtr(), internal, channel,
+                                  std::move(arguments), std::move(callback)));
+    return;
+  }
+  EmitInvoke(internal, channel, std::move(arguments), std::move(callback));
+}
+
+void ElectronApiIPCHandlerImpl::EmitInvoke(bool internal,
+                                           const std::string& channel,
+                                           blink::CloneableMessage arguments,
+                                           InvokeCallback callback) {
+  TRACE_EVENT1("electron", "ElectronApiIPCHandlerImpl::Invoke", "channel",
+               channel);
+  ScopedChannelStats stats(internal, channel, arguments);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->Invoke(internal, channel, std::move(arguments),
@@ -69,6 +177,9 @@ void ElectronApiIPCHandlerImpl::MessageSync(bool internal,
                                             const std::string& channel,
                                             blink::CloneableMessage arguments,
                                             MessageSyncCallback callback) {
+  TRACE_EVENT1("electron", "ElectronApiIPCHandlerImpl::MessageSync", "channel",
+               channel);
+  ScopedChannelStats stats(internal, channel, arguments);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->MessageSync(internal, channel, std::move(arguments),
@@ -78,6 +189,9 @@ void ElectronApiIPCHandlerImpl::MessageSync(bool internal,
 
 void ElectronApiIPCHandlerImpl::MessageHost(const std::string& channel,
                                             blink::CloneableMessage arguments) {
+  TRACE_EVENT1("electron", "ElectronApiIPCHandlerImpl::MessageHost", "channel",
+               channel);
+  ScopedChannelStats stats(/*internal=*/false, channel, arguments);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->MessageHost(channel, std::move(arguments),
@@ -85,6 +199,23 @@ void ElectronApiIPCHandlerImpl::MessageHost(const std::string& channel,
   }
 }
 
+void ElectronApiIPCHandlerImpl::GetSharedValues(
+    GetSharedValuesCallback callback) {
+  std::move(callback).Run(SharedValueStore::GetInstance()->DuplicateRegion());
+}
+
+void ElectronApiIPCHandlerImpl::GetSharedBuffer(
+    const std::string& name,
+    GetSharedBufferCallback callback) {
+  content::RenderFrameHost* frame = GetRenderFrameHost();
+  if (!frame) {
+    std::move(callback).Run(base::ReadOnlySharedMemoryRegion());
+    return;
+  }
+  std::move(callback).Run(SharedBufferBroker::GetInstance()->DuplicateRegion(
+      name, frame->GetLastCommittedOrigin()));
+}
+
 content::RenderFrameHost* ElectronApiIPCHandlerImpl::GetRenderFrameHost() {
   return content::RenderFrameHost::FromID(render_frame_host_id_);
 }
@@ -95,4 +226,28 @@ void ElectronApiIPCHandlerImpl::Create(
     mojo::PendingAssociatedReceiver<mojom::ElectronApiIPC> receiver) {
   new ElectronApiIPCHandlerImpl(frame_host, std::move(receiver));
 }
+
+// static
+void ElectronApiIPCHandlerImpl::SetChannelPriority(
+    const std::string& channel,
+    ChannelPriority priority) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (priority == ChannelPriority::kNormal)
+    GetChannelPriorities().erase(channel);
+  else
+    GetChannelPriorities()[channel] = priority;
+}
+
+// static
+const base::flat_map<std::string, ElectronApiIPCHandlerImpl::ChannelStats>&
+ElectronApiIPCHandlerImpl::GetChannelStats() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  return GetMutableChannelStats();
+}
+
+// static
+void ElectronApiIPCHandlerImpl::ResetChannelStats() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  GetMutableChannelStats().clear();
+}
 }  // namespace electron
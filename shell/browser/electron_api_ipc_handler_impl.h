@@ -5,9 +5,12 @@
 #ifndef ELECTRON_SHELL_BROWSER_ELECTRON_API_IPC_HANDLER_IMPL_H_
 #define ELECTRON_SHELL_BROWSER_ELECTRON_API_IPC_HANDLER_IMPL_H_
 
+#include <cstdint>
 #include <string>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/public/browser/global_routing_id.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "electron/shell/common/api/api.mojom.h"
@@ -30,6 +33,25 @@ class ElectronApiIPCHandlerImpl : public mojom::ElectronApiIPC,
       content::RenderFrameHost* frame_host,
       mojo::PendingAssociatedReceiver<mojom::ElectronApiIPC> receiver);
 
+  // The messages on a channel of low priority are emitted after the other
+  // tasks of the UI thread, so that the messages of other channels overtake
+  // them. Messages on channels of the same priority keep their order.
+  enum class ChannelPriority { kNormal, kLow };
+  static void SetChannelPriority(const std::string& channel,
+                                 ChannelPriority priority);
+
+  // Counters of the messages received on each channel since the last reset,
+  // the internal channels are not counted. |handler_time| is the time spent
+  // deserializing and emitting the messages, for ipcMain.handle() it doesn't
+  // include the time until a returned promise settles.
+  struct ChannelStats {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    base::TimeDelta handler_time;
+  };
+  static const base::flat_map<std::string, ChannelStats>& GetChannelStats();
+  static void ResetChannelStats();
+
   // disable copy
   ElectronApiIPCHandlerImpl(const ElectronApiIPCHandlerImpl&) = delete;
   ElectronApiIPCHandlerImpl& operator=(const ElectronApiIPCHandlerImpl&) =
@@ -51,6 +73,9 @@ class ElectronApiIPCHandlerImpl : public mojom::ElectronApiIPC,
                    MessageSyncCallback callback) override;
   void MessageHost(const std::string& channel,
                    blink::CloneableMessage arguments) override;
+  void GetSharedValues(GetSharedValuesCallback callback) override;
+  void GetSharedBuffer(const std::string& name,
+                       GetSharedBufferCallback callback) override;
 
   base::WeakPtr<ElectronApiIPCHandlerImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
@@ -64,6 +89,14 @@ class ElectronApiIPCHandlerImpl : public mojom::ElectronApiIPC,
 
   void OnConnectionError();
 
+  void EmitMessage(bool internal,
+                   const std::string& channel,
+                   blink::CloneableMessage arguments);
+  void EmitInvoke(bool internal,
+                  const std::string& channel,
+                  blink::CloneableMessage arguments,
+                  InvokeCallback callback);
+
   content::RenderFrameHost* GetRenderFrameHost();
 
   content::GlobalRenderFrameHostId render_frame_host_id_;
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/base_switches.h"
 #include "base/command_line.h"
@@ -59,6 +60,8 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "extensions/browser/extension_navigation_ui_data.h"
 #include "mojo/public/cpp/bindings/binder_map.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/http/http_request_headers.h"
 #include "net/ssl/ssl_cert_request_info.h"
 #include "net/ssl/ssl_private_key.h"
 #include "ppapi/buildflags/buildflags.h"
@@ -72,6 +75,7 @@
 #include "services/network/public/cpp/resource_request_body.h"
 #include "services/network/public/cpp/self_deleting_url_loader_factory.h"
 #include "services/network/public/cpp/url_loader_factory_builder.h"
+#include "services/network/public/mojom/websocket.mojom.h"
 #include "shell/app/electron_crash_reporter_client.h"
 #include "shell/browser/api/electron_api_app.h"
 #include "shell/browser/api/electron_api_crash_reporter.h"
@@ -101,6 +105,7 @@
 #include "shell/browser/notifications/notification_presenter.h"
 #include "shell/browser/notifications/platform_notification_service.h"
 #include "shell/browser/protocol_registry.h"
+#include "shell/browser/renderer_process_pool.h"
 #include "shell/browser/serial/electron_serial_delegate.h"
 #include "shell/browser/session_preferences.h"
 #include "shell/browser/ui/devtools_manager_delegate.h"
@@ -369,11 +374,20 @@ content::WebContents* ElectronBrowserClient::GetWebContentsFromProcessID(
   return WebContentsPreferences::GetWebContentsFromProcessID(process_id);
 }
 
-content::SiteInstance* ElectronBrowserClient::GetSiteInstanceFromAffinity(
+scoped_refptr<content::SiteInstance>
+ElectronBrowserClient::GetSiteInstanceForProcessGroup(
     content::BrowserContext* browser_context,
-    const GURL& url,
-    content::RenderFrameHost* rfh) const {
-  return nullptr;
+    const std::string& process_group,
+    const RendererProcessPreferences& prefs) const {
+  content::WebContents* web_contents =
+      WebContentsPreferences::GetWebContentsInProcessGroup(
+          browser_context, process_group, prefs);
+  if (!web_contents)
+    return nullptr;
+  // Joining the BrowsingInstance of the group makes same-site pages share
+  // the SiteInstance, and thus the process, of |web_contents|. Pages of other
+  // sites still get processes of their own.
+  return web_contents->GetPrimaryMainFrame()->GetSiteInstance();
 }
 
 bool ElectronBrowserClient::IsRendererSubFrame(int process_id) const {
@@ -574,6 +588,13 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
       if (web_preferences)
         web_preferences->AppendCommandLineSwitches(
             command_line, IsRendererSubFrame(process_id));
+    } else if (auto* host = content::RenderProcessHost::FromID(process_id)) {
+      // Processes launched ahead of time by session.setRendererProcessPool().
+      auto* pool =
+          static_cast<ElectronBrowserContext*>(host->GetBrowserContext())
+              ->renderer_process_pool();
+      if (pool)
+        pool->AppendCommandLineSwitches(process_id, command_line);
     }
   }
 }
@@ -752,6 +773,11 @@ bool ElectronBrowserClient::IsSuitableHost(
 bool ElectronBrowserClient::ShouldUseProcessPerSite(
     content::BrowserContext* browser_context,
     const GURL& effective_url) {
+  // The DevTools frontends of a session share a renderer process, so that
+  // opening DevTools for many windows doesn't start a process and load the
+  // whole frontend again for each of them.
+  if (effective_url.SchemeIs(content::kChromeDevToolsScheme))
+    return true;
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   const extensions::Extension* extension =
       GetEnabledExtensionFromEffectiveURL(browser_context, effective_url);
@@ -966,6 +992,9 @@ ElectronBrowserClient::CreateDevToolsManagerDelegate() {
 }
 
 NotificationPresenter* ElectronBrowserClient::GetNotificationPresenter() {
+  // Headless servers have no desktop to show the notifications on.
+  if (Browser::IsHeadless())
+    return nullptr;
   if (!notification_presenter_) {
     notification_presenter_.reset(NotificationPresenter::Create());
   }
@@ -1268,8 +1297,12 @@ void ElectronBrowserClient::CreateWebSocket(
   auto web_request = api::WebRequest::FromOrCreate(isolate, browser_context);
   DCHECK(web_request.get());
 
+  // The session may only have listeners for other resource types or URLs,
+  // in which case the handshake doesn't need to go through the proxy.
+  const bool has_listener = web_request->HasListenerForWebSocket(url);
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
-  if (!web_request->HasListener()) {
+  if (!has_listener) {
     auto* web_request_api = extensions::BrowserContextKeyedAPIFactory<
         extensions::WebRequestAPI>::Get(browser_context);
 
@@ -1282,6 +1315,17 @@ void ElectronBrowserClient::CreateWebSocket(
   }
 #endif
 
+  if (!has_listener) {
+    std::vector<network::mojom::HttpHeaderPtr> headers;
+    if (user_agent) {
+      headers.push_back(network::mojom::HttpHeader::New(
+          net::HttpRequestHeaders::kUserAgent, *user_agent));
+    }
+    std::move(factory).Run(url, std::move(headers), std::move(handshake_client),
+                           mojo::NullRemote(), mojo::NullRemote());
+    return;
+  }
+
   ProxyingWebSocket::StartProxying(
       web_request.get(), std::move(factory), url, site_for_cookies, user_agent,
       std::move(handshake_client), true, frame->GetProcess()->GetID(),
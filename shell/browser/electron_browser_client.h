@@ -13,6 +13,7 @@
 #include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "content/public/browser/content_browser_client.h"
 #include "content/public/browser/render_process_host_observer.h"
@@ -41,6 +42,7 @@ class ElectronBrowserMainParts;
 class NotificationPresenter;
 class PlatformNotificationService;
 class ElectronWebAuthenticationDelegate;
+struct RendererProcessPreferences;
 
 class ElectronBrowserClient : public content::ContentBrowserClient,
                               public content::RenderProcessHostObserver {
@@ -61,6 +63,15 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
   // Returns the WebContents for pending render processes.
   content::WebContents* GetWebContentsFromProcessID(int process_id);
 
+  // Returns the SiteInstance a new WebContents in |process_group| should be
+  // created with to share renderer processes with its group, or null when no
+  // WebContents of the group runs with the same |prefs|.
+  // See webPreferences.processGroup.
+  scoped_refptr<content::SiteInstance> GetSiteInstanceForProcessGroup(
+      content::BrowserContext* browser_context,
+      const std::string& process_group,
+      const RendererProcessPreferences& prefs) const;
+
   NotificationPresenter* GetNotificationPresenter();
 
   void WebNotificationAllowed(content::RenderFrameHost* rfh,
@@ -309,11 +320,6 @@ class ElectronBrowserClient : public content::ContentBrowserClient,
       const content::ChildProcessTerminationInfo& info) override;
 
  private:
-  content::SiteInstance* GetSiteInstanceFromAffinity(
-      content::BrowserContext* browser_context,
-      const GURL& url,
-      content::RenderFrameHost* rfh) const;
-
   bool IsRendererSubFrame(int process_id) const;
 
   // pending_render_process => web contents.
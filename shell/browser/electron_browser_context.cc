@@ -4,6 +4,7 @@
 
 #include "shell/browser/electron_browser_context.h"
 
+#include <map>
 #include <memory>
 
 #include <utility>
@@ -20,6 +21,7 @@
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/pref_names.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
+#include "components/prefs/in_memory_pref_store.h"
 #include "components/prefs/json_pref_store.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
@@ -45,8 +47,10 @@
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/electron_download_manager_delegate.h"
 #include "shell/browser/electron_permission_manager.h"
+#include "shell/browser/net/network_stats.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
 #include "shell/browser/protocol_registry.h"
+#include "shell/browser/renderer_process_pool.h"
 #include "shell/browser/special_storage_policy.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
 #include "shell/browser/web_contents_permission_helper.h"
@@ -223,6 +227,20 @@ DesktopMediaIDToDisplayMediaInformation(
       zoom_level);
 }
 
+struct SharedPrefStore {
+  scoped_refptr<JsonPrefStore> store;
+  int contexts = 0;
+};
+
+// The Preferences files in use, keyed by their path. The default session and
+// the in-memory sessions all live in the session data directory, they share
+// one store instead of each reading the file and then overwriting the
+// changes of the others.
+std::map<base::FilePath, SharedPrefStore>& GetSharedPrefStores() {
+  static base::NoDestructor<std::map<base::FilePath, SharedPrefStore>> stores;
+  return *stores;
+}
+
 // Convert string to lower case and escape it.
 std::string MakePartitionName(const std::string& input) {
   return base::EscapePath(base::ToLowerASCII(input));
@@ -257,6 +275,7 @@ ElectronBrowserContext::ElectronBrowserContext(
     : in_memory_pref_store_(new ValueMapPrefStore),
       storage_policy_(base::MakeRefCounted<SpecialStoragePolicy>()),
       protocol_registry_(base::WrapUnique(new ProtocolRegistry)),
+      network_stats_(std::make_unique<NetworkStats>()),
       in_memory_(in_memory),
       ssl_config_(network::mojom::SSLConfig::New()) {
   // Read options.
@@ -268,6 +287,18 @@ ElectronBrowserContext::ElectronBrowserContext(
 
   base::StringToInt(command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
                     &max_cache_size_);
+  if (auto cache_size_opt = options.FindInt("cacheSize")) {
+    max_cache_size_ = std::max(cache_size_opt.value(), 0);
+  }
+  // The cache option can also be an object that configures the cache.
+  if (const base::Value::Dict* cache = options.FindDict("cache")) {
+    use_cache_ = true;
+    if (auto max_size_opt = cache->FindInt("maxSize"))
+      max_cache_size_ = std::max(max_size_opt.value(), 0);
+    if (const std::string* backend = cache->FindString("backend"))
+      memory_cache_ = *backend == "memory";
+  }
+  ephemeral_ = in_memory && options.FindBool("ephemeral").value_or(false);
 
   if (auto* path_value = std::get_if<std::reference_wrapper<const std::string>>(
           &partition_location)) {
@@ -307,21 +338,38 @@ ElectronBrowserContext::ElectronBrowserContext(
 
 ElectronBrowserContext::~ElectronBrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  renderer_process_pool_.reset();
   NotifyWillBeDestroyed();
   // Notify any keyed services of browser context destruction.
   BrowserContextDependencyManager::GetInstance()->DestroyBrowserContextServices(
       this);
   ShutdownStoragePartitions();
+
+  // The store is written for the last time when the last PrefService using
+  // it goes away.
+  if (!ephemeral_) {
+    auto& stores = GetSharedPrefStores();
+    auto it = stores.find(GetPath().Append(FILE_PATH_LITERAL("Preferences")));
+    if (it != stores.end() && --it->second.contexts == 0)
+      stores.erase(it);
+  }
 }
 
 void ElectronBrowserContext::InitPrefs() {
-  auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
-  ScopedAllowBlockingForElectron allow_blocking;
   PrefServiceFactory prefs_factory;
-  scoped_refptr<JsonPrefStore> pref_store =
-      base::MakeRefCounted<JsonPrefStore>(prefs_path);
-  pref_store->ReadPrefs();  // Synchronous.
-  prefs_factory.set_user_prefs(pref_store);
+  if (ephemeral_) {
+    prefs_factory.set_user_prefs(base::MakeRefCounted<InMemoryPrefStore>());
+  } else {
+    auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
+    SharedPrefStore& shared = GetSharedPrefStores()[prefs_path];
+    if (!shared.store) {
+      ScopedAllowBlockingForElectron allow_blocking;
+      shared.store = base::MakeRefCounted<JsonPrefStore>(prefs_path);
+      shared.store->ReadPrefs();  // Synchronous.
+    }
+    ++shared.contexts;
+    prefs_factory.set_user_prefs(shared.store);
+  }
   prefs_factory.set_command_line_prefs(in_memory_pref_store());
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -457,6 +505,12 @@ predictors::PreconnectManager* ElectronBrowserContext::GetPreconnectManager() {
   return preconnect_manager_.get();
 }
 
+RendererProcessPool* ElectronBrowserContext::GetRendererProcessPool() {
+  if (!renderer_process_pool_)
+    renderer_process_pool_ = std::make_unique<RendererProcessPool>(this);
+  return renderer_process_pool_.get();
+}
+
 scoped_refptr<network::SharedURLLoaderFactory>
 ElectronBrowserContext::GetURLLoaderFactory() {
   if (url_loader_factory_)
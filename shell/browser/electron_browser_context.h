@@ -60,9 +60,11 @@ using DevicePermissionMap =
 class ElectronDownloadManagerDelegate;
 class ElectronPermissionManager;
 class CookieChangeNotifier;
+class NetworkStats;
 class ResolveProxyHelper;
 class WebViewManager;
 class ProtocolRegistry;
+class RendererProcessPool;
 
 using DisplayMediaResponseCallbackJs =
     base::OnceCallback<void(gin::Arguments* args)>;
@@ -121,8 +123,10 @@ class ElectronBrowserContext : public content::BrowserContext {
   std::string GetUserAgent() const;
   bool can_use_http_cache() const { return use_cache_; }
   int max_cache_size() const { return max_cache_size_; }
+  bool use_memory_cache() const { return memory_cache_; }
   ResolveProxyHelper* GetResolveProxyHelper();
   predictors::PreconnectManager* GetPreconnectManager();
+  RendererProcessPool* GetRendererProcessPool();
   scoped_refptr<network::SharedURLLoaderFactory> GetURLLoaderFactory();
 
   std::string GetMediaDeviceIDSalt();
@@ -175,6 +179,13 @@ class ElectronBrowserContext : public content::BrowserContext {
     return protocol_registry_.get();
   }
 
+  NetworkStats* network_stats() const { return network_stats_.get(); }
+
+  // Null until session.setRendererProcessPool() is called.
+  RendererProcessPool* renderer_process_pool() const {
+    return renderer_process_pool_.get();
+  }
+
   void SetSSLConfig(network::mojom::SSLConfigPtr config);
   network::mojom::SSLConfigPtr GetSSLConfig();
   void SetSSLConfigClient(mojo::Remote<network::mojom::SSLConfigClient> client);
@@ -234,12 +245,18 @@ class ElectronBrowserContext : public content::BrowserContext {
   scoped_refptr<storage::SpecialStoragePolicy> storage_policy_;
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
   std::unique_ptr<ProtocolRegistry> protocol_registry_;
+  std::unique_ptr<NetworkStats> network_stats_;
+  std::unique_ptr<RendererProcessPool> renderer_process_pool_;
 
   std::optional<std::string> user_agent_;
   base::FilePath path_;
   bool in_memory_ = false;
+  // Ephemeral sessions keep their prefs in memory instead of in a file.
+  bool ephemeral_ = false;
   bool use_cache_ = true;
   int max_cache_size_ = 0;
+  // Whether a persistent session keeps its HTTP cache in memory.
+  bool memory_cache_ = false;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   // Owned by the KeyedService system.
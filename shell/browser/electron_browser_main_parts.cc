@@ -60,11 +60,13 @@
 #include "shell/browser/ui/devtools_manager_delegate.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/application_info.h"
+#include "shell/common/bootstrap_code_cache.h"
 #include "shell/common/electron_paths.h"
 #include "shell/common/gin_helper/trackable_object.h"
 #include "shell/common/logging.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_metrics.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/base/ui_base_switches.h"
@@ -208,6 +210,17 @@ int ElectronBrowserMainParts::GetExitCode() const {
 }
 
 int ElectronBrowserMainParts::PreEarlyInitialization() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronBrowserMainParts::PreEarlyInitialization");
+  // Files needed by later phases are read into the page cache on the thread
+  // pool while the main thread is busy creating the JavaScript environment.
+  PrefetchResourceBundle(
+      base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+          ::switches::kLang));
+  if (electron::fuses::IsBootstrapCodeCacheEnabled())
+    bootstrap_code_cache_ =
+        std::make_unique<BootstrapCodeCache>(FILE_PATH_LITERAL("bootstrap"));
+
   field_trial_list_ = std::make_unique<base::FieldTrialList>();
 #if BUILDFLAG(IS_POSIX)
   HandleSIGCHLD();
@@ -227,20 +240,30 @@ int ElectronBrowserMainParts::PreEarlyInitialization() {
 }
 
 void ElectronBrowserMainParts::PostEarlyInitialization() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronBrowserMainParts::PostEarlyInitialization");
   // A workaround was previously needed because there was no ThreadTaskRunner
   // set.  If this check is failing we may need to re-add that workaround
   DCHECK(base::SingleThreadTaskRunner::HasCurrentDefault());
 
   // The ProxyResolverV8 has setup a complete V8 environment, in order to
   // avoid conflicts we only initialize our V8 environment after that.
-  js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+  {
+    startup_metrics::ScopedPhase js_env_phase("JavascriptEnvironment");
+    js_env_ =
+        std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+  }
 
   v8::HandleScope scope(js_env_->isolate());
 
   node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
   // Create the global environment.
-  node_env_ = node_bindings_->CreateEnvironment(
-      js_env_->isolate()->GetCurrentContext(), js_env_->platform());
+  {
+    startup_metrics::ScopedPhase create_env_phase(
+        "NodeBindings::CreateEnvironment");
+    node_env_ = node_bindings_->CreateEnvironment(
+        js_env_->isolate()->GetCurrentContext(), js_env_->platform());
+  }
 
   node_env_->set_trace_sync_io(node_env_->options()->trace_sync_io);
 
@@ -257,7 +280,11 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
   node_bindings_->set_uv_env(node_env_.get());
 
   // Load everything.
+  if (bootstrap_code_cache_)
+    bootstrap_code_cache_->Load(node_env_.get());
   node_bindings_->LoadEnvironment(node_env_.get());
+  if (bootstrap_code_cache_)
+    bootstrap_code_cache_->Save(node_env_.get());
 
   // Wait for app
   node_bindings_->JoinAppCode();
@@ -282,6 +309,8 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 }
 
 int ElectronBrowserMainParts::PreCreateThreads() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronBrowserMainParts::PreCreateThreads");
   if (!views::LayoutProvider::Get()) {
     layout_provider_ = std::make_unique<views::LayoutProvider>();
   }
@@ -363,6 +392,8 @@ int ElectronBrowserMainParts::PreCreateThreads() {
 }
 
 void ElectronBrowserMainParts::PostCreateThreads() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronBrowserMainParts::PostCreateThreads");
   content::GetIOThreadTaskRunner({})->PostTask(
       FROM_HERE,
       base::BindOnce(&tracing::TracingSamplerProfiler::CreateOnChildThread));
@@ -393,30 +424,35 @@ void ElectronBrowserMainParts::PostDestroyThreads() {
 }
 
 void ElectronBrowserMainParts::ToolkitInitialized() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronBrowserMainParts::ToolkitInitialized");
 #if BUILDFLAG(IS_LINUX)
-  auto* linux_ui = ui::GetDefaultLinuxUi();
-  CHECK(linux_ui);
-  linux_ui_getter_ = std::make_unique<LinuxUiGetterImpl>();
-
-  // Try loading gtk symbols used by Electron.
-  electron::InitializeElectron_gtk(gtk::GetLibGtk());
-  if (!electron::IsElectron_gtkInitialized()) {
-    electron::UninitializeElectron_gtk();
-  }
+  // The toolkit needs a display, which headless servers don't have.
+  if (!Browser::IsHeadless()) {
+    auto* linux_ui = ui::GetDefaultLinuxUi();
+    CHECK(linux_ui);
+    linux_ui_getter_ = std::make_unique<LinuxUiGetterImpl>();
+
+    // Try loading gtk symbols used by Electron.
+    electron::InitializeElectron_gtk(gtk::GetLibGtk());
+    if (!electron::IsElectron_gtkInitialized()) {
+      electron::UninitializeElectron_gtk();
+    }
 
-  electron::InitializeElectron_gdk_pixbuf(gtk::GetLibGdkPixbuf());
-  CHECK(electron::IsElectron_gdk_pixbufInitialized())
-      << "Failed to initialize libgdk_pixbuf-2.0.so.0";
+    electron::InitializeElectron_gdk_pixbuf(gtk::GetLibGdkPixbuf());
+    CHECK(electron::IsElectron_gdk_pixbufInitialized())
+        << "Failed to initialize libgdk_pixbuf-2.0.so.0";
 
-  // source theme changes from system settings, including settings portal:
-  // https://flatpak.github.io/xdg-desktop-portal/#gdbus-org.freedesktop.portal.Settings
-  dark_mode_manager_ = std::make_unique<ui::DarkModeManagerLinux>();
+    // source theme changes from system settings, including settings portal:
+    // https://flatpak.github.io/xdg-desktop-portal/#gdbus-org.freedesktop.portal.Settings
+    dark_mode_manager_ = std::make_unique<ui::DarkModeManagerLinux>();
 
-  ui::LinuxUi::SetInstance(linux_ui);
+    ui::LinuxUi::SetInstance(linux_ui);
 
-  // Cursor theme changes are tracked by LinuxUI (via a CursorThemeManager
-  // implementation). Start observing them once it's initialized.
-  ui::CursorFactory::GetInstance()->ObserveThemeChanges();
+    // Cursor theme changes are tracked by LinuxUI (via a CursorThemeManager
+    // implementation). Start observing them once it's initialized.
+    ui::CursorFactory::GetInstance()->ObserveThemeChanges();
+  }
 #endif
 
 #if defined(USE_AURA)
@@ -436,6 +472,8 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
 }
 
 int ElectronBrowserMainParts::PreMainMessageLoopRun() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronBrowserMainParts::PreMainMessageLoopRun");
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareEmbedThread();
@@ -500,6 +538,8 @@ void ElectronBrowserMainParts::WillRunMainMessageLoop(
 }
 
 void ElectronBrowserMainParts::PostCreateMainMessageLoop() {
+  startup_metrics::ScopedPhase phase(
+      "ElectronBrowserMainParts::PostCreateMainMessageLoop");
 #if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_MAC)
   std::string app_name = electron::Browser::Get()->GetName();
 #endif
@@ -48,6 +48,7 @@ class DarkModeManagerLinux;
 
 namespace electron {
 
+class BootstrapCodeCache;
 class Browser;
 class ElectronBindings;
 class JavascriptEnvironment;
@@ -163,7 +164,11 @@ class ElectronBrowserMainParts : public content::BrowserMainParts {
   // depends-on: node_bindings_
   std::unique_ptr<JavascriptEnvironment> js_env_;
 
-  // depends-on: js_env_'s isolate
+  // Only set with the bootstrapCodeCache fuse. Declared before node_env_
+  // since its builtin loader refers to the cache data.
+  std::unique_ptr<BootstrapCodeCache> bootstrap_code_cache_;
+
+  // depends-on: js_env_'s isolate, bootstrap_code_cache_
   std::shared_ptr<node::Environment> node_env_;
 
   // depends-on: js_env_'s isolate
@@ -8,6 +8,7 @@
 
 #include "base/command_line.h"
 #include "base/environment.h"
+#include "shell/browser/browser.h"
 #include "ui/base/ozone_buildflags.h"
 #include "ui/ozone/public/ozone_switches.h"
 
@@ -123,7 +124,10 @@ std::string MaybeFixPlatformName(const std::string& ozone_platform_hint) {
 void ElectronBrowserMainParts::DetectOzonePlatform() {
   auto const env = base::Environment::Create();
   auto* const command_line = base::CommandLine::ForCurrentProcess();
-  if (!command_line->HasSwitch(switches::kOzonePlatform)) {
+  if (Browser::IsHeadless()) {
+    // Headless servers have no display to connect to.
+    command_line->AppendSwitchASCII(switches::kOzonePlatform, "headless");
+  } else if (!command_line->HasSwitch(switches::kOzonePlatform)) {
     auto ozone_platform_hint =
         command_line->GetSwitchValueASCII(switches::kOzonePlatformHint);
     if (ozone_platform_hint.empty()) {
@@ -5,6 +5,7 @@
 #include "shell/browser/electron_permission_manager.h"
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -120,8 +121,15 @@ void ElectronPermissionManager::SetPermissionRequestHandler(
 }
 
 void ElectronPermissionManager::SetPermissionCheckHandler(
-    const CheckHandler& handler) {
+    const CheckHandler& handler,
+    bool cache_results) {
   check_handler_ = handler;
+  cache_check_results_ = cache_results;
+  ClearPermissionCheckCache();
+}
+
+void ElectronPermissionManager::ClearPermissionCheckCache() {
+  check_cache_.clear();
 }
 
 void ElectronPermissionManager::SetDevicePermissionHandler(
@@ -301,6 +309,17 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
   if (check_handler_.is_null())
     return true;
 
+  std::optional<CheckCacheKey> cache_key;
+  if (cache_check_results_) {
+    const std::string* embedding_origin = details.FindString("embeddingOrigin");
+    const std::string* security_origin = details.FindString("securityOrigin");
+    cache_key.emplace(permission, url::Origin::Create(requesting_origin),
+                      embedding_origin ? *embedding_origin : std::string(),
+                      security_origin ? *security_origin : std::string());
+    if (auto it = check_cache_.find(*cache_key); it != check_cache_.end())
+      return it->second;
+  }
+
   auto* web_contents =
       render_frame_host
           ? content::WebContents::FromRenderFrameHost(render_frame_host)
@@ -321,8 +340,11 @@ bool ElectronPermissionManager::CheckPermissionWithDetails(
     default:
       break;
   }
-  return check_handler_.Run(web_contents, permission, requesting_origin,
-                            base::Value(std::move(details)));
+  bool granted = check_handler_.Run(web_contents, permission, requesting_origin,
+                                    base::Value(std::move(details)));
+  if (cache_key)
+    check_cache_.emplace(std::move(*cache_key), granted);
+  return granted;
 }
 
 bool ElectronPermissionManager::CheckDevicePermission(
@@ -5,7 +5,10 @@
 #ifndef ELECTRON_SHELL_BROWSER_ELECTRON_PERMISSION_MANAGER_H_
 #define ELECTRON_SHELL_BROWSER_ELECTRON_PERMISSION_MANAGER_H_
 
+#include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/containers/id_map.h"
@@ -14,6 +17,7 @@
 #include "gin/dictionary.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "url/origin.h"
 
 namespace base {
 class Value;
@@ -70,7 +74,11 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
 
   // Handler to dispatch permission requests in JS.
   void SetPermissionRequestHandler(const RequestHandler& handler);
-  void SetPermissionCheckHandler(const CheckHandler& handler);
+  // With |cache_results|, the decisions of |handler| are cached per
+  // permission and origins until the cache is cleared.
+  void SetPermissionCheckHandler(const CheckHandler& handler,
+                                 bool cache_results = false);
+  void ClearPermissionCheckCache();
   void SetDevicePermissionHandler(const DeviceCheckHandler& handler);
   void SetProtectedUSBHandler(const ProtectedUSBHandler& handler);
   void SetBluetoothPairingHandler(const BluetoothPairingHandler& handler);
@@ -158,8 +166,15 @@ class ElectronPermissionManager : public content::PermissionControllerDelegate {
       base::Value::Dict details,
       StatusesCallback callback);
 
+  // The permission, the requesting origin, then the embedding and the
+  // security origins of the details.
+  using CheckCacheKey =
+      std::tuple<blink::PermissionType, url::Origin, std::string, std::string>;
+
   RequestHandler request_handler_;
   CheckHandler check_handler_;
+  bool cache_check_results_ = false;
+  mutable std::map<CheckCacheKey, bool> check_cache_;
   DeviceCheckHandler device_permission_handler_;
   ProtectedUSBHandler protected_usb_handler_;
   BluetoothPairingHandler bluetooth_pairing_handler_;
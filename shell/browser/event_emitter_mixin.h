@@ -32,9 +32,12 @@ class EventEmitterMixin {
     v8::Local<v8::Object> wrapper;
     if (!static_cast<T*>(this)->GetWrapper(isolate).ToLocal(&wrapper))
       return false;
+    // Nothing can prevent the default of an event nobody listens to.
+    if (!internal::ShouldEmit(isolate, wrapper, name))
+      return false;
     gin::Handle<internal::Event> event = internal::Event::New(isolate);
-    gin_helper::EmitEvent(isolate, wrapper, name, event,
-                          std::forward<Args>(args)...);
+    internal::EmitEventUnchecked(isolate, wrapper, name, event,
+                                 std::forward<Args>(args)...);
     return event->GetDefaultPrevented();
   }
 
@@ -5,13 +5,19 @@
 #include "shell/browser/extensions/api/scripting/scripting_api.h"
 
 #include <algorithm>
+#include <tuple>
 
 #include "base/check.h"
 #include "base/containers/contains.h"
+#include "base/containers/lru_cache.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/json/json_writer.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "base/types/optional_util.h"
 #include "chrome/common/extensions/api/scripting.h"
 #include "content/public/browser/browser_task_traits.h"
@@ -232,6 +238,94 @@ void CheckLoadedResources(std::vector<std::string> file_names,
   std::move(callback).Run(std::move(file_sources), std::nullopt);
 }
 
+// The files injected by executeScript() and insertCSS() are kept once loaded
+// and checked, keyed by extension directory, file and localization, so that
+// injecting them again only checks that they were not modified since.
+struct CachedFileSource {
+  base::Time last_modified;
+  std::string data;
+};
+using FileSourceCacheKey = std::tuple<base::FilePath, std::string, bool>;
+using FileSourceCache = base::LRUCache<FileSourceCacheKey, CachedFileSource>;
+
+constexpr size_t kMaxCachedFileSources = 64;
+constexpr size_t kMaxCachedFileSourceSize = 1024 * 1024;
+
+FileSourceCache& GetFileSourceCache() {
+  static base::NoDestructor<FileSourceCache> cache(kMaxCachedFileSources);
+  return *cache;
+}
+
+// Returns the modification time of each resource, or a null time if it
+// can't be read. Runs on the extension file task runner.
+std::vector<base::Time> GetLastModifiedTimes(
+    const std::vector<ExtensionResource>& resources) {
+  std::vector<base::Time> times;
+  times.reserve(resources.size());
+  for (const auto& resource : resources) {
+    base::File::Info info;
+    times.push_back(base::GetFileInfo(resource.GetFilePath(), &info)
+                        ? info.last_modified
+                        : base::Time());
+  }
+  return times;
+}
+
+void CacheLoadedResources(std::vector<FileSourceCacheKey> keys,
+                          std::vector<base::Time> last_modified_times,
+                          ResourcesLoadedCallback callback,
+                          std::vector<InjectedFileSource> file_sources,
+                          std::optional<std::string> load_error) {
+  if (!load_error) {
+    FileSourceCache& cache = GetFileSourceCache();
+    for (size_t i = 0; i < file_sources.size(); ++i) {
+      const std::string& data = *file_sources[i].data;
+      if (!last_modified_times[i].is_null() &&
+          data.size() <= kMaxCachedFileSourceSize) {
+        cache.Put(keys[i], CachedFileSource{last_modified_times[i], data});
+      }
+    }
+  }
+  std::move(callback).Run(std::move(file_sources), std::move(load_error));
+}
+
+void LoadFilesIfModified(std::vector<std::string> files,
+                         scoped_refptr<const Extension> extension,
+                         std::vector<ExtensionResource> resources,
+                         bool requires_localization,
+                         ResourcesLoadedCallback callback,
+                         std::vector<base::Time> last_modified_times) {
+  std::vector<FileSourceCacheKey> keys;
+  keys.reserve(files.size());
+  for (const auto& file : files)
+    keys.emplace_back(extension->path(), file, requires_localization);
+
+  FileSourceCache& cache = GetFileSourceCache();
+  std::vector<std::unique_ptr<std::string>> file_data;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto it = cache.Get(keys[i]);
+    if (it == cache.end() || last_modified_times[i].is_null() ||
+        it->second.last_modified != last_modified_times[i]) {
+      break;
+    }
+    file_data.push_back(std::make_unique<std::string>(it->second.data));
+  }
+  if (file_data.size() == files.size()) {
+    std::move(callback).Run(
+        ConstructFileSources(std::move(file_data), std::move(files)),
+        std::nullopt);
+    return;
+  }
+
+  LoadAndLocalizeResources(
+      *extension, resources, requires_localization,
+      script_parsing::GetMaxScriptLength(),
+      base::BindOnce(
+          &CheckLoadedResources, std::move(files),
+          base::BindOnce(&CacheLoadedResources, std::move(keys),
+                         std::move(last_modified_times), std::move(callback))));
+}
+
 // Checks the specified `files` for validity, and attempts to load and localize
 // them, invoking `callback` with the result. Returns true on success; on
 // failure, populates `error`.
@@ -244,11 +338,11 @@ bool CheckAndLoadFiles(std::vector<std::string> files,
   if (!GetFileResources(files, extension, &resources, error))
     return false;
 
-  LoadAndLocalizeResources(
-      extension, resources, requires_localization,
-      script_parsing::GetMaxScriptLength(),
-      base::BindOnce(&CheckLoadedResources, std::move(files),
-                     std::move(callback)));
+  GetExtensionFileTaskRunner()->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&GetLastModifiedTimes, resources),
+      base::BindOnce(&LoadFilesIfModified, std::move(files),
+                     base::WrapRefCounted(&extension), std::move(resources),
+                     requires_localization, std::move(callback)));
   return true;
 }
 
@@ -0,0 +1,141 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/extensions/api/tabs/tab_index.h"
+
+#include "base/containers/contains.h"
+#include "base/ranges/algorithm.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "extensions/common/url_pattern.h"
+#include "extensions/common/url_pattern_set.h"
+
+namespace extensions {
+
+// Keeps the index up to date with the visible URL of a tab, which is what
+// tabs.query() matches.
+class TabIndex::Entry : public content::WebContentsObserver {
+ public:
+  Entry(TabIndex* index, content::WebContents* web_contents)
+      : content::WebContentsObserver(web_contents),
+        index_(index),
+        browser_context_(web_contents->GetBrowserContext()) {}
+
+  content::BrowserContext* browser_context() const { return browser_context_; }
+
+  // The host the tab is indexed under, once |indexed|.
+  std::string host;
+  bool indexed = false;
+
+ private:
+  void OnNavigation(content::NavigationHandle* navigation_handle) {
+    if (navigation_handle->IsInPrimaryMainFrame())
+      index_->UpdateHost(this);
+  }
+
+  // content::WebContentsObserver:
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override {
+    OnNavigation(navigation_handle);
+  }
+  void DidRedirectNavigation(
+      content::NavigationHandle* navigation_handle) override {
+    OnNavigation(navigation_handle);
+  }
+  void DidFinishNavigation(
+      content::NavigationHandle* navigation_handle) override {
+    OnNavigation(navigation_handle);
+  }
+  void WebContentsDestroyed() override { index_->Remove(this); }
+
+  const raw_ptr<TabIndex> index_;
+  const raw_ptr<content::BrowserContext> browser_context_;
+};
+
+// static
+TabIndex* TabIndex::GetInstance() {
+  static base::NoDestructor<TabIndex> instance;
+  return instance.get();
+}
+
+TabIndex::TabIndex() = default;
+
+TabIndex::~TabIndex() = default;
+
+void TabIndex::Add(content::WebContents* web_contents) {
+  if (base::Contains(entries_, web_contents))
+    return;
+  auto entry = std::make_unique<Entry>(this, web_contents);
+  Entry* raw_entry = entry.get();
+  entries_[web_contents] = std::move(entry);
+  tabs_by_context_[raw_entry->browser_context()].insert(web_contents);
+  UpdateHost(raw_entry);
+}
+
+void TabIndex::UpdateHost(Entry* entry) {
+  content::WebContents* web_contents = entry->web_contents();
+  std::string host = web_contents->GetURL().host();
+  if (entry->indexed && host == entry->host)
+    return;
+  if (entry->indexed)
+    EraseHost(entry);
+  entry->host = std::move(host);
+  entry->indexed = true;
+  tabs_by_host_[{entry->browser_context(), entry->host}].insert(web_contents);
+}
+
+void TabIndex::EraseHost(Entry* entry) {
+  auto it = tabs_by_host_.find({entry->browser_context(), entry->host});
+  if (it == tabs_by_host_.end())
+    return;
+  it->second.erase(entry->web_contents());
+  if (it->second.empty())
+    tabs_by_host_.erase(it);
+}
+
+void TabIndex::Remove(Entry* entry) {
+  content::WebContents* web_contents = entry->web_contents();
+  EraseHost(entry);
+  if (auto it = tabs_by_context_.find(entry->browser_context());
+      it != tabs_by_context_.end()) {
+    it->second.erase(web_contents);
+    if (it->second.empty())
+      tabs_by_context_.erase(it);
+  }
+  // Destroys |entry|.
+  entries_.erase(web_contents);
+}
+
+std::vector<content::WebContents*> TabIndex::GetCandidates(
+    content::BrowserContext* browser_context,
+    const URLPatternSet& url_patterns) const {
+  std::vector<content::WebContents*> result;
+
+  // Patterns with wildcards in their hosts can't be looked up by host.
+  const bool by_host =
+      !url_patterns.is_empty() &&
+      base::ranges::none_of(url_patterns, [](const URLPattern& pattern) {
+        return pattern.match_all_urls() || pattern.host().empty() ||
+               pattern.match_subdomains();
+      });
+
+  if (!by_host) {
+    auto it = tabs_by_context_.find(browser_context);
+    if (it != tabs_by_context_.end())
+      result.assign(it->second.begin(), it->second.end());
+    return result;
+  }
+
+  std::set<content::WebContents*> candidates;
+  for (const URLPattern& pattern : url_patterns) {
+    auto it = tabs_by_host_.find({browser_context, pattern.host()});
+    if (it != tabs_by_host_.end())
+      candidates.insert(it->second.begin(), it->second.end());
+  }
+  result.assign(candidates.begin(), candidates.end());
+  return result;
+}
+
+}  // namespace extensions
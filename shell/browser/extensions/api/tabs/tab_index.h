@@ -0,0 +1,70 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_EXTENSIONS_API_TABS_TAB_INDEX_H_
+#define ELECTRON_SHELL_BROWSER_EXTENSIONS_API_TABS_TAB_INDEX_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/no_destructor.h"
+
+class URLPatternSet;
+
+namespace content {
+class BrowserContext;
+class WebContents;
+}  // namespace content
+
+namespace extensions {
+
+// Indexes the WebContents that extensions can see as tabs by browser context
+// and by the host of their URL, so that tabs.query() only looks at the tabs
+// that can match instead of at all the WebContents.
+class TabIndex {
+ public:
+  static TabIndex* GetInstance();
+
+  // disable copy
+  TabIndex(const TabIndex&) = delete;
+  TabIndex& operator=(const TabIndex&) = delete;
+
+  // The tab is indexed until it's destroyed.
+  void Add(content::WebContents* web_contents);
+
+  // Returns the tabs of |browser_context| whose URL can match |url_patterns|,
+  // which still have to be matched against them. All the tabs of the browser
+  // context are returned when the patterns are empty or match any host.
+  std::vector<content::WebContents*> GetCandidates(
+      content::BrowserContext* browser_context,
+      const URLPatternSet& url_patterns) const;
+
+ private:
+  friend class base::NoDestructor<TabIndex>;
+
+  class Entry;
+
+  using TabSet = std::set<raw_ptr<content::WebContents>>;
+  using HostKey = std::pair<raw_ptr<content::BrowserContext>, std::string>;
+
+  TabIndex();
+  ~TabIndex();
+
+  void UpdateHost(Entry* entry);
+  void EraseHost(Entry* entry);
+  void Remove(Entry* entry);
+
+  std::map<raw_ptr<content::WebContents>, std::unique_ptr<Entry>> entries_;
+  std::map<raw_ptr<content::BrowserContext>, TabSet> tabs_by_context_;
+  std::map<HostKey, TabSet> tabs_by_host_;
+};
+
+}  // namespace extensions
+
+#endif  // ELECTRON_SHELL_BROWSER_EXTENSIONS_API_TABS_TAB_INDEX_H_
@@ -6,8 +6,10 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/pattern.h"
 #include "base/types/expected_macros.h"
 #include "chrome/common/url_constants.h"
@@ -23,6 +25,7 @@
 #include "extensions/common/permissions/permissions_data.h"
 #include "extensions/common/switches.h"
 #include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/extensions/api/tabs/tab_index.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/web_contents_zoom_controller.h"
 #include "shell/browser/window_list.h"
@@ -260,15 +263,18 @@ ExtensionFunction::ResponseAction TabsQueryFunction::Run() {
 
   base::Value::List result;
 
-  // Filter out webContents that don't belong to the current browser context.
-  auto* bc = browser_context();
-  auto all_contents = electron::api::WebContents::GetWebContentsList();
-  all_contents.remove_if([&bc](electron::api::WebContents* wc) {
-    return (bc != wc->web_contents()->GetBrowserContext());
-  });
+  // Only the tabs of the current browser context, and of the hosts that the
+  // url patterns can match, are looked at.
+  std::vector<electron::api::WebContents*> candidates;
+  for (content::WebContents* wc : TabIndex::GetInstance()->GetCandidates(
+           browser_context(), url_patterns)) {
+    if (auto* contents = electron::api::WebContents::From(wc))
+      candidates.push_back(contents);
+  }
+  base::ranges::sort(candidates, {}, &electron::api::WebContents::ID);
 
-  for (auto* contents : all_contents) {
-    if (!contents || !contents->web_contents())
+  for (auto* contents : candidates) {
+    if (!contents->web_contents())
       continue;
 
     auto* wc = contents->web_contents();
@@ -4,9 +4,11 @@
 
 #include "shell/browser/extensions/electron_extension_loader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/auto_reset.h"
+#include "base/barrier_callback.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
@@ -14,6 +16,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/time/time.h"
 #include "extensions/browser/extension_file_task_runner.h"
@@ -109,6 +112,30 @@ void ElectronExtensionLoader::LoadExtension(
                      weak_factory_.GetWeakPtr(), std::move(cb)));
 }
 
+void ElectronExtensionLoader::LoadExtensions(
+    const std::vector<base::FilePath>& extension_dirs,
+    int load_flags,
+    LoadExtensionsCallback cb) {
+  // The extension file task runner is a single sequence, the directories are
+  // read in parallel on the thread pool instead.
+  auto barrier = base::BarrierCallback<IndexedLoadResult>(
+      extension_dirs.size(),
+      base::BindOnce(&ElectronExtensionLoader::FinishExtensionsLoad,
+                     weak_factory_.GetWeakPtr(), std::move(cb)));
+  for (size_t i = 0; i < extension_dirs.size(); ++i) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(&LoadUnpacked, extension_dirs[i], load_flags),
+        base::BindOnce(
+            [](base::RepeatingCallback<void(IndexedLoadResult)> barrier,
+               size_t index,
+               std::pair<scoped_refptr<const Extension>, std::string> result) {
+              barrier.Run(std::make_pair(index, std::move(result)));
+            },
+            barrier, i));
+  }
+}
+
 void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
   const Extension* extension = ExtensionRegistry::Get(browser_context_)
                                    ->GetInstalledExtension(extension_id);
@@ -135,28 +162,46 @@ void ElectronExtensionLoader::FinishExtensionLoad(
     base::OnceCallback<void(const Extension*, const std::string&)> cb,
     std::pair<scoped_refptr<const Extension>, std::string> result) {
   scoped_refptr<const Extension> extension = result.first;
-  if (extension) {
-    extension_registrar_.AddExtension(extension);
+  if (extension)
+    AddLoadedExtension(extension);
 
-    // Write extension install time to ExtensionPrefs. This is required by
-    // WebRequestAPI which calls extensions::ExtensionPrefs::GetInstallTime.
-    //
-    // Implementation for writing the pref was based on
-    // PreferenceAPIBase::SetExtensionControlledPref.
-    {
-      ExtensionPrefs* extension_prefs = ExtensionPrefs::Get(browser_context_);
-      ExtensionPrefs::ScopedDictionaryUpdate update(
-          extension_prefs, extension.get()->id(),
-          extensions::pref_names::kPrefPreferences);
-
-      auto preference = update.Create();
-      const int64_t now_usec =
-          base::Time::Now().since_origin().InMicroseconds();
-      preference->SetString("install_time", base::NumberToString(now_usec));
-    }
+  std::move(cb).Run(extension.get(), result.second);
+}
+
+void ElectronExtensionLoader::FinishExtensionsLoad(
+    LoadExtensionsCallback cb,
+    std::vector<IndexedLoadResult> results) {
+  std::sort(results.begin(), results.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::vector<std::pair<const Extension*, std::string>> loaded;
+  loaded.reserve(results.size());
+  for (auto& [index, result] : results) {
+    if (result.first)
+      AddLoadedExtension(result.first);
+    loaded.emplace_back(result.first.get(), std::move(result.second));
   }
 
-  std::move(cb).Run(extension.get(), result.second);
+  std::move(cb).Run(std::move(loaded));
+}
+
+void ElectronExtensionLoader::AddLoadedExtension(
+    scoped_refptr<const Extension> extension) {
+  extension_registrar_.AddExtension(extension);
+
+  // Write extension install time to ExtensionPrefs. This is required by
+  // WebRequestAPI which calls extensions::ExtensionPrefs::GetInstallTime.
+  //
+  // Implementation for writing the pref was based on
+  // PreferenceAPIBase::SetExtensionControlledPref.
+  ExtensionPrefs* extension_prefs = ExtensionPrefs::Get(browser_context_);
+  ExtensionPrefs::ScopedDictionaryUpdate update(
+      extension_prefs, extension.get()->id(),
+      extensions::pref_names::kPrefPreferences);
+
+  auto preference = update.Create();
+  const int64_t now_usec = base::Time::Now().since_origin().InMicroseconds();
+  preference->SetString("install_time", base::NumberToString(now_usec));
 }
 
 void ElectronExtensionLoader::FinishExtensionReload(
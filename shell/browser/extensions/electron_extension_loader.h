@@ -7,6 +7,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
@@ -44,6 +45,15 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
                      base::OnceCallback<void(const Extension* extension,
                                              const std::string&)> cb);
 
+  // Loads unpacked extensions from several directories at the same time, and
+  // adds them once all of them are read. |cb| receives the result of each
+  // directory, in the order of |extension_dirs|.
+  using LoadExtensionsCallback = base::OnceCallback<void(
+      std::vector<std::pair<const Extension*, std::string>>)>;
+  void LoadExtensions(const std::vector<base::FilePath>& extension_dirs,
+                      int load_flags,
+                      LoadExtensionsCallback cb);
+
   // Starts reloading the extension. A keep-alive is maintained until the
   // reload succeeds/fails. If the extension is an app, it will be launched upon
   // reloading.
@@ -67,6 +77,16 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
       base::OnceCallback<void(const Extension*, const std::string&)> cb,
       std::pair<scoped_refptr<const Extension>, std::string> result);
 
+  // The result of LoadExtensions() for the directory at an index.
+  using IndexedLoadResult =
+      std::pair<size_t, std::pair<scoped_refptr<const Extension>, std::string>>;
+
+  void FinishExtensionsLoad(LoadExtensionsCallback cb,
+                            std::vector<IndexedLoadResult> results);
+
+  // Registers a loaded extension and records its install time.
+  void AddLoadedExtension(scoped_refptr<const Extension> extension);
+
   // ExtensionRegistrar::Delegate:
   void PreAddExtension(const Extension* extension,
                        const Extension* old_extension) override;
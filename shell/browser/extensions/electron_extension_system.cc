@@ -60,6 +60,14 @@ void ElectronExtensionSystem::LoadExtension(
   extension_loader_->LoadExtension(extension_dir, load_flags, std::move(cb));
 }
 
+void ElectronExtensionSystem::LoadExtensions(
+    const std::vector<base::FilePath>& extension_dirs,
+    int load_flags,
+    base::OnceCallback<
+        void(std::vector<std::pair<const Extension*, std::string>>)> cb) {
+  extension_loader_->LoadExtensions(extension_dirs, load_flags, std::move(cb));
+}
+
 void ElectronExtensionSystem::FinishInitialization() {
   // Inform the rest of the extensions system to start.
   ready_.Signal();
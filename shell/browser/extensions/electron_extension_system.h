@@ -7,6 +7,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/memory/raw_ptr.h"
@@ -49,6 +51,13 @@ class ElectronExtensionSystem : public ExtensionSystem {
       int load_flags,
       base::OnceCallback<void(const Extension*, const std::string&)> cb);
 
+  // Loads unpacked extensions from several directories at the same time.
+  void LoadExtensions(
+      const std::vector<base::FilePath>& extension_dirs,
+      int load_flags,
+      base::OnceCallback<void(
+          std::vector<std::pair<const Extension*, std::string>>)> cb);
+
   // Finish initialization for the shell extension system.
   void FinishInitialization();
 
@@ -4,6 +4,7 @@
 
 #include "shell/browser/extensions/electron_extension_web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "shell/browser/extensions/api/tabs/tab_index.h"
 
 namespace extensions {
 
@@ -23,6 +24,8 @@ void ElectronExtensionWebContentsObserver::CreateForWebContents(
 
   // Initialize this instance if necessary.
   FromWebContents(web_contents)->Initialize();
+
+  TabIndex::GetInstance()->Add(web_contents);
 }
 
 WEB_CONTENTS_USER_DATA_KEY_IMPL(ElectronExtensionWebContentsObserver);
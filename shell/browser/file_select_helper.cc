@@ -12,7 +12,6 @@
 
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
-#include "base/memory/ptr_util.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -33,6 +32,7 @@
 #include "net/base/filename_util.h"
 #include "net/base/mime_util.h"
 #include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/directory_enumerator.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/native_window.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -57,11 +57,12 @@ void DeleteFiles(std::vector<base::FilePath> paths) {
 
 struct FileSelectHelper::ActiveDirectoryEnumeration {
   explicit ActiveDirectoryEnumeration(const base::FilePath& path)
-      : path_(path) {}
+      : path_(path),
+        enumerator_(
+            base::MakeRefCounted<electron::DirectoryEnumerator>(path)) {}
 
-  std::unique_ptr<net::DirectoryLister> lister_;
   const base::FilePath path_;
-  std::vector<base::FilePath> results_;
+  scoped_refptr<electron::DirectoryEnumerator> enumerator_;
 };
 
 FileSelectHelper::FileSelectHelper()
@@ -117,28 +118,21 @@ void FileSelectHelper::FileSelectionCanceled(void* params) {
 void FileSelectHelper::StartNewEnumeration(const base::FilePath& path) {
   base_dir_ = path;
   auto entry = std::make_unique<ActiveDirectoryEnumeration>(path);
-  entry->lister_ = base::WrapUnique(new net::DirectoryLister(
-      path, net::DirectoryLister::NO_SORT_RECURSIVE, this));
-  entry->lister_->Start();
+  // Directory upload only cares about files, which is all the enumerator
+  // returns.
+  entry->enumerator_->Start(
+      base::BindOnce(&FileSelectHelper::OnListDone, this));
   directory_enumeration_ = std::move(entry);
 }
 
-void FileSelectHelper::OnListFile(
-    const net::DirectoryLister::DirectoryListerData& data) {
-  // Directory upload only cares about files.
-  if (data.info.IsDirectory())
-    return;
-
-  directory_enumeration_->results_.push_back(data.path);
-}
-
 void FileSelectHelper::LaunchConfirmationDialog(
     const base::FilePath& path,
     std::vector<ui::SelectedFileInfo> selected_files) {
   ConvertToFileChooserFileInfoList(std::move(selected_files));
 }
 
-void FileSelectHelper::OnListDone(int error) {
+void FileSelectHelper::OnListDone(std::vector<base::FilePath> files,
+                                  int error) {
   if (!web_contents_) {
     // Web contents was destroyed under us (probably by closing the tab). We
     // must notify |listener_| and release our reference to
@@ -156,13 +150,14 @@ void FileSelectHelper::OnListDone(int error) {
   }
 
   std::vector<ui::SelectedFileInfo> selected_files =
-      ui::FilePathListToSelectedFileInfoList(entry->results_);
+      ui::FilePathListToSelectedFileInfoList(files);
 
   if (dialog_type_ == ui::SelectFileDialog::SELECT_UPLOAD_FOLDER) {
     LaunchConfirmationDialog(entry->path_, std::move(selected_files));
   } else {
     std::vector<FileChooserFileInfoPtr> chooser_files;
-    for (const auto& file_path : entry->results_) {
+    chooser_files.reserve(files.size());
+    for (const auto& file_path : files) {
       chooser_files.push_back(FileChooserFileInfo::NewNativeFile(
           blink::mojom::NativeFileInfo::New(file_path, std::u16string())));
     }
@@ -512,6 +507,10 @@ void FileSelectHelper::RenderFrameDeleted(
 void FileSelectHelper::WebContentsDestroyed() {
   render_frame_host_ = nullptr;
   web_contents_ = nullptr;
+  // The enumeration still reports back, with what was found so far, and
+  // OnListDone() ends it.
+  if (directory_enumeration_)
+    directory_enumeration_->enumerator_->Cancel();
   CleanUp();
 }
 
@@ -17,7 +17,6 @@
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_observer.h"
 #include "content/public/browser/web_contents_observer.h"
-#include "net/base/directory_lister.h"
 #include "third_party/blink/public/mojom/choosers/file_chooser.mojom.h"
 #include "ui/shell_dialogs/select_file_dialog.h"
 
@@ -41,8 +40,7 @@ class FileSelectHelper : public base::RefCountedThreadSafe<
                              FileSelectHelper,
                              content::BrowserThread::DeleteOnUIThread>,
                          public ui::SelectFileDialog::Listener,
-                         public content::WebContentsObserver,
-                         private net::DirectoryLister::DirectoryListerDelegate {
+                         public content::WebContentsObserver {
  public:
   // disable copy
   FileSelectHelper(const FileSelectHelper&) = delete;
@@ -105,10 +103,9 @@ class FileSelectHelper : public base::RefCountedThreadSafe<
   // Kicks off a new directory enumeration.
   void StartNewEnumeration(const base::FilePath& path);
 
-  // net::DirectoryLister::DirectoryListerDelegate overrides.
-  void OnListFile(
-      const net::DirectoryLister::DirectoryListerData& data) override;
-  void OnListDone(int error) override;
+  // Called by the electron::DirectoryEnumerator with all the files under the
+  // enumeration root.
+  void OnListDone(std::vector<base::FilePath> files, int error);
 
   void LaunchConfirmationDialog(
       const base::FilePath& path,
@@ -0,0 +1,75 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/frame_buffer_pool.h"
+
+#include <utility>
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace electron {
+
+struct FrameBufferPool::Buffer {
+  explicit Buffer(size_t size)
+      : size(size), memory(std::make_unique<uint8_t[]>(size)) {}
+
+  const size_t size;
+  std::unique_ptr<uint8_t[]> memory;
+  // Only set while the buffer is in use, to keep the pool alive until the
+  // buffer has been returned to it.
+  scoped_refptr<FrameBufferPool> pool;
+};
+
+FrameBufferPool::FrameBufferPool(size_t max_buffers)
+    : max_buffers_(max_buffers) {}
+
+FrameBufferPool::~FrameBufferPool() = default;
+
+bool FrameBufferPool::AllocPixels(const SkImageInfo& info, SkBitmap* bitmap) {
+  const size_t row_bytes = info.minRowBytes();
+  const size_t size = info.computeByteSize(row_bytes);
+  if (SkImageInfo::ByteSizeOverflowed(size))
+    return false;
+
+  std::unique_ptr<Buffer> buffer;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (size != buffer_size_) {
+      buffer_size_ = size;
+      free_buffers_.clear();
+    }
+    if (!free_buffers_.empty()) {
+      buffer = std::move(free_buffers_.back());
+      free_buffers_.pop_back();
+    } else if (buffers_in_use_ < max_buffers_) {
+      buffer = std::make_unique<Buffer>(size);
+    } else {
+      return bitmap->tryAllocPixels(info, row_bytes);
+    }
+    ++buffers_in_use_;
+  }
+
+  buffer->pool = this;
+  void* pixels = buffer->memory.get();
+  return bitmap->installPixels(info, pixels, row_bytes,
+                               &FrameBufferPool::ReleasePixels,
+                               buffer.release());
+}
+
+// static
+void FrameBufferPool::ReleasePixels(void* addr, void* context) {
+  std::unique_ptr<Buffer> buffer(static_cast<Buffer*>(context));
+  scoped_refptr<FrameBufferPool> pool = std::move(buffer->pool);
+  pool->Return(std::move(buffer));
+}
+
+void FrameBufferPool::Return(std::unique_ptr<Buffer> buffer) {
+  base::AutoLock auto_lock(lock_);
+  --buffers_in_use_;
+  if (buffer->size == buffer_size_)
+    free_buffers_.push_back(std::move(buffer));
+}
+
+}  // namespace electron
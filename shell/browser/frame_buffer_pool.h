@@ -0,0 +1,58 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_FRAME_BUFFER_POOL_H_
+#define ELECTRON_SHELL_BROWSER_FRAME_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+
+class SkBitmap;
+struct SkImageInfo;
+
+namespace electron {
+
+// Recycles the pixel memory of captured frames. Bitmaps allocated from the
+// pool hand their pixels back to it once the last reference to them goes
+// away, e.g. when the NativeImage wrapping them is released or collected, so
+// that capturing frames of a steady size does not allocate.
+class FrameBufferPool : public base::RefCountedThreadSafe<FrameBufferPool> {
+ public:
+  explicit FrameBufferPool(size_t max_buffers);
+
+  // disable copy
+  FrameBufferPool(const FrameBufferPool&) = delete;
+  FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+  // Allocates the pixels of |bitmap| for |info|. Falls back to an ordinary
+  // allocation when every pooled buffer is still in use.
+  bool AllocPixels(const SkImageInfo& info, SkBitmap* bitmap);
+
+ private:
+  friend class base::RefCountedThreadSafe<FrameBufferPool>;
+
+  struct Buffer;
+
+  ~FrameBufferPool();
+
+  static void ReleasePixels(void* addr, void* context);
+  void Return(std::unique_ptr<Buffer> buffer);
+
+  const size_t max_buffers_;
+
+  base::Lock lock_;
+  // All buffers of the pool have this size, a change of size drops them.
+  size_t buffer_size_ GUARDED_BY(lock_) = 0;
+  size_t buffers_in_use_ GUARDED_BY(lock_) = 0;
+  std::vector<std::unique_ptr<Buffer>> free_buffers_ GUARDED_BY(lock_);
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_FRAME_BUFFER_POOL_H_
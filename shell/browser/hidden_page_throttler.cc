@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/hidden_page_throttler.h"
+
+#include "base/functional/bind.h"
+#include "content/public/browser/web_contents.h"
+#include "gin/arguments.h"
+#include "shell/common/gin_helper/dictionary.h"
+
+namespace electron {
+
+bool GetBackgroundThrottlingPolicyArgument(
+    gin::Arguments* args,
+    std::optional<BackgroundThrottlingPolicy>* policy) {
+  v8::Local<v8::Value> value;
+  if (args->GetNext(&value) && value->IsNull()) {
+    policy->reset();
+    return true;
+  }
+  BackgroundThrottlingPolicy result;
+  if (value.IsEmpty() || !gin::ConvertFromV8(args->isolate(), value, &result)) {
+    args->ThrowTypeError(
+        "policy must be null or have a positive interval and a budget that "
+        "is at most the interval");
+    return false;
+  }
+  *policy = result;
+  return true;
+}
+
+HiddenPageThrottler::HiddenPageThrottler(content::WebContents* web_contents)
+    : web_contents_(web_contents) {}
+
+HiddenPageThrottler::~HiddenPageThrottler() = default;
+
+void HiddenPageThrottler::Start(const BackgroundThrottlingPolicy& policy) {
+  policy_ = policy;
+  // The page gets its first slice right away, what it does when it is hidden
+  // is usually what it needs the time for.
+  WakeUp();
+  wake_up_timer_.Start(FROM_HERE, policy.interval,
+                       base::BindRepeating(&HiddenPageThrottler::WakeUp,
+                                           base::Unretained(this)));
+}
+
+void HiddenPageThrottler::Stop() {
+  wake_up_timer_.Stop();
+  freeze_timer_.Stop();
+  if (frozen_) {
+    frozen_ = false;
+    web_contents_->SetPageFrozen(false);
+  }
+}
+
+void HiddenPageThrottler::WakeUp() {
+  if (frozen_) {
+    frozen_ = false;
+    web_contents_->SetPageFrozen(false);
+  }
+  freeze_timer_.Start(
+      FROM_HERE, policy_.budget,
+      base::BindOnce(&HiddenPageThrottler::Freeze, base::Unretained(this)));
+}
+
+void HiddenPageThrottler::Freeze() {
+  // A page that started playing audio in its slice is not hidden work that
+  // can wait.
+  if (web_contents_->IsCurrentlyAudible())
+    return;
+  frozen_ = true;
+  web_contents_->SetPageFrozen(true);
+}
+
+}  // namespace electron
+
+namespace gin {
+
+// static
+bool Converter<electron::BackgroundThrottlingPolicy>::FromV8(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> val,
+    electron::BackgroundThrottlingPolicy* out) {
+  gin_helper::Dictionary dict;
+  if (!ConvertFromV8(isolate, val, &dict))
+    return false;
+  int interval = 0;
+  int budget = 0;
+  if (!dict.Get("interval", &interval) || !dict.Get("budget", &budget))
+    return false;
+  if (interval <= 0 || budget <= 0 || budget > interval)
+    return false;
+  out->interval = base::Milliseconds(interval);
+  out->budget = base::Milliseconds(budget);
+  return true;
+}
+
+}  // namespace gin
@@ -0,0 +1,84 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_HIDDEN_PAGE_THROTTLER_H_
+#define ELECTRON_SHELL_BROWSER_HIDDEN_PAGE_THROTTLER_H_
+
+#include <optional>
+
+#include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "gin/converter.h"
+
+namespace content {
+class WebContents;
+}
+
+namespace gin {
+class Arguments;
+}
+
+namespace electron {
+
+// How much a hidden page may run: |budget| of every |interval|.
+struct BackgroundThrottlingPolicy {
+  bool operator==(const BackgroundThrottlingPolicy&) const = default;
+
+  base::TimeDelta interval;
+  base::TimeDelta budget;
+};
+
+// Reads the argument of the setBackgroundThrottlingPolicy() methods, which is
+// a policy or null. Throws and returns false if it is neither.
+bool GetBackgroundThrottlingPolicyArgument(
+    gin::Arguments* args,
+    std::optional<BackgroundThrottlingPolicy>* policy);
+
+// Freezes a hidden page outside of the time slices that its policy gives it,
+// so that the timers and tasks of the page run in bursts of |budget| at the
+// start of each |interval|, instead of whenever Blink's own throttling lets
+// them.
+class HiddenPageThrottler {
+ public:
+  explicit HiddenPageThrottler(content::WebContents* web_contents);
+  ~HiddenPageThrottler();
+
+  // disable copy
+  HiddenPageThrottler(const HiddenPageThrottler&) = delete;
+  HiddenPageThrottler& operator=(const HiddenPageThrottler&) = delete;
+
+  // Called when the page is hidden.
+  void Start(const BackgroundThrottlingPolicy& policy);
+  // Called when the page is shown, unfreezes it.
+  void Stop();
+
+  bool is_running() const { return wake_up_timer_.IsRunning(); }
+  const BackgroundThrottlingPolicy& policy() const { return policy_; }
+
+ private:
+  void WakeUp();
+  void Freeze();
+
+  raw_ptr<content::WebContents> web_contents_;
+  BackgroundThrottlingPolicy policy_;
+  bool frozen_ = false;
+  base::RepeatingTimer wake_up_timer_;
+  base::OneShotTimer freeze_timer_;
+};
+
+}  // namespace electron
+
+namespace gin {
+
+template <>
+struct Converter<electron::BackgroundThrottlingPolicy> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::BackgroundThrottlingPolicy* out);
+};
+
+}  // namespace gin
+
+#endif  // ELECTRON_SHELL_BROWSER_HIDDEN_PAGE_THROTTLER_H_
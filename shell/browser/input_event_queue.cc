@@ -0,0 +1,119 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/input_event_queue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/common/gin_converters/blink_converter.h"
+#include "third_party/blink/public/common/input/web_mouse_event.h"
+
+namespace electron {
+
+namespace {
+
+static_assert(std::atomic<int32_t>::is_always_lock_free,
+              "The header is shared with JS threads");
+
+constexpr size_t kEventSize = gin::kInputEventStreamStride * sizeof(double);
+
+}  // namespace
+
+// static
+std::unique_ptr<InputEventQueue> InputEventQueue::Create(
+    std::shared_ptr<v8::BackingStore> backing_store,
+    base::TimeDelta poll_interval,
+    EventsCallback callback) {
+  if (!backing_store || !backing_store->IsShared() ||
+      backing_store->ByteLength() < kHeaderSize + kEventSize ||
+      (backing_store->ByteLength() - kHeaderSize) % kEventSize != 0 ||
+      (backing_store->ByteLength() - kHeaderSize) / kEventSize >
+          static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return nullptr;
+  }
+  return base::WrapUnique(new InputEventQueue(
+      std::move(backing_store), poll_interval, std::move(callback)));
+}
+
+InputEventQueue::InputEventQueue(
+    std::shared_ptr<v8::BackingStore> backing_store,
+    base::TimeDelta poll_interval,
+    EventsCallback callback)
+    : backing_store_(std::move(backing_store)),
+      capacity_((backing_store_->ByteLength() - kHeaderSize) / kEventSize),
+      callback_(std::move(callback)) {
+  auto* data = static_cast<uint8_t*>(backing_store_->Data());
+  auto* header = reinterpret_cast<std::atomic<int32_t>*>(data);
+  written_count_ = &header[0];
+  read_count_ = &header[1];
+  slots_ = base::span<const double>(
+      reinterpret_cast<const double*>(data + kHeaderSize),
+      capacity_ * gin::kInputEventStreamStride);
+
+  // The events written before the queue was set are sent too.
+  read_ = static_cast<uint32_t>(read_count_->load(std::memory_order_relaxed));
+
+  poll_timer_.Start(FROM_HERE, poll_interval,
+                    base::BindRepeating(&InputEventQueue::Drain,
+                                        base::Unretained(this)));
+}
+
+InputEventQueue::~InputEventQueue() = default;
+
+void InputEventQueue::Drain() {
+  const auto written =
+      static_cast<uint32_t>(written_count_->load(std::memory_order_acquire));
+  const uint32_t available = written - read_;
+  if (available == 0)
+    return;
+
+  TRACE_EVENT1("electron", "InputEventQueue::Drain", "events", available);
+
+  // The writer is not trusted to keep the counts consistent, the events it
+  // overwrote are dropped.
+  if (available > capacity_) {
+    read_ = written;
+    read_count_->store(static_cast<int32_t>(read_), std::memory_order_release);
+    return;
+  }
+
+  std::vector<double> data(available * gin::kInputEventStreamStride);
+  for (uint32_t i = 0; i < available; ++i) {
+    const size_t slot = (read_ + i) % capacity_;
+    std::memcpy(&data[i * gin::kInputEventStreamStride],
+                &slots_[slot * gin::kInputEventStreamStride], kEventSize);
+  }
+  read_ = written;
+  read_count_->store(static_cast<int32_t>(read_), std::memory_order_release);
+
+  // Stamping the events with the time they were written makes the input
+  // latency that Chromium traces, up to the frame that presents them, start
+  // when the events were written rather than when they were drained.
+  const double last_time_stamp =
+      data[data.size() - gin::kInputEventStreamStride + gin::kStreamTimeStamp];
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeTicks last_written =
+      now - (base::Time::Now() -
+             base::Time::FromMillisecondsSinceUnixEpoch(last_time_stamp));
+
+  std::vector<std::unique_ptr<blink::WebMouseEvent>> events;
+  if (!gin::DecodeInputEventStream(data, std::min(now, last_written),
+                                   &events)) {
+    TRACE_EVENT_INSTANT0("electron", "InputEventQueue::MalformedEvents",
+                         TRACE_EVENT_SCOPE_THREAD);
+    return;
+  }
+  TRACE_EVENT_INSTANT1(
+      "electron", "InputEventQueue::QueueDelay", TRACE_EVENT_SCOPE_THREAD,
+      "us", (now - events.front()->TimeStamp()).InMicroseconds());
+  callback_.Run(std::move(events));
+}
+
+}  // namespace electron
@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_INPUT_EVENT_QUEUE_H_
+#define ELECTRON_SHELL_BROWSER_INPUT_EVENT_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "v8/include/v8-array-buffer.h"
+
+namespace blink {
+class WebMouseEvent;
+}
+
+namespace electron {
+
+// Drains the mouse and wheel events that any thread holding a
+// SharedArrayBuffer writes to it, on the UI thread and without running JS, see
+// webContents.setInputQueue(). The buffer starts with an Int32Array header
+// followed by the events, each laid out like in sendInputEvents() but stamped
+// with a time since the Unix epoch:
+//   [written count][read count][reserved][reserved][event]...[event]
+// The writer publishes an event by storing the count of events it wrote after
+// writing the event to slot |count % capacity|, and must not write to the
+// slots that were not read yet.
+class InputEventQueue {
+ public:
+  using EventsCallback = base::RepeatingCallback<void(
+      std::vector<std::unique_ptr<blink::WebMouseEvent>> events)>;
+
+  static constexpr size_t kHeaderSize = 4 * sizeof(int32_t);
+
+  // Returns null if |backing_store| can't hold a queue of one event.
+  static std::unique_ptr<InputEventQueue> Create(
+      std::shared_ptr<v8::BackingStore> backing_store,
+      base::TimeDelta poll_interval,
+      EventsCallback callback);
+
+  ~InputEventQueue();
+
+  // disable copy
+  InputEventQueue(const InputEventQueue&) = delete;
+  InputEventQueue& operator=(const InputEventQueue&) = delete;
+
+ private:
+  InputEventQueue(std::shared_ptr<v8::BackingStore> backing_store,
+                  base::TimeDelta poll_interval,
+                  EventsCallback callback);
+
+  void Drain();
+
+  // Keeps the memory alive while it is read from.
+  const std::shared_ptr<v8::BackingStore> backing_store_;
+  raw_ptr<std::atomic<int32_t>> written_count_;
+  raw_ptr<std::atomic<int32_t>> read_count_;
+  base::span<const double> slots_;
+  size_t capacity_;
+
+  // The count this end owns, which is only published to the writer.
+  uint32_t read_ = 0;
+
+  EventsCallback callback_;
+  base::RepeatingTimer poll_timer_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_INPUT_EVENT_QUEUE_H_
@@ -25,9 +25,47 @@ MediaCaptureDevicesDispatcher::MediaCaptureDevicesDispatcher() {
 
 MediaCaptureDevicesDispatcher::~MediaCaptureDevicesDispatcher() = default;
 
-void MediaCaptureDevicesDispatcher::OnAudioCaptureDevicesChanged() {}
+const blink::MediaStreamDevices&
+MediaCaptureDevicesDispatcher::GetCachedAudioCaptureDevices() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!audio_devices_)
+    audio_devices_ = GetAudioCaptureDevices();
+  return *audio_devices_;
+}
+
+const blink::MediaStreamDevices&
+MediaCaptureDevicesDispatcher::GetCachedVideoCaptureDevices() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!video_devices_)
+    video_devices_ = GetVideoCaptureDevices();
+  return *video_devices_;
+}
+
+void MediaCaptureDevicesDispatcher::AddObserver(Observer* observer) {
+  observers_.AddObserver(observer);
+}
 
-void MediaCaptureDevicesDispatcher::OnVideoCaptureDevicesChanged() {}
+void MediaCaptureDevicesDispatcher::RemoveObserver(Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+void MediaCaptureDevicesDispatcher::OnAudioCaptureDevicesChanged() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // Only refreshed when it was read before, so that the devices are not
+  // listed for an app that never asks for them.
+  if (audio_devices_)
+    audio_devices_ = GetAudioCaptureDevices();
+  for (Observer& observer : observers_)
+    observer.OnMediaCaptureDevicesChanged();
+}
+
+void MediaCaptureDevicesDispatcher::OnVideoCaptureDevicesChanged() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (video_devices_)
+    video_devices_ = GetVideoCaptureDevices();
+  for (Observer& observer : observers_)
+    observer.OnMediaCaptureDevicesChanged();
+}
 
 void MediaCaptureDevicesDispatcher::OnMediaRequestStateChanged(
     int render_process_id,
@@ -5,6 +5,10 @@
 #ifndef ELECTRON_SHELL_BROWSER_MEDIA_MEDIA_CAPTURE_DEVICES_DISPATCHER_H_
 #define ELECTRON_SHELL_BROWSER_MEDIA_MEDIA_CAPTURE_DEVICES_DISPATCHER_H_
 
+#include <optional>
+
+#include "base/observer_list.h"
+#include "base/observer_list_types.h"
 #include "components/webrtc/media_stream_device_enumerator_impl.h"
 #include "content/public/browser/media_observer.h"
 #include "content/public/browser/media_stream_request.h"
@@ -19,8 +23,22 @@ class MediaCaptureDevicesDispatcher
     : public content::MediaObserver,
       public webrtc::MediaStreamDeviceEnumeratorImpl {
  public:
+  class Observer : public base::CheckedObserver {
+   public:
+    // Called when capture devices were added or removed.
+    virtual void OnMediaCaptureDevicesChanged() = 0;
+  };
+
   static MediaCaptureDevicesDispatcher* GetInstance();
 
+  // The capture devices are listed once and then kept up to date by the
+  // change notifications, instead of being listed again at each call.
+  const blink::MediaStreamDevices& GetCachedAudioCaptureDevices();
+  const blink::MediaStreamDevices& GetCachedVideoCaptureDevices();
+
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
   // Overridden from content::MediaObserver:
   void OnAudioCaptureDevicesChanged() override;
   void OnVideoCaptureDevicesChanged() override;
@@ -56,6 +74,10 @@ class MediaCaptureDevicesDispatcher
 
   MediaCaptureDevicesDispatcher();
   ~MediaCaptureDevicesDispatcher() override;
+
+  std::optional<blink::MediaStreamDevices> audio_devices_;
+  std::optional<blink::MediaStreamDevices> video_devices_;
+  base::ObserverList<Observer> observers_;
 };
 
 }  // namespace electron
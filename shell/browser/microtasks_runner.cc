@@ -5,19 +5,70 @@
 
 #include "shell/browser/microtasks_runner.h"
 
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/node_includes.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
-MicrotasksRunner::MicrotasksRunner(v8::Isolate* isolate) : isolate_(isolate) {}
+namespace {
+
+constinit thread_local MicrotasksRunner* current_runner = nullptr;
+
+}  // namespace
+
+MicrotasksRunner::MicrotasksRunner(v8::Isolate* isolate) : isolate_(isolate) {
+  current_runner = this;
+}
+
+MicrotasksRunner::~MicrotasksRunner() {
+  SetSkipIdleCheckpoints(false);
+  current_runner = nullptr;
+}
+
+// static
+MicrotasksRunner* MicrotasksRunner::GetCurrent() {
+  return current_runner;
+}
+
+void MicrotasksRunner::SetSkipIdleCheckpoints(bool skip) {
+  if (skip == skip_idle_checkpoints_)
+    return;
+  skip_idle_checkpoints_ = skip;
+  // The callback runs before every call into V8 that may run script, so it is
+  // only installed while it is needed.
+  if (skip) {
+    entered_v8_ = true;
+    isolate_->AddBeforeCallEnteredCallback(&OnBeforeCallEntered);
+  } else {
+    isolate_->RemoveBeforeCallEnteredCallback(&OnBeforeCallEntered);
+  }
+}
+
+// static
+void MicrotasksRunner::OnBeforeCallEntered(v8::Isolate* isolate) {
+  if (current_runner)
+    current_runner->entered_v8_ = true;
+}
 
 void MicrotasksRunner::WillProcessTask(const base::PendingTask& pending_task,
-                                       bool was_blocked_or_low_priority) {}
+                                       bool was_blocked_or_low_priority) {
+  monitor_.WillProcessTask(pending_task);
+}
 
 void MicrotasksRunner::DidProcessTask(const base::PendingTask& pending_task) {
+  // Both are taken, so that the next task starts from a clean state.
+  const bool settled_promise = gin_helper::MicrotasksScope::TakeWasEntered();
+  if (skip_idle_checkpoints_ && !settled_promise && !entered_v8_) {
+    monitor_.RecordSkippedMicrotaskCheckpoint();
+    monitor_.DidProcessTask(pending_task);
+    return;
+  }
+
   v8::Isolate::Scope scope(isolate_);
   // In the browser process we follow Node.js microtask policy of kExplicit
   // and let the MicrotaskRunner which is a task observer for chromium UI thread
@@ -28,11 +79,18 @@ void MicrotasksRunner::DidProcessTask(const base::PendingTask& pending_task) {
   // contention for performing checkpoint between Node.js and chromium, ending
   // up Node.js delaying its callbacks. To fix this, now we always lets Node.js
   // handle the checkpoint in the browser process.
+  const base::TimeTicks checkpoint_start = base::TimeTicks::Now();
   {
+    TRACE_EVENT0("electron", "MicrotasksRunner::DidProcessTask");
     v8::HandleScope handle_scope(isolate_);
     node::CallbackScope microtasks_scope(isolate_, v8::Object::New(isolate_),
                                          {0, 0});
   }
+  // The checkpoint itself called into V8.
+  entered_v8_ = false;
+  monitor_.RecordMicrotaskCheckpoint(base::TimeTicks::Now() -
+                                     checkpoint_start);
+  monitor_.DidProcessTask(pending_task);
 }
 
 }  // namespace electron
@@ -7,6 +7,7 @@
 
 #include "base/memory/raw_ptr.h"
 #include "base/task/task_observer.h"
+#include "shell/common/event_loop_monitor.h"
 
 namespace v8 {
 class Isolate;
@@ -23,6 +24,15 @@ namespace electron {
 class MicrotasksRunner : public base::TaskObserver {
  public:
   explicit MicrotasksRunner(v8::Isolate* isolate);
+  ~MicrotasksRunner() override;
+
+  // Returns the runner of the current thread, or nullptr.
+  static MicrotasksRunner* GetCurrent();
+
+  // When enabled, the checkpoint is skipped after the tasks that neither
+  // called into V8 nor settled a promise, as they cannot have queued any
+  // microtask. Skipped checkpoints are counted in app.getEventLoopStats().
+  void SetSkipIdleCheckpoints(bool skip);
 
   // base::TaskObserver
   void WillProcessTask(const base::PendingTask& pending_task,
@@ -30,7 +40,16 @@ class MicrotasksRunner : public base::TaskObserver {
   void DidProcessTask(const base::PendingTask& pending_task) override;
 
  private:
+  static void OnBeforeCallEntered(v8::Isolate* isolate);
+
   raw_ptr<v8::Isolate> isolate_;
+
+  bool skip_idle_checkpoints_ = false;
+  // Whether V8 was called into since the last checkpoint.
+  bool entered_v8_ = false;
+
+  // Measures the tasks observed by this runner, see app.getEventLoopStats().
+  EventLoopMonitor monitor_;
 };
 
 }  // namespace electron
@@ -6,10 +6,12 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/containers/contains.h"
 #include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
 #include "content/public/browser/web_contents_user_data.h"
@@ -90,6 +92,14 @@ gfx::Size GetExpandedWindowSize(const NativeWindow* window, gfx::Size size) {
 }
 #endif
 
+// The depth of the nested batch updates in progress, and their windows.
+int g_batch_update_depth = 0;
+
+std::vector<base::WeakPtr<NativeWindow>>& GetBatchedWindows() {
+  static base::NoDestructor<std::vector<base::WeakPtr<NativeWindow>>> windows;
+  return *windows;
+}
+
 }  // namespace
 
 const char kElectronNativeWindowKey[] = "__ELECTRON_NATIVE_WINDOW__";
@@ -102,6 +112,7 @@ NativeWindow::NativeWindow(const gin_helper::Dictionary& options,
   options.Get(options::kFrame, &has_frame_);
   options.Get(options::kTransparent, &transparent_);
   options.Get(options::kEnableLargerThanScreen, &enable_larger_than_screen_);
+  options.Get(options::kDeferContentResize, &defer_content_resize_);
   options.Get(options::kTitleBarStyle, &title_bar_style_);
 #if BUILDFLAG(IS_WIN)
   options.Get(options::kBackgroundMaterial, &background_material_);
@@ -293,6 +304,46 @@ bool NativeWindow::IsClosed() const {
   return is_closed_;
 }
 
+// static
+void NativeWindow::BeginBatchUpdate(const std::vector<NativeWindow*>& windows) {
+  ++g_batch_update_depth;
+  for (NativeWindow* window : windows) {
+    if (window->in_batch_update_)
+      continue;
+    window->in_batch_update_ = true;
+    GetBatchedWindows().push_back(window->GetWeakPtr());
+  }
+}
+
+// static
+void NativeWindow::EndBatchUpdate() {
+  DCHECK_GT(g_batch_update_depth, 0);
+  if (--g_batch_update_depth > 0)
+    return;
+
+  std::vector<base::WeakPtr<NativeWindow>> windows;
+  windows.swap(GetBatchedWindows());
+  BatchedBounds changes;
+  for (const auto& window : windows) {
+    if (!window)
+      continue;
+    window->in_batch_update_ = false;
+    std::optional<gfx::Rect> bounds =
+        std::exchange(window->batched_bounds_, std::nullopt);
+    if (bounds && !window->IsClosed())
+      changes.emplace_back(window, *bounds);
+  }
+  if (!changes.empty())
+    CommitBatchedBounds(changes);
+}
+
+bool NativeWindow::DeferBoundsInBatch(const gfx::Rect& bounds) {
+  if (!in_batch_update_)
+    return false;
+  batched_bounds_ = bounds;
+  return true;
+}
+
 void NativeWindow::SetSize(const gfx::Size& size, bool animate) {
   SetBounds(gfx::Rect(GetPosition(), size), animate);
 }
@@ -505,6 +556,12 @@ void NativeWindow::SetTouchBar(
 
 void NativeWindow::RefreshTouchBarItem(const std::string& item_id) {}
 
+void NativeWindow::SetTouchBarItemLabel(const std::string& item_id,
+                                        const std::string& label) {}
+
+void NativeWindow::SetTouchBarItemValue(const std::string& item_id,
+                                        int value) {}
+
 void NativeWindow::SetEscapeTouchBarItem(
     gin_helper::PersistentDictionary item) {}
 
@@ -805,6 +862,8 @@ void NativeWindow::UpdateBackgroundThrottlingState() {
   bool enable_background_throttling = true;
   for (const auto* background_throttling_source :
        background_throttling_sources_) {
+    if (background_throttling_source->IsFrozen())
+      continue;
     if (!background_throttling_source->GetBackgroundThrottling()) {
       enable_background_throttling = false;
       break;
@@ -10,6 +10,7 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
@@ -244,6 +245,9 @@ class NativeWindow : public base::SupportsUserData,
   // Touchbar API
   virtual void SetTouchBar(std::vector<gin_helper::PersistentDictionary> items);
   virtual void RefreshTouchBarItem(const std::string& item_id);
+  virtual void SetTouchBarItemLabel(const std::string& item_id,
+                                    const std::string& label);
+  virtual void SetTouchBarItemValue(const std::string& item_id, int value);
   virtual void SetEscapeTouchBarItem(gin_helper::PersistentDictionary item);
 
   // Native Tab API
@@ -286,6 +290,12 @@ class NativeWindow : public base::SupportsUserData,
     return weak_factory_.GetWeakPtr();
   }
 
+  // Defers the bounds changes of |windows| until the matching
+  // EndBatchUpdate(), which applies them in a single native pass. Used by
+  // BaseWindow.batchUpdate(), batches can be nested.
+  static void BeginBatchUpdate(const std::vector<NativeWindow*>& windows);
+  static void EndBatchUpdate();
+
   virtual std::optional<gfx::Rect> GetWindowControlsOverlayRect();
   virtual void SetWindowControlsOverlayRect(const gfx::Rect& overlay_rect);
 
@@ -385,6 +395,7 @@ class NativeWindow : public base::SupportsUserData,
   bool has_client_frame() const { return has_client_frame_; }
   bool transparent() const { return transparent_; }
   bool enable_larger_than_screen() const { return enable_larger_than_screen_; }
+  bool defer_content_resize() const { return defer_content_resize_; }
 
   NativeWindow* parent() const { return parent_; }
   bool is_modal() const { return is_modal_; }
@@ -408,8 +419,9 @@ class NativeWindow : public base::SupportsUserData,
   // background throttling state.
   void RemoveBackgroundThrottlingSource(BackgroundThrottlingSource* source);
   // Updates `ui::Compositor` background throttling state based on
-  // |background_throttling_sources_|. If at least one of the sources disables
-  // throttling, then throttling in the `ui::Compositor` will be disabled.
+  // |background_throttling_sources_|. If at least one of the sources that are
+  // not frozen disables throttling, then throttling in the `ui::Compositor`
+  // will be disabled.
   void UpdateBackgroundThrottlingState();
 
  protected:
@@ -424,6 +436,13 @@ class NativeWindow : public base::SupportsUserData,
 
   void set_content_view(views::View* view) { content_view_ = view; }
 
+  // Returns true when |bounds| has been recorded to be set by
+  // EndBatchUpdate(), instead of being set now.
+  bool DeferBoundsInBatch(const gfx::Rect& bounds);
+  const std::optional<gfx::Rect>& batched_bounds() const {
+    return batched_bounds_;
+  }
+
   // The boolean parsing of the "titleBarOverlay" option
   bool titlebar_overlay_ = false;
 
@@ -454,6 +473,17 @@ class NativeWindow : public base::SupportsUserData,
 
   static int32_t next_id_;
 
+  using BatchedBounds =
+      std::vector<std::pair<base::WeakPtr<NativeWindow>, gfx::Rect>>;
+
+  // Sets the bounds recorded during a batch update, implemented per platform.
+  static void CommitBatchedBounds(const BatchedBounds& changes);
+
+  // Whether the window is part of a batch update.
+  bool in_batch_update_ = false;
+  // The last bounds set during the batch update.
+  std::optional<gfx::Rect> batched_bounds_;
+
   // The content view, weak ref.
   raw_ptr<views::View> content_view_ = nullptr;
 
@@ -471,6 +501,9 @@ class NativeWindow : public base::SupportsUserData,
   // Whether window can be resized larger than screen.
   bool enable_larger_than_screen_ = false;
 
+  // Whether the web contents are resized only when a live resize ends.
+  bool defer_content_resize_ = false;
+
   // The windows has been closed.
   bool is_closed_ = false;
 
@@ -135,6 +135,9 @@ class NativeWindowMac : public NativeWindow,
   void SetTouchBar(
       std::vector<gin_helper::PersistentDictionary> items) override;
   void RefreshTouchBarItem(const std::string& item_id) override;
+  void SetTouchBarItemLabel(const std::string& item_id,
+                            const std::string& label) override;
+  void SetTouchBarItemValue(const std::string& item_id, int value) override;
   void SetEscapeTouchBarItem(gin_helper::PersistentDictionary item) override;
   void SelectPreviousTab() override;
   void SelectNextTab() override;
@@ -5,6 +5,7 @@
 #include "shell/browser/native_window_mac.h"
 
 #include <AvailabilityMacros.h>
+#include <QuartzCore/QuartzCore.h>
 #include <objc/objc-runtime.h>
 
 #include <algorithm>
@@ -715,6 +716,9 @@ bool NativeWindowMac::IsFullscreen() const {
 }
 
 void NativeWindowMac::SetBounds(const gfx::Rect& bounds, bool animate) {
+  if (DeferBoundsInBatch(bounds))
+    return;
+
   // Do nothing if in fullscreen mode.
   if (IsFullscreen())
     return;
@@ -737,6 +741,9 @@ void NativeWindowMac::SetBounds(const gfx::Rect& bounds, bool animate) {
 }
 
 gfx::Rect NativeWindowMac::GetBounds() const {
+  if (batched_bounds())
+    return *batched_bounds();
+
   NSRect frame = [window_ frame];
   gfx::Rect bounds(frame.origin.x, 0, NSWidth(frame), NSHeight(frame));
   NSScreen* screen = [[NSScreen screens] firstObject];
@@ -1546,6 +1553,22 @@ void NativeWindowMac::RefreshTouchBarItem(const std::string& item_id) {
     [touch_bar_ refreshTouchBarItem:[window_ touchBar] id:item_id];
 }
 
+void NativeWindowMac::SetTouchBarItemLabel(const std::string& item_id,
+                                           const std::string& label) {
+  if (touch_bar_ && [window_ touchBar])
+    [touch_bar_ setLabel:label
+           forItemWithID:item_id
+              inTouchBar:[window_ touchBar]];
+}
+
+void NativeWindowMac::SetTouchBarItemValue(const std::string& item_id,
+                                           int value) {
+  if (touch_bar_ && [window_ touchBar])
+    [touch_bar_ setSliderValue:value
+                 forItemWithID:item_id
+                    inTouchBar:[window_ touchBar]];
+}
+
 void NativeWindowMac::SetEscapeTouchBarItem(
     gin_helper::PersistentDictionary item) {
   if (touch_bar_ && [window_ touchBar])
@@ -1869,4 +1892,17 @@ NativeWindow* NativeWindow::Create(const gin_helper::Dictionary& options,
   return new NativeWindowMac(options, parent);
 }
 
+// static
+void NativeWindow::CommitBatchedBounds(const BatchedBounds& changes) {
+  // Commits the new frames in a single transaction, so that the window server
+  // shows them all at once.
+  [CATransaction begin];
+  [CATransaction setDisableActions:YES];
+  for (const auto& [window, bounds] : changes) {
+    if (window)
+      window->SetBounds(bounds);
+  }
+  [CATransaction commit];
+}
+
 }  // namespace electron
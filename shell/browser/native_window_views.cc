@@ -769,6 +769,9 @@ bool NativeWindowViews::IsFullscreen() const {
 }
 
 void NativeWindowViews::SetBounds(const gfx::Rect& bounds, bool animate) {
+  if (DeferBoundsInBatch(bounds))
+    return;
+
 #if BUILDFLAG(IS_WIN)
   if (is_moving_ || is_resizing_) {
     pending_bounds_change_ = bounds;
@@ -788,6 +791,9 @@ void NativeWindowViews::SetBounds(const gfx::Rect& bounds, bool animate) {
 }
 
 gfx::Rect NativeWindowViews::GetBounds() const {
+  if (batched_bounds())
+    return *batched_bounds();
+
 #if BUILDFLAG(IS_WIN)
   if (IsMinimized())
     return widget()->GetRestoredBounds();
@@ -1762,10 +1768,59 @@ void NativeWindowViews::MoveBehindTaskBarIfNeeded() {
   // TODO(julien.isorce): Implement X11 case.
 }
 
+#if BUILDFLAG(IS_WIN)
+HDWP NativeWindowViews::DeferBounds(HDWP hdwp, const gfx::Rect& bounds) {
+  // Views keeps track of the restored bounds of these windows, and of the
+  // bounds set while moving, which ::DeferWindowPos() would bypass.
+  if (is_moving_ || is_resizing_ || IsMaximized() || IsMinimized() ||
+      IsFullscreen()) {
+    SetBounds(bounds, false);
+    return hdwp;
+  }
+
+  if (!resizable_) {
+    SetMaximumSize(bounds.size());
+    SetMinimumSize(bounds.size());
+  }
+
+  HWND hwnd = GetAcceleratedWidget();
+  const gfx::Rect pixels =
+      display::win::ScreenWin::DIPToScreenRect(hwnd, bounds);
+  return ::DeferWindowPos(hdwp, hwnd, nullptr, pixels.x(), pixels.y(),
+                          pixels.width(), pixels.height(),
+                          SWP_NOACTIVATE | SWP_NOOWNERZORDER | SWP_NOZORDER);
+}
+#endif
+
 // static
 NativeWindow* NativeWindow::Create(const gin_helper::Dictionary& options,
                                    NativeWindow* parent) {
   return new NativeWindowViews(options, parent);
 }
 
+// static
+void NativeWindow::CommitBatchedBounds(const BatchedBounds& changes) {
+#if BUILDFLAG(IS_WIN)
+  // Moves all the windows in one pass, so that they are repainted together
+  // instead of one after the other.
+  HDWP hdwp = ::BeginDeferWindowPos(static_cast<int>(changes.size()));
+  for (const auto& [window, bounds] : changes) {
+    if (hdwp && window) {
+      hdwp = static_cast<NativeWindowViews*>(window.get())
+                 ->DeferBounds(hdwp, bounds);
+    }
+  }
+  // The whole pass is discarded when one of the windows failed to be added.
+  if (hdwp && ::EndDeferWindowPos(hdwp))
+    return;
+#endif
+
+  // The X11 and Wayland requests are buffered until the end of the task, so
+  // the windows are configured in a single round trip.
+  for (const auto& [window, bounds] : changes) {
+    if (window)
+      window->SetBounds(bounds);
+  }
+}
+
 }  // namespace electron
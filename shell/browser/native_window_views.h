@@ -161,6 +161,9 @@ class NativeWindowViews : public NativeWindow,
                     LPARAM l_param,
                     LRESULT* result);
   void SetIcon(HICON small_icon, HICON app_icon);
+  // Adds the bounds change to |hdwp|, or sets the bounds now when they can't
+  // be deferred. Returns the updated handle, see ::DeferWindowPos().
+  HDWP DeferBounds(HDWP hdwp, const gfx::Rect& bounds);
 #elif BUILDFLAG(IS_LINUX)
   void SetIcon(const gfx::ImageSkia& icon);
 #endif
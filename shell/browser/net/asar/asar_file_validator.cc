@@ -13,13 +13,31 @@
 #include "base/notreached.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
 #include "crypto/sha2.h"
 
 namespace asar {
 
+namespace {
+
+std::string HashBlock(base::span<const uint8_t> data) {
+  uint8_t hash[crypto::kSHA256Length];
+  auto hasher = crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  hasher->Update(data.data(), data.size());
+  hasher->Finish(hash, sizeof(hash));
+  return base::ToLowerASCII(base::HexEncode(hash, sizeof(hash)));
+}
+
+}  // namespace
+
 AsarFileValidator::AsarFileValidator(IntegrityPayload integrity,
-                                     base::File file)
-    : file_(std::move(file)), integrity_(std::move(integrity)) {
+                                     base::File file,
+                                     std::shared_ptr<Archive> archive,
+                                     uint64_t file_offset)
+    : file_(std::move(file)),
+      integrity_(std::move(integrity)),
+      archive_(std::move(archive)),
+      file_offset_(file_offset) {
   current_block_ = 0;
   max_block_ = integrity_.blocks.size() - 1;
 }
@@ -41,17 +59,22 @@ void AsarFileValidator::OnRead(base::span<char> buffer,
           << "Unexpected number of blocks while validating ASAR file stream";
     }
 
-    // Create a hash if we don't have one yet
-    if (!current_hash_) {
+    // Create a hash if we don't have one yet, unless the block has already
+    // been verified by an earlier read, in which case we only count its bytes.
+    if (!current_hash_ && !skipping_block_) {
       current_hash_byte_count_ = 0;
-      switch (integrity_.algorithm) {
-        case HashAlgorithm::kSHA256:
-          current_hash_ =
-              crypto::SecureHash::Create(crypto::SecureHash::SHA256);
-          break;
-        case HashAlgorithm::kNone:
-          CHECK(false);
-          break;
+      if (archive_->IsBlockVerified(file_offset_, current_block_)) {
+        skipping_block_ = true;
+      } else {
+        switch (integrity_.algorithm) {
+          case HashAlgorithm::kSHA256:
+            current_hash_ =
+                crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+            break;
+          case HashAlgorithm::kNone:
+            CHECK(false);
+            break;
+        }
       }
     }
 
@@ -61,7 +84,8 @@ void AsarFileValidator::OnRead(base::span<char> buffer,
     int bytes_to_hash = std::min(block_size - current_hash_byte_count_,
                                  buffer_size - bytes_added);
     DCHECK_GT(bytes_to_hash, 0);
-    current_hash_->Update(buffer.data() + bytes_added, bytes_to_hash);
+    if (!skipping_block_)
+      current_hash_->Update(buffer.data() + bytes_added, bytes_to_hash);
     bytes_added += bytes_to_hash;
     current_hash_byte_count_ += bytes_to_hash;
     total_hash_byte_count_ += bytes_to_hash;
@@ -80,6 +104,18 @@ bool AsarFileValidator::FinishBlock() {
     }
   }
 
+  if (skipping_block_ ||
+      archive_->IsBlockVerified(file_offset_, current_block_)) {
+    skipping_block_ = false;
+    current_hash_.reset();
+    current_hash_byte_count_ = 0;
+    current_block_++;
+    return true;
+  }
+
+  TRACE_EVENT1("electron", "AsarFileValidator::FinishBlock", "block",
+               current_block_);
+
   if (!current_hash_) {
     // This happens when we fail to read the resource. Compute empty content's
     // hash in this case.
@@ -120,6 +156,7 @@ bool AsarFileValidator::FinishBlock() {
     return false;
   }
 
+  archive_->MarkBlockVerified(file_offset_, current_block_);
   current_block_++;
 
   return true;
@@ -146,4 +183,40 @@ void AsarFileValidator::SetCurrentBlock(int current_block) {
   current_block_ = current_block;
 }
 
+// static
+void AsarFileValidator::VerifyBlocksAhead(std::shared_ptr<Archive> archive,
+                                          base::File file,
+                                          uint64_t file_offset,
+                                          uint64_t file_size,
+                                          IntegrityPayload integrity,
+                                          int first_block) {
+  TRACE_EVENT1("electron", "AsarFileValidator::VerifyBlocksAhead",
+               "first_block", first_block);
+  if (integrity.algorithm != HashAlgorithm::kSHA256 ||
+      integrity.block_size == 0) {
+    return;
+  }
+
+  std::vector<uint8_t> buffer;
+  for (size_t block = first_block; block < integrity.blocks.size(); ++block) {
+    if (archive->IsBlockVerified(file_offset, block))
+      continue;
+
+    const uint64_t block_start = block * integrity.block_size;
+    if (block_start > file_size)
+      break;
+    buffer.resize(std::min<uint64_t>(integrity.block_size,
+                                     file_size - block_start));
+    // The stream will validate the block itself if this read fails.
+    if (!file.ReadAndCheck(file_offset + block_start, buffer))
+      return;
+
+    if (HashBlock(buffer) != integrity.blocks[block]) {
+      LOG(FATAL) << "Failed to validate block while verifying ASAR file: "
+                 << block;
+    }
+    archive->MarkBlockVerified(file_offset, block);
+  }
+}
+
 }  // namespace asar
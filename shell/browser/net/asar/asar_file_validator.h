@@ -18,7 +18,12 @@ namespace asar {
 
 class AsarFileValidator : public mojo::FilteredDataSource::Filter {
  public:
-  AsarFileValidator(IntegrityPayload integrity, base::File file);
+  // |archive| records the blocks that have been validated so that later
+  // streams of the file at |file_offset| can skip rehashing them.
+  AsarFileValidator(IntegrityPayload integrity,
+                    base::File file,
+                    std::shared_ptr<Archive> archive,
+                    uint64_t file_offset);
   ~AsarFileValidator() override;
 
   // disable copy
@@ -33,12 +38,25 @@ class AsarFileValidator : public mojo::FilteredDataSource::Filter {
   void SetRange(uint64_t read_start, uint64_t extra_read, uint64_t read_max);
   void SetCurrentBlock(int current_block);
 
+  // Validates the blocks of a packed file starting at |first_block| ahead of
+  // the streaming consumer, recording them as verified in |archive|. Meant to
+  // be posted to the thread pool so that the stream finds most blocks already
+  // verified. Blocks that are already verified are skipped.
+  static void VerifyBlocksAhead(std::shared_ptr<Archive> archive,
+                                base::File file,
+                                uint64_t file_offset,
+                                uint64_t file_size,
+                                IntegrityPayload integrity,
+                                int first_block);
+
  protected:
   bool FinishBlock();
 
  private:
   base::File file_;
   IntegrityPayload integrity_;
+  std::shared_ptr<Archive> archive_;
+  uint64_t file_offset_;
 
   // The offset in the file_ that the underlying file reader is starting at
   uint64_t read_start_ = 0;
@@ -56,6 +74,8 @@ class AsarFileValidator : public mojo::FilteredDataSource::Filter {
   uint64_t current_hash_byte_count_ = 0;
   uint64_t total_hash_byte_count_ = 0;
   std::unique_ptr<crypto::SecureHash> current_hash_;
+  // Whether the current block was already verified and is only being counted.
+  bool skipping_block_ = false;
 };
 
 }  // namespace asar
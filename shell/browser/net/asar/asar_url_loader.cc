@@ -6,12 +6,17 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/environment.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/file_url_loader.h"
 #include "electron/fuses.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -25,6 +30,7 @@
 #include "net/http/http_util.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "shell/browser/net/asar/asar_file_validator.h"
+#include "shell/browser/net/data_pipe_util.h"
 #include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
 
@@ -49,12 +55,178 @@ net::Error ConvertMojoResultToNetError(MojoResult result) {
   }
 }
 
-constexpr size_t kDefaultFileUrlPipeSize = 65536;
-
 // Because this makes things simpler.
-static_assert(kDefaultFileUrlPipeSize >= net::kMaxBytesToSniff,
-              "Default file data pipe size must be at least as large as a MIME-"
-              "type sniffing buffer.");
+static_assert(electron::kMinDataPipeCapacity >= net::kMaxBytesToSniff,
+              "File data pipes must be at least as large as a MIME-type "
+              "sniffing buffer.");
+
+// Size of the reads used to pull files into the page cache ahead of the
+// stream.
+constexpr uint64_t kReadAheadChunkSize = 1024 * 1024;
+
+// Returns the capacity of the data pipe to send |total_bytes| through. The
+// maximum can be set with the ELECTRON_ASAR_PIPE_SIZE environment variable.
+uint32_t GetFilePipeCapacity(uint64_t total_bytes) {
+  static const std::optional<uint32_t> max_capacity =
+      []() -> std::optional<uint32_t> {
+    std::string value;
+    unsigned size = 0;
+    auto env = base::Environment::Create();
+    if (!env->GetVar("ELECTRON_ASAR_PIPE_SIZE", &value) ||
+        !base::StringToUint(value, &size)) {
+      return std::nullopt;
+    }
+    return std::max(static_cast<uint32_t>(size), electron::kMinDataPipeCapacity);
+  }();
+  if (!max_capacity)
+    return electron::GetDataPipeCapacity(
+        base::saturated_cast<int64_t>(total_bytes));
+  return static_cast<uint32_t>(std::clamp<uint64_t>(
+      total_bytes, electron::kMinDataPipeCapacity, *max_capacity));
+}
+
+// Reads |size| bytes of |file| from |offset| and drops them, so that the disk
+// reads overlap with the consumer draining the data pipe and the reads made
+// for the response itself are served from the page cache.
+void ReadAhead(base::File file, uint64_t offset, uint64_t size) {
+  TRACE_EVENT1("electron", "AsarURLLoader::ReadAhead", "size", size);
+  std::vector<uint8_t> buffer(std::min(size, kReadAheadChunkSize));
+  while (size > 0) {
+    auto chunk = base::make_span(buffer).first(
+        static_cast<size_t>(std::min<uint64_t>(size, buffer.size())));
+    if (!file.ReadAndCheck(offset, chunk))
+      return;
+    offset += chunk.size();
+    size -= chunk.size();
+  }
+}
+
+// Warms the resources listed for |document| in the prefetch manifest of
+// |archive|, so the subresource requests made by the document find them in
+// the page cache and, for files covered by integrity checks, already
+// validated.
+void PrefetchResources(std::shared_ptr<Archive> archive,
+                       base::FilePath document) {
+  TRACE_EVENT0("electron", "AsarURLLoader::PrefetchResources");
+  std::vector<base::FilePath> resources = archive->TakePrefetchList(document);
+  if (resources.empty())
+    return;
+
+  base::File file(archive->path(),
+                  base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return;
+
+  for (const base::FilePath& resource : resources) {
+    // Unpacked files are served like regular files and are left alone.
+    Archive::FileInfo info;
+    if (!archive->GetFileInfo(resource, &info) || info.unpacked)
+      continue;
+
+    if (info.compression) {
+      // The blocks are validated once they are decompressed, only their
+      // compressed bytes are read ahead.
+      ReadAhead(file.Duplicate(), info.offset,
+                info.compression->block_offsets.back());
+    } else if (info.integrity.has_value()) {
+      AsarFileValidator::VerifyBlocksAhead(archive, file.Duplicate(),
+                                           info.offset, info.size,
+                                           std::move(info.integrity.value()),
+                                           0);
+    } else {
+      ReadAhead(file.Duplicate(), info.offset, info.size);
+    }
+  }
+}
+
+// Serves a range of the contents of a compressed file, decompressing the
+// blocks it spans as the data pipe drains.
+class CompressedFileDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  CompressedFileDataSource(std::shared_ptr<Archive> archive,
+                           Archive::FileInfo info,
+                           uint64_t first_byte,
+                           uint64_t length)
+      : archive_(std::move(archive)),
+        info_(std::move(info)),
+        first_byte_(first_byte),
+        length_(length) {}
+
+  // disable copy
+  CompressedFileDataSource(const CompressedFileDataSource&) = delete;
+  CompressedFileDataSource& operator=(const CompressedFileDataSource&) =
+      delete;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return length_; }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    if (offset >= length_)
+      return result;
+    const uint64_t size = std::min<uint64_t>(buffer.size(), length_ - offset);
+    auto chunk = buffer.first(static_cast<size_t>(size));
+    if (!archive_->ReadCompressed(info_, first_byte_ + offset,
+                                  base::as_writable_bytes(chunk))) {
+      result.result = MOJO_RESULT_UNKNOWN;
+      return result;
+    }
+    result.bytes_read = chunk.size();
+    return result;
+  }
+
+ private:
+  const std::shared_ptr<Archive> archive_;
+  const Archive::FileInfo info_;
+  const uint64_t first_byte_;
+  const uint64_t length_;
+};
+
+// Reads the single range of a Range header of |request|, if any, into
+// |byte_range|. Returns false when the range can't be satisfied.
+bool GetRequestedRange(const network::ResourceRequest& request,
+                       uint64_t size,
+                       net::HttpByteRange* byte_range) {
+  std::string range_header;
+  if (!request.headers.GetHeader(net::HttpRequestHeaders::kRange,
+                                 &range_header)) {
+    return true;
+  }
+
+  // Handle a simple Range header for a single range.
+  std::vector<net::HttpByteRange> ranges;
+  if (!net::HttpUtil::ParseRangeHeader(range_header, &ranges) ||
+      ranges.size() != 1) {
+    return false;
+  }
+  *byte_range = ranges[0];
+  return byte_range->ComputeBounds(size);
+}
+
+// Sets the MIME type of the response for |path|, sniffed from |head_bytes|
+// when the extension does not tell.
+void SetMimeType(const GURL& url,
+                 const base::FilePath& path,
+                 base::StringPiece head_bytes,
+                 network::mojom::URLResponseHead* head) {
+  if (!net::GetMimeTypeFromFile(path, &head->mime_type)) {
+    std::string new_type;
+    net::SniffMimeType(head_bytes, url, head->mime_type,
+                       net::ForceSniffFileUrlsForHtml::kDisabled, &new_type);
+    head->mime_type.assign(new_type);
+    head->did_mime_sniff = true;
+  }
+  if (head->headers) {
+    head->headers->AddHeader(net::HttpRequestHeaders::kContentType,
+                             head->mime_type.c_str());
+  }
+}
+
+bool IsDocumentRequest(const network::ResourceRequest& request) {
+  return request.destination ==
+             network::mojom::RequestDestination::kDocument ||
+         request.destination == network::mojom::RequestDestination::kIframe;
+}
 
 // Modified from the |FileURLLoader| in |file_url_loader_factory.cc|, to serve
 // asar files instead of normal files.
@@ -135,6 +307,20 @@ class AsarURLLoader : public network::mojom::URLLoader {
     }
     bool is_verifying_file = info.integrity.has_value();
 
+    // Start warming the resources the document is going to load while the
+    // document itself is being sent.
+    if (IsDocumentRequest(request)) {
+      base::ThreadPool::PostTask(
+          FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+          base::BindOnce(&PrefetchResources, archive, relative_path));
+    }
+
+    if (info.compression) {
+      StartCompressed(request, path, std::move(archive), std::move(info),
+                      std::move(head));
+      return;
+    }
+
     // For unpacked path, read like normal file.
     base::FilePath real_path;
     if (info.unpacked) {
@@ -142,14 +328,6 @@ class AsarURLLoader : public network::mojom::URLLoader {
       info.offset = 0;
     }
 
-    mojo::ScopedDataPipeProducerHandle producer_handle;
-    mojo::ScopedDataPipeConsumerHandle consumer_handle;
-    if (mojo::CreateDataPipe(kDefaultFileUrlPipeSize, producer_handle,
-                             consumer_handle) != MOJO_RESULT_OK) {
-      OnClientComplete(net::ERR_FAILED);
-      return;
-    }
-
     // Note that while the |Archive| already opens a |base::File|, we still need
     // to create a new |base::File| here, as it might be accessed by multiple
     // requests at the same time.
@@ -161,10 +339,14 @@ class AsarURLLoader : public network::mojom::URLLoader {
     mojo::FileDataSource* file_data_source_raw = file_data_source.get();
     AsarFileValidator* file_validator_raw = nullptr;
     uint32_t block_size = 0;
+    base::File read_ahead_file = file.Duplicate();
+    IntegrityPayload verify_ahead_integrity;
     if (info.integrity.has_value()) {
       block_size = info.integrity.value().block_size;
+      verify_ahead_integrity = info.integrity.value();
       auto asar_validator = std::make_unique<AsarFileValidator>(
-          std::move(info.integrity.value()), std::move(file));
+          std::move(info.integrity.value()), std::move(file), archive,
+          info.offset);
       file_validator_raw = asar_validator.get();
       readable_data_source = std::make_unique<mojo::FilteredDataSource>(
           std::move(file_data_source), std::move(asar_validator));
@@ -181,26 +363,10 @@ class AsarURLLoader : public network::mojom::URLLoader {
       return;
     }
 
-    std::string range_header;
     net::HttpByteRange byte_range;
-    if (request.headers.GetHeader(net::HttpRequestHeaders::kRange,
-                                  &range_header)) {
-      // Handle a simple Range header for a single range.
-      std::vector<net::HttpByteRange> ranges;
-      bool fail = false;
-      if (net::HttpUtil::ParseRangeHeader(range_header, &ranges) &&
-          ranges.size() == 1) {
-        byte_range = ranges[0];
-        if (!byte_range.ComputeBounds(info.size))
-          fail = true;
-      } else {
-        fail = true;
-      }
-
-      if (fail) {
-        OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
-        return;
-      }
+    if (!GetRequestedRange(request, info.size, &byte_range)) {
+      OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
+      return;
     }
 
     uint64_t first_byte_to_send = 0;
@@ -217,10 +383,19 @@ class AsarURLLoader : public network::mojom::URLLoader {
 
     head->content_length = base::saturated_cast<int64_t>(total_bytes_to_send);
 
+    mojo::ScopedDataPipeProducerHandle producer_handle;
+    mojo::ScopedDataPipeConsumerHandle consumer_handle;
+    const uint32_t pipe_capacity = GetFilePipeCapacity(total_bytes_to_send);
+    if (mojo::CreateDataPipe(pipe_capacity, producer_handle,
+                             consumer_handle) != MOJO_RESULT_OK) {
+      OnClientComplete(net::ERR_FAILED);
+      return;
+    }
+
     if (first_byte_to_send < read_result.bytes_read) {
       // Write any data we read for MIME sniffing, constraining by range where
       // applicable. This will always fit in the pipe (see assertion near
-      // |kDefaultFileUrlPipeSize| definition).
+      // the top of this file).
       uint32_t write_size = std::min(
           static_cast<uint32_t>(read_result.bytes_read - first_byte_to_send),
           static_cast<uint32_t>(total_bytes_to_send));
@@ -256,19 +431,10 @@ class AsarURLLoader : public network::mojom::URLLoader {
       }
     }
 
-    if (!net::GetMimeTypeFromFile(path, &head->mime_type)) {
-      std::string new_type;
-      net::SniffMimeType(
-          base::StringPiece(initial_read_buffer.data(), read_result.bytes_read),
-          request.url, head->mime_type,
-          net::ForceSniffFileUrlsForHtml::kDisabled, &new_type);
-      head->mime_type.assign(new_type);
-      head->did_mime_sniff = true;
-    }
-    if (head->headers) {
-      head->headers->AddHeader(net::HttpRequestHeaders::kContentType,
-                               head->mime_type.c_str());
-    }
+    SetMimeType(
+        request.url, path,
+        base::StringPiece(initial_read_buffer.data(), read_result.bytes_read),
+        head.get());
     client_->OnReceiveResponse(std::move(head), std::move(consumer_handle),
                                std::nullopt);
 
@@ -301,6 +467,14 @@ class AsarURLLoader : public network::mojom::URLLoader {
       if (file_validator_raw)
         file_validator_raw->SetCurrentBlock(start_block);
 
+      // Hash the remaining blocks on the thread pool ahead of the stream so
+      // that the validator mostly finds them already verified.
+      base::ThreadPool::PostTask(
+          FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+          base::BindOnce(&AsarFileValidator::VerifyBlocksAhead, archive,
+                         std::move(read_ahead_file), info.offset, info.size,
+                         std::move(verify_ahead_integrity), start_block));
+
       if (bytes_to_drop > 0) {
         uint64_t dropped_bytes_offset =
             info.offset + (start_block * block_size);
@@ -318,6 +492,17 @@ class AsarURLLoader : public network::mojom::URLLoader {
       }
     }
 
+    // The validator reads ahead while hashing, otherwise pull whatever does
+    // not fit in the pipe into the page cache so that sending the rest does
+    // not wait on the disk once the consumer catches up.
+    if (!is_verifying_file && total_bytes_to_send > pipe_capacity) {
+      base::ThreadPool::PostTask(
+          FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+          base::BindOnce(&ReadAhead, std::move(read_ahead_file),
+                         info.offset + first_byte_to_send + pipe_capacity,
+                         total_bytes_to_send - pipe_capacity));
+    }
+
     // In case of a range request, seek to the appropriate position before
     // sending the remaining bytes asynchronously. Under normal conditions
     // (i.e., no range request) this Seek is effectively a no-op.
@@ -338,6 +523,70 @@ class AsarURLLoader : public network::mojom::URLLoader {
         base::BindOnce(&AsarURLLoader::OnFileWritten, base::Unretained(this)));
   }
 
+  // Compressed files are read through the archive's block cache instead of
+  // straight from the file, and their blocks are validated as they are
+  // decompressed.
+  void StartCompressed(const network::ResourceRequest& request,
+                       const base::FilePath& path,
+                       std::shared_ptr<Archive> archive,
+                       Archive::FileInfo info,
+                       network::mojom::URLResponseHeadPtr head) {
+    std::vector<char> initial_read_buffer(
+        std::min(static_cast<uint32_t>(net::kMaxBytesToSniff), info.size));
+    if (!archive->ReadCompressed(
+            info, 0, base::as_writable_bytes(base::make_span(
+                         initial_read_buffer)))) {
+      OnClientComplete(net::ERR_FAILED);
+      return;
+    }
+
+    net::HttpByteRange byte_range;
+    if (!GetRequestedRange(request, info.size, &byte_range)) {
+      OnClientComplete(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
+      return;
+    }
+
+    uint64_t first_byte_to_send = 0;
+    uint64_t total_bytes_to_send = info.size;
+    if (byte_range.IsValid()) {
+      first_byte_to_send = byte_range.first_byte_position();
+      total_bytes_to_send =
+          byte_range.last_byte_position() - first_byte_to_send + 1;
+    }
+
+    total_bytes_written_ = total_bytes_to_send;
+    head->content_length = base::saturated_cast<int64_t>(total_bytes_to_send);
+
+    mojo::ScopedDataPipeProducerHandle producer_handle;
+    mojo::ScopedDataPipeConsumerHandle consumer_handle;
+    if (mojo::CreateDataPipe(GetFilePipeCapacity(total_bytes_to_send),
+                             producer_handle,
+                             consumer_handle) != MOJO_RESULT_OK) {
+      OnClientComplete(net::ERR_FAILED);
+      return;
+    }
+
+    SetMimeType(request.url, path,
+                base::StringPiece(initial_read_buffer.data(),
+                                  initial_read_buffer.size()),
+                head.get());
+    client_->OnReceiveResponse(std::move(head), std::move(consumer_handle),
+                               std::nullopt);
+
+    if (total_bytes_to_send == 0) {
+      OnFileWritten(MOJO_RESULT_OK);
+      return;
+    }
+
+    data_producer_ =
+        std::make_unique<mojo::DataPipeProducer>(std::move(producer_handle));
+    data_producer_->Write(
+        std::make_unique<CompressedFileDataSource>(
+            std::move(archive), std::move(info), first_byte_to_send,
+            total_bytes_to_send),
+        base::BindOnce(&AsarURLLoader::OnFileWritten, base::Unretained(this)));
+  }
+
   void OnConnectionError() {
     receiver_.reset();
     MaybeDeleteSelf();
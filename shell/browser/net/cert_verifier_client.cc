@@ -15,8 +15,9 @@ VerifyRequestParams::~VerifyRequestParams() = default;
 
 VerifyRequestParams::VerifyRequestParams(const VerifyRequestParams&) = default;
 
-CertVerifierClient::CertVerifierClient(CertVerifyProc proc)
-    : cert_verify_proc_(proc) {}
+CertVerifierClient::CertVerifierClient(CertVerifyProc proc,
+                                       base::TimeDelta cache_ttl)
+    : cert_verify_proc_(proc), cache_ttl_(cache_ttl) {}
 
 CertVerifierClient::~CertVerifierClient() = default;
 
@@ -28,6 +29,20 @@ void CertVerifierClient::Verify(
     int flags,
     const std::optional<std::string>& ocsp_response,
     VerifyCallback callback) {
+  std::optional<CacheKey> cache_key;
+  if (!cache_ttl_.is_zero()) {
+    cache_key.emplace(hostname, certificate->CalculateChainFingerprint256(),
+                      default_error);
+    auto it = cache_.Get(*cache_key);
+    if (it != cache_.end()) {
+      if (base::TimeTicks::Now() < it->second.expiry) {
+        std::move(callback).Run(it->second.result, default_result);
+        return;
+      }
+      cache_.Erase(it);
+    }
+  }
+
   VerifyRequestParams params;
   params.hostname = hostname;
   params.default_result = net::ErrorToString(default_error);
@@ -36,11 +51,23 @@ void CertVerifierClient::Verify(
   params.validated_certificate = default_result.verified_cert;
   params.is_issued_by_known_root = default_result.is_issued_by_known_root;
   cert_verify_proc_.Run(
-      params,
-      base::BindOnce(
-          [](VerifyCallback callback, const net::CertVerifyResult& result,
-             int err) { std::move(callback).Run(err, result); },
-          std::move(callback), default_result));
+      params, base::BindOnce(&CertVerifierClient::OnVerifyProcComplete,
+                             weak_factory_.GetWeakPtr(), std::move(cache_key),
+                             std::move(callback), default_result));
+}
+
+// static
+void CertVerifierClient::OnVerifyProcComplete(
+    base::WeakPtr<CertVerifierClient> self,
+    std::optional<CacheKey> cache_key,
+    VerifyCallback callback,
+    const net::CertVerifyResult& default_result,
+    int result) {
+  if (self && cache_key) {
+    self->cache_.Put(std::move(*cache_key),
+                     {result, base::TimeTicks::Now() + self->cache_ttl_});
+  }
+  std::move(callback).Run(result, default_result);
 }
 
 }  // namespace electron
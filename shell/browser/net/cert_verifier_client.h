@@ -5,8 +5,14 @@
 #ifndef ELECTRON_SHELL_BROWSER_NET_CERT_VERIFIER_CLIENT_H_
 #define ELECTRON_SHELL_BROWSER_NET_CERT_VERIFIER_CLIENT_H_
 
+#include <optional>
 #include <string>
+#include <tuple>
 
+#include "base/containers/lru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "net/base/hash_value.h"
 #include "net/cert/x509_certificate.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 
@@ -31,7 +37,9 @@ class CertVerifierClient : public network::mojom::CertVerifierClient {
       base::RepeatingCallback<void(const VerifyRequestParams& request,
                                    base::OnceCallback<void(int)>)>;
 
-  explicit CertVerifierClient(CertVerifyProc proc);
+  // The verdicts of |proc| are cached for |cache_ttl|, a zero |cache_ttl|
+  // calls |proc| for every verification.
+  CertVerifierClient(CertVerifyProc proc, base::TimeDelta cache_ttl);
   ~CertVerifierClient() override;
 
   // network::mojom::CertVerifierClient
@@ -44,7 +52,28 @@ class CertVerifierClient : public network::mojom::CertVerifierClient {
               VerifyCallback callback) override;
 
  private:
+  // The hostname, the fingerprint of the certificate chain and the default
+  // verification result.
+  using CacheKey = std::tuple<std::string, net::SHA256HashValue, int>;
+
+  struct CachedVerdict {
+    int result;
+    base::TimeTicks expiry;
+  };
+
+  // Runs |callback| even once the client is gone, the network service still
+  // waits for it.
+  static void OnVerifyProcComplete(base::WeakPtr<CertVerifierClient> self,
+                                   std::optional<CacheKey> cache_key,
+                                   VerifyCallback callback,
+                                   const net::CertVerifyResult& default_result,
+                                   int result);
+
   CertVerifyProc cert_verify_proc_;
+  base::TimeDelta cache_ttl_;
+  base::LRUCache<CacheKey, CachedVerdict> cache_{256};
+
+  base::WeakPtrFactory<CertVerifierClient> weak_factory_{this};
 };
 
 }  // namespace electron
@@ -0,0 +1,22 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/data_pipe_util.h"
+
+#include <algorithm>
+
+#include "services/network/public/cpp/features.h"
+
+namespace electron {
+
+uint32_t GetDataPipeCapacity(int64_t content_length) {
+  const uint32_t max_capacity =
+      network::features::GetDataPipeDefaultAllocationSize(
+          network::features::DataPipeAllocationSize::kLargerSizeIfPossible);
+  if (content_length < 0 || content_length >= max_capacity)
+    return max_capacity;
+  return std::max(static_cast<uint32_t>(content_length), kMinDataPipeCapacity);
+}
+
+}  // namespace electron
@@ -0,0 +1,24 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_DATA_PIPE_UTIL_H_
+#define ELECTRON_SHELL_BROWSER_NET_DATA_PIPE_UTIL_H_
+
+#include <cstdint>
+
+namespace electron {
+
+// The smallest pipe handed out, below this there is nothing to save by
+// making the pipe smaller.
+inline constexpr uint32_t kMinDataPipeCapacity = 64 * 1024;
+
+// Returns the capacity of the data pipe to stream a response body through.
+// Bodies whose |content_length| is known and small get a pipe that just fits
+// them, anything else gets the largest pipe the network service would use so
+// that streaming large assets is not throttled by the pipe.
+uint32_t GetDataPipeCapacity(int64_t content_length);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_DATA_PIPE_UTIL_H_
@@ -260,13 +260,15 @@ void ElectronURLLoaderFactory::RedirectedRequest::DeleteThis() {
 
 // static
 mojo::PendingRemote<network::mojom::URLLoaderFactory>
-ElectronURLLoaderFactory::Create(ProtocolType type,
-                                 const ProtocolHandler& handler) {
+ElectronURLLoaderFactory::Create(
+    ProtocolType type,
+    const ProtocolHandler& handler,
+    scoped_refptr<ProtocolResponseCache> response_cache) {
   mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote;
 
   // The ElectronURLLoaderFactory will delete itself when there are no more
   // receivers - see the SelfDeletingURLLoaderFactory::OnDisconnect method.
-  new ElectronURLLoaderFactory(type, handler,
+  new ElectronURLLoaderFactory(type, handler, std::move(response_cache),
                                pending_remote.InitWithNewPipeAndPassReceiver());
 
   return pending_remote;
@@ -275,10 +277,12 @@ ElectronURLLoaderFactory::Create(ProtocolType type,
 ElectronURLLoaderFactory::ElectronURLLoaderFactory(
     ProtocolType type,
     const ProtocolHandler& handler,
+    scoped_refptr<ProtocolResponseCache> response_cache,
     mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver)
     : network::SelfDeletingURLLoaderFactory(std::move(factory_receiver)),
       type_(type),
-      handler_(handler) {}
+      handler_(handler),
+      response_cache_(std::move(response_cache)) {}
 
 ElectronURLLoaderFactory::~ElectronURLLoaderFactory() = default;
 
@@ -291,17 +295,28 @@ void ElectronURLLoaderFactory::CreateLoaderAndStart(
     const net::MutableNetworkTrafficAnnotationTag& traffic_annotation) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
+  // The cache may add conditional headers for the handler to answer.
+  std::optional<network::ResourceRequest> cache_request;
+  if (response_cache_) {
+    cache_request = request;
+    if (response_cache_->MaybeServe(&cache_request.value(), &client))
+      return;
+  }
+  const network::ResourceRequest& handler_request =
+      cache_request ? *cache_request : request;
+
   // |StartLoading| is used for both intercepted and registered protocols,
   // and on redirects it needs a factory to use to create a loader for the
   // new request. So in this case, this factory is the target factory.
   mojo::PendingRemote<network::mojom::URLLoaderFactory> target_factory;
   this->Clone(target_factory.InitWithNewPipeAndPassReceiver());
 
-  handler_.Run(
-      request,
-      base::BindOnce(&ElectronURLLoaderFactory::StartLoading, std::move(loader),
-                     request_id, options, request, std::move(client),
-                     traffic_annotation, std::move(target_factory), type_));
+  handler_.Run(handler_request,
+               base::BindOnce(&ElectronURLLoaderFactory::StartLoading,
+                              std::move(loader), request_id, options,
+                              handler_request, std::move(client),
+                              traffic_annotation, std::move(target_factory),
+                              type_));
 }
 
 // static
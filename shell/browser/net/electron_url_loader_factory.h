@@ -5,12 +5,12 @@
 #ifndef ELECTRON_SHELL_BROWSER_NET_ELECTRON_URL_LOADER_FACTORY_H_
 #define ELECTRON_SHELL_BROWSER_NET_ELECTRON_URL_LOADER_FACTORY_H_
 
-#include <map>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
@@ -21,6 +21,7 @@
 #include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/protocol_response_cache.h"
 #include "shell/common/gin_helper/dictionary.h"
 
 namespace electron {
@@ -40,9 +41,10 @@ using ProtocolHandler =
     base::RepeatingCallback<void(const network::ResourceRequest&,
                                  StartLoadingCallback)>;
 
-// scheme => (type, handler).
+// scheme => (type, handler). Schemes are rarely registered but looked up for
+// every request, and can be looked up without copying the scheme of a URL.
 using HandlersMap =
-    std::map<std::string, std::pair<ProtocolType, ProtocolHandler>>;
+    base::flat_map<std::string, std::pair<ProtocolType, ProtocolHandler>>;
 
 // Implementation of URLLoaderFactory.
 class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
@@ -95,9 +97,12 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
     mojo::Remote<network::mojom::URLLoaderFactory> target_factory_remote_;
   };
 
+  // When |response_cache| is given, requests it can answer never reach
+  // |handler|.
   static mojo::PendingRemote<network::mojom::URLLoaderFactory> Create(
       ProtocolType type,
-      const ProtocolHandler& handler);
+      const ProtocolHandler& handler,
+      scoped_refptr<ProtocolResponseCache> response_cache = nullptr);
 
   // network::mojom::URLLoaderFactory:
   void CreateLoaderAndStart(
@@ -128,6 +133,7 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
   ElectronURLLoaderFactory(
       ProtocolType type,
       const ProtocolHandler& handler,
+      scoped_refptr<ProtocolResponseCache> response_cache,
       mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory_receiver);
   ~ElectronURLLoaderFactory() override;
 
@@ -167,6 +173,7 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
 
   ProtocolType type_;
   ProtocolHandler handler_;
+  scoped_refptr<ProtocolResponseCache> response_cache_;
 };
 
 }  // namespace electron
@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/network_stats.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "net/base/load_timing_info.h"
+#include "net/base/net_errors.h"
+#include "url/gurl.h"
+
+namespace electron {
+
+namespace {
+
+void AddInterval(NetworkStats::Histogram* histogram,
+                 base::TimeTicks start,
+                 base::TimeTicks end) {
+  // The phases that didn't happen, like the connection of a reused socket,
+  // have no times.
+  if (start.is_null() || end.is_null() || end < start)
+    return;
+  histogram->Add(end - start);
+}
+
+}  // namespace
+
+void NetworkStats::Histogram::Add(base::TimeDelta sample) {
+  const auto* bucket =
+      std::upper_bound(kBucketBoundaries.begin(), kBucketBoundaries.end(),
+                       sample.InMilliseconds());
+  buckets[bucket - kBucketBoundaries.begin()]++;
+  count++;
+  total += sample;
+}
+
+NetworkStats::HostStats::HostStats() = default;
+NetworkStats::HostStats::HostStats(const HostStats&) = default;
+NetworkStats::HostStats& NetworkStats::HostStats::operator=(
+    const HostStats&) = default;
+NetworkStats::HostStats::~HostStats() = default;
+
+NetworkStats::NetworkStats() = default;
+
+NetworkStats::~NetworkStats() = default;
+
+void NetworkStats::RecordRequest(const GURL& url,
+                                 int net_error,
+                                 bool was_cached,
+                                 int64_t bytes_received,
+                                 const net::LoadTimingInfo& load_timing) {
+  HostStats* stats = GetHostStats(url);
+  if (!stats)
+    return;
+
+  stats->requests++;
+  if (net_error != net::OK)
+    stats->failed_requests++;
+  if (was_cached)
+    stats->cached_requests++;
+  stats->bytes_received += std::max<int64_t>(bytes_received, 0);
+
+  const net::LoadTimingInfo::ConnectTiming& connect =
+      load_timing.connect_timing;
+  AddInterval(&stats->dns, connect.domain_lookup_start,
+              connect.domain_lookup_end);
+  AddInterval(&stats->connect, connect.connect_start, connect.connect_end);
+  AddInterval(&stats->ssl, connect.ssl_start, connect.ssl_end);
+  AddInterval(&stats->ttfb, load_timing.request_start,
+              load_timing.receive_headers_start);
+}
+
+void NetworkStats::RecordProtocol(const GURL& url, std::string_view protocol) {
+  if (protocol.empty() || protocol == "unknown")
+    return;
+  if (HostStats* stats = GetHostStats(url)) {
+    auto iter = stats->protocols.find(protocol);
+    if (iter == stats->protocols.end())
+      stats->protocols.emplace(protocol, 1);
+    else
+      iter->second++;
+  }
+}
+
+void NetworkStats::Clear() {
+  hosts_.Clear();
+}
+
+NetworkStats::HostStats* NetworkStats::GetHostStats(const GURL& url) {
+  if (!url.SchemeIsHTTPOrHTTPS() && !url.SchemeIsWSOrWSS())
+    return nullptr;
+
+  std::string host = url.host();
+  auto iter = hosts_.Get(host);
+  if (iter == hosts_.end())
+    iter = hosts_.Put(std::move(host), HostStats());
+  return &iter->second;
+}
+
+}  // namespace electron
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_NETWORK_STATS_H_
+#define ELECTRON_SHELL_BROWSER_NET_NETWORK_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "base/containers/lru_cache.h"
+#include "base/time/time.h"
+
+class GURL;
+
+namespace net {
+struct LoadTimingInfo;
+}
+
+namespace electron {
+
+// Aggregates the timing and throughput of the requests of a session by host.
+//
+// The loads are reported by the renderers and the net module once they are
+// complete, so no request has to go through the webRequest proxy for them to
+// be counted.
+class NetworkStats {
+ public:
+  // The upper bounds in milliseconds of the buckets of the timing
+  // histograms, the last bucket has no upper bound.
+  static constexpr std::array<int, 9> kBucketBoundaries = {
+      10, 25, 50, 100, 250, 500, 1000, 2500, 5000};
+
+  struct Histogram {
+    void Add(base::TimeDelta sample);
+
+    uint64_t count = 0;
+    base::TimeDelta total;
+    std::array<uint64_t, kBucketBoundaries.size() + 1> buckets = {};
+  };
+
+  struct HostStats {
+    HostStats();
+    HostStats(const HostStats&);
+    HostStats& operator=(const HostStats&);
+    ~HostStats();
+
+    uint64_t requests = 0;
+    uint64_t failed_requests = 0;
+    uint64_t cached_requests = 0;
+    int64_t bytes_received = 0;
+    Histogram dns;
+    Histogram connect;
+    Histogram ssl;
+    Histogram ttfb;
+    // The number of responses by negotiated protocol, like "h2" or "h3".
+    std::map<std::string, uint64_t, std::less<>> protocols;
+  };
+
+  using HostMap = base::LRUCache<std::string, HostStats>;
+
+  NetworkStats();
+  ~NetworkStats();
+
+  // disable copy
+  NetworkStats(const NetworkStats&) = delete;
+  NetworkStats& operator=(const NetworkStats&) = delete;
+
+  void RecordRequest(const GURL& url,
+                     int net_error,
+                     bool was_cached,
+                     int64_t bytes_received,
+                     const net::LoadTimingInfo& load_timing);
+  // Counts a response whose protocol is known, for loads that are already
+  // counted by RecordRequest() without it.
+  void RecordProtocol(const GURL& url, std::string_view protocol);
+  void Clear();
+
+  const HostMap& hosts() const { return hosts_; }
+
+ private:
+  // Returns null for the URLs that are not fetched over HTTP.
+  HostStats* GetHostStats(const GURL& url);
+
+  // The least recently used hosts are dropped above this.
+  static constexpr size_t kMaxHosts = 256;
+
+  HostMap hosts_{kMaxHosts};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_NETWORK_STATS_H_
@@ -4,15 +4,61 @@
 
 #include "shell/browser/net/node_stream_loader.h"
 
-#include <string_view>
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
-#include "mojo/public/cpp/system/string_data_source.h"
+#include "base/containers/span.h"
+#include "shell/browser/net/data_pipe_util.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/node_includes.h"
 
 namespace electron {
 
+namespace {
+
+// Writes several Buffers into the pipe in one go, reading straight from their
+// memory instead of concatenating them first.
+class BufferListDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  explicit BufferListDataSource(std::vector<base::span<const char>> chunks)
+      : chunks_(std::move(chunks)) {
+    for (const auto& chunk : chunks_)
+      length_ += chunk.size();
+  }
+
+  // disable copy
+  BufferListDataSource(const BufferListDataSource&) = delete;
+  BufferListDataSource& operator=(const BufferListDataSource&) = delete;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return length_; }
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    uint64_t chunk_offset = 0;
+    for (const auto& chunk : chunks_) {
+      if (result.bytes_read == buffer.size())
+        break;
+      const uint64_t position = offset + result.bytes_read;
+      if (position < chunk_offset + chunk.size()) {
+        const size_t begin = position - chunk_offset;
+        const size_t size = std::min(chunk.size() - begin,
+                                     buffer.size() - result.bytes_read);
+        memcpy(buffer.data() + result.bytes_read, chunk.data() + begin, size);
+        result.bytes_read += size;
+      }
+      chunk_offset += chunk.size();
+    }
+    return result;
+  }
+
+ private:
+  std::vector<base::span<const char>> chunks_;
+  uint64_t length_ = 0;
+};
+
+}  // namespace
+
 NodeStreamLoader::NodeStreamLoader(
     network::mojom::URLResponseHeadPtr head,
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
@@ -52,7 +98,8 @@ NodeStreamLoader::~NodeStreamLoader() {
 void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
   mojo::ScopedDataPipeProducerHandle producer;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, producer, consumer);
+  pipe_capacity_ = GetDataPipeCapacity(head->content_length);
+  MojoResult rv = mojo::CreateDataPipe(pipe_capacity_, producer, consumer);
   if (rv != MOJO_RESULT_OK) {
     NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
     return;
@@ -103,14 +150,30 @@ void NodeStreamLoader::ReadMore() {
   is_reading_ = true;
   auto weak = weak_factory_.GetWeakPtr();
   v8::HandleScope scope(isolate_);
-  // buffer = emitter.read()
-  v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
-      isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
-  DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
+
+  // Keep reading while the stream has data buffered, so that one write to the
+  // pipe carries as many chunks as fit in it.
+  std::vector<base::span<const char>> chunks;
+  size_t bytes_read = 0;
+  while (bytes_read < pipe_capacity_) {
+    // buffer = emitter.read()
+    v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
+        isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
+    DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
+
+    v8::Local<v8::Value> buffer;
+    if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer))
+      break;
+
+    // Hold the buffer until the write is done.
+    buffers_.emplace_back(isolate_, buffer);
+    chunks.emplace_back(node::Buffer::Data(buffer),
+                        node::Buffer::Length(buffer));
+    bytes_read += node::Buffer::Length(buffer);
+  }
 
   // If there is no buffer read, wait until |readable| is emitted again.
-  v8::Local<v8::Value> buffer;
-  if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer)) {
+  if (chunks.empty()) {
     is_reading_ = false;
 
     // If 'readable' was called after 'read()', try again
@@ -127,24 +190,18 @@ void NodeStreamLoader::ReadMore() {
     return;
   }
 
-  // Hold the buffer until the write is done.
-  buffer_.Reset(isolate_, buffer);
-
-  bytes_written_ += node::Buffer::Length(buffer);
+  bytes_written_ += bytes_read;
 
-  // Write buffer to mojo pipe asynchronously.
+  // Write buffers to mojo pipe asynchronously.
   is_reading_ = false;
   is_writing_ = true;
-  producer_->Write(std::make_unique<mojo::StringDataSource>(
-                       std::string_view{node::Buffer::Data(buffer),
-                                        node::Buffer::Length(buffer)},
-                       mojo::StringDataSource::AsyncWritingMode::
-                           STRING_STAYS_VALID_UNTIL_COMPLETION),
+  producer_->Write(std::make_unique<BufferListDataSource>(std::move(chunks)),
                    base::BindOnce(&NodeStreamLoader::DidWrite, weak));
 }
 
 void NodeStreamLoader::DidWrite(MojoResult result) {
   is_writing_ = false;
+  buffers_.clear();
   // We were told to end streaming.
   if (ended_) {
     NotifyComplete(result_);
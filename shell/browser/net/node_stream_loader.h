@@ -71,10 +71,13 @@ class NodeStreamLoader : public network::mojom::URLLoader {
 
   raw_ptr<v8::Isolate> isolate_;
   v8::Global<v8::Object> emitter_;
-  v8::Global<v8::Value> buffer_;
+
+  // The Buffers being written, held until the write is done.
+  std::vector<v8::Global<v8::Value>> buffers_;
 
   // Mojo data pipe where the data that is being read is written to.
   std::unique_ptr<mojo::DataPipeProducer> producer_;
+  uint32_t pipe_capacity_ = 0;
 
   // Whether we are in the middle of write.
   bool is_writing_ = false;
@@ -0,0 +1,361 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/protocol_response_cache.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/string_data_source.h"
+#include "net/base/load_flags.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "shell/browser/net/data_pipe_util.h"
+#include "shell/browser/net/response_body_filter.h"
+
+namespace electron {
+
+namespace {
+
+// Larger responses are passed through without being stored.
+constexpr size_t kMaxEntrySize = 16 * 1024 * 1024;
+
+// Least recently used responses are dropped above this.
+constexpr size_t kMaxCacheSize = 64 * 1024 * 1024;
+
+// Whether the handler asked for |head| to be cached.
+bool IsCacheable(const network::mojom::URLResponseHead& head) {
+  const net::HttpResponseHeaders* headers = head.headers.get();
+  if (!headers || headers->response_code() != net::HTTP_OK)
+    return false;
+  // Responses that vary by request headers are not worth keying on them.
+  if (headers->HasHeaderValue("cache-control", "no-store") ||
+      headers->HasHeader("vary"))
+    return false;
+  return headers->HasHeader("cache-control") || headers->HasHeader("expires") ||
+         headers->HasHeader("etag") || headers->HasHeader("last-modified");
+}
+
+void OnEntryWritten(mojo::Remote<network::mojom::URLLoaderClient> client,
+                    std::unique_ptr<mojo::DataPipeProducer> producer,
+                    scoped_refptr<base::RefCountedString> body,
+                    MojoResult result) {
+  network::URLLoaderCompletionStatus status(net::ERR_FAILED);
+  if (result == MOJO_RESULT_OK) {
+    status = network::URLLoaderCompletionStatus(net::OK);
+    status.exists_in_memory_cache = true;
+    status.decoded_body_length = body->size();
+  }
+  client->OnComplete(status);
+}
+
+// Passes the body through unchanged, keeping a copy of it.
+class RecordingTransform : public ResponseBodyTransform {
+ public:
+  RecordingTransform() = default;
+
+  // disable copy
+  RecordingTransform(const RecordingTransform&) = delete;
+  RecordingTransform& operator=(const RecordingTransform&) = delete;
+
+  // Returns the recorded body, or nullopt when it was too large to keep.
+  std::optional<std::string> TakeBody() {
+    if (too_large_)
+      return std::nullopt;
+    return std::move(body_);
+  }
+
+  // ResponseBodyTransform:
+  void Transform(std::optional<std::string> chunk,
+                 OutputCallback callback) override {
+    if (!chunk) {
+      std::move(callback).Run(std::string());
+      return;
+    }
+    if (!too_large_ && body_.size() + chunk->size() <= kMaxEntrySize) {
+      body_.append(*chunk);
+    } else {
+      too_large_ = true;
+      body_.clear();
+    }
+    std::move(callback).Run(std::move(*chunk));
+  }
+
+ private:
+  std::string body_;
+  bool too_large_ = false;
+};
+
+}  // namespace
+
+// Sits between the handler and the client of a request, storing the response
+// if it is cacheable, and answering a 304 from the cache.
+//
+// This class manages its own lifetime and deletes itself when the request
+// completes or either side disconnects.
+class ProtocolResponseCache::Recorder : public network::mojom::URLLoaderClient {
+ public:
+  Recorder(scoped_refptr<ProtocolResponseCache> cache,
+           const GURL& url,
+           bool revalidating,
+           mojo::PendingReceiver<network::mojom::URLLoaderClient> receiver,
+           mojo::PendingRemote<network::mojom::URLLoaderClient> target)
+      : cache_(std::move(cache)),
+        url_(url),
+        revalidating_(revalidating),
+        request_time_(base::Time::Now()),
+        receiver_(this, std::move(receiver)),
+        target_(std::move(target)) {
+    receiver_.set_disconnect_handler(
+        base::BindOnce(&Recorder::OnHandlerDisconnect, base::Unretained(this)));
+    target_.set_disconnect_handler(
+        base::BindOnce(&Recorder::DeleteThis, base::Unretained(this)));
+  }
+
+  // disable copy
+  Recorder(const Recorder&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+
+  // network::mojom::URLLoaderClient:
+  void OnReceiveEarlyHints(network::mojom::EarlyHintsPtr early_hints) override {
+    target_->OnReceiveEarlyHints(std::move(early_hints));
+  }
+  void OnReceiveResponse(
+      network::mojom::URLResponseHeadPtr head,
+      mojo::ScopedDataPipeConsumerHandle body,
+      std::optional<mojo_base::BigBuffer> cached_metadata) override {
+    response_time_ = base::Time::Now();
+
+    if (revalidating_ && head->headers &&
+        head->headers->response_code() == net::HTTP_NOT_MODIFIED) {
+      if (const Entry* entry = cache_->Revalidate(url_, *head->headers,
+                                                  request_time_,
+                                                  response_time_)) {
+        Serve(*entry, target_.Unbind());
+        DeleteThis();
+        return;
+      }
+    }
+
+    if (body && IsCacheable(*head)) {
+      head_ = head.Clone();
+      auto transform = std::make_unique<RecordingTransform>();
+      recording_ = transform.get();
+      body_filter_ = std::make_unique<ResponseBodyFilter>(
+          std::move(transform), base::BindOnce(&Recorder::OnBodyComplete,
+                                               weak_factory_.GetWeakPtr()));
+      body = body_filter_->Start(std::move(body));
+      if (!body) {
+        target_->OnComplete(network::URLLoaderCompletionStatus(
+            net::ERR_INSUFFICIENT_RESOURCES));
+        DeleteThis();
+        return;
+      }
+    }
+
+    target_->OnReceiveResponse(std::move(head), std::move(body),
+                               std::move(cached_metadata));
+  }
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override {
+    target_->OnReceiveRedirect(redirect_info, std::move(head));
+  }
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback callback) override {
+    target_->OnUploadProgress(current_position, total_size,
+                              std::move(callback));
+  }
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override {
+    target_->OnTransferSizeUpdated(transfer_size_diff);
+  }
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override {
+    // Wait for the recorded body to be complete as well.
+    if (body_filter_ && !body_filter_->is_complete() &&
+        status.error_code == net::OK) {
+      pending_status_ = status;
+      return;
+    }
+    Finish(status);
+  }
+
+ private:
+  ~Recorder() override = default;
+
+  void OnHandlerDisconnect() {
+    // The handler is done once it has completed, the body may still be
+    // being recorded.
+    if (!pending_status_)
+      DeleteThis();
+  }
+
+  void OnBodyComplete() {
+    if (pending_status_)
+      Finish(*pending_status_);
+  }
+
+  void Finish(const network::URLLoaderCompletionStatus& status) {
+    if (status.error_code == net::OK && recording_) {
+      if (std::optional<std::string> body = recording_->TakeBody()) {
+        Entry entry;
+        entry.head = std::move(head_);
+        entry.body =
+            base::MakeRefCounted<base::RefCountedString>(std::move(*body));
+        entry.request_time = request_time_;
+        entry.response_time = response_time_;
+        cache_->Store(url_, std::move(entry));
+      }
+    }
+    target_->OnComplete(status);
+    DeleteThis();
+  }
+
+  void DeleteThis() { delete this; }
+
+  scoped_refptr<ProtocolResponseCache> cache_;
+  const GURL url_;
+  const bool revalidating_;
+  const base::Time request_time_;
+  base::Time response_time_;
+
+  mojo::Receiver<network::mojom::URLLoaderClient> receiver_;
+  mojo::Remote<network::mojom::URLLoaderClient> target_;
+
+  network::mojom::URLResponseHeadPtr head_;
+  std::unique_ptr<ResponseBodyFilter> body_filter_;
+  // Owned by |body_filter_|.
+  raw_ptr<RecordingTransform> recording_ = nullptr;
+  std::optional<network::URLLoaderCompletionStatus> pending_status_;
+
+  base::WeakPtrFactory<Recorder> weak_factory_{this};
+};
+
+ProtocolResponseCache::Entry::Entry() = default;
+ProtocolResponseCache::Entry::Entry(Entry&&) = default;
+ProtocolResponseCache::Entry& ProtocolResponseCache::Entry::operator=(
+    Entry&&) = default;
+ProtocolResponseCache::Entry::~Entry() = default;
+
+ProtocolResponseCache::ProtocolResponseCache()
+    : entries_(base::LRUCache<GURL, Entry>::NO_AUTO_EVICT) {}
+
+ProtocolResponseCache::~ProtocolResponseCache() = default;
+
+bool ProtocolResponseCache::MaybeServe(
+    network::ResourceRequest* request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient>* client) {
+  // Leave requests the cache can not answer as a whole to the handler.
+  if (request->method != net::HttpRequestHeaders::kGetMethod ||
+      request->headers.HasHeader(net::HttpRequestHeaders::kRange) ||
+      request->headers.HasHeader(net::HttpRequestHeaders::kIfNoneMatch) ||
+      request->headers.HasHeader(net::HttpRequestHeaders::kIfModifiedSince) ||
+      (request->load_flags & net::LOAD_DISABLE_CACHE))
+    return false;
+
+  bool revalidating = false;
+  auto iter = entries_.Get(request->url);
+  if (iter != entries_.end() &&
+      !(request->load_flags & net::LOAD_BYPASS_CACHE)) {
+    const Entry& entry = iter->second;
+    const net::HttpResponseHeaders& headers = *entry.head->headers;
+    if (!(request->load_flags & net::LOAD_VALIDATE_CACHE) &&
+        headers.RequiresValidation(entry.request_time, entry.response_time,
+                                   base::Time::Now()) == net::VALIDATION_NONE) {
+      Serve(entry, std::move(*client));
+      return true;
+    }
+
+    std::string value;
+    if (headers.EnumerateHeader(nullptr, "etag", &value)) {
+      request->headers.SetHeader(net::HttpRequestHeaders::kIfNoneMatch, value);
+      revalidating = true;
+    }
+    if (headers.EnumerateHeader(nullptr, "last-modified", &value)) {
+      request->headers.SetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+                                 value);
+      revalidating = true;
+    }
+  }
+
+  mojo::PendingRemote<network::mojom::URLLoaderClient> recorder;
+  new Recorder(this, request->url, revalidating,
+               recorder.InitWithNewPipeAndPassReceiver(), std::move(*client));
+  *client = std::move(recorder);
+  return false;
+}
+
+// static
+void ProtocolResponseCache::Serve(
+    const Entry& entry,
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client) {
+  mojo::Remote<network::mojom::URLLoaderClient> client_remote(
+      std::move(client));
+
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(GetDataPipeCapacity(entry.body->size()), producer,
+                           consumer) != MOJO_RESULT_OK) {
+    client_remote->OnComplete(
+        network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+    return;
+  }
+
+  client_remote->OnReceiveResponse(entry.head.Clone(), std::move(consumer),
+                                   std::nullopt);
+
+  // The body is shared with the cache entry, which may be replaced while it
+  // is being written.
+  auto data_producer =
+      std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+  auto* producer_ptr = data_producer.get();
+  producer_ptr->Write(
+      std::make_unique<mojo::StringDataSource>(
+          entry.body->as_string(), mojo::StringDataSource::AsyncWritingMode::
+                                       STRING_STAYS_VALID_UNTIL_COMPLETION),
+      base::BindOnce(&OnEntryWritten, std::move(client_remote),
+                     std::move(data_producer), entry.body));
+}
+
+void ProtocolResponseCache::Store(const GURL& url, Entry entry) {
+  if (auto iter = entries_.Peek(url); iter != entries_.end()) {
+    total_size_ -= iter->second.body->size();
+    entries_.Erase(iter);
+  }
+
+  total_size_ += entry.body->size();
+  entries_.Put(url, std::move(entry));
+
+  while (total_size_ > kMaxCacheSize && !entries_.empty()) {
+    total_size_ -= entries_.rbegin()->second.body->size();
+    entries_.Erase(entries_.rbegin());
+  }
+}
+
+const ProtocolResponseCache::Entry* ProtocolResponseCache::Revalidate(
+    const GURL& url,
+    const net::HttpResponseHeaders& headers,
+    base::Time request_time,
+    base::Time response_time) {
+  auto iter = entries_.Get(url);
+  if (iter == entries_.end())
+    return nullptr;
+
+  Entry& entry = iter->second;
+  entry.head->headers->Update(headers);
+  entry.request_time = request_time;
+  entry.response_time = response_time;
+  return &entry;
+}
+
+}  // namespace electron
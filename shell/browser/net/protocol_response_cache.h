@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define ELECTRON_SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <cstddef>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_loader.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "url/gurl.h"
+
+namespace net {
+class HttpResponseHeaders;
+}
+
+namespace electron {
+
+// In-memory cache for the responses of a custom protocol handler, shared by
+// every renderer of a session.
+//
+// Responses are only stored when their headers ask for it, and are served
+// for as long as they are fresh by the rules of HTTP. Stale responses that
+// carry an ETag or Last-Modified header are revalidated: the handler gets a
+// conditional request and can answer it with a 304.
+class ProtocolResponseCache : public base::RefCounted<ProtocolResponseCache> {
+ public:
+  ProtocolResponseCache();
+
+  // disable copy
+  ProtocolResponseCache(const ProtocolResponseCache&) = delete;
+  ProtocolResponseCache& operator=(const ProtocolResponseCache&) = delete;
+
+  // Serves |request| to |client| when a fresh response is cached for it.
+  // Otherwise returns false, after adding any conditional headers to
+  // |request| and replacing |client| with one that records the response the
+  // handler gives.
+  bool MaybeServe(network::ResourceRequest* request,
+                  mojo::PendingRemote<network::mojom::URLLoaderClient>* client);
+
+ private:
+  friend class base::RefCounted<ProtocolResponseCache>;
+  ~ProtocolResponseCache();
+
+  class Recorder;
+
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+    ~Entry();
+
+    network::mojom::URLResponseHeadPtr head;
+    scoped_refptr<base::RefCountedString> body;
+    base::Time request_time;
+    base::Time response_time;
+  };
+
+  static void Serve(
+      const Entry& entry,
+      mojo::PendingRemote<network::mojom::URLLoaderClient> client);
+
+  void Store(const GURL& url, Entry entry);
+
+  // Applies the headers of a 304 answer to the entry for |url|, returns
+  // nullptr when there is no longer any.
+  const Entry* Revalidate(const GURL& url,
+                          const net::HttpResponseHeaders& headers,
+                          base::Time request_time,
+                          base::Time response_time);
+
+  base::LRUCache<GURL, Entry> entries_;
+  size_t total_size_ = 0;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
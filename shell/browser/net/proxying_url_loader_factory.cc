@@ -303,6 +303,11 @@ void ProxyingURLLoaderFactory::InProgressRequest::OnComplete(
     return;
   }
 
+  if (body_filter_ && !body_filter_->is_complete()) {
+    pending_complete_status_ = status;
+    return;
+  }
+
   target_client_->OnComplete(status);
   factory_->web_request_api()->OnCompleted(&info_.value(), request_,
                                            status.error_code);
@@ -662,14 +667,55 @@ void ProxyingURLLoaderFactory::InProgressRequest::ContinueToResponseStarted(
 
   info_->AddResponseInfoFromResourceResponse(*current_response_);
 
+  factory_->web_request_api()->OnResponseStarted(&info_.value(), request_);
+
+  if (current_body_) {
+    int result = factory_->web_request_api()->OnResponseBody(
+        &info_.value(), request_,
+        base::BindOnce(&InProgressRequest::ContinueToReceiveResponse,
+                       weak_factory_.GetWeakPtr()));
+    if (result == net::ERR_IO_PENDING) {
+      // Hold back OnComplete until the response has been forwarded.
+      proxied_client_receiver_.Pause();
+      return;
+    }
+  }
+
+  ContinueToReceiveResponse(nullptr);
+}
+
+void ProxyingURLLoaderFactory::InProgressRequest::ContinueToReceiveResponse(
+    std::unique_ptr<ResponseBodyTransform> transform) {
+  if (transform) {
+    body_filter_ = std::make_unique<ResponseBodyFilter>(
+        std::move(transform),
+        base::BindOnce(&InProgressRequest::OnBodyFilterComplete,
+                       weak_factory_.GetWeakPtr()));
+    current_body_ = body_filter_->Start(std::move(current_body_));
+    if (!current_body_) {
+      OnRequestError(
+          network::URLLoaderCompletionStatus(net::ERR_INSUFFICIENT_RESOURCES));
+      return;
+    }
+
+    // The length of the filtered body is not known until it has been written.
+    current_response_->content_length = -1;
+    if (current_response_->headers)
+      current_response_->headers->RemoveHeader("Content-Length");
+  }
+
   proxied_client_receiver_.Resume();
 
-  factory_->web_request_api()->OnResponseStarted(&info_.value(), request_);
   target_client_->OnReceiveResponse(current_response_.Clone(),
                                     std::move(current_body_),
                                     std::move(current_cached_metadata_));
 }
 
+void ProxyingURLLoaderFactory::InProgressRequest::OnBodyFilterComplete() {
+  if (pending_complete_status_)
+    OnComplete(*pending_complete_status_);
+}
+
 void ProxyingURLLoaderFactory::InProgressRequest::ContinueToBeforeRedirect(
     const net::RedirectInfo& redirect_info,
     int error_code) {
@@ -808,7 +854,7 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
   bool bypass_custom_protocol_handlers =
       options & kBypassCustomProtocolHandlers;
   if (!bypass_custom_protocol_handlers) {
-    auto it = intercepted_handlers_->find(request.url.scheme());
+    auto it = intercepted_handlers_->find(request.url.scheme_piece());
     if (it != intercepted_handlers_->end()) {
       mojo::PendingRemote<network::mojom::URLLoaderFactory> loader_remote;
       this->Clone(loader_remote.InitWithNewPipeAndPassReceiver());
@@ -835,8 +881,9 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
     return;
   }
 
-  if (!web_request_api()->HasListener()) {
-    // Pass-through to the original factory.
+  if (!web_request_api()->HasListenerForURL(request.url)) {
+    // Pass-through to the original factory, without the bookkeeping of an
+    // InProgressRequest, when no listener is interested in the request.
     target_factory_->CreateLoaderAndStart(std::move(loader), request_id,
                                           options, request, std::move(client),
                                           traffic_annotation);
@@ -33,6 +33,7 @@
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "services/network/url_loader_factory.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
+#include "shell/browser/net/response_body_filter.h"
 #include "shell/browser/net/web_request_api_interface.h"
 #include "url/gurl.h"
 
@@ -126,6 +127,9 @@ class ProxyingURLLoaderFactory
     void ContinueToStartRequest(int error_code);
     void ContinueToHandleOverrideHeaders(int error_code);
     void ContinueToResponseStarted(int error_code);
+    void ContinueToReceiveResponse(
+        std::unique_ptr<ResponseBodyTransform> transform);
+    void OnBodyFilterComplete();
     void ContinueToBeforeRedirect(const net::RedirectInfo& redirect_info,
                                   int error_code);
     void HandleResponseOrRedirectHeaders(
@@ -155,6 +159,11 @@ class ProxyingURLLoaderFactory
     scoped_refptr<net::HttpResponseHeaders> override_headers_;
     GURL redirect_url_;
 
+    // Filters the body for an |onResponseBody| listener. The completion of
+    // the request is held back until all of the filtered body is written.
+    std::unique_ptr<ResponseBodyFilter> body_filter_;
+    std::optional<network::URLLoaderCompletionStatus> pending_complete_status_;
+
     const bool for_cors_preflight_ = false;
 
     // If |has_any_extra_headers_listeners_| is set to true, the request will be
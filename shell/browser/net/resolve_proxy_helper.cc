@@ -9,6 +9,7 @@
 #include "base/functional/bind.h"
 #include "content/public/browser/browser_thread.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/base/net_errors.h"
 #include "net/base/network_anonymization_key.h"
 #include "net/proxy_resolution/proxy_info.h"
 
@@ -18,67 +19,109 @@ namespace electron {
 
 ResolveProxyHelper::ResolveProxyHelper(
     network::mojom::NetworkContext* network_context)
-    : network_context_(network_context) {}
+    : network_context_(network_context) {
+  receivers_.set_disconnect_handler(
+      base::BindRepeating(&ResolveProxyHelper::OnProxyLookupDisconnected,
+                          base::Unretained(this)));
+}
 
 ResolveProxyHelper::~ResolveProxyHelper() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   DCHECK(!owned_self_);
-  DCHECK(!receiver_.is_bound());
   // Clear all pending requests if the ProxyService is still alive.
+  receivers_.Clear();
+  in_progress_requests_.clear();
   pending_requests_.clear();
 }
 
 void ResolveProxyHelper::ResolveProxy(const GURL& url,
                                       ResolveProxyCallback callback) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!cache_ttl_.is_zero()) {
+    auto it = cache_.Get(url::SchemeHostPort(url));
+    if (it != cache_.end()) {
+      if (base::TimeTicks::Now() < it->second.expiry) {
+        std::move(callback).Run(it->second.proxy);
+        return;
+      }
+      cache_.Erase(it);
+    }
+  }
+
   // Enqueue the pending request.
   pending_requests_.emplace_back(url, std::move(callback));
+  StartPendingRequests();
+}
 
-  // If nothing is in progress, start.
-  if (!receiver_.is_bound()) {
-    DCHECK_EQ(1u, pending_requests_.size());
-    StartPendingRequest();
-  }
+void ResolveProxyHelper::SetMaxConcurrentLookups(
+    size_t max_concurrent_lookups) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  DCHECK_GT(max_concurrent_lookups, 0u);
+  max_concurrent_lookups_ = max_concurrent_lookups;
+  StartPendingRequests();
+}
+
+void ResolveProxyHelper::SetCacheTTL(base::TimeDelta ttl) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  cache_ttl_ = ttl;
+  if (cache_ttl_.is_zero())
+    ClearCache();
 }
 
-void ResolveProxyHelper::StartPendingRequest() {
+void ResolveProxyHelper::ClearCache() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!receiver_.is_bound());
-  DCHECK(!pending_requests_.empty());
-
-  // Start the request.
-  mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client =
-      receiver_.BindNewPipeAndPassRemote();
-  receiver_.set_disconnect_handler(
-      base::BindOnce(&ResolveProxyHelper::OnProxyLookupComplete,
-                     base::Unretained(this), net::ERR_ABORTED, std::nullopt));
-  network_context_->LookUpProxyForURL(pending_requests_.front().url,
-                                      net::NetworkAnonymizationKey(),
-                                      std::move(proxy_lookup_client));
+  cache_.Clear();
+}
+
+void ResolveProxyHelper::StartPendingRequests() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  while (!pending_requests_.empty() &&
+         in_progress_requests_.size() < max_concurrent_lookups_) {
+    const uint64_t request_id = next_request_id_++;
+    mojo::PendingRemote<network::mojom::ProxyLookupClient> proxy_lookup_client;
+    receivers_.Add(this, proxy_lookup_client.InitWithNewPipeAndPassReceiver(),
+                   request_id);
+    network_context_->LookUpProxyForURL(pending_requests_.front().url,
+                                        net::NetworkAnonymizationKey(),
+                                        std::move(proxy_lookup_client));
+    in_progress_requests_.emplace(request_id,
+                                  std::move(pending_requests_.front()));
+    pending_requests_.pop_front();
+  }
 }
 
 void ResolveProxyHelper::OnProxyLookupComplete(
     int32_t net_error,
     const std::optional<net::ProxyInfo>& proxy_info) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
-  DCHECK(!pending_requests_.empty());
-
-  receiver_.reset();
+  const uint64_t request_id = receivers_.current_context();
+  receivers_.Remove(receivers_.current_receiver());
 
   // Clear the current (completed) request.
-  PendingRequest completed_request = std::move(pending_requests_.front());
-  pending_requests_.pop_front();
+  auto it = in_progress_requests_.find(request_id);
+  DCHECK(it != in_progress_requests_.end());
+  PendingRequest completed_request = std::move(it->second);
+  in_progress_requests_.erase(it);
 
   std::string proxy;
   if (proxy_info)
     proxy = proxy_info->ToPacString();
 
+  if (net_error == net::OK && !cache_ttl_.is_zero()) {
+    cache_.Put(url::SchemeHostPort(completed_request.url),
+               {proxy, base::TimeTicks::Now() + cache_ttl_});
+  }
+
+  // Start the next requests before running the callback, which might queue
+  // more of them.
+  StartPendingRequests();
+
   if (!completed_request.callback.is_null())
     std::move(completed_request.callback).Run(proxy);
+}
 
-  // Start the next request.
-  if (!pending_requests_.empty())
-    StartPendingRequest();
+void ResolveProxyHelper::OnProxyLookupDisconnected() {
+  OnProxyLookupComplete(net::ERR_ABORTED, std::nullopt);
 }
 
 ResolveProxyHelper::PendingRequest::PendingRequest(
@@ -5,16 +5,21 @@
 #ifndef ELECTRON_SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 #define ELECTRON_SHELL_BROWSER_NET_RESOLVE_PROXY_HELPER_H_
 
+#include <cstdint>
 #include <deque>
 #include <optional>
 #include <string>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
-#include "mojo/public/cpp/bindings/receiver.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/proxy_lookup_client.mojom.h"
 #include "url/gurl.h"
+#include "url/scheme_host_port.h"
 
 namespace electron {
 
@@ -28,6 +33,15 @@ class ResolveProxyHelper
 
   void ResolveProxy(const GURL& url, ResolveProxyCallback callback);
 
+  // Sets how many lookups are in progress at once, the others are queued.
+  void SetMaxConcurrentLookups(size_t max_concurrent_lookups);
+
+  // Caches the results per origin for |ttl|, a zero |ttl| disables the cache.
+  void SetCacheTTL(base::TimeDelta ttl);
+
+  // Drops the cached results, for when the proxy config changes.
+  void ClearCache();
+
   // disable copy
   ResolveProxyHelper(const ResolveProxyHelper&) = delete;
   ResolveProxyHelper& operator=(const ResolveProxyHelper&) = delete;
@@ -54,20 +68,34 @@ class ResolveProxyHelper
     ResolveProxyCallback callback;
   };
 
-  // Starts the first pending request.
-  void StartPendingRequest();
+  struct CachedResult {
+    std::string proxy;
+    base::TimeTicks expiry;
+  };
+
+  // Starts the pending requests, up to the limit of concurrent lookups.
+  void StartPendingRequests();
 
   // network::mojom::ProxyLookupClient implementation.
   void OnProxyLookupComplete(
       int32_t net_error,
       const std::optional<net::ProxyInfo>& proxy_info) override;
 
+  void OnProxyLookupDisconnected();
+
   // Self-reference. Owned as long as there's an outstanding proxy lookup.
   scoped_refptr<ResolveProxyHelper> owned_self_;
 
   std::deque<PendingRequest> pending_requests_;
-  // Receiver for the currently in-progress request, if any.
-  mojo::Receiver<network::mojom::ProxyLookupClient> receiver_{this};
+  // The requests in progress, by the id that is the context of their
+  // receiver.
+  base::flat_map<uint64_t, PendingRequest> in_progress_requests_;
+  mojo::ReceiverSet<network::mojom::ProxyLookupClient, uint64_t> receivers_;
+  uint64_t next_request_id_ = 0;
+  size_t max_concurrent_lookups_ = 8;
+
+  base::TimeDelta cache_ttl_;
+  base::LRUCache<url::SchemeHostPort, CachedResult> cache_{1000};
 
   // Weak Ref
   raw_ptr<network::mojom::NetworkContext> network_context_ = nullptr;
@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/response_body_filter.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "mojo/public/cpp/system/string_data_source.h"
+
+namespace electron {
+
+namespace {
+
+// The largest chunk handed to the transform at once.
+constexpr uint32_t kMaxChunkSize = 64 * 1024;
+
+}  // namespace
+
+ResponseBodyFilter::ResponseBodyFilter(
+    std::unique_ptr<ResponseBodyTransform> transform,
+    base::OnceClosure on_complete)
+    : transform_(std::move(transform)),
+      on_complete_(std::move(on_complete)),
+      source_watcher_(FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::MANUAL) {}
+
+ResponseBodyFilter::~ResponseBodyFilter() = default;
+
+mojo::ScopedDataPipeConsumerHandle ResponseBodyFilter::Start(
+    mojo::ScopedDataPipeConsumerHandle source) {
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(nullptr, producer, consumer) != MOJO_RESULT_OK)
+    return {};
+
+  producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+  source_ = std::move(source);
+  source_watcher_.Watch(
+      source_.get(),
+      MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+      base::BindRepeating(&ResponseBodyFilter::OnSourceReadable,
+                          base::Unretained(this)));
+  source_watcher_.ArmOrNotify();
+  return consumer;
+}
+
+void ResponseBodyFilter::OnSourceReadable(MojoResult result) {
+  const void* buffer = nullptr;
+  uint32_t num_bytes = 0;
+  result =
+      source_->BeginReadData(&buffer, &num_bytes, MOJO_READ_DATA_FLAG_NONE);
+  if (result == MOJO_RESULT_SHOULD_WAIT) {
+    source_watcher_.ArmOrNotify();
+    return;
+  }
+
+  auto callback = base::BindOnce(&ResponseBodyFilter::OnTransformed,
+                                 weak_factory_.GetWeakPtr());
+  if (result != MOJO_RESULT_OK) {
+    // The other end has been closed, so the whole body has been read.
+    source_watcher_.Cancel();
+    source_.reset();
+    source_done_ = true;
+    transform_->Transform(std::nullopt, std::move(callback));
+    return;
+  }
+
+  num_bytes = std::min(num_bytes, kMaxChunkSize);
+  std::string chunk(static_cast<const char*>(buffer), num_bytes);
+  source_->EndReadData(num_bytes);
+  transform_->Transform(std::move(chunk), std::move(callback));
+}
+
+void ResponseBodyFilter::OnTransformed(std::string output) {
+  if (output.empty()) {
+    OnWritten(MOJO_RESULT_OK);
+    return;
+  }
+
+  pending_output_ = std::move(output);
+  producer_->Write(
+      std::make_unique<mojo::StringDataSource>(
+          pending_output_, mojo::StringDataSource::AsyncWritingMode::
+                               STRING_STAYS_VALID_UNTIL_COMPLETION),
+      base::BindOnce(&ResponseBodyFilter::OnWritten,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ResponseBodyFilter::OnWritten(MojoResult result) {
+  pending_output_.clear();
+
+  if (result != MOJO_RESULT_OK) {
+    // Nobody is reading the filtered body anymore.
+    source_watcher_.Cancel();
+    source_.reset();
+    producer_.reset();
+    return;
+  }
+
+  if (source_done_) {
+    // Closing the pipe signals the end of the body to the consumer.
+    producer_.reset();
+    complete_ = true;
+    std::move(on_complete_).Run();
+    return;
+  }
+
+  source_watcher_.ArmOrNotify();
+}
+
+}  // namespace electron
@@ -0,0 +1,80 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_NET_RESPONSE_BODY_FILTER_H_
+#define ELECTRON_SHELL_BROWSER_NET_RESPONSE_BODY_FILTER_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+
+namespace electron {
+
+// Rewrites a response body as it streams through a ResponseBodyFilter.
+class ResponseBodyTransform {
+ public:
+  using OutputCallback = base::OnceCallback<void(std::string output)>;
+
+  virtual ~ResponseBodyTransform() = default;
+
+  // Called with each chunk of the body, and then once with std::nullopt when
+  // all of it has been read. |callback| takes the data to write in place of
+  // the chunk, the next chunk is not read until it has been run.
+  virtual void Transform(std::optional<std::string> chunk,
+                         OutputCallback callback) = 0;
+};
+
+// Pipes a response body through a ResponseBodyTransform into a new data pipe.
+// A chunk is only read once the output for the previous one has been
+// written, so a slow transform or consumer holds back the network instead of
+// the body being buffered in memory.
+class ResponseBodyFilter {
+ public:
+  ResponseBodyFilter(std::unique_ptr<ResponseBodyTransform> transform,
+                     base::OnceClosure on_complete);
+  ~ResponseBodyFilter();
+
+  // disable copy
+  ResponseBodyFilter(const ResponseBodyFilter&) = delete;
+  ResponseBodyFilter& operator=(const ResponseBodyFilter&) = delete;
+
+  // Starts reading |source|, returns the pipe that the filtered body is
+  // written to, or an invalid handle if it could not be created.
+  mojo::ScopedDataPipeConsumerHandle Start(
+      mojo::ScopedDataPipeConsumerHandle source);
+
+  // Whether the whole filtered body has been written.
+  bool is_complete() const { return complete_; }
+
+ private:
+  void OnSourceReadable(MojoResult result);
+  void OnTransformed(std::string output);
+  void OnWritten(MojoResult result);
+
+  std::unique_ptr<ResponseBodyTransform> transform_;
+  base::OnceClosure on_complete_;
+
+  mojo::ScopedDataPipeConsumerHandle source_;
+  mojo::SimpleWatcher source_watcher_;
+  std::unique_ptr<mojo::DataPipeProducer> producer_;
+
+  // The output being written, kept alive until the write completes.
+  std::string pending_output_;
+
+  // Whether the end of |source_| has been reached.
+  bool source_done_ = false;
+  bool complete_ = false;
+
+  base::WeakPtrFactory<ResponseBodyFilter> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_NET_RESPONSE_BODY_FILTER_H_
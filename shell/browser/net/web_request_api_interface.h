@@ -5,12 +5,14 @@
 #ifndef ELECTRON_SHELL_BROWSER_NET_WEB_REQUEST_API_INTERFACE_H_
 #define ELECTRON_SHELL_BROWSER_NET_WEB_REQUEST_API_INTERFACE_H_
 
+#include <memory>
 #include <set>
 #include <string>
 
 #include "extensions/browser/api/web_request/web_request_info.h"
 #include "net/base/completion_once_callback.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "shell/browser/net/response_body_filter.h"
 
 namespace electron {
 
@@ -23,8 +25,13 @@ class WebRequestAPI {
       base::OnceCallback<void(const std::set<std::string>& removed_headers,
                               const std::set<std::string>& set_headers,
                               int error_code)>;
+  using ResponseBodyCallback =
+      base::OnceCallback<void(std::unique_ptr<ResponseBodyTransform>)>;
 
   virtual bool HasListener() const = 0;
+  // Whether any listener or rule could apply to a request that starts at
+  // |url|, requests for which this is false are not proxied at all.
+  virtual bool HasListenerForURL(const GURL& url) const = 0;
   virtual int OnBeforeRequest(extensions::WebRequestInfo* info,
                               const network::ResourceRequest& request,
                               net::CompletionOnceCallback callback,
@@ -48,6 +55,12 @@ class WebRequestAPI {
                                 const GURL& new_location) = 0;
   virtual void OnResponseStarted(extensions::WebRequestInfo* info,
                                  const network::ResourceRequest& request) = 0;
+  // Returns net::OK when the body should reach the client unchanged, or
+  // net::ERR_IO_PENDING when |callback| will be run with the transform to
+  // filter it through, which may be null.
+  virtual int OnResponseBody(extensions::WebRequestInfo* info,
+                             const network::ResourceRequest& request,
+                             ResponseBodyCallback callback) = 0;
   virtual void OnErrorOccurred(extensions::WebRequestInfo* info,
                                const network::ResourceRequest& request,
                                int net_error) = 0;
@@ -5,11 +5,36 @@
 #include "shell/browser/notifications/notification_presenter.h"
 
 #include <algorithm>
+#include <utility>
 
-#include "shell/browser/notifications/notification.h"
+#include "base/functional/bind.h"
+#include "base/ranges/algorithm.h"
 
 namespace electron {
 
+namespace {
+
+// A burst of notifications is shown at this rate, the notification centers
+// of the systems can't keep up with more and only show a few of them anyway.
+constexpr size_t kMaxNotificationsPerWindow = 5;
+constexpr base::TimeDelta kRateLimitWindow = base::Seconds(1);
+
+// The oldest queued notifications fail beyond this.
+constexpr size_t kMaxPendingNotifications = 50;
+
+}  // namespace
+
+NotificationPresenter::PendingNotification::PendingNotification(
+    base::WeakPtr<Notification> notification,
+    const NotificationOptions& options)
+    : notification(std::move(notification)), options(options) {}
+NotificationPresenter::PendingNotification::PendingNotification(
+    PendingNotification&&) = default;
+NotificationPresenter::PendingNotification&
+NotificationPresenter::PendingNotification::operator=(PendingNotification&&) =
+    default;
+NotificationPresenter::PendingNotification::~PendingNotification() = default;
+
 NotificationPresenter::NotificationPresenter() = default;
 
 NotificationPresenter::~NotificationPresenter() {
@@ -39,9 +64,76 @@ void NotificationPresenter::CloseNotificationWithId(
                          });
   if (it != notifications_.end()) {
     Notification* notification = (*it);
+    if (CancelPendingNotification(notification))
+      return;
     notification->Dismiss();
     notifications_.erase(notification);
   }
 }
 
+void NotificationPresenter::ShowNotification(
+    Notification* notification,
+    const NotificationOptions& options) {
+  if (!options.tag.empty()) {
+    auto it = base::ranges::find_if(
+        pending_notifications_, [&options](const PendingNotification& pending) {
+          return pending.notification && pending.options.tag == options.tag;
+        });
+    if (it != pending_notifications_.end()) {
+      // Replaced before it was shown, like a shown one would be.
+      Notification* replaced = it->notification.get();
+      pending_notifications_.erase(it);
+      RemoveNotification(replaced);
+    }
+  }
+
+  pending_notifications_.emplace_back(notification->GetWeakPtr(), options);
+  if (pending_notifications_.size() > kMaxPendingNotifications) {
+    base::WeakPtr<Notification> dropped =
+        std::move(pending_notifications_.front().notification);
+    pending_notifications_.pop_front();
+    if (dropped)
+      dropped->NotificationFailed("Too many notifications are queued");
+  }
+  ShowPendingNotifications();
+}
+
+bool NotificationPresenter::CancelPendingNotification(
+    Notification* notification) {
+  auto it = base::ranges::find_if(
+      pending_notifications_, [notification](const PendingNotification& p) {
+        return p.notification.get() == notification;
+      });
+  if (it == pending_notifications_.end())
+    return false;
+  pending_notifications_.erase(it);
+  RemoveNotification(notification);
+  return true;
+}
+
+void NotificationPresenter::ShowPendingNotifications() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  while (!recent_shows_.empty() &&
+         now - recent_shows_.front() >= kRateLimitWindow) {
+    recent_shows_.pop_front();
+  }
+
+  while (!pending_notifications_.empty() &&
+         recent_shows_.size() < kMaxNotificationsPerWindow) {
+    PendingNotification pending = std::move(pending_notifications_.front());
+    pending_notifications_.pop_front();
+    if (!pending.notification)
+      continue;
+    recent_shows_.push_back(now);
+    pending.notification->Show(pending.options);
+  }
+
+  if (!pending_notifications_.empty() && !timer_.IsRunning()) {
+    timer_.Start(
+        FROM_HERE, recent_shows_.front() + kRateLimitWindow - now,
+        base::BindOnce(&NotificationPresenter::ShowPendingNotifications,
+                       base::Unretained(this)));
+  }
+}
+
 }  // namespace electron
@@ -5,14 +5,17 @@
 #ifndef ELECTRON_SHELL_BROWSER_NOTIFICATIONS_NOTIFICATION_PRESENTER_H_
 #define ELECTRON_SHELL_BROWSER_NOTIFICATIONS_NOTIFICATION_PRESENTER_H_
 
+#include <deque>
 #include <set>
 #include <string>
 
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "shell/browser/notifications/notification.h"
 
 namespace electron {
 
-class Notification;
 class NotificationDelegate;
 
 class NotificationPresenter {
@@ -26,6 +29,15 @@ class NotificationPresenter {
       const std::string& notification_id);
   void CloseNotificationWithId(const std::string& notification_id);
 
+  // Shows |notification|, or queues it when too many notifications were shown
+  // recently. A queued notification is replaced by the next one with the same
+  // tag.
+  void ShowNotification(Notification* notification,
+                        const NotificationOptions& options);
+
+  // Discards |notification| if it is still queued, returns whether it was.
+  bool CancelPendingNotification(Notification* notification);
+
   std::set<Notification*> notifications() const { return notifications_; }
 
   // disable copy
@@ -40,9 +52,26 @@ class NotificationPresenter {
  private:
   friend class Notification;
 
+  struct PendingNotification {
+    PendingNotification(base::WeakPtr<Notification> notification,
+                        const NotificationOptions& options);
+    PendingNotification(PendingNotification&&);
+    PendingNotification& operator=(PendingNotification&&);
+    ~PendingNotification();
+
+    base::WeakPtr<Notification> notification;
+    NotificationOptions options;
+  };
+
   void RemoveNotification(Notification* notification);
+  void ShowPendingNotifications();
 
   std::set<Notification*> notifications_;
+
+  std::deque<PendingNotification> pending_notifications_;
+  // When the notifications of the current rate limit window were shown.
+  std::deque<base::TimeTicks> recent_shows_;
+  base::OneShotTimer timer_;
 };
 
 }  // namespace electron
@@ -38,7 +38,7 @@ void OnWebNotificationAllowed(base::WeakPtr<Notification> notification,
     if (data.require_interaction)
       options.timeout_type = u"never";
 
-    notification->Show(options);
+    notification->presenter()->ShowNotification(notification.get(), options);
   } else {
     notification->Destroy();
   }
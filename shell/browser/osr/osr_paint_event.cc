@@ -0,0 +1,40 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_paint_event.h"
+
+#include <utility>
+
+namespace electron {
+
+OffscreenSharedTextureHolder::OffscreenSharedTextureHolder(
+    media::mojom::VideoBufferHandlePtr data,
+    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+        callbacks)
+    : data_(std::move(data)), callbacks_(std::move(callbacks)) {}
+
+OffscreenSharedTextureHolder::~OffscreenSharedTextureHolder() = default;
+
+const gfx::GpuMemoryBufferHandle* OffscreenSharedTextureHolder::handle()
+    const {
+  if (!data_ || !data_->is_gpu_memory_buffer_handle())
+    return nullptr;
+  return &data_->get_gpu_memory_buffer_handle();
+}
+
+void OffscreenSharedTextureHolder::Release() {
+  // Dropping the callbacks pipe tells the capturer that the consumer is done
+  // with the frame, after which it may be recycled.
+  callbacks_.reset();
+  data_.reset();
+}
+
+OffscreenSharedTextureValue::OffscreenSharedTextureValue() = default;
+OffscreenSharedTextureValue::OffscreenSharedTextureValue(
+    const OffscreenSharedTextureValue&) = default;
+OffscreenSharedTextureValue& OffscreenSharedTextureValue::operator=(
+    const OffscreenSharedTextureValue&) = default;
+OffscreenSharedTextureValue::~OffscreenSharedTextureValue() = default;
+
+}  // namespace electron
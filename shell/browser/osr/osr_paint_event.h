@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_OSR_OSR_PAINT_EVENT_H_
+#define ELECTRON_SHELL_BROWSER_OSR_OSR_PAINT_EVENT_H_
+
+#include <optional>
+
+#include "base/functional/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "media/base/video_types.h"
+#include "media/capture/mojom/video_capture_buffer.mojom.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "services/viz/privileged/mojom/compositing/frame_sink_video_capture.mojom.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+#include "ui/gfx/gpu_memory_buffer.h"
+
+namespace electron {
+
+// Keeps a frame captured into a GPU texture alive. The capturer will not
+// reuse the texture, and its platform handles stay valid, until every
+// reference has been dropped or Release() has been called.
+class OffscreenSharedTextureHolder
+    : public base::RefCounted<OffscreenSharedTextureHolder> {
+ public:
+  OffscreenSharedTextureHolder(
+      media::mojom::VideoBufferHandlePtr data,
+      mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks);
+
+  // disable copy
+  OffscreenSharedTextureHolder(const OffscreenSharedTextureHolder&) = delete;
+  OffscreenSharedTextureHolder& operator=(const OffscreenSharedTextureHolder&) =
+      delete;
+
+  // Returns the GPU memory buffer, or nullptr once released.
+  const gfx::GpuMemoryBufferHandle* handle() const;
+
+  void Release();
+
+ private:
+  friend class base::RefCounted<OffscreenSharedTextureHolder>;
+  ~OffscreenSharedTextureHolder();
+
+  media::mojom::VideoBufferHandlePtr data_;
+  mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+      callbacks_;
+};
+
+// A frame that was captured into a GPU texture rather than read back into
+// an SkBitmap, for use with `offscreen: { useSharedTexture: true }`.
+struct OffscreenSharedTextureValue {
+  OffscreenSharedTextureValue();
+  OffscreenSharedTextureValue(const OffscreenSharedTextureValue&);
+  OffscreenSharedTextureValue& operator=(const OffscreenSharedTextureValue&);
+  ~OffscreenSharedTextureValue();
+
+  // Whether the frame belongs to a popup widget, which is not composited
+  // into the frame of its parent in this mode.
+  bool is_popup = false;
+  media::VideoPixelFormat pixel_format = media::PIXEL_UNKNOWN;
+  gfx::Size coded_size;
+  gfx::Rect visible_rect;
+  gfx::Rect content_rect;
+  base::TimeDelta timestamp;
+  std::optional<gfx::Rect> capture_update_rect;
+  scoped_refptr<OffscreenSharedTextureHolder> holder;
+};
+
+// Called with the damaged area and either a bitmap of the whole frame, or,
+// when the frame was captured into a GPU texture, an empty bitmap and the
+// texture.
+typedef base::RepeatingCallback<void(
+    const gfx::Rect&,
+    const SkBitmap&,
+    const std::optional<OffscreenSharedTextureValue>&)>
+    OnPaintCallback;
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_OSR_OSR_PAINT_EVENT_H_
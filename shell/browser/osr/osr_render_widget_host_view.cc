@@ -54,6 +54,14 @@ namespace {
 
 const float kDefaultScaleFactor = 1.0;
 
+// The backing bitmap, the frame composited with popups and the frames that
+// are still referenced from JS draw from the pool.
+constexpr size_t kMaxPooledFrameBuffers = 4;
+
+// How long an adaptive view has to go without input or new frames before it
+// lowers its frame rate.
+constexpr base::TimeDelta kAdaptiveFrameRateIdleDelay = base::Seconds(1);
+
 ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   ui::EventType type = ui::EventType::ET_UNKNOWN;
   switch (event.GetType()) {
@@ -173,6 +181,7 @@ class ElectronDelegatedFrameHostClient
 
 OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
     bool transparent,
+    bool offscreen_use_shared_texture,
     bool painting,
     int frame_rate,
     const OnPaintCallback& callback,
@@ -183,6 +192,7 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       render_widget_host_(content::RenderWidgetHostImpl::From(host)),
       parent_host_view_(parent_host_view),
       transparent_(transparent),
+      offscreen_use_shared_texture_(offscreen_use_shared_texture),
       callback_(callback),
       frame_rate_(frame_rate),
       size_(initial_size),
@@ -195,7 +205,9 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
           true /* should_register_frame_sink_id */)},
       cursor_manager_(std::make_unique<content::CursorManager>(this)),
       mouse_wheel_phase_handler_(this),
-      backing_(std::make_unique<SkBitmap>()) {
+      backing_(std::make_unique<SkBitmap>()),
+      frame_buffer_pool_(
+          base::MakeRefCounted<FrameBufferPool>(kMaxPooledFrameBuffers)) {
   DCHECK(render_widget_host_);
   DCHECK(!render_widget_host_->GetView());
 
@@ -557,9 +569,14 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
         embedder_render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
-      transparent_, true, embedder_host_view->frame_rate(), callback_,
-      render_widget_host, embedder_host_view, size());
+  auto* view = new OffScreenRenderWidgetHostView(
+      transparent_, offscreen_use_shared_texture_, true,
+      embedder_host_view->frame_rate(), callback_, render_widget_host,
+      embedder_host_view, size());
+  view->SetAdaptiveFrameRate(embedder_host_view->adaptive_frame_rate(),
+                             embedder_host_view->max_latency());
+  view->SetVSyncTimebase(embedder_host_view->vsync_timebase());
+  return view;
 }
 
 const viz::FrameSinkId& OffScreenRenderWidgetHostView::GetFrameSinkId() const {
@@ -684,11 +701,28 @@ uint64_t OffScreenRenderWidgetHostView::GetNSViewId() const {
 }
 #endif
 
-void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
-                                            const SkBitmap& bitmap) {
+void OffScreenRenderWidgetHostView::OnPaint(
+    const gfx::Rect& damage_rect,
+    const SkBitmap& bitmap,
+    const std::optional<OffscreenSharedTextureValue>& texture) {
+  NotifyActivity();
+
+  // Textures are passed on untouched, popups included, and it is up to the
+  // consumer to composite them.
+  if (texture) {
+    callback_.Run(gfx::IntersectRects(gfx::Rect(SizeInPixels()), damage_rect),
+                  SkBitmap(), texture);
+    return;
+  }
+
   backing_ = std::make_unique<SkBitmap>();
-  backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
-  bitmap.readPixels(backing_->pixmap());
+  if (frame_buffer_pool_->AllocPixels(
+          SkImageInfo::MakeN32(
+              bitmap.width(), bitmap.height(),
+              transparent_ ? kPremul_SkAlphaType : kOpaque_SkAlphaType),
+          backing_.get())) {
+    bitmap.readPixels(backing_->pixmap());
+  }
 
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
@@ -716,9 +750,11 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
     frame = GetBacking();
   } else {
     float sf = GetDeviceScaleFactor();
-    frame.allocN32Pixels(size_in_pixels.width(), size_in_pixels.height(),
-                         false);
-    if (!GetBacking().drawsNothing()) {
+    frame_buffer_pool_->AllocPixels(
+        SkImageInfo::MakeN32Premul(size_in_pixels.width(),
+                                   size_in_pixels.height()),
+        &frame);
+    if (!GetBacking().drawsNothing() && !frame.drawsNothing()) {
       SkCanvas canvas(frame);
       canvas.writePixels(GetBacking(), 0, 0);
 
@@ -741,7 +777,7 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
   }
 
   callback_.Run(gfx::IntersectRects(gfx::Rect(size_in_pixels), damage_rect),
-                frame);
+                frame, std::nullopt);
 
   ReleaseResize();
 }
@@ -789,6 +825,7 @@ void OffScreenRenderWidgetHostView::SynchronizeVisualProperties() {
 
 void OffScreenRenderWidgetHostView::SendMouseEvent(
     const blink::WebMouseEvent& event) {
+  NotifyActivity();
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->bounds();
     if (bounds.Contains(event.PositionInWidget().x(),
@@ -827,6 +864,7 @@ void OffScreenRenderWidgetHostView::SendMouseEvent(
 
 void OffScreenRenderWidgetHostView::SendMouseWheelEvent(
     const blink::WebMouseWheelEvent& event) {
+  NotifyActivity();
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->bounds();
     if (bounds.Contains(event.PositionInWidget().x(),
@@ -950,6 +988,54 @@ void OffScreenRenderWidgetHostView::SetFrameRate(int frame_rate) {
     guest_host_view->SetFrameRate(frame_rate);
 }
 
+void OffScreenRenderWidgetHostView::SetAdaptiveFrameRate(
+    bool adaptive,
+    base::TimeDelta max_latency) {
+  adaptive_frame_rate_ = adaptive;
+  max_latency_ = max_latency;
+
+  idle_timer_.Stop();
+  idle_ = false;
+  SetupFrameRate(true);
+  NotifyActivity();
+
+  if (popup_host_view_)
+    popup_host_view_->SetAdaptiveFrameRate(adaptive, max_latency);
+
+  for (auto* guest_host_view : guest_host_views_)
+    guest_host_view->SetAdaptiveFrameRate(adaptive, max_latency);
+}
+
+void OffScreenRenderWidgetHostView::SetVSyncTimebase(
+    base::TimeTicks timebase) {
+  vsync_timebase_ = timebase;
+  SetupFrameRate(true);
+
+  if (popup_host_view_)
+    popup_host_view_->SetVSyncTimebase(timebase);
+
+  for (auto* guest_host_view : guest_host_views_)
+    guest_host_view->SetVSyncTimebase(timebase);
+}
+
+void OffScreenRenderWidgetHostView::NotifyActivity() {
+  if (!adaptive_frame_rate_)
+    return;
+
+  idle_timer_.Start(FROM_HERE, kAdaptiveFrameRateIdleDelay,
+                    base::BindOnce(&OffScreenRenderWidgetHostView::OnIdle,
+                                   base::Unretained(this)));
+  if (idle_) {
+    idle_ = false;
+    SetupFrameRate(true);
+  }
+}
+
+void OffScreenRenderWidgetHostView::OnIdle() {
+  idle_ = true;
+  SetupFrameRate(true);
+}
+
 const viz::LocalSurfaceId& OffScreenRenderWidgetHostView::GetLocalSurfaceId()
     const {
   return delegated_frame_host_surface_id_;
@@ -963,7 +1049,10 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
 
   if (compositor_) {
     compositor_->SetDisplayVSyncParameters(
-        base::TimeTicks::Now(), base::Microseconds(frame_rate_threshold_us_));
+        vsync_timebase_.is_null() ? base::TimeTicks::Now() : vsync_timebase_,
+        idle_ ? std::max(max_latency_,
+                         base::Microseconds(frame_rate_threshold_us_))
+              : base::Microseconds(frame_rate_threshold_us_));
   }
 }
 
@@ -17,8 +17,11 @@
 #endif
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/process/kill.h"
 #include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/surfaces/parent_local_surface_id_allocator.h"
 #include "content/browser/renderer_host/delegated_frame_host.h"  // nogncheck
@@ -26,7 +29,9 @@
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_view_base.h"  // nogncheck
 #include "content/browser/web_contents/web_contents_view.h"  // nogncheck
+#include "shell/browser/frame_buffer_pool.h"
 #include "shell/browser/osr/osr_host_display_client.h"
+#include "shell/browser/osr/osr_paint_event.h"
 #include "shell/browser/osr/osr_video_consumer.h"
 #include "shell/browser/osr/osr_view_proxy.h"
 #include "third_party/blink/public/mojom/widget/record_content_to_visible_time_request.mojom-forward.h"
@@ -55,8 +60,6 @@ class ElectronBeginFrameTimer;
 
 class ElectronDelegatedFrameHostClient;
 
-typedef base::RepeatingCallback<void(const gfx::Rect&, const SkBitmap&)>
-    OnPaintCallback;
 typedef base::RepeatingCallback<void(const gfx::Rect&)> OnPopupPaintCallback;
 
 class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
@@ -64,6 +67,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
                                       public OffscreenViewProxyObserver {
  public:
   OffScreenRenderWidgetHostView(bool transparent,
+                                bool offscreen_use_shared_texture,
                                 bool painting,
                                 int frame_rate,
                                 const OnPaintCallback& callback,
@@ -189,7 +193,9 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void RemoveViewProxy(OffscreenViewProxy* proxy);
   void ProxyViewDestroyed(OffscreenViewProxy* proxy) override;
 
-  void OnPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void OnPaint(const gfx::Rect& damage_rect,
+               const SkBitmap& bitmap,
+               const std::optional<OffscreenSharedTextureValue>& texture);
   void OnPopupPaint(const gfx::Rect& damage_rect);
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
@@ -216,6 +222,25 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetFrameRate(int frame_rate);
   int frame_rate() const { return frame_rate_; }
 
+  // When adaptive, the view drops to one begin frame per |max_latency| after
+  // it has gone a while without input or new frames, and returns to
+  // |frame_rate| as soon as either arrives again.
+  void SetAdaptiveFrameRate(bool adaptive, base::TimeDelta max_latency);
+  bool adaptive_frame_rate() const { return adaptive_frame_rate_; }
+  base::TimeDelta max_latency() const { return max_latency_; }
+
+  // Tells an adaptive view that input was sent to it.
+  void NotifyActivity();
+
+  // The views that share a timebase begin their frames at the same time, a
+  // null one starts the frames when the frame rate is set.
+  void SetVSyncTimebase(base::TimeTicks timebase);
+  base::TimeTicks vsync_timebase() const { return vsync_timebase_; }
+
+  bool offscreen_use_shared_texture() const {
+    return offscreen_use_shared_texture_;
+  }
+
   ui::Layer* root_layer() const { return root_layer_.get(); }
 
   content::DelegatedFrameHost* delegated_frame_host() const {
@@ -241,6 +266,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
  private:
   void SetupFrameRate(bool force);
+  void OnIdle();
   void ResizeRootLayer(bool force);
 
   viz::FrameSinkId AllocateFrameSinkId();
@@ -259,12 +285,20 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   std::set<OffscreenViewProxy*> proxy_views_;
 
   const bool transparent_;
+  const bool offscreen_use_shared_texture_;
   OnPaintCallback callback_;
   OnPopupPaintCallback parent_callback_;
 
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
 
+  bool adaptive_frame_rate_ = false;
+  base::TimeDelta max_latency_;
+  bool idle_ = false;
+  base::OneShotTimer idle_timer_;
+
+  base::TimeTicks vsync_timebase_;
+
   gfx::Size size_;
   bool painting_;
 
@@ -309,6 +343,9 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   std::unique_ptr<SkBitmap> backing_;
 
+  // Pixel memory for |backing_| and composited frames.
+  scoped_refptr<FrameBufferPool> frame_buffer_pool_;
+
   base::WeakPtrFactory<OffScreenRenderWidgetHostView> weak_ptr_factory_{this};
 };
 
@@ -39,7 +39,11 @@ OffScreenVideoConsumer::OffScreenVideoConsumer(
       video_capturer_(view->CreateVideoCapturer()) {
   video_capturer_->SetAutoThrottlingEnabled(false);
   video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB);
+  // The capturer can only produce GPU memory buffers in NV12, which is also
+  // the format that video encoders and most engines can sample directly.
+  video_capturer_->SetFormat(view_->offscreen_use_shared_texture()
+                                 ? media::PIXEL_FORMAT_NV12
+                                 : media::PIXEL_FORMAT_ARGB);
 
   SizeChanged(view_->SizeInPixels());
   SetFrameRate(view_->frame_rate());
@@ -49,7 +53,10 @@ OffScreenVideoConsumer::~OffScreenVideoConsumer() = default;
 
 void OffScreenVideoConsumer::SetActive(bool active) {
   if (active) {
-    video_capturer_->Start(this, viz::mojom::BufferFormatPreference::kDefault);
+    video_capturer_->Start(
+        this, view_->offscreen_use_shared_texture()
+                  ? viz::mojom::BufferFormatPreference::kPreferGpuMemoryBuffer
+                  : viz::mojom::BufferFormatPreference::kDefault);
   } else {
     video_capturer_->Stop();
   }
@@ -72,13 +79,35 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     const gfx::Rect& content_rect,
     mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
         callbacks) {
-  auto& data_region = data->get_read_only_shmem_region();
-
   if (!CheckContentRect(content_rect)) {
     SizeChanged(view_->SizeInPixels());
     return;
   }
 
+  std::optional<gfx::Rect> update_rect = info->metadata.capture_update_rect;
+  if (!update_rect.has_value() || update_rect->IsEmpty()) {
+    update_rect = content_rect;
+  }
+
+  // Hand GPU textures out as they are; the capturer keeps the texture for
+  // this frame until the consumer releases it.
+  if (data->is_gpu_memory_buffer_handle()) {
+    OffscreenSharedTextureValue texture;
+    texture.is_popup = view_->IsPopupWidget();
+    texture.pixel_format = info->pixel_format;
+    texture.coded_size = info->coded_size;
+    texture.visible_rect = info->visible_rect;
+    texture.content_rect = content_rect;
+    texture.timestamp = info->timestamp;
+    texture.capture_update_rect = info->metadata.capture_update_rect;
+    texture.holder = base::MakeRefCounted<OffscreenSharedTextureHolder>(
+        std::move(data), std::move(callbacks));
+    callback_.Run(*update_rect, SkBitmap(), texture);
+    return;
+  }
+
+  auto& data_region = data->get_read_only_shmem_region();
+
   mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
       callbacks_remote(std::move(callbacks));
 
@@ -128,12 +157,7 @@ void OffScreenVideoConsumer::OnFrameCaptured(
       new FramePinner{std::move(mapping), callbacks_remote.Unbind()});
   bitmap.setImmutable();
 
-  std::optional<gfx::Rect> update_rect = info->metadata.capture_update_rect;
-  if (!update_rect.has_value() || update_rect->IsEmpty()) {
-    update_rect = content_rect;
-  }
-
-  callback_.Run(*update_rect, bitmap);
+  callback_.Run(*update_rect, bitmap, std::nullopt);
 }
 
 void OffScreenVideoConsumer::OnNewSubCaptureTargetVersion(
@@ -13,8 +13,11 @@ namespace electron {
 
 OffScreenWebContentsView::OffScreenWebContentsView(
     bool transparent,
+    bool offscreen_use_shared_texture,
     const OnPaintCallback& callback)
-    : transparent_(transparent), callback_(callback) {
+    : transparent_(transparent),
+      offscreen_use_shared_texture_(offscreen_use_shared_texture),
+      callback_(callback) {
 #if BUILDFLAG(IS_MAC)
   PlatformCreate();
 #endif
@@ -122,9 +125,12 @@ OffScreenWebContentsView::CreateViewForWidget(
         render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
-      transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
-      nullptr, GetSize());
+  auto* view = new OffScreenRenderWidgetHostView(
+      transparent_, offscreen_use_shared_texture_, painting_, GetFrameRate(),
+      callback_, render_widget_host, nullptr, GetSize());
+  view->SetAdaptiveFrameRate(adaptive_frame_rate_, max_latency_);
+  view->SetVSyncTimebase(vsync_timebase_);
+  return view;
 }
 
 content::RenderWidgetHostViewBase*
@@ -138,9 +144,13 @@ OffScreenWebContentsView::CreateViewForChildWidget(
           ? web_contents_impl->GetOuterWebContents()->GetRenderWidgetHostView()
           : web_contents_impl->GetRenderWidgetHostView());
 
-  return new OffScreenRenderWidgetHostView(transparent_, painting_,
-                                           view->frame_rate(), callback_,
-                                           render_widget_host, view, GetSize());
+  auto* child_view = new OffScreenRenderWidgetHostView(
+      transparent_, offscreen_use_shared_texture_, painting_,
+      view->frame_rate(), callback_, render_widget_host, view, GetSize());
+  child_view->SetAdaptiveFrameRate(view->adaptive_frame_rate(),
+                                   view->max_latency());
+  child_view->SetVSyncTimebase(view->vsync_timebase());
+  return child_view;
 }
 
 void OffScreenWebContentsView::SetPageTitle(const std::u16string& title) {}
@@ -204,6 +214,21 @@ void OffScreenWebContentsView::SetFrameRate(int frame_rate) {
   }
 }
 
+void OffScreenWebContentsView::SetAdaptiveFrameRate(
+    bool adaptive,
+    base::TimeDelta max_latency) {
+  adaptive_frame_rate_ = adaptive;
+  max_latency_ = max_latency;
+  if (auto* view = GetView())
+    view->SetAdaptiveFrameRate(adaptive, max_latency);
+}
+
+void OffScreenWebContentsView::SetVSyncTimebase(base::TimeTicks timebase) {
+  vsync_timebase_ = timebase;
+  if (auto* view = GetView())
+    view->SetVSyncTimebase(timebase);
+}
+
 int OffScreenWebContentsView::GetFrameRate() const {
   if (auto* view = GetView())
     return view->frame_rate();
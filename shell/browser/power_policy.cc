@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/power_policy.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/power_monitor/power_monitor.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// The share of the time a hidden page may run under |policy|.
+double RunningShare(const BackgroundThrottlingPolicy& policy) {
+  return policy.budget / policy.interval;
+}
+
+}  // namespace
+
+// static
+PowerPolicy* PowerPolicy::GetInstance() {
+  static base::NoDestructor<PowerPolicy> instance;
+  return instance.get();
+}
+
+PowerPolicy::PowerPolicy() = default;
+
+PowerPolicy::~PowerPolicy() = default;
+
+void PowerPolicy::SetRules(std::vector<Rule> rules) {
+  rules_ = std::move(rules);
+  if (!rules_.empty() && !observing_) {
+    observing_ = true;
+    base::PowerMonitor::AddPowerStateObserver(this);
+    base::PowerMonitor::AddPowerThermalObserver(this);
+    on_battery_power_ = base::PowerMonitor::IsOnBatteryPower();
+    thermal_state_ = base::PowerMonitor::GetCurrentThermalState();
+  } else if (rules_.empty() && observing_) {
+    observing_ = false;
+    base::PowerMonitor::RemovePowerStateObserver(this);
+    base::PowerMonitor::RemovePowerThermalObserver(this);
+  }
+  Update();
+}
+
+void PowerPolicy::AddObserver(Observer* observer) {
+  observers_.AddObserver(observer);
+}
+
+void PowerPolicy::RemoveObserver(Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+bool PowerPolicy::Matches(Condition condition) const {
+  switch (condition) {
+    case Condition::kOnBattery:
+      return on_battery_power_;
+    case Condition::kThermalFair:
+      return thermal_state_ >= DeviceThermalState::kFair;
+    case Condition::kThermalSerious:
+      return thermal_state_ >= DeviceThermalState::kSerious;
+    case Condition::kThermalCritical:
+      return thermal_state_ >= DeviceThermalState::kCritical;
+  }
+  return false;
+}
+
+void PowerPolicy::Update() {
+  // The strictest of the rules that apply wins.
+  Actions actions;
+  for (const Rule& rule : rules_) {
+    if (!Matches(rule.condition))
+      continue;
+    if (const auto& rate = rule.actions.max_offscreen_frame_rate) {
+      actions.max_offscreen_frame_rate =
+          std::min(*rate, actions.max_offscreen_frame_rate.value_or(*rate));
+    }
+    if (const auto& policy = rule.actions.background_throttling_policy) {
+      if (!actions.background_throttling_policy ||
+          RunningShare(*policy) <
+              RunningShare(*actions.background_throttling_policy))
+        actions.background_throttling_policy = policy;
+    }
+    actions.pause_low_priority_downloads |=
+        rule.actions.pause_low_priority_downloads;
+    actions.pause_renderer_process_pools |=
+        rule.actions.pause_renderer_process_pools;
+  }
+
+  if (actions == actions_)
+    return;
+  TRACE_EVENT0("electron", "PowerPolicy::Update");
+  actions_ = actions;
+  for (Observer& observer : observers_)
+    observer.OnPowerPolicyChanged();
+}
+
+void PowerPolicy::OnPowerStateChange(bool on_battery_power) {
+  on_battery_power_ = on_battery_power;
+  Update();
+}
+
+void PowerPolicy::OnThermalStateChange(DeviceThermalState new_state) {
+  thermal_state_ = new_state;
+  Update();
+}
+
+}  // namespace electron
@@ -0,0 +1,98 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_POWER_POLICY_H_
+#define ELECTRON_SHELL_BROWSER_POWER_POLICY_H_
+
+#include <optional>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/observer_list.h"
+#include "base/observer_list_types.h"
+#include "base/power_monitor/power_observer.h"
+#include "shell/browser/hidden_page_throttler.h"
+
+namespace electron {
+
+// Applies the rules set with powerMonitor.setPolicy() while the system is on
+// battery power or under thermal pressure, so that the app uses less power
+// without waiting for its JS listeners to react.
+class PowerPolicy : public base::PowerStateObserver,
+                    public base::PowerThermalObserver {
+ public:
+  // What the rules that currently apply ask for, combined.
+  struct Actions {
+    bool operator==(const Actions&) const = default;
+
+    // Caps the frame rate of the offscreen pages.
+    std::optional<int> max_offscreen_frame_rate;
+    // Replaces the policies of the hidden pages.
+    std::optional<BackgroundThrottlingPolicy> background_throttling_policy;
+    // Pauses the downloads whose priority is low.
+    bool pause_low_priority_downloads = false;
+    // Stops refilling the renderer process pools of the sessions.
+    bool pause_renderer_process_pools = false;
+  };
+
+  enum class Condition {
+    kOnBattery,
+    // The thermal states match the state or any worse one.
+    kThermalFair,
+    kThermalSerious,
+    kThermalCritical,
+  };
+
+  struct Rule {
+    Condition condition = Condition::kOnBattery;
+    Actions actions;
+  };
+
+  class Observer : public base::CheckedObserver {
+   public:
+    // Called when the actions that apply changed.
+    virtual void OnPowerPolicyChanged() = 0;
+  };
+
+  static PowerPolicy* GetInstance();
+
+  // disable copy
+  PowerPolicy(const PowerPolicy&) = delete;
+  PowerPolicy& operator=(const PowerPolicy&) = delete;
+
+  // The system's power state is only observed while there are rules.
+  void SetRules(std::vector<Rule> rules);
+
+  const Actions& actions() const { return actions_; }
+
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
+ private:
+  friend class base::NoDestructor<PowerPolicy>;
+
+  PowerPolicy();
+  ~PowerPolicy() override;
+
+  bool Matches(Condition condition) const;
+  void Update();
+
+  // base::PowerStateObserver:
+  void OnPowerStateChange(bool on_battery_power) override;
+
+  // base::PowerThermalObserver:
+  void OnThermalStateChange(DeviceThermalState new_state) override;
+  void OnSpeedLimitChange(int speed_limit) override {}
+
+  std::vector<Rule> rules_;
+  bool observing_ = false;
+  bool on_battery_power_ = false;
+  DeviceThermalState thermal_state_ = DeviceThermalState::kUnknown;
+  Actions actions_;
+  base::ObserverList<Observer> observers_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_POWER_POLICY_H_
@@ -42,9 +42,15 @@ void ProtocolRegistry::RegisterURLLoaderFactories(
     }
   }
 
-  for (const auto& it : handlers_) {
-    factories->emplace(it.first, ElectronURLLoaderFactory::Create(
-                                     it.second.first, it.second.second));
+  for (const auto& it : handlers_)
+    factories->emplace(it.first, GetURLLoaderFactory(it.first));
+
+  for (auto& [scheme, factory] : factories_) {
+    if (base::Contains(handlers_, scheme))
+      continue;
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> remote;
+    factory->Clone(remote.InitWithNewPipeAndPassReceiver());
+    factories->emplace(scheme, std::move(remote));
   }
 }
 
@@ -56,27 +62,73 @@ ProtocolRegistry::CreateNonNetworkNavigationURLLoaderFactory(
       return AsarURLLoaderFactory::Create();
     }
   } else {
-    auto handler = handlers_.find(scheme);
-    if (handler != handlers_.end()) {
-      return ElectronURLLoaderFactory::Create(handler->second.first,
-                                              handler->second.second);
-    }
+    if (IsProtocolRegistered(scheme))
+      return GetURLLoaderFactory(scheme);
   }
   return {};
 }
 
+mojo::PendingRemote<network::mojom::URLLoaderFactory>
+ProtocolRegistry::GetURLLoaderFactory(const std::string& scheme) {
+  DCHECK(IsProtocolRegistered(scheme));
+  auto& factory = factories_[scheme];
+  // The factory of a handler of this process is created again if it went
+  // away, the one of another process is not.
+  auto handler_it = handlers_.find(scheme);
+  if (handler_it != handlers_.end() &&
+      (!factory.is_bound() || !factory.is_connected())) {
+    const auto& [type, handler] = handler_it->second;
+    factory.reset();
+    factory.Bind(ElectronURLLoaderFactory::Create(type, handler,
+                                                  GetResponseCache(scheme)));
+  }
+  mojo::PendingRemote<network::mojom::URLLoaderFactory> remote;
+  factory->Clone(remote.InitWithNewPipeAndPassReceiver());
+  return remote;
+}
+
 bool ProtocolRegistry::RegisterProtocol(ProtocolType type,
                                         const std::string& scheme,
                                         const ProtocolHandler& handler) {
   return handlers_.try_emplace(scheme, type, handler).second;
 }
 
+bool ProtocolRegistry::RegisterProtocolFactory(
+    const std::string& scheme,
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> factory) {
+  if (IsProtocolRegistered(scheme))
+    return false;
+  factories_[scheme].Bind(std::move(factory));
+  return true;
+}
+
 bool ProtocolRegistry::UnregisterProtocol(const std::string& scheme) {
-  return handlers_.erase(scheme) != 0;
+  response_caches_.erase(scheme);
+  bool removed = factories_.erase(scheme) != 0;
+  return handlers_.erase(scheme) != 0 || removed;
 }
 
 bool ProtocolRegistry::IsProtocolRegistered(const std::string& scheme) {
-  return base::Contains(handlers_, scheme);
+  return base::Contains(handlers_, scheme) ||
+         base::Contains(factories_, scheme);
+}
+
+bool ProtocolRegistry::EnableResponseCache(const std::string& scheme) {
+  // Only the handlers of this process can use a cache.
+  if (!base::Contains(handlers_, scheme))
+    return false;
+  if (!response_caches_[scheme]) {
+    response_caches_[scheme] = base::MakeRefCounted<ProtocolResponseCache>();
+    // The factory is created with the cache of its scheme.
+    factories_.erase(scheme);
+  }
+  return true;
+}
+
+scoped_refptr<ProtocolResponseCache> ProtocolRegistry::GetResponseCache(
+    const std::string& scheme) const {
+  auto iter = response_caches_.find(scheme);
+  return iter != response_caches_.end() ? iter->second : nullptr;
 }
 
 bool ProtocolRegistry::InterceptProtocol(ProtocolType type,
@@ -5,10 +5,14 @@
 #ifndef ELECTRON_SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 #define ELECTRON_SHELL_BROWSER_PROTOCOL_REGISTRY_H_
 
+#include <map>
 #include <string>
 
+#include "base/containers/flat_map.h"
 #include "content/public/browser/content_browser_client.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "shell/browser/net/electron_url_loader_factory.h"
+#include "shell/browser/net/protocol_response_cache.h"
 
 namespace content {
 class BrowserContext;
@@ -32,15 +36,30 @@ class ProtocolRegistry {
   mojo::PendingRemote<network::mojom::URLLoaderFactory>
   CreateNonNetworkNavigationURLLoaderFactory(const std::string& scheme);
 
+  // Returns a new connection to the factory of the registered |scheme|.
+  mojo::PendingRemote<network::mojom::URLLoaderFactory> GetURLLoaderFactory(
+      const std::string& scheme);
+
   const HandlersMap& intercept_handlers() const { return intercept_handlers_; }
   const HandlersMap& handlers() const { return handlers_; }
 
   bool RegisterProtocol(ProtocolType type,
                         const std::string& scheme,
                         const ProtocolHandler& handler);
+  // Serves |scheme| with a factory implemented outside of this process, like
+  // by the handler of a utility process.
+  bool RegisterProtocolFactory(
+      const std::string& scheme,
+      mojo::PendingRemote<network::mojom::URLLoaderFactory> factory);
   bool UnregisterProtocol(const std::string& scheme);
   bool IsProtocolRegistered(const std::string& scheme);
 
+  // Caches the responses of the handler registered for |scheme|, for every
+  // renderer of the session, until it is unregistered.
+  bool EnableResponseCache(const std::string& scheme);
+  scoped_refptr<ProtocolResponseCache> GetResponseCache(
+      const std::string& scheme) const;
+
   bool InterceptProtocol(ProtocolType type,
                          const std::string& scheme,
                          const ProtocolHandler& handler);
@@ -54,6 +73,16 @@ class ProtocolRegistry {
 
   HandlersMap handlers_;
   HandlersMap intercept_handlers_;
+
+  // scheme => cache, for the registered schemes that use one.
+  std::map<std::string, scoped_refptr<ProtocolResponseCache>>
+      response_caches_;
+
+  // scheme => factory, shared by every frame and renderer of the session
+  // instead of creating one per scheme each time a frame needs factories.
+  // The schemes registered with RegisterProtocolFactory() only have one here.
+  base::flat_map<std::string, mojo::Remote<network::mojom::URLLoaderFactory>>
+      factories_;
 };
 
 }  // namespace electron
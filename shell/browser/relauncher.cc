@@ -14,10 +14,13 @@
 #include "base/logging.h"
 #include "base/path_service.h"
 #include "base/process/launch.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
 #include "content/public/common/content_paths.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/main_function_params.h"
 #include "shell/common/electron_command_line.h"
+#include "shell/common/startup_metrics.h"
 
 #if BUILDFLAG(IS_POSIX)
 #include "base/posix/eintr_wrapper.h"
@@ -98,6 +101,18 @@ bool RelaunchAppWithHelper(const base::FilePath& helper,
 #endif
 
   base::LaunchOptions options;
+  // The new instance reports how long it took to come up since the relaunch
+  // was requested, see app.getStartupMetrics().
+  const double relaunch_time =
+      base::Time::Now().InMillisecondsFSinceUnixEpoch();
+#if BUILDFLAG(IS_WIN)
+  options.environment[base::ASCIIToWide(
+      electron::startup_metrics::kRelaunchTimeEnvVar)] =
+      base::NumberToWString(relaunch_time);
+#else
+  options.environment[electron::startup_metrics::kRelaunchTimeEnvVar] =
+      base::NumberToString(relaunch_time);
+#endif
 #if BUILDFLAG(IS_POSIX)
   options.fds_to_remap.emplace_back(pipe_write_fd.get(),
                                     internal::kRelauncherSyncFD);
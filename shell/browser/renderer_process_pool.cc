@@ -0,0 +1,144 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/renderer_process_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/functional/bind.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+
+namespace electron {
+
+RendererProcessPool::RendererProcessPool(
+    content::BrowserContext* browser_context)
+    : browser_context_(browser_context) {
+  power_policy_observation_.Observe(PowerPolicy::GetInstance());
+}
+
+RendererProcessPool::~RendererProcessPool() {
+  while (!site_instances_.empty())
+    ShutdownLast();
+}
+
+void RendererProcessPool::Configure(size_t size,
+                                    const RendererProcessPreferences& prefs) {
+  // Processes launched for other preferences are of no use anymore.
+  const size_t keep = prefs == prefs_ ? size : 0;
+  while (site_instances_.size() > keep)
+    ShutdownLast();
+
+  size_ = size;
+  prefs_ = prefs;
+  ScheduleFill();
+}
+
+scoped_refptr<content::SiteInstance> RendererProcessPool::Take(
+    const RendererProcessPreferences& prefs) {
+  if (site_instances_.empty() || prefs != prefs_)
+    return nullptr;
+
+  // The oldest process is the most likely to have finished starting.
+  auto site_instance = std::move(site_instances_.front());
+  site_instances_.erase(site_instances_.begin());
+  site_instance->GetProcess()->RemoveObserver(this);
+  ScheduleFill();
+  return site_instance;
+}
+
+bool RendererProcessPool::AppendCommandLineSwitches(
+    int process_id,
+    base::CommandLine* command_line) const {
+  const bool pooled = std::any_of(
+      site_instances_.begin(), site_instances_.end(),
+      [process_id](const auto& site_instance) {
+        return site_instance->HasProcess() &&
+               site_instance->GetProcess()->GetID() == process_id;
+      });
+  if (pooled)
+    prefs_.AppendCommandLineSwitches(command_line);
+  return pooled;
+}
+
+void RendererProcessPool::ScheduleFill() {
+  if (fill_scheduled_ || site_instances_.size() >= size_)
+    return;
+  // The processes that are launched already are kept, but no more are
+  // launched while the power policy pauses the pools.
+  if (PowerPolicy::GetInstance()->actions().pause_renderer_process_pools)
+    return;
+  fill_scheduled_ = true;
+  // Launching processes competes with the window that was just created.
+  content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+      ->PostTask(FROM_HERE, base::BindOnce(&RendererProcessPool::Fill,
+                                           weak_factory_.GetWeakPtr()));
+}
+
+void RendererProcessPool::Fill() {
+  TRACE_EVENT0("electron", "RendererProcessPool::Fill");
+  fill_scheduled_ = false;
+  if (PowerPolicy::GetInstance()->actions().pause_renderer_process_pools)
+    return;
+  while (site_instances_.size() < size_) {
+    auto site_instance = content::SiteInstance::Create(browser_context_);
+    content::RenderProcessHost* host = site_instance->GetProcess();
+    // An existing process was reused, e.g. because the process limit was
+    // reached, so it was not launched with the switches of the pool.
+    if (host->IsInitializedAndNotDead())
+      return;
+
+    // Added before launching, so that AppendCommandLineSwitches() finds it.
+    site_instances_.push_back(site_instance);
+    host->AddObserver(this);
+    if (!host->Init()) {
+      Remove(host);
+      return;
+    }
+  }
+}
+
+void RendererProcessPool::ShutdownLast() {
+  scoped_refptr<content::SiteInstance> site_instance =
+      std::move(site_instances_.back());
+  site_instances_.pop_back();
+  if (!site_instance->HasProcess())
+    return;
+  content::RenderProcessHost* host = site_instance->GetProcess();
+  host->RemoveObserver(this);
+  site_instance.reset();
+  // Without frames the host is deleted once nothing refers to it anymore.
+  host->Cleanup();
+}
+
+void RendererProcessPool::Remove(content::RenderProcessHost* host) {
+  host->RemoveObserver(this);
+  std::erase_if(site_instances_, [host](const auto& site_instance) {
+    return !site_instance->HasProcess() || site_instance->GetProcess() == host;
+  });
+}
+
+void RendererProcessPool::RenderProcessExited(
+    content::RenderProcessHost* host,
+    const content::ChildProcessTerminationInfo& info) {
+  // Not refilled right away, so that a process crashing on launch is not
+  // relaunched in a loop. The next Take() refills the pool.
+  Remove(host);
+}
+
+void RendererProcessPool::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  Remove(host);
+}
+
+void RendererProcessPool::OnPowerPolicyChanged() {
+  ScheduleFill();
+}
+
+}  // namespace electron
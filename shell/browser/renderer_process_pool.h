@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_RENDERER_PROCESS_POOL_H_
+#define ELECTRON_SHELL_BROWSER_RENDERER_PROCESS_POOL_H_
+
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
+#include "content/public/browser/render_process_host_observer.h"
+#include "shell/browser/power_policy.h"
+#include "shell/browser/web_contents_preferences.h"
+
+namespace base {
+class CommandLine;
+}
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+}  // namespace content
+
+namespace electron {
+
+// Keeps renderer processes of a session launched ahead of time, so that new
+// windows don't wait for one to start. Like Chromium's spare renderer, but
+// several processes can be kept and they are launched with the command line
+// of the webPreferences they are meant for.
+// See session.setRendererProcessPool().
+class RendererProcessPool : public content::RenderProcessHostObserver,
+                            public PowerPolicy::Observer {
+ public:
+  explicit RendererProcessPool(content::BrowserContext* browser_context);
+  ~RendererProcessPool() override;
+
+  // disable copy
+  RendererProcessPool(const RendererProcessPool&) = delete;
+  RendererProcessPool& operator=(const RendererProcessPool&) = delete;
+
+  // Keeps |size| processes launched for main frames with |prefs|, processes
+  // launched for other preferences are shut down.
+  void Configure(size_t size, const RendererProcessPreferences& prefs);
+
+  // Returns the SiteInstance of a launched process matching |prefs|, or null
+  // when there is none. The pool is refilled in the background.
+  scoped_refptr<content::SiteInstance> Take(
+      const RendererProcessPreferences& prefs);
+
+  // Appends the switches of |process_id| if it is launched by the pool.
+  bool AppendCommandLineSwitches(int process_id,
+                                 base::CommandLine* command_line) const;
+
+  size_t size() const { return size_; }
+  size_t available() const { return site_instances_.size(); }
+
+ private:
+  void Fill();
+  void ScheduleFill();
+  void ShutdownLast();
+  void Remove(content::RenderProcessHost* host);
+
+  // content::RenderProcessHostObserver:
+  void RenderProcessExited(
+      content::RenderProcessHost* host,
+      const content::ChildProcessTerminationInfo& info) override;
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+  // PowerPolicy::Observer:
+  void OnPowerPolicyChanged() override;
+
+  raw_ptr<content::BrowserContext> browser_context_;
+  size_t size_ = 0;
+  RendererProcessPreferences prefs_;
+  std::vector<scoped_refptr<content::SiteInstance>> site_instances_;
+  bool fill_scheduled_ = false;
+
+  base::ScopedObservation<PowerPolicy, PowerPolicy::Observer>
+      power_policy_observation_{this};
+
+  base::WeakPtrFactory<RendererProcessPool> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_RENDERER_PROCESS_POOL_H_
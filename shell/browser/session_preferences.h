@@ -5,10 +5,12 @@
 #ifndef ELECTRON_SHELL_BROWSER_SESSION_PREFERENCES_H_
 #define ELECTRON_SHELL_BROWSER_SESSION_PREFERENCES_H_
 
+#include <optional>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/supports_user_data.h"
+#include "shell/browser/hidden_page_throttler.h"
 
 namespace content {
 class BrowserContext;
@@ -32,6 +34,17 @@ class SessionPreferences : public base::SupportsUserData::Data {
   }
   const std::vector<base::FilePath>& preloads() const { return preloads_; }
 
+  // The policy of the hidden pages of the session that have none of their
+  // own.
+  void set_background_throttling_policy(
+      std::optional<BackgroundThrottlingPolicy> policy) {
+    background_throttling_policy_ = policy;
+  }
+  const std::optional<BackgroundThrottlingPolicy>&
+  background_throttling_policy() const {
+    return background_throttling_policy_;
+  }
+
  private:
   SessionPreferences();
 
@@ -39,6 +52,7 @@ class SessionPreferences : public base::SupportsUserData::Data {
   static int kLocatorKey;
 
   std::vector<base::FilePath> preloads_;
+  std::optional<BackgroundThrottlingPolicy> background_throttling_policy_;
 };
 
 }  // namespace electron
@@ -0,0 +1,69 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/shared_buffer_broker.h"
+
+#include <utility>
+
+#include "base/containers/contains.h"
+#include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace electron {
+
+SharedBufferBroker::Buffer::Buffer() = default;
+SharedBufferBroker::Buffer::Buffer(Buffer&&) = default;
+SharedBufferBroker::Buffer& SharedBufferBroker::Buffer::operator=(Buffer&&) =
+    default;
+SharedBufferBroker::Buffer::~Buffer() = default;
+
+// static
+SharedBufferBroker* SharedBufferBroker::GetInstance() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static base::NoDestructor<SharedBufferBroker> instance;
+  return instance.get();
+}
+
+SharedBufferBroker::SharedBufferBroker() = default;
+
+SharedBufferBroker::~SharedBufferBroker() = default;
+
+bool SharedBufferBroker::Set(const std::string& name,
+                             base::span<const uint8_t> data,
+                             std::vector<url::Origin> origins) {
+  TRACE_EVENT1("electron", "SharedBufferBroker::Set", "size", data.size());
+  base::MappedReadOnlyRegion region =
+      base::ReadOnlySharedMemoryRegion::Create(data.size());
+  if (!region.IsValid())
+    return false;
+  region.mapping.GetMemoryAsSpan<uint8_t>().copy_from(data);
+
+  // The writable mapping is dropped, so that the data can't change once the
+  // renderers mapped it. The ones that mapped the previous region of |name|
+  // keep it until they let go of it.
+  Buffer buffer;
+  buffer.region = std::move(region.region);
+  buffer.origins = std::move(origins);
+  buffers_[name] = std::move(buffer);
+  return true;
+}
+
+void SharedBufferBroker::Delete(const std::string& name) {
+  buffers_.erase(name);
+}
+
+base::ReadOnlySharedMemoryRegion SharedBufferBroker::DuplicateRegion(
+    const std::string& name,
+    const url::Origin& origin) const {
+  auto it = buffers_.find(name);
+  if (it == buffers_.end())
+    return {};
+  const Buffer& buffer = it->second;
+  if (!buffer.origins.empty() && !base::Contains(buffer.origins, origin))
+    return {};
+  return buffer.region.Duplicate();
+}
+
+}  // namespace electron
@@ -0,0 +1,70 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_SHARED_BUFFER_BROKER_H_
+#define ELECTRON_SHELL_BROWSER_SHARED_BUFFER_BROKER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "url/origin.h"
+
+namespace base {
+template <typename T>
+class NoDestructor;
+}
+
+namespace electron {
+
+// Owns the read-only shared memory regions published with
+// ipcMain.setSharedBuffer(), which renderers map instead of receiving a copy of
+// the data. Only used on the UI thread.
+class SharedBufferBroker {
+ public:
+  static SharedBufferBroker* GetInstance();
+
+  // disable copy
+  SharedBufferBroker(const SharedBufferBroker&) = delete;
+  SharedBufferBroker& operator=(const SharedBufferBroker&) = delete;
+
+  // Copies |data| into a new region published under |name|, replacing the
+  // previous one. Only the frames of |origins| can map it, or all of them when
+  // it is empty. Returns false when the region can't be allocated.
+  bool Set(const std::string& name,
+           base::span<const uint8_t> data,
+           std::vector<url::Origin> origins);
+  void Delete(const std::string& name);
+
+  // Returns a read-only handle to the region published under |name|, or an
+  // invalid one if there is none or a frame of |origin| can't map it.
+  base::ReadOnlySharedMemoryRegion DuplicateRegion(
+      const std::string& name,
+      const url::Origin& origin) const;
+
+ private:
+  friend class base::NoDestructor<SharedBufferBroker>;
+
+  struct Buffer {
+    Buffer();
+    Buffer(Buffer&&);
+    Buffer& operator=(Buffer&&);
+    ~Buffer();
+
+    base::ReadOnlySharedMemoryRegion region;
+    std::vector<url::Origin> origins;
+  };
+
+  SharedBufferBroker();
+  ~SharedBufferBroker();
+
+  base::flat_map<std::string, Buffer> buffers_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_SHARED_BUFFER_BROKER_H_
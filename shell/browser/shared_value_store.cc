@@ -0,0 +1,80 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/shared_value_store.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/no_destructor.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace electron {
+
+namespace {
+
+constexpr size_t kMinimumRegionSize = 64 * 1024;
+
+}  // namespace
+
+// static
+SharedValueStore* SharedValueStore::GetInstance() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static base::NoDestructor<SharedValueStore> instance;
+  return instance.get();
+}
+
+SharedValueStore::SharedValueStore() = default;
+
+SharedValueStore::~SharedValueStore() = default;
+
+void SharedValueStore::Set(const std::string& key,
+                           std::vector<uint8_t> value) {
+  values_[key] = std::move(value);
+  Publish();
+}
+
+void SharedValueStore::Delete(const std::string& key) {
+  if (values_.erase(key))
+    Publish();
+}
+
+base::ReadOnlySharedMemoryRegion SharedValueStore::DuplicateRegion() {
+  if (!region_.IsValid())
+    Publish();
+  return region_.region.Duplicate();
+}
+
+void SharedValueStore::Publish() {
+  TRACE_EVENT0("electron", "SharedValueStore::Publish");
+  const std::vector<uint8_t> payload = shared_values::EncodeValues(values_);
+  if (region_.IsValid() &&
+      shared_values::WritePayload(region_.mapping.GetMemoryAsSpan<uint8_t>(),
+                                  payload)) {
+    return;
+  }
+
+  // Leave room to grow so that a few more values don't force another move.
+  const size_t size = std::max(
+      kMinimumRegionSize,
+      base::bits::AlignUp(sizeof(shared_values::Header) + 2 * payload.size(),
+                          kMinimumRegionSize));
+  base::MappedReadOnlyRegion region =
+      base::ReadOnlySharedMemoryRegion::Create(size);
+  if (!region.IsValid()) {
+    LOG(ERROR) << "Failed to allocate shared memory for shared values";
+    return;
+  }
+  CHECK(shared_values::WritePayload(region.mapping.GetMemoryAsSpan<uint8_t>(),
+                                    payload));
+
+  // Renderers that mapped the old region will ask for the new one.
+  if (region_.IsValid())
+    shared_values::MarkSuperseded(region_.mapping.GetMemoryAsSpan<uint8_t>());
+  region_ = std::move(region);
+}
+
+}  // namespace electron
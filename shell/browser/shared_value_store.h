@@ -0,0 +1,55 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_SHARED_VALUE_STORE_H_
+#define ELECTRON_SHELL_BROWSER_SHARED_VALUE_STORE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/memory/read_only_shared_memory_region.h"
+#include "shell/common/shared_values.h"
+
+namespace base {
+template <typename T>
+class NoDestructor;
+}
+
+namespace electron {
+
+// Owns the shared memory region that backs ipcMain.setSharedValue(), see
+// shell/common/shared_values.h for its layout. Only used on the UI thread.
+class SharedValueStore {
+ public:
+  static SharedValueStore* GetInstance();
+
+  // disable copy
+  SharedValueStore(const SharedValueStore&) = delete;
+  SharedValueStore& operator=(const SharedValueStore&) = delete;
+
+  // |value| holds the V8-serialized value.
+  void Set(const std::string& key, std::vector<uint8_t> value);
+  void Delete(const std::string& key);
+
+  // Returns a read-only handle to the current region, for a renderer to map.
+  base::ReadOnlySharedMemoryRegion DuplicateRegion();
+
+ private:
+  friend class base::NoDestructor<SharedValueStore>;
+
+  SharedValueStore();
+  ~SharedValueStore();
+
+  // Rewrites the payload in place, or moves it into a larger region when it
+  // no longer fits.
+  void Publish();
+
+  shared_values::Values values_;
+  base::MappedReadOnlyRegion region_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_SHARED_VALUE_STORE_H_
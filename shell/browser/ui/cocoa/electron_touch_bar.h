@@ -35,6 +35,12 @@
     (const std::vector<gin_helper::PersistentDictionary>&)settings;
 - (void)refreshTouchBarItem:(NSTouchBar*)touchBar
                          id:(const std::string&)item_id;
+- (void)setLabel:(const std::string&)label
+    forItemWithID:(const std::string&)item_id
+       inTouchBar:(NSTouchBar*)touchBar;
+- (void)setSliderValue:(int)value
+         forItemWithID:(const std::string&)item_id
+            inTouchBar:(NSTouchBar*)touchBar;
 - (void)addNonDefaultTouchBarItems:
     (const std::vector<gin_helper::PersistentDictionary>&)items;
 - (void)setEscapeTouchBarItem:(gin_helper::PersistentDictionary)item
@@ -45,6 +51,8 @@
 - (NSTouchBarItemIdentifier)identifierFromID:(const std::string&)item_id
                                         type:(const std::string&)typere;
 - (bool)hasItemWithID:(const std::string&)item_id;
+- (NSArray*)itemsForIdentifier:(NSTouchBarItemIdentifier)identifier
+                    inTouchBar:(NSTouchBar*)touchBar;
 - (NSColor*)colorFromHexColorString:(const std::string&)colorString;
 
 // Selector actions
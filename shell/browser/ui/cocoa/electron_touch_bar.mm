@@ -238,6 +238,32 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
                withSettings:settings];
 }
 
+// Unlike refreshTouchBarItem, doesn't read the item's settings from JS, so
+// that the labels and sliders showing progress can be updated often.
+- (void)setLabel:(const std::string&)label
+    forItemWithID:(const std::string&)item_id
+       inTouchBar:(NSTouchBar*)touchBar {
+  auto identifier = [self identifierFromID:item_id type:"label"];
+  NSString* string_value = base::SysUTF8ToNSString(label);
+  for (NSCustomTouchBarItem* item in [self itemsForIdentifier:identifier
+                                                   inTouchBar:touchBar]) {
+    NSTextField* text_field = (NSTextField*)item.view;
+    if (![text_field.stringValue isEqualToString:string_value])
+      text_field.stringValue = string_value;
+  }
+}
+
+- (void)setSliderValue:(int)value
+         forItemWithID:(const std::string&)item_id
+            inTouchBar:(NSTouchBar*)touchBar {
+  auto identifier = [self identifierFromID:item_id type:"slider"];
+  for (NSSliderTouchBarItem* item in [self itemsForIdentifier:identifier
+                                                   inTouchBar:touchBar]) {
+    if (item.slider.doubleValue != value)
+      item.slider.doubleValue = value;
+  }
+}
+
 - (void)buttonAction:(id)sender {
   NSString* item_id =
       [NSString stringWithFormat:@"%ld", ((NSButton*)sender).tag];
@@ -334,6 +360,30 @@ static NSString* const ImageScrubberItemIdentifier = @"scrubber.image.item";
   return settings_.find(item_id) != settings_.end();
 }
 
+// Finds the item in |touchBar| and in the touch bars of its popovers and
+// groups.
+- (NSArray*)itemsForIdentifier:(NSTouchBarItemIdentifier)identifier
+                    inTouchBar:(NSTouchBar*)touchBar {
+  NSMutableArray* items = [NSMutableArray array];
+  if (!touchBar)
+    return items;
+  if (NSTouchBarItem* item = [touchBar itemForIdentifier:identifier])
+    [items addObject:item];
+  for (NSTouchBarItemIdentifier parent in touchBar.defaultItemIdentifiers) {
+    NSTouchBar* child = nil;
+    if ([parent hasPrefix:PopoverIdentifier]) {
+      child = ((NSPopoverTouchBarItem*)[touchBar itemForIdentifier:parent])
+                  .popoverTouchBar;
+    } else if ([parent hasPrefix:GroupIdentifier]) {
+      child = ((NSGroupTouchBarItem*)[touchBar itemForIdentifier:parent])
+                  .groupTouchBar;
+    }
+    [items addObjectsFromArray:[self itemsForIdentifier:identifier
+                                             inTouchBar:child]];
+  }
+  return items;
+}
+
 - (NSColor*)colorFromHexColorString:(const std::string&)colorString {
   SkColor color = electron::ParseCSSColor(colorString);
   return skia::SkColorToDeviceNSColor(color);
@@ -0,0 +1,87 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ui/draggable_region_index.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// The grid has at most kGridSize x kGridSize cells.
+constexpr int kGridSize = 32;
+
+// The values of a cell that is not partially covered.
+enum Cell : int32_t {
+  kEmptyCell = -1,
+  kFullCell = -2,
+};
+
+}  // namespace
+
+DraggableRegionIndex::DraggableRegionIndex(const SkRegion& region)
+    : region_(region) {}
+
+DraggableRegionIndex::~DraggableRegionIndex() = default;
+
+bool DraggableRegionIndex::Contains(int x, int y) const {
+  // Rectangular regions are cheap to test as they are.
+  if (region_.isEmpty() || region_.isRect())
+    return region_.contains(x, y);
+
+  const SkIRect& bounds = region_.getBounds();
+  if (!bounds.contains(x, y))
+    return false;
+
+  if (!grid_built_)
+    BuildGrid();
+  const int column = (x - bounds.left()) / cell_width_;
+  const int row = (y - bounds.top()) / cell_height_;
+  const int32_t cell = cells_[row * columns_ + column];
+  if (cell == kEmptyCell)
+    return false;
+  if (cell == kFullCell)
+    return true;
+  return partial_cells_[cell].contains(x, y);
+}
+
+void DraggableRegionIndex::BuildGrid() const {
+  TRACE_EVENT0("electron", "DraggableRegionIndex::BuildGrid");
+  const SkIRect& bounds = region_.getBounds();
+  cell_width_ = std::max(1, (bounds.width() + kGridSize - 1) / kGridSize);
+  cell_height_ = std::max(1, (bounds.height() + kGridSize - 1) / kGridSize);
+  columns_ = (bounds.width() + cell_width_ - 1) / cell_width_;
+  const int rows = (bounds.height() + cell_height_ - 1) / cell_height_;
+
+  cells_.resize(columns_ * rows);
+  for (int row = 0; row < rows; ++row) {
+    for (int column = 0; column < columns_; ++column) {
+      SkIRect cell_rect = SkIRect::MakeXYWH(
+          bounds.left() + column * cell_width_,
+          bounds.top() + row * cell_height_, cell_width_, cell_height_);
+      // The last row and column can overflow the bounds.
+      cell_rect.intersect(bounds);
+      SkRegion cell_region;
+      cell_region.op(region_, cell_rect, SkRegion::kIntersect_Op);
+
+      int32_t& cell = cells_[row * columns_ + column];
+      if (cell_region.isEmpty()) {
+        cell = kEmptyCell;
+      } else if (cell_region.isRect() &&
+                 cell_region.getBounds() == cell_rect) {
+        cell = kFullCell;
+      } else {
+        cell = static_cast<int32_t>(partial_cells_.size());
+        partial_cells_.push_back(std::move(cell_region));
+      }
+    }
+  }
+  grid_built_ = true;
+}
+
+}  // namespace electron
@@ -0,0 +1,51 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_UI_DRAGGABLE_REGION_INDEX_H_
+#define ELECTRON_SHELL_BROWSER_UI_DRAGGABLE_REGION_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "third_party/skia/include/core/SkRegion.h"
+
+namespace electron {
+
+// Hit tests the draggable region of a page. SkRegion::contains() walks the
+// spans of the region, which shows up when the region is made of hundreds of
+// rects and the mouse moves over a frameless window. Instead the bounds of the
+// region are split into a grid whose cells are either fully draggable, not
+// draggable at all, or keep only the small part of the region they cover. The
+// grid is built by the first hit test, and the index is meant to be replaced
+// when the region changes.
+class DraggableRegionIndex {
+ public:
+  explicit DraggableRegionIndex(const SkRegion& region);
+  ~DraggableRegionIndex();
+
+  // disable copy
+  DraggableRegionIndex(const DraggableRegionIndex&) = delete;
+  DraggableRegionIndex& operator=(const DraggableRegionIndex&) = delete;
+
+  const SkRegion& region() const { return region_; }
+
+  bool Contains(int x, int y) const;
+
+ private:
+  void BuildGrid() const;
+
+  const SkRegion region_;
+
+  mutable bool grid_built_ = false;
+  mutable int cell_width_ = 0;
+  mutable int cell_height_ = 0;
+  mutable int columns_ = 0;
+  // Indices into |partial_cells_|, negative for empty and full cells.
+  mutable std::vector<int32_t> cells_;
+  mutable std::vector<SkRegion> partial_cells_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_UI_DRAGGABLE_REGION_INDEX_H_
@@ -16,7 +16,9 @@
 #include "shell/browser/ui/inspectable_web_contents_view_delegate.h"
 #include "ui/base/models/image_model.h"
 #include "ui/views/controls/label.h"
+#include "ui/views/controls/native/native_view_host.h"
 #include "ui/views/controls/webview/webview.h"
+#include "ui/views/view_utils.h"
 #include "ui/views/widget/widget.h"
 #include "ui/views/widget/widget_delegate.h"
 #include "ui/views/window/client_view.h"
@@ -207,6 +209,17 @@ const std::u16string InspectableWebContentsView::GetTitle() {
   return title_;
 }
 
+void InspectableWebContentsView::SetFastResize(bool fast_resize) {
+  auto* web_view = views::AsViewClass<views::WebView>(contents_web_view_);
+  if (!web_view || web_view->holder()->fast_resize() == fast_resize)
+    return;
+
+  web_view->SetFastResize(fast_resize);
+  // Lays out the native view again, this time resizing it.
+  if (!fast_resize)
+    web_view->holder()->InvalidateLayout();
+}
+
 void InspectableWebContentsView::Layout(PassKey) {
   if (!devtools_web_view_->GetVisible()) {
     contents_web_view_->SetBoundsRect(GetContentsBounds());
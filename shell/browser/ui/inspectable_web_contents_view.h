@@ -52,6 +52,10 @@ class InspectableWebContentsView : public views::View {
   void SetTitle(const std::u16string& title);
   const std::u16string GetTitle();
 
+  // In fast resize mode the web contents are moved and clipped instead of
+  // being resized, the real resize happens when the mode is turned off.
+  void SetFastResize(bool fast_resize);
+
   // views::View:
   void Layout(PassKey) override;
 #if BUILDFLAG(IS_MAC)
@@ -22,6 +22,78 @@
 #include "skia/ext/skia_utils_mac.h"
 #include "ui/gfx/image/image_skia.h"
 
+// Shows an NSAlert as a regular window, so waiting for its response does not
+// need [NSAlert runModal] and the nested run loop it spins.
+@interface ElectronModelessAlert : NSObject
+
+- (instancetype)initWithAlert:(NSAlert*)alert
+            completionHandler:(void (^)(NSModalResponse))handler;
+- (void)show;
+- (void)endWithResponse:(NSModalResponse)response;
++ (ElectronModelessAlert*)modelessAlertFor:(NSAlert*)alert;
+
+@end
+
+@implementation ElectronModelessAlert {
+  NSAlert* alert_;
+  void (^handler_)(NSModalResponse);
+}
+
+// The alerts being shown, which also keeps them alive.
++ (NSMutableArray<ElectronModelessAlert*>*)shownAlerts {
+  static NSMutableArray<ElectronModelessAlert*>* alerts =
+      [[NSMutableArray alloc] init];
+  return alerts;
+}
+
++ (ElectronModelessAlert*)modelessAlertFor:(NSAlert*)alert {
+  for (ElectronModelessAlert* shown in [self shownAlerts]) {
+    if (shown->alert_ == alert)
+      return shown;
+  }
+  return nil;
+}
+
+- (instancetype)initWithAlert:(NSAlert*)alert
+            completionHandler:(void (^)(NSModalResponse))handler {
+  if ((self = [super init])) {
+    alert_ = alert;
+    handler_ = [handler copy];
+    // The buttons would otherwise stop the modal session that isn't running.
+    for (NSButton* button in [alert buttons]) {
+      [button setTarget:self];
+      [button setAction:@selector(buttonClicked:)];
+    }
+  }
+  return self;
+}
+
+- (void)show {
+  [[ElectronModelessAlert shownAlerts] addObject:self];
+  [alert_ layout];
+  NSWindow* window = [alert_ window];
+  [window setLevel:NSModalPanelWindowLevel];
+  [window center];
+  [window makeKeyAndOrderFront:nil];
+}
+
+- (void)buttonClicked:(NSButton*)sender {
+  // The tags of the buttons are their indices, see CreateNSAlert.
+  [self endWithResponse:[sender tag]];
+}
+
+- (void)endWithResponse:(NSModalResponse)response {
+  if (!handler_)
+    return;
+  [[alert_ window] orderOut:nil];
+  auto handler = handler_;
+  handler_ = nil;
+  handler(response);
+  [[ElectronModelessAlert shownAlerts] removeObject:self];
+}
+
+@end
+
 namespace electron {
 
 MessageBoxSettings::MessageBoxSettings() = default;
@@ -141,50 +213,47 @@ void ShowMessageBox(const MessageBoxSettings& settings,
                     MessageBoxCallback callback) {
   NSAlert* alert = CreateNSAlert(settings);
 
-  // Use runModal for synchronous alert without parent, since we don't have a
-  // window to wait for.
-  if (!settings.parent_window) {
-    int ret = [alert runModal];
-    std::move(callback).Run(
-        ret, alert.suppressionButton.state == NSControlStateValueOn);
-  } else {
-    if (settings.id) {
-      if (base::Contains(GetDialogsMap(), *settings.id))
-        CloseMessageBox(*settings.id);
-      GetDialogsMap()[*settings.id] = alert;
-    }
+  if (settings.id) {
+    if (base::Contains(GetDialogsMap(), *settings.id))
+      CloseMessageBox(*settings.id);
+    GetDialogsMap()[*settings.id] = alert;
+  }
 
-    NSWindow* window =
-        settings.parent_window
-            ? settings.parent_window->GetNativeWindow().GetNativeNSWindow()
-            : nil;
-
-    // Duplicate the callback object here since c is a reference and gcd would
-    // only store the pointer, by duplication we can force gcd to store a copy.
-    __block MessageBoxCallback callback_ = std::move(callback);
-    __block std::optional<int> id = std::move(settings.id);
-    __block int cancel_id = settings.cancel_id;
-
-    auto handler = ^(NSModalResponse response) {
-      if (id)
-        GetDialogsMap().erase(*id);
-      // When the alert is cancelled programmatically, the response would be
-      // something like -1000. This currently only happens when users call
-      // CloseMessageBox API, and we should return cancelId as result.
-      if (response < 0)
-        response = cancel_id;
-      bool suppressed = alert.suppressionButton.state == NSControlStateValueOn;
-      // The completionHandler runs inside a transaction commit, and we should
-      // not do any runModal inside it. However since we can not control what
-      // users will run in the callback, we have to delay running the callback
-      // until next tick, otherwise crash like this may happen:
-      // https://github.com/electron/electron/issues/26884
-      content::GetUIThreadTaskRunner({})->PostTask(
-          FROM_HERE,
-          base::BindOnce(std::move(callback_), response, suppressed));
-    };
-    [alert beginSheetModalForWindow:window completionHandler:handler];
+  // Duplicate the callback object here since c is a reference and gcd would
+  // only store the pointer, by duplication we can force gcd to store a copy.
+  __block MessageBoxCallback callback_ = std::move(callback);
+  __block std::optional<int> id = std::move(settings.id);
+  __block int cancel_id = settings.cancel_id;
+
+  auto handler = ^(NSModalResponse response) {
+    if (id)
+      GetDialogsMap().erase(*id);
+    // When the alert is cancelled programmatically, the response would be
+    // something like -1000. This currently only happens when users call
+    // CloseMessageBox API, and we should return cancelId as result.
+    if (response < 0)
+      response = cancel_id;
+    bool suppressed = alert.suppressionButton.state == NSControlStateValueOn;
+    // The completionHandler runs inside a transaction commit, and we should
+    // not do any runModal inside it. However since we can not control what
+    // users will run in the callback, we have to delay running the callback
+    // until next tick, otherwise crash like this may happen:
+    // https://github.com/electron/electron/issues/26884
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback_), response, suppressed));
+  };
+
+  // Without a parent there is no window to attach a sheet to, show the alert
+  // on its own instead of running it modally so the main loop keeps going.
+  if (!settings.parent_window) {
+    [[[ElectronModelessAlert alloc] initWithAlert:alert
+                                completionHandler:handler] show];
+    return;
   }
+
+  NSWindow* window =
+      settings.parent_window->GetNativeWindow().GetNativeNSWindow();
+  [alert beginSheetModalForWindow:window completionHandler:handler];
 }
 
 void CloseMessageBox(int id) {
@@ -193,6 +262,11 @@ void CloseMessageBox(int id) {
     LOG(ERROR) << "CloseMessageBox called with nonexistent ID";
     return;
   }
+  if (ElectronModelessAlert* modeless =
+          [ElectronModelessAlert modelessAlertFor:it->second]) {
+    [modeless endWithResponse:NSModalResponseAbort];
+    return;
+  }
   [NSApp endSheet:it->second.window];
 }
 
@@ -4,6 +4,8 @@
 
 #include "shell/browser/ui/tray_icon.h"
 
+#include <utility>
+
 namespace electron {
 
 TrayIcon::BalloonOptions::BalloonOptions() = default;
@@ -14,6 +16,15 @@ TrayIcon::~TrayIcon() = default;
 
 void TrayIcon::SetPressedImage(ImageType image) {}
 
+void TrayIcon::SetImageSet(ImageSet images) {
+  image_set_ = std::move(images);
+}
+
+void TrayIcon::SetImageFromSet(size_t index) {
+  if (index < image_set_.size())
+    SetImage(image_set_[index]);
+}
+
 void TrayIcon::DisplayBalloon(const BalloonOptions& options) {}
 
 void TrayIcon::RemoveBalloon() {}
@@ -13,6 +13,7 @@
 #include "shell/browser/ui/tray_icon_observer.h"
 #include "shell/common/gin_converters/guid_converter.h"
 #include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/image/image.h"
 
 namespace electron {
 
@@ -22,8 +23,10 @@ class TrayIcon {
 
 #if BUILDFLAG(IS_WIN)
   using ImageType = HICON;
+  using ImageSet = std::vector<HICON>;
 #else
   using ImageType = const gfx::Image&;
+  using ImageSet = std::vector<gfx::Image>;
 #endif
 
   virtual ~TrayIcon();
@@ -38,6 +41,13 @@ class TrayIcon {
   // Sets the image associated with this status icon when pressed.
   virtual void SetPressedImage(ImageType image);
 
+  // Registers the images that SetImageFromSet() switches between, so that
+  // those that need a platform conversion are only converted once.
+  virtual void SetImageSet(ImageSet images);
+
+  // Sets the image at |index| of the image set as the status icon image.
+  virtual void SetImageFromSet(size_t index);
+
   // Sets the hover text for this status icon. This is also used as the label
   // for the menu item which is created as a replacement for the status icon
   // click action on platforms that do not support custom click actions for the
@@ -134,6 +144,8 @@ class TrayIcon {
 
  private:
   base::ObserverList<TrayIconObserver> observers_;
+
+  ImageSet image_set_;
 };
 
 }  // namespace electron
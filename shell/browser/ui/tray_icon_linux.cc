@@ -44,6 +44,21 @@ void TrayIconLinux::SetImage(const gfx::Image& image) {
     status_icon->SetIcon(image_);
 }
 
+void TrayIconLinux::SetImageSet(ImageSet images) {
+  image_set_.clear();
+  image_set_.reserve(images.size());
+  for (const auto& image : images)
+    image_set_.push_back(GetBestImageRep(image.AsImageSkia()));
+}
+
+void TrayIconLinux::SetImageFromSet(size_t index) {
+  if (index >= image_set_.size())
+    return;
+  image_ = image_set_[index];
+  if (auto* status_icon = GetStatusIcon())
+    status_icon->SetIcon(image_);
+}
+
 void TrayIconLinux::SetToolTip(const std::string& tool_tip) {
   tool_tip_ = base::UTF8ToUTF16(tool_tip);
   if (auto* status_icon = GetStatusIcon())
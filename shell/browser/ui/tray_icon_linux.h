@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "shell/browser/ui/tray_icon.h"
 #include "ui/linux/status_icon_linux.h"
@@ -24,6 +25,8 @@ class TrayIconLinux : public TrayIcon, public ui::StatusIconLinux::Delegate {
 
   // TrayIcon:
   void SetImage(const gfx::Image& image) override;
+  void SetImageSet(ImageSet images) override;
+  void SetImageFromSet(size_t index) override;
   void SetToolTip(const std::string& tool_tip) override;
   void SetContextMenu(raw_ptr<ElectronMenuModel> menu_model) override;
 
@@ -49,6 +52,8 @@ class TrayIconLinux : public TrayIcon, public ui::StatusIconLinux::Delegate {
   StatusIconType status_icon_type_;
 
   gfx::ImageSkia image_;
+  // The best representations of the image set, picked once.
+  std::vector<gfx::ImageSkia> image_set_;
   std::u16string tool_tip_;
   raw_ptr<ui::MenuModel> menu_model_ = nullptr;
 };
@@ -6,14 +6,20 @@
 
 #include "shell/browser/ui/views/win_caption_button.h"
 
+#include <tuple>
 #include <utility>
 
+#include "base/containers/lru_cache.h"
 #include "base/i18n/rtl.h"
+#include "base/no_destructor.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/win/windows_version.h"
+#include "cc/paint/paint_image.h"
+#include "cc/paint/skia_paint_canvas.h"
 #include "chrome/grit/theme_resources.h"
 #include "shell/browser/ui/views/win_frame_view.h"
 #include "shell/common/color_util.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/base/metadata/metadata_impl_macros.h"
 #include "ui/base/theme_provider.h"
 #include "ui/gfx/animation/tween.h"
@@ -23,6 +29,22 @@
 
 namespace electron {
 
+namespace {
+
+// The button type, the symbol color and the device scale factor.
+using SymbolKey = std::tuple<int, SkColor, float>;
+
+// The rasterized symbols, shared by the caption buttons of all windows so
+// that a theme or DPI change rasterizes each of them once. Only a few colors
+// are used at a time, the cache is bounded for the apps that change them.
+base::LRUCache<SymbolKey, cc::PaintImage>& GetSymbolCache() {
+  static base::NoDestructor<base::LRUCache<SymbolKey, cc::PaintImage>> cache(
+      32);
+  return *cache;
+}
+
+}  // namespace
+
 WinCaptionButton::WinCaptionButton(PressedCallback callback,
                                    WinFrameView* frame_view,
                                    ViewID button_type,
@@ -170,6 +192,36 @@ void WinCaptionButton::PaintSymbol(gfx::Canvas* canvas) {
   symbol_rect.ClampToCenteredSize(
       gfx::Size(symbol_size_pixels, symbol_size_pixels));
 
+  // The color of the close symbol changes on every frame of the hover
+  // animation, which is not worth caching.
+  if (button_type_ == VIEW_ID_CLOSE_BUTTON &&
+      hover_animation().is_animating()) {
+    PaintSymbolIcon(canvas, symbol_rect, symbol_color, scale);
+    return;
+  }
+
+  auto& cache = GetSymbolCache();
+  const SymbolKey key(button_type_, symbol_color, scale);
+  auto it = cache.Get(key);
+  if (it == cache.end()) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(symbol_rect.width(), symbol_rect.height());
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    cc::SkiaPaintCanvas paint_canvas(bitmap);
+    gfx::Canvas symbol_canvas(&paint_canvas, scale);
+    PaintSymbolIcon(&symbol_canvas, gfx::Rect(symbol_rect.size()),
+                    symbol_color, scale);
+    bitmap.setImmutable();
+    it = cache.Put(key, cc::PaintImage::CreateFromBitmap(std::move(bitmap)));
+  }
+  canvas->sk_canvas()->drawImage(it->second, symbol_rect.x(),
+                                 symbol_rect.y());
+}
+
+void WinCaptionButton::PaintSymbolIcon(gfx::Canvas* canvas,
+                                       const gfx::Rect& symbol_rect,
+                                       SkColor symbol_color,
+                                       float scale) {
   cc::PaintFlags flags;
   flags.setAntiAlias(false);
   flags.setColor(symbol_color);
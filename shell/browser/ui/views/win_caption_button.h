@@ -62,6 +62,12 @@ class WinCaptionButton : public views::Button {
   // Paints the minimize/maximize/restore/close icon for the button.
   void PaintSymbol(gfx::Canvas* canvas);
 
+  // Paints the icon in |symbol_rect|, in pixels.
+  void PaintSymbolIcon(gfx::Canvas* canvas,
+                       const gfx::Rect& symbol_rect,
+                       SkColor symbol_color,
+                       float scale);
+
   raw_ptr<WinFrameView> frame_view_;
   std::unique_ptr<WinIconPainter> icon_painter_;
   ViewID button_type_;
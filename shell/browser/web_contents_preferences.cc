@@ -82,8 +82,92 @@ std::vector<WebContentsPreferences*>& Instances() {
   static base::NoDestructor<std::vector<WebContentsPreferences*>> g_instances;
   return *g_instances;
 }
+
+bool IsSandboxedByDefault(bool node_integration,
+                          bool node_integration_in_worker) {
+  return !node_integration && !node_integration_in_worker;
+}
 }  // namespace
 
+RendererProcessPreferences::RendererProcessPreferences() = default;
+RendererProcessPreferences::RendererProcessPreferences(
+    const RendererProcessPreferences&) = default;
+RendererProcessPreferences& RendererProcessPreferences::operator=(
+    const RendererProcessPreferences&) = default;
+RendererProcessPreferences::~RendererProcessPreferences() = default;
+
+// static
+RendererProcessPreferences RendererProcessPreferences::FromDictionary(
+    const gin_helper::Dictionary& web_preferences) {
+  // Keep in sync with WebContentsPreferences::SetFromDictionary.
+  RendererProcessPreferences prefs;
+  bool node_integration = false;
+  web_preferences.Get(options::kNodeIntegration, &node_integration);
+  web_preferences.Get(options::kNodeIntegrationInWorker,
+                      &prefs.node_integration_in_worker);
+  if (!web_preferences.Get(options::kSandbox, &prefs.sandbox)) {
+    prefs.sandbox = IsSandboxedByDefault(node_integration,
+                                         prefs.node_integration_in_worker);
+  }
+  web_preferences.Get(options::kExperimentalFeatures,
+                      &prefs.experimental_features);
+#if BUILDFLAG(IS_MAC)
+  web_preferences.Get(options::kScrollBounce, &prefs.scroll_bounce);
+#endif
+  web_preferences.Get(options::kCustomArgs, &prefs.custom_args);
+  web_preferences.Get("commandLineSwitches", &prefs.custom_switches);
+  std::string blink_features;
+  if (web_preferences.Get(options::kEnableBlinkFeatures, &blink_features))
+    prefs.enable_blink_features = blink_features;
+  if (web_preferences.Get(options::kDisableBlinkFeatures, &blink_features))
+    prefs.disable_blink_features = blink_features;
+  return prefs;
+}
+
+bool RendererProcessPreferences::operator==(
+    const RendererProcessPreferences&) const = default;
+
+void RendererProcessPreferences::AppendCommandLineSwitches(
+    base::CommandLine* command_line) const {
+  // Experimental flags.
+  if (experimental_features)
+    command_line->AppendSwitch(
+        ::switches::kEnableExperimentalWebPlatformFeatures);
+
+  if (sandbox) {
+    command_line->AppendSwitch(switches::kEnableSandbox);
+  } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
+    command_line->AppendSwitch(sandbox::policy::switches::kNoSandbox);
+    command_line->AppendSwitch(::switches::kNoZygote);
+  }
+
+#if BUILDFLAG(IS_MAC)
+  // Enable scroll bounce.
+  if (scroll_bounce)
+    command_line->AppendSwitch(switches::kScrollBounce);
+#endif
+
+  // Custom args for renderer process
+  for (const auto& arg : custom_args)
+    if (!arg.empty())
+      command_line->AppendArg(arg);
+
+  // Custom command line switches.
+  for (const auto& arg : custom_switches)
+    if (!arg.empty())
+      command_line->AppendSwitch(arg);
+
+  if (enable_blink_features)
+    command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures,
+                                    *enable_blink_features);
+  if (disable_blink_features)
+    command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures,
+                                    *disable_blink_features);
+
+  if (node_integration_in_worker)
+    command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
+}
+
 WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const gin_helper::Dictionary& web_preferences)
@@ -117,6 +201,7 @@ void WebContentsPreferences::Clear() {
   node_integration_ = false;
   node_integration_in_sub_frames_ = false;
   node_integration_in_worker_ = false;
+  lazy_node_integration_ = false;
   disable_html_fullscreen_window_resize_ = false;
   webview_tag_ = false;
   sandbox_ = std::nullopt;
@@ -151,6 +236,7 @@ void WebContentsPreferences::Clear() {
   image_animation_policy_ =
       blink::mojom::ImageAnimationPolicy::kImageAnimationPolicyAllowed;
   preload_path_ = std::nullopt;
+  process_group_ = std::nullopt;
   v8_cache_options_ = blink::mojom::V8CacheOptions::kDefault;
 
 #if BUILDFLAG(IS_MAC)
@@ -172,6 +258,7 @@ void WebContentsPreferences::SetFromDictionary(
                       &node_integration_in_sub_frames_);
   web_preferences.Get(options::kNodeIntegrationInWorker,
                       &node_integration_in_worker_);
+  web_preferences.Get(options::kLazyNodeIntegration, &lazy_node_integration_);
   web_preferences.Get(options::kDisableHtmlFullscreenWindowResize,
                       &disable_html_fullscreen_window_resize_);
   web_preferences.Get(options::kWebviewTag, &webview_tag_);
@@ -192,7 +279,12 @@ void WebContentsPreferences::SetFromDictionary(
                            &allow_running_insecure_content_) &&
       !web_security_)
     allow_running_insecure_content_ = true;
-  web_preferences.Get(options::kOffscreen, &offscreen_);
+  // |offscreen| is either a boolean or an object of offscreen options
+  gin_helper::Dictionary offscreen;
+  if (web_preferences.Get(options::kOffscreen, &offscreen))
+    offscreen_ = true;
+  else
+    web_preferences.Get(options::kOffscreen, &offscreen_);
   web_preferences.Get(options::kNavigateOnDragDrop, &navigate_on_drag_drop_);
   web_preferences.Get("autoplayPolicy", &autoplay_policy_);
   web_preferences.Get("defaultFontFamily", &default_font_family_);
@@ -243,6 +335,11 @@ void WebContentsPreferences::SetFromDictionary(
     }
   }
 
+  std::string process_group;
+  if (web_preferences.Get("processGroup", &process_group) &&
+      !process_group.empty())
+    process_group_ = process_group;
+
   std::string type;
   if (web_preferences.Get(options::kType, &type)) {
     is_webview_ = type == "webview";
@@ -259,6 +356,7 @@ void WebContentsPreferences::SetFromDictionary(
 #endif
 
   SaveLastPreferences();
+  UpdateRendererProcessPreferences();
 }
 
 bool WebContentsPreferences::GetSafeDialogsMessage(std::string* message) const {
@@ -298,9 +396,7 @@ bool WebContentsPreferences::GetPreloadPath(base::FilePath* path) const {
 bool WebContentsPreferences::IsSandboxed() const {
   if (sandbox_)
     return *sandbox_;
-  bool sandbox_disabled_by_default =
-      node_integration_ || node_integration_in_worker_;
-  return !sandbox_disabled_by_default;
+  return IsSandboxedByDefault(node_integration_, node_integration_in_worker_);
 }
 
 // static
@@ -315,6 +411,41 @@ content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
   return nullptr;
 }
 
+// static
+content::WebContents* WebContentsPreferences::GetWebContentsInProcessGroup(
+    content::BrowserContext* browser_context,
+    const std::string& process_group,
+    const RendererProcessPreferences& prefs) {
+  for (WebContentsPreferences* preferences : Instances()) {
+    content::WebContents* web_contents = preferences->web_contents_;
+    if (preferences->process_group_ == process_group &&
+        !preferences->is_webview_ &&
+        web_contents->GetBrowserContext() == browser_context &&
+        web_contents->GetPrimaryMainFrame()
+            ->GetProcess()
+            ->IsInitializedAndNotDead() &&
+        preferences->GetRendererProcessPreferences(false) == prefs)
+      return web_contents;
+  }
+  return nullptr;
+}
+
+// static
+scoped_refptr<const WebContentsPreferences::SharedRendererProcessPreferences>
+WebContentsPreferences::ShareRendererProcessPreferences(
+    RendererProcessPreferences prefs) {
+  for (WebContentsPreferences* preferences : Instances()) {
+    for (const SharedRendererProcessPreferences* shared :
+         {preferences->main_frame_process_preferences_.get(),
+          preferences->subframe_process_preferences_.get()}) {
+      if (shared && shared->data == prefs)
+        return base::WrapRefCounted(shared);
+    }
+  }
+  return base::MakeRefCounted<SharedRendererProcessPreferences>(
+      std::move(prefs));
+}
+
 // static
 WebContentsPreferences* WebContentsPreferences::From(
     content::WebContents* web_contents) {
@@ -326,53 +457,42 @@ WebContentsPreferences* WebContentsPreferences::From(
 void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
     bool is_subframe) {
-  // Experimental flags.
-  if (experimental_features_)
-    command_line->AppendSwitch(
-        ::switches::kEnableExperimentalWebPlatformFeatures);
+  // The snapshot of the preferences is already taken when they are set.
+  GetRendererProcessPreferences(is_subframe)
+      .AppendCommandLineSwitches(command_line);
+}
 
+const RendererProcessPreferences&
+WebContentsPreferences::GetRendererProcessPreferences(bool is_subframe) const {
+  return is_subframe ? subframe_process_preferences_->data
+                     : main_frame_process_preferences_->data;
+}
+
+RendererProcessPreferences
+WebContentsPreferences::ComputeRendererProcessPreferences(
+    bool is_subframe) const {
+  RendererProcessPreferences prefs;
   // Sandbox can be enabled for renderer processes hosting cross-origin frames
   // unless nodeIntegrationInSubFrames is enabled
   bool can_sandbox_frame = is_subframe && !node_integration_in_sub_frames_;
-
-  if (IsSandboxed() || can_sandbox_frame) {
-    command_line->AppendSwitch(switches::kEnableSandbox);
-  } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
-    command_line->AppendSwitch(sandbox::policy::switches::kNoSandbox);
-    command_line->AppendSwitch(::switches::kNoZygote);
-  }
-
+  prefs.sandbox = IsSandboxed() || can_sandbox_frame;
+  prefs.experimental_features = experimental_features_;
+  prefs.node_integration_in_worker = node_integration_in_worker_;
 #if BUILDFLAG(IS_MAC)
-  // Enable scroll bounce.
-  if (scroll_bounce_)
-    command_line->AppendSwitch(switches::kScrollBounce);
+  prefs.scroll_bounce = scroll_bounce_;
 #endif
+  prefs.custom_args = custom_args_;
+  prefs.custom_switches = custom_switches_;
+  prefs.enable_blink_features = enable_blink_features_;
+  prefs.disable_blink_features = disable_blink_features_;
+  return prefs;
+}
 
-  // Custom args for renderer process
-  for (const auto& arg : custom_args_)
-    if (!arg.empty())
-      command_line->AppendArg(arg);
-
-  // Custom command line switches.
-  for (const auto& arg : custom_switches_)
-    if (!arg.empty())
-      command_line->AppendSwitch(arg);
-
-  if (enable_blink_features_)
-    command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures,
-                                    *enable_blink_features_);
-  if (disable_blink_features_)
-    command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures,
-                                    *disable_blink_features_);
-
-  if (node_integration_in_worker_)
-    command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
-
-  // We are appending args to a webContents so let's save the current state
-  // of our preferences object so that during the lifetime of the WebContents
-  // we can fetch the options used to initially configure the WebContents
-  // last_preference_ = preference_.Clone();
-  SaveLastPreferences();
+void WebContentsPreferences::UpdateRendererProcessPreferences() {
+  main_frame_process_preferences_ =
+      ShareRendererProcessPreferences(ComputeRendererProcessPreferences(false));
+  subframe_process_preferences_ =
+      ShareRendererProcessPreferences(ComputeRendererProcessPreferences(true));
 }
 
 void WebContentsPreferences::SaveLastPreferences() {
@@ -486,6 +606,14 @@ void WebContentsPreferences::OverrideWebkitPrefs(
   prefs->node_integration = node_integration_;
   prefs->node_integration_in_worker = node_integration_in_worker_;
   prefs->node_integration_in_sub_frames = node_integration_in_sub_frames_;
+  // The page can only trigger the creation of the environment through the
+  // Node.js globals, and preload scripts have to run before the page.
+  auto* session_preferences =
+      SessionPreferences::FromBrowserContext(web_contents_->GetBrowserContext());
+  prefs->lazy_node_integration =
+      lazy_node_integration_ && node_integration_ && !context_isolation_ &&
+      !preload_path_ &&
+      (!session_preferences || session_preferences->preloads().empty());
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   prefs->enable_spellcheck = spellcheck_;
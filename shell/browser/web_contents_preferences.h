@@ -6,10 +6,13 @@
 #define ELECTRON_SHELL_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/values.h"
 #include "content/public/browser/web_contents_user_data.h"
 #include "electron/buildflags/buildflags.h"
@@ -21,12 +24,45 @@ namespace base {
 class CommandLine;
 }
 
+namespace content {
+class BrowserContext;
+}
+
 namespace gin_helper {
 class Dictionary;
 }
 
 namespace electron {
 
+// The preferences of a WebContents that are applied to its renderer process
+// on the command line, rather than to each frame.
+struct RendererProcessPreferences {
+  RendererProcessPreferences();
+  RendererProcessPreferences(const RendererProcessPreferences&);
+  RendererProcessPreferences& operator=(const RendererProcessPreferences&);
+  ~RendererProcessPreferences();
+
+  // Reads the preferences of a renderer process hosting a main frame with
+  // |web_preferences|, before any WebContents is created with them.
+  static RendererProcessPreferences FromDictionary(
+      const gin_helper::Dictionary& web_preferences);
+
+  bool operator==(const RendererProcessPreferences&) const;
+
+  void AppendCommandLineSwitches(base::CommandLine* command_line) const;
+
+  bool sandbox = true;
+  bool experimental_features = false;
+  bool node_integration_in_worker = false;
+#if BUILDFLAG(IS_MAC)
+  bool scroll_bounce = false;
+#endif
+  std::vector<std::string> custom_args;
+  std::vector<std::string> custom_switches;
+  std::optional<std::string> enable_blink_features;
+  std::optional<std::string> disable_blink_features;
+};
+
 // Stores and applies the preferences of WebContents.
 class WebContentsPreferences
     : public content::WebContentsUserData<WebContentsPreferences> {
@@ -48,6 +84,9 @@ class WebContentsPreferences
   void AppendCommandLineSwitches(base::CommandLine* command_line,
                                  bool is_subframe);
 
+  const RendererProcessPreferences& GetRendererProcessPreferences(
+      bool is_subframe) const;
+
   // Modify the WebPreferences according to preferences.
   void OverrideWebkitPrefs(blink::web_pref::WebPreferences* prefs,
                            blink::RendererPreferences* renderer_prefs);
@@ -82,16 +121,35 @@ class WebContentsPreferences
   bool IsWebSecurityEnabled() const { return web_security_; }
   bool GetPreloadPath(base::FilePath* path) const;
   bool IsSandboxed() const;
+  std::optional<std::string> GetProcessGroup() const { return process_group_; }
 
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
   friend class ElectronBrowserClient;
 
+  using SharedRendererProcessPreferences =
+      base::RefCountedData<RendererProcessPreferences>;
+
   // Get WebContents according to process ID.
   static content::WebContents* GetWebContentsFromProcessID(int process_id);
 
+  // Get a WebContents of |browser_context| in |process_group| whose main
+  // frame's renderer process is launched with |prefs|.
+  static content::WebContents* GetWebContentsInProcessGroup(
+      content::BrowserContext* browser_context,
+      const std::string& process_group,
+      const RendererProcessPreferences& prefs);
+
+  // Returns the preferences of another WebContents that are equal to |prefs|,
+  // so that the WebContents created with the same options share them.
+  static scoped_refptr<const SharedRendererProcessPreferences>
+  ShareRendererProcessPreferences(RendererProcessPreferences prefs);
+
   void Clear();
   void SaveLastPreferences();
+  RendererProcessPreferences ComputeRendererProcessPreferences(
+      bool is_subframe) const;
+  void UpdateRendererProcessPreferences();
 
   // TODO(clavin): refactor to use the WebContents provided by the
   // WebContentsUserData base class instead of storing a duplicate ref
@@ -102,6 +160,7 @@ class WebContentsPreferences
   bool node_integration_;
   bool node_integration_in_sub_frames_;
   bool node_integration_in_worker_;
+  bool lazy_node_integration_;
   bool disable_html_fullscreen_window_resize_;
   bool webview_tag_;
   std::optional<bool> sandbox_;
@@ -135,6 +194,7 @@ class WebContentsPreferences
   std::optional<SkColor> background_color_;
   blink::mojom::ImageAnimationPolicy image_animation_policy_;
   std::optional<base::FilePath> preload_path_;
+  std::optional<std::string> process_group_;
   blink::mojom::V8CacheOptions v8_cache_options_;
 
 #if BUILDFLAG(IS_MAC)
@@ -144,6 +204,13 @@ class WebContentsPreferences
   bool spellcheck_;
 #endif
 
+  // Computed when the preferences are set rather than for each renderer
+  // process that is launched.
+  scoped_refptr<const SharedRendererProcessPreferences>
+      main_frame_process_preferences_;
+  scoped_refptr<const SharedRendererProcessPreferences>
+      subframe_process_preferences_;
+
   // This is a snapshot of some relevant preferences at the time the renderer
   // was launched.
   base::Value last_web_preferences_;
@@ -16,21 +16,39 @@ WebViewManager::~WebViewManager() = default;
 void WebViewManager::AddGuest(int guest_instance_id,
                               content::WebContents* embedder,
                               content::WebContents* web_contents) {
+  RemoveGuest(guest_instance_id);
+  // Instance ids only grow, so both maps are appended to.
   web_contents_embedder_map_[guest_instance_id] = {web_contents, embedder};
+  guests_by_embedder_[embedder].insert(guest_instance_id);
 }
 
 void WebViewManager::RemoveGuest(int guest_instance_id) {
-  web_contents_embedder_map_.erase(guest_instance_id);
+  auto it = web_contents_embedder_map_.find(guest_instance_id);
+  if (it == web_contents_embedder_map_.end())
+    return;
+
+  auto guests = guests_by_embedder_.find(it->second.embedder);
+  if (guests != guests_by_embedder_.end()) {
+    guests->second.erase(guest_instance_id);
+    if (guests->second.empty())
+      guests_by_embedder_.erase(guests);
+  }
+  web_contents_embedder_map_.erase(it);
 }
 
 bool WebViewManager::ForEachGuest(
     content::WebContents* embedder_web_contents,
     base::FunctionRef<bool(content::WebContents*)> fn) {
-  for (auto& item : web_contents_embedder_map_) {
-    if (item.second.embedder != embedder_web_contents)
+  auto guests = guests_by_embedder_.find(embedder_web_contents);
+  if (guests == guests_by_embedder_.end())
+    return false;
+
+  for (int guest_instance_id : guests->second) {
+    auto it = web_contents_embedder_map_.find(guest_instance_id);
+    if (it == web_contents_embedder_map_.end())
       continue;
 
-    content::WebContents* guest_web_contents = item.second.web_contents;
+    content::WebContents* guest_web_contents = it->second.web_contents;
     if (guest_web_contents && fn(guest_web_contents))
       return true;
   }
@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_BROWSER_WEB_VIEW_MANAGER_H_
 
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/memory/raw_ptr.h"
 #include "content/public/browser/browser_plugin_guest_manager.h"
 
@@ -38,6 +39,10 @@ class WebViewManager : public content::BrowserPluginGuestManager {
   };
   // guest_instance_id => (web_contents, embedder)
   base::flat_map<int, WebContentsWithEmbedder> web_contents_embedder_map_;
+  // embedder => guest_instance_ids, so that the guests of an embedder are
+  // found without going through those of all embedders.
+  base::flat_map<content::WebContents*, base::flat_set<int>>
+      guests_by_embedder_;
 };
 
 }  // namespace electron
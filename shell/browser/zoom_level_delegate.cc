@@ -4,12 +4,14 @@
 
 #include "shell/browser/zoom_level_delegate.h"
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/functional/bind.h"
+#include "base/json/values_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "components/prefs/json_pref_store.h"
 #include "components/prefs/pref_filter.h"
@@ -30,11 +32,57 @@ const char kPartitionDefaultZoomLevel[] = "partition.default_zoom_level";
 // be displayed at the default zoom level.
 const char kPartitionPerHostZoomLevels[] = "partition.per_host_zoom_levels";
 
+// Keys of the per-host entries, which used to be the zoom level alone.
+const char kZoomLevelKey[] = "zoom_level";
+const char kLastModifiedKey[] = "last_modified";
+
+// Changes are batched, since each write of a pref schedules the serialization
+// of all the prefs.
+constexpr base::TimeDelta kCommitDelay = base::Seconds(1);
+
+// The least recently modified hosts are dropped past that many, so that the
+// dictionary doesn't grow forever.
+constexpr size_t kMaxPerHostZoomLevels = 1000;
+
 std::string GetHash(const base::FilePath& partition_path) {
   size_t int_key = std::hash<base::FilePath>()(partition_path);
   return base::NumberToString(int_key);
 }
 
+std::optional<double> GetZoomLevel(const base::Value& value) {
+  if (const base::Value::Dict* dict = value.GetIfDict())
+    return dict->FindDouble(kZoomLevelKey);
+  return value.GetIfDouble();
+}
+
+base::Time GetLastModified(const base::Value& value) {
+  const base::Value::Dict* dict = value.GetIfDict();
+  if (!dict)
+    return base::Time();
+  return base::ValueToTime(dict->Find(kLastModifiedKey)).value_or(base::Time());
+}
+
+// Returns the hosts of |host_zoom_dictionary| over kMaxPerHostZoomLevels,
+// starting from the least recently modified.
+std::vector<std::string> GetStaleHosts(
+    const base::Value::Dict& host_zoom_dictionary) {
+  if (host_zoom_dictionary.size() <= kMaxPerHostZoomLevels)
+    return {};
+
+  std::vector<std::pair<base::Time, std::string>> hosts;
+  hosts.reserve(host_zoom_dictionary.size());
+  for (auto [host, value] : host_zoom_dictionary)
+    hosts.emplace_back(GetLastModified(value), host);
+  const size_t stale_count = hosts.size() - kMaxPerHostZoomLevels;
+  std::partial_sort(hosts.begin(), hosts.begin() + stale_count, hosts.end());
+
+  std::vector<std::string> stale_hosts;
+  stale_hosts.reserve(stale_count);
+  for (size_t i = 0; i < stale_count; ++i)
+    stale_hosts.push_back(std::move(hosts[i].second));
+  return stale_hosts;
+}
+
 }  // namespace
 
 // static
@@ -50,7 +98,9 @@ ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
   partition_key_ = GetHash(partition_path);
 }
 
-ZoomLevelDelegate::~ZoomLevelDelegate() = default;
+ZoomLevelDelegate::~ZoomLevelDelegate() {
+  CommitPendingZoomLevels();
+}
 
 void ZoomLevelDelegate::SetDefaultZoomLevelPref(double level) {
   if (blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel()))
@@ -74,13 +124,33 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
   if (change.mode != content::HostZoomMap::ZOOM_CHANGED_FOR_HOST)
     return;
 
-  double level = change.zoom_level;
+  bool modification_is_removal = blink::PageZoomValuesEqual(
+      change.zoom_level, host_zoom_map_->GetDefaultZoomLevel());
+  if (modification_is_removal) {
+    pending_changes_[change.host] = std::nullopt;
+  } else {
+    pending_changes_[change.host] = HostZoomLevel{
+        change.zoom_level, change.last_modified.is_null()
+                               ? base::Time::Now()
+                               : change.last_modified};
+  }
+
+  if (!commit_timer_.IsRunning()) {
+    commit_timer_.Start(
+        FROM_HERE, kCommitDelay,
+        base::BindOnce(&ZoomLevelDelegate::CommitPendingZoomLevels,
+                       base::Unretained(this)));
+  }
+}
+
+void ZoomLevelDelegate::CommitPendingZoomLevels() {
+  commit_timer_.Stop();
+  if (pending_changes_.empty())
+    return;
+
   ScopedDictPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
   base::Value::Dict& host_zoom_dictionaries = update.Get();
 
-  bool modification_is_removal =
-      blink::PageZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel());
-
   base::Value::Dict* host_zoom_dictionary =
       host_zoom_dictionaries.FindDict(partition_key_);
   if (!host_zoom_dictionary) {
@@ -89,18 +159,32 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
     host_zoom_dictionary = host_zoom_dictionaries.FindDict(partition_key_);
   }
 
-  if (modification_is_removal)
-    host_zoom_dictionary->Remove(change.host);
-  else
-    host_zoom_dictionary->Set(change.host, base::Value(level));
+  for (const auto& [host, zoom_level] : pending_changes_) {
+    if (!zoom_level) {
+      host_zoom_dictionary->Remove(host);
+      continue;
+    }
+    host_zoom_dictionary->Set(
+        host, base::Value::Dict()
+                  .Set(kZoomLevelKey, zoom_level->level)
+                  .Set(kLastModifiedKey,
+                       base::TimeToValue(zoom_level->last_modified)));
+  }
+  pending_changes_.clear();
+
+  for (const std::string& host : GetStaleHosts(*host_zoom_dictionary))
+    host_zoom_dictionary->Remove(host);
 }
 
 void ZoomLevelDelegate::ExtractPerHostZoomLevels(
     const base::Value::Dict& host_zoom_dictionary) {
-  std::vector<std::string> keys_to_remove;
+  std::vector<std::string> keys_to_remove =
+      GetStaleHosts(host_zoom_dictionary);
   base::Value::Dict host_zoom_dictionary_copy = host_zoom_dictionary.Clone();
+  for (const std::string& host : keys_to_remove)
+    host_zoom_dictionary_copy.Remove(host);
   for (auto [host, value] : host_zoom_dictionary_copy) {
-    const std::optional<double> zoom_level = value.GetIfDouble();
+    const std::optional<double> zoom_level = GetZoomLevel(value);
 
     // Filter out A) the empty host, B) zoom levels equal to the default; and
     // remember them, so that we can later erase them from Prefs.
@@ -115,12 +199,13 @@ void ZoomLevelDelegate::ExtractPerHostZoomLevels(
       continue;
     }
 
-    host_zoom_map_->SetZoomLevelForHost(host, zoom_level.value());
+    host_zoom_map_->InitializeZoomLevelForHost(host, zoom_level.value(),
+                                               GetLastModified(value));
   }
 
-  // Sanitize prefs to remove entries that match the default zoom level and/or
-  // have an empty host.
-  {
+  // Sanitize prefs to remove entries that match the default zoom level, have
+  // an empty host or are stale.
+  if (!keys_to_remove.empty()) {
     ScopedDictPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
     base::Value::Dict* sanitized_host_zoom_dictionary =
         update->FindDict(partition_key_);
@@ -149,7 +234,7 @@ void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
   if (host_zoom_dictionary) {
     // Since we're calling this before setting up zoom_subscription_ below we
     // don't need to worry that host_zoom_dictionary is indirectly affected
-    // by calls to HostZoomMap::SetZoomLevelForHost().
+    // by calls to HostZoomMap::InitializeZoomLevelForHost().
     ExtractPerHostZoomLevels(*host_zoom_dictionary);
   }
   zoom_subscription_ =
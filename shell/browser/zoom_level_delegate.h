@@ -5,9 +5,13 @@
 #ifndef ELECTRON_SHELL_BROWSER_ZOOM_LEVEL_DELEGATE_H_
 #define ELECTRON_SHELL_BROWSER_ZOOM_LEVEL_DELEGATE_H_
 
+#include <optional>
 #include <string>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/host_zoom_map.h"
@@ -26,7 +30,7 @@ namespace electron {
 // levels in HostZoomMap and preference system. All changes
 // to the per-partition default zoom levels flow through this
 // class. Any changes to per-host levels are updated when HostZoomMap calls
-// OnZoomLevelChanged.
+// OnZoomLevelChanged, and written to the preferences in batches.
 class ZoomLevelDelegate : public content::ZoomLevelDelegate {
  public:
   static void RegisterPrefs(PrefRegistrySimple* pref_registry);
@@ -53,10 +57,23 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   // zoom levels (if any) managed by this class (for its associated partition).
   void OnZoomLevelChanged(const content::HostZoomMap::ZoomLevelChange& change);
 
+  // Writes the per-host zoom levels that changed since the last call to the
+  // preferences at once, and drops the least recently modified hosts.
+  void CommitPendingZoomLevels();
+
+  struct HostZoomLevel {
+    double level;
+    base::Time last_modified;
+  };
+
   raw_ptr<PrefService> pref_service_;
   raw_ptr<content::HostZoomMap> host_zoom_map_ = nullptr;
   base::CallbackListSubscription zoom_subscription_;
   std::string partition_key_;
+
+  // The hosts that went back to the default zoom level map to nullopt.
+  base::flat_map<std::string, std::optional<HostZoomLevel>> pending_changes_;
+  base::OneShotTimer commit_timer_;
 };
 
 }  // namespace electron
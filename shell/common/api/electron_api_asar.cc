@@ -2,13 +2,27 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/functional/bind.h"
+#include "base/path_service.h"
+#include "base/task/sequenced_task_runner.h"
+#include "chrome/common/chrome_paths.h"
+#include "chrome/common/chrome_switches.h"
+#include "electron/fuses.h"
 #include "gin/handle.h"
 #include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/batched_reader.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 
 namespace {
@@ -25,10 +39,18 @@ class Archive : public node::ObjectWrap {
     NODE_SET_PROTOTYPE_METHOD(tpl, "getFileInfo", &Archive::GetFileInfo);
     NODE_SET_PROTOTYPE_METHOD(tpl, "stat", &Archive::Stat);
     NODE_SET_PROTOTYPE_METHOD(tpl, "readdir", &Archive::Readdir);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readdirWithTypes",
+                              &Archive::ReaddirWithTypes);
     NODE_SET_PROTOTYPE_METHOD(tpl, "realpath", &Archive::Realpath);
     NODE_SET_PROTOTYPE_METHOD(tpl, "copyFileOut", &Archive::CopyFileOut);
     NODE_SET_PROTOTYPE_METHOD(tpl, "getFdAndValidateIntegrityLater",
                               &Archive::GetFD);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readFileMapped", &Archive::ReadFileMapped);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readCompressedFile",
+                              &Archive::ReadCompressedFile);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "readFileAsync", &Archive::ReadFileAsync);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "resolveModule", &Archive::ResolveModule);
+    NODE_SET_PROTOTYPE_METHOD(tpl, "getCacheKey", &Archive::GetCacheKey);
 
     return tpl;
   }
@@ -84,6 +106,7 @@ class Archive : public node::ObjectWrap {
     dict.Set("size", info.size);
     dict.Set("unpacked", info.unpacked);
     dict.Set("offset", info.offset);
+    dict.Set("compressed", info.compression.has_value());
     if (info.integrity.has_value()) {
       gin_helper::Dictionary integrity(isolate, v8::Object::New(isolate));
       asar::HashAlgorithm algorithm = info.integrity.value().algorithm;
@@ -142,6 +165,49 @@ class Archive : public node::ObjectWrap {
     args.GetReturnValue().Set(gin::ConvertToV8(isolate, files));
   }
 
+  // Returns the entries under a directory as [names, types, sizes], in the
+  // format of the fs binding's readdir with file types. The names are
+  // relative to the directory when the second argument is true.
+  static void ReaddirWithTypes(
+      const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    base::FilePath path;
+    if (!gin::ConvertFromV8(isolate, args[0], &path)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    const bool recursive = args[1]->IsTrue();
+
+    std::vector<asar::Archive::DirectoryEntry> entries;
+    if (!wrap->archive_ ||
+        !wrap->archive_->ReaddirWithTypes(path, recursive, &entries)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> names = v8::Array::New(isolate, entries.size());
+    v8::Local<v8::Array> types = v8::Array::New(isolate, entries.size());
+    v8::Local<v8::Array> sizes = v8::Array::New(isolate, entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const uint32_t index = static_cast<uint32_t>(i);
+      names->Set(context, index, gin::ConvertToV8(isolate, entries[i].name))
+          .Check();
+      types
+          ->Set(context, index,
+                v8::Integer::New(isolate, static_cast<int>(entries[i].type)))
+          .Check();
+      sizes
+          ->Set(context, index,
+                v8::Number::New(isolate, static_cast<double>(entries[i].size)))
+          .Check();
+    }
+    v8::Local<v8::Value> result[] = {names, types, sizes};
+    args.GetReturnValue().Set(
+        v8::Array::New(isolate, result, std::size(result)));
+  }
+
   // Returns the path of file with symbol link resolved.
   static void Realpath(const v8::FunctionCallbackInfo<v8::Value>& args) {
     auto* isolate = args.GetIsolate();
@@ -187,6 +253,138 @@ class Archive : public node::ObjectWrap {
         isolate, wrap->archive_ ? wrap->archive_->GetUnsafeFD() : -1));
   }
 
+  // Returns the contents of a packed file read from the archive's memory
+  // mapping, with integrity already validated, or false when mapped reads are
+  // disabled or unavailable and the caller should fall back to the fd.
+  static void ReadFileMapped(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    base::FilePath path;
+    if (!asar::IsMappedReadModeEnabled() || !wrap->archive_ ||
+        !gin::ConvertFromV8(isolate, args[0], &path)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    std::optional<base::span<const uint8_t>> span =
+        wrap->archive_->GetMappedFileSpan(path);
+    if (!span) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    // The V8 memory cage does not allow wrapping the mapping in an external
+    // ArrayBuffer, so a single copy into a V8-owned buffer is the best we can
+    // do here; it still avoids the read() syscalls on the archive's fd.
+    v8::Local<v8::Object> buffer;
+    if (!node::Buffer::Copy(isolate,
+                            reinterpret_cast<const char*>(span->data()),
+                            span->size())
+             .ToLocal(&buffer)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(buffer);
+  }
+
+  // Returns the decompressed contents of a compressed packed file, with the
+  // integrity of its blocks already validated, or false on failure.
+  static void ReadCompressedFile(
+      const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    base::FilePath path;
+    asar::Archive::FileInfo info;
+    std::string contents;
+    if (!wrap->archive_ || !gin::ConvertFromV8(isolate, args[0], &path) ||
+        !wrap->archive_->GetFileInfo(path, &info) || !info.compression ||
+        !wrap->archive_->ReadCompressedFile(info, &contents)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    v8::Local<v8::Object> buffer;
+    if (!node::Buffer::Copy(isolate, contents.data(), contents.size())
+             .ToLocal(&buffer)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(buffer);
+  }
+
+  // Reads a packed file on the thread pool and returns a promise resolving
+  // with its contents, with integrity already validated, or with false when
+  // it can't be read. Returns false for unpacked or compressed files, and on
+  // threads without a task runner, where the caller should fall back to the
+  // fd.
+  static void ReadFileAsync(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    base::FilePath path;
+    asar::Archive::FileInfo info;
+    if (!wrap->archive_ || !base::SequencedTaskRunner::HasCurrentDefault() ||
+        !gin::ConvertFromV8(isolate, args[0], &path) ||
+        !wrap->archive_->GetFileInfo(path, &info) || info.unpacked ||
+        info.compression) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+    args.GetReturnValue().Set(promise.GetHandle());
+    wrap->archive_->GetBatchedReader()->Read(
+        info.offset, info.size, std::move(info.integrity),
+        base::BindOnce(
+            [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+               std::optional<std::vector<uint8_t>> contents) {
+              v8::Isolate* isolate = promise.isolate();
+              v8::HandleScope handle_scope(isolate);
+              v8::Context::Scope context_scope(promise.GetContext());
+              v8::Local<v8::Object> buffer;
+              if (!contents ||
+                  !node::Buffer::Copy(
+                       isolate, reinterpret_cast<const char*>(contents->data()),
+                       contents->size())
+                       .ToLocal(&buffer)) {
+                promise.Resolve(v8::False(isolate));
+                return;
+              }
+              promise.Resolve(buffer);
+            },
+            std::move(promise)));
+  }
+
+  // Returns the pre-resolved path of a module required from inside the
+  // archive, or false if the archive's module index does not know about it.
+  static void ResolveModule(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    base::FilePath parent_dir;
+    std::string request;
+    if (!wrap->archive_ ||
+        !gin::ConvertFromV8(isolate, args[0], &parent_dir) ||
+        !gin::ConvertFromV8(isolate, args[1], &request)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+
+    std::optional<base::FilePath> resolved =
+        wrap->archive_->ResolveModule(parent_dir, request);
+    if (!resolved) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
+    }
+    args.GetReturnValue().Set(gin::ConvertToV8(isolate, *resolved));
+  }
+
+  // Returns a key identifying the archive's contents for code caching.
+  static void GetCacheKey(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* isolate = args.GetIsolate();
+    auto* wrap = node::ObjectWrap::Unwrap<Archive>(args.Holder());
+    args.GetReturnValue().Set(gin::ConvertToV8(
+        isolate, wrap->archive_ ? wrap->archive_->cache_key() : std::string()));
+  }
+
   std::shared_ptr<asar::Archive> archive_;
 };
 
@@ -211,6 +409,29 @@ static void SplitPath(const v8::FunctionCallbackInfo<v8::Value>& args) {
   args.GetReturnValue().Set(dict.GetHandle());
 }
 
+// Returns the directory where V8 code caches of scripts loaded from asar
+// archives are stored, or undefined when the asarCodeCache fuse is disabled.
+static void GetCodeCacheDirectory(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  auto* isolate = args.GetIsolate();
+  if (!electron::fuses::IsAsarCodeCacheEnabled())
+    return;
+
+  // Child processes are always launched with --user-data-dir, the browser
+  // process has to ask the path service.
+  base::FilePath user_data_dir =
+      base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+          ::switches::kUserDataDir);
+  if (user_data_dir.empty() &&
+      !base::PathService::Get(chrome::DIR_USER_DATA, &user_data_dir)) {
+    return;
+  }
+
+  args.GetReturnValue().Set(gin::ConvertToV8(
+      isolate, user_data_dir.Append(FILE_PATH_LITERAL("Code Cache"))
+                   .Append(FILE_PATH_LITERAL("asar"))));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -225,6 +446,7 @@ void Initialize(v8::Local<v8::Object> exports,
   exports->Set(context, node::FIXED_ONE_BYTE_STRING(isolate, "Archive"), cons)
       .Check();
   NODE_SET_METHOD(exports, "splitPath", &SplitPath);
+  NODE_SET_METHOD(exports, "getCodeCacheDirectory", &GetCodeCacheDirectory);
 }
 
 }  // namespace
@@ -5,14 +5,22 @@
 #include "shell/common/api/electron_api_clipboard.h"
 
 #include <map>
+#include <memory>
+#include <utility>
 
 #include "base/containers/contains.h"
+#include "base/no_destructor.h"
 #include "base/run_loop.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/clipboard_watcher.h"
+#include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/process_util.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
@@ -22,6 +30,21 @@
 
 namespace electron::api {
 
+namespace {
+
+SkBitmap DecodePng(std::vector<uint8_t> png) {
+  SkBitmap bitmap;
+  gfx::PNGCodec::Decode(png.data(), png.size(), &bitmap);
+  return bitmap;
+}
+
+std::unique_ptr<ClipboardWatcher>& GetClipboardWatcher() {
+  static base::NoDestructor<std::unique_ptr<ClipboardWatcher>> watcher;
+  return *watcher;
+}
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(gin_helper::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -97,8 +120,19 @@ std::string Clipboard::Read(const std::string& format_string) {
 
 v8::Local<v8::Value> Clipboard::ReadBuffer(const std::string& format_string,
                                            gin_helper::Arguments* args) {
-  std::string data = Read(format_string);
-  return node::Buffer::Copy(args->isolate(), data.data(), data.length())
+  // The buffer takes over the string instead of copying it, clipboard data
+  // can be large.
+  auto* data = new std::string(Read(format_string));
+  auto backing_store = v8::ArrayBuffer::NewBackingStore(
+      data->data(), data->size(),
+      [](void*, size_t, void* data) {
+        delete static_cast<std::string*>(data);
+      },
+      data);
+  size_t length = backing_store->ByteLength();
+  auto array_buffer =
+      v8::ArrayBuffer::New(args->isolate(), std::move(backing_store));
+  return node::Buffer::New(args->isolate(), array_buffer, 0, length)
       .ToLocalChecked();
 }
 
@@ -251,6 +285,40 @@ gfx::Image Clipboard::ReadImage(gin_helper::Arguments* args) {
   return image.value();
 }
 
+v8::Local<v8::Promise> Clipboard::ReadImageAsync(gin_helper::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (IsBrowserProcess() && !Browser::Get()->is_ready()) {
+    promise.RejectWithErrorMessage(
+        "clipboard.readImageAsync is available only after app ready in the "
+        "main process");
+    return handle;
+  }
+
+  // Unlike readImage() this doesn't wait for the image in a nested run loop,
+  // and the PNG is decoded on the thread pool.
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadPng(
+      GetClipboardBuffer(args),
+      /* data_dst = */ nullptr,
+      base::BindOnce(
+          [](gin_helper::Promise<gfx::Image> promise,
+             const std::vector<uint8_t>& result) {
+            base::ThreadPool::PostTaskAndReplyWithResult(
+                FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+                base::BindOnce(&DecodePng, result),
+                base::BindOnce(
+                    [](gin_helper::Promise<gfx::Image> promise,
+                       SkBitmap bitmap) {
+                      promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
+                    },
+                    std::move(promise)));
+          },
+          std::move(promise)));
+  return handle;
+}
+
 void Clipboard::WriteImage(const gfx::Image& image,
                            gin_helper::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
@@ -274,6 +342,24 @@ void Clipboard::Clear(gin_helper::Arguments* args) {
   ui::Clipboard::GetForCurrentThread()->Clear(GetClipboardBuffer(args));
 }
 
+std::string Clipboard::GetSequenceNumber(gin_helper::Arguments* args) {
+  return ui::Clipboard::GetForCurrentThread()
+      ->GetSequenceNumber(GetClipboardBuffer(args))
+      .ToString();
+}
+
+// A listener that isn't a function stops watching the clipboard.
+void Clipboard::SetChangeListener(v8::Isolate* isolate,
+                                  v8::Local<v8::Value> listener) {
+  base::RepeatingClosure callback;
+  if (!gin::ConvertFromV8(isolate, listener, &callback)) {
+    GetClipboardWatcher().reset();
+    return;
+  }
+  GetClipboardWatcher() =
+      std::make_unique<ClipboardWatcher>(std::move(callback));
+}
+
 }  // namespace electron::api
 
 namespace {
@@ -297,12 +383,20 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("readBookmark", &electron::api::Clipboard::ReadBookmark);
   dict.SetMethod("writeBookmark", &electron::api::Clipboard::WriteBookmark);
   dict.SetMethod("readImage", &electron::api::Clipboard::ReadImage);
+  dict.SetMethod("readImageAsync", &electron::api::Clipboard::ReadImageAsync);
   dict.SetMethod("writeImage", &electron::api::Clipboard::WriteImage);
   dict.SetMethod("readFindText", &electron::api::Clipboard::ReadFindText);
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
   dict.SetMethod("writeBuffer", &electron::api::Clipboard::WriteBuffer);
   dict.SetMethod("clear", &electron::api::Clipboard::Clear);
+  dict.SetMethod("getSequenceNumber",
+                 &electron::api::Clipboard::GetSequenceNumber);
+  // The change event is only emitted in the main process.
+  if (electron::IsBrowserProcess()) {
+    dict.SetMethod("_setChangeListener",
+                   &electron::api::Clipboard::SetChangeListener);
+  }
 }
 
 }  // namespace
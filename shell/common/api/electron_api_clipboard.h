@@ -31,6 +31,9 @@ class Clipboard {
   static bool Has(const std::string& format_string,
                   gin_helper::Arguments* args);
   static void Clear(gin_helper::Arguments* args);
+  static std::string GetSequenceNumber(gin_helper::Arguments* args);
+  static void SetChangeListener(v8::Isolate* isolate,
+                                v8::Local<v8::Value> listener);
 
   static std::string Read(const std::string& format_string);
   static void Write(const gin_helper::Dictionary& data,
@@ -53,6 +56,7 @@ class Clipboard {
                             gin_helper::Arguments* args);
 
   static gfx::Image ReadImage(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadImageAsync(gin_helper::Arguments* args);
   static void WriteImage(const gfx::Image& image, gin_helper::Arguments* args);
 
   static std::u16string ReadFindText();
@@ -4,17 +4,23 @@
 
 #include "shell/common/api/electron_api_native_image.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/barrier_callback.h"
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/arguments.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
@@ -25,14 +31,17 @@
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gfx_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
+#include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/process_util.h"
 #include "shell/common/skia_util.h"
 #include "shell/common/thread_restrictions.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -42,6 +51,7 @@
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
+#include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_util.h"
@@ -119,6 +129,128 @@ base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
 }
 #endif
 
+struct ResizeParams {
+  gfx::Size size;
+  skia::ImageOperations::ResizeMethod method;
+};
+
+// Reads the options of resize() and resizeAsync() for an image of |size|,
+// returns nothing when the result is an empty image.
+std::optional<ResizeParams> GetResizeParams(gfx::Size size,
+                                            float aspect_ratio,
+                                            const base::Value::Dict& options) {
+  std::optional<int> new_width = options.FindInt("width");
+  std::optional<int> new_height = options.FindInt("height");
+  int width = new_width.value_or(size.width());
+  int height = new_height.value_or(size.height());
+  size.SetSize(width, height);
+
+  if (width <= 0 && height <= 0) {
+    return std::nullopt;
+  } else if (new_width && !new_height) {
+    // Scale height to preserve original aspect ratio
+    size.set_height(width);
+    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / aspect_ratio);
+  } else if (new_height && !new_width) {
+    // Scale width to preserve original aspect ratio
+    size.set_width(height);
+    size = gfx::ScaleToRoundedSize(size, aspect_ratio, 1.f);
+  }
+
+  skia::ImageOperations::ResizeMethod method =
+      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+  const std::string* quality = options.FindString("quality");
+  if (quality && *quality == "good")
+    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  else if (quality && *quality == "better")
+    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  return ResizeParams{size, method};
+}
+
+// The async methods hand bitmaps and representations to the thread pool
+// rather than gfx::ImageSkia, which may only be used on the sequence it
+// belongs to. The pixels are shared, not copied.
+
+constexpr base::TaskTraits kImageTaskTraits = {
+    base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+gfx::Image CreateImageFromReps(const std::vector<gfx::ImageSkiaRep>& reps) {
+  gfx::ImageSkia image_skia;
+  for (const auto& rep : reps)
+    image_skia.AddRepresentation(rep);
+  return gfx::Image(image_skia);
+}
+
+std::vector<gfx::ImageSkiaRep> ResizeReps(
+    const std::vector<gfx::ImageSkiaRep>& reps,
+    const ResizeParams& params) {
+  TRACE_EVENT0("electron", "NativeImage::ResizeAsync");
+  std::vector<gfx::ImageSkiaRep> resized;
+  for (const auto& rep : reps) {
+    const gfx::Size size = gfx::ScaleToCeiledSize(params.size, rep.scale());
+    resized.emplace_back(
+        skia::ImageOperations::Resize(rep.GetBitmap(), params.method,
+                                      size.width(), size.height()),
+        rep.scale());
+  }
+  return resized;
+}
+
+std::vector<gfx::ImageSkiaRep> DecodeReps(const std::vector<uint8_t>& data,
+                                          int width,
+                                          int height,
+                                          double scale_factor) {
+  TRACE_EVENT0("electron", "NativeImage::DecodeAsync");
+  gfx::ImageSkia image_skia;
+  electron::util::AddImageSkiaRepFromBuffer(&image_skia, data.data(),
+                                            data.size(), width, height,
+                                            scale_factor);
+  return image_skia.image_reps();
+}
+
+// Reading the files blocks, unlike decoding a buffer.
+constexpr base::TaskTraits kImageFileTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+struct ImageFromPath {
+  base::FilePath path;
+  std::vector<gfx::ImageSkiaRep> reps;
+};
+
+ImageFromPath LoadReps(const base::FilePath& path) {
+  TRACE_EVENT0("electron", "NativeImage::CreateFromPathAsync");
+  ImageFromPath result;
+  result.path = NormalizePath(path);
+#if BUILDFLAG(IS_WIN)
+  // The icons are loaded lazily, at the sizes they are asked for.
+  if (result.path.MatchesExtension(FILE_PATH_LITERAL(".ico")))
+    return result;
+#endif
+  gfx::ImageSkia image_skia;
+  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, result.path);
+  result.reps = image_skia.image_reps();
+  return result;
+}
+
+// Frees what the pixels of a bitmap created by createFromBitmap() with the
+// shared option point into, on whichever thread releases the bitmap last.
+void ReleaseBackingStore(void* pixels, void* context) {
+  delete static_cast<std::shared_ptr<v8::BackingStore>*>(context);
+}
+
+void ResolveWithBuffer(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                       std::vector<uint8_t> data) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(node::Buffer::Copy(isolate,
+                                     reinterpret_cast<const char*>(data.data()),
+                                     data.size())
+                      .ToLocalChecked());
+}
+
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
@@ -244,6 +376,60 @@ v8::Local<v8::Value> NativeImage::ToPNG(gin::Arguments* args) {
   return node::Buffer::Copy(args->isolate(), data, size).ToLocalChecked();
 }
 
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(gin::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      ResolveWithBuffer(std::move(promise),
+                        std::vector<uint8_t>(png->front(),
+                                             png->front() + png->size()));
+      return handle;
+    }
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(
+          [](const SkBitmap& bitmap) {
+            TRACE_EVENT0("electron", "NativeImage::ToPNGAsync");
+            std::vector<uint8_t> encoded;
+            gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+            return encoded;
+          },
+          bitmap),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(1.0f).GetBitmap();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(
+          [](const SkBitmap& bitmap, int quality) {
+            TRACE_EVENT0("electron", "NativeImage::ToJPEGAsync");
+            std::vector<uint8_t> encoded;
+            if (!bitmap.isNull())
+              gfx::JPEGCodec::Encode(bitmap, quality, &encoded);
+            return encoded;
+          },
+          bitmap, quality),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
 v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
@@ -304,6 +490,31 @@ v8::Local<v8::Value> NativeImage::GetBitmap(gin::Arguments* args) {
       .ToLocalChecked();
 }
 
+v8::Local<v8::Value> NativeImage::GetBitmapView(gin::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  const char* pixels = static_cast<const char*>(bitmap.getPixels());
+  if (!pixels)
+    return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
+
+  // External buffers can't be created with the V8 sandbox, so only pixels
+  // that already live in memory of V8 can be viewed without a copy.
+  const size_t size = bitmap.computeByteSize();
+  if (pixel_store_) {
+    const char* data = static_cast<const char*>(pixel_store_->Data());
+    if (pixels >= data && pixels + size <= data + pixel_store_->ByteLength()) {
+      return node::Buffer::New(
+                 args->isolate(),
+                 v8::ArrayBuffer::New(args->isolate(), pixel_store_),
+                 pixels - data, size)
+          .ToLocalChecked();
+    }
+  }
+  return node::Buffer::Copy(args->isolate(), pixels, size).ToLocalChecked();
+}
+
 v8::Local<v8::Value> NativeImage::GetNativeHandle(
     gin_helper::ErrorThrower thrower) {
 #if BUILDFLAG(IS_MAC)
@@ -324,6 +535,16 @@ bool NativeImage::IsEmpty() {
   return image_.IsEmpty();
 }
 
+void NativeImage::Release() {
+  image_ = gfx::Image();
+  pixel_store_.reset();
+#if BUILDFLAG(IS_WIN)
+  hicon_path_.clear();
+  hicons_.clear();
+#endif
+  UpdateExternalAllocatedMemoryUsage();
+}
+
 gfx::Size NativeImage::GetSize(const std::optional<float> scale_factor) {
   float sf = scale_factor.value_or(1.0f);
   gfx::ImageSkiaRep image_rep = image_.AsImageSkia().GetRepresentation(sf);
@@ -352,41 +573,42 @@ float NativeImage::GetAspectRatio(const std::optional<float> scale_factor) {
 gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
                                              base::Value::Dict options) {
   float scale_factor = GetScaleFactorFromOptions(args);
-
-  gfx::Size size = GetSize(scale_factor);
-  std::optional<int> new_width = options.FindInt("width");
-  std::optional<int> new_height = options.FindInt("height");
-  int width = new_width.value_or(size.width());
-  int height = new_height.value_or(size.height());
-  size.SetSize(width, height);
-
-  if (width <= 0 && height <= 0) {
+  std::optional<ResizeParams> params = GetResizeParams(
+      GetSize(scale_factor), GetAspectRatio(scale_factor), options);
+  if (!params)
     return CreateEmpty(args->isolate());
-  } else if (new_width && !new_height) {
-    // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size =
-        gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio(scale_factor));
-  } else if (new_height && !new_width) {
-    // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(scale_factor), 1.f);
-  }
-
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string* quality = options.FindString("quality");
-  if (quality && *quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality && *quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
 
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+      image_.AsImageSkia(), params->method, params->size);
   return gin::CreateHandle(
       args->isolate(), new NativeImage(args->isolate(), gfx::Image(resized)));
 }
 
+v8::Local<v8::Promise> NativeImage::ResizeAsync(gin::Arguments* args,
+                                                base::Value::Dict options) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  gin_helper::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::optional<ResizeParams> params = GetResizeParams(
+      GetSize(scale_factor), GetAspectRatio(scale_factor), options);
+  if (!params) {
+    promise.Resolve(gfx::Image());
+    return handle;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&ResizeReps, image_.AsImageSkia().image_reps(), *params),
+      base::BindOnce(
+          [](gin_helper::Promise<gfx::Image> promise,
+             const std::vector<gfx::ImageSkiaRep>& reps) {
+            promise.Resolve(CreateImageFromReps(reps));
+          },
+          std::move(promise)));
+  return handle;
+}
+
 gin::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                            const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -532,6 +754,16 @@ gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
     return CreateEmpty(thrower.isolate());
   }
 
+  bool shared = false;
+  options.Get("shared", &shared);
+  if (shared) {
+    gin::Handle<NativeImage> handle = CreateFromSharedBuffer(
+        thrower.isolate(), buffer.As<v8::ArrayBufferView>(), info,
+        scale_factor);
+    if (!handle.IsEmpty())
+      return handle;
+  }
+
   SkBitmap bitmap;
   bitmap.allocN32Pixels(width, height, false);
   bitmap.writePixels({info, node::Buffer::Data(buffer), bitmap.rowBytes()});
@@ -542,6 +774,33 @@ gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
   return Create(thrower.isolate(), gfx::Image(image_skia));
 }
 
+// static
+gin::Handle<NativeImage> NativeImage::CreateFromSharedBuffer(
+    v8::Isolate* isolate,
+    v8::Local<v8::ArrayBufferView> buffer,
+    const SkImageInfo& info,
+    double scale_factor) {
+  char* data = node::Buffer::Data(buffer);
+  // Pixels must be aligned to their size, which pooled buffers always are.
+  if (node::Buffer::Length(buffer) < info.computeMinByteSize() ||
+      reinterpret_cast<uintptr_t>(data) % sizeof(uint32_t) != 0)
+    return gin::Handle<NativeImage>();
+
+  std::shared_ptr<v8::BackingStore> pixel_store =
+      buffer->Buffer()->GetBackingStore();
+  SkBitmap bitmap;
+  if (!bitmap.installPixels(
+          info, data, info.minRowBytes(), &ReleaseBackingStore,
+          new std::shared_ptr<v8::BackingStore>(pixel_store)))
+    return gin::Handle<NativeImage>();
+
+  gin::Handle<NativeImage> handle = Create(
+      isolate, gfx::Image(gfx::ImageSkia::CreateFromBitmap(bitmap,
+                                                           scale_factor)));
+  handle->pixel_store_ = std::move(pixel_store);
+  return handle;
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromBuffer(
     gin_helper::ErrorThrower thrower,
@@ -570,6 +829,157 @@ gin::Handle<NativeImage> NativeImage::CreateFromBuffer(
   return Create(args->isolate(), gfx::Image(image_skia));
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::ResizeImages(
+    v8::Isolate* isolate,
+    const std::vector<gin_helper::Dictionary>& requests) {
+  gin_helper::Promise<std::vector<gfx::Image>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  struct Job {
+    std::vector<gfx::ImageSkiaRep> reps;
+    std::optional<ResizeParams> params;
+  };
+  std::vector<Job> jobs;
+  for (const auto& request : requests) {
+    NativeImage* image = nullptr;
+    if (!request.Get("image", &image) || !image) {
+      promise.RejectWithErrorMessage("image must be a NativeImage");
+      return handle;
+    }
+
+    base::Value::Dict options;
+    int width = 0;
+    int height = 0;
+    std::string quality;
+    if (request.Get("width", &width))
+      options.Set("width", width);
+    if (request.Get("height", &height))
+      options.Set("height", height);
+    if (request.Get("quality", &quality))
+      options.Set("quality", quality);
+    float scale_factor = 1.0f;
+    request.Get("scaleFactor", &scale_factor);
+
+    jobs.push_back({image->image().AsImageSkia().image_reps(),
+                    GetResizeParams(image->GetSize(scale_factor),
+                                    image->GetAspectRatio(scale_factor),
+                                    options)});
+  }
+
+  if (jobs.empty()) {
+    promise.Resolve(std::vector<gfx::Image>());
+    return handle;
+  }
+
+  // Every image is resized in its own task, so that they are spread over
+  // the workers of the thread pool.
+  using IndexedReps = std::pair<size_t, std::vector<gfx::ImageSkiaRep>>;
+  auto barrier = base::BarrierCallback<IndexedReps>(
+      jobs.size(),
+      base::BindOnce(
+          [](gin_helper::Promise<std::vector<gfx::Image>> promise,
+             std::vector<IndexedReps> results) {
+            std::sort(results.begin(), results.end(),
+                      [](const auto& a, const auto& b) {
+                        return a.first < b.first;
+                      });
+            std::vector<gfx::Image> images;
+            for (const auto& result : results)
+              images.push_back(CreateImageFromReps(result.second));
+            promise.Resolve(images);
+          },
+          std::move(promise)));
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    if (!jobs[i].params) {
+      barrier.Run({i, {}});
+      continue;
+    }
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, kImageTaskTraits,
+        base::BindOnce(&ResizeReps, std::move(jobs[i].reps), *jobs[i].params),
+        base::BindOnce(
+            [](size_t index,
+               base::OnceCallback<void(IndexedReps)> callback,
+               std::vector<gfx::ImageSkiaRep> reps) {
+              std::move(callback).Run({index, std::move(reps)});
+            },
+            i, barrier));
+  }
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::DecodeAsync(v8::Isolate* isolate,
+                                                v8::Local<v8::Value> buffer,
+                                                gin::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node::Buffer::HasInstance(buffer)) {
+    promise.RejectWithErrorMessage("buffer must be a node Buffer");
+    return handle;
+  }
+
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  // Copied, since the buffer can be changed while the image is decoded.
+  const auto* data =
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(buffer));
+  std::vector<uint8_t> contents(data, data + node::Buffer::Length(buffer));
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&DecodeReps, std::move(contents), width, height,
+                     scale_factor),
+      base::BindOnce(
+          [](gin_helper::Promise<gfx::Image> promise,
+             const std::vector<gfx::ImageSkiaRep>& reps) {
+            promise.Resolve(CreateImageFromReps(reps));
+          },
+          std::move(promise)));
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  gin_helper::Promise<gin::Handle<NativeImage>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageFileTaskTraits, base::BindOnce(&LoadReps, path),
+      base::BindOnce(
+          [](gin_helper::Promise<gin::Handle<NativeImage>> promise,
+             ImageFromPath image) {
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+#if BUILDFLAG(IS_WIN)
+            if (image.path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+              promise.Resolve(gin::CreateHandle(
+                  isolate, new NativeImage(isolate, image.path)));
+              return;
+            }
+#endif
+            gin::Handle<NativeImage> native_image =
+                Create(isolate, CreateImageFromReps(image.reps));
+#if BUILDFLAG(IS_MAC)
+            if (IsTemplateFilename(image.path))
+              native_image->SetTemplateImage(true);
+#endif
+            promise.Resolve(native_image);
+          },
+          std::move(promise)));
+  return handle;
+}
+
 // static
 gin::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
                                                         const GURL& url) {
@@ -606,9 +1016,12 @@ gin::ObjectTemplateBuilder NativeImage::GetObjectTemplateBuilder(
   return gin::ObjectTemplateBuilder(isolate, GetTypeName(),
                                     constructor->InstanceTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
+      .SetMethod("getBitmapView", &NativeImage::GetBitmapView)
       .SetMethod("getScaleFactors", &NativeImage::GetScaleFactors)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
       .SetMethod("toDataURL", &NativeImage::ToDataURL)
@@ -619,9 +1032,11 @@ gin::ObjectTemplateBuilder NativeImage::GetObjectTemplateBuilder(
       .SetProperty("isMacTemplateImage", &NativeImage::IsTemplateImage,
                    &NativeImage::SetTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
-      .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
+      .SetMethod("addRepresentation", &NativeImage::AddRepresentation)
+      .SetMethod("release", &NativeImage::Release);
 }
 
 const char* NativeImage::GetTypeName() {
@@ -651,6 +1066,10 @@ void Initialize(v8::Local<v8::Object> exports,
   native_image.SetMethod("createFromBitmap", &NativeImage::CreateFromBitmap);
   native_image.SetMethod("createFromBuffer", &NativeImage::CreateFromBuffer);
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
+  native_image.SetMethod("decodeAsync", &NativeImage::DecodeAsync);
+  native_image.SetMethod("createFromPathAsync",
+                         &NativeImage::CreateFromPathAsync);
+  native_image.SetMethod("resizeImages", &NativeImage::ResizeImages);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
 #if !BUILDFLAG(IS_LINUX)
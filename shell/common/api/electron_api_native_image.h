@@ -5,6 +5,7 @@
 #ifndef ELECTRON_SHELL_COMMON_API_ELECTRON_API_NATIVE_IMAGE_H_
 #define ELECTRON_SHELL_COMMON_API_ELECTRON_API_NATIVE_IMAGE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/common/gin_helper/error_thrower.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/image/image_skia_rep.h"
 
@@ -70,12 +72,30 @@ class NativeImage : public gin::Wrappable<NativeImage> {
       gin_helper::ErrorThrower thrower,
       v8::Local<v8::Value> buffer,
       const gin_helper::Dictionary& options);
+  // Creates an image whose pixels are the memory of |buffer|, which must hold
+  // the bytes of |info|. Returns an empty handle when the memory can't be
+  // used, e.g. because it is not aligned.
+  static gin::Handle<NativeImage> CreateFromSharedBuffer(
+      v8::Isolate* isolate,
+      v8::Local<v8::ArrayBufferView> buffer,
+      const SkImageInfo& info,
+      double scale_factor);
   static gin::Handle<NativeImage> CreateFromBuffer(
       gin_helper::ErrorThrower thrower,
       v8::Local<v8::Value> buffer,
       gin::Arguments* args);
   static gin::Handle<NativeImage> CreateFromDataURL(v8::Isolate* isolate,
                                                     const GURL& url);
+  // Reads and decodes the file on the thread pool.
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
+  static v8::Local<v8::Promise> DecodeAsync(v8::Isolate* isolate,
+                                            v8::Local<v8::Value> buffer,
+                                            gin::Arguments* args);
+  static v8::Local<v8::Promise> ResizeImages(
+      v8::Isolate* isolate,
+      const std::vector<gin_helper::Dictionary>& requests);
   static gin::Handle<NativeImage> CreateFromNamedImage(gin::Arguments* args,
                                                        std::string name);
 #if !BUILDFLAG(IS_LINUX)
@@ -107,19 +127,25 @@ class NativeImage : public gin::Wrappable<NativeImage> {
 
  private:
   v8::Local<v8::Value> ToPNG(gin::Arguments* args);
+  v8::Local<v8::Promise> ToPNGAsync(gin::Arguments* args);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
   v8::Local<v8::Value> ToBitmap(gin::Arguments* args);
   std::vector<float> GetScaleFactors();
   v8::Local<v8::Value> GetBitmap(gin::Arguments* args);
+  v8::Local<v8::Value> GetBitmapView(gin::Arguments* args);
   v8::Local<v8::Value> GetNativeHandle(gin_helper::ErrorThrower thrower);
   gin::Handle<NativeImage> Resize(gin::Arguments* args,
                                   base::Value::Dict options);
+  v8::Local<v8::Promise> ResizeAsync(gin::Arguments* args,
+                                     base::Value::Dict options);
   gin::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(gin::Arguments* args);
   bool IsEmpty();
   gfx::Size GetSize(const std::optional<float> scale_factor);
   float GetAspectRatio(const std::optional<float> scale_factor);
   void AddRepresentation(const gin_helper::Dictionary& options);
+  void Release();
 
   void UpdateExternalAllocatedMemoryUsage();
 
@@ -137,6 +163,10 @@ class NativeImage : public gin::Wrappable<NativeImage> {
 
   gfx::Image image_;
 
+  // The memory of the Buffer that the pixels of the image point into, when
+  // it was created by createFromBitmap() with the shared option.
+  std::shared_ptr<v8::BackingStore> pixel_store_;
+
   raw_ptr<v8::Isolate> isolate_;
   int32_t memory_usage_ = 0;
 };
@@ -56,16 +56,23 @@ v8::Local<v8::Promise> ResolveHost(
           [](gin_helper::Promise<gin_helper::Dictionary> promise,
              int64_t net_error, const std::optional<net::AddressList>& addrs) {
             if (net_error < 0) {
-              promise.RejectWithErrorMessage(net::ErrorToString(net_error));
-            } else {
-              DCHECK(addrs.has_value() && !addrs->empty());
-
-              v8::HandleScope handle_scope(promise.isolate());
-              auto dict =
-                  gin_helper::Dictionary::CreateEmpty(promise.isolate());
-              dict.Set("endpoints", addrs->endpoints());
-              promise.Resolve(dict);
+              gin_helper::Promise<gin_helper::Dictionary>::RejectPromise(
+                  std::move(promise), net::ErrorToString(net_error));
+              return;
             }
+
+            DCHECK(addrs.has_value() && !addrs->empty());
+            // Bulk lookups complete together, so they are resolved at once.
+            gin_helper::PromiseBase::SettleInBatch(base::BindOnce(
+                [](gin_helper::Promise<gin_helper::Dictionary> promise,
+                   const net::AddressList& addrs) {
+                  v8::HandleScope handle_scope(promise.isolate());
+                  auto dict =
+                      gin_helper::Dictionary::CreateEmpty(promise.isolate());
+                  dict.Set("endpoints", addrs.endpoints());
+                  promise.Resolve(dict);
+                },
+                std::move(promise), *addrs));
           },
           std::move(promise)));
 
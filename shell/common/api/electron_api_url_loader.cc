@@ -16,12 +16,16 @@
 #include "base/no_destructor.h"
 #include "base/sequence_checker.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "net/base/isolation_info.h"
 #include "net/base/load_flags.h"
+#include "net/base/load_timing_info.h"
+#include "net/base/request_priority.h"
 #include "net/http/http_util.h"
 #include "net/url_request/redirect_util.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -35,9 +39,11 @@
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/net/asar/asar_url_loader_factory.h"
+#include "shell/browser/net/network_stats.h"
 #include "shell/browser/net/proxying_url_loader_factory.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -318,6 +324,11 @@ const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
           setting: "This feature cannot be disabled."
         })");
 
+// When downloading to a file no one needs to see every chunk, so progress is
+// reported at most this often.
+constexpr base::TimeDelta kDownloadToFileProgressInterval =
+    base::Milliseconds(100);
+
 }  // namespace
 
 gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
@@ -326,10 +337,14 @@ gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     ElectronBrowserContext* browser_context,
     std::unique_ptr<network::ResourceRequest> request,
-    int options)
+    int options,
+    const base::FilePath& download_path,
+    std::optional<UploadFile> upload_file)
     : browser_context_(browser_context),
       request_options_(options),
-      request_(std::move(request)) {
+      request_(std::move(request)),
+      download_path_(download_path),
+      upload_file_(std::move(upload_file)) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
   if (!request_->trusted_params)
     request_->trusted_params = network::ResourceRequest::TrustedParams();
@@ -365,6 +380,9 @@ void SimpleURLLoaderWrapper::Start() {
 
   if (request_body)
     request_ref->request_body = std::move(request_body);
+  else if (upload_file_)
+    loader_->AttachFileForUpload(upload_file_->path, upload_file_->offset,
+                                 upload_file_->length);
 
   loader_->SetAllowHttpErrorResults(true);
   loader_->SetURLLoaderFactoryOptions(request_options_);
@@ -378,7 +396,17 @@ void SimpleURLLoaderWrapper::Start() {
       &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
 
   url_loader_factory_ = GetURLLoaderFactoryForURL(request_ref->url);
-  loader_->DownloadAsStream(url_loader_factory_.get(), this);
+  if (!download_path_.empty()) {
+    // The body is written to disk on a background sequence and never reaches
+    // V8.
+    loader_->DownloadToFile(
+        url_loader_factory_.get(),
+        base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadedToFile,
+                       base::Unretained(this)),
+        download_path_);
+  } else {
+    loader_->DownloadAsStream(url_loader_factory_.get(), this);
+  }
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -497,10 +525,8 @@ SimpleURLLoaderWrapper::GetURLLoaderFactoryForURL(const GURL& url) {
             std::move(pending_remote)));
   } else if (!bypass_custom_protocol_handlers &&
              protocol_registry->IsProtocolRegistered(url.scheme())) {
-    auto& protocol_handler = protocol_registry->handlers().at(url.scheme());
     mojo::PendingRemote<network::mojom::URLLoaderFactory> pending_remote =
-        ElectronURLLoaderFactory::Create(protocol_handler.first,
-                                         protocol_handler.second);
+        protocol_registry->GetURLLoaderFactory(url.scheme());
     url_loader_factory = network::SharedURLLoaderFactory::Create(
         std::make_unique<network::WrapperPendingSharedURLLoaderFactory>(
             std::move(pending_remote)));
@@ -589,6 +615,34 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
       request->destination = iter->second;
   }
 
+  // A request for the document of a main frame gets the isolation info of a
+  // navigation to it, so that the navigation can be served from the entry it
+  // leaves in the partitioned HTTP cache.
+  if (request->mode == network::mojom::RequestMode::kNavigate &&
+      request->destination == network::mojom::RequestDestination::kDocument) {
+    url::Origin origin = url::Origin::Create(request->url);
+    if (!request->trusted_params)
+      request->trusted_params = network::ResourceRequest::TrustedParams();
+    request->trusted_params->isolation_info = net::IsolationInfo::Create(
+        net::IsolationInfo::RequestType::kMainFrame, origin, origin,
+        net::SiteForCookies::FromOrigin(origin));
+  }
+
+  if (std::string priority; opts.Get("priority", &priority)) {
+    static constexpr auto Lookup =
+        base::MakeFixedFlatMap<std::string_view, net::RequestPriority>({
+            {"highest", net::HIGHEST},
+            {"idle", net::IDLE},
+            {"low", net::LOW},
+            {"lowest", net::LOWEST},
+            {"medium", net::MEDIUM},
+            {"throttled", net::THROTTLED},
+        });
+    if (auto* iter = Lookup.find(priority); iter != Lookup.end())
+      request->priority = iter->second;
+  }
+  opts.Get("priorityIncremental", &request->priority_incremental);
+
   bool credentials_specified =
       opts.Get("credentials", &request->credentials_mode);
   std::vector<std::pair<std::string, std::string>> extra_headers;
@@ -675,6 +729,26 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
     }
   }
 
+  std::optional<UploadFile> upload_file;
+  gin_helper::Dictionary upload_file_dict;
+  if (opts.Get("uploadFile", &upload_file_dict)) {
+    upload_file.emplace();
+    if (!upload_file_dict.Get("path", &upload_file->path) ||
+        !upload_file->path.IsAbsolute()) {
+      args->ThrowTypeError("uploadFile path must be an absolute path");
+      return gin::Handle<SimpleURLLoaderWrapper>();
+    }
+    upload_file_dict.Get("offset", &upload_file->offset);
+    upload_file_dict.Get("length", &upload_file->length);
+  }
+
+  base::FilePath download_path;
+  if (opts.Get("downloadToFile", &download_path) &&
+      !download_path.IsAbsolute()) {
+    args->ThrowTypeError("downloadToFile must be an absolute path");
+    return gin::Handle<SimpleURLLoaderWrapper>();
+  }
+
   ElectronBrowserContext* browser_context = nullptr;
   if (electron::IsBrowserProcess()) {
     std::string partition;
@@ -690,7 +764,8 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
 
   auto ret = gin::CreateHandle(
       args->isolate(),
-      new SimpleURLLoaderWrapper(browser_context, std::move(request), options));
+      new SimpleURLLoaderWrapper(browser_context, std::move(request), options,
+                                 download_path, std::move(upload_file)));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
@@ -711,6 +786,19 @@ void SimpleURLLoaderWrapper::OnDataReceived(std::string_view string_piece,
 }
 
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
+  // There is no session in the utility process.
+  if (browser_context_) {
+    NetworkStats* network_stats = browser_context_->network_stats();
+    const network::mojom::URLResponseHead* head = loader_->ResponseInfo();
+    GURL url = head ? loader_->GetFinalURL() : request_->url;
+    network_stats->RecordRequest(
+        url, loader_->NetError(), head && head->was_fetched_via_cache,
+        loader_->GetContentSize(),
+        head ? head->load_timing : net::LoadTimingInfo());
+    if (head)
+      network_stats->RecordProtocol(url, head->alpn_negotiated_protocol);
+  }
+
   if (success) {
     Emit("complete");
   } else {
@@ -735,6 +823,24 @@ void SimpleURLLoaderWrapper::OnResponseStarted(
   dict.Set("headers", response_head.headers.get());
   dict.Set("rawHeaders", response_head.raw_response_headers);
   dict.Set("mimeType", response_head.mime_type);
+
+  // Lets callers tell whether requests are being multiplexed over pooled
+  // connections or each pay for a new one.
+  const net::LoadTimingInfo& load_timing = response_head.load_timing;
+  auto connection_info = gin::Dictionary::CreateEmpty(isolate);
+  connection_info.Set("protocol", response_head.alpn_negotiated_protocol);
+  connection_info.Set("socketReused", load_timing.socket_reused);
+  double connect_time = 0;
+  if (!load_timing.connect_timing.connect_start.is_null() &&
+      !load_timing.connect_timing.connect_end.is_null()) {
+    connect_time = (load_timing.connect_timing.connect_end -
+                    load_timing.connect_timing.connect_start)
+                       .InMillisecondsF();
+  }
+  connection_info.Set("connectTime", connect_time);
+  connection_info.Set("remoteAddress",
+                      response_head.remote_endpoint.address().ToString());
+  dict.Set("connectionInfo", connection_info);
   Emit("response-started", final_url, dict);
 }
 
@@ -767,6 +873,7 @@ void SimpleURLLoaderWrapper::OnRedirect(
   if (should_clear_upload) {
     // The request body is no longer applicable.
     request_->request_body.reset();
+    upload_file_.reset();
   }
 
   request_->url = redirect_info.new_url;
@@ -791,9 +898,22 @@ void SimpleURLLoaderWrapper::OnUploadProgress(uint64_t position,
 }
 
 void SimpleURLLoaderWrapper::OnDownloadProgress(uint64_t current) {
+  if (!download_path_.empty()) {
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (now - last_download_progress_ < kDownloadToFileProgressInterval)
+      return;
+    last_download_progress_ = now;
+  }
   Emit("download-progress", current);
 }
 
+void SimpleURLLoaderWrapper::OnDownloadedToFile(base::FilePath path) {
+  // Report where the download ended, which throttling may have skipped.
+  if (!path.empty())
+    Emit("download-progress", loader_->GetContentSize());
+  OnComplete(!path.empty());
+}
+
 // static
 gin::ObjectTemplateBuilder SimpleURLLoaderWrapper::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
@@ -5,13 +5,18 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_URL_LOADER_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_URL_LOADER_H_
 
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "net/base/auth.h"
@@ -61,9 +66,19 @@ class SimpleURLLoaderWrapper
   const char* GetTypeName() override;
 
  private:
+  // A range of a file sent as the request body, which SimpleURLLoader streams
+  // into the upload data pipe off the main thread.
+  struct UploadFile {
+    base::FilePath path;
+    uint64_t offset = 0;
+    uint64_t length = std::numeric_limits<uint64_t>::max();
+  };
+
   SimpleURLLoaderWrapper(ElectronBrowserContext* browser_context,
                          std::unique_ptr<network::ResourceRequest> request,
-                         int options);
+                         int options,
+                         const base::FilePath& download_path,
+                         std::optional<UploadFile> upload_file);
 
   // SimpleURLLoaderStreamConsumer:
   void OnDataReceived(base::StringPiece string_piece,
@@ -131,6 +146,7 @@ class SimpleURLLoaderWrapper
                   std::vector<std::string>* removed_headers);
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
+  void OnDownloadedToFile(base::FilePath path);
 
   void Start();
   void Pin();
@@ -140,6 +156,12 @@ class SimpleURLLoaderWrapper
   raw_ptr<ElectronBrowserContext> browser_context_;
   int request_options_;
   std::unique_ptr<network::ResourceRequest> request_;
+  // When set, the body is written to this file by the network stack instead
+  // of being streamed to JS.
+  base::FilePath download_path_;
+  // When set, the body is read from this file instead of |request_|.
+  std::optional<UploadFile> upload_file_;
+  base::TimeTicks last_download_progress_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   std::unique_ptr<network::SimpleURLLoader> loader_;
   v8::Global<v8::Value> pinned_wrapper_;
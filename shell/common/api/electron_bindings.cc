@@ -10,16 +10,20 @@
 #include <vector>
 
 #include "base/containers/contains.h"
+#include "base/files/file.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "base/system/sys_info.h"
+#include "gin/arguments.h"
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/global_memory_dump.h"
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "shell/browser/browser.h"
 #include "shell/common/application_info.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/heap_snapshot.h"
@@ -48,6 +52,7 @@ void ElectronBindings::BindProcess(v8::Isolate* isolate,
   process->SetMethod("getCreationTime", &GetCreationTime);
   process->SetMethod("getHeapStatistics", &GetHeapStatistics);
   process->SetMethod("getBlinkMemoryInfo", &GetBlinkMemoryInfo);
+  process->SetMethod("getEventEmitterStats", &GetEventEmitterStats);
   if (electron::IsBrowserProcess()) {
     process->SetMethod("getProcessMemoryInfo", &GetProcessMemoryInfo);
   }
@@ -74,6 +79,9 @@ void ElectronBindings::BindTo(v8::Isolate* isolate,
   BindProcess(isolate, &dict, metrics_.get());
 
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
+  dict.SetMethod("saveHeapSnapshot", &SaveHeapSnapshot);
+  dict.SetMethod("startHeapSampling", &StartHeapSampling);
+  dict.SetMethod("stopHeapSampling", &StopHeapSampling);
 #if BUILDFLAG(IS_POSIX)
   dict.SetMethod("setFdLimit", &base::IncreaseFdLimitTo);
 #endif
@@ -217,6 +225,16 @@ v8::Local<v8::Promise> ElectronBindings::GetProcessMemoryInfo(
   return handle;
 }
 
+// static
+v8::Local<v8::Value> ElectronBindings::GetEventEmitterStats(
+    v8::Isolate* isolate) {
+  const gin_helper::EmitStats stats = gin_helper::GetEmitStats();
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("emitted", static_cast<double>(stats.emitted));
+  dict.Set("suppressed", static_cast<double>(stats.suppressed));
+  return dict.GetHandle();
+}
+
 // static
 v8::Local<v8::Value> ElectronBindings::GetBlinkMemoryInfo(
     v8::Isolate* isolate) {
@@ -302,4 +320,73 @@ bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
   return electron::TakeHeapSnapshot(isolate, &file);
 }
 
+// static
+v8::Local<v8::Promise> ElectronBindings::SaveHeapSnapshot(
+    v8::Isolate* isolate,
+    const base::FilePath& file_path,
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string type = "snapshot";
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("type", &type);
+  if (type != "snapshot" && type != "sampling") {
+    promise.RejectWithErrorMessage("type must be 'snapshot' or 'sampling'");
+    return handle;
+  }
+
+  base::File file;
+  {
+    ScopedAllowBlockingForElectron allow_blocking;
+    file = base::File(file_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  }
+
+  auto callback = base::BindOnce(
+      [](gin_helper::Promise<void> promise, std::string type, bool success) {
+        if (success)
+          promise.Resolve();
+        else if (type == "sampling")
+          promise.RejectWithErrorMessage(
+              "Failed to save the heap sampling profile");
+        else
+          promise.RejectWithErrorMessage("Failed to save the heap snapshot");
+      },
+      std::move(promise), type);
+  if (type == "sampling")
+    electron::WriteSamplingHeapProfile(isolate, std::move(file),
+                                       std::move(callback));
+  else
+    electron::TakeHeapSnapshot(isolate, std::move(file), std::move(callback));
+  return handle;
+}
+
+// static
+bool ElectronBindings::StartHeapSampling(v8::Isolate* isolate,
+                                         gin::Arguments* args) {
+  int sampling_interval = 32768;
+  int stack_depth = 16;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sampling_interval);
+    options.Get("stackDepth", &stack_depth);
+  }
+  if (sampling_interval <= 0 || stack_depth <= 0) {
+    args->ThrowTypeError(
+        "samplingInterval and stackDepth must be positive numbers");
+    return false;
+  }
+  // Deeper stacks would exceed the nesting the profile can be written with.
+  stack_depth = std::min(stack_depth, 64);
+  return electron::StartSamplingHeapProfiler(isolate, sampling_interval,
+                                             stack_depth);
+}
+
+// static
+void ElectronBindings::StopHeapSampling(v8::Isolate* isolate) {
+  electron::StopSamplingHeapProfiler(isolate);
+}
+
 }  // namespace electron
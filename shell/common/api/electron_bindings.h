@@ -15,6 +15,10 @@
 #include "shell/common/node_bindings.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 
+namespace gin {
+class Arguments;
+}
+
 namespace gin_helper {
 class Arguments;
 class Dictionary;
@@ -67,10 +71,17 @@ class ElectronBindings {
                                                   gin_helper::Arguments* args);
   static v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetBlinkMemoryInfo(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetEventEmitterStats(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetCPUUsage(base::ProcessMetrics* metrics,
                                           v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
+  static v8::Local<v8::Promise> SaveHeapSnapshot(
+      v8::Isolate* isolate,
+      const base::FilePath& file_path,
+      gin::Arguments* args);
+  static bool StartHeapSampling(v8::Isolate* isolate, gin::Arguments* args);
+  static void StopHeapSampling(v8::Isolate* isolate);
 
   void ActivateUVLoop(v8::Isolate* isolate);
 
@@ -4,22 +4,40 @@
 
 #include "shell/common/asar/archive.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "base/check.h"
+#include "base/containers/contains.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/numerics/checked_math.h"
 #include "base/pickle.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "crypto/sha2.h"
 #include "base/values.h"
 #include "electron/fuses.h"
+#include "shell/common/asar/archive_index.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/asar/batched_reader.h"
+#include "shell/common/asar/extraction_cache.h"
 #include "shell/common/asar/scoped_temporary_file.h"
+#include "shell/common/startup_metrics.h"
 #include "shell/common/thread_restrictions.h"
+#include "third_party/brotli/include/brotli/decode.h"
 
 #if BUILDFLAG(IS_WIN)
 #include <io.h>
@@ -86,6 +104,44 @@ const base::Value::Dict* GetNodeFromPath(std::string path,
   return GetChildNode(root, path, *dir);
 }
 
+// How many decompressed blocks are cached per archive, 4MB for 64KB blocks.
+constexpr size_t kDecompressedBlockCacheSize = 64;
+
+// Larger blocks would make the cache hold too much memory.
+constexpr int kMaxCompressionBlockSize = 1024 * 1024;
+
+bool FillCompressionWithNode(Archive::FileInfo* info,
+                             const base::Value::Dict* node) {
+  const std::string* algorithm = node->FindString("algorithm");
+  std::optional<int> block_size = node->FindInt("blockSize");
+  const base::Value::List* blocks = node->FindList("blocks");
+  if (!algorithm || *algorithm != "brotli" || !block_size ||
+      *block_size <= 0 || *block_size > kMaxCompressionBlockSize || !blocks) {
+    return false;
+  }
+
+  // Every block but the last holds |block_size| bytes.
+  const size_t block_count =
+      info->size == 0 ? 0 : (info->size - 1) / *block_size + 1;
+  if (blocks->size() != block_count)
+    return false;
+
+  CompressionPayload compression;
+  compression.algorithm = CompressionAlgorithm::kBrotli;
+  compression.block_size = static_cast<uint32_t>(*block_size);
+  compression.block_offsets.reserve(block_count + 1);
+  compression.block_offsets.push_back(0);
+  for (const base::Value& value : *blocks) {
+    std::optional<int> compressed_size = value.GetIfInt();
+    if (!compressed_size || *compressed_size <= 0)
+      return false;
+    compression.block_offsets.push_back(compression.block_offsets.back() +
+                                        *compressed_size);
+  }
+  info->compression = std::move(compression);
+  return true;
+}
+
 bool FillFileInfoWithNode(Archive::FileInfo* info,
                           uint32_t header_size,
                           bool load_integrity,
@@ -115,6 +171,11 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
     info->executable = *executable;
   }
 
+  if (const base::Value::Dict* compression = node->FindDict("compression")) {
+    if (!FillCompressionWithNode(info, compression))
+      return false;
+  }
+
 #if BUILDFLAG(IS_MAC)
   if (load_integrity &&
       electron::fuses::IsEmbeddedAsarIntegrityValidationEnabled()) {
@@ -150,6 +211,14 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
   }
 #endif
 
+  // Each decompressed block is validated against the integrity block it
+  // matches.
+  if (info->compression && info->integrity &&
+      info->compression->block_size != info->integrity->block_size) {
+    LOG(FATAL) << "Compressed blocks of file in ASAR archive do not match its "
+                  "integrity blocks";
+  }
+
   return true;
 }
 
@@ -160,12 +229,21 @@ IntegrityPayload::IntegrityPayload()
 IntegrityPayload::~IntegrityPayload() = default;
 IntegrityPayload::IntegrityPayload(const IntegrityPayload& other) = default;
 
+CompressionPayload::CompressionPayload()
+    : algorithm(CompressionAlgorithm::kBrotli), block_size(0) {}
+CompressionPayload::~CompressionPayload() = default;
+CompressionPayload::CompressionPayload(const CompressionPayload& other) =
+    default;
+
 Archive::FileInfo::FileInfo()
     : unpacked(false), executable(false), size(0), offset(0) {}
 Archive::FileInfo::~FileInfo() = default;
 
 Archive::Archive(const base::FilePath& path)
-    : initialized_(false), path_(path), file_(base::File::FILE_OK) {
+    : initialized_(false),
+      path_(path),
+      file_(base::File::FILE_OK),
+      decompressed_blocks_(kDecompressedBlockCacheSize) {
   electron::ScopedAllowBlockingForElectron allow_blocking;
   file_.Initialize(path_, base::File::FLAG_OPEN | base::File::FLAG_READ);
 #if BUILDFLAG(IS_WIN)
@@ -192,6 +270,14 @@ bool Archive::Init() {
   CHECK(!initialized_);
   initialized_ = true;
 
+  TRACE_EVENT0("electron", "Archive::Init");
+  base::ScopedClosureRunner record_init_time(base::BindOnce(
+      [](base::TimeTicks start) {
+        electron::startup_metrics::RecordArchiveInit(base::TimeTicks::Now() -
+                                                     start);
+      },
+      base::TimeTicks::Now()));
+
   if (!file_.IsValid()) {
     if (file_.error_details() != base::File::FILE_ERROR_NOT_FOUND) {
       LOG(WARNING) << "Opening " << path_.value() << ": "
@@ -262,6 +348,29 @@ bool Archive::Init() {
   }
 #endif
 
+  if (electron::fuses::IsAsarCodeCacheEnabled()) {
+    base::File::Info file_info;
+    {
+      electron::ScopedAllowBlockingForElectron allow_blocking;
+      file_.GetInfo(&file_info);
+    }
+    cache_key_ = base::StrCat(
+        {base::ToLowerASCII(base::HexEncode(crypto::SHA256HashString(header))),
+         ":", base::NumberToString(file_info.size), ":",
+         base::NumberToString(
+             file_info.last_modified.InMillisecondsSinceUnixEpoch())});
+  }
+
+  if (ArchiveIndex::IsIndex(header)) {
+    index_ = ArchiveIndex::Parse(std::move(header));
+    if (!index_) {
+      LOG(ERROR) << "Failed to parse binary header";
+      return false;
+    }
+    header_size_ = 8 + size;
+    return true;
+  }
+
   std::optional<base::Value> value = base::JSONReader::Read(header);
   if (!value || !value->is_dict()) {
     LOG(ERROR) << "Failed to parse header";
@@ -284,6 +393,21 @@ std::optional<base::FilePath> Archive::RelativePath() const {
 #endif
 
 bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
+  if (index_) {
+    std::optional<ArchiveIndex::Entry> entry =
+        index_->FindEntry(path.AsUTF8Unsafe());
+    if (!entry)
+      return false;
+
+    if (entry->type == ArchiveIndex::Type::kLink) {
+      return GetFileInfo(base::FilePath::FromUTF8Unsafe(
+                             std::string(index_->GetLinkTarget(*entry))),
+                         info);
+    }
+
+    return index_->FillFileInfo(*entry, header_size_, header_validated_, info);
+  }
+
   if (!header_)
     return false;
 
@@ -300,6 +424,25 @@ bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) const {
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) const {
+  if (index_) {
+    std::optional<ArchiveIndex::Entry> entry =
+        index_->FindEntry(path.AsUTF8Unsafe());
+    if (!entry)
+      return false;
+
+    switch (entry->type) {
+      case ArchiveIndex::Type::kLink:
+        stats->type = FileType::kLink;
+        return true;
+      case ArchiveIndex::Type::kDirectory:
+        stats->type = FileType::kDirectory;
+        return true;
+      case ArchiveIndex::Type::kFile:
+        return index_->FillFileInfo(*entry, header_size_, header_validated_,
+                                    stats);
+    }
+  }
+
   if (!header_)
     return false;
 
@@ -323,6 +466,21 @@ bool Archive::Stat(const base::FilePath& path, Stats* stats) const {
 
 bool Archive::Readdir(const base::FilePath& path,
                       std::vector<base::FilePath>* files) const {
+  if (index_) {
+    std::optional<ArchiveIndex::Entry> entry =
+        index_->FindEntry(path.AsUTF8Unsafe());
+    if (!entry || entry->type == ArchiveIndex::Type::kFile)
+      return false;
+
+    std::vector<std::string_view> names = index_->GetChildNames(*entry);
+    if (names.empty() && entry->type == ArchiveIndex::Type::kLink)
+      return false;
+
+    for (std::string_view name : names)
+      files->push_back(base::FilePath::FromUTF8Unsafe(name));
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -340,8 +498,107 @@ bool Archive::Readdir(const base::FilePath& path,
   return true;
 }
 
+bool Archive::ReaddirWithTypes(const base::FilePath& path,
+                               bool recursive,
+                               std::vector<DirectoryEntry>* entries) const {
+  TRACE_EVENT1("electron", "Archive::ReaddirWithTypes", "recursive",
+               recursive);
+  if (index_) {
+    std::optional<ArchiveIndex::Entry> entry =
+        index_->FindEntry(path.AsUTF8Unsafe());
+    if (!entry || entry->type == ArchiveIndex::Type::kFile)
+      return false;
+
+    // The directories left to read, with their path relative to |path|.
+    std::vector<std::pair<ArchiveIndex::Entry, base::FilePath>> dirs = {
+        {*entry, base::FilePath()}};
+    for (size_t i = 0; i < dirs.size(); ++i) {
+      std::vector<ArchiveIndex::Entry> children =
+          index_->GetChildren(dirs[i].first);
+      if (i == 0 && children.empty() &&
+          entry->type == ArchiveIndex::Type::kLink)
+        return false;
+
+      for (const ArchiveIndex::Entry& child : children) {
+        DirectoryEntry result;
+        result.name = dirs[i].second.Append(
+            base::FilePath::FromUTF8Unsafe(index_->GetName(child)));
+        switch (child.type) {
+          case ArchiveIndex::Type::kLink:
+            result.type = FileType::kLink;
+            break;
+          case ArchiveIndex::Type::kDirectory:
+            result.type = FileType::kDirectory;
+            if (recursive)
+              dirs.emplace_back(child, result.name);
+            break;
+          case ArchiveIndex::Type::kFile:
+            result.type = FileType::kFile;
+            result.size = child.size;
+            break;
+        }
+        entries->push_back(std::move(result));
+      }
+    }
+    return true;
+  }
+
+  if (!header_)
+    return false;
+
+  const base::Value::Dict* node =
+      GetNodeFromPath(path.AsUTF8Unsafe(), *header_);
+  if (!node)
+    return false;
+
+  const base::Value::Dict* files_node = GetFilesNode(*header_, *node);
+  if (!files_node)
+    return false;
+
+  std::vector<std::pair<const base::Value::Dict*, base::FilePath>> dirs = {
+      {files_node, base::FilePath()}};
+  for (size_t i = 0; i < dirs.size(); ++i) {
+    for (const auto [name, value] : *dirs[i].first) {
+      const base::Value::Dict* child = value.GetIfDict();
+      if (!child)
+        continue;
+
+      DirectoryEntry result;
+      result.name =
+          dirs[i].second.Append(base::FilePath::FromUTF8Unsafe(name));
+      if (child->Find("link")) {
+        result.type = FileType::kLink;
+      } else if (const base::Value::Dict* files = child->FindDict("files")) {
+        result.type = FileType::kDirectory;
+        if (recursive)
+          dirs.emplace_back(files, result.name);
+      } else {
+        result.type = FileType::kFile;
+        result.size = child->FindInt("size").value_or(0);
+      }
+      entries->push_back(std::move(result));
+    }
+  }
+  return true;
+}
+
 bool Archive::Realpath(const base::FilePath& path,
                        base::FilePath* realpath) const {
+  if (index_) {
+    std::optional<ArchiveIndex::Entry> entry =
+        index_->FindEntry(path.AsUTF8Unsafe());
+    if (!entry)
+      return false;
+
+    if (entry->type == ArchiveIndex::Type::kLink) {
+      *realpath = base::FilePath::FromUTF8Unsafe(index_->GetLinkTarget(*entry));
+      return true;
+    }
+
+    *realpath = path;
+    return true;
+  }
+
   if (!header_)
     return false;
 
@@ -361,7 +618,7 @@ bool Archive::Realpath(const base::FilePath& path,
 }
 
 bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
-  if (!header_)
+  if (!header_ && !index_)
     return false;
 
   base::AutoLock auto_lock(external_files_lock_);
@@ -371,6 +628,11 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
     *out = it->second->path();
     return true;
   }
+  auto cached_it = cached_files_.find(path.value());
+  if (cached_it != cached_files_.end()) {
+    *out = cached_it->second;
+    return true;
+  }
 
   FileInfo info;
   if (!GetFileInfo(path, &info))
@@ -381,11 +643,29 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
     return true;
   }
 
+  // The shared cache holds the files as they are stored in the archive.
+  base::FilePath cached_path;
+  if (!info.compression &&
+      ExtractToCache(&file_, path.Extension(), info.offset, info.size,
+                     info.integrity, info.executable, &cached_path)) {
+    *out = cached_path;
+    cached_files_[path.value()] = std::move(cached_path);
+    return true;
+  }
+
   auto temp_file = std::make_unique<ScopedTemporaryFile>();
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
-                               info.integrity))
+  if (info.compression) {
+    std::string contents;
+    if (!ReadCompressedFile(info, &contents) || !temp_file->Init(ext))
+      return false;
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!base::WriteFile(temp_file->path(), contents))
+      return false;
+  } else if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
+                                      info.integrity)) {
     return false;
+  }
 
 #if BUILDFLAG(IS_POSIX)
   if (info.executable) {
@@ -403,4 +683,246 @@ int Archive::GetUnsafeFD() const {
   return fd_;
 }
 
+std::optional<base::span<const uint8_t>> Archive::GetMappedFileSpan(
+    const base::FilePath& path) {
+  FileInfo info;
+  if (!GetFileInfo(path, &info) || info.unpacked || info.compression)
+    return std::nullopt;
+
+  base::AutoLock auto_lock(mapped_file_lock_);
+  if (!mapped_file_) {
+    if (mapping_failed_)
+      return std::nullopt;
+
+    auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+    {
+      electron::ScopedAllowBlockingForElectron allow_blocking;
+      if (!mapped_file->Initialize(file_.Duplicate())) {
+        LOG(WARNING) << "Failed to map " << path_.value();
+        mapping_failed_ = true;
+        return std::nullopt;
+      }
+    }
+    mapped_file_ = std::move(mapped_file);
+  }
+
+  base::CheckedNumeric<uint64_t> end = info.offset;
+  end += info.size;
+  if (!end.IsValid() || end.ValueOrDie() > mapped_file_->length())
+    return std::nullopt;
+
+  base::span<const uint8_t> span =
+      base::make_span(mapped_file_->data(), mapped_file_->length())
+          .subspan(info.offset, info.size);
+
+  if (info.integrity.has_value() &&
+      !base::Contains(validated_offsets_, info.offset)) {
+    ValidateIntegrityOrDie(reinterpret_cast<const char*>(span.data()),
+                           span.size(), info.integrity.value());
+    validated_offsets_.insert(info.offset);
+  }
+
+  return span;
+}
+
+scoped_refptr<BatchedReader> Archive::GetBatchedReader() {
+  base::AutoLock auto_lock(batched_reader_lock_);
+  if (!batched_reader_)
+    batched_reader_ = base::MakeRefCounted<BatchedReader>(file_.Duplicate());
+  return batched_reader_;
+}
+
+bool Archive::ReadCompressed(const FileInfo& info,
+                             uint64_t offset,
+                             base::span<uint8_t> out) {
+  DCHECK(info.compression);
+  base::CheckedNumeric<uint64_t> end = offset;
+  end += out.size();
+  if (!end.IsValid() || end.ValueOrDie() > info.size)
+    return false;
+
+  const uint32_t block_size = info.compression->block_size;
+  while (!out.empty()) {
+    const uint32_t block = static_cast<uint32_t>(offset / block_size);
+    std::shared_ptr<const std::string> data = GetDecompressedBlock(info, block);
+    if (!data)
+      return false;
+    const size_t start = static_cast<size_t>(offset % block_size);
+    const size_t size = std::min(out.size(), data->size() - start);
+    std::copy_n(data->data() + start, size, out.data());
+    out = out.subspan(size);
+    offset += size;
+  }
+  return true;
+}
+
+bool Archive::ReadCompressedFile(const FileInfo& info, std::string* contents) {
+  contents->resize(info.size);
+  return ReadCompressed(info, 0,
+                        base::as_writable_bytes(base::make_span(*contents)));
+}
+
+std::shared_ptr<const std::string> Archive::GetDecompressedBlock(
+    const FileInfo& info,
+    uint32_t block) {
+  const CompressionPayload& compression = info.compression.value();
+  if (block + 1 >= compression.block_offsets.size())
+    return nullptr;
+
+  const auto key = std::make_pair(info.offset, block);
+  {
+    base::AutoLock auto_lock(decompressed_blocks_lock_);
+    auto it = decompressed_blocks_.Get(key);
+    if (it != decompressed_blocks_.end())
+      return it->second;
+  }
+
+  TRACE_EVENT1("electron", "Archive::GetDecompressedBlock", "block", block);
+  const uint64_t compressed_offset =
+      info.offset + compression.block_offsets[block];
+  std::vector<uint8_t> compressed(compression.block_offsets[block + 1] -
+                                  compression.block_offsets[block]);
+  {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (!file_.ReadAndCheck(compressed_offset, compressed))
+      return nullptr;
+  }
+
+  const uint64_t block_start = uint64_t{block} * compression.block_size;
+  std::string decompressed(
+      std::min<uint64_t>(compression.block_size, info.size - block_start),
+      '\0');
+  size_t decompressed_size = decompressed.size();
+  if (BrotliDecoderDecompress(
+          compressed.size(), compressed.data(), &decompressed_size,
+          reinterpret_cast<uint8_t*>(decompressed.data())) !=
+          BROTLI_DECODER_RESULT_SUCCESS ||
+      decompressed_size != decompressed.size()) {
+    LOG(ERROR) << "Failed to decompress block " << block << " of a file in "
+               << path_.value();
+    return nullptr;
+  }
+
+  if (info.integrity.has_value() && !IsBlockVerified(info.offset, block)) {
+    const IntegrityPayload& integrity = info.integrity.value();
+    const std::string digest = crypto::SHA256HashString(decompressed);
+    const std::string hash =
+        base::ToLowerASCII(base::HexEncode(digest.data(), digest.size()));
+    if (block >= integrity.blocks.size() || hash != integrity.blocks[block]) {
+      LOG(FATAL) << "Integrity check failed for compressed block of asar "
+                    "archive";
+    }
+    MarkBlockVerified(info.offset, block);
+  }
+
+  auto data = std::make_shared<const std::string>(std::move(decompressed));
+  base::AutoLock auto_lock(decompressed_blocks_lock_);
+  decompressed_blocks_.Put(key, data);
+  return data;
+}
+
+bool Archive::IsBlockVerified(uint64_t file_offset, uint32_t block) const {
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  auto it = verified_blocks_.find(file_offset);
+  return it != verified_blocks_.end() && block < it->second.size() &&
+         it->second[block];
+}
+
+void Archive::MarkBlockVerified(uint64_t file_offset, uint32_t block) {
+  base::AutoLock auto_lock(verified_blocks_lock_);
+  std::vector<bool>& blocks = verified_blocks_[file_offset];
+  if (block >= blocks.size())
+    blocks.resize(block + 1);
+  blocks[block] = true;
+}
+
+std::optional<base::FilePath> Archive::ResolveModule(
+    const base::FilePath& parent_dir,
+    const std::string& request) {
+  base::AutoLock auto_lock(module_index_lock_);
+  if (!module_index_loaded_) {
+    module_index_loaded_ = true;
+    module_index_ =
+        ReadJSONFile(base::FilePath::FromASCII(kModuleIndexFileName));
+  }
+
+  if (!module_index_)
+    return std::nullopt;
+
+  // The index always uses forward slashes and "" for the archive root.
+  std::string parent = parent_dir.NormalizePathSeparatorsTo('/').AsUTF8Unsafe();
+  if (parent == ".")
+    parent.clear();
+
+  const base::Value::Dict* requests = module_index_->FindDict(parent);
+  if (!requests)
+    return std::nullopt;
+
+  const std::string* resolved = requests->FindString(request);
+  if (!resolved)
+    return std::nullopt;
+
+  return base::FilePath::FromUTF8Unsafe(*resolved).NormalizePathSeparators();
+}
+
+std::vector<base::FilePath> Archive::TakePrefetchList(
+    const base::FilePath& document) {
+  base::AutoLock auto_lock(prefetch_manifest_lock_);
+  if (!prefetch_manifest_loaded_) {
+    prefetch_manifest_loaded_ = true;
+    prefetch_manifest_ =
+        ReadJSONFile(base::FilePath::FromASCII(kPrefetchManifestFileName));
+  }
+
+  std::vector<base::FilePath> result;
+  if (!prefetch_manifest_)
+    return result;
+
+  // The manifest always uses forward slashes.
+  std::optional<base::Value> resources = prefetch_manifest_->Extract(
+      document.NormalizePathSeparatorsTo('/').AsUTF8Unsafe());
+  if (!resources || !resources->is_list())
+    return result;
+
+  for (const base::Value& resource : resources->GetList()) {
+    if (resource.is_string()) {
+      result.push_back(base::FilePath::FromUTF8Unsafe(resource.GetString())
+                           .NormalizePathSeparators());
+    }
+  }
+  return result;
+}
+
+std::optional<base::Value::Dict> Archive::ReadJSONFile(
+    const base::FilePath& path) {
+  FileInfo info;
+  if (!GetFileInfo(path, &info) || info.unpacked)
+    return std::nullopt;
+
+  std::string contents(info.size, '\0');
+  if (info.compression) {
+    if (!ReadCompressedFile(info, &contents))
+      return std::nullopt;
+  } else {
+    electron::ScopedAllowBlockingForElectron allow_blocking;
+    if (file_.Read(info.offset, contents.data(), contents.size()) !=
+        static_cast<int>(contents.size())) {
+      return std::nullopt;
+    }
+  }
+  // The blocks of compressed files were already validated.
+  if (info.integrity.has_value() && !info.compression) {
+    ValidateIntegrityOrDie(contents.data(), contents.size(),
+                           info.integrity.value());
+  }
+
+  std::optional<base::Value> value = base::JSONReader::Read(contents);
+  if (!value || !value->is_dict()) {
+    LOG(ERROR) << "Failed to parse " << path.value() << " of "
+               << path_.value();
+    return std::nullopt;
+  }
+  return std::move(value->GetDict());
+}
+
 }  // namespace asar
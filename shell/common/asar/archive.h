@@ -5,21 +5,33 @@
 #ifndef ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_H_
 #define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_H_
 
+#include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <uv.h>
 
+#include "base/containers/lru_cache.h"
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/values.h"
 
+namespace base {
+class MemoryMappedFile;
+}
+
 namespace asar {
 
+class ArchiveIndex;
+class BatchedReader;
 class ScopedTemporaryFile;
 
 enum class HashAlgorithm {
@@ -37,6 +49,25 @@ struct IntegrityPayload {
   std::vector<std::string> blocks;
 };
 
+enum class CompressionAlgorithm {
+  kBrotli,
+};
+
+// A packed file stored as a sequence of independently compressed blocks, so
+// that reading part of it only decompresses the blocks the read spans.
+struct CompressionPayload {
+  CompressionPayload();
+  ~CompressionPayload();
+  CompressionPayload(const CompressionPayload& other);
+  CompressionAlgorithm algorithm;
+  // The size of each block before compression, only the last one may be
+  // smaller. Equal to the integrity block size when the file has one.
+  uint32_t block_size;
+  // Where each compressed block starts relative to the file's offset,
+  // followed by where the last one ends.
+  std::vector<uint64_t> block_offsets;
+};
+
 // This class represents an asar package, and provides methods to read
 // information from it. It is thread-safe after |Init| has been called.
 class Archive {
@@ -46,9 +77,11 @@ class Archive {
     ~FileInfo();
     bool unpacked;
     bool executable;
+    // The size of the contents, before compression for compressed files.
     uint32_t size;
     uint64_t offset;
     std::optional<IntegrityPayload> integrity;
+    std::optional<CompressionPayload> compression;
   };
 
   enum class FileType {
@@ -84,10 +117,29 @@ class Archive {
   bool Readdir(const base::FilePath& path,
                std::vector<base::FilePath>* files) const;
 
+  struct DirectoryEntry {
+    // Relative to the directory that was read.
+    base::FilePath name;
+    FileType type = FileType::kFile;
+    // Only set for files.
+    uint64_t size = 0;
+  };
+
+  // Fs.readdir(path, { withFileTypes: true }) along with the size of each
+  // file, in a single walk of the header. When |recursive| the entries of
+  // each subdirectory follow all those of its parent's level, and linked
+  // directories are not descended into, like fs.readdir(path, { recursive })
+  // does.
+  bool ReaddirWithTypes(const base::FilePath& path,
+                        bool recursive,
+                        std::vector<DirectoryEntry>* entries) const;
+
   // Fs.realpath(path).
   bool Realpath(const base::FilePath& path, base::FilePath* realpath) const;
 
-  // Copy the file into a temporary file, and return the new path.
+  // Copy the file out of the archive, and return the new path. The file is
+  // extracted into the cache shared with other processes when possible, see
+  // ExtractToCache(), and into a temporary file otherwise.
   // For unpacked file, this method will return its real path.
   bool CopyFileOut(const base::FilePath& path, base::FilePath* out);
 
@@ -97,22 +149,122 @@ class Archive {
   // for integrity validation after this fd is handed over.
   int GetUnsafeFD() const;
 
+  // Returns the bytes of a packed file straight from a read-only mapping of
+  // the archive, which is created on first use and shared by all callers.
+  // The integrity of each file is validated over the mapped span the first
+  // time it is requested. Returns std::nullopt for unpacked or compressed
+  // files or when the archive could not be mapped. The span is valid for the
+  // Archive's lifetime.
+  std::optional<base::span<const uint8_t>> GetMappedFileSpan(
+      const base::FilePath& path);
+
+  // Returns the reader that reads packed files on the thread pool, created on
+  // first use.
+  scoped_refptr<BatchedReader> GetBatchedReader();
+
+  // Reads |out.size()| bytes of the contents of the compressed file |info|
+  // from |offset|, decompressing only the blocks they span. The most recently
+  // decompressed blocks are cached for all readers, and each block's
+  // integrity is validated the first time it is decompressed.
+  bool ReadCompressed(const FileInfo& info,
+                      uint64_t offset,
+                      base::span<uint8_t> out);
+
+  // Reads all of the contents of the compressed file |info|.
+  bool ReadCompressedFile(const FileInfo& info, std::string* contents);
+
+  // Tracks which integrity blocks of the packed file starting at
+  // |file_offset| have already been validated, so repeated reads of the same
+  // file can skip rehashing them.
+  bool IsBlockVerified(uint64_t file_offset, uint32_t block) const;
+  void MarkBlockVerified(uint64_t file_offset, uint32_t block);
+
+  // Looks up how |request| resolves when required from a module in
+  // |parent_dir| in the archive's pre-generated module resolution index
+  // (|kModuleIndexFileName| at the archive root). Both |parent_dir| and the
+  // result are relative to the archive root. The index is loaded on first use.
+  std::optional<base::FilePath> ResolveModule(const base::FilePath& parent_dir,
+                                              const std::string& request);
+
+  static constexpr char kModuleIndexFileName[] = ".electron-resolve.json";
+
+  // Returns the resources listed for |document| in the archive's prefetch
+  // manifest (|kPrefetchManifestFileName| at the archive root). Both
+  // |document| and the result are relative to the archive root. Each list is
+  // only handed out once, since warming the resources only pays off for the
+  // first load of the document. The manifest is loaded on first use.
+  std::vector<base::FilePath> TakePrefetchList(const base::FilePath& document);
+
+  static constexpr char kPrefetchManifestFileName[] = ".electron-prefetch.json";
+
   base::FilePath path() const { return path_; }
 
+  // Identifies the current contents of the archive: the SHA256 of its header
+  // combined with the archive's size and modification time. Only computed
+  // when the asarCodeCache fuse is enabled, empty otherwise.
+  const std::string& cache_key() const { return cache_key_; }
+
  private:
+  // Reads and parses a JSON object stored as a packed file at |path|.
+  std::optional<base::Value::Dict> ReadJSONFile(const base::FilePath& path);
+
+  // Returns block |block| of the compressed file |info| decompressed, or
+  // nullptr when it can't be read or decompressed.
+  std::shared_ptr<const std::string> GetDecompressedBlock(const FileInfo& info,
+                                                          uint32_t block);
+
   bool initialized_;
   bool header_validated_ = false;
   const base::FilePath path_;
   base::File file_;
   int fd_ = -1;
   uint32_t header_size_ = 0;
+  std::string cache_key_;
   std::optional<base::Value::Dict> header_;
+  // Set instead of |header_| for archives with a binary header.
+  std::unique_ptr<ArchiveIndex> index_;
 
   // Cached external temporary files.
   base::Lock external_files_lock_;
   std::unordered_map<base::FilePath::StringType,
                      std::unique_ptr<ScopedTemporaryFile>>
       external_files_;
+  // Files extracted into the shared cache, which outlive the process.
+  std::unordered_map<base::FilePath::StringType, base::FilePath> cached_files_;
+
+  // Lazily created read-only mapping of the whole archive.
+  base::Lock mapped_file_lock_;
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+  bool mapping_failed_ = false;
+  // Offsets of files whose integrity has already been validated in the
+  // mapping.
+  std::set<uint64_t> validated_offsets_;
+
+  // Per-file bitmaps of validated integrity blocks, keyed by file offset.
+  mutable base::Lock verified_blocks_lock_;
+  std::map<uint64_t, std::vector<bool>> verified_blocks_;
+
+  base::Lock batched_reader_lock_;
+  scoped_refptr<BatchedReader> batched_reader_;
+
+  // Decompressed blocks of compressed files, keyed by file offset and block
+  // index.
+  base::Lock decompressed_blocks_lock_;
+  base::LRUCache<std::pair<uint64_t, uint32_t>,
+                 std::shared_ptr<const std::string>>
+      decompressed_blocks_;
+
+  // Module resolution index, maps a parent directory to the modules it
+  // requires.
+  base::Lock module_index_lock_;
+  bool module_index_loaded_ = false;
+  std::optional<base::Value::Dict> module_index_;
+
+  // Prefetch manifest, maps a document to the resources it loads. Entries
+  // are removed once taken.
+  base::Lock prefetch_manifest_lock_;
+  bool prefetch_manifest_loaded_ = false;
+  std::optional<base::Value::Dict> prefetch_manifest_;
 };
 
 }  // namespace asar
@@ -0,0 +1,279 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/archive_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/numerics/checked_math.h"
+#include "base/strings/string_split.h"
+#include "electron/fuses.h"
+
+namespace asar {
+
+namespace {
+
+#if BUILDFLAG(IS_WIN)
+const char kSeparators[] = "\\/";
+#else
+const char kSeparators[] = "/";
+#endif
+
+template <typename T>
+T ReadAt(const std::string& data, size_t offset) {
+  T value;
+  memcpy(&value, data.data() + offset, sizeof(T));
+  return value;
+}
+
+bool IsInRange(uint64_t offset, uint64_t size, uint64_t limit) {
+  base::CheckedNumeric<uint64_t> end = offset;
+  end += size;
+  return end.IsValid() && end.ValueOrDie() <= limit;
+}
+
+}  // namespace
+
+// static
+bool ArchiveIndex::IsIndex(std::string_view header) {
+  return header.size() >= kMagicSize &&
+         header.substr(0, kMagicSize) == std::string_view(kMagic, kMagicSize);
+}
+
+// static
+std::unique_ptr<ArchiveIndex> ArchiveIndex::Parse(std::string header) {
+  if (!IsIndex(header) || header.size() < kPreambleSize)
+    return nullptr;
+
+  auto index = base::WrapUnique(new ArchiveIndex(std::move(header)));
+  if (!index->Validate())
+    return nullptr;
+  return index;
+}
+
+ArchiveIndex::ArchiveIndex(std::string header) : data_(std::move(header)) {
+  entry_count_ = ReadAt<uint32_t>(data_, kMagicSize);
+  child_count_ = ReadAt<uint32_t>(data_, kMagicSize + sizeof(uint32_t));
+  string_table_size_ =
+      ReadAt<uint32_t>(data_, kMagicSize + 2 * sizeof(uint32_t));
+  entries_offset_ = kPreambleSize;
+  children_offset_ =
+      entries_offset_ + static_cast<size_t>(entry_count_) * kEntrySize;
+  strings_offset_ =
+      children_offset_ + static_cast<size_t>(child_count_) * sizeof(uint32_t);
+}
+
+ArchiveIndex::~ArchiveIndex() = default;
+
+bool ArchiveIndex::Validate() const {
+  base::CheckedNumeric<uint64_t> expected_size = kPreambleSize;
+  expected_size += base::CheckMul<uint64_t>(entry_count_, kEntrySize);
+  expected_size += base::CheckMul<uint64_t>(child_count_, sizeof(uint32_t));
+  expected_size += string_table_size_;
+  if (!expected_size.IsValid() || expected_size.ValueOrDie() != data_.size())
+    return false;
+
+  if (entry_count_ == 0 || GetEntry(0).type != Type::kDirectory)
+    return false;
+
+  for (uint32_t i = 0; i < entry_count_; ++i) {
+    const Entry entry = GetEntry(i);
+    if (!IsInRange(entry.name_offset, entry.name_size, string_table_size_))
+      return false;
+
+    switch (entry.type) {
+      case Type::kDirectory:
+        if (!IsInRange(entry.first, entry.count, child_count_))
+          return false;
+        for (uint32_t c = 0; c < entry.count; ++c) {
+          if (GetChild(entry.first + c) >= entry_count_)
+            return false;
+        }
+        break;
+      case Type::kLink:
+        if (!IsInRange(entry.first, entry.count, string_table_size_))
+          return false;
+        break;
+      case Type::kFile:
+        if ((entry.flags & kHasIntegrity) &&
+            (entry.block_size == 0 ||
+             !IsInRange(entry.integrity_offset,
+                        base::CheckMul<uint64_t>(kHashSize,
+                                                 entry.block_count + 1ull)
+                            .ValueOrDefault(UINT64_MAX),
+                        string_table_size_))) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+ArchiveIndex::Entry ArchiveIndex::GetEntry(uint32_t index) const {
+  const size_t base = entries_offset_ + static_cast<size_t>(index) * kEntrySize;
+  Entry entry;
+  entry.name_offset = ReadAt<uint32_t>(data_, base);
+  entry.name_size = ReadAt<uint32_t>(data_, base + 4);
+  entry.type = static_cast<Type>(ReadAt<uint8_t>(data_, base + 8));
+  entry.flags = ReadAt<uint8_t>(data_, base + 9);
+  entry.size = ReadAt<uint32_t>(data_, base + 12);
+  entry.offset = ReadAt<uint64_t>(data_, base + 16);
+  entry.first = ReadAt<uint32_t>(data_, base + 24);
+  entry.count = ReadAt<uint32_t>(data_, base + 28);
+  entry.integrity_offset = ReadAt<uint32_t>(data_, base + 32);
+  entry.block_size = ReadAt<uint32_t>(data_, base + 36);
+  entry.block_count = ReadAt<uint32_t>(data_, base + 40);
+  return entry;
+}
+
+uint32_t ArchiveIndex::GetChild(uint32_t index) const {
+  return ReadAt<uint32_t>(
+      data_, children_offset_ + static_cast<size_t>(index) * sizeof(uint32_t));
+}
+
+std::string_view ArchiveIndex::GetString(uint32_t offset,
+                                         uint32_t size) const {
+  return std::string_view(data_).substr(strings_offset_ + offset, size);
+}
+
+std::optional<ArchiveIndex::Entry> ArchiveIndex::FindChild(
+    const Entry& dir,
+    std::string_view name) const {
+  uint32_t low = dir.first;
+  uint32_t high = dir.first + dir.count;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    const Entry child = GetEntry(GetChild(mid));
+    const std::string_view child_name =
+        GetString(child.name_offset, child.name_size);
+    if (child_name == name)
+      return child;
+    if (child_name < name)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return std::nullopt;
+}
+
+std::optional<ArchiveIndex::Entry> ArchiveIndex::ResolveDirectory(
+    const Entry& entry) const {
+  if (entry.type == Type::kDirectory)
+    return entry;
+  if (entry.type != Type::kLink)
+    return std::nullopt;
+
+  // Like the JSON header, only a single level of linking is followed.
+  std::optional<Entry> linked = FindEntry(GetLinkTarget(entry));
+  if (!linked || linked->type != Type::kDirectory)
+    return std::nullopt;
+  return linked;
+}
+
+std::optional<ArchiveIndex::Entry> ArchiveIndex::FindEntry(
+    std::string_view path) const {
+  const Entry root = GetEntry(0);
+  if (path.empty())
+    return root;
+
+  std::vector<std::string_view> components = base::SplitStringPiece(
+      path, kSeparators, base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+
+  Entry node = root;
+  for (size_t i = 0; i < components.size(); ++i) {
+    if (components[i].empty()) {
+      node = root;
+      continue;
+    }
+
+    std::optional<Entry> dir = ResolveDirectory(node);
+    if (!dir)
+      return std::nullopt;
+
+    std::optional<Entry> child = FindChild(*dir, components[i]);
+    if (!child)
+      return std::nullopt;
+    node = *child;
+  }
+
+  return node;
+}
+
+std::string_view ArchiveIndex::GetLinkTarget(const Entry& entry) const {
+  DCHECK(entry.type == Type::kLink);
+  return GetString(entry.first, entry.count);
+}
+
+std::vector<std::string_view> ArchiveIndex::GetChildNames(
+    const Entry& dir) const {
+  std::vector<std::string_view> names;
+  for (const Entry& child : GetChildren(dir))
+    names.push_back(GetName(child));
+  return names;
+}
+
+std::vector<ArchiveIndex::Entry> ArchiveIndex::GetChildren(
+    const Entry& dir) const {
+  std::vector<Entry> children;
+  std::optional<Entry> resolved = ResolveDirectory(dir);
+  if (!resolved)
+    return children;
+
+  children.reserve(resolved->count);
+  for (uint32_t i = 0; i < resolved->count; ++i)
+    children.push_back(GetEntry(GetChild(resolved->first + i)));
+  return children;
+}
+
+std::string_view ArchiveIndex::GetName(const Entry& entry) const {
+  return GetString(entry.name_offset, entry.name_size);
+}
+
+bool ArchiveIndex::FillFileInfo(const Entry& entry,
+                                uint32_t header_size,
+                                bool load_integrity,
+                                Archive::FileInfo* info) const {
+  if (entry.type != Type::kFile)
+    return false;
+
+  info->size = entry.size;
+  info->unpacked = entry.flags & kUnpacked;
+  if (info->unpacked)
+    return true;
+
+  info->offset = entry.offset + header_size;
+  info->executable = entry.flags & kExecutable;
+
+#if BUILDFLAG(IS_MAC)
+  if (load_integrity &&
+      electron::fuses::IsEmbeddedAsarIntegrityValidationEnabled()) {
+    if (!(entry.flags & kHasIntegrity)) {
+      LOG(FATAL) << "Failed to read integrity for file in ASAR archive";
+    }
+
+    IntegrityPayload integrity_payload;
+    integrity_payload.algorithm = HashAlgorithm::kSHA256;
+    integrity_payload.hash = GetString(entry.integrity_offset, kHashSize);
+    integrity_payload.block_size = entry.block_size;
+    integrity_payload.blocks.reserve(entry.block_count);
+    for (uint32_t i = 1; i <= entry.block_count; ++i) {
+      integrity_payload.blocks.emplace_back(
+          GetString(entry.integrity_offset + i * kHashSize, kHashSize));
+    }
+    info->integrity = std::move(integrity_payload);
+  }
+#endif
+
+  return true;
+}
+
+}  // namespace asar
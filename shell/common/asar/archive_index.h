@@ -0,0 +1,138 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+#define ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "shell/common/asar/archive.h"
+
+namespace asar {
+
+// A pre-indexed binary alternative to the JSON header of an asar archive.
+// The header string of such an archive starts with |kMagic| instead of "{",
+// and is laid out as follows (all integers little-endian):
+//
+//   char     magic[8]                     "ASARIDX1"
+//   uint32   entry_count
+//   uint32   child_count
+//   uint32   string_table_size
+//   Entry    entries[entry_count]         entries[0] is the root directory
+//   uint32   children[child_count]        indices into |entries|
+//   char     strings[string_table_size]
+//
+// where each Entry is 48 bytes:
+//
+//   uint32   name_offset, name_size       into |strings|
+//   uint8    type                         0 = file, 1 = directory, 2 = link
+//   uint8    flags                        see |Flags|
+//   uint16   reserved
+//   uint32   size
+//   uint64   offset                       relative to the end of the header
+//   uint32   first, count                 directory: range of |children|,
+//                                         sorted by name; link: target path
+//                                         in |strings|
+//   uint32   integrity_offset             hex SHA256 of the file followed by
+//                                         |block_count| hex block hashes
+//   uint32   block_size, block_count
+//   uint32   reserved
+//
+// Every offset is bounds-checked once in Parse(), so lookups are a binary
+// search per path component over the directory's children.
+class ArchiveIndex {
+ public:
+  static constexpr char kMagic[] = "ASARIDX1";
+  static constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+  static constexpr size_t kPreambleSize = kMagicSize + 3 * sizeof(uint32_t);
+  static constexpr size_t kEntrySize = 48;
+  static constexpr size_t kHashSize = 64;
+
+  enum class Type : uint8_t {
+    kFile = 0,
+    kDirectory = 1,
+    kLink = 2,
+  };
+
+  enum Flags : uint8_t {
+    kUnpacked = 1 << 0,
+    kExecutable = 1 << 1,
+    kHasIntegrity = 1 << 2,
+  };
+
+  struct Entry {
+    uint32_t name_offset;
+    uint32_t name_size;
+    Type type;
+    uint8_t flags;
+    uint32_t size;
+    uint64_t offset;
+    uint32_t first;
+    uint32_t count;
+    uint32_t integrity_offset;
+    uint32_t block_size;
+    uint32_t block_count;
+  };
+
+  // Whether |header| is in the binary format rather than JSON.
+  static bool IsIndex(std::string_view header);
+
+  // Returns nullptr if |header| is malformed.
+  static std::unique_ptr<ArchiveIndex> Parse(std::string header);
+
+  ~ArchiveIndex();
+
+  // disable copy
+  ArchiveIndex(const ArchiveIndex&) = delete;
+  ArchiveIndex& operator=(const ArchiveIndex&) = delete;
+
+  // Looks up |path| relative to the archive root, following linked
+  // directories in intermediate components like the JSON lookup does.
+  std::optional<Entry> FindEntry(std::string_view path) const;
+
+  std::string_view GetLinkTarget(const Entry& entry) const;
+
+  // Returns the names of a directory's children in sorted order.
+  std::vector<std::string_view> GetChildNames(const Entry& dir) const;
+
+  // Returns a directory's children in sorted order, empty when |dir| is not
+  // a directory or a link to one.
+  std::vector<Entry> GetChildren(const Entry& dir) const;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  // Fills |info| the way the JSON header's FillFileInfoWithNode does.
+  bool FillFileInfo(const Entry& entry,
+                    uint32_t header_size,
+                    bool load_integrity,
+                    Archive::FileInfo* info) const;
+
+ private:
+  explicit ArchiveIndex(std::string header);
+
+  bool Validate() const;
+  Entry GetEntry(uint32_t index) const;
+  uint32_t GetChild(uint32_t index) const;
+  std::string_view GetString(uint32_t offset, uint32_t size) const;
+  std::optional<Entry> FindChild(const Entry& dir,
+                                 std::string_view name) const;
+  std::optional<Entry> ResolveDirectory(const Entry& entry) const;
+
+  const std::string data_;
+  uint32_t entry_count_ = 0;
+  uint32_t child_count_ = 0;
+  uint32_t string_table_size_ = 0;
+  size_t entries_offset_ = 0;
+  size_t children_offset_ = 0;
+  size_t strings_offset_ = 0;
+};
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_ARCHIVE_INDEX_H_
@@ -4,10 +4,15 @@
 
 #include "shell/common/asar/asar_util.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
+#include "base/environment.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
@@ -17,6 +22,7 @@
 #include "base/strings/string_util.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
+#include "base/trace_event/trace_event.h"
 #include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "shell/common/asar/archive.h"
@@ -30,20 +36,60 @@ typedef std::map<base::FilePath, std::shared_ptr<Archive>> ArchiveMap;
 
 const base::FilePath::CharType kAsarExtension[] = FILE_PATH_LITERAL(".asar");
 
+// Archives and directory lookups are resolved for every asar path, from the
+// main thread, the IO thread and Node.js worker threads alike. Each thread
+// keeps its own copy of the results it has seen so that repeated lookups never
+// contend on the global locks below; the global maps are only consulted (and
+// locked) the first time a thread sees a given path.
+struct ThreadLocalCache {
+  // Value of |g_archive_cache_generation| when |archives| was filled.
+  uint32_t archive_generation = 0;
+  std::unordered_map<base::FilePath, std::shared_ptr<Archive>> archives;
+  std::unordered_map<base::FilePath, bool> is_directory;
+};
+
+// Bumped by ClearArchives() so that per-thread copies of the archive cache
+// are dropped on their next lookup.
+std::atomic<uint32_t> g_archive_cache_generation{0};
+
+ThreadLocalCache* GetThreadLocalCache() {
+  static base::NoDestructor<base::ThreadLocalOwnedPointer<ThreadLocalCache>>
+      tls_cache;
+  ThreadLocalCache* cache = tls_cache->Get();
+  if (!cache) {
+    auto new_cache = std::make_unique<ThreadLocalCache>();
+    cache = new_cache.get();
+    tls_cache->Set(std::move(new_cache));
+  }
+  return cache;
+}
+
 bool IsDirectoryCached(const base::FilePath& path) {
+  ThreadLocalCache* thread_cache = GetThreadLocalCache();
+  auto cached = thread_cache->is_directory.find(path);
+  if (cached != thread_cache->is_directory.end())
+    return cached->second;
+
   static base::NoDestructor<std::map<base::FilePath, bool>>
       s_is_directory_cache;
   static base::NoDestructor<base::Lock> lock;
 
-  base::AutoLock auto_lock(*lock);
-  auto& is_directory_cache = *s_is_directory_cache;
-
-  auto it = is_directory_cache.find(path);
-  if (it != is_directory_cache.end()) {
-    return it->second;
+  bool is_directory;
+  {
+    base::AutoLock auto_lock(*lock);
+    auto& is_directory_cache = *s_is_directory_cache;
+
+    auto it = is_directory_cache.find(path);
+    if (it != is_directory_cache.end()) {
+      is_directory = it->second;
+    } else {
+      electron::ScopedAllowBlockingForElectron allow_blocking;
+      is_directory = is_directory_cache[path] = base::DirectoryExists(path);
+    }
   }
-  electron::ScopedAllowBlockingForElectron allow_blocking;
-  return is_directory_cache[path] = base::DirectoryExists(path);
+
+  thread_cache->is_directory.emplace(path, is_directory);
+  return is_directory;
 }
 
 }  // namespace
@@ -59,23 +105,41 @@ base::Lock& GetArchiveCacheLock() {
 }
 
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path) {
-  base::AutoLock auto_lock(GetArchiveCacheLock());
-  ArchiveMap& map = GetArchiveCache();
-
-  // if we have it, return it
-  const auto lower = map.lower_bound(path);
-  if (lower != std::end(map) && !map.key_comp()(path, lower->first))
-    return lower->second;
+  ThreadLocalCache* thread_cache = GetThreadLocalCache();
+  const uint32_t generation =
+      g_archive_cache_generation.load(std::memory_order_acquire);
+  if (thread_cache->archive_generation != generation) {
+    thread_cache->archives.clear();
+    thread_cache->archive_generation = generation;
+  }
 
-  // if we can create it, return it
-  auto archive = std::make_shared<Archive>(path);
-  if (archive->Init()) {
-    map.try_emplace(lower, path, archive);
-    return archive;
+  auto cached = thread_cache->archives.find(path);
+  if (cached != thread_cache->archives.end())
+    return cached->second;
+
+  std::shared_ptr<Archive> archive;
+  {
+    base::AutoLock auto_lock(GetArchiveCacheLock());
+    ArchiveMap& map = GetArchiveCache();
+
+    // if we have it, return it
+    const auto lower = map.lower_bound(path);
+    if (lower != std::end(map) && !map.key_comp()(path, lower->first)) {
+      archive = lower->second;
+    } else {
+      // if we can create it, return it
+      auto new_archive = std::make_shared<Archive>(path);
+      if (!new_archive->Init()) {
+        // didn't have it, couldn't create it
+        return nullptr;
+      }
+      map.try_emplace(lower, path, new_archive);
+      archive = std::move(new_archive);
+    }
   }
 
-  // didn't have it, couldn't create it
-  return nullptr;
+  thread_cache->archives.emplace(path, archive);
+  return archive;
 }
 
 void ClearArchives() {
@@ -83,6 +147,7 @@ void ClearArchives() {
   ArchiveMap& map = GetArchiveCache();
 
   map.clear();
+  g_archive_cache_generation.fetch_add(1, std::memory_order_release);
 }
 
 bool GetAsarArchivePath(const base::FilePath& full_path,
@@ -109,6 +174,14 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
   return true;
 }
 
+bool IsMappedReadModeEnabled() {
+  static const bool enabled = [] {
+    auto env = base::Environment::Create();
+    return env->HasVar("ELECTRON_ASAR_MMAP");
+  }();
+  return enabled;
+}
+
 bool ReadFileToString(const base::FilePath& path, std::string* contents) {
   base::FilePath asar_path, relative_path;
   if (!GetAsarArchivePath(path, &asar_path, &relative_path))
@@ -129,6 +202,17 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return base::ReadFileToString(real_path, contents);
   }
 
+  if (info.compression)
+    return archive->ReadCompressedFile(info, contents);
+
+  if (IsMappedReadModeEnabled()) {
+    if (std::optional<base::span<const uint8_t>> span =
+            archive->GetMappedFileSpan(relative_path)) {
+      contents->assign(span->begin(), span->end());
+      return true;
+    }
+  }
+
   base::File src(asar_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
   if (!src.IsValid())
     return false;
@@ -151,6 +235,7 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
 void ValidateIntegrityOrDie(const char* data,
                             size_t size,
                             const IntegrityPayload& integrity) {
+  TRACE_EVENT1("electron", "asar::ValidateIntegrityOrDie", "size", size);
   if (integrity.algorithm == HashAlgorithm::kSHA256) {
     uint8_t hash[crypto::kSHA256Length];
     auto hasher = crypto::SecureHash::Create(crypto::SecureHash::SHA256);
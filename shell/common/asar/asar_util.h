@@ -29,6 +29,11 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
                         base::FilePath* relative_path,
                         bool allow_root = false);
 
+// Whether packed files should be read from a memory mapping of the archive
+// instead of through read() calls on its fd. Controlled by the
+// ELECTRON_ASAR_MMAP environment variable.
+bool IsMappedReadModeEnabled();
+
 // Same with base::ReadFileToString but supports asar Archive.
 bool ReadFileToString(const base::FilePath& path, std::string* contents);
 
@@ -0,0 +1,109 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/batched_reader.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/common/asar/asar_util.h"
+
+namespace asar {
+
+namespace {
+
+// Files are read together as long as this many bytes are read at most, the
+// files of an archive are usually stored one after the other.
+constexpr uint64_t kMaxBatchReadSize = 4 * 1024 * 1024;
+
+}  // namespace
+
+BatchedReader::Request::Request() = default;
+BatchedReader::Request::Request(Request&&) = default;
+BatchedReader::Request& BatchedReader::Request::operator=(Request&&) = default;
+BatchedReader::Request::~Request() = default;
+
+BatchedReader::BatchedReader(base::File file)
+    : file_(std::move(file)),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+BatchedReader::~BatchedReader() = default;
+
+void BatchedReader::Read(uint64_t offset,
+                         uint32_t size,
+                         std::optional<IntegrityPayload> integrity,
+                         ReadCallback callback) {
+  Request request;
+  request.offset = offset;
+  request.size = size;
+  request.integrity = std::move(integrity);
+  request.callback = std::move(callback);
+  request.reply_task_runner = base::SequencedTaskRunner::GetCurrentDefault();
+
+  base::AutoLock auto_lock(lock_);
+  // The batch that is already scheduled picks the request up.
+  const bool schedule = pending_.empty();
+  pending_.push_back(std::move(request));
+  if (schedule) {
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&BatchedReader::ReadPending, this));
+  }
+}
+
+void BatchedReader::ReadPending() {
+  std::vector<Request> requests;
+  {
+    base::AutoLock auto_lock(lock_);
+    requests.swap(pending_);
+  }
+  TRACE_EVENT1("electron", "BatchedReader::ReadPending", "requests",
+               requests.size());
+
+  std::sort(requests.begin(), requests.end(),
+            [](const Request& a, const Request& b) {
+              return a.offset < b.offset;
+            });
+
+  std::vector<uint8_t> buffer;
+  for (size_t first = 0; first < requests.size();) {
+    // Extend the batch over the requests that start where it ends, or inside
+    // it for files read more than once.
+    const uint64_t start = requests[first].offset;
+    uint64_t end = start + requests[first].size;
+    size_t last = first + 1;
+    while (last < requests.size() && requests[last].offset <= end &&
+           std::max(end, requests[last].offset + requests[last].size) - start <=
+               kMaxBatchReadSize) {
+      end = std::max(end, requests[last].offset + requests[last].size);
+      ++last;
+    }
+
+    buffer.resize(end - start);
+    const bool success = file_.ReadAndCheck(start, buffer);
+    for (; first < last; ++first) {
+      Request& request = requests[first];
+      std::optional<std::vector<uint8_t>> contents;
+      if (success) {
+        const auto begin = buffer.begin() + (request.offset - start);
+        contents.emplace(begin, begin + request.size);
+        if (request.integrity) {
+          ValidateIntegrityOrDie(
+              reinterpret_cast<const char*>(contents->data()),
+              contents->size(), *request.integrity);
+        }
+      }
+      request.reply_task_runner->PostTask(
+          FROM_HERE,
+          base::BindOnce(std::move(request.callback), std::move(contents)));
+    }
+  }
+}
+
+}  // namespace asar
@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_BATCHED_READER_H_
+#define ELECTRON_SHELL_COMMON_ASAR_BATCHED_READER_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/functional/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/synchronization/lock.h"
+#include "shell/common/asar/archive.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace asar {
+
+// Reads packed files of an archive on the thread pool instead of the libuv
+// threadpool. The reads queued while an earlier batch is running are sorted
+// by offset and the ones next to each other are read with a single call, so
+// that loading many small files, like the modules of an app, costs few reads.
+// Integrity is validated on the thread pool as well.
+class BatchedReader : public base::RefCountedThreadSafe<BatchedReader> {
+ public:
+  // Called on the sequence Read() was called on, with std::nullopt when the
+  // file could not be read.
+  using ReadCallback =
+      base::OnceCallback<void(std::optional<std::vector<uint8_t>>)>;
+
+  explicit BatchedReader(base::File file);
+
+  // disable copy
+  BatchedReader(const BatchedReader&) = delete;
+  BatchedReader& operator=(const BatchedReader&) = delete;
+
+  // Must be called on a sequence with a task runner.
+  void Read(uint64_t offset,
+            uint32_t size,
+            std::optional<IntegrityPayload> integrity,
+            ReadCallback callback);
+
+ private:
+  friend class base::RefCountedThreadSafe<BatchedReader>;
+
+  struct Request {
+    Request();
+    Request(Request&&);
+    Request& operator=(Request&&);
+    ~Request();
+
+    uint64_t offset = 0;
+    uint32_t size = 0;
+    std::optional<IntegrityPayload> integrity;
+    ReadCallback callback;
+    scoped_refptr<base::SequencedTaskRunner> reply_task_runner;
+  };
+
+  ~BatchedReader();
+
+  void ReadPending();
+
+  base::File file_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  base::Lock lock_;
+  std::vector<Request> pending_;
+};
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_BATCHED_READER_H_
@@ -0,0 +1,178 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/asar/extraction_cache.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/environment.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/thread_restrictions.h"
+
+#if BUILDFLAG(IS_POSIX)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace asar {
+
+namespace {
+
+constexpr size_t kHashChunkSize = 1024 * 1024;
+
+std::string HashToHex(crypto::SecureHash* hasher) {
+  uint8_t hash[crypto::kSHA256Length];
+  hasher->Finish(hash, sizeof(hash));
+  return base::ToLowerASCII(base::HexEncode(hash, sizeof(hash)));
+}
+
+// The directory is private to the user, on POSIX the temporary directory can
+// be shared with other users so it is only used when it belongs to us.
+std::optional<base::FilePath> CreateCacheDirectory() {
+  if (base::Environment::Create()->HasVar(
+          "ELECTRON_DISABLE_ASAR_EXTRACTION_CACHE"))
+    return std::nullopt;
+
+  base::FilePath temp_dir;
+  if (!base::GetTempDir(&temp_dir))
+    return std::nullopt;
+#if BUILDFLAG(IS_POSIX)
+  const base::FilePath dir = temp_dir.Append(
+      "electron-asar-cache-" + base::NumberToString(geteuid()));
+  if (!base::CreateDirectory(dir))
+    return std::nullopt;
+  struct stat info;
+  if (lstat(dir.value().c_str(), &info) != 0 || !S_ISDIR(info.st_mode) ||
+      info.st_uid != geteuid()) {
+    LOG(WARNING) << "Not using ASAR extraction cache " << dir;
+    return std::nullopt;
+  }
+  if ((info.st_mode & 0077) != 0 && !base::SetPosixFilePermissions(dir, 0700))
+    return std::nullopt;
+#else
+  const base::FilePath dir =
+      temp_dir.Append(FILE_PATH_LITERAL("electron-asar-cache"));
+  if (!base::CreateDirectory(dir))
+    return std::nullopt;
+#endif
+  return dir;
+}
+
+const std::optional<base::FilePath>& GetCacheDirectory() {
+  static const base::NoDestructor<std::optional<base::FilePath>> dir(
+      CreateCacheDirectory());
+  return *dir;
+}
+
+// Whether the file at |path| is a complete copy of the packed file.
+bool IsCachedFileIntact(const base::FilePath& path,
+                        uint64_t size,
+                        const std::optional<IntegrityPayload>& integrity) {
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid() || file.GetLength() != static_cast<int64_t>(size))
+    return false;
+  if (!integrity.has_value())
+    return true;
+
+  TRACE_EVENT1("electron", "asar::IsCachedFileIntact", "size", size);
+  auto hasher = crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  std::vector<char> buf(std::min<uint64_t>(size, kHashChunkSize));
+  for (uint64_t read = 0; read < size;) {
+    int len = file.ReadAtCurrentPos(buf.data(), buf.size());
+    if (len <= 0)
+      return false;
+    hasher->Update(buf.data(), len);
+    read += len;
+  }
+  return HashToHex(hasher.get()) == integrity->hash;
+}
+
+}  // namespace
+
+bool ExtractToCache(base::File* src,
+                    const base::FilePath::StringType& ext,
+                    uint64_t offset,
+                    uint64_t size,
+                    const std::optional<IntegrityPayload>& integrity,
+                    bool executable,
+                    base::FilePath* out) {
+  electron::ScopedAllowBlockingForElectron allow_blocking;
+  const std::optional<base::FilePath>& dir = GetCacheDirectory();
+  if (!dir || !src->IsValid())
+    return false;
+  if (integrity.has_value() &&
+      integrity->algorithm != HashAlgorithm::kSHA256)
+    return false;
+
+  // With integrity the name is known without reading the packed file.
+  std::vector<char> buf;
+  std::string hash;
+  if (integrity.has_value()) {
+    hash = integrity->hash;
+  } else {
+    buf.resize(size);
+    if (src->Read(offset, buf.data(), buf.size()) != static_cast<int>(size))
+      return false;
+    auto hasher = crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+    hasher->Update(buf.data(), buf.size());
+    hash = HashToHex(hasher.get());
+  }
+
+#if BUILDFLAG(IS_WIN)
+  const base::FilePath path = dir->Append(base::UTF8ToWide(hash) + ext);
+#else
+  const base::FilePath path = dir->Append(hash + ext);
+#endif
+  if (IsCachedFileIntact(path, size, integrity)) {
+    *out = path;
+    return true;
+  }
+
+  if (buf.empty()) {
+    buf.resize(size);
+    if (src->Read(offset, buf.data(), buf.size()) != static_cast<int>(size))
+      return false;
+    ValidateIntegrityOrDie(buf.data(), buf.size(), integrity.value());
+  }
+
+  // Written next to its final path and renamed, so that other processes
+  // never see a partial file.
+  base::FilePath temp_path;
+  if (!base::CreateTemporaryFileInDir(*dir, &temp_path))
+    return false;
+  if (!base::WriteFile(temp_path, std::string_view(buf.data(), buf.size()))) {
+    base::DeleteFile(temp_path);
+    return false;
+  }
+#if BUILDFLAG(IS_POSIX)
+  base::SetPosixFilePermissions(temp_path, executable ? 0700 : 0600);
+#endif
+  if (!base::ReplaceFile(temp_path, path, nullptr)) {
+    base::DeleteFile(temp_path);
+    // Another process may have extracted it first, on Windows the file can't
+    // be replaced while it is loaded.
+    if (!IsCachedFileIntact(path, size, integrity))
+      return false;
+  }
+  *out = path;
+  return true;
+}
+
+}  // namespace asar
@@ -0,0 +1,41 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+#define ELECTRON_SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
+
+#include <cstdint>
+#include <optional>
+
+#include "base/files/file_path.h"
+
+namespace base {
+class File;
+}
+
+namespace asar {
+
+struct IntegrityPayload;
+
+// Extracts the packed file at |offset| in |src| into a directory shared by
+// all the processes and launches of the app, where it is named after the
+// SHA256 of its contents, so that the processes which need a real path for
+// the same file, like the ones loading a native module, extract it once.
+//
+// A file already in the cache is used when it is intact: for archives with
+// integrity its contents are hashed again, otherwise its size is checked.
+// Returns false when the cache can't be used, the caller then extracts the
+// file into a temporary file. Disabled by the
+// ELECTRON_DISABLE_ASAR_EXTRACTION_CACHE environment variable.
+bool ExtractToCache(base::File* src,
+                    const base::FilePath::StringType& ext,
+                    uint64_t offset,
+                    uint64_t size,
+                    const std::optional<IntegrityPayload>& integrity,
+                    bool executable,
+                    base::FilePath* out);
+
+}  // namespace asar
+
+#endif  // ELECTRON_SHELL_COMMON_ASAR_EXTRACTION_CACHE_H_
@@ -0,0 +1,160 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/bootstrap_code_cache.h"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/functional/bind.h"
+#include "base/logging.h"
+#include "base/path_service.h"
+#include "base/pickle.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "chrome/common/chrome_paths.h"
+#include "electron/electron_version.h"
+#include "shell/common/thread_restrictions.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x45424343;  // "EBCC"
+
+using CodeCacheList = std::vector<node::builtins::CodeCacheInfo>;
+
+// Writes the header that ties the cache to the V8 version and flags which
+// produced it, since V8 rejects cache data from any other configuration.
+void WriteHeader(base::Pickle* pickle) {
+  pickle->WriteUInt32(kMagic);
+  pickle->WriteString(ELECTRON_VERSION_STRING);
+  pickle->WriteUInt32(v8::ScriptCompiler::CachedDataVersionTag());
+}
+
+bool ParseCache(const std::string& contents, CodeCacheList* out) {
+  base::Pickle pickle(contents.data(), contents.size());
+  base::PickleIterator iter(pickle);
+  uint32_t magic, tag, count;
+  std::string version;
+  if (!iter.ReadUInt32(&magic) || magic != kMagic ||
+      !iter.ReadString(&version) || version != ELECTRON_VERSION_STRING ||
+      !iter.ReadUInt32(&tag) ||
+      tag != v8::ScriptCompiler::CachedDataVersionTag() ||
+      !iter.ReadUInt32(&count))
+    return false;
+
+  out->reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    node::builtins::CodeCacheInfo info;
+    const char* data;
+    size_t length;
+    if (!iter.ReadString(&info.id) || !iter.ReadData(&data, &length))
+      return false;
+    info.data.assign(data, data + length);
+    out->push_back(std::move(info));
+  }
+  return true;
+}
+
+void WriteCache(const base::FilePath& path, CodeCacheList cache) {
+  TRACE_EVENT0("electron", "BootstrapCodeCache::Save");
+  base::Pickle pickle;
+  WriteHeader(&pickle);
+  pickle.WriteUInt32(cache.size());
+  for (const auto& info : cache) {
+    pickle.WriteString(info.id);
+    pickle.WriteData(reinterpret_cast<const char*>(info.data.data()),
+                     info.data.size());
+  }
+
+  if (!base::CreateDirectory(path.DirName()) ||
+      !base::ImportantFileWriter::WriteFileAtomically(
+          path, std::string_view(static_cast<const char*>(pickle.data()),
+                                 pickle.size()))) {
+    LOG(WARNING) << "Failed to write the bootstrap code cache to "
+                 << path.value();
+  }
+}
+
+}  // namespace
+
+BootstrapCodeCache::BootstrapCodeCache(
+    const base::FilePath::StringType& name) {
+  base::FilePath user_data_dir;
+  if (!base::PathService::Get(chrome::DIR_USER_DATA, &user_data_dir))
+    return;
+
+  path_ = user_data_dir.Append(FILE_PATH_LITERAL("Code Cache"))
+              .Append(name);
+  // Overlap the disk read with the creation of the JavaScript environment.
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(
+          [](const base::FilePath& path) {
+            TRACE_EVENT0("electron.startup", "BootstrapCodeCache::Prefetch");
+            base::PreReadFile(path, /*is_executable=*/false);
+          },
+          path_));
+}
+
+BootstrapCodeCache::~BootstrapCodeCache() = default;
+
+void BootstrapCodeCache::Load(node::Environment* env) {
+  TRACE_EVENT0("electron.startup", "BootstrapCodeCache::Load");
+  if (path_.empty())
+    return;
+
+  if (!read_) {
+    read_ = true;
+    std::string contents;
+    {
+      ScopedAllowBlockingForElectron allow_blocking;
+      if (!base::ReadFileToString(path_, &contents))
+        return;
+    }
+
+    // A stale or corrupt file is replaced by the next Save().
+    if (!ParseCache(contents, &cache_)) {
+      cache_.clear();
+      return;
+    }
+    for (const auto& info : cache_)
+      loaded_ids_.insert(info.id);
+  }
+
+  if (!cache_.empty())
+    env->builtin_loader()->RefreshCodeCache(cache_);
+}
+
+void BootstrapCodeCache::Save(node::Environment* env) {
+  if (path_.empty())
+    return;
+
+  CodeCacheList cache;
+  env->builtin_loader()->CopyCodeCache(&cache);
+  const bool has_new_entries =
+      std::any_of(cache.begin(), cache.end(), [this](const auto& info) {
+        return !loaded_ids_.contains(info.id);
+      });
+  if (!has_new_entries)
+    return;
+
+  for (const auto& info : cache)
+    loaded_ids_.insert(info.id);
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&WriteCache, path_, std::move(cache)));
+}
+
+}  // namespace electron
@@ -0,0 +1,52 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_BOOTSTRAP_CODE_CACHE_H_
+#define ELECTRON_SHELL_COMMON_BOOTSTRAP_CODE_CACHE_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+// Keeps the V8 code cache of the builtin modules compiled while a process
+// starts, i.e. Electron's browser_init or renderer_init bundle and the
+// Node.js internals it and the app's code load, so that later launches can
+// skip compiling them. Enabled by the bootstrapCodeCache fuse.
+class BootstrapCodeCache {
+ public:
+  // Uses the |name| file in the "Code Cache" folder of the user data
+  // directory, which starts being read into the page cache on the thread pool
+  // right away.
+  explicit BootstrapCodeCache(const base::FilePath::StringType& name);
+  ~BootstrapCodeCache();
+
+  // disable copy
+  BootstrapCodeCache(const BootstrapCodeCache&) = delete;
+  BootstrapCodeCache& operator=(const BootstrapCodeCache&) = delete;
+
+  // Hands the cache stored on disk to the builtin loader of |env|. Must be
+  // called before the environment is loaded. The file is only read once, so
+  // that all environments of the process use the same cache data, which V8
+  // refers to rather than copies: this object must outlive them.
+  void Load(node::Environment* env);
+
+  // Writes the cache of the builtin loader of |env| back to disk, in the
+  // background, when modules that were not cached have been compiled.
+  void Save(node::Environment* env);
+
+ private:
+  base::FilePath path_;
+  bool read_ = false;
+  std::vector<node::builtins::CodeCacheInfo> cache_;
+  std::set<std::string> loaded_ids_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_BOOTSTRAP_CODE_CACHE_H_
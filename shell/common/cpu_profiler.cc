@@ -0,0 +1,141 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/cpu_profiler.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/json/json_writer.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+#include "gin/converter.h"
+#include "v8/include/v8-profiler.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+constexpr char kProfileTitle[] = "electron";
+
+// Converts |profile| to the Profile of the DevTools protocol.
+base::Value::Dict ToProfileValue(const v8::CpuProfile* profile) {
+  base::Value::List nodes;
+  std::vector<const v8::CpuProfileNode*> pending = {profile->GetTopDownRoot()};
+  while (!pending.empty()) {
+    const v8::CpuProfileNode* node = pending.back();
+    pending.pop_back();
+
+    base::Value::Dict call_frame;
+    call_frame.Set("functionName", node->GetFunctionNameStr());
+    call_frame.Set("scriptId", base::NumberToString(node->GetScriptId()));
+    call_frame.Set("url", node->GetScriptResourceNameStr());
+    // The DevTools count lines and columns from 0.
+    call_frame.Set("lineNumber", node->GetLineNumber() - 1);
+    call_frame.Set("columnNumber", node->GetColumnNumber() - 1);
+
+    base::Value::List children;
+    for (int i = 0; i < node->GetChildrenCount(); ++i) {
+      const v8::CpuProfileNode* child = node->GetChild(i);
+      children.Append(static_cast<int>(child->GetNodeId()));
+      pending.push_back(child);
+    }
+
+    base::Value::Dict dict;
+    dict.Set("id", static_cast<int>(node->GetNodeId()));
+    dict.Set("callFrame", std::move(call_frame));
+    dict.Set("hitCount", static_cast<int>(node->GetHitCount()));
+    dict.Set("children", std::move(children));
+    nodes.Append(std::move(dict));
+  }
+
+  base::Value::List samples;
+  base::Value::List time_deltas;
+  int64_t last_timestamp = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples.Append(static_cast<int>(profile->GetSample(i)->GetNodeId()));
+    const int64_t timestamp = profile->GetSampleTimestamp(i);
+    time_deltas.Append(static_cast<double>(timestamp - last_timestamp));
+    last_timestamp = timestamp;
+  }
+
+  base::Value::Dict result;
+  result.Set("nodes", std::move(nodes));
+  result.Set("startTime", static_cast<double>(profile->GetStartTime()));
+  result.Set("endTime", static_cast<double>(profile->GetEndTime()));
+  result.Set("samples", std::move(samples));
+  result.Set("timeDeltas", std::move(time_deltas));
+  return result;
+}
+
+bool WriteProfile(base::File file, base::Value::Dict profile) {
+  TRACE_EVENT0("electron", "WriteProfile");
+  std::string json;
+  if (!file.IsValid() || !base::JSONWriter::Write(profile, &json))
+    return false;
+  const int length = base::checked_cast<int>(json.size());
+  return file.WriteAtCurrentPos(json.data(), length) == length;
+}
+
+}  // namespace
+
+CpuProfiler::CpuProfiler(v8::Isolate* isolate) : isolate_(isolate) {}
+
+CpuProfiler::~CpuProfiler() {
+  if (profiler_)
+    profiler_.ExtractAsDangling()->Dispose();
+}
+
+bool CpuProfiler::Start(base::TimeDelta sampling_interval) {
+  if (profiling_)
+    return false;
+  if (!profiler_)
+    profiler_ = v8::CpuProfiler::New(isolate_);
+
+  v8::HandleScope handle_scope(isolate_);
+  v8::CpuProfilingOptions options(
+      v8::kLeafNodeLineNumbers, v8::CpuProfilingOptions::kNoSampleLimit,
+      base::checked_cast<int>(sampling_interval.InMicroseconds()));
+  profiling_ = profiler_->StartProfiling(
+                   gin::StringToV8(isolate_, kProfileTitle), options) ==
+               v8::CpuProfilingStatus::kStarted;
+  return profiling_;
+}
+
+void CpuProfiler::Stop(base::File file,
+                       base::OnceCallback<void(bool)> callback) {
+  v8::CpuProfile* profile = nullptr;
+  if (profiling_) {
+    v8::HandleScope handle_scope(isolate_);
+    profile =
+        profiler_->StopProfiling(gin::StringToV8(isolate_, kProfileTitle));
+    profiling_ = false;
+  }
+  if (!profile) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), false));
+    return;
+  }
+
+  // The profile can only be read on the isolate's thread, converting it to
+  // JSON and writing it are left to the thread pool.
+  base::Value::Dict value = ToProfileValue(profile);
+  profile->Delete();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+      base::BindOnce(&WriteProfile, std::move(file), std::move(value)),
+      std::move(callback));
+}
+
+}  // namespace electron
@@ -0,0 +1,48 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_CPU_PROFILER_H_
+#define ELECTRON_SHELL_COMMON_CPU_PROFILER_H_
+
+#include "base/files/file.h"
+#include "base/functional/callback_forward.h"
+#include "base/memory/raw_ptr.h"
+#include "base/time/time.h"
+
+namespace v8 {
+class CpuProfiler;
+class Isolate;
+}  // namespace v8
+
+namespace electron {
+
+// Samples the JavaScript stacks of an isolate with v8::CpuProfiler, without
+// the overhead of a DevTools session. See app.startCpuProfiling().
+class CpuProfiler {
+ public:
+  explicit CpuProfiler(v8::Isolate* isolate);
+  ~CpuProfiler();
+
+  // disable copy
+  CpuProfiler(const CpuProfiler&) = delete;
+  CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+  bool Start(base::TimeDelta sampling_interval);
+
+  // Stops profiling and writes the profile to |file| in the .cpuprofile
+  // format of the DevTools. The file is written on the thread pool,
+  // |callback| runs on the calling sequence once it is done.
+  void Stop(base::File file, base::OnceCallback<void(bool)> callback);
+
+  bool is_profiling() const { return profiling_; }
+
+ private:
+  raw_ptr<v8::Isolate> isolate_;
+  raw_ptr<v8::CpuProfiler> profiler_ = nullptr;
+  bool profiling_ = false;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_CPU_PROFILER_H_
@@ -4,7 +4,11 @@
 
 #include "shell/common/crash_keys.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
 #include <cstdint>
+#include <cstring>
 #include <deque>
 #include <map>
 #include <string>
@@ -14,6 +18,7 @@
 #include "base/no_destructor.h"
 #include "base/strings/string_split.h"
 #include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "components/crash/core/common/crash_key.h"
 #include "content/public/common/content_switches.h"
 #include "electron/buildflags/buildflags.h"
@@ -45,8 +50,47 @@ std::deque<std::string>& GetExtraCrashKeyNames() {
   return *crash_key_names;
 }
 
+// The breadcrumbs are fixed size lines in a ring, that crashpad reads as a
+// single string. Each line starts with its sequence number, since the ring
+// is not in order once it wrapped around.
+constexpr size_t kBreadcrumbCount = 64;
+constexpr size_t kBreadcrumbSize = 128;
+static_assert(kBreadcrumbCount * kBreadcrumbSize <
+                  crashpad::Annotation::kValueMaxSize,
+              "breadcrumbs above what crashpad supports");
+
+char g_breadcrumbs[kBreadcrumbCount * kBreadcrumbSize];
+std::atomic<uint32_t> g_next_breadcrumb{0};
+crashpad::Annotation g_breadcrumbs_annotation(
+    crashpad::Annotation::Type::kString,
+    "electron_breadcrumbs",
+    g_breadcrumbs);
+
 }  // namespace
 
+void AddBreadcrumb(std::string_view category, std::string_view text) {
+  const uint32_t sequence =
+      g_next_breadcrumb.fetch_add(1, std::memory_order_relaxed);
+  char line[kBreadcrumbSize];
+  int length = snprintf(
+      line, sizeof(line), "%u %" PRId64 " %.*s %.*s", sequence,
+      base::Time::Now().InMillisecondsSinceUnixEpoch(),
+      static_cast<int>(category.size()), category.data(),
+      static_cast<int>(text.size()), text.data());
+  length = std::clamp(length, 0, static_cast<int>(sizeof(line)) - 1);
+  // Pad the line, so that the previous line of the slot doesn't show through.
+  memset(line + length, ' ', sizeof(line) - length - 1);
+  line[sizeof(line) - 1] = '\n';
+
+  const size_t slot = sequence % kBreadcrumbCount;
+  memcpy(g_breadcrumbs + slot * kBreadcrumbSize, line, sizeof(line));
+  if (sequence < kBreadcrumbCount) {
+    g_breadcrumbs_annotation.SetSize(
+        static_cast<crashpad::Annotation::ValueSizeType>((sequence + 1) *
+                                                         kBreadcrumbSize));
+  }
+}
+
 constexpr uint32_t kMaxCrashKeyNameLength = 40;
 static_assert(kMaxCrashKeyNameLength <= crashpad::Annotation::kNameMaxLength,
               "max crash key name length above what crashpad supports");
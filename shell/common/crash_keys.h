@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 
 namespace base {
 class CommandLine;
@@ -18,6 +19,12 @@ void SetCrashKey(const std::string& key, const std::string& value);
 void ClearCrashKey(const std::string& key);
 void GetCrashKeys(std::map<std::string, std::string>* keys);
 
+// Records a line in the "electron_breadcrumbs" crash key, which holds the
+// last lines recorded by the process, like the recent IPC messages and
+// navigations. It doesn't allocate or lock, so it can be called from hot paths
+// and from any thread.
+void AddBreadcrumb(std::string_view category, std::string_view text);
+
 void SetCrashKeysFromCommandLine(const base::CommandLine& command_line);
 void SetPlatformCrashKey();
 
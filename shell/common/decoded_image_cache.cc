@@ -0,0 +1,144 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/decoded_image_cache.h"
+
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/strcat.h"
+#include "base/task/sequenced_task_runner.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
+
+namespace electron {
+
+namespace {
+
+// Enough for the icons of an app at all their scales, the bitmaps that would
+// take a large part of it aren't kept.
+constexpr size_t kMaxTotalBytes = 32 * 1024 * 1024;
+constexpr size_t kMaxBitmapBytes = kMaxTotalBytes / 8;
+
+std::optional<std::string> GetRealFileVersion(const base::FilePath& path) {
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info) || info.is_directory)
+    return std::nullopt;
+  return base::StrCat(
+      {base::NumberToString(info.size), ":",
+       base::NumberToString(
+           info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds())});
+}
+
+}  // namespace
+
+// static
+DecodedImageCache* DecodedImageCache::GetInstance() {
+  static base::NoDestructor<DecodedImageCache> instance;
+  return instance.get();
+}
+
+// static
+std::optional<std::string> DecodedImageCache::GetFileVersion(
+    const base::FilePath& path) {
+  base::FilePath asar_path, relative_path;
+  if (!asar::GetAsarArchivePath(path, &asar_path, &relative_path))
+    return GetRealFileVersion(path);
+
+  std::shared_ptr<asar::Archive> archive =
+      asar::GetOrCreateAsarArchive(asar_path);
+  asar::Archive::FileInfo info;
+  if (!archive || !archive->GetFileInfo(relative_path, &info))
+    return std::nullopt;
+
+  if (info.unpacked) {
+    base::FilePath real_path;
+    archive->CopyFileOut(relative_path, &real_path);
+    return GetRealFileVersion(real_path);
+  }
+
+  // The packed files can't change while the archive is open.
+  return base::StrCat(
+      {"asar:", asar_path.AsUTF8Unsafe(), ":",
+       base::NumberToString(info.offset), ":", base::NumberToString(info.size),
+       ":", info.integrity ? info.integrity->hash : std::string()});
+}
+
+DecodedImageCache::DecodedImageCache()
+    : entries_(base::LRUCache<base::FilePath, Entry>::NO_AUTO_EVICT) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+std::optional<SkBitmap> DecodedImageCache::Get(const base::FilePath& path,
+                                               const std::string& version) {
+  base::AutoLock auto_lock(lock_);
+  auto it = entries_.Get(path);
+  if (it == entries_.end())
+    return std::nullopt;
+  if (it->second.version != version) {
+    total_bytes_ -= it->second.bitmap.computeByteSize();
+    entries_.Erase(it);
+    return std::nullopt;
+  }
+  return it->second.bitmap;
+}
+
+void DecodedImageCache::Put(const base::FilePath& path,
+                            std::string version,
+                            const SkBitmap& bitmap) {
+  size_t bytes = bitmap.computeByteSize();
+  if (bytes > kMaxBitmapBytes)
+    return;
+
+  // The pixels are shared with the images that are already using |bitmap|,
+  // which must not write to them anymore.
+  SkBitmap shared = bitmap;
+  shared.setImmutable();
+
+  base::AutoLock auto_lock(lock_);
+  ListenForMemoryPressureIfPossible();
+  auto it = entries_.Peek(path);
+  if (it != entries_.end()) {
+    total_bytes_ -= it->second.bitmap.computeByteSize();
+    entries_.Erase(it);
+  }
+  entries_.Put(path, Entry{std::move(version), std::move(shared)});
+  total_bytes_ += bytes;
+  while (total_bytes_ > kMaxTotalBytes) {
+    auto oldest = entries_.rbegin();
+    total_bytes_ -= oldest->second.bitmap.computeByteSize();
+    entries_.Erase(oldest);
+  }
+}
+
+void DecodedImageCache::Clear() {
+  base::AutoLock auto_lock(lock_);
+  entries_.Clear();
+  total_bytes_ = 0;
+}
+
+void DecodedImageCache::ListenForMemoryPressureIfPossible() {
+  // The listener is called on the sequence that created it, so it can't be
+  // created by the tasks that load images in parallel.
+  if (memory_pressure_listener_ ||
+      !base::SequencedTaskRunner::HasCurrentDefault())
+    return;
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE, base::BindRepeating(&DecodedImageCache::OnMemoryPressure,
+                                     base::Unretained(this)));
+}
+
+void DecodedImageCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  // Only the cache's references are dropped, the images in use keep theirs.
+  if (memory_pressure_level !=
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    Clear();
+}
+
+}  // namespace electron
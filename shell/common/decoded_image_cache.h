@@ -0,0 +1,72 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_DECODED_IMAGE_CACHE_H_
+#define ELECTRON_SHELL_COMMON_DECODED_IMAGE_CACHE_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "base/containers/lru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace electron {
+
+// The images decoded from files, shared by all the nativeImages and icons that
+// load the same files while they are unchanged. The bitmaps are immutable, so
+// their pixels are shared instead of copied. Used from any thread.
+class DecodedImageCache {
+ public:
+  static DecodedImageCache* GetInstance();
+
+  // What identifies the contents of |path| without reading it: its size and
+  // modification time, or where it is packed in an asar archive and its
+  // integrity hash. Returns nullopt when the file doesn't exist. Blocks.
+  static std::optional<std::string> GetFileVersion(const base::FilePath& path);
+
+  // disable copy
+  DecodedImageCache(const DecodedImageCache&) = delete;
+  DecodedImageCache& operator=(const DecodedImageCache&) = delete;
+
+  // Returns the bitmap last decoded from |path|, unless the file changed.
+  std::optional<SkBitmap> Get(const base::FilePath& path,
+                              const std::string& version);
+
+  void Put(const base::FilePath& path,
+           std::string version,
+           const SkBitmap& bitmap);
+
+  void Clear();
+
+ private:
+  friend class base::NoDestructor<DecodedImageCache>;
+
+  struct Entry {
+    std::string version;
+    SkBitmap bitmap;
+  };
+
+  DecodedImageCache();
+  ~DecodedImageCache();
+
+  void ListenForMemoryPressureIfPossible() EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  base::Lock lock_;
+  base::LRUCache<base::FilePath, Entry> entries_ GUARDED_BY(lock_);
+  size_t total_bytes_ GUARDED_BY(lock_) = 0;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_
+      GUARDED_BY(lock_);
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_DECODED_IMAGE_CACHE_H_
@@ -14,6 +14,7 @@ const char kDeviceProductIdKey[] = "productId";
 const char kDeviceSerialNumberKey[] = "serialNumber";
 
 const char kRunAsNode[] = "ELECTRON_RUN_AS_NODE";
+const char kRunAsNodeMinimal[] = "ELECTRON_RUN_AS_NODE_MINIMAL";
 
 #if BUILDFLAG(ENABLE_PDF_VIEWER)
 const char kPDFExtensionPluginName[] = "Chromium PDF Viewer";
@@ -21,6 +21,7 @@ extern const char kDeviceProductIdKey[];
 extern const char kDeviceSerialNumberKey[];
 
 extern const char kRunAsNode[];
+extern const char kRunAsNodeMinimal[];
 
 #if BUILDFLAG(ENABLE_PDF_VIEWER)
 extern const char kPDFExtensionPluginName[];
@@ -0,0 +1,208 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/event_loop_monitor.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/pending_task.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/common/crash_keys.h"
+
+namespace electron {
+
+namespace {
+
+// Number of samples kept per histogram to compute percentiles from.
+constexpr size_t kMaxRecentSamples = 1000;
+
+// Number of long tasks kept, the oldest are dropped first.
+constexpr size_t kMaxLongTasks = 50;
+
+// Calls into JavaScript shorter than this are not worth attributing.
+constexpr base::TimeDelta kMinAttributedCall = base::Milliseconds(1);
+
+constinit thread_local EventLoopMonitor* current_monitor = nullptr;
+
+}  // namespace
+
+EventLoopMonitor::Histogram::Histogram() = default;
+
+EventLoopMonitor::Histogram::~Histogram() = default;
+
+void EventLoopMonitor::Histogram::Add(base::TimeDelta sample) {
+  ++count_;
+  sum_ += sample;
+  min_ = std::min(min_, sample);
+  max_ = std::max(max_, sample);
+  if (recent_.size() == kMaxRecentSamples)
+    recent_.pop_front();
+  recent_.push_back(sample);
+}
+
+void EventLoopMonitor::Histogram::Reset() {
+  *this = Histogram();
+}
+
+base::Value::Dict EventLoopMonitor::Histogram::ToDict() const {
+  base::Value::Dict dict;
+  dict.Set("count", static_cast<double>(count_));
+  if (count_ == 0) {
+    dict.Set("min", 0.0);
+    dict.Set("max", 0.0);
+    dict.Set("mean", 0.0);
+    dict.Set("p50", 0.0);
+    dict.Set("p90", 0.0);
+    dict.Set("p99", 0.0);
+    return dict;
+  }
+
+  std::vector<base::TimeDelta> sorted(recent_.begin(), recent_.end());
+  std::sort(sorted.begin(), sorted.end());
+  auto percentile = [&sorted](size_t p) {
+    return sorted[(sorted.size() - 1) * p / 100].InMillisecondsF();
+  };
+
+  dict.Set("min", min_.InMillisecondsF());
+  dict.Set("max", max_.InMillisecondsF());
+  dict.Set("mean", sum_.InMillisecondsF() / count_);
+  dict.Set("p50", percentile(50));
+  dict.Set("p90", percentile(90));
+  dict.Set("p99", percentile(99));
+  return dict;
+}
+
+EventLoopMonitor::EventLoopMonitor() {
+  DCHECK(!current_monitor);
+  current_monitor = this;
+}
+
+EventLoopMonitor::~EventLoopMonitor() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_EQ(current_monitor, this);
+  current_monitor = nullptr;
+}
+
+// static
+EventLoopMonitor* EventLoopMonitor::GetCurrent() {
+  return current_monitor;
+}
+
+void EventLoopMonitor::WillProcessTask(const base::PendingTask& pending_task) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (task_depth_++ > 0)
+    return;
+
+  task_start_ = base::TimeTicks::Now();
+  slowest_call_.clear();
+  slowest_call_duration_ = base::TimeDelta();
+
+  // Delayed tasks know when they were meant to run, immediate ones only know
+  // when they were posted if the sequence manager recorded it.
+  if (!pending_task.delayed_run_time.is_null()) {
+    loop_lag_.Add(std::max(base::TimeDelta(),
+                           task_start_ - pending_task.delayed_run_time));
+  } else if (!pending_task.queue_time.is_null()) {
+    loop_lag_.Add(task_start_ - pending_task.queue_time);
+  }
+}
+
+void EventLoopMonitor::DidProcessTask(const base::PendingTask& pending_task) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  // Tasks that were already running when the monitor was installed are not
+  // matched by a WillProcessTask.
+  if (task_depth_ == 0 || --task_depth_ > 0)
+    return;
+
+  const base::TimeDelta duration = base::TimeTicks::Now() - task_start_;
+  task_duration_.Add(duration);
+  if (duration < kLongTaskThreshold)
+    return;
+
+  LongTask long_task;
+  long_task.start_time = base::Time::Now() - duration;
+  long_task.duration = duration;
+  long_task.posted_from = pending_task.posted_from.ToString();
+  long_task.api = std::move(slowest_call_);
+  long_task.api_duration = slowest_call_duration_;
+
+  TRACE_EVENT_INSTANT("electron", "EventLoopMonitor::LongTask", "duration_ms",
+                      duration.InMillisecondsF(), "posted_from",
+                      long_task.posted_from, "api", long_task.api);
+  crash_keys::AddBreadcrumb(
+      "long-task",
+      base::StringPrintf("%dms %s", static_cast<int>(duration.InMilliseconds()),
+                         long_task.posted_from.c_str()));
+
+  if (long_tasks_.size() == kMaxLongTasks)
+    long_tasks_.pop_front();
+  long_tasks_.push_back(std::move(long_task));
+}
+
+void EventLoopMonitor::RecordMicrotaskCheckpoint(base::TimeDelta duration) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  microtask_checkpoint_.Add(duration);
+}
+
+void EventLoopMonitor::RecordSkippedMicrotaskCheckpoint() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  ++skipped_microtask_checkpoints_;
+}
+
+void EventLoopMonitor::RecordUvRun(base::TimeDelta duration) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  uv_run_.Add(duration);
+}
+
+void EventLoopMonitor::RecordCall(base::TimeDelta duration,
+                                  base::FunctionRef<std::string()> describe) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (task_depth_ == 0 || duration < kMinAttributedCall ||
+      duration <= slowest_call_duration_)
+    return;
+  slowest_call_ = describe();
+  slowest_call_duration_ = duration;
+}
+
+base::Value::Dict EventLoopMonitor::GetStats() const {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  base::Value::List long_tasks;
+  for (const auto& long_task : long_tasks_) {
+    base::Value::Dict dict;
+    dict.Set("startTime", long_task.start_time.InMillisecondsFSinceUnixEpoch());
+    dict.Set("duration", long_task.duration.InMillisecondsF());
+    dict.Set("postedFrom", long_task.posted_from);
+    if (!long_task.api.empty()) {
+      dict.Set("api", long_task.api);
+      dict.Set("apiDuration", long_task.api_duration.InMillisecondsF());
+    }
+    long_tasks.Append(std::move(dict));
+  }
+
+  base::Value::Dict stats;
+  stats.Set("taskDuration", task_duration_.ToDict());
+  stats.Set("loopLag", loop_lag_.ToDict());
+  stats.Set("microtaskCheckpoint", microtask_checkpoint_.ToDict());
+  stats.Set("skippedMicrotaskCheckpoints",
+            static_cast<double>(skipped_microtask_checkpoints_));
+  stats.Set("uvRun", uv_run_.ToDict());
+  stats.Set("longTasks", std::move(long_tasks));
+  return stats;
+}
+
+void EventLoopMonitor::Reset() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  task_duration_.Reset();
+  loop_lag_.Reset();
+  microtask_checkpoint_.Reset();
+  skipped_microtask_checkpoints_ = 0;
+  uv_run_.Reset();
+  long_tasks_.clear();
+}
+
+}  // namespace electron
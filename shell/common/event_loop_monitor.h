@@ -0,0 +1,104 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_EVENT_LOOP_MONITOR_H_
+#define ELECTRON_SHELL_COMMON_EVENT_LOOP_MONITOR_H_
+
+#include <cstdint>
+#include <string>
+
+#include "base/containers/circular_deque.h"
+#include "base/functional/function_ref.h"
+#include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace base {
+struct PendingTask;
+}
+
+namespace electron {
+
+// Records how long the tasks of the current thread take and how late they
+// start, so that a stuttering main process can be diagnosed without a
+// profiler attached. The monitor is installed on the thread that creates it
+// and is fed by the MicrotasksRunner, NodeBindings and the gin_helper calls
+// into JavaScript.
+class EventLoopMonitor {
+ public:
+  // Tasks running for longer than this are kept as long tasks.
+  static constexpr base::TimeDelta kLongTaskThreshold = base::Milliseconds(50);
+
+  EventLoopMonitor();
+  ~EventLoopMonitor();
+
+  // disable copy
+  EventLoopMonitor(const EventLoopMonitor&) = delete;
+  EventLoopMonitor& operator=(const EventLoopMonitor&) = delete;
+
+  // Returns the monitor of the current thread, or nullptr.
+  static EventLoopMonitor* GetCurrent();
+
+  void WillProcessTask(const base::PendingTask& pending_task);
+  void DidProcessTask(const base::PendingTask& pending_task);
+
+  void RecordMicrotaskCheckpoint(base::TimeDelta duration);
+  // Counts a checkpoint that was skipped because the task did not touch V8.
+  void RecordSkippedMicrotaskCheckpoint();
+  void RecordUvRun(base::TimeDelta duration);
+
+  // Remembers the slowest call into JavaScript of the running task. |describe|
+  // is only invoked when the call is the slowest one so far.
+  void RecordCall(base::TimeDelta duration,
+                  base::FunctionRef<std::string()> describe);
+
+  base::Value::Dict GetStats() const;
+  void Reset();
+
+ private:
+  class Histogram {
+   public:
+    Histogram();
+    ~Histogram();
+
+    void Add(base::TimeDelta sample);
+    void Reset();
+    base::Value::Dict ToDict() const;
+
+   private:
+    uint64_t count_ = 0;
+    base::TimeDelta sum_;
+    base::TimeDelta min_ = base::TimeDelta::Max();
+    base::TimeDelta max_;
+    // Percentiles are computed over this window of the latest samples.
+    base::circular_deque<base::TimeDelta> recent_;
+  };
+
+  struct LongTask {
+    base::Time start_time;
+    base::TimeDelta duration;
+    std::string posted_from;
+    std::string api;
+    base::TimeDelta api_duration;
+  };
+
+  THREAD_CHECKER(thread_checker_);
+
+  Histogram task_duration_;
+  Histogram loop_lag_;
+  Histogram microtask_checkpoint_;
+  Histogram uv_run_;
+  uint64_t skipped_microtask_checkpoints_ = 0;
+  base::circular_deque<LongTask> long_tasks_;
+
+  // State of the outermost running task; nested run loops are folded into it.
+  int task_depth_ = 0;
+  base::TimeTicks task_start_;
+  std::string slowest_call_;
+  base::TimeDelta slowest_call_duration_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_EVENT_LOOP_MONITOR_H_
@@ -5,11 +5,14 @@
 #include "shell/common/gin_converters/blink_converter.h"
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "base/containers/fixed_flat_map.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversion_utils.h"
 #include "base/strings/utf_string_conversions.h"
@@ -216,6 +219,92 @@ blink::WebInputEvent::Type GetWebInputEventType(v8::Isolate* isolate,
   return type;
 }
 
+namespace {
+
+// Indexed by the kStreamType value.
+constexpr blink::WebInputEvent::Type kInputEventStreamTypes[] = {
+    blink::WebInputEvent::Type::kMouseDown,
+    blink::WebInputEvent::Type::kMouseUp,
+    blink::WebInputEvent::Type::kMouseMove,
+    blink::WebInputEvent::Type::kMouseEnter,
+    blink::WebInputEvent::Type::kMouseLeave,
+    blink::WebInputEvent::Type::kMouseWheel,
+};
+
+constexpr int kInputEventStreamModifiers =
+    blink::WebInputEvent::Modifiers::kShiftKey |
+    blink::WebInputEvent::Modifiers::kControlKey |
+    blink::WebInputEvent::Modifiers::kAltKey |
+    blink::WebInputEvent::Modifiers::kMetaKey |
+    blink::WebInputEvent::Modifiers::kLeftButtonDown |
+    blink::WebInputEvent::Modifiers::kMiddleButtonDown |
+    blink::WebInputEvent::Modifiers::kRightButtonDown;
+
+bool IsStreamInteger(double value, double min, double max) {
+  return value >= min && value <= max && std::trunc(value) == value;
+}
+
+}  // namespace
+
+bool DecodeInputEventStream(
+    base::span<const double> data,
+    base::TimeTicks now,
+    std::vector<std::unique_ptr<blink::WebMouseEvent>>* out) {
+  if (data.size() % kInputEventStreamStride != 0)
+    return false;
+  if (!base::ranges::all_of(data, [](double v) { return std::isfinite(v); }))
+    return false;
+  if (data.empty())
+    return true;
+
+  const double last_time_stamp =
+      data[data.size() - kInputEventStreamStride + kStreamTimeStamp];
+  for (size_t i = 0; i < data.size(); i += kInputEventStreamStride) {
+    base::span<const double> values = data.subspan(i, kInputEventStreamStride);
+    if (!IsStreamInteger(values[kStreamType], 0,
+                         std::size(kInputEventStreamTypes) - 1) ||
+        !IsStreamInteger(values[kStreamButton], -1, 2) ||
+        !IsStreamInteger(values[kStreamModifiers], 0,
+                         kInputEventStreamModifiers) ||
+        !IsStreamInteger(values[kStreamClickCount], 0, 3)) {
+      return false;
+    }
+
+    const blink::WebInputEvent::Type type =
+        kInputEventStreamTypes[static_cast<size_t>(values[kStreamType])];
+    const int modifiers = static_cast<int>(values[kStreamModifiers]) &
+                          kInputEventStreamModifiers;
+    const base::TimeTicks time_stamp =
+        now - base::Milliseconds(last_time_stamp - values[kStreamTimeStamp]);
+
+    std::unique_ptr<blink::WebMouseEvent> event;
+    if (type == blink::WebInputEvent::Type::kMouseWheel) {
+      auto wheel_event = std::make_unique<blink::WebMouseWheelEvent>(
+          type, modifiers, time_stamp);
+      wheel_event->delta_x = values[kStreamDeltaX];
+      wheel_event->delta_y = values[kStreamDeltaY];
+      wheel_event->delta_units = ui::ScrollGranularity::kScrollByPixel;
+      event = std::move(wheel_event);
+    } else {
+      event =
+          std::make_unique<blink::WebMouseEvent>(type, modifiers, time_stamp);
+    }
+    event->SetPositionInWidget(values[kStreamX], values[kStreamY]);
+    event->button = static_cast<blink::WebMouseEvent::Button>(
+        static_cast<int>(values[kStreamButton]));
+    event->click_count = static_cast<int>(values[kStreamClickCount]);
+
+    // Moves and wheel events of a recorded session come in runs, which are
+    // merged the same way blink merges those that queue up in the renderer.
+    if (!out->empty() && out->back()->CanCoalesce(*event)) {
+      out->back()->Coalesce(*event);
+      continue;
+    }
+    out->push_back(std::move(event));
+  }
+  return true;
+}
+
 bool Converter<blink::WebInputEvent>::FromV8(v8::Isolate* isolate,
                                              v8::Local<v8::Value> val,
                                              blink::WebInputEvent* out) {
@@ -5,6 +5,11 @@
 #ifndef ELECTRON_SHELL_COMMON_GIN_CONVERTERS_BLINK_CONVERTER_H_
 #define ELECTRON_SHELL_COMMON_GIN_CONVERTERS_BLINK_CONVERTER_H_
 
+#include <memory>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/time/time.h"
 #include "gin/converter.h"
 #include "third_party/blink/public/common/context_menu_data/context_menu_data.h"
 #include "third_party/blink/public/common/input/web_input_event.h"
@@ -24,6 +29,29 @@ namespace gin {
 blink::WebInputEvent::Type GetWebInputEventType(v8::Isolate* isolate,
                                                 v8::Local<v8::Value> val);
 
+// The values of each event in webContents.sendInputEvents().
+enum InputEventStreamField : size_t {
+  kStreamType,
+  kStreamTimeStamp,
+  kStreamModifiers,
+  kStreamX,
+  kStreamY,
+  kStreamButton,
+  kStreamClickCount,
+  kStreamDeltaX,
+  kStreamDeltaY,
+  kInputEventStreamStride,
+};
+
+// Decodes the events passed to webContents.sendInputEvents(), whose layout is
+// described in its docs, into |out|. Consecutive events that blink would merge
+// are coalesced. The last event is stamped with |now|. Returns false if |data|
+// is malformed.
+bool DecodeInputEventStream(
+    base::span<const double> data,
+    base::TimeTicks now,
+    std::vector<std::unique_ptr<blink::WebMouseEvent>>* out);
+
 template <>
 struct Converter<blink::WebInputEvent::Type> {
   static bool FromV8(v8::Isolate* isolate,
@@ -4,11 +4,12 @@
 
 #include "shell/common/gin_converters/extension_converter.h"
 
+#include "base/no_destructor.h"
 #include "extensions/common/extension.h"
-#include "gin/dictionary.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary_template.h"
 
 namespace gin {
 
@@ -16,15 +17,16 @@ namespace gin {
 v8::Local<v8::Value> Converter<const extensions::Extension*>::ToV8(
     v8::Isolate* isolate,
     const extensions::Extension* extension) {
-  auto dict = gin::Dictionary::CreateEmpty(isolate);
-  dict.Set("id", extension->id());
-  dict.Set("name", extension->name());
-  dict.Set("path", extension->path());
-  dict.Set("url", extension->url());
-  dict.Set("version", extension->VersionString());
-  dict.Set("manifest", *extension->manifest()->value());
-
-  return gin::ConvertToV8(isolate, dict);
+  static base::NoDestructor<gin_helper::DictionaryTemplate> templ(
+      {"id", "name", "path", "url", "version", "manifest"});
+  v8::MaybeLocal<v8::Value> values[] = {
+      gin::ConvertToV8(isolate, extension->id()),
+      gin::ConvertToV8(isolate, extension->name()),
+      gin::ConvertToV8(isolate, extension->path()),
+      gin::ConvertToV8(isolate, extension->url()),
+      gin::ConvertToV8(isolate, extension->VersionString()),
+      gin::ConvertToV8(isolate, *extension->manifest()->value())};
+  return templ->NewInstance(isolate, values);
 }
 
 }  // namespace gin
@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/span.h"
 #include "base/memory/raw_ptr.h"
 #include "base/strings/string_number_conversions.h"
@@ -159,20 +160,26 @@ v8::Local<v8::Value> Converter<net::CertPrincipal>::ToV8(
 v8::Local<v8::Value> Converter<net::HttpResponseHeaders*>::ToV8(
     v8::Isolate* isolate,
     net::HttpResponseHeaders* headers) {
-  base::Value::Dict response_headers;
+  // The values are grouped by name, sorted by name like base::Value::Dict
+  // used to do, and converted directly rather than through a base::Value.
+  base::flat_map<std::string, std::vector<std::string>> response_headers;
   if (headers) {
     size_t iter = 0;
     std::string key;
     std::string value;
-    while (headers->EnumerateHeaderLines(&iter, &key, &value)) {
-      key = base::ToLowerASCII(key);
-      base::Value::List* values = response_headers.FindList(key);
-      if (!values)
-        values = &response_headers.Set(key, base::Value::List())->GetList();
-      values->Append(value);
-    }
+    while (headers->EnumerateHeaderLines(&iter, &key, &value))
+      response_headers[base::ToLowerASCII(key)].push_back(std::move(value));
+  }
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Object> dict = v8::Object::New(isolate);
+  for (const auto& [name, header_values] : response_headers) {
+    // Unlike Set(), this doesn't call the setter of a "__proto__" header.
+    dict->CreateDataProperty(context, StringToV8(isolate, name),
+                             ConvertToV8(isolate, header_values))
+        .Check();
   }
-  return ConvertToV8(isolate, response_headers);
+  return dict;
 }
 
 bool Converter<net::HttpResponseHeaders*>::FromV8(
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/gin_helper/dictionary_template.h"
+
+#include "base/check_op.h"
+#include "base/memory/raw_ptr.h"
+#include "gin/per_isolate_data.h"
+
+namespace gin_helper {
+
+// Holds the template of an isolate, until the isolate is disposed.
+class DictionaryTemplate::IsolateTemplate
+    : public gin::PerIsolateData::DisposeObserver {
+ public:
+  IsolateTemplate(DictionaryTemplate* owner,
+                  v8::Isolate* isolate,
+                  gin::PerIsolateData* per_isolate_data,
+                  v8::Local<v8::DictionaryTemplate> templ)
+      : owner_(owner),
+        isolate_(isolate),
+        per_isolate_data_(per_isolate_data),
+        template_(isolate, templ) {
+    per_isolate_data_->AddDisposeObserver(this);
+  }
+  ~IsolateTemplate() override {
+    per_isolate_data_->RemoveDisposeObserver(this);
+  }
+
+  // disable copy
+  IsolateTemplate(const IsolateTemplate&) = delete;
+  IsolateTemplate& operator=(const IsolateTemplate&) = delete;
+
+  v8::Local<v8::DictionaryTemplate> Get() const {
+    return template_.Get(isolate_);
+  }
+
+  // gin::PerIsolateData::DisposeObserver:
+  void OnBeforeDispose(v8::Isolate* isolate) override { template_.Reset(); }
+  void OnDisposed() override {
+    // Deletes this.
+    owner_->templates_.erase(isolate_);
+  }
+
+ private:
+  const raw_ptr<DictionaryTemplate> owner_;
+  const raw_ptr<v8::Isolate> isolate_;
+  const raw_ptr<gin::PerIsolateData> per_isolate_data_;
+  v8::Global<v8::DictionaryTemplate> template_;
+};
+
+DictionaryTemplate::DictionaryTemplate(
+    std::initializer_list<std::string_view> names)
+    : names_(names) {}
+
+DictionaryTemplate::DictionaryTemplate(base::span<const std::string_view> names)
+    : names_(names.begin(), names.end()) {}
+
+DictionaryTemplate::~DictionaryTemplate() = default;
+
+v8::Local<v8::Object> DictionaryTemplate::NewInstance(
+    v8::Isolate* isolate,
+    base::span<v8::MaybeLocal<v8::Value>> values) {
+  CHECK_EQ(values.size(), names_.size());
+  return GetTemplate(isolate)->NewInstance(
+      isolate->GetCurrentContext(),
+      v8::MemorySpan<v8::MaybeLocal<v8::Value>>(values.data(), values.size()));
+}
+
+v8::Local<v8::DictionaryTemplate> DictionaryTemplate::GetTemplate(
+    v8::Isolate* isolate) {
+  auto it = templates_.find(isolate);
+  if (it != templates_.end())
+    return it->second->Get();
+
+  v8::Local<v8::DictionaryTemplate> templ = v8::DictionaryTemplate::New(
+      isolate,
+      v8::MemorySpan<const std::string_view>(names_.data(), names_.size()));
+  // Without a PerIsolateData, like in Node.js workers, there is no telling
+  // when the isolate goes away so the template can't be cached.
+  if (auto* per_isolate_data = gin::PerIsolateData::From(isolate)) {
+    templates_.emplace(isolate, std::make_unique<IsolateTemplate>(
+                                    this, isolate, per_isolate_data, templ));
+  }
+  return templ;
+}
+
+}  // namespace gin_helper
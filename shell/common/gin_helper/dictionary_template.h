@@ -0,0 +1,60 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_DICTIONARY_TEMPLATE_H_
+#define ELECTRON_SHELL_COMMON_GIN_HELPER_DICTIONARY_TEMPLATE_H_
+
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
+#include "v8/include/v8.h"
+
+namespace gin_helper {
+
+// Creates objects that have the same properties in a single call each,
+// instead of setting their properties one by one like gin_helper::Dictionary
+// does. The objects also share their hidden class, which makes a difference
+// for results holding thousands of them, like those of cookies.get().
+//
+// Templates are cached per isolate and are meant to be static:
+//
+//   static base::NoDestructor<gin_helper::DictionaryTemplate> templ(
+//       {"name", "value"});
+//   v8::MaybeLocal<v8::Value> values[] = {...};
+//   return templ->NewInstance(isolate, values);
+//
+// This class is not thread-safe, it should be used on a single thread.
+class DictionaryTemplate {
+ public:
+  // |names| must outlive the template, they are usually string literals.
+  explicit DictionaryTemplate(std::initializer_list<std::string_view> names);
+  explicit DictionaryTemplate(base::span<const std::string_view> names);
+  ~DictionaryTemplate();
+
+  // disable copy
+  DictionaryTemplate(const DictionaryTemplate&) = delete;
+  DictionaryTemplate& operator=(const DictionaryTemplate&) = delete;
+
+  // |values| are in the order of the names, those that are empty are left
+  // out of the object.
+  v8::Local<v8::Object> NewInstance(
+      v8::Isolate* isolate,
+      base::span<v8::MaybeLocal<v8::Value>> values);
+
+ private:
+  class IsolateTemplate;
+
+  v8::Local<v8::DictionaryTemplate> GetTemplate(v8::Isolate* isolate);
+
+  const std::vector<std::string_view> names_;
+  base::flat_map<v8::Isolate*, std::unique_ptr<IsolateTemplate>> templates_;
+};
+
+}  // namespace gin_helper
+
+#endif  // ELECTRON_SHELL_COMMON_GIN_HELPER_DICTIONARY_TEMPLATE_H_
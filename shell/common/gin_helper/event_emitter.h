@@ -44,6 +44,9 @@ class EventEmitter : public gin_helper::Wrappable<T> {
     v8::Local<v8::Object> wrapper = GetWrapper();
     if (wrapper.IsEmpty())
       return false;
+    // Nothing can prevent the default of an event nobody listens to.
+    if (!internal::ShouldEmit(isolate(), wrapper, name))
+      return false;
     gin::Handle<gin_helper::internal::Event> event =
         internal::Event::New(isolate());
     return EmitWithEvent(name, event, std::forward<Args>(args)...);
@@ -65,8 +68,8 @@ class EventEmitter : public gin_helper::Wrappable<T> {
     // It's possible that |this| will be deleted by EmitEvent, so save anything
     // we need from |this| before calling EmitEvent.
     auto* isolate = this->isolate();
-    gin_helper::EmitEvent(isolate, GetWrapper(), name, event,
-                          std::forward<Args>(args)...);
+    internal::EmitEventUnchecked(isolate, GetWrapper(), name, event,
+                                 std::forward<Args>(args)...);
     return event->GetDefaultPrevented();
   }
 };
@@ -4,10 +4,70 @@
 
 #include "shell/common/gin_helper/event_emitter_caller.h"
 
+#include <atomic>
+#include <string>
+#include <string_view>
+
+#include "base/time/time.h"
+#include "gin/converter.h"
+#include "shell/common/event_loop_monitor.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/node_includes.h"
 
-namespace gin_helper::internal {
+namespace gin_helper {
+
+namespace internal {
+
+namespace {
+
+std::atomic<uint64_t> g_emitted_events = 0;
+std::atomic<uint64_t> g_suppressed_events = 0;
+
+// Mirrors EventEmitter#emit(), which only calls the listeners stored in
+// |_events|. That object is created by the first listener added.
+bool HasListeners(v8::Isolate* isolate,
+                  v8::Local<v8::Object> obj,
+                  std::string_view name) {
+  // An unhandled 'error' throws, which has to happen in JS.
+  if (name == "error")
+    return true;
+
+  v8::Local<v8::Context> context = obj->GetCreationContextChecked();
+  // Some objects have their emit() replaced to forward their events to
+  // another emitter, whose listeners can't be known here.
+  if (obj->HasRealNamedProperty(context, gin::StringToSymbol(isolate, "emit"))
+          .FromMaybe(true))
+    return true;
+
+  v8::Local<v8::Value> events;
+  if (!obj->Get(context, gin::StringToSymbol(isolate, "_events"))
+           .ToLocal(&events))
+    return true;
+  if (!events->IsObject())
+    return false;
+
+  v8::Local<v8::Value> listeners;
+  if (!events.As<v8::Object>()
+           ->Get(context, gin::StringToV8(isolate, name))
+           .ToLocal(&listeners))
+    return true;
+  return !listeners->IsUndefined();
+}
+
+// Describes a call for the event loop monitor, e.g. "WebContents.emit('ipc')".
+std::string DescribeCall(v8::Isolate* isolate,
+                         v8::Local<v8::Object> obj,
+                         const char* method,
+                         const ValueVector& args) {
+  std::string description =
+      gin::V8ToString(isolate, obj->GetConstructorName()) + "." + method;
+  if (std::string_view(method) == "emit" && !args.empty() &&
+      args[0]->IsString())
+    description += "('" + gin::V8ToString(isolate, args[0]) + "')";
+  return description;
+}
+
+}  // namespace
 
 v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
                                         v8::Local<v8::Object> obj,
@@ -26,8 +86,16 @@ v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
       isolate, obj->GetCreationContextChecked()->GetMicrotaskQueue(), true);
   // Use node::MakeCallback to call the callback, and it will also run pending
   // tasks in Node.js.
+  auto* monitor = electron::EventLoopMonitor::GetCurrent();
+  const base::TimeTicks start =
+      monitor ? base::TimeTicks::Now() : base::TimeTicks();
   v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
       isolate, obj, method, args->size(), args->data(), {0, 0});
+  if (monitor) {
+    monitor->RecordCall(base::TimeTicks::Now() - start, [&] {
+      return DescribeCall(isolate, obj, method, *args);
+    });
+  }
   // If the JS function throws an exception (doesn't return a value) the result
   // of MakeCallback will be empty and therefore ToLocal will be false, in this
   // case we need to return "false" as that indicates that the event emitter did
@@ -39,4 +107,25 @@ v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
   return v8::Boolean::New(isolate, false);
 }
 
-}  // namespace gin_helper::internal
+bool ShouldEmit(v8::Isolate* isolate,
+                v8::Local<v8::Object> obj,
+                std::string_view name) {
+  if (HasListeners(isolate, obj, name)) {
+    g_emitted_events.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  g_suppressed_events.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+}  // namespace internal
+
+EmitStats GetEmitStats() {
+  EmitStats stats;
+  stats.emitted = internal::g_emitted_events.load(std::memory_order_relaxed);
+  stats.suppressed =
+      internal::g_suppressed_events.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace gin_helper
@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_CALLER_H_
 #define ELECTRON_SHELL_COMMON_GIN_HELPER_EVENT_EMITTER_CALLER_H_
 
+#include <cstdint>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -22,8 +24,24 @@ v8::Local<v8::Value> CallMethodWithArgs(v8::Isolate* isolate,
                                         const char* method,
                                         ValueVector* args);
 
+// Returns false when |obj| has no listener for |name|, in which case emitting
+// it would only convert the arguments and call into JS for nothing. Events
+// that are skipped are counted, see GetEmitStats().
+bool ShouldEmit(v8::Isolate* isolate,
+                v8::Local<v8::Object> obj,
+                std::string_view name);
+
 }  // namespace internal
 
+struct EmitStats {
+  // The events emitted to JS, and those skipped for lack of listeners.
+  uint64_t emitted = 0;
+  uint64_t suppressed = 0;
+};
+
+// The counters of the events emitted by native code in this process.
+EmitStats GetEmitStats();
+
 // obj.emit.apply(obj, name, args...);
 // The caller is responsible of allocating a HandleScope.
 template <typename StringType>
@@ -31,12 +49,31 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                v8::Local<v8::Object> obj,
                                const StringType& name,
                                const internal::ValueVector& args) {
+  if (!internal::ShouldEmit(isolate, obj, name))
+    return v8::False(isolate);
   internal::ValueVector concatenated_args = {gin::StringToV8(isolate, name)};
   concatenated_args.reserve(1 + args.size());
   concatenated_args.insert(concatenated_args.end(), args.begin(), args.end());
   return internal::CallMethodWithArgs(isolate, obj, "emit", &concatenated_args);
 }
 
+namespace internal {
+
+// Like EmitEvent() below, for callers that already checked ShouldEmit().
+template <typename StringType, typename... Args>
+v8::Local<v8::Value> EmitEventUnchecked(v8::Isolate* isolate,
+                                        v8::Local<v8::Object> obj,
+                                        const StringType& name,
+                                        Args&&... args) {
+  ValueVector converted_args = {
+      gin::StringToV8(isolate, name),
+      gin::ConvertToV8(isolate, std::forward<Args>(args))...,
+  };
+  return CallMethodWithArgs(isolate, obj, "emit", &converted_args);
+}
+
+}  // namespace internal
+
 // obj.emit(name, args...);
 // The caller is responsible of allocating a HandleScope.
 template <typename StringType, typename... Args>
@@ -44,11 +81,10 @@ v8::Local<v8::Value> EmitEvent(v8::Isolate* isolate,
                                v8::Local<v8::Object> obj,
                                const StringType& name,
                                Args&&... args) {
-  internal::ValueVector converted_args = {
-      gin::StringToV8(isolate, name),
-      gin::ConvertToV8(isolate, std::forward<Args>(args))...,
-  };
-  return internal::CallMethodWithArgs(isolate, obj, "emit", &converted_args);
+  if (!internal::ShouldEmit(isolate, obj, name))
+    return v8::False(isolate);
+  return internal::EmitEventUnchecked(isolate, obj, name,
+                                      std::forward<Args>(args)...);
 }
 
 // obj.custom_emit(args...)
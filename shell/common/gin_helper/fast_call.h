@@ -0,0 +1,101 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_GIN_HELPER_FAST_CALL_H_
+#define ELECTRON_SHELL_COMMON_GIN_HELPER_FAST_CALL_H_
+
+#include <cstdint>
+#include <type_traits>
+
+#include "base/functional/bind.h"
+#include "gin/public/wrapper_info.h"
+#include "gin/wrappable.h"
+#include "shell/common/gin_helper/function_template.h"
+#include "shell/common/gin_helper/wrappable_base.h"
+#include "v8/include/v8-fast-api-calls.h"
+
+// V8 can call a C++ function directly from optimized code when it is given a
+// v8::CFunction, which skips creating the v8::FunctionCallbackInfo and
+// converting the arguments and the return value. The C function can't
+// allocate on the V8 heap, call into JavaScript or throw, so this is only
+// offered for the getters of a wrapped object that return a primitive.
+
+namespace gin_helper {
+
+namespace internal {
+
+// Returns the native object of |receiver| like the converters of
+// gin::Wrappable and gin_helper::Wrappable do, without using the isolate.
+template <typename T>
+T* UnwrapForFastCall(v8::Local<v8::Object> receiver) {
+  if constexpr (std::is_convertible_v<T*, WrappableBase*>) {
+    if (receiver->InternalFieldCount() != 1)
+      return nullptr;
+    return static_cast<T*>(static_cast<WrappableBase*>(
+        receiver->GetAlignedPointerFromInternalField(0)));
+  } else {
+    if (gin::WrapperInfo::From(receiver) != &T::kWrapperInfo)
+      return nullptr;
+    return static_cast<T*>(static_cast<gin::WrappableBase*>(
+        receiver->GetAlignedPointerFromInternalField(gin::kEncodedValueIndex)));
+  }
+}
+
+template <typename T>
+constexpr bool IsFastCallReturnType =
+    std::is_void_v<T> || std::is_same_v<T, bool> ||
+    std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <typename T, typename ReturnType, auto method>
+struct FastMethodImpl {
+  static_assert(IsFastCallReturnType<ReturnType>,
+                "Fast calls can only return void or a primitive");
+
+  static ReturnType Call(v8::Local<v8::Object> receiver,
+                         v8::FastApiCallbackOptions& options) {
+    T* self = UnwrapForFastCall<T>(receiver);
+    if (!self) {
+      // The slow path throws the same error as when the method isn't
+      // optimized.
+      options.fallback = true;
+      return ReturnType();
+    }
+    return (self->*method)();
+  }
+
+  static const v8::CFunction* GetCFunction() {
+    static const v8::CFunction c_function = v8::CFunction::Make(&Call);
+    return &c_function;
+  }
+};
+
+}  // namespace internal
+
+// FastMethod<method> holds the C function of a member function without
+// arguments.
+template <auto method, typename Method = decltype(method)>
+struct FastMethod;
+
+template <auto method, typename T, typename ReturnType>
+struct FastMethod<method, ReturnType (T::*)()>
+    : internal::FastMethodImpl<T, ReturnType, method> {};
+
+template <auto method, typename T, typename ReturnType>
+struct FastMethod<method, ReturnType (T::*)() const>
+    : internal::FastMethodImpl<T, ReturnType, method> {};
+
+// Creates a function template that calls |method| on its holder, through the
+// usual conversions in the interpreter and directly from optimized code.
+template <auto method>
+v8::Local<v8::FunctionTemplate> CreateFastFunctionTemplate(
+    v8::Isolate* isolate) {
+  return CreateFunctionTemplate(isolate, base::BindRepeating(method),
+                                {.holder_is_first_argument = true},
+                                FastMethod<method>::GetCFunction());
+}
+
+}  // namespace gin_helper
+
+#endif  // ELECTRON_SHELL_COMMON_GIN_HELPER_FAST_CALL_H_
@@ -344,11 +344,15 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
 // relied upon. As such, any destructors for objects bound to the callback must
 // not depend on the isolate being alive at the point they are called. The order
 // in which callbacks are destroyed is not guaranteed.
+//
+// When |c_function| is given, optimized code calls it instead of |callback|,
+// see fast_call.h. It must outlive the template.
 template <typename Sig>
 v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
     v8::Isolate* isolate,
     base::RepeatingCallback<Sig> callback,
-    InvokerOptions invoker_options = {}) {
+    InvokerOptions invoker_options = {},
+    const v8::CFunction* c_function = nullptr) {
   typedef CallbackHolder<Sig> HolderT;
   HolderT* holder =
       new HolderT(isolate, std::move(callback), std::move(invoker_options));
@@ -357,7 +361,8 @@ v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
       isolate, &Dispatcher<Sig>::DispatchToCallback,
       gin::ConvertToV8<v8::Local<v8::External>>(isolate,
                                                 holder->GetHandle(isolate)),
-      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow);
+      v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow,
+      v8::SideEffectType::kHasSideEffect, c_function);
   return tmpl;
 }
 
@@ -4,16 +4,26 @@
 
 #include "shell/common/gin_helper/microtasks_scope.h"
 
+#include <utility>
+
 #include "shell/common/process_util.h"
 
 namespace gin_helper {
 
+namespace {
+
+constinit thread_local bool was_entered = false;
+constinit thread_local bool checkpoints_deferred = false;
+
+}  // namespace
+
 MicrotasksScope::MicrotasksScope(v8::Isolate* isolate,
                                  v8::MicrotaskQueue* microtask_queue,
                                  bool ignore_browser_checkpoint,
                                  v8::MicrotasksScope::Type scope_type) {
+  was_entered = true;
   if (electron::IsBrowserProcess()) {
-    if (!ignore_browser_checkpoint)
+    if (!ignore_browser_checkpoint && !checkpoints_deferred)
       v8::MicrotasksScope::PerformCheckpoint(isolate);
   } else {
     v8_microtasks_scope_ = std::make_unique<v8::MicrotasksScope>(
@@ -23,4 +33,14 @@ MicrotasksScope::MicrotasksScope(v8::Isolate* isolate,
 
 MicrotasksScope::~MicrotasksScope() = default;
 
+// static
+bool MicrotasksScope::TakeWasEntered() {
+  return std::exchange(was_entered, false);
+}
+
+// static
+base::AutoReset<bool> MicrotasksScope::DeferBrowserCheckpoints() {
+  return base::AutoReset<bool>(&checkpoints_deferred, true);
+}
+
 }  // namespace gin_helper
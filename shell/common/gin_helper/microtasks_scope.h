@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "base/auto_reset.h"
 #include "v8/include/v8.h"
 
 namespace gin_helper {
@@ -26,6 +27,16 @@ class MicrotasksScope {
   MicrotasksScope(const MicrotasksScope&) = delete;
   MicrotasksScope& operator=(const MicrotasksScope&) = delete;
 
+  // Returns whether a scope was created on the current thread since the last
+  // call. Promises are settled in a scope, so the browser's MicrotasksRunner
+  // uses this to tell whether a task may have queued microtasks.
+  static bool TakeWasEntered();
+
+  // While the returned object lives, the scopes created in the browser process
+  // leave the checkpoint to the one that the MicrotasksRunner performs after
+  // the task, so that the microtasks of several settled promises run at once.
+  [[nodiscard]] static base::AutoReset<bool> DeferBrowserCheckpoints();
+
  private:
   std::unique_ptr<v8::MicrotasksScope> v8_microtasks_scope_;
 };
@@ -8,6 +8,7 @@
 #include <string_view>
 
 #include "base/memory/raw_ptr.h"
+#include "shell/common/gin_helper/fast_call.h"
 #include "shell/common/gin_helper/function_template.h"
 
 namespace gin_helper {
@@ -59,6 +60,19 @@ class ObjectTemplateBuilder {
                            CallbackTraits<U>::CreateTemplate(isolate_, setter));
   }
 
+  // Like SetMethod() and SetProperty(), but optimized code calls |method| and
+  // |getter| without converting anything. They must be member functions
+  // without arguments that return void or a primitive, see fast_call.h.
+  template <auto method>
+  ObjectTemplateBuilder& SetFastMethod(const std::string_view name) {
+    return SetImpl(name, CreateFastFunctionTemplate<method>(isolate_));
+  }
+  template <auto getter>
+  ObjectTemplateBuilder& SetFastProperty(const std::string_view name) {
+    return SetPropertyImpl(name, CreateFastFunctionTemplate<getter>(isolate_),
+                           v8::Local<v8::FunctionTemplate>());
+  }
+
   v8::Local<v8::ObjectTemplate> Build();
 
  private:
@@ -3,11 +3,67 @@
 // found in the LICENSE file.
 
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "shell/common/gin_helper/promise.h"
 
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/trace_event/trace_event.h"
+
 namespace gin_helper {
 
+namespace {
+
+// The settlements waiting for the task that runs them.
+struct PendingSettlements {
+  base::Lock lock;
+  std::vector<base::OnceClosure> closures GUARDED_BY(lock);
+};
+
+PendingSettlements& GetPendingSettlements() {
+  static base::NoDestructor<PendingSettlements> pending;
+  return *pending;
+}
+
+void RunPendingSettlements() {
+  std::vector<base::OnceClosure> closures;
+  {
+    PendingSettlements& pending = GetPendingSettlements();
+    base::AutoLock auto_lock(pending.lock);
+    closures.swap(pending.closures);
+  }
+  TRACE_EVENT1("electron", "RunPendingSettlements", "count", closures.size());
+  // The reactions of the promises run after all of them have been settled.
+  auto defer_checkpoints = MicrotasksScope::DeferBrowserCheckpoints();
+  for (auto& closure : closures)
+    std::move(closure).Run();
+}
+
+}  // namespace
+
+// static
+void PromiseBase::SettleInBatch(base::OnceClosure settle) {
+  if (!electron::IsBrowserProcess()) {
+    std::move(settle).Run();
+    return;
+  }
+
+  bool was_empty;
+  {
+    PendingSettlements& pending = GetPendingSettlements();
+    base::AutoLock auto_lock(pending.lock);
+    was_empty = pending.closures.empty();
+    pending.closures.push_back(std::move(settle));
+  }
+  if (was_empty) {
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE, base::BindOnce(&RunPendingSettlements));
+  }
+}
+
 PromiseBase::PromiseBase(v8::Isolate* isolate)
     : PromiseBase(isolate,
                   v8::Promise::Resolver::New(isolate->GetCurrentContext())
@@ -71,15 +127,8 @@ v8::Local<v8::Promise::Resolver> PromiseBase::GetInner() const {
 
 // static
 void Promise<void>::ResolvePromise(Promise<void> promise) {
-  if (electron::IsBrowserProcess() &&
-      !content::BrowserThread::CurrentlyOn(content::BrowserThread::UI)) {
-    content::GetUIThreadTaskRunner({})->PostTask(
-        FROM_HERE,
-        base::BindOnce([](Promise<void> promise) { promise.Resolve(); },
-                       std::move(promise)));
-  } else {
-    promise.Resolve();
-  }
+  SettleInBatch(base::BindOnce(
+      [](Promise<void> promise) { promise.Resolve(); }, std::move(promise)));
 }
 
 // static
@@ -11,6 +11,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
@@ -43,27 +44,29 @@ class PromiseBase {
   PromiseBase(PromiseBase&&);
   PromiseBase& operator=(PromiseBase&&);
 
+  // Runs |settle|, which resolves or rejects promises, on the UI thread
+  // together with the others that are passed before it runs.
+  //
+  // In the browser process bulk async APIs complete many promises in a row, so
+  // they are settled from a single task that is followed by a single microtask
+  // checkpoint, instead of one of each per promise. Can be called from any
+  // thread, |settle| runs right away in the other processes.
+  static void SettleInBatch(base::OnceClosure settle);
+
   // Helper for rejecting promise with error message.
   //
   // Note: The parameter type is PromiseBase&& so it can take the instances of
   // Promise<T> type.
   static void RejectPromise(PromiseBase&& promise,
                             const std::string_view errmsg) {
-    if (electron::IsBrowserProcess() &&
-        !content::BrowserThread::CurrentlyOn(content::BrowserThread::UI)) {
-      content::GetUIThreadTaskRunner({})->PostTask(
-          FROM_HERE,
-          base::BindOnce(
-              // Note that this callback can not take std::string_view,
-              // as StringPiece only references string internally and
-              // will blow when a temporary string is passed.
-              [](PromiseBase&& promise, std::string str) {
-                promise.RejectWithErrorMessage(str);
-              },
-              std::move(promise), std::string{errmsg}));
-    } else {
-      promise.RejectWithErrorMessage(errmsg);
-    }
+    SettleInBatch(base::BindOnce(
+        // Note that this callback can not take std::string_view,
+        // as StringPiece only references string internally and
+        // will blow when a temporary string is passed.
+        [](PromiseBase&& promise, std::string str) {
+          promise.RejectWithErrorMessage(str);
+        },
+        std::move(promise), std::string{errmsg}));
   }
 
   v8::Maybe<bool> Reject();
@@ -92,15 +95,9 @@ class Promise : public PromiseBase {
 
   // Helper for resolving the promise with |result|.
   static void ResolvePromise(Promise<RT> promise, RT result) {
-    if (electron::IsBrowserProcess() &&
-        !content::BrowserThread::CurrentlyOn(content::BrowserThread::UI)) {
-      content::GetUIThreadTaskRunner({})->PostTask(
-          FROM_HERE, base::BindOnce([](Promise<RT> promise,
-                                       RT result) { promise.Resolve(result); },
-                                    std::move(promise), std::move(result)));
-    } else {
-      promise.Resolve(result);
-    }
+    SettleInBatch(base::BindOnce(
+        [](Promise<RT> promise, RT result) { promise.Resolve(result); },
+        std::move(promise), std::move(result)));
   }
 
   // Returns an already-resolved promise.
@@ -98,11 +98,17 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
   }
 
   // Returns all objects in this class's weak map.
-  static std::vector<v8::Local<v8::Object>> GetAll(v8::Isolate* isolate) {
-    if (weak_map_)
-      return weak_map_->Values(isolate);
-    else
-      return std::vector<v8::Local<v8::Object>>();
+  static v8::Local<v8::Array> GetAll(v8::Isolate* isolate) {
+    if (!weak_map_)
+      return v8::Array::New(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Array> objects =
+        v8::Array::New(isolate, static_cast<int>(weak_map_->size()));
+    uint32_t index = 0;
+    weak_map_->ForEach(isolate, [&](v8::Local<v8::Object> object) {
+      objects->Set(context, index++, object).Check();
+    });
+    return objects;
   }
 
   // Removes this instance from the weak map.
@@ -4,8 +4,24 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "base/files/file.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/json/json_writer.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/values.h"
+#include "gin/converter.h"
+#include "shell/common/thread_restrictions.h"
 #include "v8/include/v8-profiler.h"
 #include "v8/include/v8.h"
 
@@ -33,6 +49,123 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   bool is_complete_ = false;
 };
 
+// Writes the chunks of a file on the thread pool. When too much data is
+// pending, chunks are written in place instead, which slows the producer
+// down to the speed of the disk rather than buffering the whole file.
+class ChunkWriter : public base::RefCountedThreadSafe<ChunkWriter> {
+ public:
+  explicit ChunkWriter(base::File file)
+      : file_(std::move(file)),
+        task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+            {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+             base::TaskShutdownBehavior::BLOCK_SHUTDOWN})) {}
+
+  // disable copy
+  ChunkWriter(const ChunkWriter&) = delete;
+  ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+  // Returns false once a chunk failed to be written.
+  bool Write(const char* data, size_t size) {
+    if (failed_)
+      return false;
+
+    // Chunks are written at their offset, so that the ones written in place
+    // don't have to wait for those that are pending.
+    const int64_t offset = offset_;
+    offset_ += size;
+    if (pending_bytes_ + size > kMaxPendingBytes) {
+      electron::ScopedAllowBlockingForElectron allow_blocking;
+      WriteAt(offset, data, size);
+    } else {
+      pending_bytes_ += size;
+      task_runner_->PostTask(
+          FROM_HERE, base::BindOnce(&ChunkWriter::WritePending, this, offset,
+                                    std::string(data, size)));
+    }
+    return !failed_;
+  }
+
+  // Runs |callback| on the calling sequence once the pending chunks were
+  // written.
+  void Finish(base::OnceCallback<void(bool)> callback) {
+    task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE, base::BindOnce(&ChunkWriter::succeeded, this),
+        std::move(callback));
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<ChunkWriter>;
+  ~ChunkWriter() = default;
+
+  static constexpr size_t kMaxPendingBytes = 32 * 1024 * 1024;
+
+  bool succeeded() const { return !failed_; }
+
+  void WritePending(int64_t offset, std::string data) {
+    WriteAt(offset, data.data(), data.size());
+    pending_bytes_ -= data.size();
+  }
+
+  void WriteAt(int64_t offset, const char* data, size_t size) {
+    const int length = base::checked_cast<int>(size);
+    if (!failed_ && file_.Write(offset, data, length) != length)
+      failed_ = true;
+  }
+
+  base::File file_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  // Only used on the producer's sequence.
+  int64_t offset_ = 0;
+  std::atomic<size_t> pending_bytes_ = 0;
+  std::atomic<bool> failed_ = false;
+};
+
+class StreamingOutputStream : public v8::OutputStream {
+ public:
+  explicit StreamingOutputStream(ChunkWriter* writer) : writer_(writer) {}
+
+  bool IsComplete() const { return is_complete_; }
+
+  // v8::OutputStream
+  int GetChunkSize() override { return 65536; }
+  void EndOfStream() override { is_complete_ = true; }
+
+  v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
+    return writer_->Write(data, size) ? kContinue : kAbort;
+  }
+
+ private:
+  raw_ptr<ChunkWriter> writer_;
+  bool is_complete_ = false;
+};
+
+// Converts |node| to the ProfileNode of the DevTools protocol.
+base::Value::Dict ToProfileNode(v8::Isolate* isolate,
+                                const v8::AllocationProfile::Node* node) {
+  base::Value::Dict call_frame;
+  call_frame.Set("functionName", gin::V8ToString(isolate, node->name));
+  call_frame.Set("scriptId", base::NumberToString(node->script_id));
+  call_frame.Set("url", gin::V8ToString(isolate, node->script_name));
+  // The DevTools count lines and columns from 0.
+  call_frame.Set("lineNumber", node->line_number - 1);
+  call_frame.Set("columnNumber", node->column_number - 1);
+
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  base::Value::List children;
+  for (const v8::AllocationProfile::Node* child : node->children)
+    children.Append(ToProfileNode(isolate, child));
+
+  base::Value::Dict dict;
+  dict.Set("callFrame", std::move(call_frame));
+  dict.Set("selfSize", self_size);
+  dict.Set("id", static_cast<int>(node->node_id));
+  dict.Set("children", std::move(children));
+  return dict;
+}
+
 }  // namespace
 
 namespace electron {
@@ -56,4 +189,76 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   return stream.IsComplete();
 }
 
+void TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File file,
+                      base::OnceCallback<void(bool)> callback) {
+  DCHECK(isolate);
+
+  const v8::HeapSnapshot* snapshot =
+      file.IsValid() ? isolate->GetHeapProfiler()->TakeHeapSnapshot()
+                     : nullptr;
+  if (!snapshot) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), false));
+    return;
+  }
+
+  auto writer = base::MakeRefCounted<ChunkWriter>(std::move(file));
+  StreamingOutputStream stream(writer.get());
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+
+  writer->Finish(base::BindOnce(
+      [](bool complete, base::OnceCallback<void(bool)> callback,
+         bool written) { std::move(callback).Run(complete && written); },
+      stream.IsComplete(), std::move(callback)));
+}
+
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth) {
+  return isolate->GetHeapProfiler()->StartSamplingHeapProfiler(sample_interval,
+                                                               stack_depth);
+}
+
+void StopSamplingHeapProfiler(v8::Isolate* isolate) {
+  isolate->GetHeapProfiler()->StopSamplingHeapProfiler();
+}
+
+void WriteSamplingHeapProfile(v8::Isolate* isolate,
+                              base::File file,
+                              base::OnceCallback<void(bool)> callback) {
+  v8::HandleScope handle_scope(isolate);
+  std::unique_ptr<v8::AllocationProfile> profile;
+  if (file.IsValid())
+    profile.reset(isolate->GetHeapProfiler()->GetAllocationProfile());
+  if (!profile) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), false));
+    return;
+  }
+
+  base::Value::List samples;
+  for (const v8::AllocationProfile::Sample& sample : profile->GetSamples()) {
+    base::Value::Dict dict;
+    dict.Set("size", static_cast<double>(sample.size) * sample.count);
+    dict.Set("nodeId", static_cast<int>(sample.node_id));
+    dict.Set("ordinal", static_cast<double>(sample.sample_id));
+    samples.Append(std::move(dict));
+  }
+
+  base::Value::Dict result;
+  result.Set("head", ToProfileNode(isolate, profile->GetRootNode()));
+  result.Set("samples", std::move(samples));
+  std::string json;
+  const bool serialized = base::JSONWriter::Write(result, &json);
+
+  auto writer = base::MakeRefCounted<ChunkWriter>(std::move(file));
+  writer->Write(json.data(), json.size());
+  writer->Finish(base::BindOnce(
+      [](bool serialized, base::OnceCallback<void(bool)> callback,
+         bool written) { std::move(callback).Run(serialized && written); },
+      serialized, std::move(callback)));
+}
+
 }  // namespace electron
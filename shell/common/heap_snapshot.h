@@ -5,9 +5,10 @@
 #ifndef ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 
-namespace base {
-class File;
-}
+#include <cstdint>
+
+#include "base/files/file.h"
+#include "base/functional/callback_forward.h"
 
 namespace v8 {
 class Isolate;
@@ -17,6 +18,27 @@ namespace electron {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Like above, but the snapshot is written to |file| on the thread pool while
+// it is being serialized. |callback| runs on the calling sequence once the
+// whole snapshot was written.
+void TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File file,
+                      base::OnceCallback<void(bool)> callback);
+
+// Samples an allocation every |sample_interval| bytes on average, recording
+// |stack_depth| frames of its stack. This is cheap enough to be left running
+// in production, unlike heap snapshots.
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth);
+void StopSamplingHeapProfiler(v8::Isolate* isolate);
+
+// Writes the sampled allocations that are still alive to |file|, in the
+// .heapprofile format of the DevTools.
+void WriteSamplingHeapProfile(v8::Isolate* isolate,
+                              base::File file,
+                              base::OnceCallback<void(bool)> callback);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
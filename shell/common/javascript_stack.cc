@@ -0,0 +1,43 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/javascript_stack.h"
+
+#include "base/strings/stringprintf.h"
+#include "gin/converter.h"
+#include "v8/include/v8-isolate.h"
+#include "v8/include/v8-local-handle.h"
+#include "v8/include/v8-primitive.h"
+#include "v8/include/v8-script.h"
+
+namespace electron {
+
+namespace {
+
+constexpr int kMaxStackFrames = 32;
+
+}  // namespace
+
+std::string CaptureJavaScriptStack(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> trace =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string stack;
+  for (int i = 0; i < trace->GetFrameCount(); i++) {
+    v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, i);
+    std::string function_name;
+    std::string script_name;
+    if (!frame->GetFunctionName().IsEmpty())
+      function_name = gin::V8ToString(isolate, frame->GetFunctionName());
+    if (!frame->GetScriptName().IsEmpty())
+      script_name = gin::V8ToString(isolate, frame->GetScriptName());
+    base::StringAppendF(
+        &stack, "    at %s (%s:%d:%d)\n",
+        function_name.empty() ? "<anonymous>" : function_name.c_str(),
+        script_name.c_str(), frame->GetLineNumber(), frame->GetColumn());
+  }
+  return stack;
+}
+
+}  // namespace electron
@@ -0,0 +1,23 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_JAVASCRIPT_STACK_H_
+#define ELECTRON_SHELL_COMMON_JAVASCRIPT_STACK_H_
+
+#include <string>
+
+namespace v8 {
+class Isolate;
+}  // namespace v8
+
+namespace electron {
+
+// Returns the JavaScript stack running on |isolate|, one "    at" line per
+// frame like Error.stack, or an empty string when no JavaScript is running.
+// Must be called on the thread of |isolate|, e.g. from an interrupt.
+std::string CaptureJavaScriptStack(v8::Isolate* isolate);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_JAVASCRIPT_STACK_H_
@@ -15,13 +15,17 @@
 namespace electron {
 
 // Like ES6's WeakMap, with a K key and Weak Pointer value.
+//
+// The objects are packed densely, so that iterating over them with ForEach()
+// doesn't allocate and removing one moves the last object into its place
+// instead of shifting the others.
 template <typename K>
 class KeyWeakMap {
  public:
   KeyWeakMap() {}
   ~KeyWeakMap() {
-    for (auto& p : map_)
-      p.second.second.ClearWeak();
+    for (auto& value : values_)
+      value.object.ClearWeak();
   }
 
   // disable copy
@@ -30,54 +34,92 @@ class KeyWeakMap {
 
   // Sets the object to WeakMap with the given |key|.
   void Set(v8::Isolate* isolate, const K& key, v8::Local<v8::Object> object) {
-    KeyObject key_object = {key, this};
-    auto& p = map_[key] =
-        std::make_pair(key_object, v8::Global<v8::Object>(isolate, object));
-    p.second.SetWeak(&(p.first), OnObjectGC, v8::WeakCallbackType::kParameter);
+    auto [iter, inserted] = slots_.try_emplace(key);
+    Slot& slot = iter->second;
+    if (inserted) {
+      slot.self = this;
+      slot.index = values_.size();
+      values_.emplace_back();
+      values_.back().slot = &slot;
+    }
+    v8::Global<v8::Object>& global = values_[slot.index].object;
+    global.Reset(isolate, object);
+    global.SetWeak(&*iter, OnObjectGC, v8::WeakCallbackType::kParameter);
   }
 
   // Gets the object from WeakMap by its |key|.
   v8::MaybeLocal<v8::Object> Get(v8::Isolate* isolate, const K& key) {
-    if (auto iter = map_.find(key); iter != map_.end())
-      return v8::Local<v8::Object>::New(isolate, iter->second.second);
+    if (auto iter = slots_.find(key); iter != slots_.end())
+      return v8::Local<v8::Object>::New(isolate,
+                                        values_[iter->second.index].object);
     return {};
   }
 
+  // Whether there is an object with |key| in the WeakMap.
+  bool Has(const K& key) const { return slots_.contains(key); }
+
+  size_t size() const { return values_.size(); }
+
+  // Calls |callback| with each object, in no particular order. The map must
+  // not be changed by |callback|, use Values() to iterate over a copy instead.
+  template <typename Callback>
+  void ForEach(v8::Isolate* isolate, Callback callback) const {
+    for (const auto& value : values_)
+      callback(v8::Local<v8::Object>::New(isolate, value.object));
+  }
+
   // Returns all objects.
   std::vector<v8::Local<v8::Object>> Values(v8::Isolate* isolate) const {
     std::vector<v8::Local<v8::Object>> values;
-    values.reserve(map_.size());
-    for (const auto& it : map_)
-      values.emplace_back(
-          v8::Local<v8::Object>::New(isolate, it.second.second));
+    values.reserve(values_.size());
+    ForEach(isolate, [&values](v8::Local<v8::Object> object) {
+      values.push_back(object);
+    });
     return values;
   }
 
   // Remove object with |key| in the WeakMap.
   void Remove(const K& key) {
-    auto iter = map_.find(key);
-    if (iter == map_.end())
+    auto iter = slots_.find(key);
+    if (iter == slots_.end())
       return;
 
-    iter->second.second.ClearWeak();
-    map_.erase(iter);
+    const size_t index = iter->second.index;
+    values_[index].object.ClearWeak();
+    if (index != values_.size() - 1) {
+      values_[index] = std::move(values_.back());
+      values_[index].slot->index = index;
+    }
+    values_.pop_back();
+    slots_.erase(iter);
   }
 
  private:
-  // Records the key and self, used by SetWeak.
-  struct KeyObject {
-    K key;
+  // The position of an object in |values_|, the address of its entry in
+  // |slots_| is stable and is used by SetWeak.
+  struct Slot {
     raw_ptr<KeyWeakMap> self;
+    size_t index = 0;
   };
 
-  static void OnObjectGC(
-      const v8::WeakCallbackInfo<typename KeyWeakMap<K>::KeyObject>& data) {
-    KeyWeakMap<K>::KeyObject* key_object = data.GetParameter();
-    key_object->self->Remove(key_object->key);
+  struct Value {
+    v8::Global<v8::Object> object;
+    raw_ptr<Slot> slot;
+  };
+
+  using SlotEntry = std::pair<const K, Slot>;
+
+  static void OnObjectGC(const v8::WeakCallbackInfo<SlotEntry>& data) {
+    SlotEntry* entry = data.GetParameter();
+    // The key is destroyed along with the entry.
+    const K key = entry->first;
+    entry->second.self->Remove(key);
   }
 
-  // Map of stored objects.
-  std::unordered_map<K, std::pair<KeyObject, v8::Global<v8::Object>>> map_;
+  // Map of the keys to the position of their objects.
+  std::unordered_map<K, Slot> slots_;
+  // The stored objects.
+  std::vector<Value> values_;
 };
 
 }  // namespace electron
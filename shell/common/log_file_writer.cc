@@ -0,0 +1,180 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/log_file_writer.h"
+
+#include <stdio.h>
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/threading/platform_thread.h"
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <share.h>
+#endif
+
+namespace logging {
+
+namespace {
+
+// The messages that are waiting to be written are bounded, so that a thread
+// that logs faster than the disk can take doesn't grow the memory without
+// limits.
+constexpr size_t kMaxBufferSize = 4 * 1024 * 1024;
+
+FILE* OpenLogFile(const base::FilePath& path, bool truncate) {
+#if BUILDFLAG(IS_WIN)
+  return _wfsopen(path.value().c_str(), truncate ? L"wb" : L"ab", _SH_DENYNO);
+#else
+  return fopen(path.value().c_str(), truncate ? "w" : "a");
+#endif
+}
+
+class LogFileWriter : public base::PlatformThread::Delegate {
+ public:
+  LogFileWriter(const base::FilePath& path,
+                bool truncate,
+                int64_t max_file_size)
+      : path_(path),
+        max_file_size_(max_file_size),
+        file_(OpenLogFile(path, truncate)) {}
+
+  // disable copy
+  LogFileWriter(const LogFileWriter&) = delete;
+  LogFileWriter& operator=(const LogFileWriter&) = delete;
+
+  bool is_open() {
+    base::AutoLock file_lock(file_lock_);
+    return file_ != nullptr;
+  }
+
+  void Add(const std::string& message) {
+    base::AutoLock lock(lock_);
+    if (buffer_.size() + message.size() > kMaxBufferSize) {
+      dropped_++;
+      return;
+    }
+    buffer_ += message;
+    has_messages_.Signal();
+  }
+
+  // Writes out the buffered messages on the calling thread.
+  void Flush() {
+    base::AutoLock file_lock(file_lock_);
+    WriteBuffered();
+  }
+
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override {
+    base::PlatformThread::SetName("ElectronLogFileWriter");
+    while (true) {
+      {
+        base::AutoLock lock(lock_);
+        while (buffer_.empty() && dropped_ == 0)
+          has_messages_.Wait();
+      }
+      base::AutoLock file_lock(file_lock_);
+      WriteBuffered();
+      RotateIfNeeded();
+    }
+  }
+
+ private:
+  // The messages are taken under |file_lock_|, so that the batches are
+  // written in order whether they are written by the thread or by Flush().
+  void WriteBuffered() EXCLUSIVE_LOCKS_REQUIRED(file_lock_) {
+    std::string messages;
+    size_t dropped;
+    {
+      base::AutoLock lock(lock_);
+      messages.swap(buffer_);
+      dropped = std::exchange(dropped_, 0);
+    }
+    if (!file_)
+      return;
+    if (dropped > 0) {
+      messages += "[" + base::NumberToString(dropped) +
+                  " log messages were dropped]\n";
+    }
+    fwrite(messages.data(), 1, messages.size(), file_);
+    fflush(file_);
+  }
+
+  void RotateIfNeeded() EXCLUSIVE_LOCKS_REQUIRED(file_lock_) {
+    if (!file_ || max_file_size_ <= 0 || ftell(file_) < max_file_size_)
+      return;
+    fclose(file_);
+    base::ReplaceFile(path_, path_.AddExtension(FILE_PATH_LITERAL("1")),
+                      nullptr);
+    file_ = OpenLogFile(path_, true);
+  }
+
+  const base::FilePath path_;
+  const int64_t max_file_size_;
+
+  base::Lock file_lock_;
+  FILE* file_ GUARDED_BY(file_lock_);
+
+  base::Lock lock_;
+  base::ConditionVariable has_messages_{&lock_};
+  std::string buffer_ GUARDED_BY(lock_);
+  size_t dropped_ GUARDED_BY(lock_) = 0;
+};
+
+LogFileWriter* g_writer = nullptr;
+
+bool OnLogMessage(int severity,
+                  const char* file,
+                  int line,
+                  size_t message_start,
+                  const std::string& str) {
+  g_writer->Add(str);
+  if (severity == LOGGING_FATAL)
+    g_writer->Flush();
+  // The other destinations, like stderr, are still handled by base.
+  return false;
+}
+
+void FlushAtExit() {
+  g_writer->Flush();
+}
+
+}  // namespace
+
+void StartLogFileWriter(const base::FilePath& path,
+                        bool truncate,
+                        int64_t max_file_size) {
+  if (g_writer)
+    return;
+  // Leaked, the thread runs until the process exits.
+  auto* writer = new LogFileWriter(path, truncate, max_file_size);
+  if (!writer->is_open()) {
+    PLOG(ERROR) << "Failed to open the log file";
+    delete writer;
+    return;
+  }
+  if (!base::PlatformThread::CreateNonJoinable(0, writer)) {
+    delete writer;
+    return;
+  }
+  g_writer = writer;
+  SetLogMessageHandler(&OnLogMessage);
+  std::atexit(&FlushAtExit);
+}
+
+bool IsLogFileWriterStarted() {
+  return g_writer != nullptr;
+}
+
+}  // namespace logging
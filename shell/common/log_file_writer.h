@@ -0,0 +1,33 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_LOG_FILE_WRITER_H_
+#define ELECTRON_SHELL_COMMON_LOG_FILE_WRITER_H_
+
+#include <cstdint>
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace logging {
+
+// Writes the log messages of the process to |path| from a background thread,
+// so that the threads that log don't block on file I/O. The messages are
+// buffered up to a limit, past which new messages are dropped until the
+// writer catches up. Once the file grows past |max_file_size|, when it is not
+// 0, it is renamed with a ".1" extension and a new file is started.
+//
+// Fatal messages are written synchronously along with the buffered messages,
+// as are the buffered messages when the process exits.
+void StartLogFileWriter(const base::FilePath& path,
+                        bool truncate,
+                        int64_t max_file_size);
+
+// Whether StartLogFileWriter() has been called in this process.
+bool IsLogFileWriterStarted();
+
+}  // namespace logging
+
+#endif  // ELECTRON_SHELL_COMMON_LOG_FILE_WRITER_H_
@@ -4,6 +4,7 @@
 
 #include "shell/common/logging.h"
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -17,11 +18,14 @@
 #include "chrome/common/chrome_paths.h"
 #include "content/public/common/content_switches.h"
 #include "shell/common/electron_paths.h"
+#include "shell/common/log_file_writer.h"
 
 namespace logging {
 
 constexpr std::string_view kLogFileName{"ELECTRON_LOG_FILE"};
 constexpr std::string_view kElectronEnableLogging{"ELECTRON_ENABLE_LOGGING"};
+constexpr std::string_view kLogAsync{"ELECTRON_LOG_ASYNC"};
+constexpr std::string_view kLogFileMaxSize{"ELECTRON_LOG_FILE_MAX_SIZE"};
 
 base::FilePath GetLogFileName(const base::CommandLine& command_line) {
   std::string filename = command_line.GetSwitchValueASCII(switches::kLogFile);
@@ -140,6 +144,22 @@ void InitElectronLogging(const base::CommandLine& command_line,
       process_type.empty() && (is_preinit || !HasExplicitLogFile(command_line))
           ? DELETE_OLD_LOG_FILE
           : APPEND_TO_OLD_LOG_FILE;
+
+  // The main process can write its log file from a background thread instead,
+  // so that logging doesn't block the UI thread.
+  auto env = base::Environment::Create();
+  if ((logging_dest & LOG_TO_FILE) != 0 && process_type.empty() &&
+      env->HasVar(kLogAsync)) {
+    std::string max_size_str;
+    int64_t max_size = 0;
+    if (env->GetVar(kLogFileMaxSize, &max_size_str))
+      base::StringToInt64(max_size_str, &max_size);
+    StartLogFileWriter(log_path, settings.delete_old == DELETE_OLD_LOG_FILE,
+                       max_size);
+  }
+  if (IsLogFileWriterStarted())
+    settings.logging_dest &= ~LOG_TO_FILE;
+
   bool success = InitLogging(settings);
   if (!success) {
     PLOG(ERROR) << "Failed to init logging";
@@ -16,8 +16,10 @@
 #include "base/environment.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/current_thread.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/trace_event/trace_event.h"
 #include "chrome/common/chrome_version.h"
@@ -29,6 +31,7 @@
 #include "shell/browser/api/electron_api_app.h"
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/electron_command_line.h"
+#include "shell/common/event_loop_monitor.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -37,6 +40,7 @@
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/mac/main_application_bundle.h"
 #include "shell/common/node_util.h"
+#include "shell/common/startup_metrics.h"
 #include "shell/common/world_ids.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_initializer.h"  // nogncheck
@@ -62,6 +66,7 @@
   V(electron_browser_message_port)       \
   V(electron_browser_native_theme)       \
   V(electron_browser_notification)       \
+  V(electron_browser_offscreen_atlas)    \
   V(electron_browser_power_monitor)      \
   V(electron_browser_power_save_blocker) \
   V(electron_browser_protocol)           \
@@ -69,6 +74,7 @@
   V(electron_browser_push_notifications) \
   V(electron_browser_safe_storage)       \
   V(electron_browser_session)            \
+  V(electron_browser_shared_values)      \
   V(electron_browser_screen)             \
   V(electron_browser_system_preferences) \
   V(electron_browser_base_window)        \
@@ -410,20 +416,34 @@ base::FilePath GetResourcesPath() {
 
 NodeBindings::NodeBindings(BrowserEnvironment browser_env)
     : browser_env_{browser_env},
-      uv_loop_{InitEventLoop(browser_env, &worker_loop_)} {}
+      uv_loop_{InitEventLoop(browser_env, &worker_loop_)} {
+  std::string budget;
+  int budget_ms = 0;
+  if (base::Environment::Create()->GetVar("ELECTRON_UV_DRAIN_BUDGET_MS",
+                                          &budget) &&
+      base::StringToInt(budget, &budget_ms) && budget_ms > 0) {
+    uv_drain_budget_ = base::Milliseconds(budget_ms);
+  }
+}
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
+  if (integrated_loop_) {
+    if (base::CurrentThread::IsSet())
+      base::CurrentThread::Get()->RemoveTaskObserver(this);
+  } else {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
+
+    WakeupEmbedThread();
 
-  WakeupEmbedThread();
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    uv_sem_destroy(&embed_sem_);
+  }
 
   // Clear uv.
-  uv_sem_destroy(&embed_sem_);
   dummy_uv_handle_.reset();
 
   // Clean up worker loop
@@ -783,6 +803,7 @@ std::shared_ptr<node::Environment> NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  startup_metrics::ScopedPhase phase("NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env, node::StartExecutionCallback{}, &OnNodePreload);
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -801,6 +822,19 @@ void NodeBindings::PrepareEmbedThread() {
   // nothing to do.
   uv_async_init(uv_loop_, dummy_uv_handle_.get(), nullptr);
 
+  // The browser process can opt into dispatching uv events straight from the
+  // main thread's message pump, which saves two thread hops and a semaphore
+  // handshake per wakeup.
+  if (browser_env_ == BrowserEnvironment::kBrowser &&
+      base::Environment::Create()->HasVar("ELECTRON_INTEGRATED_UV_LOOP") &&
+      WatchBackendFd()) {
+    integrated_loop_ = true;
+    // Timers scheduled by JS running outside of uv, e.g. in IPC handlers,
+    // change when the loop has to run next without waking the backend fd.
+    base::CurrentThread::Get()->AddTaskObserver(this);
+    return;
+  }
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -878,10 +912,27 @@ void NodeBindings::UvRunOnce() {
 
   if (browser_env_ != BrowserEnvironment::kBrowser)
     TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
-
-  // Deal with uv events.
-  int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
-
+  TRACE_EVENT_BEGIN0("electron", "NodeBindings::UvRunOnce");
+
+  // Deal with uv events. With a drain budget, keep going while more events
+  // are ready so that a busy loop is served by one wakeup instead of a task
+  // per iteration.
+  int r;
+  int iterations = 0;
+  const base::TimeTicks start = base::TimeTicks::Now();
+  const base::TimeTicks deadline =
+      uv_drain_budget_.is_zero() ? base::TimeTicks() : start + uv_drain_budget_;
+  do {
+    r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+    ++iterations;
+  } while (r != 0 && !deadline.is_null() && base::TimeTicks::Now() < deadline &&
+           (uv_backend_timeout(uv_loop_) == 0 || HasPendingEvents()));
+
+  if (auto* monitor = EventLoopMonitor::GetCurrent())
+    monitor->RecordUvRun(base::TimeTicks::Now() - start);
+
+  TRACE_EVENT_END1("electron", "NodeBindings::UvRunOnce", "iterations",
+                   iterations);
   if (browser_env_ != BrowserEnvironment::kBrowser)
     TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
 
@@ -890,10 +941,42 @@ void NodeBindings::UvRunOnce() {
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
+  if (integrated_loop_) {
+    ScheduleUvTimer();
+    return;
+  }
+
   // Tell the worker thread to continue polling.
   uv_sem_post(&embed_sem_);
 }
 
+bool NodeBindings::WatchBackendFd() {
+  return false;
+}
+
+void NodeBindings::ScheduleUvTimer() {
+  const int timeout = uv_backend_timeout(uv_loop_);
+  // Nothing is pending until the backend fd becomes readable.
+  if (timeout < 0)
+    return;
+
+  // A timer that fires early just runs the loop once with nothing to do, so
+  // only reschedule when the loop has to run sooner.
+  const base::TimeTicks deadline =
+      base::TimeTicks::Now() + base::Milliseconds(timeout);
+  if (uv_timer_.IsRunning() && uv_timer_.desired_run_time() <= deadline)
+    return;
+
+  uv_timer_.Start(FROM_HERE, base::Milliseconds(timeout),
+                  base::BindOnce(&NodeBindings::UvRunOnce,
+                                 weak_factory_.GetWeakPtr()));
+}
+
+void NodeBindings::DidProcessTask(const base::PendingTask& pending_task) {
+  if (initialized_ && uv_env())
+    ScheduleUvTimer();
+}
+
 void NodeBindings::WakeupMainThread() {
   DCHECK(task_runner_);
   task_runner_->PostTask(FROM_HERE, base::BindOnce(&NodeBindings::UvRunOnce,
@@ -16,6 +16,8 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/raw_ptr_exclusion.h"
 #include "base/memory/weak_ptr.h"
+#include "base/task/task_observer.h"
+#include "base/timer/timer.h"
 #include "gin/public/context_holder.h"
 #include "gin/public/gin_embedders.h"
 #include "shell/common/node_includes.h"
@@ -76,7 +78,7 @@ class UvHandle {
   RAW_PTR_EXCLUSION T* t_ = {};
 };
 
-class NodeBindings {
+class NodeBindings : private base::TaskObserver {
  public:
   enum class BrowserEnvironment { kBrowser, kRenderer, kUtility, kWorker };
 
@@ -84,7 +86,7 @@ class NodeBindings {
   static void RegisterBuiltinBindings();
   static bool IsInitialized();
 
-  virtual ~NodeBindings();
+  ~NodeBindings() override;
 
   // Setup V8, libuv.
   void Initialize(v8::Local<v8::Context> context);
@@ -148,18 +150,38 @@ class NodeBindings {
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
+  // Returns whether uv's backend has events ready, without waiting or
+  // consuming them.
+  virtual bool HasPendingEvents() = 0;
+
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
   // Interrupt the PollEvents.
   void WakeupEmbedThread();
 
+  // Starts watching uv's backend fd from the current thread's message pump,
+  // calling UvRunOnce() whenever it becomes readable, so that uv events are
+  // dispatched without going through the embed thread. Returns false if the
+  // pump can not watch file descriptors, in which case the embed thread is
+  // used.
+  virtual bool WatchBackendFd();
+
+  // Run the libuv loop for once.
+  void UvRunOnce();
+
  private:
   static uv_loop_t* InitEventLoop(BrowserEnvironment browser_env,
                                   uv_loop_t* worker_loop);
 
-  // Run the libuv loop for once.
-  void UvRunOnce();
+  // Makes sure the loop runs again when its next uv timer is due, which the
+  // backend fd does not signal, when the integrated loop is used.
+  void ScheduleUvTimer();
+
+  // base::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override {}
+  void DidProcessTask(const base::PendingTask& pending_task) override;
 
   [[nodiscard]] constexpr bool in_worker_loop() const {
     return browser_env_ == BrowserEnvironment::kWorker;
@@ -201,6 +223,18 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether uv events are dispatched from the main thread's message pump
+  // rather than the embed thread.
+  bool integrated_loop_ = false;
+
+  // Runs the loop when its next uv timer is due with the integrated loop.
+  base::OneShotTimer uv_timer_;
+
+  // How long UvRunOnce() keeps running the loop while events are ready, so
+  // that a busy loop is drained in one wakeup. Zero runs it only once. Set
+  // with the ELECTRON_UV_DRAIN_BUDGET_MS environment variable.
+  base::TimeDelta uv_drain_budget_;
+
   // Dummy handle to make uv's loop not quit.
   UvHandle<uv_async_t> dummy_uv_handle_;
 
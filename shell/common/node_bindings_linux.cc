@@ -6,6 +6,8 @@
 
 #include <sys/epoll.h>
 
+#include "base/task/current_thread.h"
+
 namespace electron {
 
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
@@ -33,6 +35,36 @@ void NodeBindingsLinux::PollEvents() {
 }
 
 // static
+bool NodeBindingsLinux::WatchBackendFd() {
+  if (!base::CurrentUIThread::IsSet())
+    return false;
+
+  // uv's backend is itself an epoll fd, which becomes readable whenever one
+  // of the fds registered with it is ready.
+  return base::CurrentUIThread::Get()->WatchFileDescriptor(
+      uv_backend_fd(uv_loop()), true, base::MessagePumpForUI::WATCH_READ,
+      &backend_fd_controller_, this);
+}
+
+void NodeBindingsLinux::OnFileCanReadWithoutBlocking(int fd) {
+  // The fd stays readable until uv runs, so stop watching it once there is
+  // no environment left to run uv for.
+  if (!uv_env()) {
+    backend_fd_controller_.StopWatchingFileDescriptor();
+    return;
+  }
+  UvRunOnce();
+}
+
+bool NodeBindingsLinux::HasPendingEvents() {
+  struct epoll_event ev;
+  int r;
+  do {
+    r = epoll_wait(epoll_, &ev, 1, 0);
+  } while (r == -1 && errno == EINTR);
+  return r > 0;
+}
+
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
 }
@@ -40,6 +40,20 @@ void NodeBindingsMac::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+bool NodeBindingsMac::HasPendingEvents() {
+  fd_set readset;
+  int fd = uv_backend_fd(uv_loop());
+  FD_ZERO(&readset);
+  FD_SET(fd, &readset);
+
+  struct timeval tv = {0, 0};
+  int r;
+  do {
+    r = select(fd + 1, &readset, nullptr, nullptr, &tv);
+  } while (r == -1 && errno == EINTR);
+  return r > 0;
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsMac(browser_env);
@@ -49,6 +49,21 @@ void NodeBindingsWin::PollEvents() {
     PostQueuedCompletionStatus(event_loop->iocp, bytes, key, overlapped);
 }
 
+bool NodeBindingsWin::HasPendingEvents() {
+  auto* const event_loop = uv_loop();
+
+  DWORD bytes;
+  ULONG_PTR key;
+  OVERLAPPED* overlapped;
+  GetQueuedCompletionStatus(event_loop->iocp, &bytes, &key, &overlapped, 0);
+  if (overlapped == nullptr)
+    return false;
+
+  // Give the event back so libuv can deal with it.
+  PostQueuedCompletionStatus(event_loop->iocp, bytes, key, overlapped);
+  return true;
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsWin(browser_env);
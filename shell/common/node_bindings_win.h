@@ -16,6 +16,7 @@ class NodeBindingsWin : public NodeBindings {
 
  private:
   void PollEvents() override;
+  bool HasPendingEvents() override;
 };
 
 }  // namespace electron
@@ -74,6 +74,9 @@ const char kAutoHideMenuBar[] = "autoHideMenuBar";
 // Enable window to be resized larger than screen.
 const char kEnableLargerThanScreen[] = "enableLargerThanScreen";
 
+// Resize the web contents once the user is done resizing the window.
+const char kDeferContentResize[] = "deferContentResize";
+
 // Forces to use dark theme on Linux.
 const char kDarkTheme[] = "darkTheme";
 
@@ -156,8 +159,19 @@ const char kAllowRunningInsecureContent[] = "allowRunningInsecureContent";
 
 const char kOffscreen[] = "offscreen";
 
+const char kUseSharedTexture[] = "useSharedTexture";
+
+const char kDirtyRectOnly[] = "dirtyRectOnly";
+
+const char kAdaptiveFrameRate[] = "adaptiveFrameRate";
+
+const char kMaxLatency[] = "maxLatency";
+
 const char kNodeIntegrationInSubFrames[] = "nodeIntegrationInSubFrames";
 
+// Create the Node.js environment of a frame on first use.
+const char kLazyNodeIntegration[] = "lazyNodeIntegration";
+
 // Disable window resizing when HTML Fullscreen API is activated.
 const char kDisableHtmlFullscreenWindowResize[] =
     "disableHtmlFullscreenWindowResize";
@@ -269,6 +283,9 @@ const char kDisableNTLMv2[] = "disable-ntlm-v2";
 
 const char kEnableWebSQL[] = "enable-websql";
 
+// Runs the app without a display, with all the pages rendered offscreen.
+const char kHeadlessServer[] = "headless-server";
+
 }  // namespace switches
 
 }  // namespace electron
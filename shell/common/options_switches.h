@@ -43,6 +43,7 @@ extern const char kTitleBarStyle[];
 extern const char kTabbingIdentifier[];
 extern const char kAutoHideMenuBar[];
 extern const char kEnableLargerThanScreen[];
+extern const char kDeferContentResize[];
 extern const char kDarkTheme[];
 extern const char kTransparent[];
 extern const char kType[];
@@ -80,7 +81,12 @@ extern const char kSandbox[];
 extern const char kWebSecurity[];
 extern const char kAllowRunningInsecureContent[];
 extern const char kOffscreen[];
+extern const char kUseSharedTexture[];
+extern const char kDirtyRectOnly[];
+extern const char kAdaptiveFrameRate[];
+extern const char kMaxLatency[];
 extern const char kNodeIntegrationInSubFrames[];
+extern const char kLazyNodeIntegration[];
 extern const char kDisableHtmlFullscreenWindowResize[];
 extern const char kJavaScript[];
 extern const char kImages[];
@@ -88,6 +94,8 @@ extern const char kTextAreasAreResizable[];
 extern const char kWebGL[];
 extern const char kNavigateOnDragDrop[];
 extern const char kEnableWebSQL[];
+
+extern const char kHeadlessServer[];
 extern const char kEnablePreferredSizeMode[];
 
 extern const char kHiddenPage[];
@@ -0,0 +1,155 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/shared_values.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/threading/platform_thread.h"
+
+namespace electron::shared_values {
+
+namespace {
+
+void AppendUint32(std::vector<uint8_t>* out, uint32_t value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  out->insert(out->end(), bytes, bytes + sizeof(value));
+}
+
+// Reads from a payload that may be concurrently rewritten, so every read is
+// bounds-checked and the result is only trusted once the sequence number has
+// been confirmed unchanged.
+class PayloadReader {
+ public:
+  explicit PayloadReader(base::span<const uint8_t> payload)
+      : payload_(payload) {}
+
+  bool ReadUint32(uint32_t* value) {
+    if (payload_.size() < sizeof(*value))
+      return false;
+    memcpy(value, payload_.data(), sizeof(*value));
+    payload_ = payload_.subspan(sizeof(*value));
+    return true;
+  }
+
+  bool ReadBytes(uint32_t size, base::span<const uint8_t>* bytes) {
+    if (payload_.size() < size)
+      return false;
+    *bytes = payload_.first(size);
+    payload_ = payload_.subspan(size);
+    return true;
+  }
+
+ private:
+  base::span<const uint8_t> payload_;
+};
+
+std::optional<std::vector<uint8_t>> FindValue(
+    base::span<const uint8_t> payload,
+    std::string_view key) {
+  PayloadReader reader(payload);
+  uint32_t entry_count = 0;
+  if (!reader.ReadUint32(&entry_count))
+    return std::nullopt;
+
+  for (uint32_t i = 0; i < entry_count; ++i) {
+    uint32_t key_size = 0;
+    uint32_t value_size = 0;
+    base::span<const uint8_t> entry_key;
+    base::span<const uint8_t> entry_value;
+    if (!reader.ReadUint32(&key_size) ||
+        !reader.ReadBytes(key_size, &entry_key) ||
+        !reader.ReadUint32(&value_size) ||
+        !reader.ReadBytes(value_size, &entry_value)) {
+      return std::nullopt;
+    }
+
+    const std::string_view entry_key_string(
+        reinterpret_cast<const char*>(entry_key.data()), entry_key.size());
+    if (entry_key_string == key)
+      return std::vector<uint8_t>(entry_value.begin(), entry_value.end());
+    if (entry_key_string > key)
+      break;
+  }
+
+  return std::nullopt;
+}
+
+}  // namespace
+
+std::vector<uint8_t> EncodeValues(const Values& values) {
+  std::vector<uint8_t> payload;
+  AppendUint32(&payload, values.size());
+  for (const auto& [key, value] : values) {
+    AppendUint32(&payload, key.size());
+    payload.insert(payload.end(), key.begin(), key.end());
+    AppendUint32(&payload, value.size());
+    payload.insert(payload.end(), value.begin(), value.end());
+  }
+  return payload;
+}
+
+bool WritePayload(base::span<uint8_t> region,
+                  base::span<const uint8_t> payload) {
+  DCHECK_GE(region.size(), sizeof(Header));
+  if (payload.size() > region.size() - sizeof(Header))
+    return false;
+
+  auto* header = reinterpret_cast<Header*>(region.data());
+  const uint32_t sequence = header->sequence.load(std::memory_order_relaxed);
+  header->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  memcpy(region.data() + sizeof(Header), payload.data(), payload.size());
+  header->payload_size.store(payload.size(), std::memory_order_relaxed);
+
+  header->sequence.store(sequence + 2, std::memory_order_release);
+  return true;
+}
+
+void MarkSuperseded(base::span<uint8_t> region) {
+  DCHECK_GE(region.size(), sizeof(Header));
+  auto* header = reinterpret_cast<Header*>(region.data());
+  header->superseded.store(1, std::memory_order_release);
+}
+
+ReadResult ReadValue(base::span<const uint8_t> region,
+                     std::string_view key,
+                     std::vector<uint8_t>* value) {
+  if (region.size() < sizeof(Header))
+    return ReadResult::kNotFound;
+
+  const auto* header = reinterpret_cast<const Header*>(region.data());
+  const base::span<const uint8_t> data = region.subspan(sizeof(Header));
+  for (;;) {
+    if (header->superseded.load(std::memory_order_acquire))
+      return ReadResult::kSuperseded;
+
+    const uint32_t sequence = header->sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      base::PlatformThread::YieldCurrentThread();
+      continue;
+    }
+
+    const size_t payload_size = std::min<size_t>(
+        header->payload_size.load(std::memory_order_relaxed), data.size());
+    std::optional<std::vector<uint8_t>> found =
+        FindValue(data.first(payload_size), key);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+
+    if (!found)
+      return ReadResult::kNotFound;
+    *value = std::move(*found);
+    return ReadResult::kFound;
+  }
+}
+
+}  // namespace electron::shared_values
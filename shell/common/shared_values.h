@@ -0,0 +1,68 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_SHARED_VALUES_H_
+#define ELECTRON_SHELL_COMMON_SHARED_VALUES_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/containers/span.h"
+
+namespace electron::shared_values {
+
+// The main process publishes the values set with ipcMain.setSharedValue() in
+// a shared memory region that every renderer maps read-only, so that
+// ipcRenderer.getSharedValue() does not need a round trip. The region starts
+// with a Header and is followed by the payload written by EncodeValues():
+//
+//   uint32   entry_count
+//   repeated entry_count times, sorted by key:
+//     uint32   key_size
+//     char     key[key_size]
+//     uint32   value_size
+//     uint8    value[value_size]       V8-serialized, see v8_value_serializer.h
+//
+// The payload is guarded by a sequence lock: the writer makes |sequence| odd
+// while it rewrites the payload, and readers retry until they have read it
+// entirely under one even sequence number.
+struct Header {
+  std::atomic<uint32_t> sequence;
+  // Set once the payload outgrew the region and was moved into a new one,
+  // which readers then have to ask the main process for.
+  std::atomic<uint32_t> superseded;
+  std::atomic<uint32_t> payload_size;
+  uint32_t reserved;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "Header must be usable across processes");
+
+using Values = std::map<std::string, std::vector<uint8_t>>;
+
+std::vector<uint8_t> EncodeValues(const Values& values);
+
+// Returns false if |payload| does not fit into |region|.
+bool WritePayload(base::span<uint8_t> region,
+                  base::span<const uint8_t> payload);
+
+void MarkSuperseded(base::span<uint8_t> region);
+
+enum class ReadResult {
+  kFound,
+  kNotFound,
+  kSuperseded,
+};
+
+ReadResult ReadValue(base::span<const uint8_t> region,
+                     std::string_view key,
+                     std::vector<uint8_t>* value);
+
+}  // namespace electron::shared_values
+
+#endif  // ELECTRON_SHELL_COMMON_SHARED_VALUES_H_
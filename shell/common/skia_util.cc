@@ -2,7 +2,9 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <optional>
 #include <string>
+#include <utility>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
@@ -10,6 +12,7 @@
 #include "base/strings/string_util.h"
 #include "net/base/data_url.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/decoded_image_cache.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
 #include "shell/common/thread_restrictions.h"
@@ -121,9 +124,18 @@ bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
 bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
                              const base::FilePath& path,
                              double scale_factor) {
+  DecodedImageCache* cache = DecodedImageCache::GetInstance();
+  std::optional<std::string> version;
   std::string file_contents;
   {
     electron::ScopedAllowBlockingForElectron allow_blocking;
+    version = DecodedImageCache::GetFileVersion(path);
+    if (!version)
+      return false;
+    if (std::optional<SkBitmap> bitmap = cache->Get(path, *version)) {
+      image->AddRepresentation(gfx::ImageSkiaRep(*bitmap, scale_factor));
+      return true;
+    }
     if (!asar::ReadFileToString(path, &file_contents))
       return false;
   }
@@ -132,7 +144,14 @@ bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
       reinterpret_cast<const unsigned char*>(file_contents.data());
   size_t size = file_contents.size();
 
-  return AddImageSkiaRepFromBuffer(image, data, size, 0, 0, scale_factor);
+  gfx::ImageSkia decoded;
+  if (!AddImageSkiaRepFromBuffer(&decoded, data, size, 0, 0, scale_factor))
+    return false;
+
+  const gfx::ImageSkiaRep& rep = decoded.image_reps().front();
+  cache->Put(path, std::move(*version), rep.GetBitmap());
+  image->AddRepresentation(rep);
+  return true;
 }
 
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
@@ -0,0 +1,147 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_metrics.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "base/environment.h"
+#include "base/no_destructor.h"
+#include "base/process/process.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron::startup_metrics {
+
+namespace {
+
+struct Phase {
+  const char* name;
+  base::TimeTicks start;
+  base::TimeTicks end;
+};
+
+// Archives can be opened on any thread, hence the lock.
+struct Metrics {
+  base::Lock lock;
+  std::vector<Phase> phases GUARDED_BY(lock);
+  size_t archive_count GUARDED_BY(lock) = 0;
+  base::TimeDelta archive_duration GUARDED_BY(lock);
+  base::Time relaunch_time GUARDED_BY(lock);
+};
+
+Metrics& GetState() {
+  static base::NoDestructor<Metrics> metrics;
+  return *metrics;
+}
+
+void AddPhase(const char* name, base::TimeTicks start, base::TimeTicks end) {
+  Metrics& metrics = GetState();
+  base::AutoLock lock(metrics.lock);
+  const bool recorded = std::any_of(
+      metrics.phases.begin(), metrics.phases.end(), [name](const Phase& phase) {
+        return std::string_view(phase.name) == name;
+      });
+  if (!recorded)
+    metrics.phases.push_back({name, start, end});
+}
+
+}  // namespace
+
+void RecordPhase(const char* name, base::TimeTicks start) {
+  AddPhase(name, start, base::TimeTicks::Now());
+}
+
+void RecordMilestone(const char* name) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  AddPhase(name, now, now);
+}
+
+void RecordArchiveInit(base::TimeDelta duration) {
+  Metrics& metrics = GetState();
+  base::AutoLock lock(metrics.lock);
+  ++metrics.archive_count;
+  metrics.archive_duration += duration;
+}
+
+void TakeRelaunchTime() {
+  auto env = base::Environment::Create();
+  std::string value;
+  if (!env->GetVar(kRelaunchTimeEnvVar, &value))
+    return;
+  env->UnSetVar(kRelaunchTimeEnvVar);
+
+  double milliseconds = 0;
+  if (!base::StringToDouble(value, &milliseconds))
+    return;
+  Metrics& metrics = GetState();
+  base::AutoLock lock(metrics.lock);
+  metrics.relaunch_time =
+      base::Time::FromMillisecondsSinceUnixEpoch(milliseconds);
+}
+
+base::Value::Dict GetMetrics() {
+  // Phases are measured in ticks, the process creation time is only known
+  // in wall clock time.
+  const base::Time creation_time = base::Process::Current().CreationTime();
+  const base::TimeTicks creation_ticks =
+      creation_time.is_null()
+          ? base::TimeTicks()
+          : base::TimeTicks::Now() - (base::Time::Now() - creation_time);
+
+  Metrics& metrics = GetState();
+  base::AutoLock lock(metrics.lock);
+  std::vector<Phase> phases = metrics.phases;
+  std::stable_sort(phases.begin(), phases.end(),
+                   [](const Phase& a, const Phase& b) {
+                     return a.start < b.start;
+                   });
+
+  base::Value::List phase_list;
+  for (const auto& phase : phases) {
+    base::Value::Dict dict;
+    dict.Set("name", phase.name);
+    const base::TimeDelta start = creation_ticks.is_null()
+                                      ? base::TimeDelta()
+                                      : phase.start - creation_ticks;
+    dict.Set("startTime", start.InMillisecondsF());
+    dict.Set("duration", (phase.end - phase.start).InMillisecondsF());
+    phase_list.Append(std::move(dict));
+  }
+
+  base::Value::Dict archives;
+  archives.Set("count", static_cast<int>(metrics.archive_count));
+  archives.Set("duration", metrics.archive_duration.InMillisecondsF());
+
+  base::Value::Dict result;
+  result.Set("processCreationTime",
+             creation_time.is_null()
+                 ? 0.0
+                 : creation_time.InMillisecondsFSinceUnixEpoch());
+  result.Set("phases", std::move(phase_list));
+  result.Set("asarArchives", std::move(archives));
+  if (!metrics.relaunch_time.is_null()) {
+    result.Set("relaunchTime",
+               metrics.relaunch_time.InMillisecondsFSinceUnixEpoch());
+  }
+  return result;
+}
+
+ScopedPhase::ScopedPhase(const char* name)
+    : name_(name), start_(base::TimeTicks::Now()) {
+  TRACE_EVENT_BEGIN("electron.startup", perfetto::StaticString(name_));
+}
+
+ScopedPhase::~ScopedPhase() {
+  TRACE_EVENT_END("electron.startup");
+  RecordPhase(name_, start_);
+}
+
+}  // namespace electron::startup_metrics
@@ -0,0 +1,54 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_STARTUP_METRICS_H_
+#define ELECTRON_SHELL_COMMON_STARTUP_METRICS_H_
+
+#include "base/time/time.h"
+#include "base/values.h"
+
+// Timings of the steps taken from process launch to the first paint, see
+// app.getStartupMetrics(). Phases are also emitted as trace events in the
+// "electron.startup" category.
+namespace electron::startup_metrics {
+
+// Records a phase that started at |start| and ends now. Only the first run of
+// each phase is kept, so that e.g. the first navigation is measured.
+// |name| must outlive the process.
+void RecordPhase(const char* name, base::TimeTicks start);
+
+// Records a phase without duration, such as the app becoming ready.
+void RecordMilestone(const char* name);
+
+// Adds the time taken to open an ASAR archive.
+void RecordArchiveInit(base::TimeDelta duration);
+
+// Set by the relauncher in the environment of the new instance of the app, to
+// when the relaunch was requested in milliseconds since the Unix epoch.
+inline constexpr char kRelaunchTimeEnvVar[] = "ELECTRON_RELAUNCH_TIME";
+
+// Takes the relaunch time out of the environment, so that the processes the
+// app launches don't inherit it.
+void TakeRelaunchTime();
+
+base::Value::Dict GetMetrics();
+
+// Measures and traces a phase for the lifetime of the object.
+class ScopedPhase {
+ public:
+  explicit ScopedPhase(const char* name);
+  ~ScopedPhase();
+
+  // disable copy
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+ private:
+  const char* name_;
+  base::TimeTicks start_;
+};
+
+}  // namespace electron::startup_metrics
+
+#endif  // ELECTRON_SHELL_COMMON_STARTUP_METRICS_H_
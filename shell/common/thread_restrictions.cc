@@ -0,0 +1,88 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/thread_restrictions.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/task/current_thread.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// Call sites are few and fixed, so they are never evicted. The file names
+// are string literals, so they are compared by address.
+struct Registry {
+  base::Lock lock;
+  std::map<std::pair<const char*, int>,
+           ScopedAllowBlockingForElectron::CallSiteStats>
+      sites;
+};
+
+Registry& GetRegistry() {
+  static base::NoDestructor<Registry> registry;
+  return *registry;
+}
+
+}  // namespace
+
+ScopedAllowBlockingForElectron::ScopedAllowBlockingForElectron(
+    const base::Location& from_here)
+    : base::ScopedAllowBlocking(from_here), from_here_(from_here) {
+  // Blocking on the thread pool is expected, only the UI is stalled by it.
+  if (!base::CurrentUIThread::IsSet())
+    return;
+  start_ = base::TimeTicks::Now();
+  TRACE_EVENT_BEGIN("electron", "ScopedAllowBlockingForElectron",
+                    "from_here", from_here_);
+}
+
+ScopedAllowBlockingForElectron::~ScopedAllowBlockingForElectron() {
+  if (start_.is_null())
+    return;
+  TRACE_EVENT_END("electron");
+  const base::TimeDelta duration = base::TimeTicks::Now() - start_;
+  Registry& registry = GetRegistry();
+  base::AutoLock auto_lock(registry.lock);
+  auto [it, inserted] = registry.sites.try_emplace(
+      std::make_pair(from_here_.file_name(), from_here_.line_number()));
+  CallSiteStats& stats = it->second;
+  if (inserted)
+    stats.location = from_here_.ToString();
+  ++stats.count;
+  stats.total += duration;
+  stats.max = std::max(stats.max, duration);
+}
+
+// static
+std::vector<ScopedAllowBlockingForElectron::CallSiteStats>
+ScopedAllowBlockingForElectron::GetStats() {
+  std::vector<CallSiteStats> result;
+  {
+    Registry& registry = GetRegistry();
+    base::AutoLock auto_lock(registry.lock);
+    for (const auto& [site, stats] : registry.sites)
+      result.push_back(stats);
+  }
+  std::sort(result.begin(), result.end(),
+            [](const CallSiteStats& a, const CallSiteStats& b) {
+              return a.total > b.total;
+            });
+  return result;
+}
+
+// static
+void ScopedAllowBlockingForElectron::ResetStats() {
+  Registry& registry = GetRegistry();
+  base::AutoLock auto_lock(registry.lock);
+  registry.sites.clear();
+}
+
+}  // namespace electron
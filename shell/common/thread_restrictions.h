@@ -5,11 +5,47 @@
 #ifndef ELECTRON_SHELL_COMMON_THREAD_RESTRICTIONS_H_
 #define ELECTRON_SHELL_COMMON_THREAD_RESTRICTIONS_H_
 
+#include <string>
+#include <vector>
+
+#include "base/location.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
 
 namespace electron {
 
-class ScopedAllowBlockingForElectron : public base::ScopedAllowBlocking {};
+// Allows blocking I/O in its scope. The scopes entered on a UI thread are
+// timed by call site and recorded as trace events in the electron category,
+// so that the blocking that stalls the UI can be found, see
+// app.getBlockingCallStats().
+class ScopedAllowBlockingForElectron : public base::ScopedAllowBlocking {
+ public:
+  struct CallSiteStats {
+    std::string location;
+    uint64_t count = 0;
+    base::TimeDelta total;
+    base::TimeDelta max;
+  };
+
+  explicit ScopedAllowBlockingForElectron(
+      const base::Location& from_here = base::Location::Current());
+  ~ScopedAllowBlockingForElectron();
+
+  // disable copy
+  ScopedAllowBlockingForElectron(const ScopedAllowBlockingForElectron&) =
+      delete;
+  ScopedAllowBlockingForElectron& operator=(
+      const ScopedAllowBlockingForElectron&) = delete;
+
+  // The call sites that blocked a UI thread, the longest total first.
+  static std::vector<CallSiteStats> GetStats();
+  static void ResetStats();
+
+ private:
+  const base::Location from_here_;
+  // Null when the scope is not on a UI thread.
+  base::TimeTicks start_;
+};
 
 }  // namespace electron
 
@@ -0,0 +1,444 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/v8_compact_value_serializer.h"
+
+#include <array>
+#include <cstring>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+// Values are written as a one-byte tag followed by their payload. Lengths,
+// counts and shape ids are unsigned LEB128 varints, int32s are zigzag
+// encoded varints.
+enum Tag : uint8_t {
+  // Leading byte of every message; it can't be confused with the 0xFF version
+  // tag that starts the V8 and Blink formats.
+  kCompactFormatTag = 'C',
+
+  kUndefinedTag = '_',
+  kNullTag = '0',
+  kTrueTag = 'T',
+  kFalseTag = 'F',
+  kInt32Tag = 'I',
+  kDoubleTag = 'N',
+  kOneByteStringTag = '"',
+  kTwoByteStringTag = 'c',
+  kArrayTag = 'A',
+  // Object with a new shape: key count, keys, then values.
+  kObjectNewShapeTag = 'o',
+  // Object with a previously written shape: shape id, then values.
+  kObjectShapeTag = 'O',
+};
+
+// Deeper values go through the V8 serializer, which handles them iteratively.
+constexpr int kMaxDepth = 64;
+
+class CompactSerializer {
+ public:
+  CompactSerializer(v8::Isolate* isolate, std::vector<uint8_t>* out)
+      : isolate_(isolate),
+        context_(isolate->GetCurrentContext()),
+        object_prototype_(v8::Object::New(isolate)->GetPrototype()),
+        out_(out) {}
+
+  CompactSerializeResult Serialize(v8::Local<v8::Value> value) {
+    out_->clear();
+    out_->push_back(kCompactFormatTag);
+    return WriteValue(value, 0);
+  }
+
+ private:
+  CompactSerializeResult WriteValue(v8::Local<v8::Value> value, int depth) {
+    if (value->IsUndefined()) {
+      out_->push_back(kUndefinedTag);
+    } else if (value->IsNull()) {
+      out_->push_back(kNullTag);
+    } else if (value->IsTrue()) {
+      out_->push_back(kTrueTag);
+    } else if (value->IsFalse()) {
+      out_->push_back(kFalseTag);
+    } else if (value->IsInt32()) {
+      out_->push_back(kInt32Tag);
+      const int32_t number = value.As<v8::Int32>()->Value();
+      WriteVarint((static_cast<uint32_t>(number) << 1) ^
+                  static_cast<uint32_t>(number >> 31));
+    } else if (value->IsNumber()) {
+      out_->push_back(kDoubleTag);
+      const double number = value.As<v8::Number>()->Value();
+      WriteRawBytes(&number, sizeof(number));
+    } else if (value->IsString()) {
+      WriteString(value.As<v8::String>());
+    } else if (value->IsObject() && depth < kMaxDepth) {
+      v8::Local<v8::Object> object = value.As<v8::Object>();
+      // Shared and cyclic references need the V8 serializer to preserve
+      // their identity. Hash collisions merely cost the fast path.
+      if (!seen_.insert(object->GetIdentityHash()).second)
+        return CompactSerializeResult::kUnsupported;
+      if (object->IsArray())
+        return WriteArray(object.As<v8::Array>(), depth);
+      if (IsPlainObject(object))
+        return WriteObject(object, depth);
+      return CompactSerializeResult::kUnsupported;
+    } else {
+      return CompactSerializeResult::kUnsupported;
+    }
+    return CompactSerializeResult::kSuccess;
+  }
+
+  bool IsPlainObject(v8::Local<v8::Object> object) {
+    return !object->IsProxy() && !object->IsArgumentsObject() &&
+           object->InternalFieldCount() == 0 &&
+           object->GetPrototype() == object_prototype_;
+  }
+
+  CompactSerializeResult WriteArray(v8::Local<v8::Array> array, int depth) {
+    // Named properties on arrays are only preserved by the V8 serializer.
+    v8::Local<v8::Array> named_properties;
+    if (!array
+             ->GetPropertyNames(
+                 context_, v8::KeyCollectionMode::kOwnOnly,
+                 static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                 v8::SKIP_SYMBOLS),
+                 v8::IndexFilter::kSkipIndices)
+             .ToLocal(&named_properties)) {
+      return CompactSerializeResult::kException;
+    }
+    if (named_properties->Length() != 0)
+      return CompactSerializeResult::kUnsupported;
+
+    const uint32_t length = array->Length();
+    out_->push_back(kArrayTag);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Local<v8::Value> element;
+      if (!array->Get(context_, i).ToLocal(&element))
+        return CompactSerializeResult::kException;
+      // So are holes in sparse arrays.
+      if (element->IsUndefined()) {
+        bool has_element;
+        if (!array->HasRealIndexedProperty(context_, i).To(&has_element))
+          return CompactSerializeResult::kException;
+        if (!has_element)
+          return CompactSerializeResult::kUnsupported;
+      }
+      CompactSerializeResult result = WriteValue(element, depth + 1);
+      if (result != CompactSerializeResult::kSuccess)
+        return result;
+    }
+    return CompactSerializeResult::kSuccess;
+  }
+
+  CompactSerializeResult WriteObject(v8::Local<v8::Object> object,
+                                     int depth) {
+    v8::Local<v8::Array> keys;
+    if (!object
+             ->GetOwnPropertyNames(
+                 context_,
+                 static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                                 v8::SKIP_SYMBOLS),
+                 v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&keys)) {
+      return CompactSerializeResult::kException;
+    }
+
+    const uint32_t key_count = keys->Length();
+    std::vector<v8::Local<v8::String>> key_strings;
+    key_strings.reserve(key_count);
+    for (uint32_t i = 0; i < key_count; ++i) {
+      v8::Local<v8::Value> key;
+      if (!keys->Get(context_, i).ToLocal(&key))
+        return CompactSerializeResult::kException;
+      key_strings.push_back(key.As<v8::String>());
+    }
+
+    // Objects at the same depth usually share a shape, e.g. the records in
+    // an array of records.
+    std::optional<Shape>& last_shape = last_shape_by_depth_[depth];
+    if (last_shape && ShapeMatches(*last_shape, key_strings)) {
+      out_->push_back(kObjectShapeTag);
+      WriteVarint(last_shape->id);
+    } else {
+      out_->push_back(kObjectNewShapeTag);
+      WriteVarint(key_count);
+      for (const auto& key : key_strings)
+        WriteString(key);
+      last_shape = Shape{next_shape_id_++, key_strings};
+    }
+
+    for (uint32_t i = 0; i < key_count; ++i) {
+      v8::Local<v8::Value> property;
+      if (!object->Get(context_, key_strings[i]).ToLocal(&property))
+        return CompactSerializeResult::kException;
+      CompactSerializeResult result = WriteValue(property, depth + 1);
+      if (result != CompactSerializeResult::kSuccess)
+        return result;
+    }
+    return CompactSerializeResult::kSuccess;
+  }
+
+  struct Shape {
+    uint32_t id;
+    std::vector<v8::Local<v8::String>> keys;
+  };
+
+  static bool ShapeMatches(const Shape& shape,
+                           const std::vector<v8::Local<v8::String>>& keys) {
+    if (shape.keys.size() != keys.size())
+      return false;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (!shape.keys[i]->StringEquals(keys[i]))
+        return false;
+    }
+    return true;
+  }
+
+  void WriteString(v8::Local<v8::String> string) {
+    const int length = string->Length();
+    if (string->IsOneByte()) {
+      out_->push_back(kOneByteStringTag);
+      WriteVarint(length);
+      const size_t offset = out_->size();
+      out_->resize(offset + length);
+      string->WriteOneByte(isolate_, out_->data() + offset, 0, length,
+                           v8::String::NO_NULL_TERMINATION);
+    } else {
+      out_->push_back(kTwoByteStringTag);
+      WriteVarint(length);
+      std::vector<uint16_t> buffer(length);
+      string->Write(isolate_, buffer.data(), 0, length,
+                    v8::String::NO_NULL_TERMINATION);
+      WriteRawBytes(buffer.data(), buffer.size() * sizeof(uint16_t));
+    }
+  }
+
+  void WriteVarint(uint32_t value) {
+    do {
+      uint8_t byte = value & 0x7F;
+      value >>= 7;
+      if (value)
+        byte |= 0x80;
+      out_->push_back(byte);
+    } while (value);
+  }
+
+  void WriteRawBytes(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    out_->insert(out_->end(), bytes, bytes + size);
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  v8::Local<v8::Context> context_;
+  v8::Local<v8::Value> object_prototype_;
+  raw_ptr<std::vector<uint8_t>> out_;
+  std::unordered_set<int> seen_;
+  std::array<std::optional<Shape>, kMaxDepth> last_shape_by_depth_;
+  uint32_t next_shape_id_ = 0;
+};
+
+class CompactDeserializer {
+ public:
+  CompactDeserializer(v8::Isolate* isolate, base::span<const uint8_t> data)
+      : isolate_(isolate),
+        context_(isolate->GetCurrentContext()),
+        data_(data) {}
+
+  v8::MaybeLocal<v8::Value> Deserialize() {
+    uint8_t tag;
+    if (!ReadByte(&tag) || tag != kCompactFormatTag)
+      return {};
+    return ReadValue(0);
+  }
+
+ private:
+  v8::MaybeLocal<v8::Value> ReadValue(int depth) {
+    uint8_t tag;
+    if (depth > kMaxDepth || !ReadByte(&tag))
+      return {};
+
+    switch (tag) {
+      case kUndefinedTag:
+        return v8::Undefined(isolate_);
+      case kNullTag:
+        return v8::Null(isolate_);
+      case kTrueTag:
+        return v8::True(isolate_);
+      case kFalseTag:
+        return v8::False(isolate_);
+      case kInt32Tag: {
+        uint32_t zigzag;
+        if (!ReadVarint(&zigzag))
+          return {};
+        const int32_t number =
+            static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+        return v8::Integer::New(isolate_, number);
+      }
+      case kDoubleTag: {
+        double number;
+        if (!ReadRawBytes(&number, sizeof(number)))
+          return {};
+        return v8::Number::New(isolate_, number);
+      }
+      case kOneByteStringTag:
+      case kTwoByteStringTag: {
+        v8::Local<v8::String> string;
+        if (!ReadString(tag, v8::NewStringType::kNormal).ToLocal(&string))
+          return {};
+        return string;
+      }
+      case kArrayTag:
+        return ReadArray(depth);
+      case kObjectNewShapeTag:
+      case kObjectShapeTag:
+        return ReadObject(tag, depth);
+      default:
+        return {};
+    }
+  }
+
+  v8::MaybeLocal<v8::Value> ReadArray(int depth) {
+    uint32_t length;
+    // Every element takes at least one byte.
+    if (!ReadVarint(&length) || length > data_.size())
+      return {};
+    std::vector<v8::Local<v8::Value>> elements(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      if (!ReadValue(depth + 1).ToLocal(&elements[i]))
+        return {};
+    }
+    return v8::Array::New(isolate_, elements.data(), elements.size());
+  }
+
+  v8::MaybeLocal<v8::Value> ReadObject(uint8_t tag, int depth) {
+    // An index rather than a pointer, as nested objects add to |shapes_|.
+    size_t shape_index;
+    if (tag == kObjectNewShapeTag) {
+      uint32_t key_count;
+      if (!ReadVarint(&key_count) || key_count > data_.size())
+        return {};
+      std::vector<v8::Local<v8::Name>> shape;
+      shape.reserve(key_count);
+      for (uint32_t i = 0; i < key_count; ++i) {
+        uint8_t string_tag;
+        v8::Local<v8::String> key;
+        if (!ReadByte(&string_tag) ||
+            !ReadString(string_tag, v8::NewStringType::kInternalized)
+                 .ToLocal(&key)) {
+          return {};
+        }
+        shape.push_back(key);
+      }
+      shape_index = shapes_.size();
+      shapes_.push_back(std::move(shape));
+    } else {
+      uint32_t shape_id;
+      if (!ReadVarint(&shape_id) || shape_id >= shapes_.size())
+        return {};
+      shape_index = shape_id;
+    }
+
+    // Adding the properties one by one in the same order lets objects of
+    // the same shape share their hidden class.
+    v8::Local<v8::Object> object = v8::Object::New(isolate_);
+    const size_t key_count = shapes_[shape_index].size();
+    for (size_t i = 0; i < key_count; ++i) {
+      v8::Local<v8::Value> property;
+      if (!ReadValue(depth + 1).ToLocal(&property))
+        return {};
+      bool created;
+      if (!object
+               ->CreateDataProperty(context_, shapes_[shape_index][i],
+                                    property)
+               .To(&created)) {
+        return {};
+      }
+    }
+    return object;
+  }
+
+  v8::MaybeLocal<v8::String> ReadString(uint8_t tag,
+                                        v8::NewStringType type) {
+    uint32_t length;
+    if (!ReadVarint(&length))
+      return {};
+    if (tag == kOneByteStringTag) {
+      if (length > data_.size())
+        return {};
+      v8::MaybeLocal<v8::String> string =
+          v8::String::NewFromOneByte(isolate_, data_.data(), type, length);
+      data_ = data_.subspan(length);
+      return string;
+    }
+    if (tag == kTwoByteStringTag) {
+      if (length > data_.size() / sizeof(uint16_t))
+        return {};
+      std::vector<uint16_t> buffer(length);
+      ReadRawBytes(buffer.data(), length * sizeof(uint16_t));
+      return v8::String::NewFromTwoByte(isolate_, buffer.data(), type, length);
+    }
+    return {};
+  }
+
+  bool ReadByte(uint8_t* byte) { return ReadRawBytes(byte, 1); }
+
+  bool ReadVarint(uint32_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      *value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadRawBytes(void* out, size_t size) {
+    if (data_.size() < size)
+      return false;
+    memcpy(out, data_.data(), size);
+    data_ = data_.subspan(size);
+    return true;
+  }
+
+  raw_ptr<v8::Isolate> isolate_;
+  v8::Local<v8::Context> context_;
+  base::span<const uint8_t> data_;
+  std::vector<std::vector<v8::Local<v8::Name>>> shapes_;
+};
+
+}  // namespace
+
+CompactSerializeResult SerializeCompactV8Value(v8::Isolate* isolate,
+                                               v8::Local<v8::Value> value,
+                                               std::vector<uint8_t>* out) {
+  CompactSerializer serializer(isolate, out);
+  return serializer.Serialize(value);
+}
+
+bool IsCompactV8Value(base::span<const uint8_t> data) {
+  return !data.empty() && data[0] == kCompactFormatTag;
+}
+
+v8::MaybeLocal<v8::Value> DeserializeCompactV8Value(
+    v8::Isolate* isolate,
+    base::span<const uint8_t> data) {
+  v8::EscapableHandleScope scope(isolate);
+  v8::Local<v8::Value> value;
+  if (!CompactDeserializer(isolate, data).Deserialize().ToLocal(&value))
+    return {};
+  return scope.Escape(value);
+}
+
+}  // namespace electron
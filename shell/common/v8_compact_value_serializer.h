@@ -0,0 +1,46 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_V8_COMPACT_VALUE_SERIALIZER_H_
+#define ELECTRON_SHELL_COMMON_V8_COMPACT_VALUE_SERIALIZER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "v8/include/v8-forward.h"
+
+namespace electron {
+
+// A compact encoding for the JSON-like values that make up most IPC
+// payloads: plain objects, dense arrays, strings, numbers, booleans, null
+// and undefined. Objects that share the same keys in the same order share a
+// "shape" that is written only once per message, and the deserializer
+// internalizes each shape's keys once, so arrays of records are cheap to
+// encode and produce objects with a common hidden class on the other end.
+//
+// Only Electron's own deserializer understands this format, so it must not
+// be used for messages that Blink or other versions of Electron may read.
+enum class CompactSerializeResult {
+  kSuccess,
+  // |value| contains something other than the supported types, or shares
+  // objects between several places; use the V8 serializer instead.
+  kUnsupported,
+  // A getter threw; the exception is left pending on the isolate.
+  kException,
+};
+
+CompactSerializeResult SerializeCompactV8Value(v8::Isolate* isolate,
+                                               v8::Local<v8::Value> value,
+                                               std::vector<uint8_t>* out);
+
+bool IsCompactV8Value(base::span<const uint8_t> data);
+
+v8::MaybeLocal<v8::Value> DeserializeCompactV8Value(
+    v8::Isolate* isolate,
+    base::span<const uint8_t> data);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_V8_COMPACT_VALUE_SERIALIZER_H_
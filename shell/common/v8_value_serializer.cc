@@ -4,15 +4,20 @@
 
 #include "shell/common/v8_value_serializer.h"
 
+#include <cstring>
 #include <utility>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/trace_event/trace_event.h"
 #include "gin/converter.h"
+#include "mojo/public/cpp/base/big_buffer.h"
 #include "shell/common/api/electron_api_native_image.h"
 #include "shell/common/gin_helper/microtasks_scope.h"
+#include "shell/common/v8_compact_value_serializer.h"
 #include "skia/public/mojom/bitmap.mojom.h"
 #include "third_party/blink/public/common/messaging/cloneable_message.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
 #include "third_party/blink/public/common/messaging/web_message_port.h"
 #include "ui/gfx/image/image_skia.h"
 #include "v8/include/v8.h"
@@ -33,30 +38,35 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
       : isolate_(isolate), serializer_(isolate, this) {}
   ~V8Serializer() override = default;
 
-  bool Serialize(v8::Local<v8::Value> value, blink::CloneableMessage* out) {
-    gin_helper::MicrotasksScope microtasks_scope(
-        isolate_, isolate_->GetCurrentContext()->GetMicrotaskQueue(),
-        v8::MicrotasksScope::kDoNotRunMicrotasks);
-    WriteBlinkEnvelope(19);
-
-    serializer_.WriteHeader();
-    bool wrote_value;
-    if (!serializer_.WriteValue(isolate_->GetCurrentContext(), value)
-             .To(&wrote_value)) {
-      isolate_->ThrowException(v8::Exception::Error(
-          gin::StringToV8(isolate_, "An object could not be cloned.")));
-      return false;
+  bool Serialize(v8::Local<v8::Value> value,
+                 blink::CloneableMessage* out,
+                 SerializationFormat format) {
+    if (format == SerializationFormat::kAllowCompact) {
+      gin_helper::MicrotasksScope microtasks_scope(
+          isolate_, isolate_->GetCurrentContext()->GetMicrotaskQueue(),
+          v8::MicrotasksScope::kDoNotRunMicrotasks);
+      std::vector<uint8_t> compact;
+      switch (SerializeCompactV8Value(isolate_, value, &compact)) {
+        case CompactSerializeResult::kSuccess:
+          out->encoded_message = compact;
+          out->owned_encoded_message = std::move(compact);
+          out->sender_agent_cluster_id =
+              blink::WebMessagePort::GetEmbedderAgentClusterID();
+          return true;
+        case CompactSerializeResult::kException:
+          return false;
+        case CompactSerializeResult::kUnsupported:
+          break;
+      }
     }
-    DCHECK(wrote_value);
-
-    std::pair<uint8_t*, size_t> buffer = serializer_.Release();
-    DCHECK_EQ(buffer.first, data_.data());
-    out->encoded_message = base::make_span(buffer.first, buffer.second);
-    out->owned_encoded_message = std::move(data_);
-    out->sender_agent_cluster_id =
-        blink::WebMessagePort::GetEmbedderAgentClusterID();
+    return Serialize(value, {}, out, nullptr);
+  }
 
-    return true;
+  bool Serialize(v8::Local<v8::Value> value,
+                 const std::vector<v8::Local<v8::ArrayBuffer>>& array_buffers,
+                 blink::TransferableMessage* out) {
+    return Serialize(value, array_buffers, out,
+                     &out->array_buffer_contents_array);
   }
 
   // v8::ValueSerializer::Delegate
@@ -102,6 +112,72 @@ class V8Serializer : public v8::ValueSerializer::Delegate {
   }
 
  private:
+  bool Serialize(v8::Local<v8::Value> value,
+                 const std::vector<v8::Local<v8::ArrayBuffer>>& array_buffers,
+                 blink::CloneableMessage* out,
+                 std::vector<mojo_base::BigBuffer>* array_buffer_contents) {
+    gin_helper::MicrotasksScope microtasks_scope(
+        isolate_, isolate_->GetCurrentContext()->GetMicrotaskQueue(),
+        v8::MicrotasksScope::kDoNotRunMicrotasks);
+    WriteBlinkEnvelope(19);
+
+    serializer_.WriteHeader();
+    for (size_t i = 0; i < array_buffers.size(); ++i) {
+      if (!array_buffers[i]->IsDetachable()) {
+        isolate_->ThrowException(v8::Exception::TypeError(gin::StringToV8(
+            isolate_, "An ArrayBuffer could not be transferred.")));
+        return false;
+      }
+      serializer_.TransferArrayBuffer(i, array_buffers[i]);
+    }
+    bool wrote_value;
+    if (!serializer_.WriteValue(isolate_->GetCurrentContext(), value)
+             .To(&wrote_value)) {
+      isolate_->ThrowException(v8::Exception::Error(
+          gin::StringToV8(isolate_, "An object could not be cloned.")));
+      return false;
+    }
+    DCHECK(wrote_value);
+
+    std::pair<uint8_t*, size_t> buffer = serializer_.Release();
+    DCHECK_EQ(buffer.first, data_.data());
+    out->encoded_message = base::make_span(buffer.first, buffer.second);
+    out->owned_encoded_message = std::move(data_);
+    out->sender_agent_cluster_id =
+        blink::WebMessagePort::GetEmbedderAgentClusterID();
+
+    if (array_buffer_contents && !TransferArrayBufferContents(
+                                     array_buffers, array_buffer_contents)) {
+      return false;
+    }
+
+    return true;
+  }
+
+  // Moves the contents of the transferred ArrayBuffers into mojo BigBuffers,
+  // which are backed by shared memory for anything larger than 64KB, so the
+  // bytes are not copied again when the message is sent.
+  bool TransferArrayBufferContents(
+      const std::vector<v8::Local<v8::ArrayBuffer>>& array_buffers,
+      std::vector<mojo_base::BigBuffer>* out) {
+    TRACE_EVENT1("electron", "V8Serializer::TransferArrayBufferContents",
+                 "count", array_buffers.size());
+    out->reserve(array_buffers.size());
+    for (const auto& array_buffer : array_buffers) {
+      out->emplace_back(base::make_span(
+          static_cast<const uint8_t*>(array_buffer->Data()),
+          array_buffer->ByteLength()));
+    }
+    for (const auto& array_buffer : array_buffers) {
+      bool detached;
+      if (!array_buffer->Detach(v8::Local<v8::Value>()).To(&detached) ||
+          !detached) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void WriteTag(SerializationTag tag) { serializer_.WriteRawBytes(&tag, 1); }
 
   void WriteBlinkEnvelope(uint32_t blink_version) {
@@ -121,8 +197,11 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
   V8Deserializer(v8::Isolate* isolate, base::span<const uint8_t> data)
       : isolate_(isolate),
         deserializer_(isolate, data.data(), data.size(), this) {}
-  V8Deserializer(v8::Isolate* isolate, const blink::CloneableMessage& message)
-      : V8Deserializer(isolate, message.encoded_message) {}
+  V8Deserializer(v8::Isolate* isolate,
+                 const blink::TransferableMessage& message)
+      : V8Deserializer(isolate, message.encoded_message) {
+    array_buffer_contents_ = &message.array_buffer_contents_array;
+  }
 
   v8::Local<v8::Value> Deserialize() {
     v8::EscapableHandleScope scope(isolate_);
@@ -136,6 +215,8 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
     if (!deserializer_.ReadHeader(context).To(&read_header))
       return v8::Null(isolate_);
     DCHECK(read_header);
+    if (array_buffer_contents_)
+      ReadTransferredArrayBuffers();
     v8::Local<v8::Value> value;
     if (!deserializer_.ReadValue(context).ToLocal(&value))
       return v8::Null(isolate_);
@@ -157,6 +238,20 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
   }
 
  private:
+  // The V8 sandbox does not allow ArrayBuffers to be backed by memory outside
+  // of the cage, so the transferred contents are copied into freshly
+  // allocated ArrayBuffers once, right out of shared memory.
+  void ReadTransferredArrayBuffers() {
+    for (size_t i = 0; i < array_buffer_contents_->size(); ++i) {
+      const mojo_base::BigBuffer& contents = (*array_buffer_contents_)[i];
+      v8::Local<v8::ArrayBuffer> array_buffer =
+          v8::ArrayBuffer::New(isolate_, contents.size());
+      if (contents.size())
+        memcpy(array_buffer->Data(), contents.data(), contents.size());
+      deserializer_.TransferArrayBuffer(i, array_buffer);
+    }
+  }
+
   bool ReadTag(uint8_t* tag) {
     const void* tag_bytes = nullptr;
     if (!deserializer_.ReadRawBytes(1, &tag_bytes))
@@ -220,21 +315,43 @@ class V8Deserializer : public v8::ValueDeserializer::Delegate {
 
   raw_ptr<v8::Isolate> isolate_;
   v8::ValueDeserializer deserializer_;
+  raw_ptr<const std::vector<mojo_base::BigBuffer>> array_buffer_contents_ =
+      nullptr;
 };
 
 bool SerializeV8Value(v8::Isolate* isolate,
                       v8::Local<v8::Value> value,
-                      blink::CloneableMessage* out) {
-  return V8Serializer(isolate).Serialize(value, out);
+                      blink::CloneableMessage* out,
+                      SerializationFormat format) {
+  return V8Serializer(isolate).Serialize(value, out, format);
+}
+
+bool SerializeV8Value(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& array_buffers,
+    blink::TransferableMessage* out) {
+  return V8Serializer(isolate).Serialize(value, array_buffers, out);
 }
 
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         const blink::CloneableMessage& in) {
+  return DeserializeV8Value(isolate, in.encoded_message);
+}
+
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        const blink::TransferableMessage& in) {
   return V8Deserializer(isolate, in).Deserialize();
 }
 
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data) {
+  if (IsCompactV8Value(data)) {
+    v8::Local<v8::Value> value;
+    if (!DeserializeCompactV8Value(isolate, data).ToLocal(&value))
+      return v8::Null(isolate);
+    return value;
+  }
   return V8Deserializer(isolate, data).Deserialize();
 }
 
@@ -5,6 +5,8 @@
 #ifndef ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 #define ELECTRON_SHELL_COMMON_V8_VALUE_SERIALIZER_H_
 
+#include <vector>
+
 #include "base/containers/span.h"
 #include "ui/gfx/image/image_skia_rep.h"
 
@@ -12,20 +14,44 @@ namespace v8 {
 class Isolate;
 template <class T>
 class Local;
+class ArrayBuffer;
 class Value;
 }  // namespace v8
 
 namespace blink {
 struct CloneableMessage;
+struct TransferableMessage;
 }
 
 namespace electron {
 
-bool SerializeV8Value(v8::Isolate* isolate,
-                      v8::Local<v8::Value> value,
-                      blink::CloneableMessage* out);
+// Messages that are only read by Electron's own IPC may use the compact
+// encoding from v8_compact_value_serializer.h for JSON-like values. Anything
+// that may be read by Blink or by another version of Electron has to use the
+// V8 wire format.
+enum class SerializationFormat {
+  kAllowCompact,
+  kV8Only,
+};
+
+bool SerializeV8Value(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    blink::CloneableMessage* out,
+    SerializationFormat format = SerializationFormat::kAllowCompact);
+// Like the above, but the contents of |array_buffers| are moved into
+// |out->array_buffer_contents_array| instead of being copied inline into the
+// encoded message, and the ArrayBuffers are detached. This always uses the V8
+// format, as TransferableMessages may be read by Blink.
+bool SerializeV8Value(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& array_buffers,
+    blink::TransferableMessage* out);
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         const blink::CloneableMessage& in);
+v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
+                                        const blink::TransferableMessage& in);
 v8::Local<v8::Value> DeserializeV8Value(v8::Isolate* isolate,
                                         base::span<const uint8_t> data);
 
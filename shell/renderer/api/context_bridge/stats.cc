@@ -0,0 +1,14 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/api/context_bridge/stats.h"
+
+namespace electron::api::context_bridge {
+
+Stats& GetStats() {
+  static Stats stats;
+  return stats;
+}
+
+}  // namespace electron::api::context_bridge
@@ -0,0 +1,36 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_STATS_H_
+#define ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_STATS_H_
+
+#include <cstdint>
+
+namespace electron::api::context_bridge {
+
+// Cumulative counters for everything that crossed the context bridge in this
+// renderer process, reported by webFrame.getContextBridgeStats(). The bridge
+// only runs on the renderer main thread, so these are not synchronized.
+struct Stats {
+  // Calls made through proxied functions.
+  uint64_t calls = 0;
+  // Proxies created for functions and promises.
+  uint64_t functions_proxied = 0;
+  uint64_t promises_proxied = 0;
+  // Objects and arrays copied into the other context, including values
+  // copied by the structured clone fallback.
+  uint64_t objects_cloned = 0;
+  // Bytes of structured clone data produced by the fallback.
+  uint64_t bytes_copied = 0;
+  // Buffers marked with contextBridge.shareBuffer() passed by reference.
+  uint64_t buffers_shared = 0;
+  // Values found in the per-call cache or as a reused function proxy.
+  uint64_t cache_hits = 0;
+};
+
+Stats& GetStats();
+
+}  // namespace electron::api::context_bridge
+
+#endif  // ELECTRON_SHELL_RENDERER_API_CONTEXT_BRIDGE_STATS_H_
@@ -5,13 +5,11 @@
 #include "shell/renderer/api/electron_api_context_bridge.h"
 
 #include <memory>
-#include <set>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
-#include "base/containers/contains.h"
 #include "base/feature_list.h"
 #include "base/no_destructor.h"
 #include "base/trace_event/trace_event.h"
@@ -21,9 +19,11 @@
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/world_ids.h"
+#include "shell/renderer/api/context_bridge/stats.h"
 #include "third_party/blink/public/web/web_blob.h"
 #include "third_party/blink/public/web/web_element.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -48,6 +48,12 @@ const char kProxyFunctionReceiverPrivateKey[] =
 const char kSupportsDynamicPropertiesPrivateKey[] =
     "electron_contextBridge_supportsDynamicProperties";
 const char kOriginalFunctionPrivateKey[] = "electron_contextBridge_original_fn";
+const char kCachedProxyFunctionPrivateKey[] =
+    "electron_contextBridge_cached_proxy_fn";
+const char kCachedDynamicProxyFunctionPrivateKey[] =
+    "electron_contextBridge_cached_dynamic_proxy_fn";
+const char kSharedBufferPrivateKey[] = "electron_contextBridge_shared_buffer";
+const char kFrozenPrivateKey[] = "electron_contextBridge_frozen";
 
 }  // namespace context_bridge
 
@@ -61,28 +67,48 @@ inline bool IsTrue(v8::Maybe<bool> maybe) {
 }
 
 // Sourced from "extensions/renderer/v8_schema_registry.cc"
-// Recursively freezes every v8 object on |object|.
-bool DeepFreeze(const v8::Local<v8::Object>& object,
-                const v8::Local<v8::Context>& context,
-                std::set<int> frozen = std::set<int>()) {
-  int hash = object->GetIdentityHash();
-  if (base::Contains(frozen, hash))
+// Freezes |root| and every v8 object reachable from it. Each object is marked
+// before its properties are visited, which breaks cycles and lets later
+// exposures skip objects that are already frozen, such as function proxies
+// that are reused across calls.
+bool DeepFreeze(v8::Local<v8::Object> root, v8::Local<v8::Context> context) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Private> frozen_key = v8::Private::ForApi(
+      isolate, gin::StringToV8(isolate, context_bridge::kFrozenPrivateKey));
+  std::vector<v8::Local<v8::Object>> pending;
+  auto mark = [&](v8::Local<v8::Object> object) {
+    if (IsTrue(object->HasPrivate(context, frozen_key)))
+      return true;
+    if (!IsTrue(object->SetPrivate(context, frozen_key, v8::True(isolate))))
+      return false;
+    pending.push_back(object);
     return true;
-  frozen.insert(hash);
-
-  v8::Local<v8::Array> property_names =
-      object->GetOwnPropertyNames(context).ToLocalChecked();
-  for (uint32_t i = 0; i < property_names->Length(); ++i) {
-    v8::Local<v8::Value> child =
-        object->Get(context, property_names->Get(context, i).ToLocalChecked())
-            .ToLocalChecked();
-    if (child->IsObject() && !child->IsTypedArray()) {
-      if (!DeepFreeze(child.As<v8::Object>(), context, frozen))
+  };
+
+  if (!mark(root))
+    return false;
+  while (!pending.empty()) {
+    v8::Local<v8::Object> object = pending.back();
+    pending.pop_back();
+
+    v8::Local<v8::Array> property_names;
+    if (!object->GetOwnPropertyNames(context).ToLocal(&property_names))
+      return false;
+    for (uint32_t i = 0; i < property_names->Length(); ++i) {
+      v8::Local<v8::Value> name;
+      v8::Local<v8::Value> child;
+      if (!property_names->Get(context, i).ToLocal(&name) ||
+          !object->Get(context, name).ToLocal(&child))
+        return false;
+      if (child->IsObject() && !child->IsTypedArray() &&
+          !mark(child.As<v8::Object>()))
         return false;
     }
+    if (!IsTrue(
+            object->SetIntegrityLevel(context, v8::IntegrityLevel::kFrozen)))
+      return false;
   }
-  return IsTrue(
-      object->SetIntegrityLevel(context, v8::IntegrityLevel::kFrozen));
+  return true;
 }
 
 bool IsPlainObject(const v8::Local<v8::Value>& object) {
@@ -133,6 +159,92 @@ v8::MaybeLocal<v8::Value> GetPrivate(v8::Local<v8::Context> context,
                           gin::StringToV8(context->GetIsolate(), key)));
 }
 
+// Returns the ArrayBuffer behind |value| if it was marked with
+// contextBridge.shareBuffer() and can safely be shared with another context.
+// Buffers that can be detached or resized by something other than script,
+// such as WebAssembly memories, are always copied.
+v8::Local<v8::ArrayBuffer> GetSharedArrayBuffer(
+    v8::Local<v8::Context> source_context,
+    v8::Local<v8::Value> value) {
+  v8::Local<v8::ArrayBuffer> buffer =
+      value->IsArrayBuffer() ? value.As<v8::ArrayBuffer>()
+                             : value.As<v8::ArrayBufferView>()->Buffer();
+  v8::Local<v8::Value> shared;
+  if (!buffer->IsArrayBuffer() || !buffer->IsDetachable() ||
+      buffer->WasDetached() ||
+      !GetPrivate(source_context, buffer,
+                  context_bridge::kSharedBufferPrivateKey)
+           .ToLocal(&shared) ||
+      !shared->IsTrue()) {
+    return v8::Local<v8::ArrayBuffer>();
+  }
+  return buffer;
+}
+
+// Creates |value| in |destination_context| on top of the same backing store
+// as |source_buffer| instead of copying its contents. Both worlds live in the
+// same isolate, so the backing store can be owned by both ArrayBuffers.
+v8::MaybeLocal<v8::Value> ShareArrayBufferWithOtherContext(
+    v8::Local<v8::Context> destination_context,
+    v8::Local<v8::Value> value,
+    v8::Local<v8::ArrayBuffer> source_buffer,
+    context_bridge::ObjectCache* object_cache) {
+  v8::Isolate* isolate = destination_context->GetIsolate();
+  v8::Context::Scope destination_context_scope(destination_context);
+
+  // Views onto the same buffer keep sharing a single buffer on the other
+  // side.
+  v8::Local<v8::ArrayBuffer> buffer;
+  v8::Local<v8::Value> cached_buffer;
+  if (object_cache->GetCachedProxiedObject(source_buffer)
+          .ToLocal(&cached_buffer)) {
+    buffer = cached_buffer.As<v8::ArrayBuffer>();
+  } else {
+    context_bridge::GetStats().buffers_shared++;
+    buffer = v8::ArrayBuffer::New(isolate, source_buffer->GetBackingStore());
+    SetPrivate(destination_context, buffer,
+               context_bridge::kSharedBufferPrivateKey, v8::True(isolate));
+    object_cache->CacheProxiedObject(source_buffer, buffer);
+  }
+  if (value->IsArrayBuffer())
+    return v8::MaybeLocal<v8::Value>(buffer);
+
+  auto view = value.As<v8::ArrayBufferView>();
+  const size_t offset = view->ByteOffset();
+  v8::Local<v8::Value> shared_view;
+  if (view->IsDataView()) {
+    shared_view = v8::DataView::New(buffer, offset, view->ByteLength());
+  } else {
+    const size_t length = view.As<v8::TypedArray>()->Length();
+    if (view->IsUint8Array())
+      shared_view = v8::Uint8Array::New(buffer, offset, length);
+    else if (view->IsUint8ClampedArray())
+      shared_view = v8::Uint8ClampedArray::New(buffer, offset, length);
+    else if (view->IsInt8Array())
+      shared_view = v8::Int8Array::New(buffer, offset, length);
+    else if (view->IsUint16Array())
+      shared_view = v8::Uint16Array::New(buffer, offset, length);
+    else if (view->IsInt16Array())
+      shared_view = v8::Int16Array::New(buffer, offset, length);
+    else if (view->IsUint32Array())
+      shared_view = v8::Uint32Array::New(buffer, offset, length);
+    else if (view->IsInt32Array())
+      shared_view = v8::Int32Array::New(buffer, offset, length);
+    else if (view->IsFloat32Array())
+      shared_view = v8::Float32Array::New(buffer, offset, length);
+    else if (view->IsFloat64Array())
+      shared_view = v8::Float64Array::New(buffer, offset, length);
+    else if (view->IsBigInt64Array())
+      shared_view = v8::BigInt64Array::New(buffer, offset, length);
+    else if (view->IsBigUint64Array())
+      shared_view = v8::BigUint64Array::New(buffer, offset, length);
+    else
+      return v8::MaybeLocal<v8::Value>();
+  }
+  object_cache->CacheProxiedObject(value, shared_view);
+  return v8::MaybeLocal<v8::Value>(shared_view);
+}
+
 }  // namespace
 
 v8::MaybeLocal<v8::Value> PassValueToOtherContext(
@@ -170,6 +282,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
   // Check Cache
   auto cached_value = object_cache->GetCachedProxiedObject(value);
   if (!cached_value.IsEmpty()) {
+    context_bridge::GetStats().cache_hits++;
     return cached_value;
   }
 
@@ -197,6 +310,30 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
         return v8::MaybeLocal<v8::Value>(proxy_func);
       }
 
+      // Functions passed as arguments, return values or promise results are
+      // bound to the global of the context they came from, so their proxy
+      // does not depend on anything but the function and the destination
+      // context and can be reused across calls. It is stored as a private on
+      // the source function, which keeps it alive for exactly as long as the
+      // function is and lets both be collected together.
+      const bool can_reuse_proxy = parent_value == source_context->Global();
+      const char* cached_proxy_key =
+          support_dynamic_properties
+              ? context_bridge::kCachedDynamicProxyFunctionPrivateKey
+              : context_bridge::kCachedProxyFunctionPrivateKey;
+      if (can_reuse_proxy &&
+          GetPrivate(source_context, func, cached_proxy_key)
+              .ToLocal(&proxy_func) &&
+          proxy_func->IsFunction() &&
+          proxy_func.As<v8::Object>()->GetCreationContextChecked() ==
+              destination_context) {
+        TRACE_EVENT0("electron", "ContextBridge::ReuseProxyFunction");
+        context_bridge::GetStats().cache_hits++;
+        object_cache->CacheProxiedObject(value, proxy_func);
+        return v8::MaybeLocal<v8::Value>(proxy_func);
+      }
+
+      context_bridge::GetStats().functions_proxied++;
       v8::Local<v8::Object> state =
           v8::Object::New(destination_context->GetIsolate());
       SetPrivate(destination_context, state,
@@ -214,6 +351,16 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
         return v8::MaybeLocal<v8::Value>();
       SetPrivate(destination_context, proxy_func.As<v8::Object>(),
                  context_bridge::kOriginalFunctionPrivateKey, func);
+      // Frozen functions and callable proxies may refuse the private, in
+      // which case they are simply proxied again on the next call.
+      if (can_reuse_proxy) {
+        std::ignore = func->SetPrivate(
+            source_context,
+            v8::Private::ForApi(
+                source_context->GetIsolate(),
+                gin::StringToV8(source_context->GetIsolate(), cached_proxy_key)),
+            proxy_func);
+      }
       object_cache->CacheProxiedObject(value, proxy_func);
       return v8::MaybeLocal<v8::Value>(proxy_func);
     }
@@ -221,6 +368,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
 
   // Proxy promises as they have a safe and guaranteed memory lifecycle
   if (value->IsPromise()) {
+    context_bridge::GetStats().promises_proxied++;
     v8::Context::Scope destination_scope(destination_context);
     auto source_promise = value.As<v8::Promise>();
     // Make the promise a shared_ptr so that when the original promise is
@@ -363,6 +511,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
   // array so that functions deep inside arrays get proxied or arrays of
   // promises are proxied correctly.
   if (IsPlainArray(value)) {
+    context_bridge::GetStats().objects_cloned++;
     v8::Context::Scope destination_context_scope(destination_context);
     v8::Local<v8::Array> arr = value.As<v8::Array>();
     size_t length = arr->Length();
@@ -405,6 +554,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
 
   // Proxy all objects
   if (IsPlainObject(value)) {
+    context_bridge::GetStats().objects_cloned++;
     auto object_value = value.As<v8::Object>();
     auto passed_value = CreateProxyForAPI(
         object_value, source_context, destination_context, object_cache,
@@ -414,9 +564,23 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
     return v8::MaybeLocal<v8::Value>(passed_value.ToLocalChecked());
   }
 
+  // Buffers marked with contextBridge.shareBuffer() are passed by reference
+  if (value->IsArrayBuffer() || value->IsArrayBufferView()) {
+    v8::Local<v8::ArrayBuffer> source_buffer =
+        GetSharedArrayBuffer(source_context, value);
+    v8::Local<v8::Value> shared_value;
+    if (!source_buffer.IsEmpty() &&
+        ShareArrayBufferWithOtherContext(destination_context, value,
+                                         source_buffer, object_cache)
+            .ToLocal(&shared_value)) {
+      return v8::MaybeLocal<v8::Value>(shared_value);
+    }
+  }
+
   // Serializable objects
   blink::CloneableMessage ret;
   {
+    TRACE_EVENT0("electron", "ContextBridge::SerializeValue");
     v8::Local<v8::Context> error_context =
         error_target == BridgeErrorTarget::kSource ? source_context
                                                    : destination_context;
@@ -426,6 +590,8 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
       return v8::MaybeLocal<v8::Value>();
     }
   }
+  context_bridge::GetStats().objects_cloned++;
+  context_bridge::GetStats().bytes_copied += ret.encoded_message.size();
 
   {
     v8::Context::Scope destination_context_scope(destination_context);
@@ -438,6 +604,7 @@ v8::MaybeLocal<v8::Value> PassValueToOtherContext(
 
 void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
   TRACE_EVENT0("electron", "ContextBridge::ProxyFunctionWrapper");
+  context_bridge::GetStats().calls++;
   CHECK(info.Data()->IsObject());
   v8::Local<v8::Object> data = info.Data().As<v8::Object>();
   bool support_dynamic_properties = false;
@@ -464,6 +631,14 @@ void ProxyFunctionWrapper(const v8::FunctionCallbackInfo<v8::Value>& info) {
   v8::Local<v8::Context> func_owning_context =
       func->GetCreationContextChecked();
 
+  // Only look up the name of the function when someone is tracing
+  bool tracing_enabled = false;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED("electron", &tracing_enabled);
+  TRACE_EVENT1("electron", "ContextBridge::CallProxiedFunction", "name",
+               tracing_enabled
+                   ? gin::V8ToString(args.isolate(), func->GetDebugName())
+                   : std::string());
+
   {
     v8::Context::Scope func_owning_context_scope(func_owning_context);
     context_bridge::ObjectCache object_cache;
@@ -812,6 +987,35 @@ bool OverrideGlobalPropertyFromIsolatedWorld(
   }
 }
 
+v8::Local<v8::Value> ShareBuffer(gin_helper::ErrorThrower thrower,
+                                 v8::Local<v8::Value> value) {
+  v8::Local<v8::ArrayBuffer> buffer;
+  if (value->IsArrayBuffer()) {
+    buffer = value.As<v8::ArrayBuffer>();
+  } else if (value->IsArrayBufferView()) {
+    auto view = value.As<v8::ArrayBufferView>();
+    buffer = view->Buffer();
+    // The other side can always reach the whole buffer through |view.buffer|,
+    // so refuse views onto part of one, like Buffers carved out of Node's
+    // allocation pool.
+    if (view->ByteOffset() != 0 ||
+        view->ByteLength() != buffer->ByteLength()) {
+      thrower.ThrowTypeError(
+          "Only views that span their entire ArrayBuffer can be shared");
+      return v8::Undefined(thrower.isolate());
+    }
+  }
+  if (buffer.IsEmpty() || !buffer->IsArrayBuffer()) {
+    thrower.ThrowTypeError("Expected an ArrayBuffer or ArrayBufferView");
+    return v8::Undefined(thrower.isolate());
+  }
+
+  SetPrivate(thrower.isolate()->GetCurrentContext(), buffer,
+             context_bridge::kSharedBufferPrivateKey,
+             v8::True(thrower.isolate()));
+  return value;
+}
+
 bool IsCalledFromMainWorld(v8::Isolate* isolate) {
   auto* render_frame = GetRenderFrame(isolate->GetCurrentContext()->Global());
   CHECK(render_frame);
@@ -834,6 +1038,7 @@ void Initialize(v8::Local<v8::Object> exports,
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary dict(isolate, exports);
   dict.SetMethod("exposeAPIInWorld", &electron::api::ExposeAPIInWorld);
+  dict.SetMethod("shareBuffer", &electron::api::ShareBuffer);
   dict.SetMethod("_overrideGlobalValueFromIsolatedWorld",
                  &electron::api::OverrideGlobalValueFromIsolatedWorld);
   dict.SetMethod("_overrideGlobalPropertyFromIsolatedWorld",
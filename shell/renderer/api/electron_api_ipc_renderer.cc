@@ -3,7 +3,15 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/containers/contains.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -15,11 +23,13 @@
 #include "shell/common/api/api.mojom.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/shared_values.h"
 #include "shell/common/v8_value_serializer.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -33,6 +43,47 @@ namespace {
 const char kIPCMethodCalledAfterContextReleasedError[] =
     "IPC method called after context was released";
 
+// The region holding the values published with ipcMain.setSharedValue() is
+// the same for every frame, so it is mapped once per renderer process.
+base::ReadOnlySharedMemoryMapping& GetSharedValuesMapping() {
+  static base::NoDestructor<base::ReadOnlySharedMemoryMapping> mapping;
+  return *mapping;
+}
+
+// Counters of the messages sent on each channel by the frames of this
+// renderer process since the last reset, see ipcRenderer.getStats().
+struct ChannelStats {
+  uint64_t messages = 0;
+  uint64_t bytes = 0;
+  base::TimeDelta serialization_time;
+};
+
+base::flat_map<std::string, ChannelStats>& GetChannelStats() {
+  static base::NoDestructor<base::flat_map<std::string, ChannelStats>> stats;
+  return *stats;
+}
+
+// Serializes the |arguments| of a message on |channel|, and counts it unless
+// the channel is internal.
+bool SerializeMessage(v8::Isolate* isolate,
+                      bool internal,
+                      const std::string& channel,
+                      v8::Local<v8::Value> arguments,
+                      blink::CloneableMessage* message) {
+  TRACE_EVENT1("electron", "IPCRenderer::SerializeMessage", "channel",
+               channel);
+  const base::TimeTicks start = base::TimeTicks::Now();
+  if (!electron::SerializeV8Value(isolate, arguments, message))
+    return false;
+  if (!internal) {
+    auto& stats = GetChannelStats()[channel];
+    stats.messages++;
+    stats.bytes += message->encoded_message.size();
+    stats.serialization_time += base::TimeTicks::Now() - start;
+  }
+  return true;
+}
+
 RenderFrame* GetCurrentRenderFrame() {
   WebLocalFrame* frame = WebLocalFrame::FrameForCurrentContext();
   if (!frame)
@@ -79,7 +130,11 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
         .SetMethod("sendSync", &IPCRenderer::SendSync)
         .SetMethod("sendToHost", &IPCRenderer::SendToHost)
         .SetMethod("invoke", &IPCRenderer::Invoke)
-        .SetMethod("postMessage", &IPCRenderer::PostMessage);
+        .SetMethod("postMessage", &IPCRenderer::PostMessage)
+        .SetMethod("getSharedValue", &IPCRenderer::GetSharedValue)
+        .SetMethod("getSharedBuffer", &IPCRenderer::GetSharedBuffer)
+        .SetMethod("getStats", &IPCRenderer::GetStats)
+        .SetMethod("resetStats", &IPCRenderer::ResetStats);
   }
 
   const char* GetTypeName() override { return "IPCRenderer"; }
@@ -95,7 +150,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       return;
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!SerializeMessage(isolate, internal, channel, arguments, &message)) {
       return;
     }
     electron_ipc_remote_->Message(internal, channel, std::move(message));
@@ -111,7 +166,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       return v8::Local<v8::Promise>();
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!SerializeMessage(isolate, internal, channel, arguments, &message)) {
       return v8::Local<v8::Promise>();
     }
     gin_helper::Promise<blink::CloneableMessage> p(isolate);
@@ -136,13 +191,6 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
-    blink::TransferableMessage transferable_message;
-    if (!electron::SerializeV8Value(isolate, message_value,
-                                    &transferable_message)) {
-      // SerializeV8Value sets an exception.
-      return;
-    }
-
     std::vector<v8::Local<v8::Object>> transferables;
     if (transfer && !transfer.value()->IsUndefined()) {
       if (!gin::ConvertFromV8(isolate, *transfer, &transferables)) {
@@ -151,8 +199,32 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       }
     }
 
-    std::vector<blink::MessagePortChannel> ports;
+    // ArrayBuffers in the transfer list are sent out of band in shared
+    // memory rather than being copied into the serialized message.
+    std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+    std::vector<v8::Local<v8::Object>> port_objects;
     for (auto& transferable : transferables) {
+      if (transferable->IsArrayBuffer()) {
+        auto array_buffer = transferable.As<v8::ArrayBuffer>();
+        if (base::Contains(array_buffers, array_buffer)) {
+          thrower.ThrowTypeError("ArrayBuffer is duplicated in transfer");
+          return;
+        }
+        array_buffers.push_back(array_buffer);
+      } else {
+        port_objects.push_back(transferable);
+      }
+    }
+
+    blink::TransferableMessage transferable_message;
+    if (!electron::SerializeV8Value(isolate, message_value, array_buffers,
+                                    &transferable_message)) {
+      // SerializeV8Value sets an exception.
+      return;
+    }
+
+    std::vector<blink::MessagePortChannel> ports;
+    for (auto& transferable : port_objects) {
       std::optional<blink::MessagePortChannel> port =
           blink::WebMessagePortConverter::
               DisentangleAndExtractMessagePortChannel(isolate, transferable);
@@ -177,7 +249,8 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       return;
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!SerializeMessage(isolate, /*internal=*/false, channel, arguments,
+                          &message)) {
       return;
     }
     electron_ipc_remote_->MessageHost(channel, std::move(message));
@@ -193,7 +266,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       return v8::Local<v8::Value>();
     }
     blink::CloneableMessage message;
-    if (!electron::SerializeV8Value(isolate, arguments, &message)) {
+    if (!SerializeMessage(isolate, internal, channel, arguments, &message)) {
       return v8::Local<v8::Value>();
     }
 
@@ -203,6 +276,78 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
     return electron::DeserializeV8Value(isolate, result);
   }
 
+  v8::Local<v8::Value> GetSharedValue(v8::Isolate* isolate,
+                                      gin_helper::ErrorThrower thrower,
+                                      const std::string& key) {
+    base::ReadOnlySharedMemoryMapping& mapping = GetSharedValuesMapping();
+    std::vector<uint8_t> value;
+    for (;;) {
+      if (!mapping.IsValid()) {
+        if (!electron_ipc_remote_) {
+          thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
+          return v8::Local<v8::Value>();
+        }
+        base::ReadOnlySharedMemoryRegion region;
+        electron_ipc_remote_->GetSharedValues(&region);
+        mapping = region.Map();
+        if (!mapping.IsValid())
+          return v8::Undefined(isolate);
+      }
+
+      switch (electron::shared_values::ReadValue(
+          mapping.GetMemoryAsSpan<uint8_t>(), key, &value)) {
+        case electron::shared_values::ReadResult::kFound:
+          return electron::DeserializeV8Value(isolate, value);
+        case electron::shared_values::ReadResult::kNotFound:
+          return v8::Undefined(isolate);
+        case electron::shared_values::ReadResult::kSuperseded:
+          mapping = base::ReadOnlySharedMemoryMapping();
+          break;
+      }
+    }
+  }
+
+  v8::Local<v8::Value> GetSharedBuffer(v8::Isolate* isolate,
+                                       gin_helper::ErrorThrower thrower,
+                                       const std::string& name) {
+    if (!electron_ipc_remote_) {
+      thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
+      return v8::Local<v8::Value>();
+    }
+    base::ReadOnlySharedMemoryRegion region;
+    electron_ipc_remote_->GetSharedBuffer(name, &region);
+    auto* mapping = new base::ReadOnlySharedMemoryMapping(region.Map());
+    if (!mapping->IsValid()) {
+      delete mapping;
+      return v8::Null(isolate);
+    }
+
+    // The ArrayBuffer is backed by the mapping rather than by a copy of the
+    // data, which stays in memory once however many renderers map it.
+    auto backing_store = v8::ArrayBuffer::NewBackingStore(
+        const_cast<void*>(mapping->memory()), mapping->size(),
+        [](void*, size_t, void* mapping) {
+          delete static_cast<base::ReadOnlySharedMemoryMapping*>(mapping);
+        },
+        mapping);
+    return v8::ArrayBuffer::New(isolate, std::move(backing_store));
+  }
+
+  std::vector<gin_helper::Dictionary> GetStats(v8::Isolate* isolate) {
+    std::vector<gin_helper::Dictionary> list;
+    for (const auto& [channel, stats] : GetChannelStats()) {
+      auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+      dict.Set("channel", channel);
+      dict.Set("messages", static_cast<double>(stats.messages));
+      dict.Set("bytes", static_cast<double>(stats.bytes));
+      dict.Set("serializationTime", stats.serialization_time.InMillisecondsF());
+      list.push_back(dict);
+    }
+    return list;
+  }
+
+  void ResetStats() { GetChannelStats().clear(); }
+
   v8::Global<v8::Context> weak_context_;
   mojo::AssociatedRemote<electron::mojom::ElectronApiIPC> electron_ipc_remote_;
 };
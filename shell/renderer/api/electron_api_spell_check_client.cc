@@ -6,13 +6,11 @@
 
 #include <iterator>
 #include <memory>
-#include <set>
 #include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
-#include "base/containers/contains.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/task/single_thread_task_runner.h"
@@ -41,6 +39,9 @@ bool HasWordCharacters(const std::u16string& text, int index) {
   return false;
 }
 
+// The number of correct words that are remembered, about a megabyte.
+constexpr size_t kMaxCorrectWords = 20000;
+
 struct Word {
   blink::WebTextCheckingResult result;
   std::u16string text;
@@ -62,10 +63,13 @@ class SpellCheckClient::SpellcheckRequest {
   const std::u16string& text() const { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_.get(); }
   std::vector<Word>& wordlist() { return word_list_; }
+  std::vector<std::u16string>& checked_words() { return checked_words_; }
 
  private:
   std::u16string text_;          // Text to be checked in this task.
   std::vector<Word> word_list_;  // List of Words found in text
+  // The words sent to the provider, those that are not known to be correct.
+  std::vector<std::u16string> checked_words_;
   // The interface to send the misspelled ranges to Blink.
   std::unique_ptr<blink::WebTextCheckingCompletion> completion_;
 };
@@ -154,7 +158,7 @@ void SpellCheckClient::SpellCheckText() {
   std::u16string word;
   size_t word_start;
   size_t word_length;
-  std::set<std::u16string> words;
+  std::unordered_set<std::u16string> words;
   auto& word_list = pending_request_param_->wordlist();
   Word word_entry;
   for (;;) {  // Run until end of text
@@ -181,26 +185,51 @@ void SpellCheckClient::SpellCheckText() {
     }
   }
 
+  // Blink asks for the whole paragraph around each edit, only the words that
+  // are not known to be correct yet are sent to the provider.
+  auto& checked_words = pending_request_param_->checked_words();
+  for (const auto& w : words) {
+    if (!correct_words_.contains(w))
+      checked_words.push_back(w);
+  }
+  if (checked_words.empty()) {
+    OnSpellCheckDone({});
+    return;
+  }
+
   // Send out all the words data to the spellchecker to check
-  SpellCheckWords(scope, words);
+  SpellCheckWords(scope, checked_words);
 }
 
 void SpellCheckClient::OnSpellCheckDone(
     const std::vector<std::u16string>& misspelled_words) {
+  if (!pending_request_param_)
+    return;
+
   std::vector<blink::WebTextCheckingResult> results;
   std::unordered_set<std::u16string> misspelled(misspelled_words.begin(),
                                                 misspelled_words.end());
 
+  // Remember the words that the provider found correct. Misspelled words are
+  // always checked again, they may have been added to a dictionary since.
+  auto& checked_words = pending_request_param_->checked_words();
+  if (correct_words_.size() + checked_words.size() > kMaxCorrectWords)
+    correct_words_.clear();
+  for (auto& word : checked_words) {
+    if (!misspelled.contains(word))
+      correct_words_.insert(std::move(word));
+  }
+
   auto& word_list = pending_request_param_->wordlist();
 
   for (const auto& word : word_list) {
-    if (base::Contains(misspelled, word.text)) {
+    if (misspelled.contains(word.text)) {
       // If this is a contraction, iterate through parts and accept the word
       // if none of them are misspelled
       if (!word.contraction_words.empty()) {
         auto all_correct = true;
         for (const auto& contraction_word : word.contraction_words) {
-          if (base::Contains(misspelled, contraction_word)) {
+          if (misspelled.contains(contraction_word)) {
             all_correct = false;
             break;
           }
@@ -215,8 +244,9 @@ void SpellCheckClient::OnSpellCheckDone(
   pending_request_param_ = nullptr;
 }
 
-void SpellCheckClient::SpellCheckWords(const SpellCheckScope& scope,
-                                       const std::set<std::u16string>& words) {
+void SpellCheckClient::SpellCheckWords(
+    const SpellCheckScope& scope,
+    const std::vector<std::u16string>& words) {
   DCHECK(!scope.spell_check_.IsEmpty());
 
   auto context = isolate_->GetCurrentContext();
@@ -6,8 +6,8 @@
 #define ELECTRON_SHELL_RENDERER_API_ELECTRON_API_SPELL_CHECK_CLIENT_H_
 
 #include <memory>
-#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "base/functional/callback.h"
@@ -72,7 +72,7 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // The javascript function will callback OnSpellCheckDone
   // with the results of all the misspelled words.
   void SpellCheckWords(const SpellCheckScope& scope,
-                       const std::set<std::u16string>& words);
+                       const std::vector<std::u16string>& words);
 
   // Returns whether or not the given word is a contraction of valid words
   // (e.g. "word:word").
@@ -102,6 +102,10 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
 
+  // The words that the provider found correct, which are not sent to it
+  // again.
+  std::unordered_set<std::u16string> correct_words_;
+
   raw_ptr<v8::Isolate> isolate_;
   v8::Global<v8::Context> context_;
   v8::Global<v8::Object> provider_;
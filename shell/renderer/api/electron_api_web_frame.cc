@@ -32,6 +32,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/renderer/api/context_bridge/object_cache.h"
+#include "shell/renderer/api/context_bridge/stats.h"
 #include "shell/renderer/api/electron_api_context_bridge.h"
 #include "shell/renderer/api/electron_api_spell_check_client.h"
 #include "shell/renderer/renderer_client_base.h"
@@ -375,6 +376,8 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
                    &WebFrameRenderer::SetIsolatedWorldInfo)
         .SetMethod("getResourceUsage", &WebFrameRenderer::GetResourceUsage)
         .SetMethod("clearCache", &WebFrameRenderer::ClearCache)
+        .SetMethod("getContextBridgeStats",
+                   &WebFrameRenderer::GetContextBridgeStats)
         .SetMethod("setSpellCheckProvider",
                    &WebFrameRenderer::SetSpellCheckProvider)
         // Frame navigators
@@ -784,6 +787,19 @@ class WebFrameRenderer : public gin::Wrappable<WebFrameRenderer>,
     return stats;
   }
 
+  v8::Local<v8::Value> GetContextBridgeStats(v8::Isolate* isolate) {
+    const context_bridge::Stats& stats = context_bridge::GetStats();
+    auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+    dict.Set("calls", stats.calls);
+    dict.Set("functionsProxied", stats.functions_proxied);
+    dict.Set("promisesProxied", stats.promises_proxied);
+    dict.Set("objectsCloned", stats.objects_cloned);
+    dict.Set("bytesCopied", stats.bytes_copied);
+    dict.Set("buffersShared", stats.buffers_shared);
+    dict.Set("cacheHits", stats.cache_hits);
+    return dict.GetHandle();
+  }
+
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   bool IsWordMisspelled(v8::Isolate* isolate, const std::string& word) {
     content::RenderFrame* render_frame;
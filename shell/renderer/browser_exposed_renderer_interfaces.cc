@@ -8,10 +8,14 @@
 
 #include "base/functional/bind.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/task/single_thread_task_runner.h"
 #include "build/build_config.h"
 #include "electron/buildflags/buildflags.h"
+#include "content/public/renderer/render_thread.h"
 #include "mojo/public/cpp/bindings/binder_map.h"
 #include "shell/renderer/renderer_client_base.h"
+#include "shell/renderer/renderer_diagnostics.h"
+#include "third_party/blink/public/web/blink.h"
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 #include "components/spellcheck/renderer/spellcheck.h"
@@ -32,6 +36,12 @@ void BindSpellChecker(
 void ExposeElectronRendererInterfacesToBrowser(
     electron::RendererClientBase* client,
     mojo::BinderMap* binders) {
+  // Bound on the IO thread, so that it answers while the main thread is busy.
+  binders->Add<electron::mojom::ElectronRendererDiagnostics>(
+      base::BindRepeating(&electron::RendererDiagnostics::Create,
+                          base::Unretained(blink::MainThreadIsolate()),
+                          base::SingleThreadTaskRunner::GetCurrentDefault()),
+      content::RenderThread::Get()->GetIOTaskRunner());
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   binders->Add<spellcheck::mojom::SpellChecker>(
       base::BindRepeating(&BindSpellChecker, client),
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/environment.h"
+#include "base/memory/raw_ptr.h"
 #include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
 #include "mojo/public/cpp/system/platform_handle.h"
@@ -19,7 +20,6 @@
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
-#include "shell/common/thread_restrictions.h"
 #include "shell/common/v8_value_serializer.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/renderer_client_base.h"
@@ -77,6 +77,53 @@ void InvokeIpcCallback(v8::Local<v8::Context> context,
   std::ignore = callback->Call(context, ipcNative, args.size(), args.data());
 }
 
+// Attributes the heap of the contexts of |frame| to its worlds.
+class FrameMemoryDelegate : public v8::MeasureMemoryDelegate {
+ public:
+  FrameMemoryDelegate(v8::Isolate* isolate,
+                      blink::WebLocalFrame* frame,
+                      mojom::ElectronRenderer::MeasureMemoryCallback callback)
+      : frame_(frame),
+        main_world_(isolate, frame->MainWorldScriptContext()),
+        callback_(std::move(callback)) {}
+  ~FrameMemoryDelegate() override {
+    // Measurements are dropped when the isolate is torn down.
+    if (callback_)
+      std::move(callback_).Run(mojom::FrameMemoryUsage::New());
+  }
+
+  // disable copy
+  FrameMemoryDelegate(const FrameMemoryDelegate&) = delete;
+  FrameMemoryDelegate& operator=(const FrameMemoryDelegate&) = delete;
+
+  // v8::MeasureMemoryDelegate:
+  bool ShouldMeasure(v8::Local<v8::Context> context) override {
+    return blink::WebLocalFrame::FrameForContext(context) == frame_;
+  }
+
+  void MeasurementComplete(Result result) override {
+    auto usage = mojom::FrameMemoryUsage::New();
+    for (size_t i = 0; i < result.contexts.size(); ++i) {
+      v8::Local<v8::Context> context = result.contexts[i];
+      const uint64_t size = result.sizes_in_bytes[i];
+      if (node::Environment::GetCurrent(context))
+        usage->node += size;
+      else if (context == main_world_.Get(context->GetIsolate()))
+        usage->main_world += size;
+      else
+        usage->isolated_worlds += size;
+    }
+    std::move(callback_).Run(std::move(usage));
+  }
+
+ private:
+  // Only used by ShouldMeasure(), which is called by Isolate::MeasureMemory()
+  // before it returns.
+  raw_ptr<blink::WebLocalFrame> frame_;
+  v8::Global<v8::Context> main_world_;
+  mojom::ElectronRenderer::MeasureMemoryCallback callback_;
+};
+
 void EmitIPCEvent(v8::Local<v8::Context> context,
                   bool internal,
                   const std::string& channel,
@@ -203,8 +250,6 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   if (!frame)
     return;
 
-  ScopedAllowBlockingForElectron allow_blocking;
-
   base::ScopedPlatformFile platform_file;
   if (mojo::UnwrapPlatformFile(std::move(file), &platform_file) !=
       MOJO_RESULT_OK) {
@@ -214,10 +259,27 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   }
   base::File base_file(std::move(platform_file));
 
+  // The snapshot is written in the background, so that the renderer only
+  // hangs while it is being taken and serialized.
   v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
-  bool success = electron::TakeHeapSnapshot(isolate, &base_file);
+  electron::TakeHeapSnapshot(isolate, std::move(base_file),
+                             std::move(callback));
+}
+
+void ElectronApiServiceImpl::MeasureMemory(MeasureMemoryCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (!frame) {
+    std::move(callback).Run(mojom::FrameMemoryUsage::New());
+    return;
+  }
 
-  std::move(callback).Run(success);
+  v8::Isolate* isolate = frame->GetAgentGroupScheduler()->Isolate();
+  v8::HandleScope handle_scope(isolate);
+  // Measured right away, rather than with the next garbage collection.
+  isolate->MeasureMemory(
+      std::make_unique<FrameMemoryDelegate>(isolate, frame,
+                                            std::move(callback)),
+      v8::MeasureMemoryExecution::kEager);
 }
 
 }  // namespace electron
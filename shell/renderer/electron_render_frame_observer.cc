@@ -4,10 +4,12 @@
 
 #include "shell/renderer/electron_render_frame_observer.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/functional/bind.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
@@ -24,6 +26,7 @@
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/platform/scheduler/web_agent_group_scheduler.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/platform/web_isolated_world_info.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -154,6 +157,20 @@ void ElectronRenderFrameObserver::DidInstallConditionalFeatures(
 }
 
 void ElectronRenderFrameObserver::DraggableRegionsChanged() {
+  // Blink can report the regions several times per frame when the page forces
+  // layouts, only the last ones are sent.
+  if (draggable_regions_update_pending_)
+    return;
+  draggable_regions_update_pending_ = true;
+  render_frame_->GetTaskRunner(blink::TaskType::kInternalDefault)
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(
+                     &ElectronRenderFrameObserver::SendDraggableRegions,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ElectronRenderFrameObserver::SendDraggableRegions() {
+  draggable_regions_update_pending_ = false;
   blink::WebVector<blink::WebDraggableRegion> webregions =
       render_frame_->GetWebFrame()->GetDocument().DraggableRegions();
   std::vector<mojom::DraggableRegionPtr> regions;
@@ -165,6 +182,18 @@ void ElectronRenderFrameObserver::DraggableRegionsChanged() {
     regions.push_back(std::move(region));
   }
 
+  // Most layouts don't move the regions, which then needn't be rebuilt by the
+  // browser.
+  if (draggable_regions_ &&
+      std::equal(regions.begin(), regions.end(), draggable_regions_->begin(),
+                 draggable_regions_->end(),
+                 [](const auto& a, const auto& b) { return a->Equals(*b); })) {
+    return;
+  }
+  draggable_regions_.emplace();
+  for (const auto& region : regions)
+    draggable_regions_->push_back(region.Clone());
+
   mojo::AssociatedRemote<mojom::ElectronWebContentsUtility>
       web_contents_utility_remote;
   render_frame_->GetRemoteAssociatedInterfaces()->GetInterface(
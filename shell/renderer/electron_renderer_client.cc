@@ -4,13 +4,21 @@
 
 #include "shell/renderer/electron_renderer_client.h"
 
+#include <optional>
+#include <tuple>
+#include <utility>
+
 #include "base/command_line.h"
 #include "base/containers/contains.h"
 #include "base/debug/stack_trace.h"
+#include "base/functional/bind.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
+#include "electron/fuses.h"
+#include "gin/converter.h"
 #include "net/http/http_request_headers.h"
 #include "shell/common/api/electron_bindings.h"
+#include "shell/common/bootstrap_code_cache.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_bindings.h"
@@ -26,6 +34,17 @@
 
 namespace electron {
 
+namespace {
+
+// The globals that Node.js and the renderer init script define on the window,
+// reading or writing any of them creates the environment in lazy mode.
+constexpr const char* kLazyNodeGlobals[] = {
+    "require",      "module",         "process",    "Buffer",    "global",
+    "setImmediate", "clearImmediate", "__filename", "__dirname",
+};
+
+}  // namespace
+
 ElectronRendererClient::ElectronRendererClient()
     : node_bindings_{NodeBindings::Create(
           NodeBindings::BrowserEnvironment::kRenderer)},
@@ -34,6 +53,16 @@ ElectronRendererClient::ElectronRendererClient()
 
 ElectronRendererClient::~ElectronRendererClient() = default;
 
+void ElectronRendererClient::RenderThreadStarted() {
+  RendererClientBase::RenderThreadStarted();
+  // Created once the thread pool runs, which prefetches the file. Renderers
+  // use their own file since they compile a different set of modules.
+  if (electron::fuses::IsBootstrapCodeCacheEnabled()) {
+    bootstrap_code_cache_ = std::make_unique<BootstrapCodeCache>(
+        FILE_PATH_LITERAL("bootstrap-renderer"));
+  }
+}
+
 void ElectronRendererClient::RenderFrameCreated(
     content::RenderFrame* render_frame) {
   new ElectronRenderFrameObserver(render_frame, this);
@@ -82,6 +111,18 @@ void ElectronRendererClient::DidCreateScriptContext(
   if (!ShouldLoadPreload(renderer_context, render_frame))
     return;
 
+  if (render_frame->GetBlinkPreferences().lazy_node_integration) {
+    InstallLazyNodeGlobals(renderer_context);
+    return;
+  }
+
+  CreateNodeEnvironment(renderer_context, render_frame, /*defer_load=*/true);
+}
+
+void ElectronRendererClient::CreateNodeEnvironment(
+    v8::Handle<v8::Context> renderer_context,
+    content::RenderFrame* render_frame,
+    bool defer_load) {
   injected_frames_.insert(render_frame);
 
   if (!node_integration_initialized_) {
@@ -98,17 +139,21 @@ void ElectronRendererClient::DidCreateScriptContext(
   v8::Maybe<bool> initialized = node::InitializeContext(renderer_context);
   CHECK(!initialized.IsNothing() && initialized.FromJust());
 
-  // Before we load the node environment, let's tell blink to hold off on
-  // loading the body of this frame.  We will undefer the load once the preload
-  // script has finished.  This allows our preload script to run async (E.g.
-  // with ESM) without the preload being in a race
-  render_frame->GetWebFrame()->GetDocumentLoader()->SetDefersLoading(
-      blink::LoaderFreezeMode::kStrict);
+  std::optional<base::RepeatingCallback<void()>> on_app_code_ready;
+  if (defer_load) {
+    // Before we load the node environment, let's tell blink to hold off on
+    // loading the body of this frame.  We will undefer the load once the
+    // preload script has finished.  This allows our preload script to run
+    // async (E.g. with ESM) without the preload being in a race
+    render_frame->GetWebFrame()->GetDocumentLoader()->SetDefersLoading(
+        blink::LoaderFreezeMode::kStrict);
+    on_app_code_ready =
+        base::BindRepeating(&ElectronRendererClient::UndeferLoad,
+                            base::Unretained(this), render_frame);
+  }
 
   std::shared_ptr<node::Environment> env = node_bindings_->CreateEnvironment(
-      renderer_context, nullptr,
-      base::BindRepeating(&ElectronRendererClient::UndeferLoad,
-                          base::Unretained(this), render_frame));
+      renderer_context, nullptr, std::move(on_app_code_ready));
 
   // If we have disabled the site instance overrides we should prevent loading
   // any non-context aware native module.
@@ -125,7 +170,11 @@ void ElectronRendererClient::DidCreateScriptContext(
   BindProcess(env->isolate(), &process_dict, render_frame);
 
   // Load everything.
+  if (bootstrap_code_cache_)
+    bootstrap_code_cache_->Load(env.get());
   node_bindings_->LoadEnvironment(env.get());
+  if (bootstrap_code_cache_)
+    bootstrap_code_cache_->Save(env.get());
 
   if (node_bindings_->uv_env() == nullptr) {
     // Make uv loop being wrapped by window context.
@@ -136,6 +185,66 @@ void ElectronRendererClient::DidCreateScriptContext(
   }
 }
 
+void ElectronRendererClient::InstallLazyNodeGlobals(
+    v8::Handle<v8::Context> context) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Object> global = context->Global();
+  for (const char* name : kLazyNodeGlobals) {
+    v8::Local<v8::String> key = gin::StringToV8(isolate, name);
+    v8::Local<v8::Function> getter =
+        v8::Function::New(context, &LazyNodeGlobalGetter, key).ToLocalChecked();
+    v8::Local<v8::Function> setter =
+        v8::Function::New(context, &LazyNodeGlobalSetter, key).ToLocalChecked();
+    global->SetAccessorProperty(key, getter, setter, v8::DontEnum);
+  }
+}
+
+// static
+bool ElectronRendererClient::CreateLazyNodeEnvironment(
+    v8::Local<v8::Object> receiver,
+    v8::Local<v8::Context>* context) {
+  // The accessors may be reached from another frame, so the environment is
+  // created for the context of the global they were installed on.
+  if (!receiver->GetCreationContext().ToLocal(context))
+    return false;
+  auto* web_frame = blink::WebLocalFrame::FrameForContext(*context);
+  auto* render_frame =
+      web_frame ? content::RenderFrame::FromWebFrame(web_frame) : nullptr;
+  if (!render_frame)
+    return false;
+
+  v8::Isolate* isolate = (*context)->GetIsolate();
+  v8::Local<v8::Object> global = (*context)->Global();
+  for (const char* name : kLazyNodeGlobals)
+    global->Delete(*context, gin::StringToV8(isolate, name)).Check();
+
+  v8::Context::Scope context_scope(*context);
+  auto* client =
+      static_cast<ElectronRendererClient*>(RendererClientBase::Get());
+  client->CreateNodeEnvironment(*context, render_frame, /*defer_load=*/false);
+  return true;
+}
+
+// static
+void ElectronRendererClient::LazyNodeGlobalGetter(
+    const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Local<v8::Context> context;
+  if (!CreateLazyNodeEnvironment(info.This(), &context))
+    return;
+  v8::Local<v8::Value> value;
+  if (context->Global()->Get(context, info.Data()).ToLocal(&value))
+    info.GetReturnValue().Set(value);
+}
+
+// static
+void ElectronRendererClient::LazyNodeGlobalSetter(
+    const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Local<v8::Context> context;
+  if (!CreateLazyNodeEnvironment(info.This(), &context))
+    return;
+  std::ignore = context->Global()->Set(context, info.Data(), info[0]);
+}
+
 void ElectronRendererClient::WillReleaseScriptContext(
     v8::Handle<v8::Context> context,
     content::RenderFrame* render_frame) {
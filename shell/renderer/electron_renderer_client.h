@@ -16,6 +16,7 @@ class Environment;
 
 namespace electron {
 
+class BootstrapCodeCache;
 class ElectronBindings;
 class NodeBindings;
 
@@ -37,7 +38,22 @@ class ElectronRendererClient : public RendererClientBase {
  private:
   void UndeferLoad(content::RenderFrame* render_frame);
 
+  void CreateNodeEnvironment(v8::Handle<v8::Context> context,
+                             content::RenderFrame* render_frame,
+                             bool defer_load);
+
+  // With the lazyNodeIntegration preference, the environment is only created
+  // once the page reads or writes one of the Node.js globals.
+  void InstallLazyNodeGlobals(v8::Handle<v8::Context> context);
+  static bool CreateLazyNodeEnvironment(v8::Local<v8::Object> receiver,
+                                        v8::Local<v8::Context>* context);
+  static void LazyNodeGlobalGetter(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void LazyNodeGlobalSetter(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+
   // content::ContentRendererClient:
+  void RenderThreadStarted() override;
   void RenderFrameCreated(content::RenderFrame*) override;
   void RunScriptsAtDocumentStart(content::RenderFrame* render_frame) override;
   void RunScriptsAtDocumentEnd(content::RenderFrame* render_frame) override;
@@ -54,6 +70,10 @@ class ElectronRendererClient : public RendererClientBase {
   const std::unique_ptr<NodeBindings> node_bindings_;
   const std::unique_ptr<ElectronBindings> electron_bindings_;
 
+  // Only set with the bootstrapCodeCache fuse. Shared by the environments of
+  // all frames, which refer to its data.
+  std::unique_ptr<BootstrapCodeCache> bootstrap_code_cache_;
+
   // The node::Environment::GetCurrent API does not return nullptr when it
   // is called for a context without node::Environment, so we have to keep
   // a book of the environments created.
@@ -4,7 +4,9 @@
 
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -83,14 +85,51 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
   return exports;
 }
 
+// Compiles the wrapper of a preload script with |code_cache|, the code cache
+// that an earlier renderer of the session produced for the same source. When
+// there is none or V8 rejects it, a new code cache is returned along with the
+// preload function.
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> source) {
+                                         v8::Local<v8::String> source,
+                                         v8::Local<v8::Value> code_cache) {
   auto context = isolate->GetCurrentContext();
-  auto maybe_script = v8::Script::Compile(context, source);
+  v8::ScriptCompiler::CachedData* cached_data = nullptr;
+  if (code_cache->IsArrayBufferView()) {
+    auto view = code_cache.As<v8::ArrayBufferView>();
+    // The buffer is not copied and outlives the compilation.
+    cached_data = new v8::ScriptCompiler::CachedData(
+        static_cast<const uint8_t*>(view->Buffer()->Data()) +
+            view->ByteOffset(),
+        view->ByteLength());
+  }
+  // Takes the ownership of |cached_data|.
+  v8::ScriptCompiler::Source script_source(source, cached_data);
   v8::Local<v8::Script> script;
-  if (!maybe_script.ToLocal(&script))
+  if (!v8::ScriptCompiler::Compile(context, &script_source,
+                                   cached_data
+                                       ? v8::ScriptCompiler::kConsumeCodeCache
+                                       : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&script))
+    return v8::Local<v8::Value>();
+
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+  if (!cached_data || cached_data->rejected) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> new_cache(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (new_cache) {
+      auto buffer = v8::ArrayBuffer::New(isolate, new_cache->length);
+      memcpy(buffer->Data(), new_cache->data, new_cache->length);
+      v8::Local<v8::Value> view =
+          v8::Uint8Array::New(buffer, 0, new_cache->length);
+      result.Set("codeCache", view);
+    }
+  }
+
+  v8::Local<v8::Value> preload_fn;
+  if (!script->Run(context).ToLocal(&preload_fn))
     return v8::Local<v8::Value>();
-  return script->Run(context).ToLocalChecked();
+  result.Set("preloadFn", preload_fn);
+  return result.GetHandle();
 }
 
 double Uptime() {
@@ -0,0 +1,121 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/renderer/renderer_diagnostics.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/pending_task.h"
+#include "base/task/common/task_annotator.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/common/javascript_stack.h"
+#include "v8/include/v8-isolate.h"
+
+namespace electron {
+
+namespace {
+
+// How long the IO thread waits for the main thread before it answers without
+// a stack, the main thread may be blocked outside of JavaScript.
+constexpr base::TimeDelta kCallStackTimeout = base::Seconds(2);
+
+// Shared between the IO thread and the main thread, whichever answers first
+// reports the result.
+class CallStackRequest : public base::RefCountedThreadSafe<CallStackRequest> {
+ public:
+  using Callback =
+      mojom::ElectronRendererDiagnostics::CollectJavaScriptCallStackCallback;
+
+  explicit CallStackRequest(Callback callback)
+      : callback_(std::move(callback)),
+        reply_task_runner_(base::SequencedTaskRunner::GetCurrentDefault()) {}
+
+  // disable copy
+  CallStackRequest(const CallStackRequest&) = delete;
+  CallStackRequest& operator=(const CallStackRequest&) = delete;
+
+  // Called on any thread.
+  void Report(std::string stack, std::string posted_from) {
+    if (reported_.exchange(true))
+      return;
+    reply_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback_), std::move(stack),
+                                  std::move(posted_from)));
+  }
+
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    auto* request = static_cast<CallStackRequest*>(data);
+    // The interrupt stays pending while the thread doesn't run JavaScript,
+    // by then the request may have been answered already.
+    if (request->reported_.load()) {
+      request->Release();
+      return;
+    }
+    // The task that is running is the one that keeps the thread busy.
+    std::string posted_from;
+    if (const base::PendingTask* task =
+            base::TaskAnnotator::CurrentTaskForThread())
+      posted_from = task->posted_from.ToString();
+    request->Report(CaptureJavaScriptStack(isolate), std::move(posted_from));
+    request->Release();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<CallStackRequest>;
+  ~CallStackRequest() = default;
+
+  Callback callback_;
+  scoped_refptr<base::SequencedTaskRunner> reply_task_runner_;
+  std::atomic<bool> reported_{false};
+};
+
+}  // namespace
+
+// static
+void RendererDiagnostics::Create(
+    v8::Isolate* isolate,
+    scoped_refptr<base::SingleThreadTaskRunner> main_task_runner,
+    mojo::PendingReceiver<mojom::ElectronRendererDiagnostics> receiver) {
+  mojo::MakeSelfOwnedReceiver(std::make_unique<RendererDiagnostics>(
+                                  isolate, std::move(main_task_runner)),
+                              std::move(receiver));
+}
+
+RendererDiagnostics::RendererDiagnostics(
+    v8::Isolate* isolate,
+    scoped_refptr<base::SingleThreadTaskRunner> main_task_runner)
+    : isolate_(isolate), main_task_runner_(std::move(main_task_runner)) {}
+
+RendererDiagnostics::~RendererDiagnostics() = default;
+
+void RendererDiagnostics::CollectJavaScriptCallStack(
+    CollectJavaScriptCallStackCallback callback) {
+  auto request = base::MakeRefCounted<CallStackRequest>(std::move(callback));
+
+  // Runs the next time the main thread checks for interrupts while it runs
+  // JavaScript, which is what makes a page unresponsive in most cases.
+  request->AddRef();
+  isolate_->RequestInterrupt(&CallStackRequest::OnInterrupt, request.get());
+
+  // Runs when the main thread is idle, or once it didn't run JavaScript.
+  main_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&CallStackRequest::Report, request,
+                                std::string(), std::string()));
+
+  base::SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&CallStackRequest::Report, request, std::string(),
+                     std::string()),
+      kCallStackTimeout);
+}
+
+}  // namespace electron
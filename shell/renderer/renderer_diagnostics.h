@@ -0,0 +1,53 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_RENDERER_RENDERER_DIAGNOSTICS_H_
+#define ELECTRON_SHELL_RENDERER_RENDERER_DIAGNOSTICS_H_
+
+#include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}  // namespace base
+
+namespace v8 {
+class Isolate;
+}  // namespace v8
+
+namespace electron {
+
+// Lives on the IO thread of the renderer process, so that it can look into
+// the main thread while that thread is too busy to answer itself.
+class RendererDiagnostics : public mojom::ElectronRendererDiagnostics {
+ public:
+  // Called on the IO thread, |isolate| is the isolate of the main thread.
+  static void Create(
+      v8::Isolate* isolate,
+      scoped_refptr<base::SingleThreadTaskRunner> main_task_runner,
+      mojo::PendingReceiver<mojom::ElectronRendererDiagnostics> receiver);
+
+  RendererDiagnostics(
+      v8::Isolate* isolate,
+      scoped_refptr<base::SingleThreadTaskRunner> main_task_runner);
+  ~RendererDiagnostics() override;
+
+  // disable copy
+  RendererDiagnostics(const RendererDiagnostics&) = delete;
+  RendererDiagnostics& operator=(const RendererDiagnostics&) = delete;
+
+  // mojom::ElectronRendererDiagnostics:
+  void CollectJavaScriptCallStack(
+      CollectJavaScriptCallStackCallback callback) override;
+
+ private:
+  const raw_ptr<v8::Isolate> isolate_;
+  scoped_refptr<base::SingleThreadTaskRunner> main_task_runner_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_RENDERER_RENDERER_DIAGNOSTICS_H_
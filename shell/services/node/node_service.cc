@@ -14,6 +14,7 @@
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/api/electron_bindings.h"
+#include "shell/common/cpu_profiler.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_bindings.h"
@@ -68,8 +69,19 @@ NodeService::~NodeService() {
   }
 }
 
+void NodeService::Prewarm() {
+  if (js_env_)
+    return;
+
+  js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+
+  v8::HandleScope scope(js_env_->isolate());
+
+  node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
+}
+
 void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
-  if (NodeBindings::IsInitialized())
+  if (node_env_)
     return;
 
   ParentPort::GetInstance()->Initialize(std::move(params->port));
@@ -78,12 +90,11 @@ void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
       std::move(params->url_loader_factory),
       mojo::Remote(std::move(params->host_resolver)));
 
-  js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+  // Does nothing if the process was prewarmed.
+  Prewarm();
 
   v8::HandleScope scope(js_env_->isolate());
 
-  node_bindings_->Initialize(js_env_->isolate()->GetCurrentContext());
-
   // Append program path for process.argv0
   auto program = base::CommandLine::ForCurrentProcess()->GetProgram();
 #if defined(OS_WIN)
@@ -137,4 +148,43 @@ void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
   node_bindings_->StartPolling();
 }
 
+void NodeService::StartCpuProfiling(base::TimeDelta sampling_interval,
+                                    StartCpuProfilingCallback callback) {
+  if (!js_env_ || node_env_stopped_) {
+    std::move(callback).Run(false);
+    return;
+  }
+  if (!cpu_profiler_)
+    cpu_profiler_ = std::make_unique<CpuProfiler>(js_env_->isolate());
+  std::move(callback).Run(cpu_profiler_->Start(sampling_interval));
+}
+
+void NodeService::StopCpuProfiling(base::File file,
+                                   StopCpuProfilingCallback callback) {
+  if (!cpu_profiler_ || !cpu_profiler_->is_profiling()) {
+    std::move(callback).Run(false);
+    return;
+  }
+  cpu_profiler_->Stop(std::move(file), std::move(callback));
+}
+
+void NodeService::ShareBuffer(
+    const std::string& name,
+    base::UnsafeSharedMemoryRegion region,
+    mojo::PendingRemote<node::mojom::SharedBufferPeer> parent,
+    mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver) {
+  if (!js_env_ || node_env_stopped_)
+    return;
+  ParentPort::GetInstance()->EmitSharedBuffer(
+      name, std::move(region), std::move(parent), std::move(receiver));
+}
+
+void NodeService::HandleProtocol(
+    const std::string& scheme,
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory) {
+  if (!js_env_ || node_env_stopped_)
+    return;
+  ParentPort::GetInstance()->BindProtocolFactory(scheme, std::move(factory));
+}
+
 }  // namespace electron
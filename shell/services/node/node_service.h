@@ -6,6 +6,7 @@
 #define ELECTRON_SHELL_SERVICES_NODE_NODE_SERVICE_H_
 
 #include <memory>
+#include <string>
 
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -24,6 +25,7 @@ class Environment;
 
 namespace electron {
 
+class CpuProfiler;
 class ElectronBindings;
 class JavascriptEnvironment;
 class NodeBindings;
@@ -58,7 +60,20 @@ class NodeService : public node::mojom::NodeService {
   NodeService& operator=(const NodeService&) = delete;
 
   // mojom::NodeService implementation:
+  void Prewarm() override;
   void Initialize(node::mojom::NodeServiceParamsPtr params) override;
+  void StartCpuProfiling(base::TimeDelta sampling_interval,
+                         StartCpuProfilingCallback callback) override;
+  void StopCpuProfiling(base::File file,
+                        StopCpuProfilingCallback callback) override;
+  void ShareBuffer(
+      const std::string& name,
+      base::UnsafeSharedMemoryRegion region,
+      mojo::PendingRemote<node::mojom::SharedBufferPeer> parent,
+      mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver) override;
+  void HandleProtocol(
+      const std::string& scheme,
+      mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory) override;
 
  private:
   // This needs to be initialized first so that it can be destroyed last
@@ -79,6 +94,9 @@ class NodeService : public node::mojom::NodeService {
 
   // depends-on: js_env_'s isolate
   std::shared_ptr<node::Environment> node_env_;
+
+  // depends-on: js_env_'s isolate
+  std::unique_ptr<CpuProfiler> cpu_profiler_;
 };
 
 }  // namespace electron
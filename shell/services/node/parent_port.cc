@@ -5,19 +5,45 @@
 #include "shell/services/node/parent_port.h"
 
 #include <utility>
+#include <vector>
 
+#include "base/functional/bind.h"
 #include "base/no_destructor.h"
+#include "base/task/single_thread_task_runner.h"
+#include "gin/arguments.h"
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/v8_value_serializer.h"
+#include "shell/services/node/shared_buffer.h"
 #include "third_party/blink/public/common/messaging/transferable_message_mojom_traits.h"
 
 namespace electron {
 
+namespace {
+
+v8::Local<v8::Object> CreateMessageEvent(v8::Isolate* isolate,
+                                         blink::TransferableMessage message) {
+  auto wrapped_ports =
+      MessagePort::EntanglePorts(isolate, std::move(message.ports));
+  v8::Local<v8::Value> message_value =
+      electron::DeserializeV8Value(isolate, message);
+  return gin::DataObjectBuilder(isolate)
+      .Set("data", message_value)
+      .Set("ports", wrapped_ports)
+      .Build();
+}
+
+}  // namespace
+
 gin::WrapperInfo ParentPort::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 ParentPort* ParentPort::GetInstance() {
@@ -40,16 +66,39 @@ void ParentPort::Initialize(blink::MessagePortDescriptor port) {
       base::BindOnce(&ParentPort::Close, base::Unretained(this)));
 }
 
-void ParentPort::PostMessage(v8::Local<v8::Value> message_value) {
-  if (!connector_closed_ && connector_ && connector_->is_valid()) {
-    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-    blink::TransferableMessage transferable_message;
-    electron::SerializeV8Value(isolate, message_value, &transferable_message);
-    mojo::Message mojo_message =
-        blink::mojom::TransferableMessage::WrapAsMessage(
-            std::move(transferable_message));
-    connector_->Accept(&mojo_message);
+void ParentPort::PostMessage(gin::Arguments* args) {
+  if (connector_closed_ || !connector_ || !connector_->is_valid())
+    return;
+
+  v8::Isolate* isolate = args->isolate();
+  v8::Local<v8::Value> message_value = v8::Undefined(isolate);
+  args->GetNext(&message_value);
+
+  v8::Local<v8::Value> transferables;
+  std::vector<gin::Handle<MessagePort>> wrapped_ports;
+  std::vector<v8::Local<v8::ArrayBuffer>> array_buffers;
+  if (args->GetNext(&transferables)) {
+    if (!MessagePort::GetTransferables(isolate, transferables, &wrapped_ports,
+                                       &array_buffers)) {
+      return;
+    }
+    // The parent only reads the data of the messages of this port.
+    if (!wrapped_ports.empty()) {
+      gin_helper::ErrorThrower(isolate).ThrowTypeError(
+          "parentPort can only transfer ArrayBuffers");
+      return;
+    }
+  }
+
+  blink::TransferableMessage transferable_message;
+  if (!electron::SerializeV8Value(isolate, message_value, array_buffers,
+                                  &transferable_message)) {
+    // SerializeV8Value sets an exception.
+    return;
   }
+  mojo::Message mojo_message = blink::mojom::TransferableMessage::WrapAsMessage(
+      std::move(transferable_message));
+  connector_->Accept(&mojo_message);
 }
 
 void ParentPort::Close() {
@@ -73,6 +122,10 @@ void ParentPort::Pause() {
   }
 }
 
+void ParentPort::SetBatching(bool batching) {
+  batching_ = batching;
+}
+
 bool ParentPort::Accept(mojo::Message* mojo_message) {
   blink::TransferableMessage message;
   if (!blink::mojom::TransferableMessage::DeserializeFromMessage(
@@ -80,21 +133,112 @@ bool ParentPort::Accept(mojo::Message* mojo_message) {
     return false;
   }
 
+  if (batching_) {
+    // The connector reads all the messages that are available at once, they
+    // are delivered together after it's done.
+    pending_messages_.push_back(std::move(message));
+    if (pending_messages_.size() == 1) {
+      base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+          FROM_HERE, base::BindOnce(&ParentPort::DeliverPendingMessages,
+                                    base::Unretained(this)));
+    }
+    return true;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  auto wrapped_ports =
-      MessagePort::EntanglePorts(isolate, std::move(message.ports));
-  v8::Local<v8::Value> message_value =
-      electron::DeserializeV8Value(isolate, message);
   v8::Local<v8::Object> self;
   if (!GetWrapper(isolate).ToLocal(&self))
     return false;
+  gin_helper::EmitEvent(isolate, self, "message",
+                        CreateMessageEvent(isolate, std::move(message)));
+  return true;
+}
+
+void ParentPort::DeliverPendingMessages() {
+  std::vector<blink::TransferableMessage> messages;
+  messages.swap(pending_messages_);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate).ToLocal(&self))
+    return;
+
+  // Batching was turned off after the messages were queued.
+  if (!batching_) {
+    for (auto& message : messages) {
+      gin_helper::EmitEvent(isolate, self, "message",
+                            CreateMessageEvent(isolate, std::move(message)));
+    }
+    return;
+  }
+
+  // A single call into JavaScript, with a single microtask checkpoint, for
+  // all the messages.
+  std::vector<v8::Local<v8::Value>> events;
+  events.reserve(messages.size());
+  for (auto& message : messages)
+    events.push_back(CreateMessageEvent(isolate, std::move(message)));
+  gin_helper::EmitEvent(isolate, self, "messages",
+                        v8::Array::New(isolate, events.data(), events.size()));
+}
+
+void ParentPort::EmitSharedBuffer(
+    const std::string& name,
+    base::UnsafeSharedMemoryRegion region,
+    mojo::PendingRemote<node::mojom::SharedBufferPeer> parent,
+    mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate).ToLocal(&self))
+    return;
+  gin::Handle<SharedBuffer> buffer =
+      SharedBuffer::Create(isolate, std::move(region), /*is_parent=*/false,
+                           std::move(parent), std::move(receiver));
+  if (buffer.IsEmpty())
+    return;
   auto event = gin::DataObjectBuilder(isolate)
-                   .Set("data", message_value)
-                   .Set("ports", wrapped_ports)
+                   .Set("name", name)
+                   .Set("buffer", buffer)
                    .Build();
-  gin_helper::EmitEvent(isolate, self, "message", event);
-  return true;
+  gin_helper::EmitEvent(isolate, self, "shared-buffer", event);
+}
+
+void ParentPort::BindProtocolFactory(
+    const std::string& scheme,
+    mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory) {
+  auto handler = protocol_handlers_.find(scheme);
+  if (handler == protocol_handlers_.end()) {
+    pending_protocol_factories_[scheme].push_back(std::move(factory));
+    return;
+  }
+  // The factory deletes itself once the parent drops its end.
+  mojo::Remote<network::mojom::URLLoaderFactory> remote(
+      ElectronURLLoaderFactory::Create(ProtocolType::kFree, handler->second));
+  remote->Clone(std::move(factory));
+}
+
+void ParentPort::HandleProtocol(gin::Arguments* args) {
+  std::string scheme;
+  ProtocolHandler handler;
+  if (!args->GetNext(&scheme) || !args->GetNext(&handler)) {
+    args->ThrowTypeError("Expected a scheme and a handler");
+    return;
+  }
+  if (!protocol_handlers_.try_emplace(scheme, std::move(handler)).second) {
+    gin_helper::ErrorThrower(args->isolate())
+        .ThrowError("The scheme is already handled");
+    return;
+  }
+  auto pending = pending_protocol_factories_.find(scheme);
+  if (pending == pending_protocol_factories_.end())
+    return;
+  auto factories = std::move(pending->second);
+  pending_protocol_factories_.erase(pending);
+  for (auto& factory : factories)
+    BindProtocolFactory(scheme, std::move(factory));
 }
 
 // static
@@ -108,7 +252,9 @@ gin::ObjectTemplateBuilder ParentPort::GetObjectTemplateBuilder(
   return gin::Wrappable<ParentPort>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &ParentPort::PostMessage)
       .SetMethod("start", &ParentPort::Start)
-      .SetMethod("pause", &ParentPort::Pause);
+      .SetMethod("pause", &ParentPort::Pause)
+      .SetMethod("setBatching", &ParentPort::SetBatching)
+      .SetMethod("handleProtocol", &ParentPort::HandleProtocol);
 }
 
 const char* ParentPort::GetTypeName() {
@@ -6,11 +6,25 @@
 #define ELECTRON_SHELL_SERVICES_NODE_PARENT_PORT_H_
 
 #include <memory>
+#include <string>
+#include <vector>
+#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "services/network/public/mojom/url_loader_factory.mojom-forward.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/net/electron_url_loader_factory.h"
+#include "shell/services/node/public/mojom/node_service.mojom-forward.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
+
+namespace base {
+class UnsafeSharedMemoryRegion;
+}
 
 namespace v8 {
 template <class T>
@@ -43,6 +57,19 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   ~ParentPort() override;
   void Initialize(blink::MessagePortDescriptor port);
 
+  // Emits the 'shared-buffer' event with the utility end of a SharedBuffer.
+  void EmitSharedBuffer(
+      const std::string& name,
+      base::UnsafeSharedMemoryRegion region,
+      mojo::PendingRemote<node::mojom::SharedBufferPeer> parent,
+      mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver);
+
+  // Binds a factory of the parent for |scheme| to the handler of the scheme,
+  // or keeps it until the process sets one.
+  void BindProtocolFactory(
+      const std::string& scheme,
+      mojo::PendingReceiver<network::mojom::URLLoaderFactory> factory);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -50,17 +77,32 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   const char* GetTypeName() override;
 
  private:
-  void PostMessage(v8::Local<v8::Value> message_value);
+  void PostMessage(gin::Arguments* args);
   void Close();
   void Start();
   void Pause();
+  // Delivers the messages in 'messages' events with all those available,
+  // instead of a 'message' event each.
+  void SetBatching(bool batching);
+  void DeliverPendingMessages();
+  void HandleProtocol(gin::Arguments* args);
 
   // mojo::MessageReceiver
   bool Accept(mojo::Message* mojo_message) override;
 
+  bool batching_ = false;
+  std::vector<blink::TransferableMessage> pending_messages_;
   bool connector_closed_ = false;
   std::unique_ptr<mojo::Connector> connector_;
   blink::MessagePortDescriptor port_;
+
+  // scheme => handler set with handleProtocol().
+  base::flat_map<std::string, ProtocolHandler> protocol_handlers_;
+  // scheme => factories of the parent waiting for a handler.
+  base::flat_map<
+      std::string,
+      std::vector<mojo::PendingReceiver<network::mojom::URLLoaderFactory>>>
+      pending_protocol_factories_;
 };
 
 }  // namespace electron
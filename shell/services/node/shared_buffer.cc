@@ -0,0 +1,273 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/services/node/shared_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "gin/arguments.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_helper/event_emitter_caller.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+// The state of a ring, which is only written by the end that owns each field.
+struct alignas(64) SharedBuffer::RingHeader {
+  // Owned by the writer, the number of bytes ever written.
+  std::atomic<uint64_t> write_pos;
+  // Owned by the reader, the number of bytes ever read.
+  std::atomic<uint64_t> read_pos;
+  // Set by the reader when it found the ring empty, cleared by the writer
+  // that wakes it up.
+  std::atomic<uint32_t> reader_waiting;
+  // Set by the writer when it found the ring full, cleared by the reader
+  // that wakes it up.
+  std::atomic<uint32_t> writer_waiting;
+};
+
+namespace {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "The rings are shared with another process");
+
+// Each record is its size followed by its bytes.
+using RecordSize = uint32_t;
+
+// The memory holds the headers of the rings followed by the rings, the ring
+// the parent writes to coming first:
+//   [parent header][utility header][parent ring][utility ring]
+constexpr size_t kHeadersSize = 2 * 64;
+
+void CopyToRing(base::span<uint8_t> ring,
+                uint64_t pos,
+                base::span<const uint8_t> data) {
+  const size_t offset = pos % ring.size();
+  const size_t first = std::min(data.size(), ring.size() - offset);
+  std::memcpy(ring.data() + offset, data.data(), first);
+  std::memcpy(ring.data(), data.data() + first, data.size() - first);
+}
+
+void CopyFromRing(base::span<const uint8_t> ring,
+                  uint64_t pos,
+                  base::span<uint8_t> data) {
+  const size_t offset = pos % ring.size();
+  const size_t first = std::min(data.size(), ring.size() - offset);
+  std::memcpy(data.data(), ring.data() + offset, first);
+  std::memcpy(data.data() + first, ring.data(), data.size() - first);
+}
+
+}  // namespace
+
+gin::WrapperInfo SharedBuffer::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+// static
+base::UnsafeSharedMemoryRegion SharedBuffer::CreateRegion(size_t capacity) {
+  static_assert(sizeof(RingHeader) * 2 == kHeadersSize);
+  if (capacity <= sizeof(RecordSize) ||
+      capacity > (std::numeric_limits<size_t>::max() - kHeadersSize) / 2) {
+    return {};
+  }
+  return base::UnsafeSharedMemoryRegion::Create(kHeadersSize + 2 * capacity);
+}
+
+// static
+gin::Handle<SharedBuffer> SharedBuffer::Create(
+    v8::Isolate* isolate,
+    base::UnsafeSharedMemoryRegion region,
+    bool is_parent,
+    mojo::PendingRemote<node::mojom::SharedBufferPeer> peer,
+    mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver) {
+  if (!region.IsValid() || region.GetSize() <= kHeadersSize ||
+      (region.GetSize() - kHeadersSize) % 2 != 0) {
+    return {};
+  }
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return {};
+  auto handle = gin::CreateHandle(
+      isolate, new SharedBuffer(std::move(mapping), is_parent, std::move(peer),
+                                std::move(receiver)));
+  // Kept alive until closed, since the other end can wake it up at any time.
+  handle->Pin(isolate);
+
+  // The other end may have written before this end was created, in which
+  // case it did not know it had to wake this end up.
+  handle->read_header_->reader_waiting.store(1);
+  if (handle->read_header_->write_pos.load() != 0) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&SharedBuffer::OnReadable,
+                                  handle->weak_factory_.GetWeakPtr()));
+  }
+  return handle;
+}
+
+SharedBuffer::SharedBuffer(
+    base::WritableSharedMemoryMapping mapping,
+    bool is_parent,
+    mojo::PendingRemote<node::mojom::SharedBufferPeer> peer,
+    mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver)
+    : mapping_(std::move(mapping)),
+      peer_(std::move(peer)),
+      receiver_(this, std::move(receiver)) {
+  base::span<uint8_t> memory = mapping_.GetMemoryAsSpan<uint8_t>();
+  const size_t capacity = (memory.size() - kHeadersSize) / 2;
+  auto* headers = reinterpret_cast<RingHeader*>(memory.data());
+  base::span<uint8_t> parent_ring = memory.subspan(kHeadersSize, capacity);
+  base::span<uint8_t> utility_ring =
+      memory.subspan(kHeadersSize + capacity, capacity);
+  write_header_ = is_parent ? &headers[0] : &headers[1];
+  read_header_ = is_parent ? &headers[1] : &headers[0];
+  write_ring_ = is_parent ? parent_ring : utility_ring;
+  read_ring_ = is_parent ? utility_ring : parent_ring;
+
+  peer_.set_disconnect_handler(
+      base::BindOnce(&SharedBuffer::Close, base::Unretained(this)));
+  receiver_.set_disconnect_handler(
+      base::BindOnce(&SharedBuffer::Close, base::Unretained(this)));
+}
+
+SharedBuffer::~SharedBuffer() = default;
+
+void SharedBuffer::OnReadable() {
+  Emit("readable");
+}
+
+void SharedBuffer::OnDrain() {
+  Emit("drain");
+}
+
+bool SharedBuffer::Write(gin::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value) || !value->IsArrayBufferView()) {
+    args->ThrowTypeError("data must be an ArrayBufferView");
+    return false;
+  }
+  auto view = value.As<v8::ArrayBufferView>();
+  const size_t size = view->ByteLength();
+  const uint64_t record_size = sizeof(RecordSize) + uint64_t{size};
+  if (record_size > capacity()) {
+    args->ThrowTypeError("data is larger than the capacity of the buffer");
+    return false;
+  }
+  if (closed_)
+    return false;
+
+  // The other end could have stored any read position, one that would make
+  // the ring look like it holds more than it can is treated as full.
+  auto free_space = [this] {
+    const uint64_t used = write_pos_ - write_header_->read_pos.load();
+    return used > capacity() ? 0 : capacity() - used;
+  };
+  if (free_space() < record_size) {
+    // Checks again after asking to be woken up, in case the reader made room
+    // in between and missed the request.
+    write_header_->writer_waiting.store(1);
+    if (free_space() < record_size)
+      return false;
+  }
+
+  const RecordSize header = static_cast<RecordSize>(size);
+  CopyToRing(write_ring_, write_pos_,
+             base::as_bytes(base::make_span(&header, 1u)));
+  auto backing_store = view->Buffer()->GetBackingStore();
+  const auto* data =
+      static_cast<const uint8_t*>(backing_store->Data()) + view->ByteOffset();
+  CopyToRing(write_ring_, write_pos_ + sizeof(RecordSize),
+             base::make_span(data, size));
+  write_pos_ += record_size;
+  write_header_->write_pos.store(write_pos_);
+
+  if (write_header_->reader_waiting.exchange(0) != 0)
+    peer_->OnReadable();
+  return true;
+}
+
+v8::Local<v8::Value> SharedBuffer::Read(v8::Isolate* isolate) {
+  if (closed_)
+    return v8::Null(isolate);
+
+  uint64_t available = read_header_->write_pos.load() - read_pos_;
+  if (available == 0) {
+    // Checks again after asking to be woken up, in case the writer added a
+    // record in between and missed the request.
+    read_header_->reader_waiting.store(1);
+    available = read_header_->write_pos.load() - read_pos_;
+    if (available == 0)
+      return v8::Null(isolate);
+  }
+
+  // Records are published whole, anything else means the other end did not
+  // follow the protocol.
+  RecordSize size = 0;
+  if (available > capacity() || available < sizeof(RecordSize)) {
+    Close();
+    return v8::Null(isolate);
+  }
+  CopyFromRing(read_ring_, read_pos_,
+               base::as_writable_bytes(base::make_span(&size, 1u)));
+  const uint64_t record_size = sizeof(RecordSize) + uint64_t{size};
+  if (record_size > available) {
+    Close();
+    return v8::Null(isolate);
+  }
+
+  v8::Local<v8::Object> buffer;
+  if (!node::Buffer::New(isolate, size).ToLocal(&buffer))
+    return v8::Null(isolate);
+  CopyFromRing(read_ring_, read_pos_ + sizeof(RecordSize),
+               base::make_span(
+                   reinterpret_cast<uint8_t*>(node::Buffer::Data(buffer)),
+                   size));
+  read_pos_ += record_size;
+  read_header_->read_pos.store(read_pos_);
+
+  if (read_header_->writer_waiting.exchange(0) != 0)
+    peer_->OnDrain();
+  return buffer;
+}
+
+void SharedBuffer::Close() {
+  if (closed_)
+    return;
+  closed_ = true;
+  peer_.reset();
+  receiver_.reset();
+  Emit("close");
+  Unpin();
+}
+
+void SharedBuffer::Emit(const char* name) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Object> self;
+  if (GetWrapper(isolate).ToLocal(&self))
+    gin_helper::EmitEvent(isolate, self, name);
+}
+
+// static
+gin::ObjectTemplateBuilder SharedBuffer::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<SharedBuffer>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("write", &SharedBuffer::Write)
+      .SetMethod("read", &SharedBuffer::Read)
+      .SetMethod("close", &SharedBuffer::Close)
+      .SetProperty("capacity", &SharedBuffer::capacity);
+}
+
+const char* SharedBuffer::GetTypeName() {
+  return "SharedBuffer";
+}
+
+}  // namespace electron
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_SERVICES_NODE_SHARED_BUFFER_H_
+#define ELECTRON_SHELL_SERVICES_NODE_SHARED_BUFFER_H_
+
+#include <cstdint>
+
+#include "base/containers/span.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "base/memory/weak_ptr.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/gin_helper/pinnable.h"
+#include "shell/services/node/public/mojom/node_service.mojom.h"
+
+namespace gin {
+class Arguments;
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron {
+
+// One end of a channel between the main process and a utility process, made
+// of two single-producer single-consumer rings of records in shared memory,
+// one for each direction. Records are copied in and out of the rings without
+// being serialized or going through IPC; the ends only message each other to
+// wake up a reader that ran out of records or a writer that ran out of room.
+//
+// The memory is shared with the other process, so nothing read from it is
+// trusted: an end whose ring is found inconsistent closes itself.
+class SharedBuffer : public gin::Wrappable<SharedBuffer>,
+                     public gin_helper::Pinnable<SharedBuffer>,
+                     public node::mojom::SharedBufferPeer {
+ public:
+  // Returns the region for rings of |capacity| bytes each, which is invalid
+  // if it can't be allocated.
+  static base::UnsafeSharedMemoryRegion CreateRegion(size_t capacity);
+
+  // Returns an empty handle if |region| does not hold two rings.
+  static gin::Handle<SharedBuffer> Create(
+      v8::Isolate* isolate,
+      base::UnsafeSharedMemoryRegion region,
+      bool is_parent,
+      mojo::PendingRemote<node::mojom::SharedBufferPeer> peer,
+      mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  SharedBuffer(const SharedBuffer&) = delete;
+  SharedBuffer& operator=(const SharedBuffer&) = delete;
+
+ private:
+  struct RingHeader;
+
+  SharedBuffer(base::WritableSharedMemoryMapping mapping,
+               bool is_parent,
+               mojo::PendingRemote<node::mojom::SharedBufferPeer> peer,
+               mojo::PendingReceiver<node::mojom::SharedBufferPeer> receiver);
+  ~SharedBuffer() override;
+
+  // node::mojom::SharedBufferPeer
+  void OnReadable() override;
+  void OnDrain() override;
+
+  bool Write(gin::Arguments* args);
+  v8::Local<v8::Value> Read(v8::Isolate* isolate);
+  void Close();
+  size_t capacity() const { return write_ring_.size(); }
+
+  void Emit(const char* name);
+
+  base::WritableSharedMemoryMapping mapping_;
+  raw_ptr<RingHeader> write_header_;
+  raw_ptr<RingHeader> read_header_;
+  base::span<uint8_t> write_ring_;
+  base::span<uint8_t> read_ring_;
+
+  // The positions this end owns, which are only ever published to the other
+  // end and never read back from the shared memory.
+  uint64_t write_pos_ = 0;
+  uint64_t read_pos_ = 0;
+
+  bool closed_ = false;
+  mojo::Remote<node::mojom::SharedBufferPeer> peer_;
+  mojo::Receiver<node::mojom::SharedBufferPeer> receiver_;
+
+  base::WeakPtrFactory<SharedBuffer> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_SERVICES_NODE_SHARED_BUFFER_H_
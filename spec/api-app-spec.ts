@@ -6,7 +6,7 @@ import * as net from 'node:net';
 import * as fs from 'fs-extra';
 import * as path from 'node:path';
 import { promisify } from 'node:util';
-import { app, BrowserWindow, Menu, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
+import { app, BrowserWindow, ipcMain, Menu, nativeImage, session, net as electronNet, WebContents, utilityProcess } from 'electron/main';
 import { closeWindow, closeAllWindows } from './lib/window-helpers';
 import { ifdescribe, ifit, listen, waitUntil } from './lib/spec-helpers';
 import { collectStreamBody, getResponse } from './lib/net-helpers';
@@ -1476,6 +1476,219 @@ describe('app module', () => {
     });
   });
 
+  describe('startCpuProfiling() API', () => {
+    const profilePath = path.join(app.getPath('temp'), 'electron-main.cpuprofile');
+
+    afterEach(async () => {
+      await app.stopCpuProfiling(profilePath).catch(() => {});
+      await fs.remove(profilePath);
+    });
+
+    it('throws for an invalid sampling interval', () => {
+      expect(() => app.startCpuProfiling({ samplingInterval: 0 })).to.throw(/samplingInterval must be a positive number/);
+    });
+
+    it('rejects when not profiling', async () => {
+      await expect(app.stopCpuProfiling(profilePath)).to.eventually.be.rejectedWith(/CPU profiling is not running/);
+    });
+
+    it('can not be started twice', () => {
+      expect(app.startCpuProfiling()).to.be.true();
+      expect(app.startCpuProfiling()).to.be.false();
+    });
+
+    it('writes a .cpuprofile file', async () => {
+      expect(app.startCpuProfiling({ samplingInterval: 100 })).to.be.true();
+      const end = Date.now() + 100;
+      while (Date.now() < end);
+      await app.stopCpuProfiling(profilePath);
+      const profile = await fs.readJson(profilePath);
+      expect(profile.nodes).to.be.an('array').that.is.not.empty();
+      expect(profile.nodes[0].callFrame.functionName).to.equal('(root)');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+      expect(profile.timeDeltas).to.have.lengthOf(profile.samples.length);
+      expect(profile.endTime).to.be.at.least(profile.startTime);
+    });
+  });
+
+  describe('startProcessMetricsSampling() API', () => {
+    afterEach(() => {
+      app.stopProcessMetricsSampling();
+    });
+
+    it('returns null when the processes are not sampled', () => {
+      expect(app.getProcessMetricsHistory()).to.be.null();
+    });
+
+    it('throws for invalid options', () => {
+      expect(() => app.startProcessMetricsSampling({ interval: 0 })).to.throw(/interval must be a positive number/);
+      expect(() => app.startProcessMetricsSampling({ historySize: -1 })).to.throw(/historySize must be a positive number/);
+    });
+
+    it('samples the processes of the app in the background', async () => {
+      app.startProcessMetricsSampling({ interval: 50, historySize: 2 });
+      await new Promise(resolve => setTimeout(resolve, 500));
+      const { fields, data } = app.getProcessMetricsHistory()!;
+      expect(fields).to.deep.equal([
+        'time', 'pid', 'percentCPUUsage', 'workingSetSize', 'privateBytes',
+        'sharedBytes', 'gpuMemory', 'readBytes', 'writeBytes'
+      ]);
+      expect(data).to.be.an.instanceOf(Float64Array);
+      expect(data.length % fields.length).to.equal(0);
+
+      const rows = [];
+      for (let i = 0; i < data.length; i += fields.length) {
+        rows.push(data.subarray(i, i + fields.length));
+      }
+      const times = new Set(rows.map(row => row[fields.indexOf('time')]));
+      expect(times.size).to.equal(2);
+
+      const browser = rows.find(row => row[fields.indexOf('pid')] === process.pid);
+      expect(browser).to.not.be.undefined();
+      expect(browser![fields.indexOf('time')]).to.be.within(Date.now() - 5000, Date.now());
+      expect(browser![fields.indexOf('percentCPUUsage')]).to.be.at.least(0);
+      expect(browser![fields.indexOf('workingSetSize')]).to.be.greaterThan(0);
+    });
+  });
+
+  describe('getEventLoopStats() API', () => {
+    afterEach(closeAllWindows);
+
+    const blockFor = (ms: number) => {
+      const end = Date.now() + ms;
+      while (Date.now() < end);
+    };
+
+    it('returns histograms of the main process event loop', async () => {
+      await new Promise(resolve => setTimeout(resolve, 10));
+      const stats = app.getEventLoopStats();
+      for (const histogram of [stats.taskDuration, stats.loopLag, stats.microtaskCheckpoint, stats.uvRun]) {
+        expect(histogram).to.have.all.keys('count', 'min', 'max', 'mean', 'p50', 'p90', 'p99');
+        expect(histogram.max).to.be.at.least(histogram.p99);
+        expect(histogram.p90).to.be.at.least(histogram.p50);
+      }
+      expect(stats.taskDuration.count).to.be.greaterThan(0);
+      expect(stats.uvRun.count).to.be.greaterThan(0);
+      expect(stats.longTasks).to.be.an('array');
+    });
+
+    it('records long tasks', async () => {
+      app.resetEventLoopStats();
+      expect(app.getEventLoopStats().longTasks).to.be.empty();
+      await new Promise<void>(resolve => setTimeout(() => { blockFor(100); resolve(); }));
+      await new Promise(resolve => setTimeout(resolve, 10));
+      const { longTasks } = app.getEventLoopStats();
+      expect(longTasks).to.have.lengthOf.at.least(1);
+      const longTask = longTasks[longTasks.length - 1];
+      expect(longTask.duration).to.be.at.least(100);
+      expect(longTask.startTime).to.be.within(Date.now() - 10000, Date.now());
+      expect(longTask.postedFrom).to.be.a('string').that.does.not.equal('');
+    });
+
+    it('attributes long tasks to the event that was emitted', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      app.resetEventLoopStats();
+      const received = once(ipcMain, 'slow-message');
+      ipcMain.once('slow-message', () => blockFor(100));
+      w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.send(\'slow-message\')');
+      await received;
+      await new Promise(resolve => setTimeout(resolve, 10));
+      const { longTasks } = app.getEventLoopStats();
+      const longTask = longTasks.find(task => task.api === 'WebContents.emit(\'-ipc-message\')');
+      expect(longTask).to.not.be.undefined();
+      expect(longTask!.apiDuration).to.be.at.least(100);
+    });
+  });
+
+  describe('setSkipIdleMicrotaskCheckpoints() API', () => {
+    afterEach(() => app.setSkipIdleMicrotaskCheckpoints(false));
+
+    it('still runs the microtasks of the tasks that settle promises', async () => {
+      app.setSkipIdleMicrotaskCheckpoints(true);
+      app.resetEventLoopStats();
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      expect(await w.webContents.executeJavaScript('1 + 1')).to.equal(2);
+      await new Promise(resolve => setTimeout(resolve, 100));
+      const stats = app.getEventLoopStats();
+      expect(stats.skippedMicrotaskCheckpoints).to.be.a('number');
+      w.destroy();
+    });
+
+    it('does not skip checkpoints by default', async () => {
+      app.resetEventLoopStats();
+      await new Promise(resolve => setTimeout(resolve, 100));
+      expect(app.getEventLoopStats().skippedMicrotaskCheckpoints).to.equal(0);
+    });
+  });
+
+  describe('getBlockingCallStats() API', () => {
+    it('records the blocking regions of the main thread', () => {
+      app.resetBlockingCallStats();
+      expect(app.getBlockingCallStats()).to.be.an('array').that.is.empty();
+      // Resolving a path that references its parent blocks.
+      nativeImage.createFromPath(path.join(fixturesPath, 'assets') + '/../assets/logo.png');
+      const stats = app.getBlockingCallStats();
+      expect(stats).to.have.lengthOf.at.least(1);
+      for (const site of stats) {
+        expect(site.location).to.be.a('string').that.does.not.equal('');
+        expect(site.count).to.be.at.least(1);
+        expect(site.maxDuration).to.be.at.most(site.totalDuration);
+      }
+    });
+  });
+
+  describe('startHangMonitor() API', () => {
+    afterEach(() => app.stopHangMonitor());
+
+    it('throws for an invalid threshold', () => {
+      expect(() => app.startHangMonitor({ threshold: 0 })).to.throw(/threshold must be a positive number/);
+    });
+
+    it('reports a blocked main thread with its JavaScript stack', async () => {
+      app.startHangMonitor({ threshold: 100 });
+      const hang = once(app, 'main-process-hang');
+      setTimeout(function blockMainThread () {
+        const end = Date.now() + 500;
+        while (Date.now() < end);
+      }, 200);
+      const [, details] = await hang;
+      expect(details.duration).to.be.at.least(100);
+      expect(details.stack).to.include('blockMainThread');
+    });
+  });
+
+  describe('getStartupMetrics() API', () => {
+    afterEach(closeAllWindows);
+
+    it('returns the phases of the main process startup', () => {
+      const metrics = app.getStartupMetrics();
+      expect(metrics.processCreationTime).to.be.within(0, Date.now());
+      const names = metrics.phases.map(phase => phase.name);
+      expect(names).to.include.members([
+        'ElectronBrowserMainParts::PreMainMessageLoopRun',
+        'NodeBindings::LoadEnvironment',
+        'ready'
+      ]);
+      for (const phase of metrics.phases) {
+        expect(phase.startTime).to.be.at.least(0);
+        expect(phase.duration).to.be.at.least(0);
+      }
+      expect(metrics.asarArchives.count).to.be.a('number');
+      expect(metrics.asarArchives.duration).to.be.a('number');
+      // The spec runner was not started by app.relaunch().
+      expect(metrics.relaunchTime).to.be.undefined();
+    });
+
+    it('records the first navigation of a window', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const names = app.getStartupMetrics().phases.map(phase => phase.name);
+      expect(names).to.include('firstNavigationCommit');
+    });
+  });
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus();
@@ -1484,6 +1697,20 @@ describe('app module', () => {
     });
   });
 
+  describe('getMediaCaptureDevices() API', () => {
+    it('returns the audio and video capture devices', () => {
+      const { audio, video } = app.getMediaCaptureDevices();
+      for (const device of [...audio, ...video]) {
+        expect(device.id).to.be.a('string');
+        expect(device.name).to.be.a('string');
+      }
+    });
+
+    it('returns the same devices from the cache', () => {
+      expect(app.getMediaCaptureDevices()).to.deep.equal(app.getMediaCaptureDevices());
+    });
+  });
+
   ifdescribe(!process.env.IS_ASAN)('getGPUInfo() API', () => {
     const appPath = path.join(fixturesPath, 'api', 'gpu-info.js');
 
@@ -1550,6 +1777,12 @@ describe('app module', () => {
       }
     });
 
+    it('resolves concurrent basic GPUInfo requests with the same info', async () => {
+      const [first, second] = await Promise.all([app.getGPUInfo('basic'), app.getGPUInfo('basic')]);
+      await verifyBasicGPUInfo(first);
+      expect(second).to.deep.equal(first);
+    });
+
     it('fails for invalid info_type', () => {
       const invalidType = 'invalid';
       const expectedErrorMessage = "Invalid info type. Use 'basic' or 'complete'";
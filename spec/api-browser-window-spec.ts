@@ -264,6 +264,20 @@ describe('BrowserWindow module', () => {
         contents.getProcessId();
       }).to.throw('Object has been destroyed');
     });
+    it('prevents users to access optimized getters of webContents', async () => {
+      const contents = w.webContents;
+      // Call the getters often enough for them to be optimized.
+      const getZoomFactor = () => contents.getZoomFactor();
+      let sum = 0;
+      for (let i = 0; i < 100000; ++i) {
+        if (!contents.isDestroyed()) sum += getZoomFactor();
+      }
+      expect(sum).to.equal(100000);
+      w.destroy();
+      await new Promise(setImmediate);
+      expect(contents.isDestroyed()).to.be.true();
+      expect(getZoomFactor).to.throw('Object has been destroyed');
+    });
     it('should not crash when destroying windows with pending events', () => {
       const focusListener = () => { };
       app.on('browser-window-focus', focusListener);
@@ -2381,6 +2395,35 @@ describe('BrowserWindow module', () => {
       // Values can be 0,2,3,4, or 6. We want 6, which is RGB + Alpha
       expect(imgBuffer[25]).to.equal(6);
     });
+
+    it('honors the scaleFactor option', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 });
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+      await once(w, 'ready-to-show');
+      w.show();
+
+      const rect = { x: 0, y: 0, width: 100, height: 100 };
+      const image = await w.capturePage(rect, { scaleFactor: 0.5 });
+      expect(image.getSize()).to.deep.equal({ width: 50, height: 50 });
+      await expect(w.capturePage(rect, { scaleFactor: 0 })).to.eventually.be.rejectedWith('scaleFactor must be positive');
+    });
+
+    it('writes into the buffer option', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 });
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+      await once(w, 'ready-to-show');
+      w.show();
+
+      const rect = { x: 0, y: 0, width: 100, height: 100 };
+      const buffer = Buffer.alloc(50 * 50 * 4);
+      const image = await w.capturePage(rect, { scaleFactor: 0.5, buffer });
+      expect(image.getSize()).to.deep.equal({ width: 50, height: 50 });
+      expect(image.getBitmapView().buffer).to.equal(buffer.buffer);
+      expect(image.toBitmap().equals(buffer)).to.be.true();
+
+      await expect(w.capturePage(rect, { scaleFactor: 0.5, buffer: Buffer.alloc(4) })).to.eventually.be.rejectedWith('buffer must hold at least 10000 bytes');
+      await expect(w.capturePage(rect, { buffer: [] as any })).to.eventually.be.rejectedWith('buffer must be a node Buffer');
+    });
   });
 
   describe('BrowserWindow.setProgressBar(progress)', () => {
@@ -2741,6 +2784,39 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('BrowserWindow.batchUpdate(windows, callback)', () => {
+    afterEach(closeAllWindows);
+
+    it('applies the last bounds of each window once the callback returns', () => {
+      const w1 = new BrowserWindow({ show: false });
+      const w2 = new BrowserWindow({ show: false });
+      const bounds1 = { x: 100, y: 100, width: 300, height: 200 };
+      const bounds2 = { x: 400, y: 100, width: 300, height: 200 };
+      BrowserWindow.batchUpdate([w1, w2], () => {
+        w1.setBounds({ x: 0, y: 0, width: 200, height: 200 });
+        w1.setBounds(bounds1);
+        w2.setBounds(bounds2);
+        expectBoundsEqual(w1.getBounds(), bounds1);
+      });
+      expectBoundsEqual(w1.getBounds(), bounds1);
+      expectBoundsEqual(w2.getBounds(), bounds2);
+    });
+
+    it('applies the bounds when the callback throws', () => {
+      const w = new BrowserWindow({ show: false });
+      const bounds = { x: 100, y: 100, width: 300, height: 200 };
+      expect(() => BrowserWindow.batchUpdate([w], () => {
+        w.setBounds(bounds);
+        throw new Error('failed');
+      })).to.throw('failed');
+      expectBoundsEqual(w.getBounds(), bounds);
+    });
+
+    it('throws for invalid windows', () => {
+      expect(() => BrowserWindow.batchUpdate([{} as any], () => {})).to.throw(/Must pass an array of BaseWindow instances/);
+    });
+  });
+
   describe('Opening a BrowserWindow from a link', () => {
     let appProcess: childProcess.ChildProcessWithoutNullStreams | undefined;
 
@@ -3511,6 +3587,43 @@ describe('BrowserWindow module', () => {
         expect(test).to.equal('preload');
       });
 
+      it('runs a preload script from the code cache of an earlier renderer', async () => {
+        for (let i = 0; i < 2; i++) {
+          const w = new BrowserWindow({
+            show: false,
+            webPreferences: {
+              sandbox: true,
+              preload,
+              contextIsolation: false
+            }
+          });
+          w.loadFile(path.join(fixtures, 'api', 'preload.html'));
+          const [, test] = await once(ipcMain, 'answer');
+          expect(test).to.equal('preload');
+          w.destroy();
+        }
+      });
+
+      it('reads a preload script again when its file changes', async () => {
+        const tmpDir = await fs.promises.mkdtemp(path.resolve(os.tmpdir(), 'electron-preload-'));
+        defer(() => fs.promises.rm(tmpDir, { recursive: true, force: true }));
+        const changingPreload = path.join(tmpDir, 'preload.js');
+        for (const answer of ['first', 'second answer']) {
+          await fs.promises.writeFile(changingPreload, `require('electron').ipcRenderer.send('answer', ${JSON.stringify(answer)});`);
+          const w = new BrowserWindow({
+            show: false,
+            webPreferences: {
+              sandbox: true,
+              preload: changingPreload
+            }
+          });
+          w.loadURL('about:blank');
+          const [, test] = await once(ipcMain, 'answer');
+          expect(test).to.equal(answer);
+          w.destroy();
+        }
+      });
+
       it('exposes ipcRenderer to preload script (path has special chars)', async () => {
         const preloadSpecialChars = path.join(fixtures, 'module', 'preload-sandboxæø åü.js');
         const w = new BrowserWindow({
@@ -4488,6 +4601,30 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('beginEncodedFrameSubscription method', () => {
+    afterEach(closeAllWindows);
+
+    it('delivers encoded frames starting with a key frame', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'));
+      const frame = await new Promise<Electron.EncodedFrame>((resolve) => {
+        w.webContents.beginEncodedFrameSubscription({ codec: 'vp8' }, resolve);
+      });
+      w.webContents.endFrameSubscription();
+      expect(frame.data).to.be.an.instanceOf(Buffer);
+      expect(frame.data.length).to.be.greaterThan(0);
+      expect(frame.keyFrame).to.be.true();
+      expect(frame.timestamp).to.be.a('number');
+    });
+
+    it('throws for unsupported codecs', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.beginEncodedFrameSubscription({ codec: 'mjpeg' }, () => {});
+      }).to.throw('Unsupported codec: mjpeg');
+    });
+  });
+
   describe('savePage method', () => {
     const savePageDir = path.join(fixtures, 'save_page');
     const savePageHtmlPath = path.join(savePageDir, 'save_page.html');
@@ -4554,6 +4691,28 @@ describe('BrowserWindow module', () => {
       } catch {}
     });
 
+    it('should generate an MHTML file', async () => {
+      const tmpDir = await fs.promises.mkdtemp(path.resolve(os.tmpdir(), 'electron-mhtml-generate-'));
+      const mhtmlPath = path.join(tmpDir, 'page.mhtml');
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+      const result = await w.webContents.generateMHTML(mhtmlPath, { computeContentsHash: true });
+
+      const stat = await fs.promises.stat(mhtmlPath);
+      expect(result.size).to.equal(stat.size);
+      expect(result.sha256).to.match(/^[0-9A-F]{64}$/);
+      await fs.promises.rm(tmpDir, { recursive: true, force: true });
+    });
+
+    it('should reject relative paths for generateMHTML', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+
+      await expect(
+        w.webContents.generateMHTML('page.mhtml')
+      ).to.eventually.be.rejectedWith('Path must be absolute');
+    });
+
     it('should save page to disk with HTMLComplete', async () => {
       const w = new BrowserWindow({ show: false });
       await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
@@ -4563,6 +4722,36 @@ describe('BrowserWindow module', () => {
       expect(fs.existsSync(savePageJsPath)).to.be.true('js path');
       expect(fs.existsSync(savePageCssPath)).to.be.true('css path');
     });
+
+    it('should save page to disk with HTMLComplete and a concurrency', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+      const stages = new Set<string>();
+      await w.webContents.savePage(savePageHtmlPath, 'HTMLComplete', {
+        concurrency: 4,
+        onProgress: ({ stage }) => stages.add(stage)
+      });
+
+      expect(fs.existsSync(savePageHtmlPath)).to.be.true('html path');
+      expect(fs.existsSync(savePageJsPath)).to.be.true('js path');
+      expect(fs.existsSync(savePageCssPath)).to.be.true('css path');
+      for (const stage of stages) {
+        expect(stage).to.be.oneOf(['fetching', 'saving']);
+      }
+    });
+
+    it('should reject invalid options', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixtures, 'pages', 'save_page', 'index.html'));
+
+      await expect(
+        w.webContents.savePage(savePageHtmlPath, 'HTMLComplete', { concurrency: 0 })
+      ).to.eventually.be.rejectedWith('concurrency must be a positive integer');
+
+      await expect(
+        w.webContents.savePage(savePageHtmlPath, 'HTMLComplete', { onProgress: 'nope' as any })
+      ).to.eventually.be.rejectedWith('onProgress must be a function');
+    });
   });
 
   describe('BrowserWindow options argument is optional', () => {
@@ -6353,6 +6542,49 @@ describe('BrowserWindow module', () => {
         expect(c.webContents.isOffscreen()).to.be.false('isOffscreen');
         c.destroy();
       });
+
+      it('is true when offscreen options are given as an object', () => {
+        const c = new BrowserWindow({ show: false, webPreferences: { offscreen: { useSharedTexture: false } } });
+        expect(c.webContents.isOffscreen()).to.be.true('isOffscreen');
+        c.destroy();
+      });
+    });
+
+    it('paints bitmaps without a texture by default', async () => {
+      const paint = once(w.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage, Electron.OffscreenSharedTexture | undefined]>;
+      w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [,, image, texture] = await paint;
+      expect(image.isEmpty()).to.be.false('image is empty');
+      expect(texture).to.be.undefined();
+    });
+
+    it('paints with an adaptive frame rate', async () => {
+      const c = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: { backgroundThrottling: false, offscreen: { adaptiveFrameRate: true, maxLatency: 100 } }
+      });
+      const paint = once(c.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage]>;
+      c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [,, image] = await paint;
+      expect(image.isEmpty()).to.be.false('image is empty');
+      expect(c.webContents.getFrameRate()).to.equal(60);
+      c.destroy();
+    });
+
+    it('paints only the dirty rect when dirtyRectOnly is set', async () => {
+      const c = new BrowserWindow({
+        width: 100,
+        height: 100,
+        show: false,
+        webPreferences: { backgroundThrottling: false, offscreen: { dirtyRectOnly: true } }
+      });
+      const paint = once(c.webContents, 'paint') as Promise<[any, Electron.Rectangle, Electron.NativeImage]>;
+      c.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
+      const [, dirtyRect, image] = await paint;
+      expect(image.getSize()).to.deep.equal({ width: dirtyRect.width, height: dirtyRect.height });
+      c.destroy();
     });
 
     describe('window.webContents.isPainting()', () => {
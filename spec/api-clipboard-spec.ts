@@ -1,6 +1,7 @@
 import { expect } from 'chai';
 import * as path from 'node:path';
 import { Buffer } from 'node:buffer';
+import { once } from 'node:events';
 import { ifdescribe, ifit } from './lib/spec-helpers';
 import { clipboard, nativeImage } from 'electron/common';
 
@@ -23,6 +24,44 @@ ifdescribe(process.platform !== 'win32' || process.arch !== 'arm64')('clipboard
     });
   });
 
+  describe('clipboard.readImageAsync()', () => {
+    it('resolves with a NativeImage instance', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png');
+      const i = nativeImage.createFromPath(p);
+      clipboard.writeImage(i);
+      const readImage = await clipboard.readImageAsync();
+      expect(readImage.toDataURL()).to.equal(i.toDataURL());
+    });
+
+    it('works for empty image', async () => {
+      clipboard.writeText('Not an Image');
+      expect((await clipboard.readImageAsync()).isEmpty()).to.be.true();
+    });
+  });
+
+  describe('clipboard.getSequenceNumber()', () => {
+    it('changes when the clipboard is written to', () => {
+      clipboard.writeText('first');
+      const sequenceNumber = clipboard.getSequenceNumber();
+      expect(clipboard.getSequenceNumber()).to.equal(sequenceNumber);
+      clipboard.writeText('second');
+      expect(clipboard.getSequenceNumber()).to.not.equal(sequenceNumber);
+    });
+  });
+
+  describe('clipboard \'change\' event', () => {
+    afterEach(() => {
+      clipboard.removeAllListeners('change');
+    });
+
+    it('is emitted when the clipboard is written to', async () => {
+      const changed = once(clipboard, 'change');
+      clipboard.writeText('changed');
+      await changed;
+      expect(clipboard.readText()).to.equal('changed');
+    });
+  });
+
   describe('clipboard.readText()', () => {
     it('returns unicode string correctly', () => {
       const text = '千江有水千江月，万里无云万里天';
@@ -118,6 +118,41 @@ ifdescribe(!(['arm', 'arm64'].includes(process.arch)) || (process.platform !== '
     });
   });
 
+  describe('startStreaming', function () {
+    this.timeout(10e3);
+
+    const streamFilePath = path.join(app.getPath('temp'), 'trace.pftrace');
+    afterEach(async () => {
+      await contentTracing.stopStreaming().catch(() => {});
+      fs.rmSync(streamFilePath, { force: true });
+      fs.rmSync(`${streamFilePath}.1`, { force: true });
+    });
+
+    it('rejects for invalid options', async () => {
+      await expect(contentTracing.startStreaming('', {})).to.be.rejectedWith('filePath must be a non-empty string');
+      await expect(contentTracing.startStreaming(streamFilePath, {}, { fileWritePeriod: 0 })).to.be.rejectedWith('fileWritePeriod must be a positive number');
+      await expect(contentTracing.startStreaming(streamFilePath, {}, { maxFiles: 0 })).to.be.rejectedWith('maxFiles must be a positive number');
+    });
+
+    it('rejects when a trace is already being streamed', async () => {
+      await contentTracing.startStreaming(streamFilePath, {});
+      await expect(contentTracing.startStreaming(streamFilePath, {})).to.be.rejectedWith('Failed to start streaming - a trace is already being streamed');
+    });
+
+    it('writes the trace to the file while it is recorded', async () => {
+      await contentTracing.startStreaming(streamFilePath, {
+        included_categories: ['*']
+      }, { fileWritePeriod: 100 });
+      await setTimeout(1000);
+      expect(fs.statSync(streamFilePath).size).to.be.greaterThan(0);
+      await contentTracing.stopStreaming();
+    });
+
+    it('rejects stopping if no trace is being streamed', async () => {
+      await expect(contentTracing.stopStreaming()).to.be.rejectedWith('Failed to stop streaming - no trace is being streamed');
+    });
+  });
+
   describe('captured events', () => {
     it('include V8 samples from the main process', async function () {
       this.timeout(60000);
@@ -1,5 +1,5 @@
 import { BrowserWindow, ipcMain } from 'electron/main';
-import { contextBridge } from 'electron/renderer';
+import { contextBridge, webFrame } from 'electron/renderer';
 import { expect } from 'chai';
 import * as fs from 'fs-extra';
 import * as http from 'node:http';
@@ -264,6 +264,27 @@ describe('contextBridge', () => {
         expect(immutable).to.equal(true);
       });
 
+      it('should freeze every object reachable from an exposed API once', async () => {
+        await makeBindingWindow(() => {
+          const shared = { value: 1 };
+          const api: Record<string, any> = { a: { shared }, b: { shared } };
+          for (let i = 0; i < 2000; i++) api[`method${i}`] = () => i;
+          contextBridge.exposeInMainWorld('example', api);
+          contextBridge.exposeInMainWorld('again', { method: api.method0, shared });
+        });
+        const result = await callWithBindings((root: any) => {
+          return [
+            Object.isFrozen(root.example),
+            Object.isFrozen(root.example.a.shared),
+            Object.isFrozen(root.example.b.shared),
+            Object.isFrozen(root.example.method1999),
+            root.example.method1999(),
+            Object.isFrozen(root.again.shared)
+          ];
+        });
+        expect(result).to.deep.equal([true, true, true, true, 1999, true]);
+      });
+
       it('should proxy booleans', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', true);
@@ -440,6 +461,52 @@ describe('contextBridge', () => {
         expect(result).to.equal(124);
       });
 
+      it('should reuse the proxy for a function passed over the bridge more than once', async () => {
+        await makeBindingWindow(() => {
+          const listeners = new Set();
+          contextBridge.exposeInMainWorld('example', {
+            addListener: (fn: any) => { listeners.add(fn); },
+            removeListener: (fn: any) => { listeners.delete(fn); },
+            count: () => listeners.size
+          });
+        });
+        const result = await callWithBindings(async (root: any) => {
+          const listener = () => {};
+          root.example.addListener(listener);
+          root.example.addListener(listener);
+          const added = root.example.count();
+          root.example.removeListener(listener);
+          return [added, root.example.count()];
+        });
+        expect(result).to.deep.equal([1, 0]);
+      });
+
+      it('should count values crossing the bridge', async () => {
+        await makeBindingWindow(() => {
+          contextBridge.exposeInMainWorld('example', {
+            getStats: () => webFrame.getContextBridgeStats(),
+            echo: (value: any) => value
+          });
+        });
+        const result = await callWithBindings(async (root: any) => {
+          const before = root.example.getStats();
+          root.example.echo({ a: [1, 2] });
+          await root.example.echo(Promise.resolve());
+          const after = root.example.getStats();
+          return {
+            calls: after.calls - before.calls,
+            objectsCloned: after.objectsCloned - before.objectsCloned,
+            promisesProxied: after.promisesProxied - before.promisesProxied
+          };
+        });
+        // Both calls to echo and the second call to getStats
+        expect(result.calls).to.equal(3);
+        // The object and array on the way in and out, and the first stats
+        // object on the way out
+        expect(result.objectsCloned).to.equal(5);
+        expect(result.promisesProxied).to.equal(2);
+      });
+
       it('should proxy promises in the reverse direction', async () => {
         await makeBindingWindow(() => {
           contextBridge.exposeInMainWorld('example', {
@@ -581,6 +648,40 @@ describe('contextBridge', () => {
         expect(result).to.deep.equal([true, true]);
       });
 
+      it('should pass shared buffers by reference', async () => {
+        await makeBindingWindow(() => {
+          const shared = new Uint8Array(4);
+          const copied = new Uint8Array(4);
+          contextBridge.exposeInMainWorld('example', {
+            getShared: () => contextBridge.shareBuffer(shared),
+            getCopied: () => copied,
+            read: () => [shared[0], copied[0]]
+          });
+        });
+        const result = await callWithBindings((root: any) => {
+          const shared = root.example.getShared();
+          const copied = root.example.getCopied();
+          shared[0] = 1;
+          copied[0] = 2;
+          return [Object.getPrototypeOf(shared) === Uint8Array.prototype, root.example.read()];
+        });
+        expect(result).to.deep.equal([true, [1, 0]]);
+      });
+
+      it('should refuse to share part of a buffer', async () => {
+        await makeBindingWindow(() => {
+          let error: any;
+          try {
+            contextBridge.shareBuffer(new Uint8Array(16).subarray(4));
+          } catch (e) {
+            error = e;
+          }
+          contextBridge.exposeInMainWorld('example', { error: error && error.message });
+        });
+        const result = await callWithBindings((root: any) => root.example.error);
+        expect(result).to.equal('Only views that span their entire ArrayBuffer can be shared');
+      });
+
       it('should handle recursive objects', async () => {
         await makeBindingWindow(() => {
           const o: any = { value: 135 };
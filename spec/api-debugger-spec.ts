@@ -243,4 +243,79 @@ describe('debugger module', () => {
       w.webContents.debugger.sendCommand('Target.setDiscoverTargets', { discover: true });
     });
   });
+
+  describe('debugger.setEventDomains', () => {
+    it('only emits the events of the given domains', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setEventDomains(['Runtime']);
+      const methods: string[] = [];
+      w.webContents.debugger.on('message', (event, method) => methods.push(method));
+      const contextCreated = emittedUntil(w.webContents.debugger, 'message',
+        (event: Electron.Event, method: string) => method === 'Runtime.executionContextCreated');
+      await w.webContents.debugger.sendCommand('Page.enable');
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      await w.webContents.debugger.sendCommand('Page.reload');
+      await contextCreated;
+      w.webContents.debugger.detach();
+      expect(methods).to.not.be.empty();
+      expect(methods.every(method => method.startsWith('Runtime.'))).to.be.true();
+    });
+
+    it('throws for invalid domains', () => {
+      expect(() => {
+        w.webContents.debugger.setEventDomains('Runtime' as any);
+      }).to.throw(/domains must be null or an array of strings/);
+    });
+  });
+
+  describe('debugger.setEventFilters', () => {
+    it('only emits the events that match a filter', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setEventFilters([
+        { method: 'Runtime.consoleAPICalled', params: { 'args.0.value': 'keep*' } }
+      ]);
+      const messages: [string, any][] = [];
+      w.webContents.debugger.on('message', (event, method, params) => messages.push([method, params]));
+      const message = once(w.webContents.debugger, 'message');
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      await w.webContents.executeJavaScript('console.log("drop"); console.log("keep me"); null');
+      const [, , params] = await message;
+      w.webContents.debugger.detach();
+      expect(params.args[0].value).to.equal('keep me');
+      expect(messages.map(([method]) => method)).to.deep.equal(['Runtime.consoleAPICalled']);
+    });
+
+    it('throws for invalid filters', () => {
+      expect(() => {
+        w.webContents.debugger.setEventFilters([{ params: {} }] as any);
+      }).to.throw(/filters must be null or an array of event filters/);
+    });
+  });
+
+  describe('debugger.setRawMessages', () => {
+    it('emits events as JSON', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setRawMessages(true);
+      const message = emittedUntil(w.webContents.debugger, 'raw-message',
+        (event: Electron.Event, json: string) => JSON.parse(json).method === 'Runtime.consoleAPICalled');
+      await w.webContents.debugger.sendCommand('Runtime.enable');
+      w.webContents.executeJavaScript('console.log("raw")');
+      const [, json] = await message;
+      w.webContents.debugger.detach();
+      const { params } = JSON.parse(json);
+      expect(params.args[0].value).to.equal('raw');
+    });
+
+    it('still resolves commands with objects', async () => {
+      await w.webContents.loadURL('about:blank');
+      w.webContents.debugger.attach();
+      w.webContents.debugger.setRawMessages(true);
+      const res = await w.webContents.debugger.sendCommand('Runtime.evaluate', { expression: '1 + 2' });
+      w.webContents.debugger.detach();
+      expect(res.result.value).to.equal(3);
+    });
+  });
 });
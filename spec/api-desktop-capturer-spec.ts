@@ -242,4 +242,47 @@ ifdescribe(!process.arch.includes('arm') && process.platform !== 'win32')('deskt
       destroyWindows();
     }
   });
+
+  describe('createSourceList()', () => {
+    it('throws an error for invalid options', () => {
+      expect(() => desktopCapturer.createSourceList(['window', 'screen'] as any)).to.throw('Invalid options');
+      expect(() => desktopCapturer.createSourceList({ types: ['screen'], updateInterval: 0 })).to.throw('updateInterval must be a positive number');
+    });
+
+    it('emits the sources once and keeps them up to date', async () => {
+      const list = desktopCapturer.createSourceList({ types: ['window', 'screen'], updateInterval: 100 });
+      try {
+        const added: Electron.DesktopCapturerSource[] = [];
+        list.on('source-added', source => added.push(source));
+        await once(list, 'updated');
+        const ids = list.getSources().map(source => source.id);
+        expect(ids).to.not.be.empty();
+        expect(added.map(source => source.id)).to.have.members(ids);
+
+        // Sources are only added once, however often the list is refreshed.
+        await setTimeout(500);
+        const addedIds = added.map(source => source.id);
+        expect(new Set(addedIds).size).to.equal(addedIds.length);
+      } finally {
+        list.destroy();
+      }
+    });
+
+    // Linux doesn't return any window sources.
+    ifit(process.platform !== 'linux')('emits source-removed when a window is closed', async () => {
+      const w = new BrowserWindow({ width: 200, height: 200, title: 'source-list-window' });
+      await w.loadURL('about:blank');
+      const id = w.getMediaSourceId();
+      const list = desktopCapturer.createSourceList({ types: ['window'], thumbnailSize: { width: 0, height: 0 }, updateInterval: 100 });
+      try {
+        await once(list, 'updated');
+        expect(list.getSources().map(source => source.id)).to.include(id);
+        w.destroy();
+        const [removed] = await once(list, 'source-removed');
+        expect(removed).to.equal(id);
+      } finally {
+        list.destroy();
+      }
+    });
+  });
 });
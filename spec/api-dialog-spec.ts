@@ -80,7 +80,8 @@ describe('dialog module', () => {
   describe('showMessageBox', () => {
     afterEach(closeAllWindows);
 
-    // parentless message boxes are synchronous on macOS
+    // dangling parentless message boxes stay open on macOS, see below for one
+    // that is closed
     // dangling message boxes on windows cause a DCHECK: https://source.chromium.org/chromium/chromium/src/+/main:base/win/message_window.cc;drc=7faa4bf236a866d007dc5672c9ce42660e67a6a6;l=68
     ifit(process.platform !== 'darwin' && process.platform !== 'win32')('should not throw for a parentless message box', () => {
       expect(() => {
@@ -125,6 +126,21 @@ describe('dialog module', () => {
   describe('showMessageBox with signal', () => {
     afterEach(closeAllWindows);
 
+    ifit(process.platform === 'darwin')('closes a parentless message box', async () => {
+      const controller = new AbortController();
+      const signal = controller.signal;
+      const p = dialog.showMessageBox({
+        signal,
+        message: 'i am message',
+        buttons: ['OK', 'Cancel'],
+        cancelId: 1
+      });
+      await setTimeout(500);
+      controller.abort();
+      const result = await p;
+      expect(result.response).to.equal(1);
+    });
+
     it('closes message box immediately', async () => {
       const controller = new AbortController();
       const signal = controller.signal;
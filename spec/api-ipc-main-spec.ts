@@ -1,8 +1,10 @@
 import { expect } from 'chai';
 import * as path from 'node:path';
 import * as cp from 'node:child_process';
+import * as http from 'node:http';
+import { Worker } from 'node:worker_threads';
 import { closeAllWindows } from './lib/window-helpers';
-import { defer } from './lib/spec-helpers';
+import { defer, listen, waitUntil } from './lib/spec-helpers';
 import { ipcMain, BrowserWindow } from 'electron/main';
 import { once } from 'node:events';
 
@@ -89,4 +91,181 @@ describe('ipc main module', () => {
       expect(v).to.equal('hello');
     });
   });
+
+  describe('ipcMain.setChannelPriority', () => {
+    afterEach(() => {
+      ipcMain.setChannelPriority('bulk', 'normal');
+      ipcMain.removeAllListeners('bulk');
+      ipcMain.removeAllListeners('urgent');
+    });
+
+    it('lets messages on normal channels overtake those on low ones', async () => {
+      ipcMain.setChannelPriority('bulk', 'low');
+      const received: string[] = [];
+      ipcMain.on('bulk', () => received.push('bulk'));
+      ipcMain.on('urgent', () => received.push('urgent'));
+
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: false
+        }
+      });
+      await w.loadURL('about:blank');
+      const done = once(ipcMain, 'bulk');
+      await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.send('bulk')
+        ipcRenderer.send('urgent')
+      }`);
+      await done;
+      expect(received).to.deep.equal(['urgent', 'bulk']);
+    });
+
+    it('keeps the order of messages on the same channel', async () => {
+      ipcMain.setChannelPriority('bulk', 'low');
+      const received: number[] = [];
+      ipcMain.on('bulk', (e, i) => received.push(i));
+
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: false
+        }
+      });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        for (let i = 0; i < 10; i++) ipcRenderer.send('bulk', i)
+      }`);
+      await waitUntil(() => received.length === 10);
+      expect(received).to.deep.equal([0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+    });
+
+    it('throws for unknown priorities', () => {
+      expect(() => ipcMain.setChannelPriority('bulk', 'high' as any)).to.throw(/priority must be/);
+    });
+  });
+
+  describe('ipcMain.getStats', () => {
+    afterEach(() => {
+      ipcMain.removeAllListeners('counted');
+      ipcMain.resetStats();
+    });
+
+    it('counts the messages of each channel in both processes', async () => {
+      const received: number[] = [];
+      ipcMain.on('counted', (e, i) => received.push(i));
+
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: false
+        }
+      });
+      await w.loadURL('about:blank');
+      ipcMain.resetStats();
+      const rendererStats = await w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.resetStats()
+        for (let i = 0; i < 3; i++) ipcRenderer.send('counted', i)
+        ipcRenderer.getStats()
+      }`);
+      await waitUntil(() => received.length === 3);
+
+      const mainStats = ipcMain.getStats().find(stats => stats.channel === 'counted');
+      expect(mainStats).to.not.be.undefined();
+      expect(mainStats!.messages).to.equal(3);
+      expect(mainStats!.bytes).to.be.greaterThan(0);
+      expect(mainStats!.handlerTime).to.be.at.least(0);
+
+      const sentStats = rendererStats.find((stats: Electron.IpcRendererChannelStats) => stats.channel === 'counted');
+      expect(sentStats.messages).to.equal(3);
+      expect(sentStats.bytes).to.equal(mainStats!.bytes);
+      expect(sentStats.serializationTime).to.be.a('number');
+    });
+
+    it('does not count internal channels', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      ipcMain.resetStats();
+      await w.webContents.executeJavaScript('1');
+      expect(ipcMain.getStats()).to.deep.equal([]);
+    });
+
+    it('is cleared by resetStats()', async () => {
+      ipcMain.on('counted', () => {});
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: false
+        }
+      });
+      await w.loadURL('about:blank');
+      const message = once(ipcMain, 'counted');
+      w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.send(\'counted\')');
+      await message;
+      expect(ipcMain.getStats()).to.not.be.empty();
+      ipcMain.resetStats();
+      expect(ipcMain.getStats()).to.deep.equal([]);
+    });
+  });
+
+  describe('in worker threads', () => {
+    const startWorker = () => {
+      const worker = new Worker(path.join(fixtures, 'api', 'worker-bridge.js'));
+      defer(() => worker.terminate());
+      return worker;
+    };
+
+    const request = async (worker: Worker, message: any) => {
+      worker.postMessage(message);
+      const [reply] = await once(worker, 'message');
+      return reply;
+    };
+
+    it('handles ipcRenderer.invoke() on the worker thread', async () => {
+      const worker = startWorker();
+      expect(await request(worker, { type: 'handle', channel: 'worker-bridge-echo' })).to.deep.equal({ ok: true });
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      const result = await w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.invoke(\'worker-bridge-echo\', 1, \'a\')');
+      expect(result).to.deep.equal({ senderId: w.webContents.id, args: [1, 'a'] });
+    });
+
+    it('rejects handlers that the main thread already has', async () => {
+      ipcMain.handle('worker-bridge-taken', () => {});
+      defer(() => ipcMain.removeHandler('worker-bridge-taken'));
+      const worker = startWorker();
+      const reply = await request(worker, { type: 'handle', channel: 'worker-bridge-taken' });
+      expect(reply.error).to.match(/second handler/);
+    });
+
+    it('removes the handlers of the worker thread when it exits', async () => {
+      const worker = startWorker();
+      await request(worker, { type: 'handle', channel: 'worker-bridge-exit' });
+      await worker.terminate();
+      await waitUntil(() => {
+        try {
+          ipcMain.handle('worker-bridge-exit', () => {});
+          return true;
+        } catch {
+          return false;
+        }
+      });
+      ipcMain.removeHandler('worker-bridge-exit');
+    });
+
+    it('can use net.fetch() from the worker thread', async () => {
+      const server = http.createServer((req, res) => res.end('hello from main'));
+      defer(() => server.close());
+      const { url } = await listen(server);
+      const worker = startWorker();
+      expect(await request(worker, { type: 'fetch', url })).to.deep.equal({ status: 200, text: 'hello from main' });
+    });
+  });
 });
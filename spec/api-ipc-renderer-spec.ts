@@ -117,6 +117,40 @@ describe('ipcRenderer module', () => {
       expect(childValue.hello).to.equal('world');
       expect(childValue.child).to.equal(childValue);
     });
+
+    it('preserves JSON-like values exactly', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const records = [{ id: 1, name: 'a', tags: [] }, { id: 2, name: 'b', tags: ['x'] }, { name: 'c', id: 3 }]
+        const numbers = [0, -0, -1, 2147483647, -2147483648, 2147483648, 1.5, NaN, Infinity]
+        const strings = ['', 'latin1 \\u00e9', 'two-byte \\u2603', '\\ud83d\\ude00']
+        const nested = { a: { b: { c: [null, undefined, true, false] } }, 1: 'one', '': 'empty' }
+        ipcRenderer.send('message', records, numbers, strings, nested)
+      }`);
+
+      const [, records, numbers, strings, nested] = await once(ipcMain, 'message');
+      expect(records).to.deep.equal([{ id: 1, name: 'a', tags: [] }, { id: 2, name: 'b', tags: ['x'] }, { name: 'c', id: 3 }]);
+      expect(Object.keys(records[2])).to.deep.equal(['name', 'id']);
+      expect(numbers).to.deep.equal([0, -0, -1, 2147483647, -2147483648, 2147483648, 1.5, NaN, Infinity]);
+      expect(Object.is(numbers[1], -0)).to.be.true();
+      expect(strings).to.deep.equal(['', 'latin1 é', 'two-byte ☃', '😀']);
+      expect(nested).to.deep.equal({ a: { b: { c: [null, undefined, true, false] } }, 1: 'one', '': 'empty' });
+    });
+
+    it('preserves holes and named properties of arrays', async () => {
+      w.webContents.executeJavaScript(`{
+        const { ipcRenderer } = require('electron')
+        const sparse = [1, , 3]
+        const named = [1, 2]
+        named.extra = 'value'
+        ipcRenderer.send('message', sparse, named)
+      }`);
+
+      const [, sparse, named] = await once(ipcMain, 'message');
+      expect(sparse).to.have.lengthOf(3);
+      expect(1 in sparse).to.be.false();
+      expect(named.extra).to.equal('value');
+    });
   });
 
   describe('sendSync()', () => {
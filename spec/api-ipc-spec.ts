@@ -198,6 +198,133 @@ describe('ipc module', () => {
       expect(received).to.have.lengthOf(1000);
       expect(received).to.deep.equal([...received].sort((a, b) => a - b));
     });
+
+    it('between sendBatched, send, and sendSync is consistent', async () => {
+      const received: number[] = [];
+      ipcMain.on('test-batched', (e, i) => { received.push(i); });
+      ipcMain.on('test-async', (e, i) => { received.push(i); });
+      ipcMain.on('test-sync', (e, i) => { received.push(i); e.returnValue = null; });
+      const done = new Promise<void>(resolve => ipcMain.once('done', () => { resolve(); }));
+      function rendererStressTest () {
+        const { ipcRenderer } = require('electron');
+        for (let i = 0; i < 1000; i++) {
+          switch ((Math.random() * 4) | 0) {
+            case 0:
+            case 1:
+              ipcRenderer.sendBatched('test-batched', i);
+              break;
+            case 2:
+              ipcRenderer.send('test-async', i);
+              break;
+            case 3:
+              ipcRenderer.sendSync('test-sync', i);
+              break;
+          }
+        }
+        ipcRenderer.sendBatched('done');
+      }
+      try {
+        w.webContents.executeJavaScript(`(${rendererStressTest})()`);
+        await done;
+      } finally {
+        ipcMain.removeAllListeners('test-batched');
+        ipcMain.removeAllListeners('test-async');
+        ipcMain.removeAllListeners('test-sync');
+      }
+      expect(received).to.have.lengthOf(1000);
+      expect(received).to.deep.equal([...received].sort((a, b) => a - b));
+    });
+  });
+
+  describe('shared values', () => {
+    let w: BrowserWindow;
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+    });
+    after(async () => {
+      w.destroy();
+      ipcMain.deleteSharedValue('config');
+      ipcMain.deleteSharedValue('large');
+    });
+
+    const getSharedValue = (key: string) =>
+      w.webContents.executeJavaScript(`require('electron').ipcRenderer.getSharedValue(${JSON.stringify(key)})`);
+
+    it('reads values set in the main process', async () => {
+      ipcMain.setSharedValue('config', { theme: 'dark', size: 12 });
+      expect(await getSharedValue('config')).to.deep.equal({ theme: 'dark', size: 12 });
+    });
+
+    it('returns undefined for unknown keys', async () => {
+      expect(await getSharedValue('does-not-exist')).to.be.undefined();
+    });
+
+    it('sees updated and deleted values', async () => {
+      ipcMain.setSharedValue('config', 1);
+      expect(await getSharedValue('config')).to.equal(1);
+      ipcMain.setSharedValue('config', 2);
+      expect(await getSharedValue('config')).to.equal(2);
+      ipcMain.deleteSharedValue('config');
+      expect(await getSharedValue('config')).to.be.undefined();
+    });
+
+    it('keeps working once the values outgrow the shared memory region', async () => {
+      ipcMain.setSharedValue('config', 'before');
+      expect(await getSharedValue('config')).to.equal('before');
+      ipcMain.setSharedValue('large', 'x'.repeat(1024 * 1024));
+      ipcMain.setSharedValue('config', 'after');
+      expect(await getSharedValue('config')).to.equal('after');
+      expect(await getSharedValue('large')).to.have.lengthOf(1024 * 1024);
+    });
+  });
+
+  describe('shared buffers', () => {
+    let w: BrowserWindow;
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+    });
+    after(async () => {
+      w.destroy();
+      ipcMain.deleteSharedBuffer('dataset');
+    });
+
+    const getSharedBuffer = (name: string) =>
+      w.webContents.executeJavaScript(`(() => {
+        const buffer = require('electron').ipcRenderer.getSharedBuffer(${JSON.stringify(name)});
+        return buffer && Array.from(new Uint8Array(buffer));
+      })()`);
+
+    it('maps buffers set in the main process', async () => {
+      ipcMain.setSharedBuffer('dataset', new Uint8Array([1, 2, 3]));
+      expect(await getSharedBuffer('dataset')).to.deep.equal([1, 2, 3]);
+    });
+
+    it('copies the data when it is set', async () => {
+      const data = new Uint8Array([1, 2, 3]);
+      ipcMain.setSharedBuffer('dataset', data.buffer);
+      data[0] = 4;
+      expect(await getSharedBuffer('dataset')).to.deep.equal([1, 2, 3]);
+    });
+
+    it('returns null for unknown and deleted buffers', async () => {
+      expect(await getSharedBuffer('does-not-exist')).to.be.null();
+      ipcMain.setSharedBuffer('dataset', Buffer.from('data'));
+      ipcMain.deleteSharedBuffer('dataset');
+      expect(await getSharedBuffer('dataset')).to.be.null();
+    });
+
+    it('only maps buffers into the allowed origins', async () => {
+      ipcMain.setSharedBuffer('dataset', new Uint8Array([1]), { origins: ['https://example.com'] });
+      expect(await getSharedBuffer('dataset')).to.be.null();
+    });
+
+    it('throws for empty data', () => {
+      expect(() => ipcMain.setSharedBuffer('dataset', new Uint8Array())).to.throw(/must not be empty/);
+    });
   });
 
   describe('MessagePort', () => {
@@ -233,6 +360,36 @@ describe('ipc module', () => {
       expect(ev.senderFrame.routingId).to.equal(w.webContents.mainFrame.routingId);
     });
 
+    it('can transfer an ArrayBuffer to the main process', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      w.loadURL('about:blank');
+      const p = once(ipcMain, 'buffer');
+      const byteLength = await w.webContents.executeJavaScript(`(${function () {
+        const buffer = new ArrayBuffer(1024 * 1024);
+        new Uint8Array(buffer).fill(42);
+        const view = new Uint8Array(buffer, 16, 4);
+        require('electron').ipcRenderer.postMessage('buffer', { buffer, view }, [buffer]);
+        return buffer.byteLength;
+      }})()`);
+      expect(byteLength).to.equal(0);
+      const [ev, msg] = await p;
+      expect(ev.ports).to.deep.equal([]);
+      expect(msg.buffer).to.be.an.instanceOf(ArrayBuffer);
+      expect(msg.buffer.byteLength).to.equal(1024 * 1024);
+      expect(new Uint8Array(msg.buffer).every((b: number) => b === 42)).to.be.true();
+      expect(msg.view.buffer).to.equal(msg.buffer);
+      expect(msg.view.byteOffset).to.equal(16);
+    });
+
+    it('throws when an ArrayBuffer is transferred twice', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      w.loadURL('about:blank');
+      await expect(w.webContents.executeJavaScript(`(${function () {
+        const buffer = new ArrayBuffer(8);
+        require('electron').ipcRenderer.postMessage('buffer', buffer, [buffer, buffer]);
+      }})()`)).to.eventually.be.rejectedWith(/ArrayBuffer is duplicated in transfer/);
+    });
+
     it('can communicate between main and renderer', async () => {
       const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
       w.loadURL('about:blank');
@@ -411,11 +568,6 @@ describe('ipc module', () => {
       it('throws an error when an invalid parameter is sent to postMessage', () => {
         const { port1 } = new MessageChannelMain();
 
-        expect(() => {
-          const buffer = new ArrayBuffer(10) as any;
-          port1.postMessage(null, [buffer]);
-        }).to.throw(/Port at index 0 is not a valid port/);
-
         expect(() => {
           port1.postMessage(null, ['1' as any]);
         }).to.throw(/Port at index 0 is not a valid port/);
@@ -441,6 +593,44 @@ describe('ipc module', () => {
         expect(ev.data).to.equal('hello');
       });
 
+      it('transfers ArrayBuffers', async () => {
+        const { port1, port2 } = new MessageChannelMain();
+        const buffer = new Uint8Array([1, 2, 3]).buffer;
+        port2.postMessage({ buffer }, [buffer]);
+        expect(buffer.byteLength).to.equal(0);
+        port1.start();
+        const [ev] = await once(port1, 'message');
+        expect(new Uint8Array(ev.data.buffer)).to.deep.equal(new Uint8Array([1, 2, 3]));
+      });
+
+      it('throws when an ArrayBuffer is transferred twice', () => {
+        const { port1 } = new MessageChannelMain();
+        const buffer = new ArrayBuffer(10);
+        expect(() => {
+          port1.postMessage(null, [buffer, buffer]);
+        }).to.throw(/ArrayBuffer at index 1 is duplicated in transfer/);
+      });
+
+      it('transfers ArrayBuffers to a WebContents', async () => {
+        const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+        w.loadURL('about:blank');
+        await w.webContents.executeJavaScript(`(${function () {
+          const { ipcRenderer } = require('electron');
+          ipcRenderer.on('port', ev => {
+            const [port] = ev.ports;
+            port.onmessage = (e: MessageEvent) => {
+              ipcRenderer.send('done', Array.from(new Uint8Array(e.data)));
+            };
+          });
+        }})()`);
+        const { port1, port2 } = new MessageChannelMain();
+        const buffer = new Uint8Array([4, 5, 6]).buffer;
+        port1.postMessage(buffer, [buffer]);
+        w.webContents.postMessage('port', null, [port2]);
+        const [, bytes] = await once(ipcMain, 'done');
+        expect(bytes).to.deep.equal([4, 5, 6]);
+      });
+
       it('can pass one end to a WebContents', async () => {
         const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
         w.loadURL('about:blank');
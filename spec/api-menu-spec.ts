@@ -781,6 +781,35 @@ describe('Menu module', function () {
     });
   });
 
+  describe('menu item state', () => {
+    it('is kept natively and updated when the items change', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: 'a', enabled: false },
+        { label: 'b', type: 'checkbox' },
+        { label: 'c', type: 'radio', checked: true },
+        { label: 'd', type: 'radio' }
+      ]) as any;
+      // The state must not be read from JS.
+      menu._isCommandIdEnabled = menu._isCommandIdChecked = menu._isCommandIdVisible = () => {
+        throw new Error('Unexpected call');
+      };
+
+      expect(menu.isEnabledAt(0)).to.be.false();
+      expect(menu.isItemCheckedAt(1)).to.be.false();
+      expect(menu.isItemCheckedAt(2)).to.be.true();
+
+      menu.items[0].enabled = true;
+      menu.items[1].checked = true;
+      menu.items[3].checked = true;
+      menu.items[0].visible = false;
+      expect(menu.isEnabledAt(0)).to.be.true();
+      expect(menu.isVisibleAt(0)).to.be.false();
+      expect(menu.isItemCheckedAt(1)).to.be.true();
+      expect(menu.isItemCheckedAt(2)).to.be.false();
+      expect(menu.isItemCheckedAt(3)).to.be.true();
+    });
+  });
+
   describe('Menu.popup', () => {
     let w: BrowserWindow;
     let menu: Menu;
@@ -1,6 +1,8 @@
 import { expect } from 'chai';
 import { nativeImage } from 'electron/common';
 import { ifdescribe, ifit } from './lib/spec-helpers';
+import * as fs from 'node:fs';
+import * as os from 'node:os';
 import * as path from 'node:path';
 
 describe('nativeImage module', () => {
@@ -120,6 +122,32 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('createFromBitmap(buffer, { shared: true })', () => {
+    it('uses the memory of the buffer', () => {
+      const imageA = nativeImage.createFromPath(imageLogo.path);
+      const bitmap = imageA.toBitmap();
+      const imageB = nativeImage.createFromBitmap(bitmap, { ...imageA.getSize(), shared: true });
+      expect(imageB.toBitmap().equals(bitmap)).to.be.true();
+
+      const view = imageB.getBitmapView();
+      expect(view.buffer).to.equal(bitmap.buffer);
+      expect(view.byteOffset).to.equal(bitmap.byteOffset);
+      expect(view.equals(bitmap)).to.be.true();
+
+      bitmap.fill(0);
+      expect(imageB.getBitmapView().every(byte => byte === 0)).to.be.true();
+    });
+
+    it('returns a copy from getBitmapView() otherwise', () => {
+      const imageA = nativeImage.createFromPath(imageLogo.path);
+      const bitmap = imageA.toBitmap();
+      const imageB = nativeImage.createFromBitmap(bitmap, imageA.getSize());
+      const view = imageB.getBitmapView();
+      expect(view.buffer).to.not.equal(bitmap.buffer);
+      expect(view.equals(bitmap)).to.be.true();
+    });
+  });
+
   describe('createFromBuffer(buffer, options)', () => {
     it('returns an empty image when the buffer is empty', () => {
       expect(nativeImage.createFromBuffer(Buffer.from([])).isEmpty()).to.be.true();
@@ -170,6 +198,47 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('createFromPathAsync(path)', () => {
+    it('resolves with the image read from the given path', async () => {
+      const image = await nativeImage.createFromPathAsync(imageLogo.path);
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 });
+      const expected = nativeImage.createFromPath(imageLogo.path);
+      expect(image.toBitmap().equals(expected.toBitmap())).to.be.true();
+    });
+
+    it('resolves with an empty image for a missing file', async () => {
+      const image = await nativeImage.createFromPathAsync(path.join(fixturesPath, 'missing.png'));
+      expect(image.isEmpty()).to.be.true();
+    });
+  });
+
+  describe('decodeAsync(buffer, options)', () => {
+    it('resolves with an image decoded from the given buffer', async () => {
+      const imageA = nativeImage.createFromPath(imageLogo.path);
+
+      const imageB = await nativeImage.decodeAsync(imageA.toPNG());
+      expect(imageB.getSize()).to.deep.equal({ width: 538, height: 190 });
+      expect(imageA.toBitmap().equals(imageB.toBitmap())).to.be.true();
+
+      const imageC = await nativeImage.decodeAsync(imageA.toJPEG(100));
+      expect(imageC.getSize()).to.deep.equal({ width: 538, height: 190 });
+
+      const imageD = await nativeImage.decodeAsync(imageA.toBitmap(),
+        { width: 538, height: 190, scaleFactor: 2.0 });
+      expect(imageD.getSize()).to.deep.equal({ width: 269, height: 95 });
+    });
+
+    it('resolves with an empty image when the buffer can not be decoded', async () => {
+      expect((await nativeImage.decodeAsync(Buffer.from([]))).isEmpty()).to.be.true();
+      const image = await nativeImage.decodeAsync(Buffer.from([1, 2, 3, 4]), { width: 100, height: 100 });
+      expect(image.isEmpty()).to.be.true();
+    });
+
+    it('rejects on invalid arguments', async () => {
+      await expect(nativeImage.decodeAsync(null as any)).to.eventually.be.rejectedWith('buffer must be a node Buffer');
+    });
+  });
+
   describe('createFromDataURL(dataURL)', () => {
     it('returns an empty image from the empty string', () => {
       expect(nativeImage.createFromDataURL('').isEmpty()).to.be.true();
@@ -271,6 +340,26 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('toPNGAsync()', () => {
+    it('resolves with the same data as toPNG()', async () => {
+      const image = nativeImage.createFromPath(imageLogo.path);
+      expect((await image.toPNGAsync()).equals(image.toPNG())).to.be.true();
+      expect((await image.toPNGAsync({ scaleFactor: 2.0 })).equals(image.toPNG({ scaleFactor: 2.0 }))).to.be.true();
+
+      const resized = image.resize({ width: 100 });
+      expect((await resized.toPNGAsync()).equals(resized.toPNG())).to.be.true();
+    });
+  });
+
+  describe('toJPEGAsync()', () => {
+    it('resolves with JPEG encoded data', async () => {
+      const image = nativeImage.createFromPath(imageLogo.path);
+      const decoded = nativeImage.createFromBuffer(await image.toJPEGAsync(100));
+      expect(decoded.getSize()).to.deep.equal({ width: 538, height: 190 });
+      expect(await nativeImage.createEmpty().toJPEGAsync(100)).to.have.lengthOf(0);
+    });
+  });
+
   describe('createFromPath(path)', () => {
     it('returns an empty image for invalid paths', () => {
       expect(nativeImage.createFromPath('').isEmpty()).to.be.true();
@@ -301,6 +390,24 @@ describe('nativeImage module', () => {
       expect(image.getSize()).to.deep.equal({ width: 538, height: 190 });
     });
 
+    it('reloads images whose files changed', () => {
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-native-image-'));
+      try {
+        const imagePath = path.join(dir, 'image.png');
+        fs.copyFileSync(path.join(fixturesPath, 'assets', 'logo.png'), imagePath);
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 });
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 });
+
+        fs.copyFileSync(path.join(fixturesPath, 'assets', '3x3.png'), imagePath);
+        expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 3, height: 3 });
+
+        fs.rmSync(imagePath);
+        expect(nativeImage.createFromPath(imagePath).isEmpty()).to.be.true();
+      } finally {
+        fs.rmSync(dir, { recursive: true, force: true });
+      }
+    });
+
     ifit(process.platform === 'darwin')('Gets an NSImage pointer on macOS', function () {
       const imagePath = `${path.join(fixturesPath, 'api')}${path.sep}..${path.sep}${path.join('assets', 'logo.png')}`;
       const image = nativeImage.createFromPath(imagePath);
@@ -378,6 +485,63 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('resizeAsync(options)', () => {
+    it('resolves with a resized image', async () => {
+      const image = nativeImage.createFromPath(path.join(fixturesPath, 'assets', 'logo.png'));
+      for (const [resizeTo, expectedSize] of new Map([
+        [{}, { width: 538, height: 190 }],
+        [{ width: 269 }, { width: 269, height: 95 }],
+        [{ height: 200 }, { width: 566, height: 200 }],
+        [{ width: 80, height: 65 }, { width: 80, height: 65 }],
+        [{ width: -1, height: -1 }, { width: 0, height: 0 }]
+      ])) {
+        const resized = await image.resizeAsync(resizeTo);
+        expect(resized.getSize()).to.deep.equal(expectedSize);
+      }
+    });
+
+    it('resizes every representation', async () => {
+      const image = nativeImage.createFromPath(path.join(fixturesPath, 'assets', 'logo.png'));
+      image.addRepresentation({ scaleFactor: 2.0, buffer: image.resize({ width: 1076 }).toPNG() });
+      const resized = await image.resizeAsync({ width: 100, height: 50 });
+      expect(resized.getScaleFactors()).to.deep.equal([1, 2]);
+      expect(resized.getSize(2.0)).to.deep.equal({ width: 100, height: 50 });
+      expect(resized.toBitmap({ scaleFactor: 2.0 })).to.have.lengthOf(200 * 100 * 4);
+    });
+
+    it('resolves with an empty image when called on an empty image', async () => {
+      expect((await nativeImage.createEmpty().resizeAsync({ width: 1, height: 1 })).isEmpty()).to.be.true();
+    });
+  });
+
+  describe('resizeImages(requests)', () => {
+    it('resolves with the resized images in order', async () => {
+      const logo = nativeImage.createFromPath(imageLogo.path);
+      const images = await nativeImage.resizeImages([
+        { image: logo, width: 269 },
+        { image: logo, height: 200, quality: 'good' },
+        { image: nativeImage.createFromPath(image3x3.path), width: 6, height: 9 },
+        { image: logo, width: 0, height: 0 },
+        { image: nativeImage.createEmpty(), width: 1, height: 1 }
+      ]);
+      expect(images.map(image => image.getSize())).to.deep.equal([
+        { width: 269, height: 95 },
+        { width: 566, height: 200 },
+        { width: 6, height: 9 },
+        { width: 0, height: 0 },
+        { width: 0, height: 0 }
+      ]);
+    });
+
+    it('resolves with an empty array for no requests', async () => {
+      expect(await nativeImage.resizeImages([])).to.deep.equal([]);
+    });
+
+    it('rejects when a request has no image', async () => {
+      await expect(nativeImage.resizeImages([{ width: 1 } as any])).to.eventually.be.rejectedWith('image must be a NativeImage');
+    });
+  });
+
   describe('crop(bounds)', () => {
     it('returns an empty image when called on an empty image', () => {
       expect(nativeImage.createEmpty().crop({ width: 1, height: 2, x: 0, y: 0 }).isEmpty()).to.be.true();
@@ -408,6 +572,17 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('release()', () => {
+    it('empties the image', () => {
+      const image = nativeImage.createFromPath(path.join(fixturesPath, 'assets', 'logo.png'));
+      const crop = image.crop({ width: 25, height: 64, x: 0, y: 0 });
+      image.release();
+      expect(image.isEmpty()).to.be.true();
+      expect(image.toBitmap()).to.have.lengthOf(0);
+      expect(crop.getSize()).to.deep.equal({ width: 25, height: 64 });
+    });
+  });
+
   describe('getAspectRatio()', () => {
     it('returns an aspect ratio of an empty image', () => {
       expect(nativeImage.createEmpty().getAspectRatio()).to.equal(1.0);
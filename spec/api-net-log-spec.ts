@@ -118,6 +118,59 @@ describe('netLog module', () => {
     expect(JSON.parse(dump).events.some((x: any) => x.params && x.params.bytes && Buffer.from(x.params.bytes, 'base64').includes(unique))).to.be.true('uuid present in dump');
   });
 
+  describe('recording', () => {
+    afterEach(async () => {
+      if (testNetLog().currentlyRecording) {
+        await testNetLog().stopRecording();
+      }
+    });
+
+    it('dumps the recent events on demand', async () => {
+      await testNetLog().startRecording();
+      expect(testNetLog().currentlyRecording).to.be.true('currently recording');
+      const unique = require('uuid').v4();
+      await new Promise<void>((resolve) => {
+        const req = net.request(`${serverUrl}/${unique}`);
+        req.on('response', (response) => {
+          response.on('data', () => {});
+          response.on('end', () => resolve());
+        });
+        req.end();
+      });
+      await testNetLog().dumpRecording(dumpFileDynamic);
+      expect(testNetLog().currentlyRecording).to.be.true('still recording');
+      const dump = JSON.parse(fs.readFileSync(dumpFileDynamic, 'utf8'));
+      expect(dump.constants).to.be.an('object');
+      expect(JSON.stringify(dump.events)).to.contain(unique);
+    });
+
+    it('can be dumped more than once', async () => {
+      await testNetLog().startRecording({ maxSize: 1024 * 1024 });
+      await testNetLog().dumpRecording(dumpFileDynamic);
+      await testNetLog().dumpRecording(dumpFile);
+      expect(JSON.parse(fs.readFileSync(dumpFile, 'utf8')).events).to.be.an('array');
+    });
+
+    it('stops recording', async () => {
+      await testNetLog().startRecording();
+      await testNetLog().stopRecording();
+      expect(testNetLog().currentlyRecording).to.be.false('currently recording');
+      await expect(testNetLog().dumpRecording(dumpFileDynamic)).to.be.rejectedWith('No net log recording in progress');
+    });
+
+    it('runs alongside startLogging()', async () => {
+      await testNetLog().startRecording();
+      await testNetLog().startLogging(dumpFile);
+      await testNetLog().stopLogging();
+      expect(testNetLog().currentlyRecording).to.be.true('currently recording');
+    });
+
+    it('throws with invalid options', () => {
+      expect(() => testNetLog().startRecording({ captureMode: 'aoeu' as any })).to.throw(/Invalid value for captureMode/);
+      expect(() => testNetLog().startRecording({ maxSize: 0 })).to.throw(/Invalid value for maxSize/);
+    });
+  });
+
   ifit(process.platform !== 'linux')('should begin and end logging automatically when --log-net-log is passed', async () => {
     const appProcess = ChildProcess.spawn(process.execPath,
       [appPath], {
@@ -1,6 +1,8 @@
 import { expect } from 'chai';
 import { net, ClientRequest, ClientRequestConstructorOptions, utilityProcess } from 'electron/main';
+import * as fs from 'node:fs';
 import * as http from 'node:http';
+import * as os from 'node:os';
 import * as path from 'node:path';
 import * as url from 'node:url';
 import { once } from 'node:events';
@@ -817,6 +819,22 @@ describe('net module', () => {
         }).to.throw(/`name` is required for removeHeader\(name\)/);
       });
 
+      test('should send requests with an explicit priority', async () => {
+        const serverUrl = await respondOnce.toSingleURL((request, response) => {
+          response.end('ok');
+        });
+        const urlRequest = net.request({ url: serverUrl, priority: 'highest', priorityIncremental: true });
+        const response = await getResponse(urlRequest);
+        expect(response.statusCode).to.equal(200);
+        expect(await collectStreamBody(response)).to.equal('ok');
+      });
+
+      test('should throw when given an invalid priority', () => {
+        expect(() => {
+          net.request({ url: 'https://test', priority: 'urgent' as any });
+        }).to.throw(/priority should be one of/);
+      });
+
       test('should follow redirect when no redirect handler is provided', async () => {
         const requestUrl = '/302';
         const serverUrl = await respondOnce.toRoutes({
@@ -1113,6 +1131,24 @@ describe('net module', () => {
         await collectStreamBody(response);
       });
 
+      test('should report the connection the response was received on', async () => {
+        const serverUrl = await respondNTimes.toSingleURL((request, response) => {
+          response.end();
+        }, 2);
+
+        const first = await getResponse(net.request(serverUrl));
+        await collectStreamBody(first);
+        expect(first.connectionInfo.protocol).to.be.a('string');
+        expect(first.connectionInfo.socketReused).to.be.false();
+        expect(first.connectionInfo.connectTime).to.be.a('number').and.to.be.at.least(0);
+        expect(first.connectionInfo.remoteAddress).to.equal('127.0.0.1');
+
+        const second = await getResponse(net.request(serverUrl));
+        await collectStreamBody(second);
+        expect(second.connectionInfo.socketReused).to.be.true();
+        expect(second.connectionInfo.connectTime).to.equal(0);
+      });
+
       test('should discard duplicate headers', async () => {
         const includedHeader = 'max-forwards';
         const discardableHeader = 'Max-Forwards';
@@ -1613,4 +1649,111 @@ describe('net module', () => {
       });
     });
   }
+
+  describe('downloadToFile', () => {
+    let tmpDir: string;
+    beforeEach(() => {
+      tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-net-download-'));
+    });
+    afterEach(() => {
+      fs.rmSync(tmpDir, { recursive: true, force: true });
+    });
+
+    it('writes the body to the file without emitting data events', async () => {
+      const data = randomBuffer(kOneMegaByte * 4);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.setHeader('Content-Length', data.length);
+        response.end(data);
+      });
+      const downloadPath = path.join(tmpDir, 'download.bin');
+      const urlRequest = net.request({ url: serverUrl, downloadToFile: downloadPath });
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+      let dataEvents = 0;
+      let lastProgress = 0;
+      response.on('data', () => { dataEvents++; });
+      response.on('download-progress', (current: number) => { lastProgress = current; });
+      await once(response, 'end');
+      expect(dataEvents).to.equal(0);
+      expect(lastProgress).to.equal(data.length);
+      expect(fs.readFileSync(downloadPath).equals(data)).to.be.true();
+    });
+
+    it('removes the file when the request fails', async () => {
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.setHeader('Content-Length', kOneMegaByte);
+        response.write(randomBuffer(kOneKiloByte));
+        setTimeout(10).then(() => response.destroy());
+      });
+      const downloadPath = path.join(tmpDir, 'download.bin');
+      const urlRequest = net.request({ url: serverUrl, downloadToFile: downloadPath });
+      const response = await getResponse(urlRequest);
+      response.on('data', () => {});
+      await expect(once(response, 'end')).to.eventually.be.rejected();
+      expect(fs.existsSync(downloadPath)).to.be.false();
+    });
+
+    it('throws when the path is not absolute', () => {
+      expect(() => {
+        net.request({ url: 'https://test', downloadToFile: 'relative/path' });
+      }).to.throw(/downloadToFile must be an absolute path/);
+    });
+  });
+
+  describe('uploadFile', () => {
+    let tmpDir: string;
+    beforeEach(() => {
+      tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-net-upload-'));
+    });
+    afterEach(() => {
+      fs.rmSync(tmpDir, { recursive: true, force: true });
+    });
+
+    it('sends the file as the request body', async () => {
+      const data = randomBuffer(kOneMegaByte * 4);
+      const uploadPath = path.join(tmpDir, 'upload.bin');
+      fs.writeFileSync(uploadPath, data);
+      let received: Buffer | undefined;
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        received = await collectStreamBodyBuffer(request);
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.uploadFile(uploadPath);
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+      expect(received!.equals(data)).to.be.true();
+    });
+
+    it('sends a range of the file', async () => {
+      const data = randomBuffer(kOneKiloByte * 4);
+      const uploadPath = path.join(tmpDir, 'upload.bin');
+      fs.writeFileSync(uploadPath, data);
+      let received: Buffer | undefined;
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        received = await collectStreamBodyBuffer(request);
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.uploadFile(uploadPath, { offset: 100, length: 1000 });
+      await getResponse(urlRequest);
+      expect(received!.equals(data.subarray(100, 1100))).to.be.true();
+    });
+
+    it('throws when the path is not absolute', () => {
+      const urlRequest = net.request({ method: 'POST', url: 'https://test' });
+      expect(() => {
+        urlRequest.uploadFile('relative/path');
+      }).to.throw(/filePath must be an absolute path/);
+    });
+
+    it('throws after the first write', () => {
+      const urlRequest = net.request({ method: 'POST', url: 'https://test' });
+      urlRequest.write('foo');
+      expect(() => {
+        urlRequest.uploadFile(path.join(tmpDir, 'upload.bin'));
+      }).to.throw(/uploadFile can only be called before the request is started/);
+      urlRequest.abort();
+    });
+  });
 });
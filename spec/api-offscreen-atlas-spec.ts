@@ -0,0 +1,75 @@
+import { expect } from 'chai';
+import { BrowserWindow, OffscreenAtlas } from 'electron/main';
+import { once } from 'node:events';
+import * as path from 'node:path';
+import { closeAllWindows } from './lib/window-helpers';
+
+const fixtures = path.resolve(__dirname, 'fixtures');
+
+describe('OffscreenAtlas module', () => {
+  afterEach(closeAllWindows);
+
+  const createOffscreenWindow = () => new BrowserWindow({
+    width: 100,
+    height: 100,
+    show: false,
+    webPreferences: { backgroundThrottling: false, offscreen: true }
+  });
+
+  it('sets the correct class name on the prototype', () => {
+    expect(OffscreenAtlas.prototype.constructor.name).to.equal('OffscreenAtlas');
+  });
+
+  it('validates its options', () => {
+    expect(() => new (OffscreenAtlas as any)()).to.throw(/width and a height/);
+    expect(() => new OffscreenAtlas({ width: 0, height: 100 })).to.throw(/width and a height/);
+    expect(() => new OffscreenAtlas({ width: 100, height: 100000 })).to.throw(/width and a height/);
+    expect(new OffscreenAtlas({ width: 100, height: 100 }).frameRate).to.equal(60);
+    expect(new OffscreenAtlas({ width: 100, height: 100, frameRate: 1000 }).frameRate).to.equal(240);
+  });
+
+  it('only accepts offscreen WebContents without shared textures', () => {
+    const atlas = new OffscreenAtlas({ width: 100, height: 100 });
+    const w = new BrowserWindow({ show: false });
+    expect(() => atlas.addWebContents(w.webContents, { x: 0, y: 0 })).to.throw(/offscreen WebContents/);
+    const c = new BrowserWindow({ show: false, webPreferences: { offscreen: { useSharedTexture: true } } });
+    expect(() => atlas.addWebContents(c.webContents, { x: 0, y: 0 })).to.throw(/shared textures/);
+  });
+
+  it('paints the frames of its WebContents in one event', async () => {
+    const atlas = new OffscreenAtlas({ width: 400, height: 400, frameRate: 30 });
+    const w1 = createOffscreenWindow();
+    const w2 = createOffscreenWindow();
+    atlas.addWebContents(w1.webContents, { x: 0, y: 0 });
+    atlas.addWebContents(w2.webContents, { x: 200, y: 0 });
+    expect(w1.webContents.getFrameRate()).to.equal(30);
+
+    let ownPaints = 0;
+    w1.webContents.on('paint', () => { ownPaints++; });
+    w2.webContents.on('paint', () => { ownPaints++; });
+
+    const painted = new Set<number>();
+    const bothPainted = new Promise<Electron.NativeImage>((resolve) => {
+      atlas.on('paint', (event, image, dirtyRect, regions) => {
+        for (const region of regions) {
+          const origin = region.webContentsId === w1.webContents.id ? 0 : 200;
+          expect(region.bounds.x).to.equal(origin);
+          expect(region.dirtyRect.x).to.be.at.least(origin);
+          painted.add(region.webContentsId);
+        }
+        if (painted.size === 2) resolve(image);
+      });
+    });
+    await Promise.all([
+      w1.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html')),
+      w2.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+    ]);
+    const image = await bothPainted;
+    expect(image.getSize()).to.deep.equal({ width: 400, height: 400 });
+    expect(ownPaints).to.equal(0);
+
+    atlas.removeWebContents(w1.webContents);
+    w1.webContents.invalidate();
+    await once(w1.webContents, 'paint');
+  });
+});
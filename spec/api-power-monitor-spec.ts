@@ -192,5 +192,35 @@ describe('powerMonitor', () => {
         expect(powerMonitor.isOnBatteryPower()).to.be.a('boolean');
       });
     });
+
+    describe('powerMonitor.setPolicy', () => {
+      afterEach(() => {
+        powerMonitor.setPolicy([]);
+      });
+
+      it('accepts valid rules', () => {
+        expect(() => {
+          powerMonitor.setPolicy([
+            { when: 'on-battery', maxOffscreenFrameRate: 30, pauseRendererProcessPools: true },
+            { when: 'thermal-serious', backgroundThrottlingPolicy: { interval: 1000, budget: 10 }, pauseLowPriorityDownloads: true }
+          ]);
+        }).to.not.throw();
+      });
+
+      it('rejects invalid rules', () => {
+        expect(() => {
+          powerMonitor.setPolicy({} as any);
+        }).to.throw(/rules must be an array/);
+        expect(() => {
+          powerMonitor.setPolicy([{ when: 'sometimes' } as any]);
+        }).to.throw(/rules must be an array/);
+        expect(() => {
+          powerMonitor.setPolicy([{ when: 'on-battery', maxOffscreenFrameRate: 0 }]);
+        }).to.throw(/rules must be an array/);
+        expect(() => {
+          powerMonitor.setPolicy([{ when: 'on-battery', backgroundThrottlingPolicy: { interval: 10, budget: 20 } }]);
+        }).to.throw(/rules must be an array/);
+      });
+    });
   });
 });
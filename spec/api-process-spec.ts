@@ -136,6 +136,25 @@ describe('process module', () => {
       });
     });
 
+    describe('process.getEventEmitterStats()', () => {
+      afterEach(closeAllWindows);
+
+      it('returns the counters of emitted events', () => {
+        const stats = process.getEventEmitterStats();
+        expect(stats.emitted).to.be.a('number').and.be.at.least(0);
+        expect(stats.suppressed).to.be.a('number').and.be.at.least(0);
+      });
+
+      it('counts the events that had no listeners', async () => {
+        const before = process.getEventEmitterStats();
+        const w = new BrowserWindow({ show: false });
+        await w.loadURL('about:blank');
+        const after = process.getEventEmitterStats();
+        expect(after.emitted).to.be.greaterThan(before.emitted);
+        expect(after.suppressed).to.be.greaterThan(before.suppressed);
+      });
+    });
+
     describe('process.getProcessMemoryInfo()', () => {
       it('resolves promise successfully with valid data', async () => {
         const memoryInfo = await process.getProcessMemoryInfo();
@@ -203,5 +222,43 @@ describe('process module', () => {
         expect(success).to.be.false();
       });
     });
+
+    describe('process.saveHeapSnapshot()', () => {
+      const filePath = path.join(app.getPath('temp'), 'test-save.heapsnapshot');
+      afterEach(() => {
+        process.stopHeapSampling();
+        try {
+          fs.unlinkSync(filePath);
+        } catch {
+          // ignore error
+        }
+      });
+
+      it('writes a heap snapshot in the background', async () => {
+        await process.saveHeapSnapshot(filePath);
+        const snapshot = JSON.parse(fs.readFileSync(filePath, 'utf8'));
+        expect(snapshot).to.have.property('snapshot');
+        expect(snapshot.nodes).to.be.an('array').that.is.not.empty();
+      });
+
+      it('writes the sampled allocations', async () => {
+        expect(process.startHeapSampling({ samplingInterval: 1024 })).to.be.true();
+        const retained = Array.from({ length: 1e5 }, (_, i) => ({ i }));
+        await process.saveHeapSnapshot(filePath, { type: 'sampling' });
+        expect(retained).to.have.lengthOf(1e5);
+        const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'));
+        expect(profile.head.callFrame.functionName).to.equal('(root)');
+        expect(profile.samples).to.be.an('array').that.is.not.empty();
+      });
+
+      it('rejects when sampling was not started', async () => {
+        await expect(process.saveHeapSnapshot(filePath, { type: 'sampling' })).to.eventually.be.rejectedWith(/Failed to save the heap sampling profile/);
+      });
+
+      it('rejects on failure', async () => {
+        await expect(process.saveHeapSnapshot('')).to.eventually.be.rejectedWith(/Failed to save the heap snapshot/);
+        await expect(process.saveHeapSnapshot(filePath, { type: 'bogus' as any })).to.eventually.be.rejectedWith(/type must be/);
+      });
+    });
   });
 });
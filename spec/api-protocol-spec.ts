@@ -453,6 +453,21 @@ describe('protocol module', () => {
         expect(r.data).to.have.lengthOf(data.length);
       });
 
+      it('keeps data intact when many chunks are buffered at once', async () => {
+        const data = Buffer.alloc(4 * 1024 * 1024);
+        for (let i = 0; i < data.length; i++) data[i] = 97 + (i % 26);
+        registerStreamProtocol(protocolName, (request, callback) => {
+          const body = new stream.PassThrough();
+          for (let offset = 0; offset < data.length; offset += 16 * 1024) {
+            body.write(data.subarray(offset, offset + 16 * 1024));
+          }
+          body.end();
+          callback(body);
+        });
+        const r = await ajax(protocolName + '://fake-host');
+        expect(r.data).to.equal(data.toString());
+      });
+
       it('can handle a stream completing while writing', async () => {
         function dumbPassthrough () {
           return new stream.Transform({
@@ -1360,6 +1375,72 @@ describe('protocol module', () => {
       expect(body.trimEnd()).to.equal('hello world');
     });
 
+    describe('with cache enabled', () => {
+      afterEach(() => { protocol.unhandle('test-scheme'); });
+
+      it('serves fresh responses without calling the handler', async () => {
+        let calls = 0;
+        protocol.handle('test-scheme', () => {
+          calls++;
+          return new Response('hello', { headers: { 'cache-control': 'max-age=60' } });
+        }, { cache: true });
+
+        expect(await net.fetch('test-scheme://foo').then(r => r.text())).to.equal('hello');
+        expect(await net.fetch('test-scheme://foo').then(r => r.text())).to.equal('hello');
+        expect(calls).to.equal(1);
+      });
+
+      it('does not store responses with no-store', async () => {
+        let calls = 0;
+        protocol.handle('test-scheme', () => {
+          calls++;
+          return new Response('hello', { headers: { 'cache-control': 'no-store' } });
+        }, { cache: true });
+
+        await net.fetch('test-scheme://foo').then(r => r.text());
+        await net.fetch('test-scheme://foo').then(r => r.text());
+        expect(calls).to.equal(2);
+      });
+
+      it('revalidates stale responses with their ETag', async () => {
+        const conditions: (string | null)[] = [];
+        protocol.handle('test-scheme', (req) => {
+          conditions.push(req.headers.get('if-none-match'));
+          if (req.headers.get('if-none-match') === '"v1"') {
+            return new Response(null, { status: 304 });
+          }
+          return new Response('hello', { headers: { 'cache-control': 'no-cache', etag: '"v1"' } });
+        }, { cache: true });
+
+        expect(await net.fetch('test-scheme://foo').then(r => r.text())).to.equal('hello');
+        const resp = await net.fetch('test-scheme://foo');
+        expect(resp.status).to.equal(200);
+        expect(await resp.text()).to.equal('hello');
+        expect(conditions).to.deep.equal([null, '"v1"']);
+      });
+    });
+
+    it('can forward range requests to file', async () => {
+      protocol.handle('test-scheme', () => net.fetch(url.pathToFileURL(path.join(__dirname, 'fixtures', 'hello.txt')).toString()));
+      defer(() => { protocol.unhandle('test-scheme'); });
+
+      const body = await net.fetch('test-scheme://foo', { headers: { Range: 'bytes=6-10' } }).then(r => r.text());
+      expect(body).to.equal('world');
+    });
+
+    it('forwards file responses with their headers', async () => {
+      protocol.handle('test-scheme', (req) => net.fetch(url.pathToFileURL(path.join(__dirname, 'fixtures', 'hello.txt')).toString()).then(resp => {
+        resp.headers.set('x-served-by', 'file');
+        return resp;
+      }));
+      defer(() => { protocol.unhandle('test-scheme'); });
+
+      const resp = await net.fetch('test-scheme://foo');
+      expect(resp.headers.get('x-served-by')).to.equal('file');
+      expect(resp.headers.get('content-type')).to.match(/^text\/plain/);
+      expect((await resp.text()).trimEnd()).to.equal('hello world');
+    });
+
     it('can receive simple request body', async () => {
       protocol.handle('test-scheme', (req) => new Response(req.body));
       defer(() => { protocol.unhandle('test-scheme'); });
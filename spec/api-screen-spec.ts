@@ -22,6 +22,26 @@ describe('screen module', () => {
     });
   });
 
+  describe('screen.getDisplaySnapshot()', () => {
+    it('returns the same frozen snapshot until the displays change', () => {
+      const snapshot = screen.getDisplaySnapshot();
+      expect(snapshot.version).to.equal(screen.getDisplaysVersion());
+      expect(snapshot.displays).to.deep.equal(screen.getAllDisplays());
+      expect(Object.isFrozen(snapshot.displays[0].bounds)).to.be.true();
+      expect(screen.getDisplaySnapshot()).to.equal(snapshot);
+    });
+  });
+
+  describe('\'cursor-moved\' event', () => {
+    it('can be listened to and removed', () => {
+      const listener = () => {};
+      screen.on('cursor-moved', listener);
+      expect(screen.listenerCount('cursor-moved')).to.equal(1);
+      screen.removeListener('cursor-moved', listener);
+      expect(screen.listenerCount('cursor-moved')).to.equal(0);
+    });
+  });
+
   describe('screen.getPrimaryDisplay()', () => {
     let display: Display | null = null;
 
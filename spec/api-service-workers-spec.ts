@@ -4,7 +4,7 @@ import * as path from 'node:path';
 import { session, webContents, WebContents } from 'electron/main';
 import { expect } from 'chai';
 import { v4 } from 'uuid';
-import { listen } from './lib/spec-helpers';
+import { listen, waitUntil } from './lib/spec-helpers';
 import { on, once } from 'node:events';
 
 const partition = 'service-workers-spec';
@@ -39,6 +39,7 @@ describe('session.serviceWorkers', () => {
   });
 
   afterEach(async () => {
+    ses.serviceWorkers.setEventFilter(null);
     w.destroy();
     server.close();
     await ses.clearStorageData();
@@ -90,4 +91,49 @@ describe('session.serviceWorkers', () => {
       expect(messages['error log']).to.have.property('level', 3);
     });
   });
+
+  describe('setEventFilter()', () => {
+    it('drops the console messages below the minimum level', async () => {
+      ses.serviceWorkers.setEventFilter({ minimumLevel: 'warning' });
+      const messages: string[] = [];
+      w.loadURL(`${baseUrl}/logs.html`);
+      for await (const [, details] of on(ses.serviceWorkers, 'console-message')) {
+        messages.push(details.message);
+        if (details.message === 'error log') break;
+      }
+      expect(messages).to.deep.equal(['warn log', 'error log']);
+    });
+
+    it('drops the events of the service workers outside of the scopes', async () => {
+      ses.serviceWorkers.setEventFilter({ scopes: ['http://other.test/*'] });
+      let emitted = false;
+      const listener = () => { emitted = true; };
+      ses.serviceWorkers.on('console-message', listener);
+      ses.serviceWorkers.on('registration-completed', listener);
+      w.loadURL(`${baseUrl}/index.html`);
+      await waitUntil(() => Object.keys(ses.serviceWorkers.getAllRunning()).length > 0);
+      ses.serviceWorkers.off('console-message', listener);
+      ses.serviceWorkers.off('registration-completed', listener);
+      expect(emitted).to.be.false();
+    });
+
+    it('throws for invalid filters', () => {
+      expect(() => ses.serviceWorkers.setEventFilter({ minimumLevel: 'loud' as any })).to.throw(/Invalid level loud/);
+      expect(() => ses.serviceWorkers.setEventFilter({ scopes: ['not a pattern'] })).to.throw(/Invalid url pattern/);
+    });
+  });
+
+  describe('startWorkerForScope()', () => {
+    it('starts the service worker of a registered scope', async () => {
+      w.loadURL(`${baseUrl}/index.html`);
+      await once(ses.serviceWorkers, 'console-message');
+      const info = await ses.serviceWorkers.startWorkerForScope(`${baseUrl}/`);
+      expect(info).to.have.property('scope', `${baseUrl}/`);
+      expect(ses.serviceWorkers.getFromVersionID(info.versionId)).to.have.property('scope', `${baseUrl}/`);
+    });
+
+    it('rejects for a scope without a service worker', async () => {
+      await expect(ses.serviceWorkers.startWorkerForScope(`${baseUrl}/nothing-here/`)).to.eventually.be.rejectedWith(/Failed to start the service worker/);
+    });
+  });
 });
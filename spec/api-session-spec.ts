@@ -8,7 +8,7 @@ import { app, session, BrowserWindow, net, ipcMain, Session, webFrameMain, WebFr
 import * as send from 'send';
 import * as auth from 'basic-auth';
 import { closeAllWindows } from './lib/window-helpers';
-import { defer, listen } from './lib/spec-helpers';
+import { defer, listen, waitUntil } from './lib/spec-helpers';
 import { once } from 'node:events';
 import { setTimeout } from 'node:timers/promises';
 
@@ -26,6 +26,42 @@ describe('session module', () => {
     it('returns existing session with same partition', () => {
       expect(session.fromPartition('test')).to.equal(session.fromPartition('test'));
     });
+
+    it('validates the cache options', () => {
+      expect(() => session.fromPartition(`cache-${Date.now()}`, { cache: 'yes' } as any)).to.throw('cache must be a boolean or an object');
+      expect(() => session.fromPartition(`cache-${Date.now()}`, { cache: { maxSize: -1 } })).to.throw('cache.maxSize must be a non-negative integer');
+      expect(() => session.fromPartition(`cache-${Date.now()}`, { cache: { backend: 'blockfile' } } as any)).to.throw("cache.backend must be 'disk' or 'memory'");
+    });
+
+    it('can keep the cache of a persistent session in memory', async () => {
+      const ses = session.fromPartition(`persist:memory-cache-${Date.now()}`, { cache: { backend: 'memory', maxSize: 1024 * 1024 } });
+      const server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', 'max-age=3600');
+        res.end('<title>cached</title>');
+      });
+      defer(() => server.close());
+      const { url } = await listen(server);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      defer(() => w.destroy());
+      await w.loadURL(url);
+      expect(w.webContents.getTitle()).to.equal('cached');
+      expect(fs.existsSync(path.join(ses.storagePath!, 'Cache'))).to.be.false();
+    });
+
+    it('creates an ephemeral session with a bounded cache', async () => {
+      const ses = session.fromPartition(`ephemeral-${Date.now()}`, { ephemeral: true, cacheSize: 1024 * 1024 });
+      expect(ses.isPersistent()).to.be.false();
+      const server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', 'max-age=3600');
+        res.end('<title>ephemeral</title>');
+      });
+      defer(() => server.close());
+      const { url } = await listen(server);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      defer(() => w.destroy());
+      await w.loadURL(url);
+      expect(w.webContents.getTitle()).to.equal('ephemeral');
+    });
   });
 
   describe('session.fromPath(path)', () => {
@@ -76,6 +112,82 @@ describe('session module', () => {
       expect(c.session).to.equal(false);
     });
 
+    it('settles the promises of concurrent calls in order', async () => {
+      const { cookies } = session.defaultSession;
+      const settled: number[] = [];
+      await Promise.all(Array.from({ length: 200 }, (_, i) =>
+        cookies.set({ url, name: `bulk-${i}`, value: `${i}` }).then(() => settled.push(i))));
+      expect(settled).to.deep.equal(Array.from({ length: 200 }, (_, i) => i));
+      const list = (await cookies.get({ url })).filter(c => c.name.startsWith('bulk-'));
+      expect(list).to.have.lengthOf(200);
+    });
+
+    it('gets many cookies and only sets expirationDate on persistent ones', async () => {
+      const { cookies } = session.defaultSession;
+      const expirationDate = Math.floor(Date.now() / 1000) + 120;
+      for (let i = 0; i < 100; ++i) {
+        await cookies.set({ url, name: `many-${i}`, value: `${i}`, expirationDate: i % 2 ? expirationDate : undefined });
+      }
+      const list = (await cookies.get({ url })).filter(c => c.name.startsWith('many-'));
+      expect(list).to.have.lengthOf(100);
+      for (const c of list) {
+        const i = Number(c.value);
+        expect(c.name).to.equal(`many-${i}`);
+        expect(c.session).to.equal(i % 2 === 0);
+        expect(Object.prototype.hasOwnProperty.call(c, 'expirationDate')).to.equal(i % 2 === 1);
+        expect(Object.keys(c)).to.include.members(['name', 'value', 'domain', 'hostOnly', 'path', 'secure', 'httpOnly', 'session', 'sameSite']);
+      }
+    });
+
+    describe('cookies.getPage()', () => {
+      const setCookies = async (count: number) => {
+        const { cookies } = session.defaultSession;
+        for (let i = 0; i < count; ++i) {
+          await cookies.set({ url, name: `page-${String(i).padStart(3, '0')}`, value: `${i}` });
+        }
+      };
+
+      it('returns the cookies in pages', async () => {
+        await setCookies(25);
+        const names: string[] = [];
+        let cursor: string | undefined;
+        let pages = 0;
+        do {
+          const page = await session.defaultSession.cookies.getPage({ url }, { limit: 10, cursor });
+          expect(page.cookies!.length).to.be.at.most(10);
+          names.push(...page.cookies!.map(c => c.name));
+          cursor = page.cursor;
+          pages++;
+        } while (cursor);
+        expect(pages).to.equal(3);
+        expect(names.filter(name => name.startsWith('page-'))).to.deep.equal(
+          Array.from({ length: 25 }, (_, i) => `page-${String(i).padStart(3, '0')}`));
+      });
+
+      it('applies the filter', async () => {
+        await setCookies(5);
+        const page = await session.defaultSession.cookies.getPage({ url, name: 'page-003' });
+        expect(page.cookies!.map(c => c.value)).to.deep.equal(['3']);
+        expect(page.cursor).to.be.undefined();
+      });
+
+      it('returns columns', async () => {
+        await setCookies(3);
+        const { fields, values } = await session.defaultSession.cookies.getPage({ url, name: 'page-001' }, { format: 'columns' });
+        expect(values).to.have.lengthOf(fields!.length);
+        expect(values![fields!.indexOf('name')]).to.equal('page-001');
+        expect(values![fields!.indexOf('value')]).to.equal('1');
+        expect(values![fields!.indexOf('expirationDate')]).to.be.undefined();
+      });
+
+      it('rejects invalid options', async () => {
+        const { cookies } = session.defaultSession;
+        await expect(cookies.getPage({}, { limit: 0 })).to.eventually.be.rejectedWith('limit must be a positive integer');
+        await expect(cookies.getPage({}, { cursor: 'nope' })).to.eventually.be.rejectedWith('Invalid cursor');
+        await expect(cookies.getPage({}, { format: 'rows' })).to.eventually.be.rejectedWith("format must be either 'objects' or 'columns'");
+      });
+    });
+
     it('sets session cookies', async () => {
       const { cookies } = session.defaultSession;
       const name = '2';
@@ -210,6 +322,45 @@ describe('session module', () => {
       expect(removeEventRemoved).to.equal(true);
     });
 
+    describe('cookies.setChangeBatching()', () => {
+      it('emits the matching changes in batches', async () => {
+        const { cookies } = session.fromPartition('cookies-batched');
+        cookies.setChangeBatching({ interval: 100, names: ['a', 'b'] });
+        try {
+          const changes = once(cookies, 'changes');
+          await cookies.set({ url, name: 'a', value: '1' });
+          await cookies.set({ url, name: 'c', value: '3' });
+          await cookies.set({ url, name: 'b', value: '2' });
+          const [, batch] = await changes;
+          expect(batch.map((change: any) => change.cookie.name)).to.deep.equal(['a', 'b']);
+          expect(batch[0].cause).to.equal('explicit');
+          expect(batch[0].removed).to.equal(false);
+        } finally {
+          cookies.setChangeBatching(null);
+        }
+      });
+
+      it('emits the pending changes when batching is turned off', async () => {
+        const { cookies } = session.fromPartition('cookies-batched-off');
+        let changed = false;
+        cookies.on('changed', () => { changed = true; });
+        cookies.setChangeBatching({ interval: 60000 });
+        await cookies.set({ url, name: 'a', value: '1' });
+        // Let the change notification arrive.
+        await setTimeout(500);
+        const changes = once(cookies, 'changes');
+        cookies.setChangeBatching(null);
+        const [, batch] = await changes;
+        expect(batch).to.have.lengthOf(1);
+        expect(changed).to.be.false();
+      });
+
+      it('validates the options', () => {
+        const { cookies } = session.defaultSession;
+        expect(() => cookies.setChangeBatching({ interval: 0 })).to.throw('interval must be a positive integer');
+      });
+    });
+
     describe('ses.cookies.flushStore()', async () => {
       it('flushes the cookies to disk', async () => {
         const name = 'foo';
@@ -483,6 +634,41 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setProxyResolutionOptions(options)', () => {
+    let customSession: Electron.Session;
+
+    beforeEach(() => {
+      customSession = session.fromPartition('proxyresolution');
+    });
+
+    afterEach(async () => {
+      customSession.setProxyResolutionOptions({ maxConcurrentLookups: 8, cacheTTL: 0 });
+      await customSession.setProxy({ mode: 'direct' });
+    });
+
+    it('resolves concurrent lookups', async () => {
+      customSession.setProxyResolutionOptions({ maxConcurrentLookups: 2 });
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' });
+      const urls = [...Array(10).keys()].map(i => `http://example${i}.com/`);
+      const proxies = await Promise.all(urls.map(url => customSession.resolveProxy(url)));
+      expect(proxies).to.deep.equal(urls.map(() => 'PROXY myproxy:80'));
+    });
+
+    it('clears the cached results when the proxy config changes', async () => {
+      customSession.setProxyResolutionOptions({ cacheTTL: 60000 });
+      await customSession.setProxy({ proxyRules: 'http=myproxy:80' });
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY myproxy:80');
+      await customSession.setProxy({ proxyRules: 'http=otherproxy:80' });
+      expect(await customSession.resolveProxy('http://example.com/')).to.equal('PROXY otherproxy:80');
+    });
+
+    it('throws for an invalid limit', () => {
+      expect(() => {
+        customSession.setProxyResolutionOptions({ maxConcurrentLookups: 0 });
+      }).to.throw(/maxConcurrentLookups must be a positive integer/);
+    });
+  });
+
   describe('ses.resolveHost(host)', () => {
     let customSession: Electron.Session;
 
@@ -530,6 +716,79 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.getNetworkStats()', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => {
+        res.setHeader('Content-Type', 'text/html');
+        res.end('<img src="/image.png">');
+      });
+      serverUrl = (await listen(server)).url;
+    });
+    after(() => {
+      server.close();
+    });
+    afterEach(closeAllWindows);
+
+    it('counts the requests of the net module', async () => {
+      const ses = session.fromPartition(`network-stats-${Math.random()}`);
+      const response = await ses.fetch(serverUrl);
+      await response.text();
+      const stats = ses.getNetworkStats()[new URL(serverUrl).hostname];
+      expect(stats.requests).to.equal(1);
+      expect(stats.failedRequests).to.equal(0);
+      expect(stats.bytesReceived).to.be.greaterThan(0);
+      expect(stats.ttfb.count).to.equal(1);
+      expect(stats.ttfb.buckets).to.have.lengthOf(10);
+      expect(stats.protocols['http/1.1']).to.equal(1);
+    });
+
+    it('counts the loads of the pages', async () => {
+      const ses = session.fromPartition(`network-stats-${Math.random()}`);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      const host = new URL(serverUrl).hostname;
+      await waitUntil(() => ses.getNetworkStats()[host]?.requests === 2);
+    });
+
+    it('is cleared by ses.clearNetworkStats()', async () => {
+      const ses = session.fromPartition(`network-stats-${Math.random()}`);
+      await (await ses.fetch(serverUrl)).text();
+      ses.clearNetworkStats();
+      expect(ses.getNetworkStats()).to.deep.equal({});
+    });
+  });
+
+  describe('ses.resolveHosts(hosts)', () => {
+    let customSession: Electron.Session;
+
+    beforeEach(async () => {
+      customSession = session.fromPartition('resolvehost');
+    });
+
+    afterEach(() => {
+      customSession = null as any;
+    });
+
+    it('resolves the hosts in order', async () => {
+      const results = await customSession.resolveHosts(['ipv6.localhost2', 'notfound.localhost2', 'ipv4.localhost2']);
+      expect(results.map(result => result.host)).to.deep.equal(['ipv6.localhost2', 'notfound.localhost2', 'ipv4.localhost2']);
+      expect(results[0].endpoints![0].address).to.equal('::1');
+      expect(results[1].error).to.match(/net::ERR_NAME_NOT_RESOLVED/);
+      expect(results[2].endpoints![0].address).to.equal('10.0.0.1');
+    });
+
+    it('resolves an empty list', async () => {
+      expect(await customSession.resolveHosts([])).to.deep.equal([]);
+    });
+
+    it('accepts staleWhileRevalidate', async () => {
+      const [result] = await customSession.resolveHosts(['ipv4.localhost2'], { staleWhileRevalidate: true });
+      expect(result.endpoints![0].address).to.equal('10.0.0.1');
+    });
+  });
+
   describe('ses.getBlobData()', () => {
     const scheme = 'cors-blob';
     const protocol = session.defaultSession.protocol;
@@ -711,6 +970,29 @@ describe('session module', () => {
       expect(numVerificationRequests).to.equal(1);
     });
 
+    it('accepts the request with a cached verdict', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      let numVerificationRequests = 0;
+      ses.setCertificateVerifyProc((e, callback) => {
+        if (e.hostname !== '127.0.0.1') return callback(-3);
+        numVerificationRequests++;
+        callback(0);
+      }, { cacheTTL: 60000 });
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      await w.loadURL(serverUrl + '/test');
+      expect(w.webContents.getTitle()).to.equal('hello');
+      expect(numVerificationRequests).to.equal(1);
+    });
+
+    it('throws for an invalid cacheTTL', () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      expect(() => {
+        ses.setCertificateVerifyProc((e, callback) => callback(-3), { cacheTTL: -1 });
+      }).to.throw(/cacheTTL must be a non-negative number/);
+    });
+
     it('does not cancel requests in other sessions', async () => {
       const ses1 = session.fromPartition(`${Math.random()}`);
       ses1.setCertificateVerifyProc((opts, cb) => cb(0));
@@ -1284,6 +1566,10 @@ describe('session module', () => {
         expect(completedItem.getMimeType()).to.equal('image/png');
         expect(completedItem.getReceivedBytes()).to.equal(14022);
         expect(completedItem.getTotalBytes()).to.equal(14022);
+        expect(completedItem.getPercentComplete()).to.equal(100);
+        expect(completedItem.getCurrentBytesPerSecond()).to.be.a('number');
+        expect(completedItem.getReceivedSlices()).to.be.an('array');
+        expect(completedItem.getEndTime()).to.be.at.least(completedItem.getStartTime());
         expect(fs.existsSync(downloadFilePath)).to.equal(true);
       } finally {
         rangeServer.close();
@@ -1291,6 +1577,52 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setDownloadScheduler(options)', () => {
+    afterEach(() => {
+      session.defaultSession.setDownloadScheduler(null);
+    });
+
+    it('rejects invalid options', () => {
+      expect(() => session.defaultSession.setDownloadScheduler('fast' as any)).to.throw('options must be null or an object');
+      expect(() => session.defaultSession.setDownloadScheduler({ maxBytesPerSecond: 0 })).to.throw('maxBytesPerSecond must be a positive number');
+    });
+
+    it('pauses low priority downloads while a page is loading', async () => {
+      const server = http.createServer((req, res) => {
+        if (req.url === '/download') {
+          res.writeHead(200, { 'Content-Type': 'application/octet-stream', 'Content-Disposition': 'attachment; filename="file.bin"' });
+          // Never finish the download, so that it can be paused.
+          res.write(Buffer.alloc(1024));
+        }
+        // Never finish loading the page either.
+      });
+      defer(() => { server.closeAllConnections(); server.close(); });
+      const { url } = await listen(server);
+
+      session.defaultSession.setDownloadScheduler({ pauseWhileLoading: true, interval: 50 });
+      const w = new BrowserWindow({ show: false });
+      defer(() => w.destroy());
+      const willDownload = new Promise<Electron.DownloadItem>(resolve => {
+        session.defaultSession.once('will-download', (event, item) => {
+          expect(item.priority).to.equal('normal');
+          item.priority = 'low';
+          item.setSavePath(path.join(app.getPath('temp'), `electron-download-scheduler-${Date.now()}.bin`));
+          resolve(item);
+        });
+      });
+      session.defaultSession.downloadURL(`${url}/download`);
+      const item = await willDownload;
+      defer(() => item.cancel());
+      expect(item.priority).to.equal('low');
+
+      w.loadURL(`${url}/page`).catch(() => {});
+      await waitUntil(() => item.isPaused());
+
+      w.webContents.stop();
+      await waitUntil(() => !item.isPaused());
+    });
+  });
+
   describe('ses.setPermissionRequestHandler(handler)', () => {
     afterEach(closeAllWindows);
     // These tests are done on an http server because navigator.userAgentData
@@ -1462,6 +1794,40 @@ describe('session module', () => {
       expect(handlerDetails!.isMainFrame).to.be.false();
       expect(handlerDetails!.embeddingOrigin).to.equal('file:///');
     });
+
+    it('caches the decisions with the cache option', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          partition: 'very-temp-permission-cache'
+        }
+      });
+      const ses = w.webContents.session;
+      const loadUrl = 'https://myfakesite/';
+      ses.protocol.interceptStringProtocol('https', (req, cb) => {
+        cb('<html></html>');
+      });
+
+      let checks = 0;
+      ses.setPermissionCheckHandler((wc, permission) => {
+        if (permission !== 'clipboard-read') return false;
+        checks++;
+        return true;
+      }, { cache: true });
+
+      const readClipboardPermission = () => w.webContents.executeJavaScript(`
+        navigator.permissions.query({name: 'clipboard-read'}).then(permission => permission.state);
+      `, true);
+
+      await w.loadURL(loadUrl);
+      expect(await readClipboardPermission()).to.equal('granted');
+      expect(await readClipboardPermission()).to.equal('granted');
+      expect(checks).to.equal(1);
+
+      ses.clearPermissionCheckCache();
+      expect(await readClipboardPermission()).to.equal('granted');
+      expect(checks).to.equal(2);
+    });
   });
 
   describe('ses.isPersistent()', () => {
@@ -1557,6 +1923,52 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setRendererProcessPool(options)', () => {
+    const ses = session.fromPartition('renderer-process-pool');
+    const webPreferences = { nodeIntegration: true, contextIsolation: false };
+
+    const getRendererPids = () => new Set(app.getAppMetrics().filter(m => m.type === 'Tab').map(m => m.pid));
+
+    const waitForNewRenderer = async (existing: Set<number>) => {
+      let pid: number | undefined;
+      await waitUntil(() => {
+        pid = [...getRendererPids()].find(pid => !existing.has(pid));
+        return pid !== undefined;
+      });
+      return pid!;
+    };
+
+    afterEach(async () => {
+      ses.setRendererProcessPool({ size: 0 });
+      await closeAllWindows();
+    });
+
+    it('throws when the size is invalid', () => {
+      expect(() => {
+        ses.setRendererProcessPool({ size: -1 });
+      }).to.throw('Must pass a non-negative size to session.setRendererProcessPool.');
+    });
+
+    it('hands a launched process to a new window', async () => {
+      const existing = getRendererPids();
+      ses.setRendererProcessPool({ size: 1, webPreferences });
+      const pid = await waitForNewRenderer(existing);
+      const w = new BrowserWindow({ show: false, webPreferences: { ...webPreferences, session: ses } });
+      await w.loadFile(path.join(fixtures, 'pages', 'blank.html'));
+      expect(w.webContents.getOSProcessId()).to.equal(pid);
+      expect(await w.webContents.executeJavaScript('typeof require')).to.equal('function');
+    });
+
+    it('does not hand the process to a window with other preferences', async () => {
+      const existing = getRendererPids();
+      ses.setRendererProcessPool({ size: 1, webPreferences });
+      const pid = await waitForNewRenderer(existing);
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true, session: ses } });
+      await w.loadFile(path.join(fixtures, 'pages', 'blank.html'));
+      expect(w.webContents.getOSProcessId()).to.not.equal(pid);
+    });
+  });
+
   describe('ses.setSSLConfig()', () => {
     it('can disable cipher suites', async () => {
       const ses = session.fromPartition('' + Math.random());
@@ -1608,6 +2020,90 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.prefetch(urls)', () => {
+    afterEach(closeAllWindows);
+
+    it('serves the navigation to a prefetched page from the cache', async () => {
+      let requests = 0;
+      const server = http.createServer((req, res) => {
+        requests++;
+        res.setHeader('Cache-Control', 'max-age=60');
+        res.setHeader('Content-Type', 'text/html');
+        res.end('<title>prefetched</title>');
+      });
+      const { url } = await listen(server);
+      defer(() => server.close());
+
+      const ses = session.fromPartition(`prefetch-${Math.random()}`);
+      const results = await ses.prefetch([url]);
+      expect(results).to.deep.equal([{ url, statusCode: 200 }]);
+      expect(requests).to.equal(1);
+
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(url);
+      expect(w.webContents.getTitle()).to.equal('prefetched');
+      expect(requests).to.equal(1);
+    });
+
+    it('reports the errors of the pages that failed to load', async () => {
+      const results = await session.defaultSession.prefetch(['http://127.0.0.1:1/']);
+      expect(results).to.have.lengthOf(1);
+      expect(results[0].error).to.match(/ERR_/);
+    });
+
+    it('throws when urls is not an array', () => {
+      expect(() => session.defaultSession.prefetch('https://example.com' as any)).to.throw(/urls must be an array/);
+    });
+  });
+
+  describe('ses.getSerialPorts()', () => {
+    it('resolves with the serial ports', async () => {
+      const ports = await session.defaultSession.getSerialPorts();
+      expect(ports).to.be.an('array');
+      for (const port of ports) {
+        expect(port.portId).to.be.a('string');
+      }
+    });
+  });
+
+  describe('ses.openSerialPort()', () => {
+    it('rejects an invalid portId', async () => {
+      await expect(session.defaultSession.openSerialPort('not-a-port', { baudRate: 9600 })).to.eventually.be.rejectedWith(/Invalid portId/);
+    });
+
+    it('rejects invalid options', async () => {
+      const portId = '0123456789ABCDEF0123456789ABCDEF';
+      await expect(session.defaultSession.openSerialPort(portId, {} as any)).to.eventually.be.rejectedWith(/baudRate/);
+      await expect(session.defaultSession.openSerialPort(portId, { baudRate: 9600, dataBits: 6 })).to.eventually.be.rejectedWith(/dataBits/);
+      await expect(session.defaultSession.openSerialPort(portId, { baudRate: 9600, parity: 'mark' as any })).to.eventually.be.rejectedWith(/parity/);
+      await expect(session.defaultSession.openSerialPort(portId, { baudRate: 9600, readBatchSize: 0 })).to.eventually.be.rejectedWith(/readBatchSize/);
+    });
+
+    it('rejects a port that does not exist', async () => {
+      await expect(session.defaultSession.openSerialPort('0123456789ABCDEF0123456789ABCDEF', { baudRate: 9600 })).to.eventually.be.rejectedWith(/Failed to open the serial port/);
+    });
+  });
+
+  describe('ses.getHidDevices()', () => {
+    it('resolves with the HID devices', async () => {
+      const devices = await session.defaultSession.getHidDevices();
+      expect(devices).to.be.an('array');
+      const deviceIds = devices.map(device => device.deviceId);
+      expect(new Set(deviceIds).size).to.equal(deviceIds.length);
+    });
+  });
+
+  describe('ses.openHidDevice()', () => {
+    it('rejects an unknown deviceId', async () => {
+      await expect(session.defaultSession.openHidDevice('not-a-device')).to.eventually.be.rejectedWith(/Invalid deviceId/);
+    });
+
+    it('rejects invalid options', async () => {
+      await expect(session.defaultSession.openHidDevice('not-a-device', { batchInterval: -1 })).to.eventually.be.rejectedWith(/batchInterval/);
+      await expect(session.defaultSession.openHidDevice('not-a-device', { maxBatchSize: 0 })).to.eventually.be.rejectedWith(/maxBatchSize/);
+    });
+  });
+
   describe('ses.clearData()', () => {
     afterEach(closeAllWindows);
 
@@ -1726,5 +2222,37 @@ describe('session module', () => {
       expect((await cookies.get({ url: 'https://example.com/', name: 'testdotcom' })).length).to.be.greaterThan(0);
       expect((await cookies.get({ url: 'https://example.org/', name: 'testdotorg' })).length).to.equal(0);
     });
+
+    it('reports the progress of each data type', async () => {
+      const ses = session.fromPartition(`clear-data-progress-${Math.random()}`);
+      const progress: Electron.ClearDataProgress[] = [];
+      await ses.clearData({
+        dataTypes: ['cookies', 'localStorage'],
+        onProgress: (p) => progress.push(p)
+      });
+      expect(progress).to.deep.equal([
+        { dataType: 'cookies', completed: 1, total: 2 },
+        { dataType: 'localStorage', completed: 2, total: 2 }
+      ]);
+    });
+
+    it('stops clearing when the signal is aborted', async () => {
+      const ses = session.fromPartition(`clear-data-abort-${Math.random()}`);
+      const controller = new AbortController();
+      const cleared: string[] = [];
+      const promise = ses.clearData({
+        onProgress: ({ dataType }) => {
+          cleared.push(dataType);
+          controller.abort();
+        },
+        signal: controller.signal
+      });
+      await expect(promise).to.be.rejectedWith(/aborted/);
+      expect(cleared).to.have.lengthOf(1);
+    });
+
+    it('throws when onProgress is not a function', () => {
+      expect(() => session.defaultSession.clearData({ onProgress: 'foo' as any })).to.throw(/onProgress must be a function/);
+    });
   });
 });
@@ -3,7 +3,7 @@ import * as path from 'node:path';
 import * as http from 'node:http';
 import { emittedNTimes } from './lib/events-helpers';
 import { closeWindow } from './lib/window-helpers';
-import { app, BrowserWindow, ipcMain } from 'electron/main';
+import { app, BrowserWindow, ipcMain, WebFrameMain } from 'electron/main';
 import { ifdescribe, listen } from './lib/spec-helpers';
 import { once } from 'node:events';
 
@@ -214,6 +214,54 @@ describe('renderer nodeIntegrationInSubFrames', () => {
   });
 });
 
+describe('renderer lazyNodeIntegration', () => {
+  let w: BrowserWindow;
+
+  afterEach(async () => {
+    await closeWindow(w);
+    w = null as unknown as BrowserWindow;
+  });
+
+  const getRequireDescriptor = (frame: WebFrameMain) => frame.executeJavaScript(`(() => {
+    const { get, value } = Object.getOwnPropertyDescriptor(window, 'require');
+    return { lazy: typeof get === 'function', type: typeof value };
+  })()`);
+
+  const webPreferences = {
+    nodeIntegration: true,
+    nodeIntegrationInSubFrames: true,
+    contextIsolation: false,
+    lazyNodeIntegration: true
+  };
+
+  it('creates the Node.js environment of a frame on first use', async () => {
+    w = new BrowserWindow({ show: false, webPreferences });
+    await w.loadFile(path.resolve(__dirname, 'fixtures/sub-frames/frame-container.html'));
+    const frame = w.webContents.mainFrame.frames[0];
+    expect(await getRequireDescriptor(w.webContents.mainFrame)).to.deep.equal({ lazy: true, type: 'undefined' });
+    expect(await getRequireDescriptor(frame)).to.deep.equal({ lazy: true, type: 'undefined' });
+
+    expect(await frame.executeJavaScript('require(\'node:path\').basename(__filename)')).to.equal('frame.html');
+    expect(await getRequireDescriptor(frame)).to.deep.equal({ lazy: false, type: 'function' });
+    expect(await getRequireDescriptor(w.webContents.mainFrame)).to.deep.equal({ lazy: true, type: 'undefined' });
+  });
+
+  it('creates the environment when a Node.js global is assigned', async () => {
+    w = new BrowserWindow({ show: false, webPreferences });
+    await w.loadFile(path.resolve(__dirname, 'fixtures/sub-frames/frame.html'));
+    expect(await w.webContents.executeJavaScript('window.Buffer = 1; [window.Buffer, typeof process.versions.node]')).to.deep.equal([1, 'string']);
+  });
+
+  it('is ignored when there is a preload script', async () => {
+    w = new BrowserWindow({
+      show: false,
+      webPreferences: { ...webPreferences, preload: path.resolve(__dirname, 'fixtures/sub-frames/preload.js') }
+    });
+    await w.loadFile(path.resolve(__dirname, 'fixtures/sub-frames/frame.html'));
+    expect(await getRequireDescriptor(w.webContents.mainFrame)).to.deep.equal({ lazy: false, type: 'function' });
+  });
+});
+
 // app.getAppMetrics() does not return sandbox information on Linux.
 ifdescribe(process.platform !== 'linux')('cross-site frame sandboxing', () => {
   let server: http.Server;
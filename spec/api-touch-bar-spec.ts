@@ -101,6 +101,29 @@ describe('TouchBar module', () => {
       touchBar.escapeItem = null;
     });
 
+    it('updates the labels and sliders without refreshing the whole item', () => {
+      const label = new TouchBarLabel({ label: 'label' });
+      const slider = new TouchBarSlider({ value: 5 });
+      const touchBar = new TouchBar({
+        items: [new TouchBarGroup({ items: new TouchBar({ items: [label] }) }), slider]
+      });
+      window.setTouchBar(touchBar);
+      const calls: string[] = [];
+      for (const method of ['_refreshTouchBarItem', '_setTouchBarItemLabel', '_setTouchBarItemValue']) {
+        const original = (window as any)[method];
+        (window as any)[method] = (...args: any[]) => {
+          calls.push(method);
+          return original.call(window, ...args);
+        };
+      }
+      label.label = 'progress';
+      label.label = 'progress';
+      slider.value = 10;
+      slider.value = 10;
+      label.textColor = '#F00';
+      expect(calls).to.deep.equal(['_setTouchBarItemLabel', '_setTouchBarItemValue', '_refreshTouchBarItem']);
+    });
+
     it('calls the callback on the items when a window interaction event fires', (done) => {
       const button = new TouchBarButton({
         label: 'bar',
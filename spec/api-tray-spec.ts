@@ -147,6 +147,28 @@ describe('tray module', () => {
     });
   });
 
+  describe('tray.setImageIndex(index)', () => {
+    it('switches between the images of the image set', () => {
+      tray.setImageSet([nativeImage.createEmpty(), nativeImage.createEmpty()]);
+      tray.setImageIndex(1);
+      tray.setImageIndex(0);
+    });
+
+    it('throws for an index out of range', () => {
+      tray.setImageSet([nativeImage.createEmpty()]);
+      expect(() => {
+        tray.setImageIndex(1);
+      }).to.throw(/out of the range/);
+    });
+
+    it('throws a descriptive error for a missing file in the image set', () => {
+      const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
+      expect(() => {
+        tray.setImageSet([badPath]);
+      }).to.throw(/Failed to load image from path (.+)/);
+    });
+  });
+
   describe('tray.setPressedImage(image)', () => {
     it('throws a descriptive error for a missing file', () => {
       const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
@@ -1,8 +1,9 @@
 import { expect } from 'chai';
 import * as childProcess from 'node:child_process';
+import * as fs from 'node:fs/promises';
 import * as path from 'node:path';
-import { BrowserWindow, MessageChannelMain, utilityProcess, app } from 'electron/main';
-import { ifit } from './lib/spec-helpers';
+import { BrowserWindow, MessageChannelMain, utilityProcess, app, session } from 'electron/main';
+import { ifit, waitUntil } from './lib/spec-helpers';
 import { closeWindow } from './lib/window-helpers';
 import { once } from 'node:events';
 import { pathToFileURL } from 'node:url';
@@ -156,6 +157,34 @@ describe('utilityProcess module', () => {
     });
   });
 
+  describe('startCpuProfiling() API', () => {
+    const profilePath = path.join(app.getPath('temp'), 'electron-utility.cpuprofile');
+
+    afterEach(async () => {
+      await fs.rm(profilePath, { force: true });
+    });
+
+    it('rejects when the process is not running', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
+      await once(child, 'exit');
+      await expect(child.startCpuProfiling()).to.eventually.be.rejectedWith(/The process is not running/);
+    });
+
+    it('writes a .cpuprofile file of the child process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      await expect(child.startCpuProfiling({ samplingInterval: 0 })).to.eventually.be.rejectedWith(/samplingInterval must be a positive number/);
+      await child.startCpuProfiling({ samplingInterval: 100 });
+      await setImmediate();
+      await child.stopCpuProfiling(profilePath);
+      const profile = JSON.parse(await fs.readFile(profilePath, 'utf8'));
+      expect(profile.nodes).to.be.an('array').that.is.not.empty();
+      expect(profile.timeDeltas).to.have.lengthOf(profile.samples.length);
+      child.kill();
+      await once(child, 'exit');
+    });
+  });
+
   describe('esm', () => {
     it('is launches an mjs file', async () => {
       const fixtureFile = path.join(fixturesPath, 'esm.mjs');
@@ -279,6 +308,34 @@ describe('utilityProcess module', () => {
       expect(child.kill()).to.be.true();
       await exit;
     });
+
+    it('transfers ArrayBuffers in both directions', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'transfer-buffer.js'));
+      await once(child, 'spawn');
+      const buffer = new Uint8Array([1, 2, 3]).buffer;
+      child.postMessage(buffer, [buffer]);
+      expect(buffer.byteLength).to.equal(0);
+      const [data] = await once(child, 'message');
+      expect(new Uint8Array(data)).to.deep.equal(new Uint8Array([2, 4, 6]));
+      const [byteLength] = await once(child, 'message');
+      expect(byteLength).to.equal(0);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('delivers the available messages together to \'messages\' listeners', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'post-message-batch.js'));
+      await once(child, 'spawn');
+      child.postMessage('a');
+      child.postMessage('b');
+      child.postMessage('c');
+      const [result] = await once(child, 'message');
+      expect(result).to.deep.equal({ batches: 1, data: ['a', 'b', 'c'] });
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
   });
 
   describe('behavior', () => {
@@ -467,4 +524,211 @@ describe('utilityProcess module', () => {
       await exit;
     });
   });
+
+  describe('createSharedBuffer() API', () => {
+    it('exchanges records with the child process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'shared-buffer.js'));
+      await once(child, 'spawn');
+      const buffer = child.createSharedBuffer('test', 1024);
+      expect(buffer.capacity).to.equal(1024);
+      for (const record of ['a', 'bb', 'ccc']) {
+        expect(buffer.write(Buffer.from(record))).to.be.true();
+      }
+      const records: string[] = [];
+      while (records.length < 3) {
+        const record = buffer.read();
+        if (record === null) {
+          await once(buffer, 'readable');
+        } else {
+          records.push(record.toString());
+        }
+      }
+      expect(records).to.deep.equal(['test:a', 'test:bb', 'test:ccc']);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('reports when the ring is full', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      const buffer = child.createSharedBuffer('test', 16);
+      expect(() => buffer.write(new Uint8Array(16))).to.throw(/larger than the capacity/);
+      expect(buffer.write(new Uint8Array(8))).to.be.true();
+      expect(buffer.write(new Uint8Array(8))).to.be.false();
+      buffer.close();
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('throws when the process is not running', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
+      await once(child, 'exit');
+      expect(() => child.createSharedBuffer('test', 16)).to.throw(/The process is not running/);
+    });
+  });
+
+  describe('handleProtocol() API', () => {
+    it('serves the requests of a scheme in the child process', async () => {
+      const ses = session.fromPartition(`utility-protocol-${Math.random()}`);
+      const child = utilityProcess.fork(path.join(fixturesPath, 'handle-protocol.js'));
+      await once(child, 'spawn');
+      child.handleProtocol('utility-test', { session: ses });
+      try {
+        expect(ses.protocol.isProtocolHandled('utility-test')).to.be.true();
+        const res = await ses.fetch('utility-test://foo');
+        expect(res.headers.get('content-type')).to.equal('text/plain');
+        expect(await res.text()).to.equal('hello from utility-test://foo');
+        const post = await ses.fetch('utility-test://bar', { method: 'POST', body: 'posted' });
+        expect(await post.text()).to.equal('posted from utility-test://bar');
+      } finally {
+        ses.protocol.unhandle('utility-test');
+        const exit = once(child, 'exit');
+        child.kill();
+        await exit;
+      }
+      expect(ses.protocol.isProtocolHandled('utility-test')).to.be.false();
+    });
+
+    it('throws for built-in schemes', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      expect(() => child.handleProtocol('https')).to.throw(/Built-in schemes/);
+      const exit = once(child, 'exit');
+      child.kill();
+      await exit;
+    });
+  });
+
+  describe('setPriority() API', () => {
+    it('changes the priority of the process', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'));
+      await once(child, 'spawn');
+      // Raising the priority back may not be allowed on Linux.
+      expect(child.setPriority('background')).to.be.a('boolean');
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('throws on an invalid priority', () => {
+      expect(() => {
+        utilityProcess.fork(path.join(fixturesPath, 'empty.js'), [], { priority: 'high' as any });
+      }).to.throw(/Invalid value for priority/);
+    });
+
+    it('returns false when the process is not running', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'empty.js'));
+      await once(child, 'exit');
+      expect(child.setPriority('background')).to.be.false();
+    });
+  });
+
+  describe('setCPUAffinity() API', () => {
+    ifit(process.platform === 'linux')('restricts the process to the given CPUs', async () => {
+      const child = utilityProcess.fork(path.join(fixturesPath, 'endless.js'), [], { cpuAffinity: [0] });
+      await once(child, 'spawn');
+      const status = await fs.readFile(`/proc/${child.pid}/status`, 'utf8');
+      expect(status).to.match(/^Cpus_allowed_list:\s+0$/m);
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('throws on an invalid affinity', () => {
+      expect(() => {
+        utilityProcess.fork(path.join(fixturesPath, 'empty.js'), [], { cpuAffinity: 'all' as any });
+      }).to.throw(/Invalid value for cpuAffinity/);
+    });
+  });
+
+  describe('prewarm() API', () => {
+    afterEach(() => {
+      utilityProcess.prewarm(0);
+    });
+
+    it('throws when the count is not valid', () => {
+      expect(() => {
+        utilityProcess.prewarm(-1);
+      }).to.throw(/count must be a non-negative integer/);
+    });
+
+    it('forks in a prewarmed process', async () => {
+      const utilityPids = () => app.getAppMetrics().filter(item => item.type === 'Utility').map(item => item.pid);
+      const before = utilityPids();
+      utilityProcess.prewarm(1);
+      let prewarmedPid: number | undefined;
+      await waitUntil(() => {
+        prewarmedPid = utilityPids().find(pid => !before.includes(pid));
+        return prewarmedPid !== undefined;
+      });
+
+      const child = utilityProcess.fork(path.join(fixturesPath, 'post-message.js'));
+      await once(child, 'spawn');
+      expect(child.pid).to.equal(prewarmedPid);
+      child.postMessage('hello');
+      const [data] = await once(child, 'message');
+      expect(data).to.equal('hello');
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+
+    it('does not use prewarmed processes for custom launch options', async () => {
+      utilityProcess.prewarm(1);
+      const child = utilityProcess.fork(path.join(fixturesPath, 'post-message.js'), [], { stdio: 'pipe' });
+      await once(child, 'spawn');
+      expect(child.stdout).to.not.be.null();
+      const exit = once(child, 'exit');
+      expect(child.kill()).to.be.true();
+      await exit;
+    });
+  });
+
+  describe('createPool() API', () => {
+    it('throws when the size is not valid', () => {
+      expect(() => {
+        utilityProcess.createPool(path.join(fixturesPath, 'pool-task.js'), { size: 0 });
+      }).to.throw(/size must be a positive integer/);
+    });
+
+    it('runs tasks over all of its processes', async () => {
+      const pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-task.js'), { size: 2 });
+      try {
+        expect(pool.size).to.equal(2);
+        const results = await Promise.all([1, 2, 3, 4, 5, 6].map((n) => pool.run(n)));
+        expect(results).to.deep.equal([1, 2, 3, 4, 5, 6]);
+        const metrics = pool.getMetrics();
+        expect(metrics.map(m => m.completed).reduce((a, b) => a + b)).to.equal(6);
+        expect(metrics.every(m => m.completed > 0 && m.queued === 0 && !m.running)).to.be.true();
+      } finally {
+        pool.close();
+      }
+    });
+
+    ifit(!isWindows32Bit)('respawns processes that exit', async () => {
+      const pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-task.js'), { size: 1 });
+      try {
+        const exit = once(pool, 'process-exit');
+        await expect(pool.run('crash')).to.eventually.be.rejectedWith(/exited/);
+        const [index] = await exit;
+        expect(index).to.equal(0);
+        expect(await pool.run('still working')).to.equal('still working');
+        expect(pool.getMetrics()[0].respawns).to.equal(1);
+      } finally {
+        pool.close();
+      }
+    });
+
+    it('rejects the pending tasks when closed', async () => {
+      const pool = utilityProcess.createPool(path.join(fixturesPath, 'pool-task.js'), { size: 1 });
+      const tasks = [pool.run(1), pool.run(2)];
+      pool.close();
+      for (const task of tasks) {
+        await expect(task).to.eventually.be.rejectedWith(/The pool was closed/);
+      }
+      await expect(pool.run(3)).to.eventually.be.rejectedWith(/The pool was closed/);
+    });
+  });
 });
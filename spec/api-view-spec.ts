@@ -1,3 +1,4 @@
+import { expect } from 'chai';
 import { closeWindow } from './lib/window-helpers';
 import { BaseWindow, View } from 'electron/main';
 
@@ -12,4 +13,26 @@ describe('View', () => {
     w = new BaseWindow({ show: false });
     w.setContentView(new View());
   });
+
+  describe('view.layoutChildren()', () => {
+    it('sets the bounds and the visibility of the children', () => {
+      const parent = new View();
+      const children = [new View(), new View()];
+      for (const child of children) parent.addChildView(child);
+      parent.layoutChildren([
+        { view: children[0], bounds: { x: 0, y: 0, width: 100, height: 100 } },
+        { view: children[1], bounds: { x: 100, y: 0, width: 100, height: 100 }, visible: false }
+      ]);
+      expect(children[0].getBounds()).to.deep.equal({ x: 0, y: 0, width: 100, height: 100 });
+      // The bounds of a hidden child are left alone.
+      expect(children[1].getBounds()).to.deep.equal({ x: 0, y: 0, width: 0, height: 0 });
+    });
+
+    it('throws for views that are not children', () => {
+      const parent = new View();
+      expect(() => {
+        parent.layoutChildren([{ view: new View(), bounds: { x: 0, y: 0, width: 1, height: 1 } }]);
+      }).to.throw(/must be a child of this view/);
+    });
+  });
 });
@@ -374,6 +374,85 @@ describe('webContents module', () => {
     });
   });
 
+  describe('webContents.executeRegisteredScript', () => {
+    afterEach(closeAllWindows);
+    afterEach(() => {
+      webContents.unregisterScript('counter');
+    });
+
+    it('runs a registered script in the given world', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadURL('about:blank');
+      webContents.registerScript('counter', 'window.count = (window.count ?? 0) + 1');
+      expect(await w.webContents.executeRegisteredScript('counter')).to.equal(1);
+      expect(await w.webContents.executeRegisteredScript('counter')).to.equal(2);
+      expect(await w.webContents.executeRegisteredScript('counter', { worldId: 999 })).to.equal(1);
+      expect(await w.webContents.executeJavaScript('window.count')).to.equal(2);
+    });
+
+    it('runs the latest version of a script after it is replaced', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      webContents.registerScript('counter', '1');
+      expect(await w.webContents.executeRegisteredScript('counter')).to.equal(1);
+      webContents.registerScript('counter', '2');
+      expect(await w.webContents.executeRegisteredScript('counter')).to.equal(2);
+    });
+
+    it('runs a registered script in a frame', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      webContents.registerScript('counter', 'document.location.href');
+      expect(await w.webContents.mainFrame.executeRegisteredScript('counter')).to.equal('about:blank');
+    });
+
+    it('rejects for scripts that are not registered', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.executeRegisteredScript('counter')).to.eventually.be.rejectedWith(/No script is registered as 'counter'/);
+      expect(webContents.unregisterScript('counter')).to.be.false();
+    });
+  });
+
+  describe('webContents.executeJavaScriptInAllFrames', () => {
+    afterEach(closeAllWindows);
+
+    it('runs the code in every frame of the page', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'sub-frames', 'frame-with-frame-container.html'));
+      const results = await w.webContents.executeJavaScriptInAllFrames('location.href');
+      expect(results).to.have.lengthOf(3);
+      for (const { frame, result } of results) {
+        expect(result).to.equal(frame.url);
+      }
+    });
+
+    it('reports the frames that fail without rejecting', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const [{ frame, result, error }] = await w.webContents.executeJavaScriptInAllFrames('Promise.reject(new Error("oops"))');
+      expect(frame).to.equal(w.webContents.mainFrame);
+      expect(result).to.be.undefined();
+      expect(error).to.match(/oops/);
+    });
+
+    it('runs the code in all frames of several web contents', async () => {
+      const w1 = new BrowserWindow({ show: false });
+      const w2 = new BrowserWindow({ show: false });
+      await Promise.all([
+        w1.loadFile(path.join(fixturesPath, 'sub-frames', 'frame-with-frame.html')),
+        w2.loadURL('about:blank')
+      ]);
+      const results = await webContents.executeJavaScriptInAllFrames([w1.webContents, w2.webContents], '1 + 1');
+      expect(results.map(({ result }) => result)).to.deep.equal([2, 2, 2]);
+      expect(webContents.fromFrame(results[2].frame)).to.equal(w2.webContents);
+    });
+
+    it('throws when contents is not an array', async () => {
+      await expect(webContents.executeJavaScriptInAllFrames(null as any, '1')).to.eventually.be.rejectedWith('contents must be an array');
+    });
+  });
+
   describe('loadURL() promise API', () => {
     let w: BrowserWindow;
 
@@ -760,6 +839,17 @@ describe('webContents module', () => {
       await devtoolsOpened2;
       expect(w.webContents.isDevToolsOpened()).to.be.true();
     });
+
+    it('shares a renderer process between the DevTools of windows', async () => {
+      const windows = [new BrowserWindow({ show: false }), new BrowserWindow({ show: false })];
+      await Promise.all(windows.map(w => {
+        const devtoolsOpened = once(w.webContents, 'devtools-opened');
+        w.webContents.openDevTools({ mode: 'detach', activate: false });
+        return devtoolsOpened;
+      }));
+      const [first, second] = windows.map(w => w.webContents.devToolsWebContents!.getOSProcessId());
+      expect(first).to.equal(second);
+    });
   });
 
   describe('setDevToolsTitle() API', () => {
@@ -1001,6 +1091,113 @@ describe('webContents module', () => {
     });
   });
 
+  describe('sendInputEvents(events)', () => {
+    let w: BrowserWindow;
+    beforeEach(async () => {
+      w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`
+        window.receivedEvents = [];
+        for (const type of ['mousedown', 'mouseup', 'mousemove', 'wheel']) {
+          document.addEventListener(type, (e) => {
+            window.receivedEvents.push([e.type, e.clientX, e.clientY, e.shiftKey]);
+          });
+        }
+      `);
+    });
+    afterEach(closeAllWindows);
+
+    it('sends mouse events in order and coalesces moves', async () => {
+      const count = w.webContents.sendInputEvents(new Float64Array([
+        2, 0, 0, 10, 10, -1, 0, 0, 0,
+        2, 8, 0, 20, 20, -1, 0, 0, 0,
+        2, 16, 0, 30, 30, -1, 0, 0, 0,
+        0, 24, 1, 30, 30, 0, 1, 0, 0,
+        1, 32, 1, 30, 30, 0, 1, 0, 0
+      ]));
+      expect(count).to.equal(3);
+      const events = await w.webContents.executeJavaScript(`new Promise((resolve) => {
+        const check = () => window.receivedEvents.length >= 3 ? resolve(window.receivedEvents) : setTimeout(check, 10);
+        check();
+      })`);
+      expect(events).to.deep.equal([
+        ['mousemove', 30, 30, false],
+        ['mousedown', 30, 30, true],
+        ['mouseup', 30, 30, true]
+      ]);
+    });
+
+    it('throws for malformed streams', () => {
+      expect(() => {
+        w.webContents.sendInputEvents([2, 0, 0, 10, 10, -1, 0, 0, 0] as any);
+      }).to.throw(/events must be a Float64Array/);
+      expect(() => {
+        w.webContents.sendInputEvents(new Float64Array([2, 0, 0, 10]));
+      }).to.throw(/Invalid input event stream/);
+      expect(() => {
+        w.webContents.sendInputEvents(new Float64Array([42, 0, 0, 10, 10, -1, 0, 0, 0]));
+      }).to.throw(/Invalid input event stream/);
+    });
+  });
+
+  describe('setInputQueue(buffer)', () => {
+    let w: BrowserWindow;
+    beforeEach(async () => {
+      w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.executeJavaScript(`
+        window.receivedEvents = [];
+        for (const type of ['mousedown', 'mouseup', 'mousemove']) {
+          document.addEventListener(type, (e) => window.receivedEvents.push([e.type, e.clientX, e.clientY]));
+        }
+      `);
+    });
+    afterEach(closeAllWindows);
+
+    it('sends the events written to the buffer', async () => {
+      const capacity = 4;
+      const buffer = new SharedArrayBuffer(16 + capacity * 72);
+      const header = new Int32Array(buffer, 0, 4);
+      const slots = new Float64Array(buffer, 16);
+      w.webContents.setInputQueue(buffer, { pollInterval: 1 });
+
+      // More events than the capacity are written as they are read.
+      const events = [
+        [2, Date.now(), 0, 10, 10, -1, 0, 0, 0],
+        [0, Date.now(), 0, 10, 10, 0, 1, 0, 0],
+        [1, Date.now(), 0, 10, 10, 0, 1, 0, 0],
+        [2, Date.now(), 0, 20, 20, -1, 0, 0, 0],
+        [0, Date.now(), 0, 20, 20, 0, 1, 0, 0],
+        [1, Date.now(), 0, 20, 20, 0, 1, 0, 0]
+      ];
+      for (const event of events) {
+        while (Atomics.load(header, 0) - Atomics.load(header, 1) >= capacity) {
+          await setTimeout(1);
+        }
+        const written = Atomics.load(header, 0);
+        slots.set(event, (written % capacity) * 9);
+        Atomics.store(header, 0, written + 1);
+      }
+
+      const received = await w.webContents.executeJavaScript(`new Promise((resolve) => {
+        const check = () => window.receivedEvents.length >= 6 ? resolve(window.receivedEvents) : setTimeout(check, 10);
+        check();
+      })`);
+      expect(received).to.deep.equal([
+        ['mousemove', 10, 10], ['mousedown', 10, 10], ['mouseup', 10, 10],
+        ['mousemove', 20, 20], ['mousedown', 20, 20], ['mouseup', 20, 20]
+      ]);
+      expect(Atomics.load(header, 1)).to.equal(events.length);
+      w.webContents.setInputQueue(null);
+    });
+
+    it('throws for buffers that cannot hold a queue', () => {
+      expect(() => w.webContents.setInputQueue(new ArrayBuffer(88) as any)).to.throw(/SharedArrayBuffer/);
+      expect(() => w.webContents.setInputQueue(new SharedArrayBuffer(16))).to.throw(/16 byte header/);
+      expect(() => w.webContents.setInputQueue(new SharedArrayBuffer(16 + 100))).to.throw(/16 byte header/);
+    });
+  });
+
   describe('insertCSS', () => {
     afterEach(closeAllWindows);
     it('supports inserting CSS', async () => {
@@ -1112,6 +1309,107 @@ describe('webContents module', () => {
     });
   });
 
+  describe('webPreferences.processGroup', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    let crossSiteUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => { res.end('<title>group</title>'); });
+      const { port, url } = await listen(server);
+      serverUrl = url;
+      crossSiteUrl = `http://localhost:${port}`;
+    });
+    after(() => { server.close(); });
+    afterEach(closeAllWindows);
+
+    const createWindow = async (url: string, processGroup?: string) => {
+      const w = new BrowserWindow({ show: false, webPreferences: { processGroup } });
+      await w.loadURL(url);
+      return w;
+    };
+
+    it('shares the renderer process of same-site pages in the group', async () => {
+      const w1 = await createWindow(serverUrl, 'trusted');
+      const w2 = await createWindow(serverUrl, 'trusted');
+      expect(w2.webContents.getOSProcessId()).to.equal(w1.webContents.getOSProcessId());
+    });
+
+    it('does not share the renderer process of other groups', async () => {
+      const w1 = await createWindow(serverUrl, 'trusted');
+      const w2 = await createWindow(serverUrl, 'other');
+      const w3 = await createWindow(serverUrl);
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+      expect(w3.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+    });
+
+    it('does not share the renderer process of pages of other sites', async () => {
+      const w1 = await createWindow(serverUrl, 'trusted');
+      const w2 = await createWindow(crossSiteUrl, 'trusted');
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+    });
+
+    it('does not share the renderer process when the process preferences differ', async () => {
+      const w1 = await createWindow(serverUrl, 'trusted');
+      const w2 = new BrowserWindow({ show: false, webPreferences: { processGroup: 'trusted', sandbox: false } });
+      await w2.loadURL(serverUrl);
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+    });
+  });
+
+  describe('discard()', () => {
+    afterEach(closeAllWindows);
+
+    it('shuts down the renderer of a hidden page and restores it when shown', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+      const pid = w.webContents.getOSProcessId();
+      let gone = false;
+      w.webContents.once('render-process-gone', () => { gone = true; });
+      const discarded = once(w.webContents, 'discarded');
+      expect(w.webContents.discard()).to.equal(true);
+      await discarded;
+      expect(w.webContents.isDiscarded()).to.equal(true);
+      expect(gone).to.equal(false);
+
+      const restored = once(w.webContents, 'restored');
+      const loaded = once(w.webContents, 'did-finish-load');
+      w.show();
+      await restored;
+      await loaded;
+      expect(w.webContents.isDiscarded()).to.equal(false);
+      expect(w.webContents.getOSProcessId()).to.not.equal(pid);
+      expect(await w.webContents.executeJavaScript('document.wasDiscarded')).to.equal(true);
+      expect(w.webContents.getURL()).to.match(/base-page\.html$/);
+    });
+
+    it('does not discard pages with unload handlers', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'beforeunload-false.html'));
+      expect(w.webContents.discard()).to.equal(false);
+    });
+
+    it('can be prevented', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'));
+      w.webContents.once('will-discard', (event) => event.preventDefault());
+      expect(w.webContents.discard()).to.equal(false);
+      expect(w.webContents.isCrashed()).to.equal(false);
+    });
+  });
+
+  describe('setAutoDiscardable()', () => {
+    afterEach(closeAllWindows);
+
+    it('toggles whether the page is auto discardable', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(w.webContents.isAutoDiscardable()).to.equal(false);
+      w.webContents.setAutoDiscardable(true);
+      expect(w.webContents.isAutoDiscardable()).to.equal(true);
+      w.webContents.setAutoDiscardable(false);
+      expect(w.webContents.isAutoDiscardable()).to.equal(false);
+    });
+  });
+
   describe('getMediaSourceId()', () => {
     afterEach(closeAllWindows);
     it('returns a valid stream id', () => {
@@ -2069,6 +2367,175 @@ describe('webContents module', () => {
     });
   });
 
+  describe('setBackgroundThrottlingPolicy()', () => {
+    afterEach(closeAllWindows);
+
+    const listenToLifecycle = (w: BrowserWindow) => w.webContents.executeJavaScript(`
+      const { ipcRenderer } = require('electron');
+      document.addEventListener('freeze', () => ipcRenderer.send('lifecycle', 'freeze'));
+      document.addEventListener('resume', () => ipcRenderer.send('lifecycle', 'resume'));
+      null
+    `);
+
+    it('freezes a hidden page outside of its budget', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      await listenToLifecycle(w);
+      w.webContents.setBackgroundThrottlingPolicy({ interval: 1000, budget: 100 });
+      const [, first] = await once(ipcMain, 'lifecycle');
+      expect(first).to.equal('freeze');
+      const [, second] = await once(ipcMain, 'lifecycle');
+      expect(second).to.equal('resume');
+    });
+
+    it('applies the policy of the session', async () => {
+      const ses = session.fromPartition(`background-throttling-policy-${Math.random()}`);
+      ses.setBackgroundThrottlingPolicy({ interval: 1000, budget: 100 });
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses, nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      await listenToLifecycle(w);
+      const [, event] = await once(ipcMain, 'lifecycle');
+      expect(event).to.equal('freeze');
+      ses.setBackgroundThrottlingPolicy(null);
+    });
+
+    it('throws on an invalid policy', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setBackgroundThrottlingPolicy({ interval: 100, budget: 200 });
+      }).to.throw(/policy must be null or have a positive interval/);
+    });
+  });
+
+  describe('freeze() and resume()', () => {
+    afterEach(closeAllWindows);
+
+    const listenToLifecycle = (w: BrowserWindow) => w.webContents.executeJavaScript(`
+      const { ipcRenderer } = require('electron');
+      document.addEventListener('freeze', () => ipcRenderer.send('lifecycle', 'freeze'));
+      document.addEventListener('resume', () => ipcRenderer.send('lifecycle', 'resume'));
+      null
+    `);
+
+    it('freezes and resumes a hidden page', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      await listenToLifecycle(w);
+      const frozen = once(ipcMain, 'lifecycle');
+      expect(w.webContents.freeze()).to.equal(true);
+      expect(w.webContents.isFrozen()).to.equal(true);
+      expect((await frozen)[1]).to.equal('freeze');
+      expect(w.webContents.freeze()).to.equal(false);
+
+      const resumed = once(ipcMain, 'lifecycle');
+      w.webContents.resume();
+      expect(w.webContents.isFrozen()).to.equal(false);
+      expect((await resumed)[1]).to.equal('resume');
+    });
+
+    it('resumes a frozen page when it is shown', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      expect(w.webContents.freeze()).to.equal(true);
+      const resumed = once(w.webContents, 'resumed');
+      w.show();
+      await resumed;
+      expect(w.webContents.isFrozen()).to.equal(false);
+    });
+
+    it('freezes a page once it has been hidden for the auto freeze delay', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const frozen = once(w.webContents, 'frozen');
+      w.webContents.setAutoFreezeDelay(100);
+      await frozen;
+      expect(w.webContents.isFrozen()).to.equal(true);
+    });
+
+    it('does not freeze automatically when background throttling is disabled', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { backgroundThrottling: false } });
+      await w.loadURL('about:blank');
+      w.webContents.setAutoFreezeDelay(10);
+      await setTimeout(200);
+      expect(w.webContents.isFrozen()).to.equal(false);
+    });
+
+    it('throws on an invalid delay', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setAutoFreezeDelay(-1);
+      }).to.throw(/delay must be null or a non-negative integer/);
+    });
+  });
+
+  describe('getMemoryBreakdown()', () => {
+    afterEach(closeAllWindows);
+
+    it('attributes the JavaScript heap to each WebContents of a process', async () => {
+      const w1 = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w1.loadURL('about:blank');
+      const w2 = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w2.loadURL('about:blank');
+      await w1.webContents.executeJavaScript('window.retained = Array.from({ length: 1e6 }, (_, i) => ({ i })); null');
+
+      const [breakdown1, breakdown2] = await Promise.all([
+        w1.webContents.getMemoryBreakdown(),
+        w2.webContents.getMemoryBreakdown()
+      ]);
+      expect(breakdown1.process.pid).to.equal(w1.webContents.getOSProcessId());
+      expect(breakdown1.process.webContentsCount).to.be.at.least(1);
+      expect(breakdown1.process.v8).to.be.a('number');
+      expect(breakdown1.javaScript.node).to.be.greaterThan(breakdown2.javaScript.node + 10 * 1024);
+    });
+
+    it('reports the main world separately when context isolation is enabled', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadURL('about:blank');
+      const { javaScript } = await w.webContents.getMemoryBreakdown();
+      expect(javaScript.mainWorld).to.be.greaterThan(0);
+      expect(javaScript.node).to.equal(0);
+    });
+
+    it('rejects when the renderer is gone', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const gone = once(w.webContents, 'render-process-gone');
+      w.webContents.forcefullyCrashRenderer();
+      await gone;
+      await expect(w.webContents.getMemoryBreakdown()).to.eventually.be.rejectedWith(/nonexistent render frame/);
+    });
+  });
+
+  describe('collectJavaScriptCallStack()', () => {
+    afterEach(closeAllWindows);
+
+    it('collects the stack of a page that is busy', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      w.webContents.executeJavaScript('(function spinForAWhile () { const end = Date.now() + 3000; while (Date.now() < end); })()');
+      await setTimeout(500);
+      const { stack } = await w.webContents.collectJavaScriptCallStack();
+      expect(stack).to.include('spinForAWhile');
+    });
+
+    it('resolves with an empty stack when the page is idle', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const { stack, postedFrom } = await w.webContents.collectJavaScriptCallStack();
+      expect(stack).to.equal('');
+      expect(postedFrom).to.equal('');
+    });
+
+    it('rejects when the renderer is gone', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const gone = once(w.webContents, 'render-process-gone');
+      w.webContents.forcefullyCrashRenderer();
+      await gone;
+      await expect(w.webContents.collectJavaScriptCallStack()).to.eventually.be.rejectedWith(/renderer process/);
+    });
+  });
+
   describe('getBackgroundThrottling()', () => {
     afterEach(closeAllWindows);
     it('works via getter', () => {
@@ -2306,6 +2773,75 @@ describe('webContents module', () => {
         Suspects: false
       });
     });
+
+    it('can stream the PDF with printToPDFStream()', async () => {
+      await w.loadFile(path.join(__dirname, 'fixtures', 'api', 'print-to-pdf-small.html'));
+
+      const expected = await w.webContents.printToPDF({});
+      const chunks: Buffer[] = [];
+      for await (const chunk of await w.webContents.printToPDFStream()) {
+        chunks.push(chunk);
+      }
+      const data = Buffer.concat(chunks);
+      expect(data.length).to.be.greaterThan(0);
+      expect(data.subarray(0, 5).toString()).to.equal('%PDF-');
+
+      const doc = await pdfjs.getDocument(new Uint8Array(data)).promise;
+      expect(doc.numPages).to.equal((await pdfjs.getDocument(expected).promise).numPages);
+    });
+
+    describe('printToPDFFile()', () => {
+      let tmpDir: string;
+      beforeEach(() => {
+        tmpDir = fs.mkdtempSync(path.join(app.getPath('temp'), 'electron-print-to-pdf-'));
+      });
+      afterEach(() => {
+        fs.rmSync(tmpDir, { recursive: true, force: true });
+      });
+
+      it('writes the PDF to a file', async () => {
+        await w.loadFile(path.join(__dirname, 'fixtures', 'api', 'print-to-pdf-small.html'));
+
+        const pdfPath = path.join(tmpDir, 'out.pdf');
+        const result = await w.webContents.printToPDFFile(pdfPath);
+        const data = fs.readFileSync(pdfPath);
+        expect(result.size).to.equal(data.length);
+        expect(result.printTime).to.be.a('number');
+        expect(result.writeTime).to.be.a('number');
+
+        const doc = await pdfjs.getDocument(new Uint8Array(data)).promise;
+        expect(doc.numPages).to.equal(1);
+      });
+
+      it('rejects when the file can not be written', async () => {
+        await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+        const pdfPath = path.join(tmpDir, 'missing', 'out.pdf');
+        await expect(w.webContents.printToPDFFile(pdfPath)).to.eventually.be.rejectedWith('Failed to write PDF');
+      });
+
+      it('prints several pages with webContents.printToPDFFiles()', async () => {
+        const jobs = [1, 2, 3].map(i => ({
+          url: `data:text/html,<h1>Page ${i}</h1>`,
+          path: path.join(tmpDir, `${i}.pdf`)
+        }));
+        jobs.push({ url: 'bad://url', path: path.join(tmpDir, 'bad.pdf') });
+
+        const results = await webContents.printToPDFFiles(jobs, { concurrency: 2 });
+        expect(results.map(result => result.path)).to.deep.equal(jobs.map(job => job.path));
+        for (const result of results.slice(0, 3)) {
+          expect(result.error).to.be.undefined();
+          expect(result.loadTime).to.be.a('number');
+          expect(fs.statSync(result.path).size).to.equal(result.size);
+        }
+        expect(results[3].error).to.be.a('string');
+        expect(fs.existsSync(results[3].path)).to.be.false();
+      });
+
+      it('rejects an invalid concurrency', async () => {
+        await expect(webContents.printToPDFFiles([], { concurrency: 0 })).to.eventually.be.rejectedWith('concurrency must be a positive integer');
+      });
+    });
   });
 
   describe('PictureInPicture video', () => {
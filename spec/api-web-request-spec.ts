@@ -84,6 +84,57 @@ describe('webRequest module', () => {
     return contents.executeJavaScript(`ajax("${url}", ${JSON.stringify(options)})`);
   }
 
+  describe('webRequest.setRules', () => {
+    afterEach(() => {
+      ses.webRequest.setRules([]);
+    });
+
+    it('can block requests', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'filter/*'], action: 'block' }]);
+      expect((await ajax(`${defaultURL}nofilter/test`)).data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
+    });
+
+    it('can redirect requests', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + 'filter/*'], action: 'redirect', redirectURL: defaultURL + 'redirected' }]);
+      expect((await ajax(`${defaultURL}filter/test`)).data).to.equal('/redirected');
+    });
+
+    it('can modify headers', async () => {
+      ses.webRequest.setRules([{
+        urls: [defaultURL + '*'],
+        action: 'modifyHeaders',
+        requestHeaders: { Accept: '*/*;test/header' },
+        responseHeaders: { Custom: null, 'X-Rule': 'applied' }
+      }]);
+      const { data, headers } = await ajax(defaultURL);
+      expect(data).to.equal('/header/received');
+      expect(headers).to.not.have.property('custom');
+      expect(headers).to.have.property('x-rule', 'applied');
+    });
+
+    it('applies before listeners', async () => {
+      ses.webRequest.setRules([{ urls: [defaultURL + '*'], action: 'modifyHeaders', requestHeaders: { 'X-Rule': 'applied' } }]);
+      let seen: string | undefined;
+      ses.webRequest.onBeforeSendHeaders((details, callback) => {
+        seen = details.requestHeaders['X-Rule'];
+        callback({});
+      });
+      try {
+        await ajax(defaultURL);
+        expect(seen).to.equal('applied');
+      } finally {
+        ses.webRequest.onBeforeSendHeaders(null);
+      }
+    });
+
+    it('throws for invalid rules', () => {
+      expect(() => ses.webRequest.setRules([{ urls: ['bad'], action: 'block' }])).to.throw(/Invalid url pattern/);
+      expect(() => ses.webRequest.setRules([{ urls: [], action: 'nope' as any }])).to.throw('Invalid action nope');
+      expect(() => ses.webRequest.setRules([{ urls: [], action: 'redirect' }])).to.throw(/redirectURL/);
+    });
+  });
+
   describe('webRequest.onBeforeRequest', () => {
     afterEach(() => {
       ses.webRequest.onBeforeRequest(null);
@@ -106,6 +157,33 @@ describe('webRequest module', () => {
       await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
     });
 
+    it('can filter URLs against many patterns', async () => {
+      const { port } = new URL(defaultURL);
+      const urls = [...Array(500).keys()].map(i => `*://host-${i}.example.com/*`);
+      urls.push(`*://*.localhost:${port}/filter/*`, `http://127.0.0.1:${port}/filter/*`);
+      ses.webRequest.onBeforeRequest({ urls }, cancel);
+      const { data } = await ajax(`${defaultURL}nofilter/test`);
+      expect(data).to.equal('/nofilter/test');
+      await expect(ajax(`${defaultURL}filter/test`)).to.eventually.be.rejected();
+    });
+
+    it('does not see requests that start outside of the filter', async () => {
+      const urls: string[] = [];
+      ses.webRequest.onBeforeRequest({ urls: [defaultURL + 'filter/*'] }, (details, callback) => {
+        urls.push(details.url);
+        callback({});
+      });
+      ses.webRequest.onCompleted({ urls: [defaultURL + 'filter/*'] }, (details) => {
+        urls.push(details.url);
+      });
+      try {
+        expect((await ajax(`${defaultURL}nofilter/test`)).data).to.equal('/nofilter/test');
+        expect(urls).to.deep.equal([]);
+      } finally {
+        ses.webRequest.onCompleted(null);
+      }
+    });
+
     it('can filter URLs and types', async () => {
       const filter1: Electron.WebRequestFilter = { urls: [defaultURL + 'filter/*'], types: ['xhr'] };
       ses.webRequest.onBeforeRequest(filter1, cancel);
@@ -523,6 +601,40 @@ describe('webRequest module', () => {
     });
   });
 
+  describe('webRequest.onResponseBody', () => {
+    afterEach(() => {
+      ses.webRequest.onResponseBody(null);
+    });
+
+    it('can transform the response body', async () => {
+      ses.webRequest.onResponseBody((details, callback) => {
+        expect(details.statusCode).to.equal(200);
+        callback((chunk, push) => {
+          push(chunk && Buffer.from(chunk.toString().toUpperCase()));
+        });
+      });
+      const { data } = await ajax(defaultURL + 'transform');
+      expect(data).to.equal('/TRANSFORM');
+    });
+
+    it('can append to the end of the body', async () => {
+      ses.webRequest.onResponseBody((details, callback) => {
+        callback((chunk, push) => {
+          setTimeout(() => push(chunk ?? Buffer.from('/appended')), 10);
+        });
+      });
+      const { data } = await ajax(defaultURL);
+      expect(data).to.equal('//appended');
+    });
+
+    it('passes the body through when no transform is returned', async () => {
+      ses.webRequest.onResponseBody({ urls: [defaultURL + 'filter/*'] }, (details, callback) => {
+        callback();
+      });
+      expect((await ajax(defaultURL + 'filter/test')).data).to.equal('/filter/test');
+    });
+  });
+
   describe('webRequest.onBeforeRedirect', () => {
     afterEach(() => {
       ses.webRequest.onBeforeRedirect(null);
@@ -563,6 +675,34 @@ describe('webRequest module', () => {
       const { data } = await ajax(defaultURL);
       expect(data).to.equal('/');
     });
+
+    it('can deliver the details in batches', async () => {
+      const urls: string[] = [];
+      const received = new Promise<void>(resolve => {
+        ses.webRequest.onCompleted({ urls: [defaultURL + '*'], batchInterval: 500 }, ((batch: Electron.OnCompletedListenerDetails[]) => {
+          expect(batch).to.be.an('array');
+          urls.push(...batch.map(details => details.url));
+          if (urls.length === 2) resolve();
+        }) as any);
+      });
+      await Promise.all([ajax(`${defaultURL}first`), ajax(`${defaultURL}second`)]);
+      await received;
+      expect(urls.sort()).to.deep.equal([`${defaultURL}first`, `${defaultURL}second`]);
+    });
+
+    it('only fills the fields that are asked for', async () => {
+      const received = new Promise<Electron.OnCompletedListenerDetails>(resolve => {
+        ses.webRequest.onCompleted({ urls: [], fields: ['url', 'statusCode'] }, resolve);
+      });
+      await ajax(defaultURL);
+      expect(Object.keys(await received).sort()).to.deep.equal(['statusCode', 'url']);
+    });
+
+    it('rejects invalid batch intervals', () => {
+      expect(() => {
+        ses.webRequest.onCompleted({ urls: [], batchInterval: -1 }, () => {});
+      }).to.throw(/'batchInterval' must be a positive number/);
+    });
   });
 
   describe('webRequest.onErrorOccurred', () => {
@@ -580,6 +720,12 @@ describe('webRequest module', () => {
       });
       await expect(ajax(defaultURL)).to.eventually.be.rejected();
     });
+
+    it('can not be given the options of the observer events', () => {
+      expect(() => {
+        ses.webRequest.onBeforeRequest({ urls: [], batchInterval: 100 }, (details, callback) => callback({}));
+      }).to.throw(/only supported by the listeners that can't change the request/);
+    });
   });
 
   describe('WebSocket connections', () => {
@@ -676,5 +822,46 @@ describe('webRequest module', () => {
       expect(reqHeaders['/websocket'].foo).to.equal('bar');
       expect(reqHeaders['/'].foo).to.equal('bar');
     });
+
+    it('are not proxyed when no listener filter matches them', async () => {
+      const server = http.createServer((req, res) => {
+        res.end('ok');
+      });
+      const wss = new WebSocket.Server({ noServer: true });
+      wss.on('connection', (ws) => {
+        ws.on('message', (message) => {
+          if (message === 'foo') ws.send('bar');
+        });
+      });
+      server.on('upgrade', (request, socket, head) => {
+        wss.handleUpgrade(request, socket as Socket, head, (ws) => {
+          wss.emit('connection', ws, request);
+        });
+      });
+      const { port } = await listen(server);
+
+      const ses = session.fromPartition('WebRequestWebSocketFiltered');
+      const urls: string[] = [];
+      ses.webRequest.onBeforeSendHeaders({ urls: ['<all_urls>'], types: ['xhr'] }, (details, callback) => {
+        urls.push(details.url);
+        callback({});
+      });
+
+      const contents = (webContents as typeof ElectronInternal.WebContents).create({
+        session: ses,
+        nodeIntegration: true,
+        webSecurity: false,
+        contextIsolation: false
+      });
+      after(() => {
+        contents.destroy();
+        server.close();
+        ses.webRequest.onBeforeSendHeaders(null);
+      });
+
+      contents.loadFile(path.join(fixturesPath, 'api', 'webrequest.html'), { query: { port: `${port}` } });
+      await once(ipcMain, 'websocket-success');
+      expect(urls.some(url => url.startsWith('ws://'))).to.be.false();
+    });
   });
 });
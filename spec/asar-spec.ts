@@ -1,4 +1,5 @@
 import { expect } from 'chai';
+import * as cp from 'node:child_process';
 import * as path from 'node:path';
 import * as url from 'node:url';
 import { Worker } from 'node:worker_threads';
@@ -57,6 +58,53 @@ describe('asar package', () => {
       expect(message).to.equal('pong');
     });
 
+    it('loads a page from an archive with compressed files', async function () {
+      after(function () {
+        ipcMain.removeAllListeners('ping');
+      });
+
+      const w = new BrowserWindow({
+        show: false,
+        width: 400,
+        height: 400,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: false
+        }
+      });
+      // The files span several blocks, see script/asar-compress.js.
+      const p = path.resolve(asarDir, 'compressed-script.asar', 'index.html');
+      const ping = once(ipcMain, 'ping');
+      w.loadFile(p);
+      const [, message] = await ping;
+      expect(message).to.equal('pong');
+    });
+
+    it('loads a page whose resources are listed in a prefetch manifest', async function () {
+      after(function () {
+        ipcMain.removeAllListeners('ping');
+      });
+
+      const w = new BrowserWindow({
+        show: false,
+        width: 400,
+        height: 400,
+        webPreferences: {
+          nodeIntegration: true,
+          contextIsolation: false
+        }
+      });
+      // The manifest also lists a file missing from the archive, which has
+      // to be ignored.
+      const p = path.resolve(asarDir, 'prefetch.asar', 'index.html');
+      for (let i = 0; i < 2; i++) {
+        const ping = once(ipcMain, 'ping');
+        w.loadFile(p);
+        const [, message] = await ping;
+        expect(message).to.equal('pong');
+      }
+    });
+
     it('loads video tag in html', async function () {
       this.timeout(60000);
 
@@ -127,6 +175,72 @@ describe('asar package', () => {
       });
     });
   });
+
+  describe('module resolution index', () => {
+    it('resolves requires from inside the archive using its index', () => {
+      const main = path.join(asarDir, 'resolve-index.asar', 'main.js');
+      // The index deliberately points './lib' at lib/indexed.js rather than
+      // lib/index.js to prove that regular resolution was skipped.
+      expect(require(main)).to.equal('indexed:dep');
+    });
+  });
+
+  describe('ELECTRON_ASAR_MMAP', () => {
+    it('reads packed files through the archive mapping', () => {
+      const file1 = path.join(asarDir, 'a.asar', 'file1');
+      const script = `
+        const fs = require('node:fs');
+        process.stdout.write(JSON.stringify({
+          sync: fs.readFileSync(${JSON.stringify(file1)}, 'utf8').trim(),
+          nested: fs.readFileSync(${JSON.stringify(path.join(asarDir, 'a.asar', 'dir1', 'file2'))}, 'utf8').trim()
+        }));
+      `;
+      const { stdout, status } = cp.spawnSync(process.execPath, ['-e', script], {
+        env: { ...process.env, ELECTRON_RUN_AS_NODE: '1', ELECTRON_ASAR_MMAP: '1' }
+      });
+      expect(status).to.equal(0);
+      const result = JSON.parse(stdout.toString());
+      expect(result.sync).to.equal('file1');
+      expect(result.nested).to.equal('file2');
+    });
+  });
+
+  describe('extraction cache', () => {
+    const copyFileOut = (env: NodeJS.ProcessEnv) => {
+      const script = `
+        const archive = process._getOrCreateArchive(${JSON.stringify(path.join(asarDir, 'a.asar'))});
+        process.stdout.write(archive.copyFileOut('file1'));
+      `;
+      const { stdout, status } = cp.spawnSync(process.execPath, ['-e', script], {
+        env: { ...process.env, ELECTRON_RUN_AS_NODE: '1', ...env }
+      });
+      expect(status).to.equal(0);
+      return stdout.toString();
+    };
+
+    it('extracts a packed file once for all the processes', () => {
+      const first = copyFileOut({});
+      const second = copyFileOut({});
+      expect(second).to.equal(first);
+      expect(importedFs.readFileSync(first, 'utf8').trim()).to.equal('file1');
+    });
+
+    it('extracts a packed file again when its copy was modified', () => {
+      const first = copyFileOut({});
+      importedFs.writeFileSync(first, 'modified');
+      const second = copyFileOut({});
+      expect(second).to.equal(first);
+      expect(importedFs.readFileSync(second, 'utf8').trim()).to.equal('file1');
+    });
+
+    // On Windows temporary files are only deleted on reboot.
+    ifit(process.platform !== 'win32')('extracts into a temporary file when disabled', () => {
+      const cached = copyFileOut({});
+      const temporary = copyFileOut({ ELECTRON_DISABLE_ASAR_EXTRACTION_CACHE: '1' });
+      expect(temporary).to.not.equal(cached);
+      expect(importedFs.existsSync(temporary)).to.be.false();
+    });
+  });
 });
 
 // eslint-disable-next-line @typescript-eslint/no-unused-vars
@@ -250,6 +364,46 @@ describe('asar package', function () {
       });
     });
 
+    describe('compressed files', function () {
+      itremote('reads files that span several blocks', async function () {
+        const p = path.join(asarDir, 'compressed.asar');
+        expect(fs.readFileSync(path.join(p, 'file1'), 'utf8')).to.equal('file1\n');
+        expect(fs.readFileSync(path.join(p, 'dir1', 'file2')).toString().trim()).to.equal('file2');
+        expect((await fs.promises.readFile(path.join(p, 'file3'), 'utf8')).trim()).to.equal('file3');
+        expect(fs.statSync(path.join(p, 'file1')).size).to.equal(6);
+      });
+
+      itremote('copies decompressed files out of the archive', function () {
+        const p = path.join(asarDir, 'compressed.asar', 'file1');
+        const dest = path.join(require('node:os').tmpdir(), 'compressed-file1');
+        fs.copyFileSync(p, dest);
+        try {
+          expect(fs.readFileSync(dest, 'utf8')).to.equal('file1\n');
+        } finally {
+          fs.unlinkSync(dest);
+        }
+      });
+    });
+
+    describe('binary header', function () {
+      itremote('reads files from an archive with a pre-indexed header', function () {
+        const p = path.join(asarDir, 'indexed.asar');
+        expect(fs.readFileSync(path.join(p, 'file1')).toString().trim()).to.equal('file1');
+        expect(fs.readFileSync(path.join(p, 'dir1', 'file2')).toString().trim()).to.equal('file2');
+        expect(fs.readFileSync(path.join(p, 'link2', 'file1')).toString().trim()).to.equal('file1');
+      });
+
+      itremote('lists and stats entries of an archive with a pre-indexed header', function () {
+        const p = path.join(asarDir, 'indexed.asar');
+        expect(fs.readdirSync(p)).to.deep.equal(['dir1', 'dir2', 'dir3', 'file1', 'file2', 'file3', 'link1', 'link2', 'ping.js']);
+        expect(fs.readdirSync(path.join(p, 'link2'))).to.deep.equal(['file1', 'file2', 'file3', 'link1', 'link2']);
+        expect(fs.lstatSync(path.join(p, 'dir1')).isDirectory()).to.be.true();
+        expect(fs.lstatSync(path.join(p, 'link1')).isSymbolicLink()).to.be.true();
+        expect(fs.statSync(path.join(p, 'file1')).size).to.equal(6);
+        expect(fs.existsSync(path.join(p, 'not-exist'))).to.be.false();
+      });
+    });
+
     describe('fs.readFile', function () {
       itremote('reads a normal file', async function () {
         const p = path.join(asarDir, 'a.asar', 'file1');
@@ -260,6 +414,17 @@ describe('asar package', function () {
         expect(String(content).trim()).to.equal('file1');
       });
 
+      itremote('reads many files at the same time', async function () {
+        const files = ['file1', 'file2', 'file3', 'dir1/file1', 'dir1/file2', 'dir2/file1', 'file1'];
+        const contents = await Promise.all(files.map(file => new Promise((resolve, reject) => {
+          fs.readFile(path.join(asarDir, 'a.asar', file), 'utf8', (err, content) => {
+            if (err) return reject(err);
+            resolve(content);
+          });
+        })));
+        expect(contents.map(content => String(content).trim())).to.deep.equal(files.map(file => path.basename(file)));
+      });
+
       itremote('reads from a empty file', async function () {
         const p = path.join(asarDir, 'empty.asar', 'file1');
         const content = await new Promise((resolve, reject) => fs.readFile(p, (err, content) => {
@@ -974,6 +1139,31 @@ describe('asar package', function () {
         expect(names).to.deep.equal(['file1', 'file2', 'file3']);
       });
 
+      itremote('reports the type of each entry with withFileTypes', function () {
+        const p = path.join(asarDir, 'a.asar');
+        const dirents = fs.readdirSync(p, { withFileTypes: true });
+        const byName = Object.fromEntries(dirents.map((dirent: any) => [dirent.name, dirent]));
+        expect(byName.dir1.isDirectory()).to.be.true();
+        expect(byName.file1.isFile()).to.be.true();
+        expect(byName.link1.isSymbolicLink()).to.be.true();
+        expect(byName.link2.isSymbolicLink()).to.be.true();
+      });
+
+      itremote('reads a whole archive recursively without following links', function () {
+        const p = path.join(asarDir, 'a.asar');
+        const dirents = fs.readdirSync(p, { recursive: true, withFileTypes: true });
+        const paths = dirents.map((dirent: any) => path.relative(p, path.join(dirent.path, dirent.name)));
+        expect(paths).to.include.members([
+          'dir1',
+          path.join('dir1', 'file1'),
+          path.join('dir3', 'file3'),
+          'link2'
+        ]);
+        expect(paths.filter((p: string) => p.startsWith(`link2${path.sep}`))).to.be.empty();
+        const nested = dirents.find((dirent: any) => dirent.name === 'file1' && dirent.path === path.join(p, 'dir1'));
+        expect(nested.isFile()).to.be.true();
+      });
+
       itremote('reads dirs from a linked dir', function () {
         const p = path.join(asarDir, 'a.asar', 'link2', 'link2');
         const dirs = fs.readdirSync(p);
@@ -1505,8 +1695,7 @@ describe('asar package', function () {
 
       itremote('disables asar support in sync API', function (errorName: string) {
         const file = path.join(asarDir, 'a.asar', 'file1');
-        const dir = path.join(asarDir, 'a.asar', 'dir1');
-        console.log(1);
+          console.log(1);
         expect(() => {
           fs.readFileSync(file);
         }).to.throw(new RegExp(errorName));
@@ -1523,8 +1712,7 @@ describe('asar package', function () {
 
       itremote('disables asar support in async API', async function (errorName: string) {
         const file = path.join(asarDir, 'a.asar', 'file1');
-        const dir = path.join(asarDir, 'a.asar', 'dir1');
-        await new Promise<void>(resolve => {
+          await new Promise<void>(resolve => {
           fs.readFile(file, function (error) {
             expect(error?.code).to.equal(errorName);
             fs.lstat(file, function (error) {
@@ -1543,8 +1731,7 @@ describe('asar package', function () {
 
       itremote('disables asar support in promises API', async function (errorName: string) {
         const file = path.join(asarDir, 'a.asar', 'file1');
-        const dir = path.join(asarDir, 'a.asar', 'dir1');
-        await expect(fs.promises.readFile(file)).to.be.eventually.rejectedWith(Error, new RegExp(errorName));
+          await expect(fs.promises.readFile(file)).to.be.eventually.rejectedWith(Error, new RegExp(errorName));
         await expect(fs.promises.lstat(file)).to.be.eventually.rejectedWith(Error, new RegExp(errorName));
         await expect(fs.promises.realpath(file)).to.be.eventually.rejectedWith(Error, new RegExp(errorName));
         await expect(fs.promises.readdir(dir)).to.be.eventually.rejectedWith(Error, new RegExp(errorName));
@@ -478,6 +478,33 @@ describe('command line switches', () => {
     ifit(process.platform === 'linux')('should not change LC_ALL when --lang is not set', async () => testLocale('', lcAll, true));
   });
 
+  describe('--headless-server switch', () => {
+    it('renders offscreen without the desktop subsystems', async () => {
+      const appPath = path.join(fixturesPath, 'api', 'headless-server');
+      // No display is needed on Linux.
+      const env = { ...process.env, DISPLAY: '', WAYLAND_DISPLAY: '' };
+      appProcess = ChildProcess.spawn(process.execPath, [appPath, '--headless-server'], { env });
+
+      let output = '';
+      appProcess.stdout.on('data', (data) => { output += data; });
+      let stderr = '';
+      appProcess.stderr.on('data', (data) => { stderr += data; });
+
+      const [code, signal] = await once(appProcess, 'exit');
+      if (code !== 0) {
+        throw new Error(`Process exited with code "${code}" signal "${signal}" output "${output}" stderr "${stderr}"`);
+      }
+
+      expect(JSON.parse(output)).to.deep.equal({
+        offscreen: true,
+        painted: true,
+        applicationMenu: false,
+        notificationSupported: false,
+        trayError: 'Cannot create Tray in headless server mode'
+      });
+    });
+  });
+
   describe('--remote-debugging-pipe switch', () => {
     it('should expose CDP via pipe', async () => {
       const electronPath = process.execPath;
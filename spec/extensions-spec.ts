@@ -198,6 +198,24 @@ describe('chrome extensions', () => {
     await expect(promise).to.eventually.be.rejected();
   });
 
+  it('loads several extensions at once', async () => {
+    const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+    const extensionPaths = ['red-bg', 'content-script', 'chrome-i18n'].map(name => path.join(fixtures, 'extensions', name));
+    const extensions = await customSession.loadExtensions(extensionPaths);
+    expect(extensions.map(extension => extension.path)).to.deep.equal(extensionPaths);
+    expect(customSession.getAllExtensions().map(extension => extension.id).sort()).to.deep.equal(extensions.map(extension => extension.id).sort());
+  });
+
+  it('rejects when one of several extensions fails to load', async () => {
+    const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+    const promise = customSession.loadExtensions([
+      path.join(fixtures, 'extensions', 'red-bg'),
+      path.join(fixtures, 'extensions', 'missing-manifest')
+    ]);
+    await expect(promise).to.eventually.be.rejectedWith(/Manifest file is missing or unreadable/);
+    expect(customSession.getAllExtensions()).to.have.lengthOf(1);
+  });
+
   it('serializes a loaded extension', async () => {
     const extensionPath = path.join(fixtures, 'extensions', 'red-bg');
     const manifest = JSON.parse(await fs.readFile(path.join(extensionPath, 'manifest.json'), 'utf-8'));
@@ -1230,6 +1248,27 @@ describe('chrome extensions', () => {
             });
           }
         });
+
+        it('can query for tabs by url', async () => {
+          await w.loadURL(url);
+
+          const otherHostUrl = url.replace('127.0.0.1', 'localhost');
+          const otherHostWin = new BrowserWindow({
+            show: false,
+            webPreferences: {
+              session: customSession
+            }
+          });
+          await otherHostWin.loadURL(otherHostUrl);
+
+          const message = { method: 'query', args: [{ url: 'http://localhost/*' }] };
+          w.webContents.executeJavaScript(`window.postMessage('${JSON.stringify(message)}', '*')`);
+
+          const [, , responseString] = await once(w.webContents, 'console-message');
+          const response = JSON.parse(responseString);
+          expect(response).to.have.lengthOf(1);
+          expect(response[0].id).to.equal(otherHostWin.webContents.id);
+        });
       });
     });
 
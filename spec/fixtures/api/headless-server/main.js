@@ -0,0 +1,26 @@
+const { app, BrowserWindow, Menu, Notification, Tray, nativeImage } = require('electron');
+
+app.whenReady().then(async () => {
+  const w = new BrowserWindow({ show: false, width: 100, height: 100 });
+  const painted = new Promise(resolve => w.webContents.once('paint', (event, dirty, image) => resolve(image)));
+  await w.loadURL('data:text/html,<body style="background: red"></body>');
+  const image = await painted;
+
+  let trayError = null;
+  try {
+    new Tray(nativeImage.createEmpty()); // eslint-disable-line no-new
+  } catch (error) {
+    trayError = error.message;
+  }
+
+  process.stdout.write(JSON.stringify({
+    offscreen: w.webContents.isOffscreen(),
+    painted: !image.isEmpty(),
+    applicationMenu: Menu.getApplicationMenu() !== null,
+    notificationSupported: Notification.isSupported(),
+    trayError
+  }));
+  process.stdout.end();
+
+  app.quit();
+});
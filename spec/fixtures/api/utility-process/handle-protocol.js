@@ -0,0 +1,6 @@
+process.parentPort.handleProtocol('utility-test', async (request) => {
+  const body = request.method === 'POST' ? await request.text() : 'hello';
+  return new Response(`${body} from ${request.url}`, {
+    headers: { 'content-type': 'text/plain' }
+  });
+});
@@ -0,0 +1,9 @@
+process.parentPort.on('message', (e) => {
+  if (e.data === 'crash') {
+    process.crash();
+  } else if (e.data === 'pid') {
+    process.parentPort.postMessage(process.pid);
+  } else {
+    setTimeout(() => process.parentPort.postMessage(e.data), 10);
+  }
+});
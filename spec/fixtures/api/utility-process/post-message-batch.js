@@ -0,0 +1,11 @@
+setTimeout(() => {
+  let batches = 0;
+  const data = [];
+  process.parentPort.on('messages', (events) => {
+    batches++;
+    data.push(...events.map(e => e.data));
+    if (data.length === 3) {
+      process.parentPort.postMessage({ batches, data });
+    }
+  });
+}, 1000);
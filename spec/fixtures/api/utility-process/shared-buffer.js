@@ -0,0 +1,10 @@
+process.parentPort.on('shared-buffer', ({ name, buffer }) => {
+  const echo = () => {
+    let record;
+    while ((record = buffer.read()) !== null) {
+      buffer.write(Buffer.concat([Buffer.from(`${name}:`), record]));
+    }
+  };
+  buffer.on('readable', echo);
+  echo();
+});
@@ -0,0 +1,6 @@
+process.parentPort.on('message', (e) => {
+  const bytes = new Uint8Array(e.data);
+  const buffer = bytes.map((byte) => byte * 2).buffer;
+  process.parentPort.postMessage(buffer, [buffer]);
+  process.parentPort.postMessage(buffer.byteLength);
+});
@@ -0,0 +1,16 @@
+const { ipcMain, net } = require('electron');
+const { parentPort } = require('node:worker_threads');
+
+parentPort.on('message', async (message) => {
+  try {
+    if (message.type === 'handle') {
+      await ipcMain.handle(message.channel, (event, ...args) => ({ senderId: event.senderId, args }));
+      parentPort.postMessage({ ok: true });
+    } else if (message.type === 'fetch') {
+      const response = await net.fetch(message.url);
+      parentPort.postMessage({ status: response.status, text: await response.text() });
+    }
+  } catch (error) {
+    parentPort.postMessage({ error: error.message });
+  }
+});
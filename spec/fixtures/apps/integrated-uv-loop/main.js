@@ -0,0 +1,26 @@
+const { app } = require('electron');
+const fs = require('node:fs');
+const net = require('node:net');
+const { setTimeout } = require('node:timers/promises');
+
+async function roundTrip () {
+  const server = net.createServer(socket => socket.pipe(socket));
+  await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+  const socket = net.connect(server.address().port, '127.0.0.1');
+  const received = await new Promise((resolve, reject) => {
+    socket.once('data', data => resolve(data.toString()));
+    socket.once('error', reject);
+    socket.write('ping');
+  });
+  socket.destroy();
+  server.close();
+  return received;
+}
+
+app.whenReady().then(async () => {
+  // Scheduled from a Chromium task rather than from within uv.
+  await setTimeout(50);
+  const contents = await fs.promises.readFile(__filename, 'utf8');
+  const received = await roundTrip();
+  app.exit(contents.length > 0 && received === 'ping' ? 0 : 1);
+});
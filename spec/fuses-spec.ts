@@ -1,8 +1,10 @@
 import { expect } from 'chai';
-import { startRemoteControlApp } from './lib/spec-helpers';
+import { startRemoteControlApp, waitUntil } from './lib/spec-helpers';
 import { once } from 'node:events';
 import { spawn } from 'node:child_process';
 import { BrowserWindow } from 'electron';
+import fs = require('node:fs');
+import os = require('node:os');
 import path = require('node:path');
 
 describe('fuses', () => {
@@ -25,4 +27,49 @@ describe('fuses', () => {
       return await bw.webContents.executeJavaScript("ajax('file:///etc/passwd')");
     }, path.join(__dirname, 'fixtures', 'pages', 'fetch.html'))).to.eventually.be.rejectedWith('Failed to fetch');
   });
+
+  it('caches compiled asar scripts when asar_code_cache is 1', async () => {
+    const userDataDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-code-cache-'));
+    const rc = await startRemoteControlApp(['--set-fuse-asar_code_cache=1', `--user-data-dir=${userDataDir}`]);
+    const result = await rc.remotely((main: string) => require(main), path.join(__dirname, 'fixtures', 'test.asar', 'resolve-index.asar', 'main.js'));
+    expect(result).to.equal('indexed:dep');
+    const cacheDir = path.join(userDataDir, 'Code Cache', 'asar');
+    await waitUntil(() => fs.existsSync(cacheDir) && fs.readdirSync(cacheDir).length > 0);
+  });
+
+  it('caches the compiled bootstrap when bootstrap_code_cache is 1', async () => {
+    const userDataDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-bootstrap-code-cache-'));
+    const args = ['--set-fuse-bootstrap_code_cache=1', `--user-data-dir=${userDataDir}`];
+    const cacheFile = path.join(userDataDir, 'Code Cache', 'bootstrap');
+    const rc1 = await startRemoteControlApp(args);
+    await waitUntil(() => fs.existsSync(cacheFile) && fs.statSync(cacheFile).size > 0);
+    rc1.process.kill();
+    await once(rc1.process, 'exit');
+
+    // The next launch starts from the cache.
+    const rc2 = await startRemoteControlApp(args);
+    expect(await rc2.remotely(() => require('electron').app.isReady())).to.be.true();
+  });
+
+  it('caches the compiled renderer bootstrap when bootstrap_code_cache is 1', async () => {
+    const userDataDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-bootstrap-code-cache-'));
+    const args = ['--set-fuse-bootstrap_code_cache=1', `--user-data-dir=${userDataDir}`];
+    const cacheFile = path.join(userDataDir, 'Code Cache', 'bootstrap-renderer');
+    const loadNodeWindow = async () => {
+      const { BrowserWindow } = require('electron');
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      return w.webContents.executeJavaScript('typeof require(\'node:path\').join');
+    };
+
+    const rc1 = await startRemoteControlApp(args);
+    expect(await rc1.remotely(loadNodeWindow)).to.equal('function');
+    await waitUntil(() => fs.existsSync(cacheFile) && fs.statSync(cacheFile).size > 0);
+    rc1.process.kill();
+    await once(rc1.process, 'exit');
+
+    // Renderers of the next launch start from the cache.
+    const rc2 = await startRemoteControlApp(args);
+    expect(await rc2.remotely(loadNodeWindow)).to.equal('function');
+  });
 });
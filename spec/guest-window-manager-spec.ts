@@ -374,3 +374,73 @@ describe('webContents.setWindowOpenHandler', () => {
     });
   });
 });
+
+describe('webContents.setWindowOpenRules', () => {
+  let browserWindow: BrowserWindow;
+  beforeEach(async () => {
+    browserWindow = new BrowserWindow({ show: false });
+    await browserWindow.loadURL('about:blank');
+  });
+
+  afterEach(closeAllWindows);
+
+  it('denies the windows matched by a deny rule without calling the handler', async () => {
+    browserWindow.webContents.setWindowOpenRules([{ urls: ['https://denied.test/*'], action: 'deny' }]);
+    browserWindow.webContents.setWindowOpenHandler(() => {
+      assert.fail('the handler should not be called for matched URLs');
+    });
+    browserWindow.webContents.on('did-create-window', () => {
+      assert.fail('did-create-window should not be called for denied windows');
+    });
+    expect(await browserWindow.webContents.executeJavaScript("window.open('https://denied.test/page') === null")).to.be.true();
+  });
+
+  it('calls the handler when no rule matches', async () => {
+    browserWindow.webContents.setWindowOpenRules([{ urls: ['https://denied.test/*'], action: 'deny' }]);
+    const called = new Promise<string>((resolve) => {
+      browserWindow.webContents.setWindowOpenHandler(({ url }) => {
+        resolve(url);
+        return { action: 'deny' };
+      });
+    });
+    browserWindow.webContents.executeJavaScript("window.open('about:blank?other', '', 'show=no') && true");
+    expect(await called).to.equal('about:blank?other');
+  });
+
+  it('applies the options of allow rules', async () => {
+    browserWindow.webContents.setWindowOpenRules([{
+      urls: [],
+      action: 'allow',
+      overrideBrowserWindowOptions: { show: false, width: 321 }
+    }]);
+    browserWindow.webContents.setWindowOpenHandler(() => {
+      assert.fail('the handler should not be called for matched URLs');
+    });
+    const created = once(browserWindow.webContents, 'did-create-window') as Promise<[BrowserWindow, Electron.DidCreateWindowDetails]>;
+    browserWindow.webContents.executeJavaScript("window.open('about:blank') && true");
+    const [, details] = await created;
+    expect(details.options.width).to.equal(321);
+  });
+
+  it('replaces the rules when called again', async () => {
+    browserWindow.webContents.setWindowOpenRules([{ urls: [], action: 'deny' }]);
+    browserWindow.webContents.setWindowOpenRules([]);
+    const called = new Promise((resolve) => {
+      browserWindow.webContents.setWindowOpenHandler(() => {
+        setTimeout(resolve);
+        return { action: 'deny' };
+      });
+    });
+    browserWindow.webContents.executeJavaScript("window.open('about:blank', '', 'show=no') && true");
+    await called;
+  });
+
+  it('throws for invalid rules', () => {
+    expect(() => {
+      browserWindow.webContents.setWindowOpenRules([{ urls: [], action: 'maybe' as any }]);
+    }).to.throw(/Invalid action maybe/);
+    expect(() => {
+      browserWindow.webContents.setWindowOpenRules([{ urls: ['not a pattern'], action: 'deny' }]);
+    }).to.throw(/Invalid url pattern/);
+  });
+});
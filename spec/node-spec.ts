@@ -168,6 +168,26 @@ describe('node feature', () => {
     expect(code).to.equal(0);
   });
 
+  ifit(process.platform === 'linux')('dispatches uv events from the Chromium loop with ELECTRON_INTEGRATED_UV_LOOP', async () => {
+    const appPath = path.join(mainFixturesPath, 'apps', 'integrated-uv-loop', 'main.js');
+    const appProcess = childProcess.spawn(process.execPath, [appPath], {
+      env: { ...process.env, ELECTRON_INTEGRATED_UV_LOOP: '1' },
+      stdio: 'inherit'
+    });
+    const [code] = await once(appProcess, 'close');
+    expect(code).to.equal(0);
+  });
+
+  it('handles uv events with ELECTRON_UV_DRAIN_BUDGET_MS', async () => {
+    const appPath = path.join(mainFixturesPath, 'apps', 'integrated-uv-loop', 'main.js');
+    const appProcess = childProcess.spawn(process.execPath, [appPath], {
+      env: { ...process.env, ELECTRON_UV_DRAIN_BUDGET_MS: '5' },
+      stdio: 'inherit'
+    });
+    const [code] = await once(appProcess, 'close');
+    expect(code).to.equal(0);
+  });
+
   describe('contexts', () => {
     describe('setTimeout called under Chromium event loop in browser process', () => {
       it('Can be scheduled in time', (done) => {
@@ -726,6 +746,20 @@ describe('node feature', () => {
     });
   });
 
+  describe('ELECTRON_RUN_AS_NODE_MINIMAL', () => {
+    it('runs scripts with a minimal startup', async () => {
+      const script = 'process.stdout.write(JSON.stringify({ electron: process.versions.electron !== undefined, intl: new Intl.NumberFormat(\'en-US\').format(1234.5), crashReporter: typeof process.crashReporter.addExtraParameter }))';
+      const child = childProcess.spawn(process.execPath, ['-e', script], {
+        env: { ...process.env, ELECTRON_RUN_AS_NODE: '1', ELECTRON_RUN_AS_NODE_MINIMAL: '1' }
+      });
+      let output = '';
+      child.stdout.on('data', (data) => { output += data; });
+      const [code] = await once(child, 'exit');
+      expect(code).to.equal(0);
+      expect(JSON.parse(output)).to.deep.equal({ electron: true, intl: '1,234.5', crashReporter: 'function' });
+    });
+  });
+
   describe('Node.js cli flags', () => {
     let child: childProcess.ChildProcessWithoutNullStreams;
     let exitPromise: Promise<any[]>;
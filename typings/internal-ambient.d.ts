@@ -27,6 +27,17 @@ declare namespace NodeJS {
     sendToHost(channel: string, args: any[]): void;
     invoke<T>(internal: boolean, channel: string, args: any[]): Promise<{ error: string, result: T }>;
     postMessage(channel: string, message: any, transferables: MessagePort[]): void;
+    getSharedValue(key: string): any;
+    getSharedBuffer(name: string): ArrayBuffer | null;
+    getStats(): Electron.IpcRendererChannelStats[];
+    resetStats(): void;
+  }
+
+  interface SharedValuesBinding {
+    setSharedValue(key: string, value: any): void;
+    deleteSharedValue(key: string): void;
+    setSharedBuffer(name: string, data: ArrayBufferView, origins: string[]): void;
+    deleteSharedBuffer(name: string): void;
   }
 
   interface V8UtilBinding {
@@ -60,6 +71,7 @@ declare namespace NodeJS {
     size: number;
     unpacked: boolean;
     offset: number;
+    compressed: boolean;
     integrity?: {
       algorithm: 'SHA256';
       hash: string;
@@ -76,13 +88,20 @@ declare namespace NodeJS {
     getFileInfo(path: string): AsarFileInfo | false;
     stat(path: string): AsarFileStat | false;
     readdir(path: string): string[] | false;
+    readdirWithTypes(path: string, recursive: boolean): [string[], number[], number[]] | false;
     realpath(path: string): string | false;
     copyFileOut(path: string): string | false;
     getFdAndValidateIntegrityLater(): number | -1;
+    readFileMapped(path: string): Buffer | false;
+    readCompressedFile(path: string): Buffer | false;
+    readFileAsync(path: string): Promise<Buffer | false> | false;
+    resolveModule(parentDir: string, request: string): string | false;
+    getCacheKey(): string;
   }
 
   interface AsarBinding {
     Archive: { new(path: string): AsarArchive };
+    getCodeCacheDirectory(): string | undefined;
     splitPath(path: string): {
       isAsar: false;
     } | {
@@ -164,6 +183,10 @@ declare namespace NodeJS {
     referrer?: string;
     referrerPolicy?: string;
     cache?: string;
+    priority?: string;
+    priorityIncremental?: boolean;
+    downloadToFile?: string;
+    uploadFile?: { path: string, offset?: number, length?: number };
     origin?: string;
     hasUserActivation?: boolean;
     mode?: string;
@@ -176,6 +199,7 @@ declare namespace NodeJS {
     httpVersion: { major: number, minor: number };
     rawHeaders: { key: string, value: string }[];
     headers: Record<string, string[]>;
+    connectionInfo: Electron.ConnectionInfo;
   };
 
   type RedirectInfo = {
@@ -223,11 +247,13 @@ declare namespace NodeJS {
     _linkedBinding(name: 'electron_browser_message_port'): { createPair(): { port1: Electron.MessagePortMain, port2: Electron.MessagePortMain }; };
     _linkedBinding(name: 'electron_browser_native_theme'): { nativeTheme: Electron.NativeTheme };
     _linkedBinding(name: 'electron_browser_notification'): NotificationBinding;
+    _linkedBinding(name: 'electron_browser_offscreen_atlas'): { OffscreenAtlas: typeof Electron.OffscreenAtlas };
     _linkedBinding(name: 'electron_browser_power_monitor'): PowerMonitorBinding;
     _linkedBinding(name: 'electron_browser_power_save_blocker'): { powerSaveBlocker: Electron.PowerSaveBlocker };
     _linkedBinding(name: 'electron_browser_push_notifications'): { pushNotifications: Electron.PushNotifications };
     _linkedBinding(name: 'electron_browser_safe_storage'): { safeStorage: Electron.SafeStorage };
     _linkedBinding(name: 'electron_browser_session'): SessionBinding;
+    _linkedBinding(name: 'electron_browser_shared_values'): SharedValuesBinding;
     _linkedBinding(name: 'electron_browser_screen'): { createScreen(): Electron.Screen };
     _linkedBinding(name: 'electron_browser_system_preferences'): { systemPreferences: Electron.SystemPreferences };
     _linkedBinding(name: 'electron_browser_tray'): { Tray: Electron.Tray };
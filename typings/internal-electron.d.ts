@@ -35,6 +35,8 @@ declare namespace Electron {
     _setTouchBarItems: (items: TouchBarItemType[]) => void;
     _setEscapeTouchBarItem: (item: TouchBarItemType | {}) => void;
     _refreshTouchBarItem: (itemID: string) => void;
+    _setTouchBarItemLabel: (itemID: string, label: string) => void;
+    _setTouchBarItemValue: (itemID: string, value: number) => void;
     _getWindowButtonVisibility: () => boolean;
     _getAlwaysOnTopLevel: () => string;
     devToolsWebContents: WebContents;
@@ -77,12 +79,16 @@ declare namespace Electron {
     equal(other: WebContents): boolean;
     browserWindowOptions: BrowserWindowConstructorOptions;
     _windowOpenHandler: ((details: Electron.HandlerDetails) => any) | null;
-    _callWindowOpenHandler(event: any, details: Electron.HandlerDetails): {browserWindowConstructorOptions: Electron.BrowserWindowConstructorOptions | null, outlivesOpener: boolean, createWindow?: Electron.CreateWindowFunction};
+    _windowOpenRules?: Electron.WindowOpenRule[];
+    _setWindowOpenRules(rules: Electron.WindowOpenRule[]): void;
+    _callWindowOpenHandler(event: any, details: Electron.HandlerDetails, allowRule: number): {browserWindowConstructorOptions: Electron.BrowserWindowConstructorOptions | null, outlivesOpener: boolean, createWindow?: Electron.CreateWindowFunction};
     _setNextChildWebPreferences(prefs: Partial<Electron.BrowserWindowConstructorOptions['webPreferences']> & Pick<Electron.BrowserWindowConstructorOptions, 'backgroundColor'>): void;
     _send(internal: boolean, channel: string, args: any): boolean;
     _sendInternal(channel: string, ...args: any[]): void;
-    _printToPDF(options: any): Promise<Buffer>;
+    _printToPDF(options: any): Promise<any>;
     _print(options: any, callback?: (success: boolean, failureReason: string) => void): void;
+    _savePage(fullPath: string, saveType: string, onProgress?: (completed: number, total: number) => void): Promise<void>;
+    _getSubresourceURLs(): string[];
     _getPrintersAsync(): Promise<Electron.PrinterInfo[]>;
     _init(): void;
     _getNavigationEntryAtIndex(index: number): Electron.EntryAtIndex | null;
@@ -128,6 +134,7 @@ declare namespace Electron {
     _callMenuWillShow(): void;
     _executeCommand(event: KeyboardEvent, id: number): void;
     _menuWillShow(): void;
+    _setCommandState(id: number, state: any): void;
     commandsMap: Record<string, MenuItem>;
     groupsMap: Record<string, MenuItem[]>;
     getItemCount(): number;
@@ -151,6 +158,8 @@ declare namespace Electron {
     groupId: number;
     getDefaultRoleAccelerator(): Accelerator | undefined;
     getCheckStatus(): boolean;
+    _getNativeState(): any;
+    _updateNativeState(): void;
     acceleratorWorksWhenHidden?: boolean;
   }
 
@@ -185,6 +194,7 @@ declare namespace Electron {
   interface Protocol {
     registerProtocol(scheme: string, handler: any): boolean;
     interceptProtocol(scheme: string, handler: any): boolean;
+    _enableResponseCache(scheme: string): boolean;
   }
 }
 
@@ -193,6 +203,15 @@ declare namespace ElectronInternal {
     startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
     _onerror?: (error: string) => void;
     _onfinished?: (sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => void;
+    startUpdating(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean, intervalMs: number): void;
+    stop(): void;
+    _onupdated?: (added: Electron.DesktopCapturerSource[], removed: string[], changed: DesktopCapturerSourceChange[], order: string[]) => void;
+  }
+
+  interface DesktopCapturerSourceChange {
+    id: string;
+    name?: string;
+    thumbnail?: Electron.NativeImage;
   }
 
   interface GetSourcesOptions {
@@ -259,12 +278,27 @@ declare namespace ElectronInternal {
     readonly pid: (number) | (undefined);
     kill(): boolean;
     postMessage(message: any, transfer?: any[]): void;
+    startCpuProfiling(options?: Electron.CpuProfilingOptions): Promise<void>;
+    stopCpuProfiling(filePath: string): Promise<void>;
+    createSharedBuffer(name: string, capacity: number): SharedBuffer;
+    setPriority(priority: 'background' | 'utility' | 'user-interactive'): boolean;
+    setCPUAffinity(cpus: number[]): boolean;
+    handleProtocol(scheme: string, session: Electron.Session): void;
+  }
+
+  interface SharedBuffer extends NodeJS.EventEmitter {
+    readonly capacity: number;
+    write(data: ArrayBufferView): boolean;
+    read(): Buffer | null;
+    close(): void;
   }
 
   interface ParentPort extends NodeJS.EventEmitter {
     start(): void;
     pause(): void;
-    postMessage(message: any): void;
+    postMessage(message: any, transfer?: ArrayBuffer[]): void;
+    setBatching(batching: boolean): void;
+    handleProtocol(scheme: string, handler: (request: Electron.ProtocolRequest, callback: (response: any) => void) => void): void;
   }
 
   class WebViewElement extends HTMLElement {